@@ -0,0 +1,119 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "ChunkedLinearAllocator.h"
+
+#include "AllocationHelpers.h"
+
+ChunkedLinearAllocator::ChunkedLinearAllocator( BaseAllocator* parentAllocator, const size_t chunkSize )
+    : BaseAllocator( 0ull, nullptr )
+    , parentAllocator( parentAllocator )
+    , defaultChunkSize( chunkSize )
+    , firstChunk( nullptr )
+    , activeChunk( nullptr )
+    , currentPosition( nullptr )
+    , currentEndPosition( nullptr )
+{
+
+}
+
+ChunkedLinearAllocator::~ChunkedLinearAllocator()
+{
+    Chunk* chunk = firstChunk;
+    while ( chunk != nullptr ) {
+        Chunk* next = chunk->Next;
+        parentAllocator->free( chunk );
+        chunk = next;
+    }
+
+    firstChunk = nullptr;
+    activeChunk = nullptr;
+    currentPosition = nullptr;
+    currentEndPosition = nullptr;
+}
+
+void* ChunkedLinearAllocator::allocate( const size_t allocationSize, const u8 alignment )
+{
+    u8 adjustment = ( currentPosition != nullptr ) ? dk::core::AlignForwardAdjustment( currentPosition, alignment ) : 0;
+
+    if ( currentPosition == nullptr || static_cast< u8* >( currentPosition ) + adjustment + allocationSize > currentEndPosition ) {
+        nextChunk( allocationSize, alignment );
+
+        if ( currentPosition == nullptr ) {
+            return nullptr;
+        }
+
+        adjustment = dk::core::AlignForwardAdjustment( currentPosition, alignment );
+    }
+
+    u8* allocatedAddress = static_cast< u8* >( currentPosition ) + adjustment;
+    currentPosition = static_cast< void* >( allocatedAddress + allocationSize );
+
+    memoryUsage += ( allocationSize + adjustment );
+    allocationCount++;
+
+    return static_cast< void* >( allocatedAddress );
+}
+
+void ChunkedLinearAllocator::free( void* pointer )
+{
+    DUSK_UNUSED_VARIABLE( pointer );
+    DUSK_DEV_ASSERT( true, "Bad API usage (not implemented)!\n" );
+}
+
+void ChunkedLinearAllocator::clear()
+{
+    allocationCount = 0;
+    memoryUsage = 0;
+
+    activeChunk = firstChunk;
+
+    if ( activeChunk != nullptr ) {
+        currentPosition = static_cast< void* >( activeChunk + 1 );
+        currentEndPosition = static_cast< u8* >( currentPosition ) + activeChunk->Size;
+    }
+}
+
+void ChunkedLinearAllocator::nextChunk( const size_t allocationSize, const u8 alignment )
+{
+    const size_t requiredSize = allocationSize + alignment;
+
+    // Reuse the chunks following the active chunk (if they are big enough).
+    Chunk* previousChunk = activeChunk;
+    Chunk* chunk = ( activeChunk != nullptr ) ? activeChunk->Next : nullptr;
+    while ( chunk != nullptr && chunk->Size < requiredSize ) {
+        previousChunk = chunk;
+        chunk = chunk->Next;
+    }
+
+    if ( chunk == nullptr ) {
+        const size_t chunkSize = Max( defaultChunkSize, requiredSize );
+
+        void* chunkMemory = parentAllocator->allocate( sizeof( Chunk ) + chunkSize, alignof( Chunk ) );
+        DUSK_RAISE_FATAL_ERROR( chunkMemory != nullptr, "Failed to allocate a new chunk (%llu bytes)!", static_cast< u64 >( chunkSize ) );
+
+        chunk = static_cast< Chunk* >( chunkMemory );
+        chunk->Next = nullptr;
+        chunk->Size = chunkSize;
+
+        if ( previousChunk != nullptr ) {
+            // Insert the chunk after the last chunk visited (so that the chunks skipped are reused by the next frames).
+            chunk->Next = previousChunk->Next;
+            previousChunk->Next = chunk;
+        } else {
+            firstChunk = chunk;
+        }
+
+        if ( baseAddress == nullptr ) {
+            baseAddress = chunkMemory;
+        }
+
+        memorySize += chunkSize;
+    }
+
+    activeChunk = chunk;
+    currentPosition = static_cast< void* >( activeChunk + 1 );
+    currentEndPosition = static_cast< u8* >( currentPosition ) + activeChunk->Size;
+}
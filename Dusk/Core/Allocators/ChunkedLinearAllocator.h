@@ -0,0 +1,52 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include "BaseAllocator.h"
+
+// Linear allocator backed by a list of memory chunks requested to a parent allocator. A new chunk is appended whenever
+// the active chunk is exhausted. Clearing the allocator rewinds to the first chunk; chunks are kept for reuse (which
+// means that the allocator does not request any memory once its peak usage has been reached).
+class ChunkedLinearAllocator final : public BaseAllocator
+{
+public:
+            ChunkedLinearAllocator( BaseAllocator* parentAllocator, const size_t chunkSize );
+            ChunkedLinearAllocator( ChunkedLinearAllocator& ) = delete;
+            ChunkedLinearAllocator& operator = ( ChunkedLinearAllocator& ) = delete;
+            ~ChunkedLinearAllocator();
+
+    void*   allocate( const size_t allocationSize, const u8 alignment = 4 ) override;
+    void    free( void* pointer ) override;
+    void    clear();
+
+private:
+    struct Chunk {
+        // Next chunk in the list (null if this is the last chunk).
+        Chunk*  Next;
+
+        // Size of the chunk (in bytes; header excluded).
+        size_t  Size;
+    };
+
+private:
+    // Allocator owning the chunks.
+    BaseAllocator*  parentAllocator;
+
+    // Default size of a chunk (a chunk might be bigger if an allocation does not fit in a default sized chunk).
+    size_t          defaultChunkSize;
+
+    // First chunk of the list.
+    Chunk*          firstChunk;
+
+    // Chunk used to serve allocations.
+    Chunk*          activeChunk;
+
+    void*           currentPosition;
+    void*           currentEndPosition;
+
+private:
+    // Move to the next chunk able to hold an allocation of 'allocationSize' bytes (a new chunk is created if needed).
+    void            nextChunk( const size_t allocationSize, const u8 alignment );
+};
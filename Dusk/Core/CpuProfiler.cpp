@@ -51,4 +51,11 @@ void CpuProfiler::endSection()
     sectionsStack.pop();
 }
 
+void CpuProfiler::clear()
+{
+    DUSK_ASSERT( sectionsStack.empty(), "Profiling sections are still active!" );
+
+    profiledSections.clear();
+}
+
 CpuProfiler g_CpuProfiler;
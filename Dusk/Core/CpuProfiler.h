@@ -71,6 +71,9 @@ public:
     // End the latest section pushed to the session stack.
     void            endSection();
 
+    // Discard every recorded section (must be called outside of any active section).
+    void            clear();
+
 private:
     // Hashmap keeping track of the sections across several frames.
     std::unordered_map<dkStringHash_t, SectionData> profiledSections;
@@ -0,0 +1,405 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// JobSystem owning the calling thread (null if the calling thread is not a worker).
+static thread_local const JobSystem* g_WorkerOwner = nullptr;
+
+// Index of the calling worker in its JobSystem.
+static thread_local u32 g_WorkerIndex = JobSystem::INVALID_WORKER_INDEX;
+
+JobSystem::JobSystem( BaseAllocator* allocator )
+    : memoryAllocator( allocator )
+    , workers( nullptr )
+    , workerQueues( nullptr )
+    , priorityQueue( nullptr )
+    , priorityJobCount( 0u )
+    , workerCount( 0u )
+    , jobPool( nullptr )
+    , freeJobIndexes( nullptr )
+    , freeJobCount( 0u )
+    , freeDependentBlocks( nullptr )
+    , allocatedDependentBlocks( nullptr )
+    , queuedJobCount( 0u )
+    , nextExternalQueueIndex( 0u )
+    , parkedWorkerCount( 0u )
+    , waitingWorkerCount( 0u )
+    , isShutdownRequested( false )
+{
+    static_assert( ( MAX_JOB_COUNT & ( MAX_JOB_COUNT - 1 ) ) == 0, "MAX_JOB_COUNT must be a power of two!" );
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock( parkMutex );
+        isShutdownRequested.store( true );
+    }
+    parkCondition.notify_all();
+
+    for ( u32 i = 0; i < workerCount; i++ ) {
+        if ( workers[i].joinable() ) {
+            workers[i].join();
+        }
+    }
+
+    if ( workers != nullptr ) {
+        dk::core::freeArray( memoryAllocator, workers );
+        workers = nullptr;
+    }
+
+    if ( workerQueues != nullptr ) {
+        dk::core::freeArray( memoryAllocator, workerQueues );
+        workerQueues = nullptr;
+    }
+
+    if ( priorityQueue != nullptr ) {
+        dk::core::free( memoryAllocator, priorityQueue );
+        priorityQueue = nullptr;
+    }
+
+    if ( jobPool != nullptr ) {
+        dk::core::freeArray( memoryAllocator, jobPool );
+        jobPool = nullptr;
+    }
+
+    if ( freeJobIndexes != nullptr ) {
+        dk::core::freeArray( memoryAllocator, freeJobIndexes );
+        freeJobIndexes = nullptr;
+    }
+
+    while ( allocatedDependentBlocks != nullptr ) {
+        JobDependentBlock* nextBlock = allocatedDependentBlocks->NextAllocated;
+        dk::core::free( memoryAllocator, allocatedDependentBlocks );
+        allocatedDependentBlocks = nextBlock;
+    }
+    freeDependentBlocks = nullptr;
+
+    workerCount = 0u;
+}
+
+void JobSystem::create( const u32 desiredWorkerCount )
+{
+    u32 hardwareThreadCount = std::thread::hardware_concurrency();
+
+    // Keep a hardware thread for the thread owning the JobSystem (usually the main/logic thread).
+    workerCount = ( desiredWorkerCount != 0u ) ? desiredWorkerCount : ( hardwareThreadCount > 1u ) ? ( hardwareThreadCount - 1u ) : 1u;
+    workerCount = Min( workerCount, MAX_WORKER_COUNT );
+
+    DUSK_LOG_INFO( "Creating JobSystem with %u worker(s) (%u hardware thread(s) available)\n", workerCount, hardwareThreadCount );
+
+    jobPool = dk::core::allocateArray<Job>( memoryAllocator, MAX_JOB_COUNT );
+    freeJobIndexes = dk::core::allocateArray<u32>( memoryAllocator, MAX_JOB_COUNT );
+
+    // Pop order does not matter; push the indexes in reverse order so that the first jobs allocated are contiguous.
+    for ( u32 i = 0; i < MAX_JOB_COUNT; i++ ) {
+        freeJobIndexes[i] = ( MAX_JOB_COUNT - 1u - i );
+    }
+    freeJobCount = MAX_JOB_COUNT;
+    workerQueues = dk::core::allocateArray<WorkerQueue>( memoryAllocator, workerCount );
+
+    for ( u32 i = 0; i < workerCount; i++ ) {
+        workerQueues[i].Head = 0u;
+        workerQueues[i].Tail = 0u;
+    }
+
+    priorityQueue = dk::core::allocate<PriorityQueue>( memoryAllocator );
+    priorityQueue->JobCount = 0u;
+
+    workers = dk::core::allocateArray<std::thread>( memoryAllocator, workerCount );
+    for ( u32 i = 0; i < workerCount; i++ ) {
+        workers[i] = std::thread( &JobSystem::workerThread, this, i );
+    }
+}
+
+Job* JobSystem::createJob( dkJobFunction_t function, void* userData, const u32 priority )
+{
+    DUSK_DEV_ASSERT( function != nullptr, "Job has no function to execute!" );
+
+    u32 jobIndex = 0u;
+    {
+        std::lock_guard<std::mutex> lock( jobPoolLock );
+        DUSK_RAISE_FATAL_ERROR( freeJobCount != 0u, "Too many jobs in flight (the job pool is exhausted)!" );
+
+        jobIndex = freeJobIndexes[--freeJobCount];
+    }
+
+    Job* job = &jobPool[jobIndex];
+    job->Function = function;
+    job->UserData = userData;
+    job->Counter = nullptr;
+    job->Priority = priority;
+    job->PendingDependencyCount.store( 1u );
+    job->DependentCount = 0u;
+    job->OverflowDependents = nullptr;
+    job->IsSubmitted = false;
+
+    return job;
+}
+
+void JobSystem::addDependency( Job* job, Job* dependency )
+{
+    DUSK_DEV_ASSERT( !job->IsSubmitted && !dependency->IsSubmitted, "Dependencies must be declared before job submission!" );
+
+    if ( dependency->DependentCount < Job::INLINE_DEPENDENT_COUNT ) {
+        dependency->Dependents[dependency->DependentCount++] = job;
+    } else {
+        // Chain a new block once the head of the chain is full (the release order of the dependents does not matter).
+        JobDependentBlock* block = dependency->OverflowDependents;
+        if ( block == nullptr || block->DependentCount == JobDependentBlock::CAPACITY ) {
+            JobDependentBlock* newBlock = allocateDependentBlock();
+            newBlock->Next = block;
+            dependency->OverflowDependents = newBlock;
+            block = newBlock;
+        }
+
+        block->Dependents[block->DependentCount++] = job;
+    }
+
+    job->PendingDependencyCount.fetch_add( 1u );
+}
+
+JobDependentBlock* JobSystem::allocateDependentBlock()
+{
+    std::lock_guard<std::mutex> lock( jobPoolLock );
+
+    JobDependentBlock* block = freeDependentBlocks;
+    if ( block != nullptr ) {
+        freeDependentBlocks = block->Next;
+    } else {
+        block = dk::core::allocate<JobDependentBlock>( memoryAllocator );
+        block->NextAllocated = allocatedDependentBlocks;
+        allocatedDependentBlocks = block;
+    }
+
+    block->DependentCount = 0u;
+    block->Next = nullptr;
+
+    return block;
+}
+
+void JobSystem::submit( Job* job, JobCounter* counter )
+{
+    DUSK_DEV_ASSERT( !job->IsSubmitted, "Job has already been submitted!" );
+
+    job->Counter = counter;
+    job->IsSubmitted = true;
+
+    if ( counter != nullptr ) {
+        counter->PendingJobCount.fetch_add( 1u );
+    }
+
+    // Release the submission reference; push the job if every dependency is already completed.
+    if ( job->PendingDependencyCount.fetch_sub( 1u ) == 1u ) {
+        pushJob( job );
+    }
+}
+
+void JobSystem::wait( JobCounter* counter )
+{
+    const u32 workerIndex = getCallingWorkerIndex();
+
+    if ( workerIndex != INVALID_WORKER_INDEX ) {
+        // The jobs we are waiting for might be stuck in our deque; help until there is nothing left to execute.
+        while ( counter->PendingJobCount.load() != 0u ) {
+            Job* job = findJob( workerIndex );
+            if ( job != nullptr ) {
+                executeJob( job, workerIndex );
+                continue;
+            }
+
+            // Nothing to steal; park until the counter is completed or a job is pushed.
+            std::unique_lock<std::mutex> lock( completionMutex );
+            waitingWorkerCount.fetch_add( 1u );
+            completionCondition.wait( lock, [this, counter]() { return counter->PendingJobCount.load() == 0u || queuedJobCount.load() != 0u; } );
+            waitingWorkerCount.fetch_sub( 1u );
+        }
+    } else {
+        std::unique_lock<std::mutex> lock( completionMutex );
+        completionCondition.wait( lock, [counter]() { return counter->PendingJobCount.load() == 0u; } );
+    }
+}
+
+u32 JobSystem::getCallingWorkerIndex() const
+{
+    return ( g_WorkerOwner == this ) ? g_WorkerIndex : INVALID_WORKER_INDEX;
+}
+
+void JobSystem::workerThread( const u32 workerIndex )
+{
+    g_WorkerOwner = this;
+    g_WorkerIndex = workerIndex;
+
+    while ( 1 ) {
+        Job* job = findJob( workerIndex );
+        if ( job != nullptr ) {
+            executeJob( job, workerIndex );
+            continue;
+        }
+
+        // Nothing to do; park the worker until a job is pushed.
+        std::unique_lock<std::mutex> lock( parkMutex );
+        parkedWorkerCount.fetch_add( 1u );
+        parkCondition.wait( lock, [this]() { return queuedJobCount.load() != 0u || isShutdownRequested.load(); } );
+        parkedWorkerCount.fetch_sub( 1u );
+
+        if ( isShutdownRequested.load() ) {
+            return;
+        }
+    }
+}
+
+// Heap ordering (std heaps put the greatest element on top).
+static bool IsLowerPriority( const Job* left, const Job* right )
+{
+    return left->Priority < right->Priority;
+}
+
+void JobSystem::pushJob( Job* job )
+{
+    if ( job->Priority != 0u ) {
+        {
+            std::lock_guard<std::mutex> lock( priorityQueue->Lock );
+            DUSK_RAISE_FATAL_ERROR( priorityQueue->JobCount < MAX_JOB_COUNT, "Priority queue overflow!" );
+
+            priorityQueue->Jobs[priorityQueue->JobCount++] = job;
+            std::push_heap( priorityQueue->Jobs, priorityQueue->Jobs + priorityQueue->JobCount, IsLowerPriority );
+        }
+
+        priorityJobCount.fetch_add( 1u );
+        queuedJobCount.fetch_add( 1u );
+
+        if ( parkedWorkerCount.load() != 0u ) {
+            { std::lock_guard<std::mutex> lock( parkMutex ); }
+            parkCondition.notify_one();
+        }
+
+        if ( waitingWorkerCount.load() != 0u ) {
+            notifyWaitingThreads();
+        }
+        return;
+    }
+
+    u32 queueIndex = getCallingWorkerIndex();
+    if ( queueIndex == INVALID_WORKER_INDEX ) {
+        queueIndex = nextExternalQueueIndex.fetch_add( 1u ) % workerCount;
+    }
+
+    WorkerQueue& queue = workerQueues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock( queue.Lock );
+        DUSK_RAISE_FATAL_ERROR( ( queue.Tail - queue.Head ) < MAX_JOB_COUNT, "Worker deque overflow!" );
+
+        queue.Jobs[queue.Tail & ( MAX_JOB_COUNT - 1u )] = job;
+        queue.Tail++;
+    }
+
+    queuedJobCount.fetch_add( 1u );
+
+    // Only pay for the wake up if someone is actually sleeping.
+    if ( parkedWorkerCount.load() != 0u ) {
+        { std::lock_guard<std::mutex> lock( parkMutex ); }
+        parkCondition.notify_one();
+    }
+
+    if ( waitingWorkerCount.load() != 0u ) {
+        notifyWaitingThreads();
+    }
+}
+
+Job* JobSystem::findJob( const u32 workerIndex )
+{
+    // Prioritized jobs are picked first (whichever worker has released them).
+    if ( priorityJobCount.load() != 0u ) {
+        std::lock_guard<std::mutex> lock( priorityQueue->Lock );
+        if ( priorityQueue->JobCount != 0u ) {
+            std::pop_heap( priorityQueue->Jobs, priorityQueue->Jobs + priorityQueue->JobCount, IsLowerPriority );
+            priorityQueue->JobCount--;
+
+            priorityJobCount.fetch_sub( 1u );
+            queuedJobCount.fetch_sub( 1u );
+            return priorityQueue->Jobs[priorityQueue->JobCount];
+        }
+    }
+
+    // Pop the most recent job from our own deque first.
+    {
+        WorkerQueue& queue = workerQueues[workerIndex];
+        std::lock_guard<std::mutex> lock( queue.Lock );
+        if ( queue.Tail != queue.Head ) {
+            queue.Tail--;
+            queuedJobCount.fetch_sub( 1u );
+            return queue.Jobs[queue.Tail & ( MAX_JOB_COUNT - 1u )];
+        }
+    }
+
+    // Then try to steal the oldest job from the other workers.
+    for ( u32 i = 1u; i < workerCount; i++ ) {
+        WorkerQueue& victimQueue = workerQueues[( workerIndex + i ) % workerCount];
+        std::lock_guard<std::mutex> lock( victimQueue.Lock );
+        if ( victimQueue.Tail != victimQueue.Head ) {
+            Job* job = victimQueue.Jobs[victimQueue.Head & ( MAX_JOB_COUNT - 1u )];
+            victimQueue.Head++;
+            queuedJobCount.fetch_sub( 1u );
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void JobSystem::executeJob( Job* job, const u32 workerIndex )
+{
+    job->Function( job->UserData, workerIndex );
+
+    // Release the jobs waiting for this one.
+    for ( u32 i = 0u; i < job->DependentCount; i++ ) {
+        Job* dependent = job->Dependents[i];
+        if ( dependent->PendingDependencyCount.fetch_sub( 1u ) == 1u ) {
+            pushJob( dependent );
+        }
+    }
+
+    JobDependentBlock* lastOverflowBlock = nullptr;
+    for ( JobDependentBlock* block = job->OverflowDependents; block != nullptr; block = block->Next ) {
+        for ( u32 i = 0u; i < block->DependentCount; i++ ) {
+            Job* dependent = block->Dependents[i];
+            if ( dependent->PendingDependencyCount.fetch_sub( 1u ) == 1u ) {
+                pushJob( dependent );
+            }
+        }
+
+        lastOverflowBlock = block;
+    }
+
+    JobCounter* counter = job->Counter;
+
+    // The job is not referenced past this point; recycle its slot before signaling the completion (a thread waiting
+    // for the counter might allocate new jobs right away).
+    {
+        std::lock_guard<std::mutex> lock( jobPoolLock );
+        DUSK_DEV_ASSERT( freeJobCount < MAX_JOB_COUNT, "Job pool corruption (slot released twice?)" );
+
+        freeJobIndexes[freeJobCount++] = static_cast<u32>( job - jobPool );
+
+        if ( lastOverflowBlock != nullptr ) {
+            lastOverflowBlock->Next = freeDependentBlocks;
+            freeDependentBlocks = job->OverflowDependents;
+        }
+    }
+
+    if ( counter != nullptr && counter->PendingJobCount.fetch_sub( 1u ) == 1u ) {
+        notifyWaitingThreads();
+    }
+}
+
+void JobSystem::notifyWaitingThreads()
+{
+    { std::lock_guard<std::mutex> lock( completionMutex ); }
+    completionCondition.notify_all();
+}
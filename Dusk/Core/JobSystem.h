@@ -0,0 +1,238 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class BaseAllocator;
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Function executed by a worker of the JobSystem. 'workerIndex' is the index of the worker executing the job
+// (in the [0..JobSystem::getWorkerCount()[ range) and can be used to index per-worker data without synchronization.
+using dkJobFunction_t = void( * )( void* userData, const u32 workerIndex );
+
+// Track the completion of a group of jobs. The counter is incremented when a job is submitted and decremented once the
+// job has been executed.
+struct JobCounter
+{
+    // Number of jobs submitted with this counter which are not completed yet.
+    std::atomic<u32>    PendingJobCount;
+
+    JobCounter()
+        : PendingJobCount( 0u )
+    {
+
+    }
+};
+
+struct Job;
+
+// Chained block storing the dependents which do not fit in Job::Dependents. Blocks are owned (and recycled) by the
+// JobSystem.
+struct JobDependentBlock
+{
+    // Number of dependents stored in a single block.
+    static constexpr u32    CAPACITY = 32u;
+
+    // Jobs waiting for the completion of the job owning this block.
+    Job*                    Dependents[CAPACITY];
+
+    // Number of jobs stored in this block.
+    u32                     DependentCount;
+
+    // Next block of the chain (or next free block if the block is unused).
+    JobDependentBlock*      Next;
+
+    // Next block allocated by the JobSystem (used to release the memory on shutdown).
+    JobDependentBlock*      NextAllocated;
+};
+
+struct Job
+{
+    // Number of dependents stored inline in the job (additional dependents are stored in chained overflow blocks).
+    static constexpr u32    INLINE_DEPENDENT_COUNT = 32u;
+
+    // Function to execute.
+    dkJobFunction_t         Function;
+
+    // Opaque pointer forwarded to Function.
+    void*                   UserData;
+
+    // Counter to decrement on completion (optional).
+    JobCounter*             Counter;
+
+    // Number of unfinished dependencies (plus one until the job is submitted). The job becomes runnable once the
+    // counter reaches zero.
+    std::atomic<u32>        PendingDependencyCount;
+
+    // Priority of the job. Runnable jobs with a non-zero priority are executed before any other runnable job (highest
+    // priority first).
+    u32                     Priority;
+
+    // Jobs waiting for the completion of this job.
+    Job*                    Dependents[INLINE_DEPENDENT_COUNT];
+
+    // Number of jobs stored in Dependents.
+    u32                     DependentCount;
+
+    // Jobs waiting for the completion of this job which did not fit in Dependents (null if there is none).
+    JobDependentBlock*      OverflowDependents;
+
+    // True once the job has been submitted (dependencies can't be added past this point).
+    bool                    IsSubmitted;
+};
+
+// Work-stealing task scheduler. Each worker owns a deque: jobs released by a worker are pushed on its own deque (LIFO for
+// cache locality) while idle workers steal from the other end of the other deques. Workers with nothing to do are parked
+// until a job is pushed.
+class JobSystem
+{
+public:
+    // Maximum number of worker threads.
+    static constexpr u32    MAX_WORKER_COUNT = 64;
+
+    // Maximum number of jobs in flight (must be a power of two). The slot of a job is recycled once the job has been
+    // executed.
+    static constexpr u32    MAX_JOB_COUNT = 4096;
+
+    // Worker index returned when the calling thread is not a worker of the JobSystem.
+    static constexpr u32    INVALID_WORKER_INDEX = ~0u;
+
+public:
+    // Return the number of worker threads of this JobSystem.
+    DUSK_INLINE u32         getWorkerCount() const { return workerCount; }
+
+public:
+                            JobSystem( BaseAllocator* allocator );
+                            JobSystem( JobSystem& ) = delete;
+                            JobSystem& operator = ( JobSystem& ) = delete;
+                            ~JobSystem();
+
+    // Spawn the worker threads. If 'desiredWorkerCount' is zero, spawn one worker per hardware thread (minus one
+    // for the thread calling this function).
+    void                    create( const u32 desiredWorkerCount = 0u );
+
+    // Allocate a job. The job is NOT executed until it is submitted. See Job::Priority for 'priority'.
+    Job*                    createJob( dkJobFunction_t function, void* userData = nullptr, const u32 priority = 0u );
+
+    // Declare that 'job' can't start until 'dependency' is completed. Both jobs must not be submitted yet.
+    void                    addDependency( Job* job, Job* dependency );
+
+    // Submit a job for execution. The job will run as soon as all its dependencies are completed. 'counter' is an
+    // optional counter to track the completion of the job.
+    void                    submit( Job* job, JobCounter* counter = nullptr );
+
+    // Block until every job tracked by 'counter' is completed. If the calling thread is a worker, it will execute
+    // pending jobs while waiting (and is parked if there is nothing to execute); otherwise the calling thread is parked.
+    void                    wait( JobCounter* counter );
+
+    // Return the index of the worker calling this function (or INVALID_WORKER_INDEX if the calling thread does not
+    // belong to the JobSystem).
+    u32                     getCallingWorkerIndex() const;
+
+private:
+    struct WorkerQueue {
+        // Lock protecting the deque (the owner pops from the tail; thieves steal from the head).
+        std::mutex  Lock;
+
+        // Ring buffer of runnable jobs.
+        Job*        Jobs[MAX_JOB_COUNT];
+
+        // Index of the oldest job (stealing end).
+        u32         Head;
+
+        // Index past the newest job (owner end).
+        u32         Tail;
+    };
+
+    struct PriorityQueue {
+        // Lock protecting the heap.
+        std::mutex  Lock;
+
+        // Binary heap of runnable prioritized jobs (highest priority on top).
+        Job*        Jobs[MAX_JOB_COUNT];
+
+        // Number of jobs in the heap.
+        u32         JobCount;
+    };
+
+private:
+    // Allocator owning the memory of this instance.
+    BaseAllocator*          memoryAllocator;
+
+    // Worker threads.
+    std::thread*            workers;
+
+    // Per-worker deques.
+    WorkerQueue*            workerQueues;
+
+    // Runnable prioritized jobs (shared by every worker).
+    PriorityQueue*          priorityQueue;
+
+    // Number of runnable jobs stored in the priority queue.
+    std::atomic<u32>        priorityJobCount;
+
+    // Number of worker threads.
+    u32                     workerCount;
+
+    // Pool of jobs.
+    Job*                    jobPool;
+
+    // Indexes of the unused slots of the job pool (stack; protected by jobPoolLock).
+    u32*                    freeJobIndexes;
+    u32                     freeJobCount;
+    std::mutex              jobPoolLock;
+
+    // Unused dependent blocks (free list; protected by jobPoolLock). The pool grows on demand.
+    JobDependentBlock*      freeDependentBlocks;
+
+    // Every dependent block allocated by this instance (protected by jobPoolLock).
+    JobDependentBlock*      allocatedDependentBlocks;
+
+    // Number of runnable jobs stored in the worker deques.
+    std::atomic<u32>        queuedJobCount;
+
+    // Index of the next deque to use when a job is pushed from a thread which is not a worker.
+    std::atomic<u32>        nextExternalQueueIndex;
+
+    // Number of workers parked (waiting for a job).
+    std::atomic<u32>        parkedWorkerCount;
+
+    // Number of workers parked in wait() (waiting for a JobCounter or a job to help with).
+    std::atomic<u32>        waitingWorkerCount;
+
+    // True if the workers should exit.
+    std::atomic<bool>       isShutdownRequested;
+
+    // Mutex/condition used to park idle workers.
+    std::mutex              parkMutex;
+    std::condition_variable parkCondition;
+
+    // Mutex/condition used to park threads waiting for a JobCounter.
+    std::mutex              completionMutex;
+    std::condition_variable completionCondition;
+
+private:
+    // Main function of a worker thread.
+    void                    workerThread( const u32 workerIndex );
+
+    // Push a runnable job on a deque (the calling worker deque if the caller is a worker).
+    void                    pushJob( Job* job );
+
+    // Pop the highest priority job, then a job from the deque of the worker or steal one from another worker. Return
+    // null if no job is available.
+    Job*                    findJob( const u32 workerIndex );
+
+    // Return an empty dependent block (allocated if the free list is empty).
+    JobDependentBlock*      allocateDependentBlock();
+
+    // Execute a job, release its dependents and return its slot (and its dependent blocks) to the pool.
+    void                    executeJob( Job* job, const u32 workerIndex );
+
+    // Wake up the threads parked in wait() (workers waiting for a job to help with and threads waiting for a counter).
+    void                    notifyWaitingThreads();
+};
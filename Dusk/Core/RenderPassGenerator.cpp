@@ -1066,6 +1066,14 @@ void RenderLibraryGenerator::generateResourceMetadata( RenderPassInfos& passInfo
     generatedMetadata.append( scopedPassName );
     generatedMetadata.append( "\";\n" );
 
+    generatedMetadata.append( "\tstatic constexpr dkStringHash_t " );
+    generatedMetadata.append( scopedPassName );
+    generatedMetadata.append( "_NameHashcode = DUSK_STRING_HASH( \"" );
+    generatedMetadata.append( generatedLibraryName );
+    generatedMetadata.append( "::" );
+    generatedMetadata.append( scopedPassName );
+    generatedMetadata.append( "\" );\n" );
+
     generatedMetadata.append( "\tstatic constexpr const dkChar_t* " );
     generatedMetadata.append( scopedPassName );
     generatedMetadata.append( "_EventName = DUSK_STRING( \"" );
@@ -10,8 +10,10 @@
 #include "Core/CommandLineArgs.h"
 #include "Core/Environment.h"
 #include "Core/Display/DisplaySurface.h"
+#include "Core/JobSystem.h"
 
 #include "Framework/World.h"
+#include "Framework/AreaStreaming.h"
 
 #include "FileSystem/VirtualFileSystem.h"
 #include "FileSystem/FileSystemNative.h"
@@ -47,15 +49,43 @@ DUSK_DEV_VAR_PERSISTENT( UseDebugLayer, false, bool ); // "Enable render debug c
 DUSK_DEV_VAR_PERSISTENT( UseRenderDocCapture, false, bool );// "Use RenderDoc frame capture tool [false/true]" (note: renderdoc dynamic lib must be present in the working dir)
 DUSK_DEV_VAR( DisplayCulledPrimCount, "Display the number of primitive culled for the Viewport[0]", false, bool );
 DUSK_DEV_VAR( DisplayFramerate, "Display basic framerate infos", true, bool );
+DUSK_ENV_VAR( JobWorkerCount, 0, u32 ) // "Number of JobSystem worker threads. If 0, the engine will spawn one worker per hardware thread"
 DUSK_ENV_VAR( MonitorIndex, 0, i32 ) // "Monitor index used for render device creation. If 0, will use the primary monitor as a display."
+DUSK_ENV_VAR( EnableWorldStreaming, true, bool ) // "Stream the world areas (GameData/areas/) around the streaming anchors [false/true]"
 DUSK_DEV_VAR( LogicTickrate, "Number of logic tick executed per frame", 300, i32 ) //
 DUSK_DEV_VAR( PhysicsTickrate, "Number of physics tick executed per frame", 100, i32 ) //
 
+// Read an area file from the virtual file system (AreaStreaming callback; userData is the VirtualFileSystem).
+static bool ReadAreaFile( void* userData, const Area& area, AreaDataBuffer& areaData )
+{
+    // The file systems keep track of the opened files (they are not thread-safe).
+    static std::mutex FileSystemLock;
+
+    VirtualFileSystem* virtualFileSystem = static_cast< VirtualFileSystem* >( userData );
+    const dkString_t areaFilename = DUSK_STRING( "GameData/areas/" ) + DUSK_TO_STRING( area.GridX ) + DUSK_STRING( "_" ) + DUSK_TO_STRING( area.GridZ ) + DUSK_STRING( ".area" );
+
+    std::lock_guard<std::mutex> lock( FileSystemLock );
+    FileSystemObject* areaFile = virtualFileSystem->openFile( areaFilename, eFileOpenMode::FILE_OPEN_MODE_READ | eFileOpenMode::FILE_OPEN_MODE_BINARY );
+    if ( areaFile == nullptr || !areaFile->isGood() ) {
+        return false;
+    }
+
+    const u64 areaFileSize = areaFile->getSize();
+    u8* data = areaData.allocate( static_cast< size_t >( areaFileSize ) );
+    if ( data != nullptr ) {
+        areaFile->read( data, areaFileSize );
+    }
+    areaFile->close();
+
+    return ( data != nullptr );
+}
+
 DuskEngine::DuskEngine()
     : applicationName( DUSK_STRING( "DuskEngine" ) )
     , deltaTime( 0.0f )
     , allocatedTable( nullptr )
     , globalAllocator( nullptr )
+    , jobSystem( nullptr )
     , virtualFileSystem( nullptr )
     , dataFileSystem( nullptr )
     , gameFileSystem( nullptr )
@@ -108,6 +138,9 @@ void DuskEngine::create( const char* cmdLineArgs )
     // behavior!)
     dk::core::ReadCommandLineArgs( cmdLineArgs );
 
+    jobSystem = dk::core::allocate<JobSystem>( globalAllocator, globalAllocator );
+    jobSystem->create( JobWorkerCount );
+
     initializeInputSubsystems();
     initializeRenderSubsystems();
     initializeLogicSubsystems();
@@ -130,6 +163,10 @@ void DuskEngine::shutdown()
 
     DUSK_LOG_INFO( "Calling subsystems destructors...\n" );
 
+    // Logic (released first; the area streaming might still be reading from the file systems)
+    dk::core::free( globalAllocator, world );
+    dk::core::free( globalAllocator, dynamicsWorld );
+
     // Input
     dk::core::free( globalAllocator, inputMapper );
     dk::core::free( globalAllocator, inputReader );
@@ -159,8 +196,8 @@ void DuskEngine::shutdown()
     dk::core::free( globalAllocator, renderDocHelper );
 #endif
 
-    dk::core::free( globalAllocator, world );
-    dk::core::free( globalAllocator, dynamicsWorld );
+    // Must be released last (subsystems might submit jobs until their destruction)
+    dk::core::free( globalAllocator, jobSystem );
 
     DUSK_LOG_INFO( "Freeing allocated memory...\n" );
 
@@ -432,7 +469,7 @@ void DuskEngine::initializeRenderSubsystems()
     graphicsAssetCache = dk::core::allocate<GraphicsAssetCache>( globalAllocator, globalAllocator, renderDevice, shaderCache, virtualFileSystem );
 
     worldRenderer = dk::core::allocate<WorldRenderer>( globalAllocator, globalAllocator );
-    worldRenderer->loadCachedResources( renderDevice, shaderCache, graphicsAssetCache, virtualFileSystem );
+    worldRenderer->loadCachedResources( renderDevice, shaderCache, graphicsAssetCache, virtualFileSystem, jobSystem );
 
     hudRenderer = dk::core::allocate<HUDRenderer>( globalAllocator, globalAllocator );
     hudRenderer->loadCachedResources( *renderDevice, *shaderCache, *graphicsAssetCache );
@@ -447,15 +484,23 @@ void DuskEngine::initializeRenderSubsystems()
     }
 #endif
 
-    drawCommandBuilder = dk::core::allocate<DrawCommandBuilder>( globalAllocator, globalAllocator );
+    drawCommandBuilder = dk::core::allocate<DrawCommandBuilder>( globalAllocator, globalAllocator, jobSystem );
 
     g_GpuProfiler.create( *renderDevice );
 }
 
 void DuskEngine::initializeLogicSubsystems()
 {
-    world = dk::core::allocate<World>( globalAllocator, globalAllocator );
+    world = dk::core::allocate<World>( globalAllocator, globalAllocator, jobSystem );
     world->create();
 
+    if ( EnableWorldStreaming ) {
+        AreaStreamingSettings streamingSettings;
+        streamingSettings.ReadArea = &ReadAreaFile;
+        streamingSettings.UserData = virtualFileSystem;
+
+        world->enableStreaming( streamingSettings );
+    }
+
     dynamicsWorld = dk::core::allocate<DynamicsWorld>( globalAllocator, globalAllocator );
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 class LinearAllocator;
+class JobSystem;
 class VirtualFileSystem;
 class FileSystem;
 class InputMapper;
@@ -33,6 +34,7 @@ public:
     DUSK_INLINE InputMapper* getInputMapper() { return inputMapper; }
     DUSK_INLINE InputReader* getInputReader() { return inputReader; }
     DUSK_INLINE LinearAllocator* getGlobalAllocator() { return globalAllocator; }
+    DUSK_INLINE JobSystem* getJobSystem() { return jobSystem; }
     DUSK_INLINE VirtualFileSystem* getVirtualFileSystem() { return virtualFileSystem; }
     DUSK_INLINE RenderDevice* getRenderDevice() { return renderDevice; }
     DUSK_INLINE GraphicsAssetCache* getGraphicsAssetCache() { return graphicsAssetCache; }
@@ -82,6 +84,9 @@ private:
     // Global allocator used for subsystem allocation (this is used to split the allocated memory table for each subsystem).
     LinearAllocator*    globalAllocator;
 
+    // Work-stealing task scheduler shared by every subsystem (e.g. FrameGraph renderpass recording).
+    JobSystem*          jobSystem;
+
     // VirtualFileSystem instance (abstracts logical/physical FileSystem).
     VirtualFileSystem*  virtualFileSystem;
 
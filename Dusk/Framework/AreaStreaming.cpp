@@ -5,17 +5,560 @@
 #include "Shared.h"
 #include "AreaStreaming.h"
 
-AreaStreaming::AreaStreaming()
+#include <Core/Timer.h>
+#include <Core/Allocators/FreeListAllocator.h>
+#include <Maths/Helpers.h>
+
+#include <algorithm>
+
+struct AreaHeader
+{
+    u32 Magic;
+    u32 Version;
+    u32 EntityCount;
+    u32 AssetCount;
+    u32 StringTableSize;
+    u32 __PADDING__[3];
+};
+
+// The entity list is stored right after the header; the header size keeps it aligned.
+static_assert( ( sizeof( AreaHeader ) % alignof( AreaEntity ) ) == 0, "Area entities must be aligned!" );
+static_assert( AreaStreaming::MAX_ANCHOR_COUNT <= 32u, "Anchors must fit in the anchor mask!" );
+
+// Return the distance (on the XZ plane) between a point and an area (0 if the point is inside the area).
+static f32 GetAreaDistance( const Area& area, const dkVec3f& point )
+{
+    const dkVec3f areaOrigin = area.getAreaWorldOrigin();
+
+    const f32 distanceX = Max( Max( areaOrigin.x - point.x, point.x - ( areaOrigin.x + Area::DIMENSION ) ), 0.0f );
+    const f32 distanceZ = Max( Max( areaOrigin.z - point.z, point.z - ( areaOrigin.z + Area::DIMENSION ) ), 0.0f );
+
+    return sqrtf( distanceX * distanceX + distanceZ * distanceZ );
+}
+
+u8* AreaDataBuffer::allocate( const size_t size )
+{
+    DUSK_ASSERT( Data == nullptr, "Area data has already been allocated!" );
+
+    Data = static_cast< u8* >( Owner->allocateAreaMemory( size, 16 ) );
+    Size = ( Data != nullptr ) ? size : 0;
+
+    if ( Data == nullptr ) {
+        DUSK_LOG_ERROR( "Failed to allocate area data (%zu bytes): out of streaming memory (see AreaStreamingSettings::MemorySize)!\n", size );
+    }
+
+    return Data;
+}
+
+AreaStreaming::AreaStreaming( BaseAllocator* allocator, JobSystem* jobSystem )
+    : memoryAllocator( allocator )
+    , jobSystem( jobSystem )
+    , areaAllocator( nullptr )
+    , settings()
+    , areaSlots( nullptr )
+    , anchorMask( 0u )
+    , residentAreaCount( 0u )
+    , operationCount( 0u )
+    , activeAreaCount( 0u )
+    , pendingLoadCount( 0u )
+    , transitionAreaCount( 0u )
+    , isCreated( false )
 {
 
 }
 
 AreaStreaming::~AreaStreaming()
 {
+    if ( !isCreated ) {
+        return;
+    }
+
+    // Wait for the pending reads (the read jobs write to the slots).
+    if ( jobSystem != nullptr ) {
+        jobSystem->wait( &loadCounter );
+    }
+
+    // The memory of the resident areas is released with the area allocator.
+    void* areaMemory = areaAllocator->getBaseAddress();
+    dk::core::free( memoryAllocator, areaAllocator );
+    memoryAllocator->free( areaMemory );
+
+    dk::core::freeArray( memoryAllocator, areaSlots );
+}
+
+void AreaStreaming::create( const AreaStreamingSettings& streamingSettings )
+{
+    DUSK_ASSERT( !isCreated, "Streaming has already been created!" );
+    DUSK_ASSERT( streamingSettings.ReadArea != nullptr, "No function to read the areas!" );
+
+    settings = streamingSettings;
+    settings.LoadRadius = Max( settings.LoadRadius, 0.0f );
+    settings.UnloadHysteresis = Max( settings.UnloadHysteresis, 0.0f );
+
+    areaAllocator = dk::core::allocate<FreeListAllocator>( memoryAllocator, settings.MemorySize, memoryAllocator->allocate( settings.MemorySize ) );
+
+    areaSlots = dk::core::allocateArray<AreaSlot>( memoryAllocator, MAX_RESIDENT_AREA_COUNT );
+    for ( u32 slotIdx = 0u; slotIdx < MAX_RESIDENT_AREA_COUNT; slotIdx++ ) {
+        areaSlots[slotIdx].Owner = this;
+    }
+
+    isCreated = true;
+}
+
+void AreaStreaming::setAnchor( const u32 anchorIndex, const dkVec3f& worldPosition )
+{
+    DUSK_ASSERT( anchorIndex < MAX_ANCHOR_COUNT, "Invalid streaming anchor index! (must be < MAX_ANCHOR_COUNT)" );
 
+    anchors[anchorIndex] = worldPosition;
+    anchorMask |= ( 1u << anchorIndex );
+}
+
+void AreaStreaming::removeAnchor( const u32 anchorIndex )
+{
+    DUSK_ASSERT( anchorIndex < MAX_ANCHOR_COUNT, "Invalid streaming anchor index! (must be < MAX_ANCHOR_COUNT)" );
+
+    anchorMask &= ~( 1u << anchorIndex );
 }
 
 void AreaStreaming::updateFromCameraView( const CameraData& camera )
 {
+    setAnchor( CAMERA_ANCHOR_INDEX, camera.worldPosition );
+}
+
+void AreaStreaming::update( dkAreaSpawnFunction_t spawnFunction, dkAreaReleaseFunction_t releaseFunction, void* userData )
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    if ( !isCreated ) {
+        return;
+    }
+
+    const f32 unloadRadius = settings.LoadRadius + settings.UnloadHysteresis;
+
+    // Update the distance of the resident areas to the anchors. Areas between the load and unload radius keep their
+    // current state.
+    for ( u32 residentIdx = 0u; residentIdx < residentAreaCount; residentIdx++ ) {
+        AreaSlot& slot = areaSlots[residentSlots[residentIdx]];
+
+        f32 anchorDistance = std::numeric_limits<f32>::max();
+        for ( u32 anchorIdx = 0u; anchorIdx < MAX_ANCHOR_COUNT; anchorIdx++ ) {
+            if ( ( anchorMask & ( 1u << anchorIdx ) ) == 0u ) {
+                continue;
+            }
+
+            anchorDistance = Min( anchorDistance, GetAreaDistance( slot.Coordinates, anchors[anchorIdx] ) );
+        }
+
+        slot.AnchorDistance = anchorDistance;
+        if ( anchorDistance <= settings.LoadRadius ) {
+            slot.IsWanted = true;
+        } else if ( anchorDistance > unloadRadius ) {
+            slot.IsWanted = false;
+        }
+    }
+
+    // Request the areas in range of the anchors (areas which can't be requested yet are counted as pending).
+    u32 deferredLoadCount = 0u;
+    for ( u32 anchorIdx = 0u; anchorIdx < MAX_ANCHOR_COUNT; anchorIdx++ ) {
+        if ( ( anchorMask & ( 1u << anchorIdx ) ) == 0u ) {
+            continue;
+        }
+
+        const dkVec3f& anchor = anchors[anchorIdx];
+
+        const i32 minGridX = static_cast< i32 >( floorf( ( anchor.x - settings.LoadRadius ) / Area::DIMENSION ) );
+        const i32 maxGridX = static_cast< i32 >( floorf( ( anchor.x + settings.LoadRadius ) / Area::DIMENSION ) );
+        const i32 minGridZ = static_cast< i32 >( floorf( ( anchor.z - settings.LoadRadius ) / Area::DIMENSION ) );
+        const i32 maxGridZ = static_cast< i32 >( floorf( ( anchor.z + settings.LoadRadius ) / Area::DIMENSION ) );
+
+        for ( i32 gridZ = minGridZ; gridZ <= maxGridZ; gridZ++ ) {
+            for ( i32 gridX = minGridX; gridX <= maxGridX; gridX++ ) {
+                const Area area = { gridX, gridZ };
+                const f32 anchorDistance = GetAreaDistance( area, anchor );
+                if ( anchorDistance > settings.LoadRadius || findResidentSlot( area ) != MAX_RESIDENT_AREA_COUNT ) {
+                    continue;
+                }
+
+                if ( !requestAreaLoad( area ) ) {
+                    deferredLoadCount++;
+                    continue;
+                }
+
+                areaSlots[residentSlots[residentAreaCount - 1u]].AnchorDistance = anchorDistance;
+            }
+        }
+    }
+
+    // Closest areas are activated first.
+    std::stable_sort( residentSlots, residentSlots + residentAreaCount, [this]( const u32 l, const u32 r ) {
+        return areaSlots[l].AnchorDistance < areaSlots[r].AnchorDistance;
+    } );
+
+    Timer budgetTimer;
+    budgetTimer.reset();
+
+    operationCount = 0u;
+    activeAreaCount = 0u;
+    pendingLoadCount = deferredLoadCount;
+    transitionAreaCount = 0u;
+
+    u32 residentIdx = 0u;
+    while ( residentIdx < residentAreaCount ) {
+        AreaSlot& slot = areaSlots[residentSlots[residentIdx]];
+
+        switch ( slot.State.load( std::memory_order_acquire ) ) {
+        case AREA_STATE_LOADING:
+            // Reads can't be cancelled (the area is released once loaded if it is not wanted anymore).
+            pendingLoadCount++;
+            break;
+
+        case AREA_STATE_LOADED:
+            if ( !slot.IsWanted ) {
+                releaseSlot( residentIdx );
+                continue;
+            }
+
+            // Wait for the next update if the budget is exhausted.
+            if ( operationCount != 0u && budgetTimer.getElapsedTimeAsMiliseconds() >= settings.ActivationBudget ) {
+                transitionAreaCount++;
+                break;
+            }
+
+            // Resolve the asset list of the area (assets are resolved once per activation).
+            for ( u32 assetIdx = 0u; assetIdx < slot.Content.AssetCount; assetIdx++ ) {
+                slot.Models[assetIdx] = ( settings.ResolveModel != nullptr ) ? settings.ResolveModel( settings.UserData, slot.Content.getAssetPath( assetIdx ) ) : nullptr;
+            }
+
+            slot.State.store( AREA_STATE_TRANSITION, std::memory_order_relaxed );
+
+            // Start the activation right away (if the budget allows it).
+            continue;
+
+        case AREA_STATE_MISSING:
+            if ( !slot.IsWanted ) {
+                releaseSlot( residentIdx );
+                continue;
+            }
+            break;
+
+        case AREA_STATE_ACTIVE:
+            if ( slot.IsWanted ) {
+                activeAreaCount++;
+                break;
+            }
+
+            slot.State.store( AREA_STATE_TRANSITION, std::memory_order_relaxed );
+            continue;
+
+        case AREA_STATE_TRANSITION:
+            if ( !updateTransition( slot, spawnFunction, releaseFunction, userData, budgetTimer ) ) {
+                transitionAreaCount++;
+                break;
+            }
+
+            if ( !slot.IsWanted ) {
+                releaseSlot( residentIdx );
+                continue;
+            }
+
+            slot.State.store( AREA_STATE_ACTIVE, std::memory_order_relaxed );
+            activeAreaCount++;
+            break;
+
+        default:
+            DUSK_DEV_ASSERT( false, "Invalid area state!" );
+            break;
+        }
+
+        residentIdx++;
+    }
+}
+
+void AreaStreaming::unloadAll( dkAreaReleaseFunction_t releaseFunction, void* userData )
+{
+    if ( !isCreated ) {
+        return;
+    }
+
+    // Wait for the pending reads.
+    if ( jobSystem != nullptr ) {
+        jobSystem->wait( &loadCounter );
+    }
+
+    for ( u32 residentIdx = 0u; residentIdx < residentAreaCount; residentIdx++ ) {
+        AreaSlot& slot = areaSlots[residentSlots[residentIdx]];
+        for ( u32 entityIdx = 0u; entityIdx < slot.SpawnedEntityCount; entityIdx++ ) {
+            releaseFunction( userData, slot.SpawnedEntities[entityIdx] );
+        }
+    }
+
+    while ( residentAreaCount != 0u ) {
+        releaseSlot( residentAreaCount - 1u );
+    }
+
+    activeAreaCount = 0u;
+    pendingLoadCount = 0u;
+    transitionAreaCount = 0u;
+}
+
+size_t AreaStreaming::SerializeArea( const char** assetPaths, const u32 assetCount, const AreaEntity* entities, const char** entityNames, const u32 entityCount, u8* areaData )
+{
+    size_t stringTableSize = 0;
+    for ( u32 assetIdx = 0u; assetIdx < assetCount; assetIdx++ ) {
+        stringTableSize += strlen( assetPaths[assetIdx] ) + 1;
+    }
+
+    for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+        stringTableSize += strlen( entityNames[entityIdx] ) + 1;
+    }
+
+    const size_t entityListSize = sizeof( AreaEntity ) * entityCount;
+    const size_t assetListSize = sizeof( u32 ) * assetCount;
+    const size_t areaDataSize = sizeof( AreaHeader ) + entityListSize + assetListSize + stringTableSize;
+
+    if ( areaData == nullptr ) {
+        return areaDataSize;
+    }
+
+    AreaHeader header = {};
+    header.Magic = AREA_FILE_MAGIC;
+    header.Version = AREA_FILE_VERSION;
+    header.EntityCount = entityCount;
+    header.AssetCount = assetCount;
+    header.StringTableSize = static_cast< u32 >( stringTableSize );
+    memcpy( areaData, &header, sizeof( AreaHeader ) );
+
+    u8* entityList = areaData + sizeof( AreaHeader );
+    u8* assetList = entityList + entityListSize;
+    char* strings = reinterpret_cast< char* >( assetList + assetListSize );
+
+    // Build the string table (asset paths first, then entity names).
+    u32 stringOffset = 0u;
+    for ( u32 assetIdx = 0u; assetIdx < assetCount; assetIdx++ ) {
+        const size_t pathLength = strlen( assetPaths[assetIdx] ) + 1;
+
+        memcpy( assetList + sizeof( u32 ) * assetIdx, &stringOffset, sizeof( u32 ) );
+        memcpy( strings + stringOffset, assetPaths[assetIdx], pathLength );
+        stringOffset += static_cast< u32 >( pathLength );
+    }
+
+    for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+        const size_t nameLength = strlen( entityNames[entityIdx] ) + 1;
+
+        AreaEntity areaEntity = entities[entityIdx];
+        areaEntity.NameOffset = stringOffset;
+        memcpy( entityList + sizeof( AreaEntity ) * entityIdx, &areaEntity, sizeof( AreaEntity ) );
+
+        memcpy( strings + stringOffset, entityNames[entityIdx], nameLength );
+        stringOffset += static_cast< u32 >( nameLength );
+    }
+
+    return areaDataSize;
+}
+
+bool AreaStreaming::DeserializeArea( const u8* areaData, const size_t areaDataSize, AreaContent& content )
+{
+    if ( areaData == nullptr || areaDataSize < sizeof( AreaHeader ) ) {
+        return false;
+    }
+
+    AreaHeader header;
+    memcpy( &header, areaData, sizeof( AreaHeader ) );
+
+    if ( header.Magic != AREA_FILE_MAGIC || header.Version != AREA_FILE_VERSION ) {
+        return false;
+    }
+
+    const u64 entityListSize = static_cast< u64 >( sizeof( AreaEntity ) ) * header.EntityCount;
+    const u64 assetListSize = static_cast< u64 >( sizeof( u32 ) ) * header.AssetCount;
+    const u64 expectedSize = sizeof( AreaHeader ) + entityListSize + assetListSize + header.StringTableSize;
+    if ( areaDataSize != expectedSize ) {
+        return false;
+    }
+
+    const u8* data = areaData + sizeof( AreaHeader );
+    content.Entities = reinterpret_cast< const AreaEntity* >( data );
+    content.AssetPathOffsets = reinterpret_cast< const u32* >( data + entityListSize );
+    content.Strings = reinterpret_cast< const char* >( data + entityListSize + assetListSize );
+    content.EntityCount = header.EntityCount;
+    content.AssetCount = header.AssetCount;
+
+    // Every string must be NUL-terminated (the string table is empty only if nothing references it).
+    const bool hasStrings = ( header.StringTableSize != 0u );
+    if ( hasStrings && content.Strings[header.StringTableSize - 1u] != '\0' ) {
+        return false;
+    }
+
+    for ( u32 assetIdx = 0u; assetIdx < header.AssetCount; assetIdx++ ) {
+        if ( content.AssetPathOffsets[assetIdx] >= header.StringTableSize ) {
+            return false;
+        }
+    }
+
+    for ( u32 entityIdx = 0u; entityIdx < header.EntityCount; entityIdx++ ) {
+        const AreaEntity& entity = content.Entities[entityIdx];
+        if ( entity.NameOffset >= header.StringTableSize ) {
+            return false;
+        }
+
+        if ( entity.ModelAssetIndex != AreaEntity::INVALID_ASSET_INDEX && entity.ModelAssetIndex >= header.AssetCount ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+u32 AreaStreaming::findResidentSlot( const Area& area ) const
+{
+    for ( u32 residentIdx = 0u; residentIdx < residentAreaCount; residentIdx++ ) {
+        if ( areaSlots[residentSlots[residentIdx]].Coordinates == area ) {
+            return residentSlots[residentIdx];
+        }
+    }
+
+    return MAX_RESIDENT_AREA_COUNT;
+}
+
+bool AreaStreaming::requestAreaLoad( const Area& area )
+{
+    if ( residentAreaCount >= MAX_RESIDENT_AREA_COUNT ) {
+        return false;
+    }
+
+    u32 slotIdx = 0u;
+    while ( areaSlots[slotIdx].State.load( std::memory_order_acquire ) != AREA_STATE_FREE ) {
+        slotIdx++;
+    }
+
+    AreaSlot& slot = areaSlots[slotIdx];
+    slot.Coordinates = area;
+    slot.IsWanted = true;
+    slot.State.store( AREA_STATE_LOADING, std::memory_order_relaxed );
+
+    residentSlots[residentAreaCount++] = slotIdx;
+
+    if ( jobSystem == nullptr ) {
+        ReadAreaJob( &slot, 0u );
+        return true;
+    }
+
+    Job* readJob = jobSystem->createJob( &AreaStreaming::ReadAreaJob, &slot );
+    jobSystem->submit( readJob, &loadCounter );
+
+    return true;
+}
+
+bool AreaStreaming::updateTransition( AreaSlot& slot, dkAreaSpawnFunction_t spawnFunction, dkAreaReleaseFunction_t releaseFunction, void* userData, const Timer& budgetTimer )
+{
+    if ( slot.IsWanted ) {
+        while ( slot.SpawnedEntityCount < slot.Content.EntityCount ) {
+            if ( operationCount != 0u && budgetTimer.getElapsedTimeAsMiliseconds() >= settings.ActivationBudget ) {
+                return false;
+            }
+
+            const u32 entityIdx = slot.SpawnedEntityCount;
+            const AreaEntity& areaEntity = slot.Content.Entities[entityIdx];
+            Model* model = ( areaEntity.ModelAssetIndex != AreaEntity::INVALID_ASSET_INDEX ) ? slot.Models[areaEntity.ModelAssetIndex] : nullptr;
+
+            slot.SpawnedEntities[entityIdx] = spawnFunction( userData, areaEntity, slot.Content.getEntityName( entityIdx ), model );
+            slot.SpawnedEntityCount++;
+            operationCount++;
+        }
+    } else {
+        while ( slot.SpawnedEntityCount != 0u ) {
+            if ( operationCount != 0u && budgetTimer.getElapsedTimeAsMiliseconds() >= settings.ActivationBudget ) {
+                return false;
+            }
+
+            slot.SpawnedEntityCount--;
+            releaseFunction( userData, slot.SpawnedEntities[slot.SpawnedEntityCount] );
+            operationCount++;
+        }
+    }
+
+    return true;
+}
+
+void AreaStreaming::releaseSlot( const u32 residentIndex )
+{
+    AreaSlot& slot = areaSlots[residentSlots[residentIndex]];
+
+    // Release the memory of the area (the point of unloading it).
+    freeAreaMemory( slot.Data );
+    freeAreaMemory( slot.Models );
+    freeAreaMemory( slot.SpawnedEntities );
+    slot.Data = nullptr;
+    slot.Models = nullptr;
+    slot.SpawnedEntities = nullptr;
+    slot.SpawnedEntityCount = 0u;
+    slot.Content = {};
+    slot.IsWanted = false;
+    slot.State.store( AREA_STATE_FREE, std::memory_order_release );
+
+    // Keep the resident slots sorted.
+    residentAreaCount--;
+    memmove( &residentSlots[residentIndex], &residentSlots[residentIndex + 1u], sizeof( u32 ) * ( residentAreaCount - residentIndex ) );
+}
+
+void* AreaStreaming::allocateAreaMemory( const size_t size, const u8 alignment )
+{
+    if ( size == 0 ) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock( areaAllocatorLock );
+    return areaAllocator->allocate( size, alignment );
+}
+
+void AreaStreaming::freeAreaMemory( void* memory )
+{
+    if ( memory == nullptr ) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( areaAllocatorLock );
+    areaAllocator->free( memory );
+}
+
+void AreaStreaming::ReadAreaJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    AreaSlot& slot = *static_cast< AreaSlot* >( userData );
+    AreaStreaming* streaming = slot.Owner;
+
+    AreaDataBuffer areaData = { streaming, nullptr, 0 };
+
+    // Missing areas are expected (e.g. empty parts of the world); invalid ones are not.
+    bool isLoaded = streaming->settings.ReadArea( streaming->settings.UserData, slot.Coordinates, areaData );
+    if ( isLoaded && !DeserializeArea( areaData.Data, areaData.Size, slot.Content ) ) {
+        DUSK_LOG_ERROR( "Area (%i, %i) is invalid or corrupted!\n", slot.Coordinates.GridX, slot.Coordinates.GridZ );
+        isLoaded = false;
+    }
+
+    // Allocate the activation data right away (the area can't be activated without it).
+    if ( isLoaded ) {
+        slot.Models = static_cast< Model** >( streaming->allocateAreaMemory( sizeof( Model* ) * slot.Content.AssetCount, alignof( Model* ) ) );
+        slot.SpawnedEntities = static_cast< Entity* >( streaming->allocateAreaMemory( sizeof( Entity ) * slot.Content.EntityCount, alignof( Entity ) ) );
+
+        const bool isOutOfMemory = ( slot.Content.AssetCount != 0u && slot.Models == nullptr )
+                                || ( slot.Content.EntityCount != 0u && slot.SpawnedEntities == nullptr );
+        if ( isOutOfMemory ) {
+            DUSK_LOG_ERROR( "Failed to load area (%i, %i): out of streaming memory (see AreaStreamingSettings::MemorySize)!\n", slot.Coordinates.GridX, slot.Coordinates.GridZ );
+            isLoaded = false;
+        }
+    }
+
+    if ( !isLoaded ) {
+        streaming->freeAreaMemory( areaData.Data );
+        streaming->freeAreaMemory( slot.Models );
+        streaming->freeAreaMemory( slot.SpawnedEntities );
+        slot.Models = nullptr;
+        slot.SpawnedEntities = nullptr;
+        slot.Content = {};
+    }
 
+    slot.Data = ( isLoaded ) ? areaData.Data : nullptr;
+    slot.State.store( isLoaded ? AREA_STATE_LOADED : AREA_STATE_MISSING, std::memory_order_release );
 }
@@ -4,34 +4,335 @@
 */
 #pragma once
 
+class BaseAllocator;
+class FreeListAllocator;
+class JobSystem;
+class Model;
+class Timer;
+class AreaStreaming;
+
+#include <Maths/Vector.h>
+#include <Maths/Quaternion.h>
+
+#include <Core/JobSystem.h>
+
+#include "Entity.h"
 #include "Cameras/Camera.h"
 
-struct Area 
+#include <atomic>
+#include <mutex>
+
+struct Area
 {
     // Size of a single area (in world units).
-    static constexpr f32 DIMENSION = 32.0f;
+    static constexpr f32 DIMENSION = 128.0f;
 
     // Area X coordinate on the world grid (horizontal).
     i32 GridX;
 
-    // Area Y coordinate on the world grid (height).
-    i32 GridY;
-
     // Area Z coordinate on the world grid (vertical).
-    //i32 GridZ;
+    i32 GridZ;
+
+    // Return this area world origin (its min corner on the XZ plane).
+    dkVec3f getAreaWorldOrigin() const { return dkVec3f( static_cast< f32 >( GridX ), 0.0f, static_cast< f32 >( GridZ ) ) * DIMENSION; }
+
+    // Return this area world location (its center; not its origin!).
+    dkVec3f getAreaWorldLocation() const { return getAreaWorldOrigin() + dkVec3f( DIMENSION * 0.5f, 0.0f, DIMENSION * 0.5f ); }
+
+    bool operator == ( const Area& area ) const { return GridX == area.GridX && GridZ == area.GridZ; }
+};
+
+// Entity serialized in an area file (stored as is).
+struct AreaEntity
+{
+    // Value of ModelAssetIndex for entities without model.
+    static constexpr u32 INVALID_ASSET_INDEX = ~0u;
 
-    //// Return this area world origin (top left up of the area).
-    //dkVec3f getAreaWorldOrigin() const { return dkVec3f( static_cast< f32 >( GridX ), static_cast< f32 >( GridY ), static_cast< f32 >( GridZ ) ) * DIMENSION; }
+    dkVec3f Position;
+    dkQuatf Rotation;
+    dkVec3f Scale;
 
-    //// Return this area world location (its center; not its origin!).
-    //dkVec3f getAreaWorldLocation() const { return getAreaWorldOrigin() + dkVec3f( DIMENSION * 0.5f ); }
+    // Offset of the entity name in the area string table.
+    u32     NameOffset;
+
+    // Index of the entity model in the area asset list (or INVALID_ASSET_INDEX).
+    u32     ModelAssetIndex;
+};
+
+// Serialized area (read-only view of the data of an area file). An area file is made of:
+//  - a header
+//  - the entity list (AreaEntity)
+//  - the asset list (offset of each asset path in the string table)
+//  - a string table (NUL-terminated strings; entity names and asset paths)
+struct AreaContent
+{
+    // Return the path of an asset of the asset list.
+    const char* getAssetPath( const u32 assetIndex ) const { return &Strings[AssetPathOffsets[assetIndex]]; }
+
+    // Return the name of an entity of the entity list.
+    const char* getEntityName( const u32 entityIndex ) const { return &Strings[Entities[entityIndex].NameOffset]; }
+
+    const char*         Strings;
+    const u32*          AssetPathOffsets;
+    const AreaEntity*   Entities;
+    u32                 AssetCount;
+    u32                 EntityCount;
 };
 
-class AreaStreaming 
+// Memory receiving the serialized data of an area being read.
+struct AreaDataBuffer
 {
+    // Allocate the memory of the area data (once per read; the memory is owned by the streaming). Return null if the
+    // streaming memory is exhausted.
+    u8*             allocate( const size_t size );
+
+    AreaStreaming*  Owner;
+    u8*             Data;
+    size_t          Size;
+};
+
+// Read the serialized data of an area (called from a JobSystem worker; several areas might be read concurrently).
+// Return false if the area does not exist.
+using dkAreaReadFunction_t = bool( * )( void* userData, const Area& area, AreaDataBuffer& areaData );
+
+// Return the model matching an asset path of an area asset list (called once per asset when the area is activated).
+using dkAreaResolveModelFunction_t = Model*( * )( void* userData, const char* assetPath );
+
+// Spawn an entity of an area being activated (called from the thread updating the streaming). Return the spawned entity.
+using dkAreaSpawnFunction_t = Entity( * )( void* userData, const AreaEntity& areaEntity, const char* name, Model* model );
+
+// Release an entity spawned by an area being deactivated (called from the thread updating the streaming).
+using dkAreaReleaseFunction_t = void( * )( void* userData, Entity& entity );
+
+struct AreaStreamingSettings
+{
+    // Areas closer than LoadRadius (in world units; on the XZ plane) to any anchor are loaded and activated.
+    f32                             LoadRadius;
+
+    // Active areas are deactivated and unloaded once farther than LoadRadius + UnloadHysteresis from every anchor
+    // (avoids loading/unloading the same areas if an anchor oscillates around an area border).
+    f32                             UnloadHysteresis;
+
+    // Maximum time (in milliseconds) spent per update to spawn/release the entities of the areas. The activation of an
+    // area is spread over several updates if needed.
+    f64                             ActivationBudget;
+
+    // Size (in bytes) of the memory reserved for the resident areas (serialized data, resolved models and spawned
+    // entities).
+    size_t                          MemorySize;
+
+    // Callbacks used to read the areas and resolve their assets (see dkAreaReadFunction_t/dkAreaResolveModelFunction_t).
+    // ResolveModel is optional (entities are spawned without model).
+    dkAreaReadFunction_t            ReadArea;
+    dkAreaResolveModelFunction_t    ResolveModel;
+    void*                           UserData;
+
+    AreaStreamingSettings()
+        : LoadRadius( 256.0f )
+        , UnloadHysteresis( 64.0f )
+        , ActivationBudget( 2.0 )
+        , MemorySize( 64 << 20 )
+        , ReadArea( nullptr )
+        , ResolveModel( nullptr )
+        , UserData( nullptr )
+    {
+
+    }
+};
+
+// Cell-based world streaming. The world is split in areas (a uniform grid on the XZ plane) serialized in their own file.
+// Areas are read and deserialized asynchronously (one job per area) around the streaming anchors (e.g. cameras and
+// vehicles); the entities of the loaded areas are then spawned (and released once the areas are out of range) within a
+// per-update time budget, closest areas first.
+class AreaStreaming
+{
+public:
+    // Maximum number of streaming anchors.
+    static constexpr u32 MAX_ANCHOR_COUNT = 16u;
+
+    // Anchor set by updateFromCameraView (the other anchors are owned by the callers of setAnchor).
+    static constexpr u32 CAMERA_ANCHOR_INDEX = 0u;
+
+    // Maximum number of areas resident in memory (loading; loaded or active).
+    static constexpr u32 MAX_RESIDENT_AREA_COUNT = 256u;
+
+    // Area file identifier and version.
+    static constexpr u32 AREA_FILE_MAGIC = 0x41524541; // 'AREA'
+    static constexpr u32 AREA_FILE_VERSION = 1u;
+
+public:
+    // Return true if the streaming has been created.
+    DUSK_INLINE bool    isEnabled() const { return isCreated; }
+
+    // Return the number of areas resident in memory.
+    DUSK_INLINE u32     getResidentAreaCount() const { return residentAreaCount; }
+
+    // Return the number of areas whose entities are all spawned.
+    DUSK_INLINE u32     getActiveAreaCount() const { return activeAreaCount; }
+
+    // Return the number of areas being read (or waiting to be read).
+    DUSK_INLINE u32     getPendingLoadCount() const { return pendingLoadCount; }
+
+    // Return the number of areas being activated or deactivated.
+    DUSK_INLINE u32     getTransitionAreaCount() const { return transitionAreaCount; }
+
 public:
-            AreaStreaming();
+            AreaStreaming( BaseAllocator* allocator, JobSystem* jobSystem = nullptr );
+            AreaStreaming( AreaStreaming& ) = delete;
+            AreaStreaming& operator = ( AreaStreaming& ) = delete;
             ~AreaStreaming();
 
+    // Create the streaming. Areas are read synchronously (during the update) if the streaming has no JobSystem.
+    void    create( const AreaStreamingSettings& streamingSettings );
+
+    // Set (or move) a streaming anchor. Anchors are persistent: an anchor is used by every update until it is removed.
+    void    setAnchor( const u32 anchorIndex, const dkVec3f& worldPosition );
+
+    // Remove a streaming anchor (does nothing if the anchor is not set).
+    void    removeAnchor( const u32 anchorIndex );
+
+    // Move the camera anchor (CAMERA_ANCHOR_INDEX) to the position of a camera.
     void    updateFromCameraView( const CameraData& camera );
+
+    // Update the residency of the areas (using the current anchors) and spawn/release the entities of the areas within
+    // the activation budget.
+    void    update( dkAreaSpawnFunction_t spawnFunction, dkAreaReleaseFunction_t releaseFunction, void* userData );
+
+    // Release the entities of every active area and unload every area (blocks until the pending reads are completed).
+    void    unloadAll( dkAreaReleaseFunction_t releaseFunction, void* userData );
+
+    // Serialize an area (the NameOffset of the given entities is ignored; 'entityNames' holds the name of each entity).
+    // Return the size of the serialized area; 'areaData' can be null to retrieve the size only.
+    static size_t SerializeArea( const char** assetPaths, const u32 assetCount, const AreaEntity* entities, const char** entityNames, const u32 entityCount, u8* areaData = nullptr );
+
+    // Validate serialized area data and fill 'content' (which points to 'areaData'). Return false if the data is invalid.
+    static bool DeserializeArea( const u8* areaData, const size_t areaDataSize, AreaContent& content );
+
+private:
+    friend struct AreaDataBuffer;
+
+private:
+    enum eAreaState : u32 {
+        // The slot is unused.
+        AREA_STATE_FREE = 0,
+
+        // The area is waiting to be read (or is being read).
+        AREA_STATE_LOADING,
+
+        // The area has been read (but none of its entities are spawned).
+        AREA_STATE_LOADED,
+
+        // The area does not exist (or its data is invalid); kept resident until out of range to avoid reading it again.
+        AREA_STATE_MISSING,
+
+        // The entities of the area are being spawned (or released, if the area is not wanted anymore).
+        AREA_STATE_TRANSITION,
+
+        // Every entity of the area has been spawned.
+        AREA_STATE_ACTIVE,
+    };
+
+    struct AreaSlot {
+        // Streaming owning this slot.
+        AreaStreaming*          Owner;
+
+        // Coordinates of the area.
+        Area                    Coordinates;
+
+        // Current state of the area (written by the read job while loading; see eAreaState).
+        std::atomic<u32>        State;
+
+        // True if the area should be active; false if it should be unloaded.
+        bool                    IsWanted;
+
+        // Distance (on the XZ plane) to the closest anchor of the latest update.
+        f32                     AnchorDistance;
+
+        // Serialized data of the area and its content (valid once loaded).
+        u8*                     Data;
+        AreaContent             Content;
+
+        // Model of each asset of the asset list (resolved when the area activation starts; allocated once loaded).
+        Model**                 Models;
+
+        // Entities spawned so far (the entities of the area are spawned in order; allocated once loaded).
+        Entity*                 SpawnedEntities;
+        u32                     SpawnedEntityCount;
+
+        AreaSlot()
+            : Owner( nullptr )
+            , Coordinates{ 0, 0 }
+            , State( AREA_STATE_FREE )
+            , IsWanted( false )
+            , AnchorDistance( 0.0f )
+            , Data( nullptr )
+            , Content{}
+            , Models( nullptr )
+            , SpawnedEntities( nullptr )
+            , SpawnedEntityCount( 0u )
+        {
+
+        }
+    };
+
+private:
+    // The memory allocator owning this instance.
+    BaseAllocator*          memoryAllocator;
+
+    // JobSystem executing the area reads (optional).
+    JobSystem*              jobSystem;
+
+    // Allocator of the resident areas memory (shared by the read jobs; protected by areaAllocatorLock).
+    FreeListAllocator*      areaAllocator;
+    std::mutex              areaAllocatorLock;
+
+    // Counter of the read jobs in flight.
+    JobCounter              loadCounter;
+
+    // Settings of the streaming.
+    AreaStreamingSettings   settings;
+
+    // Area slots.
+    AreaSlot*               areaSlots;
+
+    // Streaming anchors (bit N of anchorMask is set if anchors[N] is used).
+    dkVec3f                 anchors[MAX_ANCHOR_COUNT];
+    u32                     anchorMask;
+
+    // Resident slots (sorted by distance to the closest anchor during the update).
+    u32                     residentSlots[MAX_RESIDENT_AREA_COUNT];
+    u32                     residentAreaCount;
+
+    // Number of entities spawned/released by the current update (at least one operation is done per update, whatever
+    // the budget).
+    u32                     operationCount;
+
+    // Statistics of the latest update.
+    u32                     activeAreaCount;
+    u32                     pendingLoadCount;
+    u32                     transitionAreaCount;
+
+    // True once the streaming has been created.
+    bool                    isCreated;
+
+private:
+    // Return the resident slot of an area (or MAX_RESIDENT_AREA_COUNT if the area is not resident).
+    u32     findResidentSlot( const Area& area ) const;
+
+    // Allocate (or free) resident area memory (thread-safe). Return null if the memory is exhausted.
+    void*   allocateAreaMemory( const size_t size, const u8 alignment );
+    void    freeAreaMemory( void* memory );
+
+    // Allocate a slot for an area and submit its read. Return false if no slot is available.
+    bool    requestAreaLoad( const Area& area );
+
+    // Spawn/release the entities of an area in transition (stops once 'budgetTimer' exceeds the activation budget).
+    // Return true if the transition is completed.
+    bool    updateTransition( AreaSlot& slot, dkAreaSpawnFunction_t spawnFunction, dkAreaReleaseFunction_t releaseFunction, void* userData, const Timer& budgetTimer );
+
+    // Release the memory of an area and free its slot.
+    void    releaseSlot( const u32 residentIndex );
+
+    // Read and deserialize the area of a slot (userData is the AreaSlot).
+    static void ReadAreaJob( void* userData, const u32 workerIndex );
 };
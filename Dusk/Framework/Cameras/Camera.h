@@ -50,6 +50,10 @@ struct CameraData
         struct {
             uint8_t enableTAA : 1;
 
+            // If set, the LOD of each instance is reused from the selection of the main camera (camera with the lowest
+            // index without this flag) instead of being selected for this camera.
+            uint8_t isLowPriority : 1;
+
             uint8_t : 0;
         } flags;
 
@@ -235,6 +235,11 @@ CameraData& FreeCamera::getData()
     return data;
 }
 
+const CameraData& FreeCamera::getData() const
+{
+    return data;
+}
+
 void FreeCamera::setMSAASamplerCount( const uint32_t samplerCount )
 {
     data.msaaSamplerCount = Max( 1u, samplerCount );
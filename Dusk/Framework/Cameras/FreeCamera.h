@@ -60,6 +60,7 @@ public:
     dkVec3f         getOrientation() const { return dkVec3f( yaw, pitch, roll ); }
 
     CameraData&     getData();
+    const CameraData& getData() const;
 
     decltype( CameraData::flags )& getUpdatableFlagset()
     {
@@ -7,12 +7,19 @@
 
 #include "Entity.h"
 
+// Number of pages required to map every entity index.
+static constexpr size_t SPARSE_PAGE_COUNT = ( ( static_cast< size_t >( Entity::INDEX_MASK ) + 1 ) + ComponentDatabase::SPARSE_PAGE_SIZE - 1 ) / ComponentDatabase::SPARSE_PAGE_SIZE;
+
 ComponentDatabase::ComponentDatabase( BaseAllocator* allocator )
-    : memoryAllocator( allocator )
+    : entities( nullptr )
+    , sparsePages( nullptr )
+    , memoryAllocator( allocator )
+    , componentArrayCount( 0 )
 {
     databaseBuffer.AllocationCount = 0;
     databaseBuffer.Capacity = 0;
     databaseBuffer.MemoryUsed = 0;
+    databaseBuffer.ComponentSize = 0;
     databaseBuffer.Data = nullptr;
 }
 
@@ -20,17 +27,34 @@ ComponentDatabase::~ComponentDatabase()
 {
     if ( databaseBuffer.Data != nullptr ) {
         dk::core::freeArray( memoryAllocator, reinterpret_cast< u8* >( databaseBuffer.Data ) );
+        dk::core::freeArray( memoryAllocator, entities );
+    }
+
+    if ( sparsePages != nullptr ) {
+        for ( size_t pageIdx = 0; pageIdx < SPARSE_PAGE_COUNT; pageIdx++ ) {
+            if ( sparsePages[pageIdx] != nullptr ) {
+                dk::core::freeArray( memoryAllocator, sparsePages[pageIdx] );
+            }
+        }
+
+        dk::core::freeArray( memoryAllocator, sparsePages );
     }
 }
 
 Instance ComponentDatabase::lookup( const Entity& entity ) const
 {
-    return entityToInstanceMap.at( static_cast< size_t >( entity.extractIndex() ) );
+    const size_t entityIndex = static_cast< size_t >( entity.extractIndex() );
+    const Instance* page = sparsePages[entityIndex / SPARSE_PAGE_SIZE];
+
+    return ( page != nullptr ) ? page[entityIndex % SPARSE_PAGE_SIZE] : Instance();
 }
 
 bool ComponentDatabase::hasComponent( const Entity& e ) const
 {
-    return entityToInstanceMap.find( static_cast< size_t >( e.extractIndex() ) ) != entityToInstanceMap.end();
+    const Instance instance = lookup( e );
+
+    // The owner check discards stale entities (same index; different generation).
+    return instance.isValid() && entities[instance.getIndex()].getIdentifier() == e.getIdentifier();
 }
 
 void ComponentDatabase::removeComponent( const Entity& e )
@@ -39,8 +63,27 @@ void ComponentDatabase::removeComponent( const Entity& e )
         return;
     }
 
-    freeInstances.push( lookup( e ) );
-    entityToInstanceMap.at( static_cast< size_t >( e.extractIndex() ) ) = Instance();
+    const size_t instanceIndex = lookup( e ).getIndex();
+    const size_t lastInstanceIndex = ( databaseBuffer.AllocationCount - 1 );
+
+    // Move the last instance to the removed slot to keep the instances packed.
+    if ( instanceIndex != lastInstanceIndex ) {
+        for ( size_t arrayIdx = 0; arrayIdx < componentArrayCount; arrayIdx++ ) {
+            const ComponentArray& componentArray = componentArrays[arrayIdx];
+            memcpy( componentArray.Data + instanceIndex * componentArray.ElementSize, 
+                    componentArray.Data + lastInstanceIndex * componentArray.ElementSize, 
+                    componentArray.ElementSize );
+        }
+
+        entities[instanceIndex] = entities[lastInstanceIndex];
+        mapEntity( entities[instanceIndex], Instance( instanceIndex ) );
+    }
+
+    entities[lastInstanceIndex] = Entity();
+    mapEntity( e, Instance() );
+
+    --databaseBuffer.AllocationCount;
+    databaseBuffer.MemoryUsed -= databaseBuffer.ComponentSize;
 }
 
 void ComponentDatabase::allocateMemoryChunk( const size_t singleComponentSize, const size_t componentCount )
@@ -50,5 +93,44 @@ void ComponentDatabase::allocateMemoryChunk( const size_t singleComponentSize, c
     databaseBuffer.AllocationCount = 0;
     databaseBuffer.Capacity = componentCount;
     databaseBuffer.MemoryUsed = 0;
+    databaseBuffer.ComponentSize = singleComponentSize;
     databaseBuffer.Data = dk::core::allocateArray<u8>( memoryAllocator, allocationSize );
+
+    entities = dk::core::allocateArray<Entity>( memoryAllocator, componentCount );
+
+    // Pages are allocated on demand (value initialized to nullptr).
+    sparsePages = dk::core::allocateArray<Instance*>( memoryAllocator, SPARSE_PAGE_COUNT );
+}
+
+Instance ComponentDatabase::allocateInstance( const Entity& entity )
+{
+    DUSK_ASSERT( databaseBuffer.AllocationCount < databaseBuffer.Capacity, "Component database is full! (capacity: %llu)", static_cast< u64 >( databaseBuffer.Capacity ) );
+    DUSK_DEV_ASSERT( !hasComponent( entity ), "Entity already has a component attached!" );
+
+    const Instance instance( databaseBuffer.AllocationCount );
+    ++databaseBuffer.AllocationCount;
+    databaseBuffer.MemoryUsed += databaseBuffer.ComponentSize;
+
+    entities[instance.getIndex()] = entity;
+    mapEntity( entity, instance );
+
+    return instance;
+}
+
+void ComponentDatabase::mapEntity( const Entity& entity, const Instance instance )
+{
+    const size_t entityIndex = static_cast< size_t >( entity.extractIndex() );
+    Instance*& page = sparsePages[entityIndex / SPARSE_PAGE_SIZE];
+
+    if ( page == nullptr ) {
+        // Unmapping an entity never requires a page allocation.
+        if ( !instance.isValid() ) {
+            return;
+        }
+
+        // Entries are default constructed (invalid instance).
+        page = dk::core::allocateArray<Instance>( memoryAllocator, SPARSE_PAGE_SIZE );
+    }
+
+    page[entityIndex % SPARSE_PAGE_SIZE] = instance;
 }
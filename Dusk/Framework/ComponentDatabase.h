@@ -5,10 +5,8 @@
 #pragma once
 
 class BaseAllocator;
-struct Entity;
 
-#include <unordered_map>
-#include <queue>
+#include "Entity.h"
 
 struct Instance
 {
@@ -33,20 +31,42 @@ private:
     size_t index;
 };
 
+// Sparse set mapping entities to component instances. The entity index is used to address a paged sparse table
+// (pages are allocated on demand) holding the instance of the entity. Instances are packed in the dense component
+// arrays [0..getInstanceCount()[: removing a component moves the last instance to the removed slot (swap-remove) so
+// that iterating the dense arrays only visits live instances. An instance index stays valid until a component is removed
+// from the database.
 class ComponentDatabase
 {
+public:
+    // Number of entries of a page of the sparse table.
+    static constexpr size_t SPARSE_PAGE_SIZE = 4096;
+
+    // Maximum number of component arrays registered by a database.
+    static constexpr size_t MAX_COMPONENT_ARRAY_COUNT = 16;
+
+public:
+    // Return the number of instances allocated by this database.
+    DUSK_INLINE size_t          getInstanceCount() const { return databaseBuffer.AllocationCount; }
+
+    // Return the entity owning a given instance.
+    DUSK_INLINE const Entity&   getOwner( const Instance instance ) const { return entities[instance.getIndex()]; }
+
 public:
                 ComponentDatabase( BaseAllocator* allocator );
+                ComponentDatabase( ComponentDatabase& ) = delete;
+                ComponentDatabase& operator = ( ComponentDatabase& ) = delete;
                 ~ComponentDatabase();
 
-    // Return the instance associated to a given entity.
+    // Return the instance associated to a given entity (or an invalid instance if the entity don't have a component
+    // attached).
     Instance    lookup( const Entity& e ) const;
 
     // Return true if the given entity has a component from this database; false otherwise.
     bool        hasComponent( const Entity& e ) const;
 
     // Remove the component attached to the given entity (does nothing if the given entity
-    // don't have a component attached).
+    // don't have a component attached). The last instance of the database is moved to the removed slot.
     void        removeComponent( const Entity& e );
 
 protected:
@@ -60,17 +80,27 @@ protected:
         // The current memory usage for this database (in bytes).
         size_t MemoryUsed;
 
+        // The size of a single component (in bytes).
+        size_t ComponentSize;
+
         // The raw pointer to the allocated memory chunk (owned by memoryAllocator).
         void* Data;
     };
 
+    struct ComponentArray {
+        // The first element of the array.
+        u8*     Data;
+
+        // The size of the data of a single instance (in bytes).
+        size_t  ElementSize;
+    };
+
 protected:
-    // An array of references to the entities that are using this component.
-    std::vector<Entity*> entities;
+    // The entity owning each instance (dense; indexed by instance index).
+    Entity* entities;
 
-    // Hashmap for quick entity to instance lookup. The key is the entity index, the value
-    // its linked instance.
-    std::unordered_map<size_t, Instance> entityToInstanceMap;
+    // Sparse table for quick entity to instance lookup (indexed by entity index; pages are allocated on demand).
+    Instance** sparsePages;
 
     // A structure describing informations related to the memory used by this database.
     MemoryBuffer databaseBuffer;
@@ -78,11 +108,31 @@ protected:
     // The allocator owning this database.
     BaseAllocator* memoryAllocator;
 
-	std::queue<Instance>    freeInstances;
+    // Component arrays moved by a swap-remove.
+    ComponentArray componentArrays[MAX_COMPONENT_ARRAY_COUNT];
+
+    // Number of registered component arrays.
+    size_t componentArrayCount;
 
 protected:
     // Allocate the "raw" memory chunk used to allocate the entries of the database.
     // singleComponentSize is the size of a single component (in bytes) and componentCount
     // is the maximum number of component allocable from this database.
     void allocateMemoryChunk( const size_t singleComponentSize, const size_t componentCount );
+
+    // Allocate an instance at the end of the dense arrays and map it to the given entity.
+    Instance allocateInstance( const Entity& entity );
+
+    // Map an entity to a given instance (the entity is unmapped if the instance is invalid).
+    void mapEntity( const Entity& entity, const Instance instance );
+
+    // Register a component array (moved when a component is removed). 'elementCountPerInstance' is the number of
+    // elements owned by a single instance.
+    template<typename T>
+    void registerComponentArray( T* array, const size_t elementCountPerInstance = 1 )
+    {
+        DUSK_ASSERT( componentArrayCount < MAX_COMPONENT_ARRAY_COUNT, "Too many component arrays! (please raise MAX_COMPONENT_ARRAY_COUNT)" );
+
+        componentArrays[componentArrayCount++] = { reinterpret_cast< u8* >( array ), sizeof( T ) * elementCountPerInstance };
+    }
 };
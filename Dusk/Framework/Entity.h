@@ -4,6 +4,16 @@
 */
 #pragma once
 
+// Entity handle layout (index in the low bits; generation in the high bits). Can be overridden at build time (see
+// DUSK_ENTITY_INDEX_BITS/DUSK_ENTITY_GENERATION_BITS in the root CMakeLists).
+#ifndef DUSK_ENTITY_INDEX_BITS
+#define DUSK_ENTITY_INDEX_BITS 22
+#endif
+
+#ifndef DUSK_ENTITY_GENERATION_BITS
+#define DUSK_ENTITY_GENERATION_BITS 10
+#endif
+
 struct Entity
 {
 private:
@@ -11,18 +21,20 @@ private:
     u32             identifier;
 
 public:
-    static constexpr u32 INDEX_BITS = 22;
-    static constexpr u32 INDEX_MASK = ( 1 << INDEX_BITS ) - 1;
+    static constexpr u32 INDEX_BITS = DUSK_ENTITY_INDEX_BITS;
+    static constexpr u32 INDEX_MASK = ( 1u << INDEX_BITS ) - 1u;
+
+    static constexpr u32 GENERATION_BITS = DUSK_ENTITY_GENERATION_BITS;
+    static constexpr u32 GENERATION_MASK = ( 1u << GENERATION_BITS ) - 1u;
 
-    static constexpr u32 GENERATION_BITS = 8;
-    static constexpr u32 GENERATION_MASK = ( 1 << GENERATION_BITS ) - 1;
+    static_assert( INDEX_BITS > 0 && GENERATION_BITS > 0 && ( INDEX_BITS + GENERATION_BITS ) <= 32, "Entity handle must fit in 32 bits!" );
 
     static constexpr u32 INVALID_ID = ~0;
 
     static constexpr u32 MAX_NAME_LENGTH = 256;
 
 public:
-            Entity( const u32 id = INVALID_ID, const u32 generation = INVALID_ID ) : identifier( id | generation << GENERATION_BITS ) {}
+            Entity( const u32 id = INVALID_ID, const u32 generation = INVALID_ID ) : identifier( ( id == INVALID_ID ) ? INVALID_ID : ( ( id & INDEX_MASK ) | ( ( generation & GENERATION_MASK ) << INDEX_BITS ) ) ) {}
 
     // Return true if the entity has been allocated correctly and is valid; false otherwise.
     bool    isValid() const { return identifier != INVALID_ID; }
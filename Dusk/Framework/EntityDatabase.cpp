@@ -5,49 +5,137 @@
 #include <Shared.h>
 #include "EntityDatabase.h"
 
-EntityDatabase::EntityDatabase()
+// Generation of a retired index (does not fit in an Entity handle; never matches an handle generation).
+static constexpr u32 RETIRED_GENERATION = ( Entity::GENERATION_MASK + 1u );
+
+EntityDatabase::EntityDatabase( BaseAllocator* allocator )
+    : memoryAllocator( allocator )
+    , generations( nullptr )
+    , freeIndices( nullptr )
+    , capacity( 0u )
+    , allocatedIndexCount( 0u )
+    , freeIndexHead( 0u )
+    , freeIndexCount( 0u )
+    , retiredIndexCount( 0u )
 {
 
 }
 
 EntityDatabase::~EntityDatabase()
 {
+    if ( generations != nullptr ) {
+        dk::core::freeArray( memoryAllocator, generations );
+        dk::core::freeArray( memoryAllocator, freeIndices );
+    }
+}
+
+void EntityDatabase::create( const u32 entityCapacity )
+{
+    DUSK_DEV_ASSERT( generations == nullptr, "EntityDatabase has already been created!" );
 
+    capacity = Min( entityCapacity, MAX_ENTITY_COUNT );
+
+    generations = dk::core::allocateArray<u32>( memoryAllocator, capacity, 0u );
+    freeIndices = dk::core::allocateArray<u32>( memoryAllocator, capacity, 0u );
 }
 
 Entity EntityDatabase::allocateEntity()
 {
-    constexpr u32 MINIMUM_FREE_INDICES = 1024u;
+    Entity entity;
+    allocateEntities( &entity, 1u );
+
+    return entity;
+}
+
+void EntityDatabase::allocateEntities( Entity* entities, const u32 entityCount )
+{
+    DUSK_ASSERT( entityCount <= ( capacity - allocatedIndexCount + freeIndexCount ), "EntityDatabase is full! (capacity: %u)", capacity );
+
+    // Recycle released indices first (only the indices above the free queue minimum length).
+    u32 recycledCount = Min( getRecyclableIndexCount(), entityCount );
+
+    // Then use never allocated indices (the free queue minimum is ignored once every index has been allocated).
+    const u32 freshCount = Min( entityCount - recycledCount, capacity - allocatedIndexCount );
+    recycledCount = ( entityCount - freshCount );
 
-    u32 entityIndex = Entity::INVALID_ID;
-    if ( freeIndices.size() > MINIMUM_FREE_INDICES ) {
-        entityIndex = freeIndices.front();
-        freeIndices.pop_front();
-    } else {
-        entityIndex = static_cast< u32 >( generationArray.size() );
-        generationArray.push_back( 0 );
+    for ( u32 entityIdx = 0u; entityIdx < recycledCount; entityIdx++ ) {
+        const u32 entityIndex = freeIndices[freeIndexHead];
+        freeIndexHead = ( freeIndexHead + 1u == capacity ) ? 0u : freeIndexHead + 1u;
+
+        entities[entityIdx] = Entity( entityIndex, generations[entityIndex] );
     }
+    freeIndexCount -= recycledCount;
 
-    return Entity( entityIndex, generationArray[entityIndex] );
+    for ( u32 entityIdx = 0u; entityIdx < freshCount; entityIdx++ ) {
+        const u32 entityIndex = allocatedIndexCount + entityIdx;
+        entities[recycledCount + entityIdx] = Entity( entityIndex, generations[entityIndex] );
+    }
+    allocatedIndexCount += freshCount;
 }
 
 void EntityDatabase::releaseEntity( const Entity entity )
 {
-    const u32 extractedIndex = entity.extractIndex();
-    ++generationArray[extractedIndex];
-    freeIndices.push_back( extractedIndex );
+    releaseEntities( &entity, 1u );
+}
+
+void EntityDatabase::releaseEntities( const Entity* entities, const u32 entityCount )
+{
+    for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+        DUSK_DEV_ASSERT( isEntityAlive( entities[entityIdx] ), "Entity is not alive (released twice?)" );
+
+        releaseIndex( entities[entityIdx].extractIndex() );
+    }
 }
 
 bool EntityDatabase::isEntityAlive( const Entity entity ) const
 {
+    if ( !entity.isValid() ) {
+        return false;
+    }
+
     const u32 extractedIndex = entity.extractIndex();
     const u32 extractedGeneration = entity.extractGenerationIndex();
 
-    return ( generationArray[extractedIndex] == extractedGeneration );
+    return ( extractedIndex < allocatedIndexCount && generations[extractedIndex] == extractedGeneration );
 }
 
 void EntityDatabase::reset()
 {
-    generationArray.clear();
-    freeIndices.clear();
+    // Indices are released (instead of cleared) so that the entities allocated prior to the reset stay invalid.
+    freeIndexHead = 0u;
+    freeIndexCount = 0u;
+    retiredIndexCount = 0u;
+
+    for ( u32 entityIndex = 0u; entityIndex < allocatedIndexCount; entityIndex++ ) {
+        if ( generations[entityIndex] == RETIRED_GENERATION ) {
+            retiredIndexCount++;
+        } else {
+            releaseIndex( entityIndex );
+        }
+    }
+}
+
+u32 EntityDatabase::getRecyclableIndexCount() const
+{
+    return ( freeIndexCount > MIN_FREE_INDEX_COUNT ) ? ( freeIndexCount - MIN_FREE_INDEX_COUNT ) : 0u;
+}
+
+void EntityDatabase::releaseIndex( const u32 entityIndex )
+{
+    // Retire the index if its generation is about to wrap (a stale handle would match a new entity).
+    if ( generations[entityIndex] == Entity::GENERATION_MASK ) {
+        generations[entityIndex] = RETIRED_GENERATION;
+        retiredIndexCount++;
+        return;
+    }
+
+    generations[entityIndex]++;
+
+    u32 freeIndexTail = freeIndexHead + freeIndexCount;
+    if ( freeIndexTail >= capacity ) {
+        freeIndexTail -= capacity;
+    }
+
+    freeIndices[freeIndexTail] = entityIndex;
+    freeIndexCount++;
 }
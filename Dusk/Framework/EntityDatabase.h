@@ -4,23 +4,51 @@
 */
 #pragma once
 
-#include <vector>
-#include <deque>
+class BaseAllocator;
 
 #include "Entity.h"
 
+// Entity allocator. The generation of each index is incremented when the entity is released (stale handles are
+// detected by comparing generations). Released indices are recycled once the free queue holds more than
+// MIN_FREE_INDEX_COUNT indices (which delays the reuse of an index and therefore generation wrapping). An index whose
+// generation would wrap is retired (never reused).
 class EntityDatabase
 {
 public:
-            EntityDatabase();
+    // Minimum number of released indices waiting in the free queue before an index is recycled.
+    static constexpr u32 MIN_FREE_INDEX_COUNT = 1024u;
+
+    // Maximum number of entities (the last index is reserved so that a valid handle never matches Entity::INVALID_ID).
+    static constexpr u32 MAX_ENTITY_COUNT = Entity::INDEX_MASK;
+
+public:
+    // Return the number of entities currently alive.
+    DUSK_INLINE u32 getAliveEntityCount() const { return allocatedIndexCount - freeIndexCount - retiredIndexCount; }
+
+    // Return the number of retired indices (generation exhausted).
+    DUSK_INLINE u32 getRetiredIndexCount() const { return retiredIndexCount; }
+
+public:
+            EntityDatabase( BaseAllocator* allocator );
+            EntityDatabase( EntityDatabase& ) = delete;
+            EntityDatabase& operator = ( EntityDatabase& ) = delete;
             ~EntityDatabase();
 
+    // Create the database with a given entity capacity (clamped to MAX_ENTITY_COUNT).
+    void    create( const u32 entityCapacity );
+
     // Allocate an entity and return it.
     Entity  allocateEntity();
 
+    // Allocate 'entityCount' entities and write them to 'entities'.
+    void    allocateEntities( Entity* entities, const u32 entityCount );
+
     // Release the given entity to make it reusable.
     void    releaseEntity( const Entity entity );
 
+    // Release 'entityCount' entities (every entity must be alive).
+    void    releaseEntities( const Entity* entities, const u32 entityCount );
+
     // Return true if the given entity is still alive and valid; false otherwise.
     bool    isEntityAlive( const Entity entity ) const;
 
@@ -28,7 +56,34 @@ public:
     void    reset();
 
 private:
-    // TODO Custom allocation/container scheme to avoid expensive realloc at runtime.
-    std::vector<u32>    generationArray;
-    std::deque<u32>     freeIndices;
+    // The allocator owning this database.
+    BaseAllocator*  memoryAllocator;
+
+    // Current generation of each index (RETIRED_GENERATION if the index is retired).
+    u32*            generations;
+
+    // Released indices (ring buffer of 'capacity' entries).
+    u32*            freeIndices;
+
+    // Maximum number of indices allocable from this database.
+    u32             capacity;
+
+    // Number of indices allocated so far (indices [0..allocatedIndexCount[ have been used at least once).
+    u32             allocatedIndexCount;
+
+    // Position of the oldest released index in the free queue.
+    u32             freeIndexHead;
+
+    // Number of released indices in the free queue.
+    u32             freeIndexCount;
+
+    // Number of indices retired (generation exhausted).
+    u32             retiredIndexCount;
+
+private:
+    // Return the number of indices which can be recycled from the free queue.
+    u32     getRecyclableIndexCount() const;
+
+    // Increment the generation of an index and push it to the free queue (or retire it).
+    void    releaseIndex( const u32 entityIndex );
 };
@@ -31,22 +31,17 @@ void EnvironmentProbeDatabase::create( const size_t dbCapacity )
     instanceData.InverseModelMatrix = reinterpret_cast< dkMat4x4f* >( instanceData.Radius + dbCapacity );
     instanceData.ArrayIndex = reinterpret_cast< i32* >( instanceData.InverseModelMatrix + dbCapacity );
     instanceData.DirtyFlags = reinterpret_cast< u32* >( instanceData.ArrayIndex + dbCapacity );
+
+    registerComponentArray( instanceData.Radius );
+    registerComponentArray( instanceData.InverseModelMatrix );
+    registerComponentArray( instanceData.ArrayIndex );
+    registerComponentArray( instanceData.DirtyFlags );
 }
 
 void EnvironmentProbeDatabase::allocateComponent( Entity& entity )
 {
     // Update buffer infos.
-    Instance instance;
-    if ( !freeInstances.empty() ) {
-        instance = freeInstances.front();
-        freeInstances.pop();
-    } else {
-		instance = Instance( databaseBuffer.AllocationCount );
-		++databaseBuffer.AllocationCount;
-		databaseBuffer.MemoryUsed += ENVPROBE_SINGLE_ENTRY_SIZE;
-    }
-
-    entityToInstanceMap[entity.extractIndex()] = instance;
+    const Instance instance = allocateInstance( entity );
 
     // Initialize this instance components.
     const size_t instanceIndex = instance.getIndex();
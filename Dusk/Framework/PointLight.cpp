@@ -9,7 +9,7 @@
 
 #include "Graphics/LightingConstants.h"
 
-constexpr size_t POINT_LIGHT_SINGLE_ENTRY_SIZE = sizeof( PointLightGPU ) + sizeof( Entity );
+constexpr size_t POINT_LIGHT_SINGLE_ENTRY_SIZE = sizeof( PointLightGPU );
 
 PointLightDatabase::PointLightDatabase( BaseAllocator* allocator )
     : ComponentDatabase( allocator )
@@ -30,26 +30,16 @@ void PointLightDatabase::create( const size_t dbCapacity )
     // Assign each component offset from the memory chunk we have allocated (we don't want to interleave the data for
     // cache coherency).
     instanceData.PointLight = static_cast< PointLightGPU* >( databaseBuffer.Data );
-    instanceData.Owner = reinterpret_cast< Entity* >( instanceData.PointLight + dbCapacity );
+
+    registerComponentArray( instanceData.PointLight );
 }
 
 void PointLightDatabase::allocateComponent( Entity& entity )
 {
-	// Update buffer infos.
-	Instance instance;
-	if ( !freeInstances.empty() ) {
-		instance = freeInstances.front();
-		freeInstances.pop();
-	} else {
-		instance = Instance( databaseBuffer.AllocationCount );
-		++databaseBuffer.AllocationCount;
-		databaseBuffer.MemoryUsed += POINT_LIGHT_SINGLE_ENTRY_SIZE;
-	}
-
-    entityToInstanceMap[entity.extractIndex()] = instance;
+    // Update buffer infos.
+    const Instance instance = allocateInstance( entity );
 
     // Initialize this instance components.
     const size_t instanceIndex = instance.getIndex();
     instanceData.PointLight[instanceIndex] = PointLightGPU{ dk::graphics::MercuryVaporBulb.Color, 1600.0f, dkVec3f::Zero, 2.0f };
-    instanceData.Owner[instanceIndex] = entity;
 }
@@ -30,7 +30,6 @@ public:
 private:
     struct InstanceData {
         PointLightGPU*  PointLight;
-        Entity*         Owner;
     };
 
 private:
@@ -0,0 +1,223 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "SpatialGrid.h"
+
+#include "Entity.h"
+
+#include <Maths/Frustum.h>
+#include <Maths/FrustumCulling.h>
+#include <Maths/Helpers.h>
+
+constexpr size_t SPATIAL_GRID_SINGLE_ENTRY_SIZE = sizeof( AABB ) + 3 * sizeof( u32 );
+
+// Value of an empty link.
+static constexpr u32 INVALID_LINK = ~0u;
+
+// Return the squared distance between a point and a box (0 if the point is inside the box).
+static f32 DistanceToAABBSquared( const AABB& aabb, const dkVec3f& point )
+{
+    const dkVec3f closestPoint = dkVec3f::min( dkVec3f::max( point, aabb.minPoint ), aabb.maxPoint );
+    return dkVec3f::distanceSquared( point, closestPoint );
+}
+
+SpatialGrid::SpatialGrid( BaseAllocator* allocator )
+    : ComponentDatabase( allocator )
+    , cellFirstInstance( nullptr )
+    , cellBounds( nullptr )
+    , isCellBoundsDirty( nullptr )
+{
+
+}
+
+SpatialGrid::~SpatialGrid()
+{
+    if ( cellFirstInstance != nullptr ) {
+        dk::core::freeArray( memoryAllocator, cellFirstInstance );
+        dk::core::freeArray( memoryAllocator, cellBounds );
+        dk::core::freeArray( memoryAllocator, isCellBoundsDirty );
+    }
+}
+
+void SpatialGrid::create( const size_t dbCapacity )
+{
+    // Do the database memory allocation.
+    allocateMemoryChunk( SPATIAL_GRID_SINGLE_ENTRY_SIZE, dbCapacity );
+
+    // Assign each component offset from the memory chunk we have allocated (we don't want to interleave the data for
+    // cache coherency).
+    instanceData.Bounds = static_cast< AABB* >( databaseBuffer.Data );
+    instanceData.Cell = reinterpret_cast< u32* >( instanceData.Bounds + dbCapacity );
+    instanceData.PrevInCell = instanceData.Cell + dbCapacity;
+    instanceData.NextInCell = instanceData.PrevInCell + dbCapacity;
+
+    // Cell links are patched by removeComponent (they don't need to be moved).
+    registerComponentArray( instanceData.Bounds );
+    registerComponentArray( instanceData.Cell );
+
+    cellFirstInstance = dk::core::allocateArray<u32>( memoryAllocator, CELL_COUNT, INVALID_LINK );
+    cellBounds = dk::core::allocateArray<AABB>( memoryAllocator, CELL_COUNT );
+    isCellBoundsDirty = dk::core::allocateArray<bool>( memoryAllocator, CELL_COUNT, false );
+}
+
+void SpatialGrid::allocateComponent( Entity& entity, const AABB& bounds )
+{
+    // Update buffer infos.
+    const Instance instance = allocateInstance( entity );
+
+    // Initialize this instance components.
+    const u32 instanceIndex = static_cast< u32 >( instance.getIndex() );
+    instanceData.Bounds[instanceIndex] = bounds;
+
+    linkInstance( instanceIndex );
+}
+
+void SpatialGrid::removeComponent( const Entity& e )
+{
+    if ( !hasComponent( e ) ) {
+        return;
+    }
+
+    const u32 instanceIndex = static_cast< u32 >( lookup( e ).getIndex() );
+    const u32 lastInstanceIndex = static_cast< u32 >( databaseBuffer.AllocationCount - 1 );
+
+    isCellBoundsDirty[instanceData.Cell[instanceIndex]] = true;
+    unlinkInstance( instanceIndex );
+
+    // The last instance is moved to the removed slot: relink it once moved.
+    if ( instanceIndex != lastInstanceIndex ) {
+        unlinkInstance( lastInstanceIndex );
+        ComponentDatabase::removeComponent( e );
+        linkInstance( instanceIndex );
+    } else {
+        ComponentDatabase::removeComponent( e );
+    }
+}
+
+void SpatialGrid::setBounds( const Instance instance, const AABB& bounds )
+{
+    const u32 instanceIndex = static_cast< u32 >( instance.getIndex() );
+    const u32 previousCell = instanceData.Cell[instanceIndex];
+
+    // The previous bounds might be the ones defining the cell bounds.
+    isCellBoundsDirty[previousCell] = true;
+
+    instanceData.Bounds[instanceIndex] = bounds;
+
+    if ( GetCellIndex( bounds ) != previousCell ) {
+        unlinkInstance( instanceIndex );
+        linkInstance( instanceIndex );
+    } else {
+        dk::maths::ExpandAABB( cellBounds[previousCell], bounds );
+    }
+}
+
+void SpatialGrid::updateCellBounds()
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    for ( u32 cellIdx = 0u; cellIdx < CELL_COUNT; cellIdx++ ) {
+        if ( !isCellBoundsDirty[cellIdx] ) {
+            continue;
+        }
+
+        const u32 firstInstance = cellFirstInstance[cellIdx];
+        if ( firstInstance != INVALID_LINK ) {
+            AABB bounds = instanceData.Bounds[firstInstance];
+            for ( u32 instanceIdx = instanceData.NextInCell[firstInstance]; instanceIdx != INVALID_LINK; instanceIdx = instanceData.NextInCell[instanceIdx] ) {
+                dk::maths::ExpandAABB( bounds, instanceData.Bounds[instanceIdx] );
+            }
+
+            cellBounds[cellIdx] = bounds;
+        }
+
+        isCellBoundsDirty[cellIdx] = false;
+    }
+}
+
+u32 SpatialGrid::query( const Query* queries, const u32 queryCount, u32* instanceIndexes ) const
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    u32 instanceCount = 0u;
+    for ( u32 cellIdx = 0u; cellIdx < CELL_COUNT; cellIdx++ ) {
+        const u32 firstInstance = cellFirstInstance[cellIdx];
+        if ( firstInstance == INVALID_LINK ) {
+            continue;
+        }
+
+        const AABB& bounds = cellBounds[cellIdx];
+
+        bool isCellVisible = false;
+        for ( u32 queryIdx = 0u; queryIdx < queryCount && !isCellVisible; queryIdx++ ) {
+            const Query& query = queries[queryIdx];
+
+            isCellVisible = ( dk::maths::CullAABBInfReversedZ( *query.ViewFrustum, bounds ) > 0.0f )
+                         || ( query.Range >= 0.0f && DistanceToAABBSquared( bounds, query.Origin ) <= ( query.Range * query.Range ) );
+        }
+
+        if ( !isCellVisible ) {
+            continue;
+        }
+
+        for ( u32 instanceIdx = firstInstance; instanceIdx != INVALID_LINK; instanceIdx = instanceData.NextInCell[instanceIdx] ) {
+            instanceIndexes[instanceCount++] = instanceIdx;
+        }
+    }
+
+    return instanceCount;
+}
+
+u32 SpatialGrid::GetCellIndex( const AABB& bounds )
+{
+    constexpr f32 GRID_HALF_EXTENT = ( CELL_COUNT_PER_AXIS * CELL_SIZE * 0.5f );
+    constexpr f32 MAX_CELL_COORDINATE = static_cast< f32 >( CELL_COUNT_PER_AXIS - 1u );
+
+    const dkVec3f boundsCenter = dk::maths::GetAABBCentroid( bounds );
+
+    // Entities outside of the grid belong to the closest border cell.
+    const f32 cellX = Min( Max( floorf( ( boundsCenter.x + GRID_HALF_EXTENT ) / CELL_SIZE ), 0.0f ), MAX_CELL_COORDINATE );
+    const f32 cellZ = Min( Max( floorf( ( boundsCenter.z + GRID_HALF_EXTENT ) / CELL_SIZE ), 0.0f ), MAX_CELL_COORDINATE );
+
+    return static_cast< u32 >( cellZ ) * CELL_COUNT_PER_AXIS + static_cast< u32 >( cellX );
+}
+
+void SpatialGrid::linkInstance( const u32 instanceIndex )
+{
+    const u32 cellIndex = GetCellIndex( instanceData.Bounds[instanceIndex] );
+    const u32 firstInstance = cellFirstInstance[cellIndex];
+
+    instanceData.Cell[instanceIndex] = cellIndex;
+    instanceData.PrevInCell[instanceIndex] = INVALID_LINK;
+    instanceData.NextInCell[instanceIndex] = firstInstance;
+
+    if ( firstInstance != INVALID_LINK ) {
+        instanceData.PrevInCell[firstInstance] = instanceIndex;
+        dk::maths::ExpandAABB( cellBounds[cellIndex], instanceData.Bounds[instanceIndex] );
+    } else {
+        cellBounds[cellIndex] = instanceData.Bounds[instanceIndex];
+    }
+
+    cellFirstInstance[cellIndex] = instanceIndex;
+}
+
+void SpatialGrid::unlinkInstance( const u32 instanceIndex )
+{
+    const u32 cellIndex = instanceData.Cell[instanceIndex];
+    const u32 prevInstance = instanceData.PrevInCell[instanceIndex];
+    const u32 nextInstance = instanceData.NextInCell[instanceIndex];
+
+    if ( prevInstance != INVALID_LINK ) {
+        instanceData.NextInCell[prevInstance] = nextInstance;
+    } else {
+        cellFirstInstance[cellIndex] = nextInstance;
+    }
+
+    if ( nextInstance != INVALID_LINK ) {
+        instanceData.PrevInCell[nextInstance] = prevInstance;
+    }
+
+    isCellBoundsDirty[cellIndex] = true;
+}
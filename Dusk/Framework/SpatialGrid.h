@@ -0,0 +1,105 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class BaseAllocator;
+struct Frustum;
+struct Entity;
+
+#include <Maths/AABB.h>
+
+#include "ComponentDatabase.h"
+
+// Uniform grid of loose cells (on the XZ plane) storing the bounds of entities. An entity belongs to the cell containing
+// the center of its bounds and the bounds of a cell are the union of the bounds of its entities (an entity may overlap
+// the neighbouring cells). Entities outside of the grid belong to the closest border cell. Queries only test the bounds
+// of the cells: every entity of a cell passing a query is returned (precise culling is left to the caller).
+class SpatialGrid : public ComponentDatabase
+{
+public:
+    // Number of cells along the X and Z axis.
+    static constexpr u32 CELL_COUNT_PER_AXIS = 64u;
+
+    // Total number of cells.
+    static constexpr u32 CELL_COUNT = ( CELL_COUNT_PER_AXIS * CELL_COUNT_PER_AXIS );
+
+    // Size of a cell (in world units). The grid is centered on the world origin.
+    static constexpr f32 CELL_SIZE = 64.0f;
+
+    struct Query {
+        // Frustum (infinite reversed Z) the cells are tested against.
+        const Frustum*  ViewFrustum;
+
+        // Cells closer than 'Range' to 'Origin' pass the query even if they are outside of the frustum (e.g. shadow
+        // casters). Set 'Range' to a negative value to disable the range test.
+        dkVec3f         Origin;
+        f32             Range;
+    };
+
+public:
+    // Return the bounds of a given instance.
+    DUSK_INLINE const AABB& getBounds( const Instance instance ) const { return instanceData.Bounds[instance.getIndex()]; }
+
+public:
+            SpatialGrid( BaseAllocator* allocator );
+            ~SpatialGrid();
+
+    // Create an instance of this database with a given entry count 'dbCapacity'.
+    void    create( const size_t dbCapacity );
+
+    // Allocate a component for a given entity (with its initial world space bounds).
+    void    allocateComponent( Entity& entity, const AABB& bounds );
+
+    // Remove the component attached to the given entity (does nothing if the given entity don't have a component
+    // attached).
+    void    removeComponent( const Entity& e );
+
+    // Update the world space bounds of an instance (the instance is moved to another cell if needed).
+    void    setBounds( const Instance instance, const AABB& bounds );
+
+    // Recompute the bounds of the cells whose entities have moved or have been removed (call once the bounds of the
+    // frame are up to date; cell bounds are conservative until then).
+    void    updateCellBounds();
+
+    // Write the index of the instances of the cells passing at least one of the queries to 'instanceIndexes' (each
+    // instance is written once; the array must be large enough to hold every instance). Return the number of instances
+    // written.
+    u32     query( const Query* queries, const u32 queryCount, u32* instanceIndexes ) const;
+
+private:
+    struct InstanceData {
+        // World space bounds.
+        AABB*           Bounds;
+
+        // Index of the cell owning the instance.
+        u32*            Cell;
+
+        // Links to the previous/next instances of the same cell (INVALID_LINK if none).
+        u32*            PrevInCell;
+        u32*            NextInCell;
+    };
+
+private:
+    InstanceData        instanceData;
+
+    // First instance of each cell (INVALID_LINK if the cell is empty).
+    u32*                cellFirstInstance;
+
+    // Bounds of each cell (union of the bounds of its instances).
+    AABB*               cellBounds;
+
+    // True if the bounds of a cell must be recomputed (an instance has moved or has been removed).
+    bool*               isCellBoundsDirty;
+
+private:
+    // Return the index of the cell owning the given bounds.
+    static u32  GetCellIndex( const AABB& bounds );
+
+    // Add an instance to the cell matching its bounds.
+    void        linkInstance( const u32 instanceIndex );
+
+    // Remove an instance from its cell.
+    void        unlinkInstance( const u32 instanceIndex );
+};
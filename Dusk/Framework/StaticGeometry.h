@@ -29,7 +29,6 @@ public:
 private:
     struct InstanceData {
         Model**         ModelResource;
-        Entity*         Owner;
     };
 
 private:
@@ -8,17 +8,47 @@
 #include "Entity.h"
 #include "Maths/MatrixTransformations.h"
 
-constexpr size_t TRANSFORM_SINGLE_ENTRY_SIZE = sizeof( dkVec3f ) * 2 + sizeof( dkQuatf ) + sizeof( Entity ) + 2 * sizeof( dkMat4x4f ) + 4 * sizeof( Instance );
+#include <Core/JobSystem.h>
 
-TransformDatabase::TransformDatabase( BaseAllocator* allocator )
-    : ComponentDatabase( allocator )
+constexpr size_t TRANSFORM_SINGLE_ENTRY_SIZE = sizeof( dkVec3f ) * 2 + sizeof( dkQuatf ) + 2 * sizeof( dkMat4x4f ) + 4 * sizeof( Instance ) + sizeof( u8 ) + sizeof( bool );
+
+// Move the live instances of 'array' to their new index (reorderBuffer must be large enough to hold the array).
+template<typename T>
+static void ReorderArray( T* array, u8* reorderBuffer, const size_t* remapTable, const size_t instanceCount, const size_t liveInstanceCount )
 {
+    T* reorderedArray = reinterpret_cast< T* >( reorderBuffer );
+    for ( size_t idx = 0; idx < instanceCount; idx++ ) {
+        if ( remapTable[idx] != Instance::INVALID_INDEX ) {
+            reorderedArray[remapTable[idx]] = array[idx];
+        }
+    }
 
+    memcpy( array, reorderedArray, sizeof( T ) * liveInstanceCount );
 }
 
-TransformDatabase::~TransformDatabase()
+// Return the new handle of an instance (or an invalid handle if the instance is invalid).
+static Instance RemapInstance( const Instance instance, const size_t* remapTable )
 {
+    return ( instance.isValid() ) ? Instance( remapTable[instance.getIndex()] ) : Instance();
+}
 
+TransformDatabase::TransformDatabase( BaseAllocator* allocator, JobSystem* jobSystem )
+    : ComponentDatabase( allocator )
+    , jobSystem( jobSystem )
+    , levelCount( 0u )
+    , isHierarchyDirty( false )
+    , reorderBuffer( nullptr )
+    , remapTable( nullptr )
+{
+    memset( levelOffsets, 0, sizeof( size_t ) * ( MAX_HIERARCHY_DEPTH + 1 ) );
+}
+
+TransformDatabase::~TransformDatabase()
+{
+    if ( reorderBuffer != nullptr ) {
+        dk::core::freeArray( memoryAllocator, reorderBuffer );
+        dk::core::freeArray( memoryAllocator, remapTable );
+    }
 }
 
 void TransformDatabase::create( const size_t dbCapacity )
@@ -31,87 +61,306 @@ void TransformDatabase::create( const size_t dbCapacity )
     instanceData.Position = static_cast< dkVec3f* >( databaseBuffer.Data );
     instanceData.Rotation = reinterpret_cast< dkQuatf* >( instanceData.Position + dbCapacity );
     instanceData.Scale = reinterpret_cast< dkVec3f* >( instanceData.Rotation + dbCapacity );
-    instanceData.Owner = reinterpret_cast< Entity* >( instanceData.Scale + dbCapacity );
-    instanceData.Local = reinterpret_cast< dkMat4x4f* >( instanceData.Owner + dbCapacity );
+    instanceData.Local = reinterpret_cast< dkMat4x4f* >( instanceData.Scale + dbCapacity );
     instanceData.World = instanceData.Local + dbCapacity;
     instanceData.Parent = reinterpret_cast< Instance* >( instanceData.World + dbCapacity );
     instanceData.FirstChild = instanceData.Parent + dbCapacity;
     instanceData.NextSibling = instanceData.FirstChild + dbCapacity;
     instanceData.PrevSibling = instanceData.NextSibling + dbCapacity;
+    instanceData.DirtyFlags = reinterpret_cast< u8* >( instanceData.PrevSibling + dbCapacity );
+    instanceData.IsWorldUpdated = reinterpret_cast< bool* >( instanceData.DirtyFlags + dbCapacity );
+
+    reorderBuffer = dk::core::allocateArray<u8>( memoryAllocator, sizeof( dkMat4x4f ) * dbCapacity );
+    remapTable = dk::core::allocateArray<size_t>( memoryAllocator, dbCapacity );
 }
 
 void TransformDatabase::allocateComponent( Entity& entity )
 {
     // Update buffer infos.
-    Instance instance;
-    if ( !freeInstances.empty() ) {
-        instance = freeInstances.front();
-        freeInstances.pop();
-    } else {
-		instance = Instance( databaseBuffer.AllocationCount );
-		++databaseBuffer.AllocationCount;
-		databaseBuffer.MemoryUsed += TRANSFORM_SINGLE_ENTRY_SIZE;
-    }
-
-    entityToInstanceMap[entity.extractIndex()] = instance;
+    const Instance instance = allocateInstance( entity );
 
     // Initialize this instance components.
     const size_t instanceIndex = instance.getIndex();
     instanceData.Position[instanceIndex] = dkVec3f::Zero;
     instanceData.Rotation[instanceIndex] = dkQuatf::Identity;
     instanceData.Scale[instanceIndex] = dkVec3f( 1.0f, 1.0f, 1.0f );
-    instanceData.Owner[instanceIndex] = entity;
     instanceData.Local[instanceIndex] = dkMat4x4f::Identity;
     instanceData.World[instanceIndex] = dkMat4x4f::Identity;
     instanceData.Parent[instanceIndex] = Instance();
     instanceData.FirstChild[instanceIndex] = Instance();
     instanceData.NextSibling[instanceIndex] = Instance();
     instanceData.PrevSibling[instanceIndex] = Instance();
+    instanceData.DirtyFlags[instanceIndex] = ( DIRTY_LOCAL | DIRTY_WORLD );
+    instanceData.IsWorldUpdated[instanceIndex] = false;
+
+    // A new instance is a root; roots are stored before the deeper levels.
+    if ( levelCount <= 1u ) {
+        levelCount = 1u;
+        levelOffsets[1] = databaseBuffer.AllocationCount;
+    } else {
+        isHierarchyDirty = true;
+    }
+}
+
+void TransformDatabase::removeComponent( const Entity& e )
+{
+    if ( !hasComponent( e ) ) {
+        return;
+    }
+
+    const Instance instance = lookup( e );
+
+    // Children become roots.
+    Instance child = instanceData.FirstChild[instance.getIndex()];
+    while ( child.isValid() ) {
+        const Instance nextChild = instanceData.NextSibling[child.getIndex()];
+        detachFromParent( child );
+        child = nextChild;
+    }
+
+    detachFromParent( instance );
+
+    // Removed instances are discarded (and the database compacted) by the next update (the hierarchy links prevent
+    // a swap-remove).
+    entities[instance.getIndex()] = Entity();
+    mapEntity( e, Instance() );
+
+    isHierarchyDirty = true;
 }
 
 void TransformDatabase::setLocal( Instance i, const dkMat4x4f& m )
 {
     instanceData.Local[i.getIndex()] = m;
+    instanceData.DirtyFlags[i.getIndex()] |= DIRTY_WORLD;
+}
+
+void TransformDatabase::setParent( const Instance instance, const Instance parent )
+{
+    DUSK_DEV_ASSERT( instance.isValid(), "Invalid instance!" );
+
+    const size_t instanceIndex = instance.getIndex();
+    if ( instanceData.Parent[instanceIndex].getIndex() == parent.getIndex() ) {
+        return;
+    }
+
+#if DUSK_DEVBUILD
+    // An instance can't be attached to one of its descendants.
+    for ( Instance ancestor = parent; ancestor.isValid(); ancestor = instanceData.Parent[ancestor.getIndex()] ) {
+        DUSK_DEV_ASSERT( ancestor.getIndex() != instanceIndex, "Cyclic transform hierarchy!" );
+    }
+#endif
+
+    detachFromParent( instance );
 
-    Instance parent = instanceData.Parent[i.getIndex()];
-    dkMat4x4f parentModel = parent.isValid() ? instanceData.World[parent.getIndex()] : dkMat4x4f::Identity;
-    applyParentMatrixRecurse( parentModel, i );
+    if ( parent.isValid() ) {
+        const size_t parentIndex = parent.getIndex();
+        const Instance firstChild = instanceData.FirstChild[parentIndex];
+
+        instanceData.Parent[instanceIndex] = parent;
+        instanceData.NextSibling[instanceIndex] = firstChild;
+        instanceData.PrevSibling[instanceIndex] = Instance();
+
+        if ( firstChild.isValid() ) {
+            instanceData.PrevSibling[firstChild.getIndex()] = instance;
+        }
+        instanceData.FirstChild[parentIndex] = instance;
+    }
+
+    instanceData.DirtyFlags[instanceIndex] |= DIRTY_WORLD;
+    isHierarchyDirty = true;
 }
 
 void TransformDatabase::update( const f32 deltaTime )
 {
-    // TODO: Improvements (multithread the database update; mark instance as dirty to avoid unecessary updates; etc.).
-    for ( size_t idx = 0; idx < databaseBuffer.AllocationCount; idx++ ) {
-		dkMat4x4f translationMatrix = dk::maths::MakeTranslationMat( instanceData.Position[idx] );
-		dkMat4x4f rotationMatrix = instanceData.Rotation[idx].toMat4x4();
-		dkMat4x4f scaleMatrix = dk::maths::MakeScaleMat( instanceData.Scale[idx] );
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    if ( isHierarchyDirty ) {
+        rebuildHierarchy();
+    }
 
-        dkMat4x4f modelMatrix = translationMatrix * rotationMatrix * scaleMatrix;
-        setLocal( Instance( idx ), modelMatrix );
+    // The parent of an instance always belongs to the previous level (which has been updated by then).
+    for ( u32 levelIdx = 0; levelIdx < levelCount; levelIdx++ ) {
+        updateLevel( levelOffsets[levelIdx], levelOffsets[levelIdx + 1] );
     }
 }
 
+#if DUSK_DEVBUILD
 TransformDatabase::EdInstanceData TransformDatabase::getEditorInstanceData( const Instance instance )
 {
     size_t instanceIndex = instance.getIndex();
 
+    // The instance is most likely edited by the caller.
+    instanceData.DirtyFlags[instanceIndex] |= DIRTY_LOCAL;
+
     EdInstanceData editorData;
     editorData.Position = &instanceData.Position[instanceIndex];
     editorData.Rotation = &instanceData.Rotation[instanceIndex];
     editorData.Scale = &instanceData.Scale[instanceIndex];
     editorData.Local = &instanceData.Local[instanceIndex];
     editorData.World = &instanceData.World[instanceIndex];
+    editorData.DirtyFlags = &instanceData.DirtyFlags[instanceIndex];
 
     return editorData;
 }
+#endif
 
-void TransformDatabase::applyParentMatrixRecurse( const dkMat4x4f& parent, Instance i )
+void TransformDatabase::rebuildHierarchy()
 {
-    instanceData.World[i.getIndex()] = instanceData.Local[i.getIndex()] * parent;
+    DUSK_CPU_PROFILE_FUNCTION;
 
-    Instance child = instanceData.FirstChild[i.getIndex()];
-    while ( child.isValid() ) {
-        applyParentMatrixRecurse( instanceData.World[i.getIndex()], child );
-        child = instanceData.NextSibling[child.getIndex()];
+    const size_t instanceCount = databaseBuffer.AllocationCount;
+
+    // Compute the depth of each live instance (stored in the remap table until the level offsets are known).
+    size_t levelInstanceCount[MAX_HIERARCHY_DEPTH] = {};
+    levelCount = 0u;
+
+    for ( size_t idx = 0; idx < instanceCount; idx++ ) {
+        if ( !entities[idx].isValid() ) {
+            remapTable[idx] = Instance::INVALID_INDEX;
+            continue;
+        }
+
+        u32 depth = 0u;
+        for ( Instance parent = instanceData.Parent[idx]; parent.isValid(); parent = instanceData.Parent[parent.getIndex()] ) {
+            depth++;
+        }
+
+        DUSK_ASSERT( depth < MAX_HIERARCHY_DEPTH, "Transform hierarchy is too deep! (please raise MAX_HIERARCHY_DEPTH)" );
+
+        remapTable[idx] = depth;
+        levelInstanceCount[depth]++;
+        levelCount = Max( levelCount, depth + 1u );
+    }
+
+    levelOffsets[0] = 0;
+    for ( u32 levelIdx = 0; levelIdx < levelCount; levelIdx++ ) {
+        levelOffsets[levelIdx + 1] = levelOffsets[levelIdx] + levelInstanceCount[levelIdx];
+    }
+
+    const size_t liveInstanceCount = levelOffsets[levelCount];
+
+    // Assign the new index of each instance (instances keep their relative order within a level).
+    size_t levelCursor[MAX_HIERARCHY_DEPTH];
+    memcpy( levelCursor, levelOffsets, sizeof( size_t ) * MAX_HIERARCHY_DEPTH );
+
+    for ( size_t idx = 0; idx < instanceCount; idx++ ) {
+        if ( remapTable[idx] != Instance::INVALID_INDEX ) {
+            remapTable[idx] = levelCursor[remapTable[idx]]++;
+        }
+    }
+
+    ReorderArray( instanceData.Position, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.Rotation, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.Scale, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( entities, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.Local, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.World, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.Parent, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.FirstChild, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.NextSibling, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.PrevSibling, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.DirtyFlags, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+    ReorderArray( instanceData.IsWorldUpdated, reorderBuffer, remapTable, instanceCount, liveInstanceCount );
+
+    // Patch the links and the entity lookup table.
+    for ( size_t idx = 0; idx < liveInstanceCount; idx++ ) {
+        instanceData.Parent[idx] = RemapInstance( instanceData.Parent[idx], remapTable );
+        instanceData.FirstChild[idx] = RemapInstance( instanceData.FirstChild[idx], remapTable );
+        instanceData.NextSibling[idx] = RemapInstance( instanceData.NextSibling[idx], remapTable );
+        instanceData.PrevSibling[idx] = RemapInstance( instanceData.PrevSibling[idx], remapTable );
+
+        mapEntity( entities[idx], Instance( idx ) );
+    }
+
+    // Removed instances have been discarded.
+    databaseBuffer.AllocationCount = liveInstanceCount;
+    databaseBuffer.MemoryUsed = liveInstanceCount * TRANSFORM_SINGLE_ENTRY_SIZE;
+
+    isHierarchyDirty = false;
+}
+
+void TransformDatabase::updateLevel( const size_t begin, const size_t end )
+{
+    const size_t instanceCount = ( end - begin );
+    const u32 taskCount = ( jobSystem != nullptr ) ? static_cast< u32 >( Min( ( instanceCount + MIN_INSTANCE_COUNT_PER_TASK - 1 ) / MIN_INSTANCE_COUNT_PER_TASK, static_cast< size_t >( MAX_TASK_COUNT ) ) ) : 1u;
+
+    if ( taskCount <= 1u ) {
+        tasks[0] = { this, begin, end };
+        UpdateInstancesJob( &tasks[0], JobSystem::INVALID_WORKER_INDEX );
+        return;
+    }
+
+    const size_t instanceCountPerTask = ( instanceCount + taskCount - 1 ) / taskCount;
+
+    JobCounter taskCounter;
+    for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+        const size_t taskBegin = begin + taskIdx * instanceCountPerTask;
+        tasks[taskIdx] = { this, taskBegin, Min( taskBegin + instanceCountPerTask, end ) };
+
+        Job* job = jobSystem->createJob( &TransformDatabase::UpdateInstancesJob, &tasks[taskIdx] );
+        jobSystem->submit( job, &taskCounter );
+    }
+
+    jobSystem->wait( &taskCounter );
+}
+
+void TransformDatabase::detachFromParent( const Instance instance )
+{
+    const size_t instanceIndex = instance.getIndex();
+    const Instance parent = instanceData.Parent[instanceIndex];
+    if ( !parent.isValid() ) {
+        return;
+    }
+
+    const Instance prevSibling = instanceData.PrevSibling[instanceIndex];
+    const Instance nextSibling = instanceData.NextSibling[instanceIndex];
+
+    if ( prevSibling.isValid() ) {
+        instanceData.NextSibling[prevSibling.getIndex()] = nextSibling;
+    } else {
+        instanceData.FirstChild[parent.getIndex()] = nextSibling;
+    }
+
+    if ( nextSibling.isValid() ) {
+        instanceData.PrevSibling[nextSibling.getIndex()] = prevSibling;
+    }
+
+    instanceData.Parent[instanceIndex] = Instance();
+    instanceData.NextSibling[instanceIndex] = Instance();
+    instanceData.PrevSibling[instanceIndex] = Instance();
+    instanceData.DirtyFlags[instanceIndex] |= DIRTY_WORLD;
+
+    isHierarchyDirty = true;
+}
+
+void TransformDatabase::UpdateInstancesJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    UpdateTask& task = *static_cast< UpdateTask* >( userData );
+    InstanceData& instanceData = task.Database->instanceData;
+
+    for ( size_t idx = task.Begin; idx < task.End; idx++ ) {
+        const u8 dirtyFlags = instanceData.DirtyFlags[idx];
+
+        if ( dirtyFlags & DIRTY_LOCAL ) {
+            dkMat4x4f translationMatrix = dk::maths::MakeTranslationMat( instanceData.Position[idx] );
+            dkMat4x4f rotationMatrix = instanceData.Rotation[idx].toMat4x4();
+            dkMat4x4f scaleMatrix = dk::maths::MakeScaleMat( instanceData.Scale[idx] );
+
+            instanceData.Local[idx] = translationMatrix * rotationMatrix * scaleMatrix;
+        }
+
+        // Dirtiness is propagated to the descendants through the world matrix update flag of their parent.
+        const Instance parent = instanceData.Parent[idx];
+        const bool isParentUpdated = ( parent.isValid() && instanceData.IsWorldUpdated[parent.getIndex()] );
+        const bool isWorldDirty = ( dirtyFlags != 0 || isParentUpdated );
+
+        if ( isWorldDirty ) {
+            instanceData.World[idx] = ( parent.isValid() ) ? instanceData.Local[idx] * instanceData.World[parent.getIndex()] : instanceData.Local[idx];
+        }
+
+        instanceData.IsWorldUpdated[idx] = isWorldDirty;
+        instanceData.DirtyFlags[idx] = 0;
     }
 }
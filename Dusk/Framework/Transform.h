@@ -5,6 +5,7 @@
 #pragma once
 
 class BaseAllocator;
+class JobSystem;
 struct Entity;
 
 #include <Maths/Vector.h>
@@ -12,6 +13,10 @@ struct Entity;
 
 #include "ComponentDatabase.h"
 
+// Instances are stored by hierarchy depth (roots first, then their children, etc.) so that each depth level can be
+// updated as a flat (parallel) loop. Only the instances whose transform has been modified (and their descendants) are
+// updated. Changing the hierarchy (parenting or removing an instance) reorders the instances during the next update:
+// instances (and editor instance data) must be looked up again once the database has been updated.
 class TransformDatabase : public ComponentDatabase
 {
 public:
@@ -21,18 +26,45 @@ public:
         dkVec3f* Scale;
         dkMat4x4f* Local;
         dkMat4x4f* World;
+
+        // Dirty flags of the instance (set to DIRTY_LOCAL to update the instance once its data has been modified).
+        u8* DirtyFlags;
+    };
+
+    // Maximum depth of a hierarchy (roots are at depth 0).
+    static constexpr u32 MAX_HIERARCHY_DEPTH = 16u;
+
+    // Maximum number of tasks a depth level can be split into.
+    static constexpr u32 MAX_TASK_COUNT = 16u;
+
+    // Minimum number of instances updated by a task (a smaller level is updated by the calling thread).
+    static constexpr u32 MIN_INSTANCE_COUNT_PER_TASK = 1024u;
+
+    enum eDirtyFlags : u8 {
+        // The local matrix must be rebuilt from the position/rotation/scale of the instance.
+        DIRTY_LOCAL = 1 << 0,
+
+        // The world matrix must be rebuilt (the local matrix has been modified).
+        DIRTY_WORLD = 1 << 1,
     };
 
 public:
     DUSK_INLINE const dkMat4x4f&    getLocalMatrix( const Instance instance ) const { return instanceData.Local[instance.getIndex()]; }
 	DUSK_INLINE const dkMat4x4f&    getWorldMatrix( const Instance instance ) const { return instanceData.World[instance.getIndex()]; }
-    DUSK_INLINE dkMat4x4f&          referenceToLocalMatrix( const Instance instance ) { return instanceData.Local[instance.getIndex()]; }
+    DUSK_INLINE dkMat4x4f&          referenceToLocalMatrix( const Instance instance ) { instanceData.DirtyFlags[instance.getIndex()] |= DIRTY_WORLD; return instanceData.Local[instance.getIndex()]; }
     DUSK_INLINE const dkVec3f&      getWorldPosition( const Instance instance ) const { return instanceData.Position[instance.getIndex()]; }
-    DUSK_INLINE void                setPosition( const Instance instance, const dkVec3f& position ) { instanceData.Position[instance.getIndex()] = position; }
-    DUSK_INLINE void                setRotation( const Instance instance, const dkQuatf& rotation ) { instanceData.Rotation[instance.getIndex()] = rotation; }
+    DUSK_INLINE void                setPosition( const Instance instance, const dkVec3f& position ) { instanceData.Position[instance.getIndex()] = position; instanceData.DirtyFlags[instance.getIndex()] |= DIRTY_LOCAL; }
+    DUSK_INLINE void                setRotation( const Instance instance, const dkQuatf& rotation ) { instanceData.Rotation[instance.getIndex()] = rotation; instanceData.DirtyFlags[instance.getIndex()] |= DIRTY_LOCAL; }
+    DUSK_INLINE void                setScale( const Instance instance, const dkVec3f& scale ) { instanceData.Scale[instance.getIndex()] = scale; instanceData.DirtyFlags[instance.getIndex()] |= DIRTY_LOCAL; }
+
+    // Return true if the world matrix of the instance has been updated by the latest update; false otherwise.
+    DUSK_INLINE bool                isWorldMatrixUpdated( const Instance instance ) const { return instanceData.IsWorldUpdated[instance.getIndex()]; }
+
+    // Return the number of depth levels of the hierarchy (as of the latest update).
+    DUSK_INLINE u32                 getHierarchyDepthCount() const { return levelCount; }
 
 public:
-            TransformDatabase( BaseAllocator* allocator );
+            TransformDatabase( BaseAllocator* allocator, JobSystem* jobSystem = nullptr );
             ~TransformDatabase();
 
     // Create an instance of this database with a given entry count 'dbCapacity'.
@@ -41,9 +73,19 @@ public:
     // Allocate a component for a given entity.
     void    allocateComponent( Entity& entity );
 
-    // Sets the local matrix f
+    // Remove the component attached to the given entity (does nothing if the given entity don't have a component
+    // attached). The children of the instance become roots.
+    void    removeComponent( const Entity& e );
+
+    // Set the local matrix of an instance (the world matrix of the instance and its descendants are updated by the next
+    // update).
     void    setLocal( Instance i, const dkMat4x4f& m );
 
+    // Attach an instance to a parent instance (or detach it if 'parent' is invalid). The hierarchy is reordered by the
+    // next update.
+    void    setParent( const Instance instance, const Instance parent );
+
+    // Update the local and world matrices of the dirty instances (and the world matrices of their descendants).
     void    update( const f32 deltaTime );
 
 #if DUSK_DEVBUILD
@@ -56,18 +98,59 @@ private:
         dkVec3f*        Position;
         dkQuatf*        Rotation;
         dkVec3f*        Scale;
-        Entity*         Owner;
         dkMat4x4f*      Local;
         dkMat4x4f*      World;
         Instance*       Parent;
         Instance*       FirstChild;
         Instance*       NextSibling;
         Instance*       PrevSibling;
+        u8*             DirtyFlags;
+        bool*           IsWorldUpdated;
+    };
+
+    struct UpdateTask {
+        // Database owning this task.
+        TransformDatabase*  Database;
+
+        // Range of instances [Begin..End[ updated by this task.
+        size_t              Begin;
+        size_t              End;
     };
 
 private:
     InstanceData            instanceData;
 
+    // JobSystem used to update the depth levels in parallel (optional).
+    JobSystem*              jobSystem;
+
+    // Offset of the first instance of each depth level (levelOffsets[levelCount] is the end of the deepest level).
+    size_t                  levelOffsets[MAX_HIERARCHY_DEPTH + 1];
+
+    // Number of depth levels.
+    u32                     levelCount;
+
+    // True if the hierarchy has been modified since the latest update (instances must be reordered by depth).
+    bool                    isHierarchyDirty;
+
+    // Scratch memory used to reorder the instances (large enough to hold any component array).
+    u8*                     reorderBuffer;
+
+    // New index of each instance (scratch memory used to reorder the instances).
+    size_t*                 remapTable;
+
+    // Tasks of the level being updated.
+    UpdateTask              tasks[MAX_TASK_COUNT];
+
 private:
-    void    applyParentMatrixRecurse( const dkMat4x4f& parent, Instance i );
+    // Reorder the instances by depth (removed instances are discarded) and rebuild the depth level ranges.
+    void    rebuildHierarchy();
+
+    // Update the instances [begin..end[ (the instances of the range must belong to the same depth level).
+    void    updateLevel( const size_t begin, const size_t end );
+
+    // Detach an instance from its parent (the instance becomes a root).
+    void    detachFromParent( const Instance instance );
+
+    // Update a range of instances (JobSystem entry point; userData is the UpdateTask to execute).
+    static void UpdateInstancesJob( void* userData, const u32 workerIndex );
 };
@@ -13,7 +13,7 @@
 
 #include "Physics/MotorizedVehicle.h"
 
-constexpr size_t VEHICLE_SINGLE_ENTRY_SIZE = sizeof( Entity ) + sizeof( Entity ) * MotorizedVehiclePhysics::MAX_WHEEL_COUNT + sizeof( MotorizedVehiclePhysics* );
+constexpr size_t VEHICLE_SINGLE_ENTRY_SIZE = sizeof( Entity ) * MotorizedVehiclePhysics::MAX_WHEEL_COUNT + sizeof( MotorizedVehiclePhysics* );
 
 VehicleDatabase::VehicleDatabase( BaseAllocator* allocator )
     : ComponentDatabase( allocator )
@@ -33,29 +33,20 @@ void VehicleDatabase::create( const size_t dbCapacity )
 
     // Assign each component offset from the memory chunk we have allocated (we don't want to interleave the data for
     // cache coherency).
-    instanceData.Owner = static_cast< Entity* >( databaseBuffer.Data );
-    instanceData.VehicleWheelsEntity = reinterpret_cast< Entity* >( instanceData.Owner + dbCapacity );
-    instanceData.VehiclePhysics = reinterpret_cast< MotorizedVehiclePhysics** >( instanceData.VehicleWheelsEntity + dbCapacity );
+    instanceData.VehicleWheelsEntity = static_cast< Entity* >( databaseBuffer.Data );
+    instanceData.VehiclePhysics = reinterpret_cast< MotorizedVehiclePhysics** >( instanceData.VehicleWheelsEntity + dbCapacity * MotorizedVehiclePhysics::MAX_WHEEL_COUNT );
+
+    registerComponentArray( instanceData.VehicleWheelsEntity, MotorizedVehiclePhysics::MAX_WHEEL_COUNT );
+    registerComponentArray( instanceData.VehiclePhysics );
 }
 
 void VehicleDatabase::allocateComponent( Entity& entity )
 {
     // Update buffer infos.
-    Instance instance;
-    if ( !freeInstances.empty() ) {
-        instance = freeInstances.front();
-        freeInstances.pop();
-    } else {
-		instance = Instance( databaseBuffer.AllocationCount );
-		++databaseBuffer.AllocationCount;
-		databaseBuffer.MemoryUsed += VEHICLE_SINGLE_ENTRY_SIZE;
-    }
-
-    entityToInstanceMap[entity.extractIndex()] = instance;
+    const Instance instance = allocateInstance( entity );
 
     // Initialize this instance components.
     const size_t instanceIndex = instance.getIndex();
-    instanceData.Owner[instanceIndex] = entity;
     instanceData.VehiclePhysics[instanceIndex] = nullptr;
 
     for ( size_t instanceOffset = instanceIndex * MotorizedVehiclePhysics::MAX_WHEEL_COUNT; instanceOffset < ( instanceIndex + 1 ) * MotorizedVehiclePhysics::MAX_WHEEL_COUNT; instanceOffset++ ) {
@@ -66,10 +57,12 @@ void VehicleDatabase::allocateComponent( Entity& entity )
 void VehicleDatabase::update( const f32 deltaTime, TransformDatabase* transformDatabase )
 {
     // Update vehicle logic (should be logic ONLY; physics updates should stay in the physics subsystems).
-    i32 wheelIdx = 0;
     for ( size_t idx = 0; idx < databaseBuffer.AllocationCount; idx++ ) {
         i32 vehicleWheelCount = instanceData.VehiclePhysics[idx]->getWheelCount();
 
+        // Each instance owns MAX_WHEEL_COUNT wheel entities (see allocateComponent).
+        const size_t wheelIdx = idx * MotorizedVehiclePhysics::MAX_WHEEL_COUNT;
+
         // Update wheels entities.
         for ( i32 i = 0; i < vehicleWheelCount; i++ ) {
             const VehicleWheel& wheelInfos = instanceData.VehiclePhysics[idx]->getWheelByIndex( i );
@@ -87,7 +80,5 @@ void VehicleDatabase::update( const f32 deltaTime, TransformDatabase* transformD
 
             transformDatabase->setRotation( wheelTransform, wheelRotation );
         }
-
-        wheelIdx += vehicleWheelCount;
     }
 }
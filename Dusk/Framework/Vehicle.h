@@ -31,7 +31,6 @@ public:
 
 private:
     struct InstanceData {
-        Entity*                     Owner;
         Entity*                     VehicleWheelsEntity;
         MotorizedVehiclePhysics**   VehiclePhysics;
     };
@@ -11,50 +11,128 @@
 #include "StaticGeometry.h"
 #include "PointLight.h"
 #include "Vehicle.h"
+#include "SpatialGrid.h"
+#include "AreaStreaming.h"
+#include "Cameras/Camera.h"
 
 #include "Graphics/DrawCommandBuilder.h"
 #include "Graphics/LightGrid.h"
+#include "Graphics/Model.h"
+#include "Graphics/ShaderHeaders/Light.h"
 
-static constexpr size_t MAX_ENTITY_COUNT = 10000;
+#include <Maths/MatrixTransformations.h>
 
-World::World( BaseAllocator* allocator )
+static constexpr size_t MAX_ENTITY_COUNT = 65536;
+
+// Maximum number of cameras a renderable collection can be queried for.
+static constexpr u32 MAX_COLLECTION_CAMERA_COUNT = 8;
+
+// Return the world space bounds of a model instance (the bounds always include the instance origin).
+static AABB ComputeRenderableBounds( const Model* model, const dkMat4x4f& modelMatrix )
+{
+    const dkVec3f instancePosition = dk::maths::ExtractTranslation( modelMatrix );
+
+    AABB bounds;
+    dk::maths::CreateAABBFromMinMaxPoints( bounds, instancePosition, instancePosition );
+
+    // The model might be missing (editor only).
+    if ( model != nullptr ) {
+        const BoundingSphere& modelBoundingSphere = model->getBoundingSphere();
+
+        // The sphere center is in model space (rotation and scale must be applied). The radius is scaled by the largest
+        // axis scale so that the sphere still encloses the model under non-uniform scaling.
+        BoundingSphere instanceSphere;
+        instanceSphere.center = dkVec3f( dkVec4f( modelBoundingSphere.center, 1.0f ) * modelMatrix );
+        instanceSphere.radius = modelBoundingSphere.radius * dk::maths::GetBiggestScalar( dk::maths::ExtractScale( modelMatrix ) );
+
+        dk::maths::ExpandAABB( bounds, instanceSphere );
+    }
+
+    return bounds;
+}
+
+World::World( BaseAllocator* allocator, JobSystem* jobSystem )
     : memoryAllocator( allocator )
-    , entityDatabase( dk::core::allocate<EntityDatabase>( allocator ) )
+    , entityDatabase( dk::core::allocate<EntityDatabase>( allocator, allocator ) )
     , entityNameRegister( dk::core::allocate<EntityNameRegister>( allocator, allocator ) )
-    , transformDatabase( dk::core::allocate<TransformDatabase>( allocator, allocator ) )
+    , transformDatabase( dk::core::allocate<TransformDatabase>( allocator, allocator, jobSystem ) )
     , staticGeometryDatabase( dk::core::allocate<StaticGeometryDatabase>( allocator, allocator ) )
     , pointLightDatabase( dk::core::allocate<PointLightDatabase>( allocator, allocator ) )
     , vehicleDatabase( dk::core::allocate<VehicleDatabase>( allocator, allocator ) )
+    , renderableGrid( dk::core::allocate<SpatialGrid>( allocator, allocator ) )
+    , visibleRenderables( nullptr )
+    , areaStreaming( dk::core::allocate<AreaStreaming>( allocator, allocator, jobSystem ) )
+    , vehicleAnchorCount( 0u )
 {
 
 }
 
 World::~World()
 {
+    // Stop the streaming first (read jobs might still be in flight).
+    dk::core::free( memoryAllocator, areaStreaming );
+
 	dk::core::free( memoryAllocator, entityDatabase );
 	dk::core::free( memoryAllocator, entityNameRegister );
 	dk::core::free( memoryAllocator, transformDatabase );
     dk::core::free( memoryAllocator, staticGeometryDatabase );
     dk::core::free( memoryAllocator, pointLightDatabase );
     dk::core::free( memoryAllocator, vehicleDatabase );
+    dk::core::free( memoryAllocator, renderableGrid );
+
+    if ( visibleRenderables != nullptr ) {
+        dk::core::freeArray( memoryAllocator, visibleRenderables );
+    }
 }
 
 void World::create()
 {
+    entityDatabase->create( MAX_ENTITY_COUNT );
     entityNameRegister->create( MAX_ENTITY_COUNT );
     transformDatabase->create( MAX_ENTITY_COUNT );
     staticGeometryDatabase->create( MAX_ENTITY_COUNT );
     pointLightDatabase->create( MAX_ENTITY_COUNT );
     vehicleDatabase->create( MAX_ENTITY_COUNT );
+    renderableGrid->create( MAX_ENTITY_COUNT );
+
+    visibleRenderables = dk::core::allocateArray<u32>( memoryAllocator, MAX_ENTITY_COUNT );
 }
 
-void World::collectRenderables( DrawCommandBuilder* drawCmdBuilder, LightGrid* lightGrid ) const
+void World::enableStreaming( const AreaStreamingSettings& settings )
+{
+    areaStreaming->create( settings );
+}
+
+void World::collectRenderables( DrawCommandBuilder* drawCmdBuilder, LightGrid* lightGrid, const CameraData** cameras, const u32 cameraCount ) const
 {
     DUSK_CPU_PROFILE_FUNCTION;
 
-    // Collect static geometry.
-	for ( const Entity& geom : staticGeometry ) {
-		const Model* model = staticGeometryDatabase->getModel( staticGeometryDatabase->lookup( geom ) );
+    // Collect static geometry. Without cameras, every instance is collected (component instances are packed; iterate
+    // the database directly). Otherwise only the instances of the grid cells relevant to at least one camera are
+    // collected (precise culling is done per camera by the DrawCommandBuilder).
+    size_t renderableCount = staticGeometryDatabase->getInstanceCount();
+    if ( cameraCount != 0u ) {
+        DUSK_ASSERT( cameraCount <= MAX_COLLECTION_CAMERA_COUNT, "Too many cameras (%u; max is %u)! Renderables only visible from the extra cameras won't be collected", cameraCount, MAX_COLLECTION_CAMERA_COUNT );
+
+        SpatialGrid::Query queries[MAX_COLLECTION_CAMERA_COUNT];
+
+        const u32 queryCount = Min( cameraCount, MAX_COLLECTION_CAMERA_COUNT );
+        for ( u32 cameraIdx = 0; cameraIdx < queryCount; cameraIdx++ ) {
+            // Shadow casters outside of the frustum are kept if they are close enough to the camera.
+            queries[cameraIdx].ViewFrustum = &cameras[cameraIdx]->frustum;
+            queries[cameraIdx].Origin = cameras[cameraIdx]->worldPosition;
+            queries[cameraIdx].Range = CSM_MAX_DEPTH;
+        }
+
+        renderableCount = renderableGrid->query( queries, queryCount, visibleRenderables );
+    }
+
+	for ( size_t renderableIdx = 0; renderableIdx < renderableCount; renderableIdx++ ) {
+        const Entity& geom = ( cameraCount != 0u )
+            ? renderableGrid->getOwner( Instance( visibleRenderables[renderableIdx] ) )
+            : staticGeometryDatabase->getOwner( Instance( renderableIdx ) );
+        const Instance geomInstance = staticGeometryDatabase->lookup( geom );
+		const Model* model = staticGeometryDatabase->getModel( geomInstance );
         const dkMat4x4f& modelMatrix = transformDatabase->getWorldMatrix( transformDatabase->lookup( geom ) );
 
 #ifdef DUSKED
@@ -68,8 +146,11 @@ void World::collectRenderables( DrawCommandBuilder* drawCmdBuilder, LightGrid* l
     }
 
     // Update and collect relevant point lights (we don't care about visibility relevance; culling is done on the GPU only).
-    for ( const Entity& pointLight : pointLights ) {
-        PointLightGPU& pointLightInfos = pointLightDatabase->getLightData( pointLightDatabase->lookup( pointLight ) );
+    const size_t pointLightCount = pointLightDatabase->getInstanceCount();
+    for ( size_t pointLightIdx = 0; pointLightIdx < pointLightCount; pointLightIdx++ ) {
+        const Instance pointLightInstance( pointLightIdx );
+        const Entity& pointLight = pointLightDatabase->getOwner( pointLightInstance );
+        PointLightGPU& pointLightInfos = pointLightDatabase->getLightData( pointLightInstance );
 
         // Forward transform infos to the POD structure (we want to duplicate the position info since the structure is 
         // uploaded as is on the GPU plus we can easily apply dynamic updates or animations on the entity).
@@ -88,6 +169,7 @@ void World::update( const f32 deltaTime )
     // e.g. Vehicles must be updated prior to Transform since each vehicle instance will update its wheels transform
     vehicleDatabase->update( deltaTime, transformDatabase );
     transformDatabase->update( deltaTime );
+    updateRenderableGrid();
 }
 
 Entity World::createStaticMesh( const char* name )
@@ -98,7 +180,8 @@ Entity World::createStaticMesh( const char* name )
     attachTransformComponent( entity );
     attachStaticGeometryComponent( entity );
 
-    staticGeometry.push_back( entity );
+    const dkMat4x4f& modelMatrix = transformDatabase->getWorldMatrix( transformDatabase->lookup( entity ) );
+    renderableGrid->allocateComponent( entity, ComputeRenderableBounds( nullptr, modelMatrix ) );
 
     return entity;
 }
@@ -111,8 +194,6 @@ Entity World::createPointLight( const char* name )
     attachTransformComponent( entity );
     attachPointLightComponent( entity );
 
-    pointLights.push_back( entity );
-
     return entity;
 }
 
@@ -120,8 +201,8 @@ void World::releaseEntity( Entity& entity )
 {
     transformDatabase->removeComponent( entity );
     staticGeometryDatabase->removeComponent( entity );
-    
-    staticGeometry.remove_if( [entity]( Entity& sge ) { return sge == entity; } );
+    pointLightDatabase->removeComponent( entity );
+    renderableGrid->removeComponent( entity );
 
     entityDatabase->releaseEntity( entity );
     entityNameRegister->releaseEntityName( entity );
@@ -142,6 +223,19 @@ void World::attachPointLightComponent( Entity& entity )
     pointLightDatabase->allocateComponent( entity );
 }
 
+void World::updateRenderableBounds( const Entity& entity )
+{
+    if ( !renderableGrid->hasComponent( entity ) ) {
+        return;
+    }
+
+    const Model* model = staticGeometryDatabase->getModel( staticGeometryDatabase->lookup( entity ) );
+    const dkMat4x4f& modelMatrix = transformDatabase->getWorldMatrix( transformDatabase->lookup( entity ) );
+
+    renderableGrid->setBounds( renderableGrid->lookup( entity ), ComputeRenderableBounds( model, modelMatrix ) );
+    renderableGrid->updateCellBounds();
+}
+
 TransformDatabase* World::getTransformDatabase() const
 {
     return transformDatabase;
@@ -162,9 +256,80 @@ EntityNameRegister* World::getEntityNameRegister() const
     return entityNameRegister;
 }
 
+AreaStreaming* World::getAreaStreaming() const
+{
+    return areaStreaming;
+}
+
 void World::updateStreaming()
 {
+    if ( !areaStreaming->isEnabled() ) {
+        return;
+    }
+
+    // Vehicles are streaming anchors (the world around them must be simulated). Anchors are persistent: move the
+    // anchors of the vehicles and remove the anchors of the vehicles released since the previous update.
+    constexpr u32 FIRST_VEHICLE_ANCHOR_INDEX = AreaStreaming::CAMERA_ANCHOR_INDEX + 1u;
+    constexpr u32 MAX_VEHICLE_ANCHOR_COUNT = AreaStreaming::MAX_ANCHOR_COUNT - FIRST_VEHICLE_ANCHOR_INDEX;
+
+    const u32 vehicleCount = static_cast< u32 >( Min( vehicleDatabase->getInstanceCount(), static_cast< size_t >( MAX_VEHICLE_ANCHOR_COUNT ) ) );
+    for ( u32 vehicleIdx = 0u; vehicleIdx < vehicleCount; vehicleIdx++ ) {
+        const Entity& vehicle = vehicleDatabase->getOwner( Instance( vehicleIdx ) );
+        areaStreaming->setAnchor( FIRST_VEHICLE_ANCHOR_INDEX + vehicleIdx, transformDatabase->getWorldPosition( transformDatabase->lookup( vehicle ) ) );
+    }
+
+    for ( u32 vehicleIdx = vehicleCount; vehicleIdx < vehicleAnchorCount; vehicleIdx++ ) {
+        areaStreaming->removeAnchor( FIRST_VEHICLE_ANCHOR_INDEX + vehicleIdx );
+    }
+
+    vehicleAnchorCount = vehicleCount;
+
+    areaStreaming->update( &World::SpawnStreamedEntity, &World::ReleaseStreamedEntity, this );
+}
+
+Entity World::SpawnStreamedEntity( void* userData, const AreaEntity& areaEntity, const char* name, Model* model )
+{
+    World* world = static_cast< World* >( userData );
+
+    Entity entity = world->createStaticMesh( name );
+
+    TransformDatabase* transformDb = world->transformDatabase;
+    const Instance transformInstance = transformDb->lookup( entity );
+    transformDb->setPosition( transformInstance, areaEntity.Position );
+    transformDb->setRotation( transformInstance, areaEntity.Rotation );
+    transformDb->setScale( transformInstance, areaEntity.Scale );
+
+    // Renderable bounds are updated once the transform has been updated.
+    world->staticGeometryDatabase->setModel( world->staticGeometryDatabase->lookup( entity ), model );
+
+    return entity;
+}
+
+void World::ReleaseStreamedEntity( void* userData, Entity& entity )
+{
+    static_cast< World* >( userData )->releaseEntity( entity );
+}
+
+void World::updateRenderableGrid()
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    // Only the instances whose world matrix has been updated this frame need new bounds.
+    const size_t renderableCount = renderableGrid->getInstanceCount();
+    for ( size_t renderableIdx = 0; renderableIdx < renderableCount; renderableIdx++ ) {
+        const Instance renderableInstance( renderableIdx );
+        const Entity& renderable = renderableGrid->getOwner( renderableInstance );
+
+        const Instance transformInstance = transformDatabase->lookup( renderable );
+        if ( !transformDatabase->isWorldMatrixUpdated( transformInstance ) ) {
+            continue;
+        }
+
+        const Model* model = staticGeometryDatabase->getModel( staticGeometryDatabase->lookup( renderable ) );
+        renderableGrid->setBounds( renderableInstance, ComputeRenderableBounds( model, transformDatabase->getWorldMatrix( transformInstance ) ) );
+    }
 
+    renderableGrid->updateCellBounds();
 }
 
 void World::assignEntityName( Entity& entity, const char* assignedName )
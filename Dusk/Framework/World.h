@@ -5,6 +5,7 @@
 #pragma once
 
 class BaseAllocator;
+class JobSystem;
 class DrawCommandBuilder;
 class EntityDatabase;
 class EntityNameRegister;
@@ -13,8 +14,13 @@ class StaticGeometryDatabase;
 class PointLightDatabase;
 class LightGrid;
 class VehicleDatabase;
+class SpatialGrid;
+class AreaStreaming;
+class Model;
+struct CameraData;
+struct AreaEntity;
+struct AreaStreamingSettings;
 
-#include <list>
 #include "Entity.h"
 
 class World
@@ -26,14 +32,20 @@ public:
 
 public:
 public:
-                            World( BaseAllocator* allocator );
+                            World( BaseAllocator* allocator, JobSystem* jobSystem = nullptr );
                             ~World();
 
     void                    create();
 
+    // Enable the streaming of the World areas (see AreaStreaming). Vehicles are streaming anchors; the
+    // camera anchor (AreaStreaming::updateFromCameraView) is owned by the caller.
+    void                    enableStreaming( const AreaStreamingSettings& settings );
+
     // Iterate over the streamed entities in the World and collect any
     // entity that is renderable (e.g. static geometry; lights; etc.).
-    void                    collectRenderables( DrawCommandBuilder* drawCmdBuilder, LightGrid* lightGrid ) const;
+    // If cameras are provided, only the static geometry of the spatial grid cells
+    // visible by (or casting shadows for) at least one camera is collected.
+    void                    collectRenderables( DrawCommandBuilder* drawCmdBuilder, LightGrid* lightGrid, const CameraData** cameras = nullptr, const u32 cameraCount = 0u ) const;
 
     void                    update( const f32 deltaTime );
 
@@ -49,6 +61,10 @@ public:
 
     void                    attachPointLightComponent( Entity& entity );
 
+    // Recompute the world bounds of a renderable entity (call if the model of the
+    // entity has been modified; transform updates are tracked automatically).
+    void                    updateRenderableBounds( const Entity& entity );
+
     TransformDatabase*      getTransformDatabase() const;
 
     StaticGeometryDatabase* getStaticGeometryDatabase() const;
@@ -57,18 +73,13 @@ public:
 
     EntityNameRegister*     getEntityNameRegister() const;
 
+    AreaStreaming*          getAreaStreaming() const;
+
 private:
     BaseAllocator*          memoryAllocator;
 
     EntityDatabase*         entityDatabase;
 
-    // TODO Might need allocation/logic improvement.
-    std::list<Entity>       staticGeometry;
-
-    std::list<Entity>       pointLights;
-
-    std::list<Entity>       vehicles;
-
     TransformDatabase*      transformDatabase;
 
     StaticGeometryDatabase* staticGeometryDatabase;
@@ -79,9 +90,29 @@ private:
 
     VehicleDatabase*        vehicleDatabase;
 
+    // Spatial partitioning of the renderable entities (static geometry).
+    SpatialGrid*            renderableGrid;
+
+    // Instances of the renderable grid returned by the latest query.
+    u32*                    visibleRenderables;
+
+    AreaStreaming*          areaStreaming;
+
+    // Number of streaming anchors set for the vehicles (anchors following AreaStreaming::CAMERA_ANCHOR_INDEX).
+    u32                     vehicleAnchorCount;
+
 private:
 	// Update this World area streaming.
 	void                    updateStreaming();
 
     void                    assignEntityName( Entity& entity, const char* assignedName = "Entity" );
+
+    // Update the bounds of the renderable entities whose transform has been updated.
+    void                    updateRenderableGrid();
+
+    // Spawn an entity of a streamed area (AreaStreaming callback; userData is the World).
+    static Entity           SpawnStreamedEntity( void* userData, const AreaEntity& areaEntity, const char* name, Model* model );
+
+    // Release an entity of a streamed area (AreaStreaming callback; userData is the World).
+    static void             ReleaseStreamedEntity( void* userData, Entity& entity );
 };
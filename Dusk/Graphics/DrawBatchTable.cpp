@@ -0,0 +1,201 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "DrawBatchTable.h"
+
+// Return the size of the instance range allocated for 'instanceCount' instances.
+static DUSK_INLINE u32 GetInstanceRangeSize( const u32 instanceCount )
+{
+    return ( ( instanceCount + DrawBatchTable::INSTANCE_RANGE_GRANULARITY - 1u ) / DrawBatchTable::INSTANCE_RANGE_GRANULARITY ) * DrawBatchTable::INSTANCE_RANGE_GRANULARITY;
+}
+
+DrawBatchTable::DrawBatchTable( BaseAllocator* allocator, const u32 batchCapacity, const u32 instanceCapacity )
+    : memoryAllocator( allocator )
+    , batches( dk::core::allocateArray<Batch>( allocator, batchCapacity ) )
+    , activeBatches( dk::core::allocateArray<i32>( allocator, batchCapacity ) )
+    , batchCapacity( batchCapacity )
+    , activeBatchCount( 0u )
+    , previousActiveBatchCount( 0u )
+    , instanceCapacity( instanceCapacity )
+    , allocatedInstanceCount( 0u )
+    , isLayoutChanged( true )
+    , unusedBatchList( INVALID_BATCH )
+    , currentFrame( 0u )
+{
+    static_assert( ( BUCKET_COUNT & ( BUCKET_COUNT - 1u ) ) == 0u, "BUCKET_COUNT must be a power of two!" );
+
+    for ( u32 i = 0u; i < BUCKET_COUNT; i++ ) {
+        bucketLists[i] = INVALID_BATCH;
+    }
+
+    for ( i32 i = static_cast< i32 >( batchCapacity ) - 1; i >= 0; i-- ) {
+        batches[i].ModelLOD = nullptr;
+        batches[i].Next = unusedBatchList;
+        unusedBatchList = i;
+    }
+}
+
+DrawBatchTable::~DrawBatchTable()
+{
+    dk::core::freeArray( memoryAllocator, batches );
+    dk::core::freeArray( memoryAllocator, activeBatches );
+}
+
+void DrawBatchTable::beginFrame( const u32 frameIndex )
+{
+    currentFrame = frameIndex;
+    previousActiveBatchCount = activeBatchCount;
+    activeBatchCount = 0u;
+    isLayoutChanged = false;
+
+    recycleUnusedBatches( MAX_UNUSED_FRAME_COUNT );
+}
+
+i32 DrawBatchTable::addInstance( const Model::LevelOfDetail& lod, const f32 distanceToCamera )
+{
+    const u32 bucketIndex = ( lod.Hashcode & ( BUCKET_COUNT - 1u ) );
+
+    for ( i32 batchIndex = bucketLists[bucketIndex]; batchIndex != INVALID_BATCH; batchIndex = batches[batchIndex].Next ) {
+        Batch& batch = batches[batchIndex];
+        if ( batch.Hashcode != lod.Hashcode ) {
+            continue;
+        }
+
+        if ( batch.LastRequestFrame != currentFrame ) {
+            // First request of the frame; reset the batch. The layout changes if the batch was not requested during
+            // the previous frame (or if the LOD has been reloaded).
+            isLayoutChanged |= ( ( batch.LastRequestFrame + 1u ) != currentFrame || batch.ModelLOD != &lod );
+
+            batch.ModelLOD = &lod;
+            batch.InstanceCount = 0u;
+            batch.ClosestDistance = distanceToCamera;
+            batch.LastRequestFrame = currentFrame;
+
+            activeBatches[activeBatchCount++] = batchIndex;
+        }
+
+        batch.InstanceCount++;
+        batch.ClosestDistance = Min( batch.ClosestDistance, distanceToCamera );
+
+        return batchIndex;
+    }
+
+    // Every batch requested during this frame is alive; the other ones can be recycled right away.
+    if ( unusedBatchList == INVALID_BATCH ) {
+        recycleUnusedBatches( 0u );
+    }
+
+    DUSK_RAISE_FATAL_ERROR( unusedBatchList != INVALID_BATCH, "Draw batch table is full!" );
+
+    const i32 batchIndex = unusedBatchList;
+    Batch& batch = batches[batchIndex];
+    unusedBatchList = batch.Next;
+
+    batch.ModelLOD = &lod;
+    batch.Hashcode = lod.Hashcode;
+    batch.InstanceCount = 1u;
+    batch.PreviousInstanceCount = 0u;
+    batch.InstanceOffset = 0u;
+    batch.InstanceCapacity = 0u;
+    batch.ClosestDistance = distanceToCamera;
+    batch.LastRequestFrame = currentFrame;
+    batch.Next = bucketLists[bucketIndex];
+    bucketLists[bucketIndex] = batchIndex;
+
+    activeBatches[activeBatchCount++] = batchIndex;
+
+    isLayoutChanged = true;
+
+    return batchIndex;
+}
+
+bool DrawBatchTable::assignInstanceRanges()
+{
+    // The requested batches are the same as the previous frame if every requested batch was requested during the
+    // previous frame (see addInstance) and if the batch count is unchanged.
+    isLayoutChanged |= ( activeBatchCount != previousActiveBatchCount );
+
+    bool needPacking = false;
+    for ( u32 activeIdx = 0; activeIdx < activeBatchCount; activeIdx++ ) {
+        Batch& batch = batches[activeBatches[activeIdx]];
+        isLayoutChanged |= ( batch.InstanceCount != batch.PreviousInstanceCount );
+        batch.PreviousInstanceCount = batch.InstanceCount;
+
+        if ( batch.InstanceCount <= batch.InstanceCapacity ) {
+            continue;
+        }
+
+        // The batch has outgrown its range; allocate a new one (the previous range is lost until the next packing).
+        const u32 rangeSize = GetInstanceRangeSize( batch.InstanceCount );
+        if ( ( allocatedInstanceCount + rangeSize ) > instanceCapacity ) {
+            needPacking = true;
+            break;
+        }
+
+        batch.InstanceOffset = allocatedInstanceCount;
+        batch.InstanceCapacity = rangeSize;
+        allocatedInstanceCount += rangeSize;
+        isLayoutChanged = true;
+    }
+
+    if ( needPacking ) {
+        packInstanceRanges();
+        isLayoutChanged = true;
+    }
+
+    for ( u32 activeIdx = 0; activeIdx < activeBatchCount; activeIdx++ ) {
+        batches[activeBatches[activeIdx]].InstanceCount = 0u;
+    }
+
+    return isLayoutChanged;
+}
+
+void DrawBatchTable::packInstanceRanges()
+{
+    // Release every range (batches which are not requested during this frame get a new range on their next request).
+    for ( u32 batchIdx = 0u; batchIdx < batchCapacity; batchIdx++ ) {
+        batches[batchIdx].InstanceCapacity = 0u;
+    }
+
+    // Keep some room for each batch to grow; fallback to tight ranges if the storage is too small.
+    u32 requiredInstanceCount = 0u;
+    for ( u32 activeIdx = 0; activeIdx < activeBatchCount; activeIdx++ ) {
+        requiredInstanceCount += GetInstanceRangeSize( batches[activeBatches[activeIdx]].InstanceCount );
+    }
+
+    const bool useTightRanges = ( requiredInstanceCount > instanceCapacity );
+
+    allocatedInstanceCount = 0u;
+    for ( u32 activeIdx = 0; activeIdx < activeBatchCount; activeIdx++ ) {
+        Batch& batch = batches[activeBatches[activeIdx]];
+        const u32 rangeSize = ( useTightRanges ) ? batch.InstanceCount : GetInstanceRangeSize( batch.InstanceCount );
+
+        batch.InstanceOffset = allocatedInstanceCount;
+        batch.InstanceCapacity = rangeSize;
+        allocatedInstanceCount += rangeSize;
+    }
+
+    DUSK_RAISE_FATAL_ERROR( allocatedInstanceCount <= instanceCapacity, "Draw batch table instance storage is full!" );
+}
+
+void DrawBatchTable::recycleUnusedBatches( const u32 maxUnusedFrameCount )
+{
+    for ( u32 bucketIndex = 0u; bucketIndex < BUCKET_COUNT; bucketIndex++ ) {
+        i32* previousLink = &bucketLists[bucketIndex];
+        for ( i32 batchIndex = *previousLink; batchIndex != INVALID_BATCH; batchIndex = *previousLink ) {
+            Batch& batch = batches[batchIndex];
+            if ( batch.LastRequestFrame == currentFrame || ( currentFrame - batch.LastRequestFrame ) <= maxUnusedFrameCount ) {
+                previousLink = &batch.Next;
+                continue;
+            }
+
+            *previousLink = batch.Next;
+
+            batch.ModelLOD = nullptr;
+            batch.Next = unusedBatchList;
+            unusedBatchList = batchIndex;
+        }
+    }
+}
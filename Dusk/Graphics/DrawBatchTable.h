@@ -0,0 +1,137 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class BaseAllocator;
+
+#include <Graphics/Model.h>
+
+// Persistent table of instanced draw batches keyed by LOD hashcode (a LOD hashcode identifies a model and one of its
+// LOD; each mesh of the LOD then gets its own draw per material). Batches survive across frames: the first request
+// of a frame only resets the batch instance count, and batches which have not been requested for a while are recycled.
+// Batches requested during the current frame are tracked in order of first request (which makes the iteration order
+// independent of the hashing). Each batch also owns a persistent range of the owner instance storage; the range only
+// moves if the batch outgrows it (which lets the owner keep the instance data of unchanged batches from a frame to
+// another).
+class DrawBatchTable
+{
+public:
+    // Number of buckets (must be a power of two).
+    static constexpr u32    BUCKET_COUNT = 1024u;
+
+    // Number of frames a batch can stay unused before being recycled.
+    static constexpr u32    MAX_UNUSED_FRAME_COUNT = 8u;
+
+    // Index returned when no batch is available.
+    static constexpr i32    INVALID_BATCH = -1;
+
+    // Granularity of the batches instance ranges (in instances). Gives some room to a batch before it has to be moved.
+    static constexpr u32    INSTANCE_RANGE_GRANULARITY = 16u;
+
+    struct Batch {
+        // LOD rendered by this batch.
+        const Model::LevelOfDetail* ModelLOD;
+
+        // Hashcode of the LOD (key of the batch).
+        dkStringHash_t      Hashcode;
+
+        // Number of instances added to this batch during the current frame.
+        u32                 InstanceCount;
+
+        // Number of instances of this batch during the last frame its instance range has been assigned.
+        u32                 PreviousInstanceCount;
+
+        // Offset of the first instance of this batch (in the owner instance storage).
+        u32                 InstanceOffset;
+
+        // Number of instances the range of this batch can hold (0 if the batch has no range yet).
+        u32                 InstanceCapacity;
+
+        // Squared distance to the closest instance of this batch.
+        f32                 ClosestDistance;
+
+        // Index of the last frame which requested this batch.
+        u32                 LastRequestFrame;
+
+        // Index of the next batch in the list owning this batch.
+        i32                 Next;
+    };
+
+public:
+    // Return the number of batches requested during the current frame.
+    DUSK_INLINE u32         getActiveBatchCount() const { return activeBatchCount; }
+
+    // Return the index of the N-th batch requested during the current frame.
+    DUSK_INLINE i32         getActiveBatchIndex( const u32 activeIndex ) const { return activeBatches[activeIndex]; }
+
+    // Return the batch stored at a given index.
+    DUSK_INLINE Batch&      getBatch( const i32 batchIndex ) { return batches[batchIndex]; }
+    DUSK_INLINE const Batch& getBatch( const i32 batchIndex ) const { return batches[batchIndex]; }
+
+public:
+                            DrawBatchTable( BaseAllocator* allocator, const u32 batchCapacity, const u32 instanceCapacity );
+                            DrawBatchTable( DrawBatchTable& ) = delete;
+                            DrawBatchTable& operator = ( DrawBatchTable& ) = delete;
+                            ~DrawBatchTable();
+
+    // Start a new frame. Batches unused for more than MAX_UNUSED_FRAME_COUNT frames are recycled.
+    void                    beginFrame( const u32 frameIndex );
+
+    // Add an instance to the batch of a given LOD (the batch is created if it does not exist yet). Return the index
+    // of the batch.
+    i32                     addInstance( const Model::LevelOfDetail& lod, const f32 distanceToCamera );
+
+    // Make sure that each batch requested during the current frame owns an instance range large enough for its
+    // instances (ranges are kept from a frame to another; if the instance storage is too fragmented, the ranges of the
+    // requested batches are packed again). Return true if the batch layout (requested batches, LOD, instance count or
+    // range) has changed since the previous frame. Instance counts are reset so that they can be used as fill cursors.
+    bool                    assignInstanceRanges();
+
+private:
+    // The memory allocator owning this instance.
+    BaseAllocator*          memoryAllocator;
+
+    // Batch storage.
+    Batch*                  batches;
+
+    // Index of the batches requested during the current frame (in request order).
+    i32*                    activeBatches;
+
+    // Maximum number of batches.
+    u32                     batchCapacity;
+
+    // Number of batches requested during the current frame.
+    u32                     activeBatchCount;
+
+    // Number of batches requested during the previous frame.
+    u32                     previousActiveBatchCount;
+
+    // Size of the owner instance storage (in instances).
+    u32                     instanceCapacity;
+
+    // Number of instances allocated from the owner instance storage (ranges are allocated linearly; the storage is
+    // packed again once full).
+    u32                     allocatedInstanceCount;
+
+    // True if the batch layout has changed during the current frame.
+    bool                    isLayoutChanged;
+
+    // Per-bucket head of the batch list.
+    i32                     bucketLists[BUCKET_COUNT];
+
+    // Head of the list of unused batches.
+    i32                     unusedBatchList;
+
+    // Index of the current frame.
+    u32                     currentFrame;
+
+private:
+    // Recycle the batches which have not been requested during the last 'maxUnusedFrameCount' frames.
+    void                    recycleUnusedBatches( const u32 maxUnusedFrameCount );
+
+    // Assign a new range to every batch requested during the current frame (the ranges of the other batches are
+    // released).
+    void                    packInstanceRanges();
+};
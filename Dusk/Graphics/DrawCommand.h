@@ -14,8 +14,10 @@ struct DrawCommandKey
     {
         LAYER_DEPTH,
         LAYER_WORLD,
+        LAYER_TRANSLUCENT, // sorted back to front (see DrawCmd::depthKey)
         LAYER_HUD,
-        LAYER_DEBUG
+        LAYER_DEBUG,
+        LAYER_COUNT
     };
 
     enum DepthViewportLayer : uint8_t
@@ -32,6 +34,11 @@ struct DrawCommandKey
         WORLD_VIEWPORT_LAYER_DEFAULT,
     };
 
+    enum TranslucentViewportLayer : u8
+    {
+        TRANSLUCENT_VIEWPORT_LAYER_DEFAULT,
+    };
+
     enum DebugViewportLayer : u8
     {
         DEBUG_VIEWPORT_LAYER_DEFAULT,
@@ -42,6 +49,9 @@ struct DrawCommandKey
         HUD_VIEWPORT_LAYER_DEFAULT,
     };
 
+    // Number of viewport layers per layer (viewportLayer is a 3 bits field).
+    static constexpr u32 VIEWPORT_LAYER_COUNT = 8u;
+
     enum SortOrder : u8
     {
         SORT_FRONT_TO_BACK = 0,
@@ -84,7 +94,7 @@ struct DrawCommandInfos
     u32                         vertexBufferCount;
     f32                         alphaDitheringValue; // 0..1 (1.0f if disabled)
     u32                         instanceCount; // 0 or 1 implicitly disable instancing
-    const InstanceData*         modelMatrix; // Points to a single matrix or an array of matrix (if instancing is used)
+    u32                         instanceDataOffset; // offset of the first instance (in the instance vector buffer; instances are contiguous)
     
     u8                          useShortIndices : 1;
 };
@@ -92,6 +102,7 @@ struct DrawCommandInfos
 struct DrawCmd
 {
     DrawCommandKey      key;
+    u32                 depthKey; // full precision depth (translucent layer only; ascending order is back to front)
     DrawCommandInfos    infos;
 
     static bool SortFrontToBack( const DrawCmd& cmd1, const DrawCmd& cmd2 )
@@ -10,17 +10,35 @@
 #include <Graphics/LightGrid.h>
 #include <Graphics/Model.h>
 #include <Graphics/Mesh.h>
+#include <Graphics/DrawBatchTable.h>
+#include <Graphics/OcclusionBuffer.h>
 #include "Graphics/WorldRenderer.h"
+#include "Graphics/FrameGraph.h"
 
 #include <Core/Allocators/LinearAllocator.h>
+#include <Core/JobSystem.h>
 #include <Maths/MatrixTransformations.h>
+#include <Maths/FrustumCulling.h>
 
 #include "Graphics/ShaderHeaders/Light.h"
 
 DUSK_DEV_VAR( DisplayBoundingSphere, "Display Geometry Bounding Sphere (as wireframe primitive)", false, bool );
+DUSK_DEV_VAR( EnableOcclusionCulling, "Cull static geometry hidden by occluders (CPU software occlusion culling)", true, bool );
+DUSK_DEV_VAR( SplitTranslucentInstances, "Split instanced translucent batches in one draw per instance (each instance is sorted back to front on its own)", true, bool );
+DUSK_DEV_VAR( LodMaxScreenError, "Maximum geometric error (in pixels) of the LOD selected for a geometry instance", 1.0f, f32 );
+DUSK_DEV_VAR( LodHysteresis, "Relative band around the LOD error threshold an instance must leave before switching LOD (prevents LOD flickering)", 0.2f, f32 );
+DUSK_DEV_VAR( RetainStaticGeometry, "Keep static geometry draw commands and instance data from a frame to another (only the modified instances are uploaded)", true, bool );
 
 static constexpr size_t MAX_STATIC_MODEL_COUNT = 4096;
-static constexpr size_t MAX_INSTANCE_COUNT_PER_MODEL = 256;
+
+// Initial capacity of the retained draw command storage (per camera).
+static constexpr u32 DEFAULT_RETAINED_DRAW_CMD_CAPACITY = 1024;
+
+// Maximum number of instances drawn by a single draw command (batches with more instances are split in several draws).
+static constexpr u32 MAX_INSTANCE_COUNT_PER_BATCH = 256;
+
+// Minimum distance (in world units) between the camera and an instance bounds used to project the LOD errors.
+static constexpr f32 MIN_LOD_PROJECTION_DISTANCE = 0.01f;
 
 struct ModelInstance 
 {
@@ -52,37 +70,196 @@ u16 DepthToBits( const f32 depth )
     return static_cast< u16 >( b );
 }
 
-// Frustum culling on a sphere. Returns > 0 if visible, <= 0 otherwise
-// NOTE Infinite Z version (it implicitly skips the far plane check)
-f32 CullSphereInfReversedZ( const Frustum* frustum, const dkVec3f& vCenter, f32 fRadius )
+// Full precision key for back to front sorting (farthest depth maps to the smallest key).
+u32 DepthToBackToFrontKey( const f32 depth )
 {
-    f32 dist01 = Min( DistanceToPlane( frustum->planes[0], vCenter ), DistanceToPlane( frustum->planes[1], vCenter ) );
-    f32 dist23 = Min( DistanceToPlane( frustum->planes[2], vCenter ), DistanceToPlane( frustum->planes[3], vCenter ) );
-    f32 dist45 = DistanceToPlane( frustum->planes[5], vCenter );
-
-    return Min( Min( dist01, dist23 ), dist45 ) + fRadius;
+    union { f32 f; u32 i; } f2i;
+    f2i.f = depth;
+    return ~FloatFlip( f2i.i );
 }
 
-f32 CullSphereInfReversedZ( const Frustum* frustum, const BoundingSphere& sphere )
+// Return the squared distance from the camera to a geometry instance.
+DUSK_INLINE f32 GetInstanceDistance( const CameraData* camera, const DrawCommandInfos::InstanceData& instance )
 {
-    return CullSphereInfReversedZ( frustum, sphere.center, sphere.radius );
+    return dkVec3f::distanceSquared( camera->worldPosition, dk::maths::ExtractTranslation( instance.ModelMatrix ) );
 }
 
+// Range of instances of a batch drawn by a single draw command.
 struct LODBatch 
 {
     const Model::LevelOfDetail*     ModelLOD;
-    DrawCommandInfos::InstanceData* Instances;
+    u32                             InstanceDataOffset;
     u32                             InstanceCount;
     f32                             ClosestDistance;
 };
 
-DrawCommandBuilder::DrawCommandBuilder( BaseAllocator* allocator )
+// Source of a retained draw command (used to patch the command if its batch is unchanged).
+struct RetainedDrawCmdSource
+{
+    i32                             BatchIndex;
+    const Mesh*                     SourceMesh;
+
+    // Index of the instance drawn by the command (in the camera GeometryInstances) if the command draws a single
+    // instance of its batch; ~0u otherwise.
+    u32                             InstanceIndex;
+};
+
+// LOD selected for a static model instance (instances are identified by their static model index).
+struct LodSelection
+{
+    // Model of the instance (the selection is discarded if the instance model has changed).
+    const Model*                    ModelResource;
+
+    // Index of the frame the selection has been made at.
+    u32                             FrameIndex;
+
+    // Index of the selected LOD.
+    u32                             LodIndex;
+
+    LodSelection()
+        : ModelResource( nullptr )
+        , FrameIndex( ~0u )
+        , LodIndex( Model::INVALID_LOD_INDEX )
+    {
+
+    }
+};
+
+// Build state of a single camera. Each context is only accessed by the job building its camera (and by the merge
+// step once every job is completed); which means that no synchronization is required.
+struct CameraDrawCmdContext
+{
+    // Builder owning this context.
+    DrawCommandBuilder*             Builder;
+
+    // Camera to build the commands for.
+    const CameraData*               Camera;
+
+    // Index of the camera (used as the viewport id of the draw commands).
+    u8                              CameraIndex;
+
+    // Indexes of the static models visible from the camera.
+    u32*                            VisibleModelIndexes;
+
+    // Index of the batch of each model processed (scratch memory used to fill the batches instances).
+    i32*                            ModelBatchIndexes;
+
+    // LOD selected by this camera for each static model (indexed by static model index; persistent across frames).
+    LodSelection*                   InstanceLods;
+
+    // Size (in pixels) of one world unit at a distance of one world unit from the camera.
+    f32                             LodProjectionScale;
+
+    // Geometry batches (persistent across frames).
+    DrawBatchTable*                 GeometryBatches;
+
+    // Instance data of the geometry batches (persistent; each batch owns a range of instances). Points to the region of
+    // the builder instance storage owned by this camera.
+    DrawCommandInfos::InstanceData* GeometryInstances;
+
+    // Offset of GeometryInstances in the builder instance storage (in instances).
+    u32                             GeometryInstanceOffset;
+
+    // Range of GeometryInstances modified during the current frame.
+    u32                             DirtyInstanceBegin;
+    u32                             DirtyInstanceEnd;
+
+    // True if the geometry batch layout has changed during the current frame (retained draw commands must be rebuilt).
+    bool                            IsGeometryLayoutChanged;
+
+    // Geometry draw commands built during a previous frame (and the source of each command).
+    DrawCmd*                        RetainedDrawCmds;
+    RetainedDrawCmdSource*          RetainedDrawCmdSources;
+    u32                             RetainedDrawCmdCount;
+    u32                             RetainedDrawCmdCapacity;
+
+    // True if the translucent batches of the retained draw commands are split in one draw per instance.
+    bool                            IsTranslucentSplit;
+
+    // Instance data of the debug bounding spheres (if DisplayBoundingSphere is enabled).
+    DrawCommandInfos::InstanceData* BoundingSphereInstances;
+    u32                             BoundingSphereCount;
+
+    // Depth buffer the occluders visible from the camera are rasterized to.
+    OcclusionBuffer*                Occlusion;
+
+    // Shadow caster batches (persistent across frames).
+    DrawBatchTable*                 ShadowBatches;
+
+    // Instance data of the shadow caster batches (batches instances are stored contiguously).
+    GPUBatchData*                   ShadowInstances;
+
+    CameraDrawCmdContext()
+        : Builder( nullptr )
+        , Camera( nullptr )
+        , CameraIndex( 0u )
+        , VisibleModelIndexes( nullptr )
+        , ModelBatchIndexes( nullptr )
+        , InstanceLods( nullptr )
+        , LodProjectionScale( 0.0f )
+        , GeometryBatches( nullptr )
+        , GeometryInstances( nullptr )
+        , GeometryInstanceOffset( 0u )
+        , DirtyInstanceBegin( ~0u )
+        , DirtyInstanceEnd( 0u )
+        , IsGeometryLayoutChanged( true )
+        , RetainedDrawCmds( nullptr )
+        , RetainedDrawCmdSources( nullptr )
+        , RetainedDrawCmdCount( 0u )
+        , RetainedDrawCmdCapacity( 0u )
+        , IsTranslucentSplit( false )
+        , BoundingSphereInstances( nullptr )
+        , BoundingSphereCount( 0u )
+        , Occlusion( nullptr )
+        , ShadowBatches( nullptr )
+        , ShadowInstances( nullptr )
+    {
+
+    }
+};
+
+DrawCommandBuilder::DrawCommandBuilder( BaseAllocator* allocator, JobSystem* jobSystem )
     : memoryAllocator( allocator )
     , cameraToRenderAllocator( dk::core::allocate<LinearAllocator>( allocator, MAX_SIMULTANEOUS_VIEWPORT_COUNT * sizeof( CameraData ), allocator->allocate( MAX_SIMULTANEOUS_VIEWPORT_COUNT * sizeof( CameraData ) ) ) )
     , staticModelsToRender( dk::core::allocate<LinearAllocator>( allocator, MAX_STATIC_MODEL_COUNT * sizeof( ModelInstance ), allocator->allocate( MAX_STATIC_MODEL_COUNT * sizeof( ModelInstance ) ) ) )
-    , instanceDataAllocator( dk::core::allocate<LinearAllocator>( allocator, MAX_STATIC_MODEL_COUNT * MAX_INSTANCE_COUNT_PER_MODEL * sizeof( DrawCommandInfos::InstanceData ), allocator->allocate( MAX_STATIC_MODEL_COUNT * MAX_INSTANCE_COUNT_PER_MODEL * sizeof( DrawCommandInfos::InstanceData ) ) ) )
-	, gpuInstanceDataAllocator( dk::core::allocate<LinearAllocator>( allocator, MAX_STATIC_MODEL_COUNT* MAX_INSTANCE_COUNT_PER_MODEL * sizeof( GPUBatchData ), allocator->allocate( MAX_STATIC_MODEL_COUNT* MAX_INSTANCE_COUNT_PER_MODEL * sizeof( GPUBatchData ) ) ) )
+    , jobSystem( jobSystem )
+    , frameIndex( 0u )
+    , lodReferenceCameraIndex( ~0u )
+    , cameraContexts( dk::core::allocateArray<CameraDrawCmdContext>( allocator, MAX_SIMULTANEOUS_VIEWPORT_COUNT ) )
 {
+	staticModelSpheres.CenterX = dk::core::allocateArray<f32>( allocator, MAX_STATIC_MODEL_COUNT );
+	staticModelSpheres.CenterY = dk::core::allocateArray<f32>( allocator, MAX_STATIC_MODEL_COUNT );
+	staticModelSpheres.CenterZ = dk::core::allocateArray<f32>( allocator, MAX_STATIC_MODEL_COUNT );
+	staticModelSpheres.Radius = dk::core::allocateArray<f32>( allocator, MAX_STATIC_MODEL_COUNT );
+
+	static_assert( ( MAX_SIMULTANEOUS_VIEWPORT_COUNT * MAX_STATIC_MODEL_COUNT ) <= FrameGraph::MAX_INSTANCE_COUNT, "Instance storage does not fit in the FrameGraph vector buffer!" );
+
+	sharedLods[0] = dk::core::allocateArray<LodSelection>( allocator, MAX_STATIC_MODEL_COUNT );
+	sharedLods[1] = dk::core::allocateArray<LodSelection>( allocator, MAX_STATIC_MODEL_COUNT );
+
+	instanceStorage = dk::core::allocateArray<DrawCommandInfos::InstanceData>( allocator, MAX_SIMULTANEOUS_VIEWPORT_COUNT * MAX_STATIC_MODEL_COUNT );
+	memset( instanceStorage, 0, sizeof( DrawCommandInfos::InstanceData ) * MAX_SIMULTANEOUS_VIEWPORT_COUNT * MAX_STATIC_MODEL_COUNT );
+
+	// A model belongs to a single batch per camera; every per-camera array is therefore bounded by the static model count.
+	for ( u32 cameraIdx = 0; cameraIdx < MAX_SIMULTANEOUS_VIEWPORT_COUNT; cameraIdx++ ) {
+		CameraDrawCmdContext& context = cameraContexts[cameraIdx];
+		context.Builder = this;
+		context.CameraIndex = static_cast< u8 >( cameraIdx );
+		context.VisibleModelIndexes = dk::core::allocateArray<u32>( allocator, MAX_STATIC_MODEL_COUNT );
+		context.ModelBatchIndexes = dk::core::allocateArray<i32>( allocator, MAX_STATIC_MODEL_COUNT );
+		context.InstanceLods = dk::core::allocateArray<LodSelection>( allocator, MAX_STATIC_MODEL_COUNT );
+		context.GeometryBatches = dk::core::allocate<DrawBatchTable>( allocator, allocator, static_cast< u32 >( MAX_STATIC_MODEL_COUNT ), static_cast< u32 >( MAX_STATIC_MODEL_COUNT ) );
+		context.GeometryInstanceOffset = static_cast< u32 >( cameraIdx * MAX_STATIC_MODEL_COUNT );
+		context.GeometryInstances = instanceStorage + context.GeometryInstanceOffset;
+		context.RetainedDrawCmds = dk::core::allocateArray<DrawCmd>( allocator, DEFAULT_RETAINED_DRAW_CMD_CAPACITY );
+		context.RetainedDrawCmdSources = dk::core::allocateArray<RetainedDrawCmdSource>( allocator, DEFAULT_RETAINED_DRAW_CMD_CAPACITY );
+		context.RetainedDrawCmdCapacity = DEFAULT_RETAINED_DRAW_CMD_CAPACITY;
+		context.BoundingSphereInstances = dk::core::allocateArray<DrawCommandInfos::InstanceData>( allocator, MAX_STATIC_MODEL_COUNT );
+		context.Occlusion = dk::core::allocate<OcclusionBuffer>( allocator, allocator );
+		context.ShadowBatches = dk::core::allocate<DrawBatchTable>( allocator, allocator, static_cast< u32 >( MAX_STATIC_MODEL_COUNT ), static_cast< u32 >( MAX_STATIC_MODEL_COUNT ) );
+		context.ShadowInstances = dk::core::allocateArray<GPUBatchData>( allocator, MAX_STATIC_MODEL_COUNT );
+	}
+
 #if DUSK_DEVBUILD
     memset( culledGeometryPrimitiveCount, 0, sizeof( u32 ) * MAX_SIMULTANEOUS_VIEWPORT_COUNT );
 #endif
@@ -92,8 +269,29 @@ DrawCommandBuilder::~DrawCommandBuilder()
 {
 	dk::core::free( memoryAllocator, cameraToRenderAllocator );
 	dk::core::free( memoryAllocator, staticModelsToRender );
-	dk::core::free( memoryAllocator, instanceDataAllocator );
-	dk::core::free( memoryAllocator, gpuInstanceDataAllocator );
+
+	dk::core::freeArray( memoryAllocator, staticModelSpheres.CenterX );
+	dk::core::freeArray( memoryAllocator, staticModelSpheres.CenterY );
+	dk::core::freeArray( memoryAllocator, staticModelSpheres.CenterZ );
+	dk::core::freeArray( memoryAllocator, staticModelSpheres.Radius );
+
+	for ( u32 cameraIdx = 0; cameraIdx < MAX_SIMULTANEOUS_VIEWPORT_COUNT; cameraIdx++ ) {
+		CameraDrawCmdContext& context = cameraContexts[cameraIdx];
+		dk::core::freeArray( memoryAllocator, context.VisibleModelIndexes );
+		dk::core::freeArray( memoryAllocator, context.ModelBatchIndexes );
+		dk::core::freeArray( memoryAllocator, context.InstanceLods );
+		dk::core::free( memoryAllocator, context.GeometryBatches );
+		dk::core::freeArray( memoryAllocator, context.RetainedDrawCmds );
+		dk::core::freeArray( memoryAllocator, context.RetainedDrawCmdSources );
+		dk::core::freeArray( memoryAllocator, context.BoundingSphereInstances );
+		dk::core::free( memoryAllocator, context.Occlusion );
+		dk::core::free( memoryAllocator, context.ShadowBatches );
+		dk::core::freeArray( memoryAllocator, context.ShadowInstances );
+	}
+	dk::core::freeArray( memoryAllocator, cameraContexts );
+	dk::core::freeArray( memoryAllocator, instanceStorage );
+	dk::core::freeArray( memoryAllocator, sharedLods[0] );
+	dk::core::freeArray( memoryAllocator, sharedLods[1] );
 }
 
 void DrawCommandBuilder::addWorldCameraToRender( CameraData* cameraData )
@@ -109,6 +307,11 @@ void DrawCommandBuilder::addWorldCameraToRender( CameraData* cameraData )
 
 void DrawCommandBuilder::addStaticModelInstance( const Model* model, const dkMat4x4f& modelMatrix, const u32 entityIndex )
 {
+    if ( staticModelsToRender->getAllocationCount() >= MAX_STATIC_MODEL_COUNT ) {
+        DUSK_LOG_WARN( "Failed to register model instance: too many instances(>=MAX_STATIC_MODEL_COUNT)!\n" );
+        return;
+    }
+
     ModelInstance* modelInstance = dk::core::allocate<ModelInstance>( staticModelsToRender );
     modelInstance->ModelResource = model;
     modelInstance->ModelMatrix = modelMatrix;
@@ -117,127 +320,233 @@ void DrawCommandBuilder::addStaticModelInstance( const Model* model, const dkMat
 
 void DrawCommandBuilder::prepareAndDispatchCommands( WorldRenderer* worldRenderer )
 {
-    u32 cameraIdx = 0;
+    DUSK_CPU_PROFILE_FUNCTION;
+
     CameraData* cameraArray = static_cast< CameraData* >( cameraToRenderAllocator->getBaseAddress() );
     const size_t cameraCount = cameraToRenderAllocator->getAllocationCount();
 
-	for ( ; cameraIdx < cameraCount; cameraIdx++ ) {
-		const CameraData& camera = cameraArray[cameraIdx];
+	// Bounding spheres don't depend on the camera; compute them once for every camera.
+	updateStaticModelSpheres();
+
+	// The first high priority camera shares its LOD selection with the low priority cameras.
+	lodReferenceCameraIndex = ~0u;
+	for ( u32 cameraIdx = 0; cameraIdx < cameraCount; cameraIdx++ ) {
+		if ( !cameraArray[cameraIdx].flags.isLowPriority ) {
+			lodReferenceCameraIndex = cameraIdx;
+			break;
+		}
+	}
+
+	// Build each camera on its own job. Jobs only write to the context of their camera.
+	JobCounter cameraJobCounter;
+	for ( u32 cameraIdx = 0; cameraIdx < cameraCount; cameraIdx++ ) {
+		CameraDrawCmdContext& context = cameraContexts[cameraIdx];
+		context.Camera = &cameraArray[cameraIdx];
+		context.GeometryBatches->beginFrame( frameIndex );
+		context.ShadowBatches->beginFrame( frameIndex );
+
+		if ( jobSystem != nullptr ) {
+			Job* cameraJob = jobSystem->createJob( &DrawCommandBuilder::BuildCameraDrawCmdsJob, &context );
+			jobSystem->submit( cameraJob, &cameraJobCounter );
+		} else {
+			BuildCameraDrawCmdsJob( &context, JobSystem::INVALID_WORKER_INDEX );
+		}
+    }
+
+	if ( jobSystem != nullptr ) {
+		jobSystem->wait( &cameraJobCounter );
+	}
+
+	// Merge the commands in camera order (so that the submission order is stable from a frame to another).
+	u32 dirtyInstanceBegin = ~0u;
+	u32 dirtyInstanceEnd = 0u;
+	for ( u32 cameraIdx = 0; cameraIdx < cameraCount; cameraIdx++ ) {
+		CameraDrawCmdContext& context = cameraContexts[cameraIdx];
+		mergeCameraDrawCmds( worldRenderer, context );
+
+		if ( context.DirtyInstanceBegin < context.DirtyInstanceEnd ) {
+			dirtyInstanceBegin = Min( dirtyInstanceBegin, context.GeometryInstanceOffset + context.DirtyInstanceBegin );
+			dirtyInstanceEnd = Max( dirtyInstanceEnd, context.GeometryInstanceOffset + context.DirtyInstanceEnd );
+		}
+	}
+
+	// Only the instances modified by this frame need to be uploaded.
+	worldRenderer->submitInstanceData( instanceStorage, dirtyInstanceBegin, dirtyInstanceEnd );
+
+	resetAllocators();
+
+	frameIndex++;
+}
+
+void DrawCommandBuilder::BuildCameraDrawCmdsJob( void* userData, const u32 workerIndex )
+{
+	DUSK_UNUSED_VARIABLE( workerIndex );
+
+	CameraDrawCmdContext& context = *static_cast< CameraDrawCmdContext* >( userData );
+	DrawCommandBuilder* builder = context.Builder;
 
 #if DUSK_DEVBUILD
-        culledGeometryPrimitiveCount[cameraIdx] = 0u;
+	builder->culledGeometryPrimitiveCount[context.CameraIndex] = 0u;
 #endif
 
-		buildGeometryDrawCmds( worldRenderer, &camera, cameraIdx );
+	const CameraData* camera = context.Camera;
+	context.LodProjectionScale = camera->viewportSize.y / ( 2.0f * tanf( camera->fov * 0.5f ) );
 
-		// TODO Conditionally enable this (find a way to check if we should render 
-		// CSM, or simply check if a camera wants to render CSM with SDSDM).
-		buildShadowGPUDrivenCullCmds( worldRenderer, &camera );
-    }
+	builder->buildGeometryDrawCmds( context );
 
-	resetAllocators();
+	// TODO Conditionally enable this (find a way to check if we should render 
+	// CSM, or simply check if a camera wants to render CSM with SDSDM).
+	builder->buildShadowGPUDrivenCullCmds( context );
 }
 
-void DrawCommandBuilder::buildShadowGPUDrivenCullCmds( WorldRenderer* worldRenderer, const CameraData* camera )
+void DrawCommandBuilder::buildShadowGPUDrivenCullCmds( CameraDrawCmdContext& context )
 {
-	struct LODGPUBatch
-	{
-		const Model::LevelOfDetail*     ModelLOD;
-		GPUBatchData*                   Instances;
-		u32                             InstanceCount;
-	};
+    DUSK_CPU_PROFILE_FUNCTION;
 
-	std::unordered_map<dkStringHash_t, LODGPUBatch> lodBatches;
+	const CameraData* camera = context.Camera;
+	DrawBatchTable& batchTable = *context.ShadowBatches;
 
-	ModelInstance* modelsArray = static_cast< ModelInstance* >( staticModelsToRender->getBaseAddress() );
-	const size_t modelCount = staticModelsToRender->getAllocationCount();
+	// First pass: find the LOD of each shadow caster and count the instances of each batch.
+	const ModelInstance* modelsArray = static_cast< const ModelInstance* >( staticModelsToRender->getBaseAddress() );
+	const u32 modelCount = static_cast< u32 >( staticModelsToRender->getAllocationCount() );
 	for ( u32 modelIdx = 0; modelIdx < modelCount; modelIdx++ ) {
 		const ModelInstance& modelInstance = modelsArray[modelIdx];
 
-		const dkMat4x4f& modelMatrix = modelInstance.ModelMatrix;
-		const Model* model = modelInstance.ModelResource;
-		const u32 entityIdx = modelInstance.EntityIdentifier;
-
-		// Retrieve instance location and scale.
-		const dkVec3f instancePosition = dk::maths::ExtractTranslation( modelMatrix );
+		// Retrieve instance location.
+		const dkVec3f instancePosition = dk::maths::ExtractTranslation( modelInstance.ModelMatrix );
 		const f32 distanceToCamera = dkVec3f::distanceSquared( camera->worldPosition, instancePosition );
 
 		// Ignore far away geometry (should fallback to distant shadows).
 		if ( distanceToCamera > ( CSM_MAX_DEPTH * CSM_MAX_DEPTH ) ) {
+			context.ModelBatchIndexes[modelIdx] = DrawBatchTable::INVALID_BATCH;
 			continue;
 		}
 
-		const f32 instanceScale = dk::maths::GetBiggestScalar( dk::maths::ExtractScale( modelMatrix ) );
+		// Instances visible from the camera reuse the LOD selected by the geometry pass.
+		const u32 lodIdx = selectInstanceLod( context, modelIdx );
+		const Model::LevelOfDetail& activeLOD = modelInstance.ModelResource->getLevelOfDetailByIndex( lodIdx );
 
-		BoundingSphere instanceBoundingSphere = model->getBoundingSphere();
-		instanceBoundingSphere.center += instancePosition;
-		instanceBoundingSphere.radius *= instanceScale;
+		context.ModelBatchIndexes[modelIdx] = batchTable.addInstance( activeLOD, distanceToCamera );
+	}
 
-		// Retrieve LOD based on instance to camera distance
-		const Model::LevelOfDetail& activeLOD = model->getLevelOfDetail( distanceToCamera );
+	// Assign a contiguous instance range to each batch.
+	batchTable.assignInstanceRanges();
 
-		// Check if a batch already exists for the given LOD.
-		auto batchIt = lodBatches.find( activeLOD.Hashcode );
-		if ( batchIt == lodBatches.end() ) {
-			LODGPUBatch batch;
-			batch.ModelLOD = &activeLOD;
-			batch.Instances = dk::core::allocateArray<GPUBatchData>( gpuInstanceDataAllocator, MAX_INSTANCE_COUNT_PER_MODEL );
-			batch.Instances[0].ModelMatrix = modelMatrix;
-			batch.Instances[0].BoundingSphereCenter = instanceBoundingSphere.center;
-			batch.Instances[0].BoundingSphereRadius = instanceBoundingSphere.radius;
+	// Second pass: fill the instances (in model order).
+	for ( u32 modelIdx = 0; modelIdx < modelCount; modelIdx++ ) {
+		const i32 batchIdx = context.ModelBatchIndexes[modelIdx];
+		if ( batchIdx == DrawBatchTable::INVALID_BATCH ) {
+			continue;
+		}
 
-			batch.InstanceCount = 1;
+		DrawBatchTable::Batch& batch = batchTable.getBatch( batchIdx );
+		GPUBatchData& instance = context.ShadowInstances[batch.InstanceOffset + batch.InstanceCount++];
+		instance.ModelMatrix = modelsArray[modelIdx].ModelMatrix;
+		instance.BoundingSphereCenter = dkVec3f( staticModelSpheres.CenterX[modelIdx], staticModelSpheres.CenterY[modelIdx], staticModelSpheres.CenterZ[modelIdx] );
+		instance.BoundingSphereRadius = staticModelSpheres.Radius[modelIdx];
+	}
+}
 
-			lodBatches.insert( std::make_pair( activeLOD.Hashcode, batch ) );
-		} else {
-			LODGPUBatch& batch = batchIt->second;
+void DrawCommandBuilder::updateStaticModelSpheres()
+{
+    DUSK_CPU_PROFILE_FUNCTION;
 
-			u32 instanceIdx = batch.InstanceCount;
-			batch.Instances[instanceIdx].ModelMatrix = modelMatrix;
-			batch.Instances[instanceIdx].BoundingSphereCenter = instanceBoundingSphere.center;
-			batch.Instances[instanceIdx].BoundingSphereRadius = instanceBoundingSphere.radius;
-			batch.InstanceCount++;
-		}
+	const ModelInstance* modelsArray = static_cast< const ModelInstance* >( staticModelsToRender->getBaseAddress() );
+	const size_t modelCount = staticModelsToRender->getAllocationCount();
+	for ( u32 modelIdx = 0; modelIdx < modelCount; modelIdx++ ) {
+		const ModelInstance& modelInstance = modelsArray[modelIdx];
+		const dkMat4x4f& modelMatrix = modelInstance.ModelMatrix;
+
+		// Transform the model bounding sphere to world space (must match the bounds used by the World renderable grid).
+		const f32 instanceScale = dk::maths::GetBiggestScalar( dk::maths::ExtractScale( modelMatrix ) );
+
+		const BoundingSphere& modelBoundingSphere = modelInstance.ModelResource->getBoundingSphere();
+		const dkVec3f sphereCenter = dkVec3f( dkVec4f( modelBoundingSphere.center, 1.0f ) * modelMatrix );
+
+		staticModelSpheres.CenterX[modelIdx] = sphereCenter.x;
+		staticModelSpheres.CenterY[modelIdx] = sphereCenter.y;
+		staticModelSpheres.CenterZ[modelIdx] = sphereCenter.z;
+		staticModelSpheres.Radius[modelIdx] = modelBoundingSphere.radius * instanceScale;
 	}
+}
 
-	// Merge all the shadow casters into a single vertex buffer.
-	for ( auto& lodBatch : lodBatches ) {
-		const LODGPUBatch& batch = lodBatch.second;
+u32 DrawCommandBuilder::selectInstanceLod( CameraDrawCmdContext& context, const u32 modelIdx )
+{
+	const ModelInstance& modelInstance = static_cast< const ModelInstance* >( staticModelsToRender->getBaseAddress() )[modelIdx];
+	const Model* model = modelInstance.ModelResource;
+
+	// Each pass of a camera shares the same selection.
+	LodSelection& selection = context.InstanceLods[modelIdx];
+	const bool isSameModel = ( selection.ModelResource == model );
+	if ( isSameModel && selection.FrameIndex == frameIndex ) {
+		return selection.LodIndex;
+	}
 
-		const Model::LevelOfDetail* lod = batch.ModelLOD;
-		for ( i32 meshIdx = 0; meshIdx < lod->MeshCount; meshIdx++ ) {
-			const Mesh& mesh = lod->MeshArray[meshIdx];
+	u32 lodIdx = Model::INVALID_LOD_INDEX;
 
-			GPUShadowDrawCmd& shadowCullCmd = worldRenderer->allocateGPUShadowCullDrawCmd();
-			shadowCullCmd.InstancesData = batch.Instances;
-            shadowCullCmd.ShadowMeshBatchIndex = mesh.RenderWorldIndex;
-            shadowCullCmd.InstanceCount = batch.InstanceCount;
+	// Low priority cameras reuse the selection made by the reference camera. The reference camera is built concurrently;
+	// its selection is therefore read from the previous frame.
+	const bool isReferenceCamera = ( context.CameraIndex == lodReferenceCameraIndex );
+	if ( !isReferenceCamera && context.Camera->flags.isLowPriority ) {
+		const LodSelection& referenceSelection = sharedLods[( frameIndex + 1u ) & 1u][modelIdx];
+		if ( referenceSelection.ModelResource == model && referenceSelection.FrameIndex == ( frameIndex - 1u ) ) {
+			lodIdx = referenceSelection.LodIndex;
 		}
 	}
+
+	if ( lodIdx == Model::INVALID_LOD_INDEX ) {
+		const CameraData* camera = context.Camera;
+		const dkVec3f sphereCenter( staticModelSpheres.CenterX[modelIdx], staticModelSpheres.CenterY[modelIdx], staticModelSpheres.CenterZ[modelIdx] );
+		const f32 distanceToBounds = sqrtf( dkVec3f::distanceSquared( camera->worldPosition, sphereCenter ) ) - staticModelSpheres.Radius[modelIdx];
+
+		// Size (in pixels) of one model space unit at the closest point of the instance bounds.
+		const f32 instanceScale = dk::maths::GetBiggestScalar( dk::maths::ExtractScale( modelInstance.ModelMatrix ) );
+		const f32 pixelsPerUnit = instanceScale * context.LodProjectionScale / Max( distanceToBounds, MIN_LOD_PROJECTION_DISTANCE );
+
+		// Models without error metrics use the (squared) distance to the instance origin.
+		const f32 distanceToCamera = dkVec3f::distanceSquared( camera->worldPosition, dk::maths::ExtractTranslation( modelInstance.ModelMatrix ) );
+
+		const u32 previousLodIdx = ( isSameModel ) ? selection.LodIndex : Model::INVALID_LOD_INDEX;
+		lodIdx = model->selectLevelOfDetail( pixelsPerUnit, distanceToCamera, LodMaxScreenError, LodHysteresis, previousLodIdx );
+	}
+
+	selection.ModelResource = model;
+	selection.FrameIndex = frameIndex;
+	selection.LodIndex = lodIdx;
+
+	// Only the reference camera writes to the shared selection (no synchronization is required).
+	if ( isReferenceCamera ) {
+		sharedLods[frameIndex & 1u][modelIdx] = selection;
+	}
+
+	return lodIdx;
 }
 
 void DrawCommandBuilder::resetAllocators()
 {
     cameraToRenderAllocator->clear();
     staticModelsToRender->clear();
-    instanceDataAllocator->clear();
-	gpuInstanceDataAllocator->clear();
 }
 
 template<DrawCommandKey::Layer layer, u8 viewportLayer>
-void AddCommand( WorldRenderer* worldRenderer, const LODBatch& batch, const u8 cameraIdx, const Material* material, const Mesh& mesh )
+void BuildCommand( DrawCmd& drawCmd, const LODBatch& batch, const u8 cameraIdx, const Material* material, const Mesh& mesh )
 {
-    // Allocate a depth render command
-    DrawCmd& drawCmd = worldRenderer->allocateDrawCmd();
+    drawCmd = DrawCmd();
 
+    // Translucent commands are sorted by their full precision depth key (the key depth is left to zero so that
+    // commands at the same depth are sorted by material).
     auto& key = drawCmd.key.bitfield;
     key.materialSortKey = material->getSortKey();
-    key.depth = DepthToBits( batch.ClosestDistance );
+    key.depth = ( layer == DrawCommandKey::LAYER_TRANSLUCENT ) ? 0u : DepthToBits( batch.ClosestDistance );
     key.sortOrder = ( material->isOpaque() ) ? DrawCommandKey::SORT_FRONT_TO_BACK : DrawCommandKey::SORT_BACK_TO_FRONT;
     key.layer = layer;
     key.viewportLayer = viewportLayer;
     key.viewportId = cameraIdx;
 
+    if ( layer == DrawCommandKey::LAYER_TRANSLUCENT ) {
+        drawCmd.depthKey = DepthToBackToFrontKey( batch.ClosestDistance );
+    }
+
     DrawCommandInfos& infos = drawCmd.infos;
     infos.material = material;
     infos.vertexBuffers = mesh.AttributeBuffers;
@@ -246,92 +555,277 @@ void AddCommand( WorldRenderer* worldRenderer, const LODBatch& batch, const u8 c
     infos.indiceBufferCount = mesh.IndiceCount;
     infos.alphaDitheringValue = 1.0f;
     infos.instanceCount = batch.InstanceCount;
-    infos.modelMatrix = batch.Instances;
+    infos.instanceDataOffset = batch.InstanceDataOffset;
 }
 
-void DrawCommandBuilder::buildGeometryDrawCmds( WorldRenderer* worldRenderer, const CameraData* camera, const u8 cameraIdx )
+void DrawCommandBuilder::buildGeometryDrawCmds( CameraDrawCmdContext& context )
 {
-    std::unordered_map<dkStringHash_t, LODBatch> lodBatches;
-    
-    DrawCommandInfos::InstanceData* boundingSphereInstanceData = ( DisplayBoundingSphere ) ? dk::core::allocateArray<DrawCommandInfos::InstanceData>( instanceDataAllocator, MAX_INSTANCE_COUNT_PER_MODEL ) : nullptr;
-    i32 boundingSphereCount = 0;
+    DUSK_CPU_PROFILE_FUNCTION;
 
-    // Do a first pass to perform a basic frustum culling and batch static geometry.
-	ModelInstance* modelsArray = static_cast< ModelInstance* >( staticModelsToRender->getBaseAddress() );
-	const size_t modelCount = staticModelsToRender->getAllocationCount();
-    for ( u32 modelIdx = 0; modelIdx < modelCount; modelIdx++ ) {
+	const CameraData* camera = context.Camera;
+	DrawBatchTable& batchTable = *context.GeometryBatches;
+	context.BoundingSphereCount = 0u;
+
+    // Do a first pass to perform a basic frustum culling (on the whole static model list at once), reject the models
+    // hidden by occluders and batch static geometry.
+	const ModelInstance* modelsArray = static_cast< const ModelInstance* >( staticModelsToRender->getBaseAddress() );
+	const u32 modelCount = static_cast< u32 >( staticModelsToRender->getAllocationCount() );
+	u32 visibleModelCount = dk::maths::CullSpheresInfReversedZ( camera->frustum, staticModelSpheres, modelCount, context.VisibleModelIndexes );
+
+	if ( EnableOcclusionCulling ) {
+		visibleModelCount = cullOccludedModels( context, visibleModelCount );
+	}
+
+#if DUSK_DEVBUILD
+	culledGeometryPrimitiveCount[context.CameraIndex] += ( modelCount - visibleModelCount );
+#endif
+
+    for ( u32 visibleIdx = 0; visibleIdx < visibleModelCount; visibleIdx++ ) {
+		const u32 modelIdx = context.VisibleModelIndexes[visibleIdx];
         const ModelInstance& modelInstance = modelsArray[modelIdx];
 
-        const dkMat4x4f& modelMatrix = modelInstance.ModelMatrix;
-        const Model* model = modelInstance.ModelResource;
-        const u32 entityIdx = modelInstance.EntityIdentifier;
+		const dkVec3f instancePosition = dk::maths::ExtractTranslation( modelInstance.ModelMatrix );
+		const f32 distanceToCamera = dkVec3f::distanceSquared( camera->worldPosition, instancePosition );
+
+		const u32 lodIdx = selectInstanceLod( context, modelIdx );
+		const Model::LevelOfDetail& activeLOD = modelInstance.ModelResource->getLevelOfDetailByIndex( lodIdx );
 
-        // Retrieve instance location and scale.
-		const dkVec3f instancePosition = dk::maths::ExtractTranslation( modelMatrix );
-		const f32 instanceScale = dk::maths::GetBiggestScalar( dk::maths::ExtractScale( modelMatrix ) );
+		context.ModelBatchIndexes[visibleIdx] = batchTable.addInstance( activeLOD, distanceToCamera );
 
-        BoundingSphere instanceBoundingSphere = model->getBoundingSphere();
-        instanceBoundingSphere.center += instancePosition;
-        instanceBoundingSphere.radius *= instanceScale;
-
-		if ( CullSphereInfReversedZ( &camera->frustum, instanceBoundingSphere ) > 0.0f ) {
-			const f32 distanceToCamera = dkVec3f::distanceSquared( camera->worldPosition, instancePosition );
-
-			// Retrieve LOD based on instance to camera distance
-			const Model::LevelOfDetail& activeLOD = model->getLevelOfDetail( distanceToCamera );
-
-            // Check if a batch already exists for the given LOD.
-            auto batchIt = lodBatches.find( activeLOD.Hashcode );
-            if ( batchIt == lodBatches.end() ) {
-                LODBatch batch;
-                batch.ModelLOD = &activeLOD;
-				batch.Instances = dk::core::allocateArray<DrawCommandInfos::InstanceData>( instanceDataAllocator, MAX_INSTANCE_COUNT_PER_MODEL );
-                batch.ClosestDistance = distanceToCamera;
-                batch.Instances[0].ModelMatrix = modelMatrix;
-                batch.Instances[0].EntityIdentifier = entityIdx;
-				batch.InstanceCount = 1;
-
-                lodBatches.insert( std::make_pair( activeLOD.Hashcode, batch ) );
-            } else {
-                LODBatch& batch = batchIt->second;
-
-				u32 instanceIdx = batch.InstanceCount;
-				batch.Instances[instanceIdx].ModelMatrix = modelMatrix;
-				batch.Instances[instanceIdx].EntityIdentifier = entityIdx;
-                batch.InstanceCount++;
-
-                batch.ClosestDistance = Min( batch.ClosestDistance, distanceToCamera );
-            }
+        // Draw debug bounding sphere.
+        if ( DisplayBoundingSphere ) {
+			const dkVec3f sphereCenter( staticModelSpheres.CenterX[modelIdx], staticModelSpheres.CenterY[modelIdx], staticModelSpheres.CenterZ[modelIdx] );
 
-            // Draw debug bounding sphere.
-            if ( DisplayBoundingSphere ) {
-                dkMat4x4f translationMat = dk::maths::MakeTranslationMat( instanceBoundingSphere.center );
-                dkMat4x4f scaleMat = dk::maths::MakeScaleMat( dkVec3f( instanceBoundingSphere.radius ) );
+            dkMat4x4f translationMat = dk::maths::MakeTranslationMat( sphereCenter );
+            dkMat4x4f scaleMat = dk::maths::MakeScaleMat( dkVec3f( staticModelSpheres.Radius[modelIdx] ) );
 
-                const u32 bbIndex = boundingSphereCount;
-                boundingSphereInstanceData[bbIndex].ModelMatrix = translationMat * scaleMat;
-                boundingSphereInstanceData[bbIndex].EntityIdentifier = 0;
-                boundingSphereCount++;
-            }
-        }
-#if DUSK_DEVBUILD
-        else {
-            culledGeometryPrimitiveCount[cameraIdx]++;
+            DrawCommandInfos::InstanceData& sphereInstance = context.BoundingSphereInstances[context.BoundingSphereCount++];
+            sphereInstance.ModelMatrix = translationMat * scaleMat;
+            sphereInstance.EntityIdentifier = 0;
         }
-#endif
     }
 
-    // Build draw commands from the batches.
-    for ( auto& lodBatch : lodBatches ) {
-        const LODBatch& batch = lodBatch.second;
+	// Make sure each batch owns an instance range large enough (ranges are kept from a frame to another).
+	context.IsGeometryLayoutChanged = batchTable.assignInstanceRanges() || !RetainStaticGeometry;
+
+	// Second pass: fill the instances (in visibility order). An instance is only written if it differs from the
+	// instance retained in its slot.
+	context.DirtyInstanceBegin = ~0u;
+	context.DirtyInstanceEnd = 0u;
+
+	for ( u32 visibleIdx = 0; visibleIdx < visibleModelCount; visibleIdx++ ) {
+		const ModelInstance& modelInstance = modelsArray[context.VisibleModelIndexes[visibleIdx]];
+
+		DrawCommandInfos::InstanceData instance;
+		instance.ModelMatrix = modelInstance.ModelMatrix;
+		instance.EntityIdentifier = modelInstance.EntityIdentifier;
+		instance.LodDitheringAlpha = 1.0f;
+		instance.__PADDING__[0] = 0u;
+		instance.__PADDING__[1] = 0u;
+
+		DrawBatchTable::Batch& batch = batchTable.getBatch( context.ModelBatchIndexes[visibleIdx] );
+		const u32 instanceIdx = batch.InstanceOffset + batch.InstanceCount++;
+
+		DrawCommandInfos::InstanceData& retainedInstance = context.GeometryInstances[instanceIdx];
+		if ( !RetainStaticGeometry || memcmp( &retainedInstance, &instance, sizeof( DrawCommandInfos::InstanceData ) ) != 0 ) {
+			retainedInstance = instance;
+
+			context.DirtyInstanceBegin = Min( context.DirtyInstanceBegin, instanceIdx );
+			context.DirtyInstanceEnd = Max( context.DirtyInstanceEnd, instanceIdx + 1u );
+		}
+	}
+}
+
+u32 DrawCommandBuilder::cullOccludedModels( CameraDrawCmdContext& context, const u32 visibleModelCount )
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+	const ModelInstance* modelsArray = static_cast< const ModelInstance* >( staticModelsToRender->getBaseAddress() );
+	OcclusionBuffer& occlusionBuffer = *context.Occlusion;
+
+	// Rasterize the occluders which passed the frustum test (an occluder outside the frustum can't hide anything inside
+	// the frustum).
+	occlusionBuffer.clear( context.Camera->viewProjectionMatrix );
+	for ( u32 visibleIdx = 0; visibleIdx < visibleModelCount; visibleIdx++ ) {
+		const ModelInstance& modelInstance = modelsArray[context.VisibleModelIndexes[visibleIdx]];
+		const OccluderMesh* occluder = modelInstance.ModelResource->getOccluderMesh();
+		if ( occluder != nullptr ) {
+			occlusionBuffer.rasterizeOccluder( *occluder, modelInstance.ModelMatrix );
+		}
+	}
+
+	if ( occlusionBuffer.getOccluderCount() == 0u ) {
+		return visibleModelCount;
+	}
+
+	occlusionBuffer.buildHierarchy();
+
+	// Test the bounds of the occludees (occluders are always kept) and compact the visible list in place.
+	u32 unoccludedModelCount = 0u;
+	for ( u32 visibleIdx = 0; visibleIdx < visibleModelCount; visibleIdx++ ) {
+		const u32 modelIdx = context.VisibleModelIndexes[visibleIdx];
+
+		if ( modelsArray[modelIdx].ModelResource->getOccluderMesh() == nullptr ) {
+			const dkVec3f sphereCenter( staticModelSpheres.CenterX[modelIdx], staticModelSpheres.CenterY[modelIdx], staticModelSpheres.CenterZ[modelIdx] );
+			if ( occlusionBuffer.isSphereOccluded( sphereCenter, staticModelSpheres.Radius[modelIdx] ) ) {
+				continue;
+			}
+		}
+
+		context.VisibleModelIndexes[unoccludedModelCount++] = modelIdx;
+	}
+
+	return unoccludedModelCount;
+}
+
+void DrawCommandBuilder::mergeCameraDrawCmds( WorldRenderer* worldRenderer, CameraDrawCmdContext& context )
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    // Geometry draw commands only depend on the batch layout (and the materials); if the layout is unchanged, the
+    // commands built during the previous frames only need their depth to be updated.
+    if ( context.IsGeometryLayoutChanged || !patchRetainedDrawCmds( context ) ) {
+        rebuildRetainedDrawCmds( context );
+    }
+
+    if ( context.RetainedDrawCmdCount != 0u ) {
+        DrawCmd* drawCmds = worldRenderer->allocateDrawCmds( context.RetainedDrawCmdCount );
+        memcpy( drawCmds, context.RetainedDrawCmds, sizeof( DrawCmd ) * context.RetainedDrawCmdCount );
+    }
+
+	// Merge all the shadow casters into a single vertex buffer.
+	const DrawBatchTable& shadowBatches = *context.ShadowBatches;
+	for ( u32 activeIdx = 0; activeIdx < shadowBatches.getActiveBatchCount(); activeIdx++ ) {
+		const DrawBatchTable::Batch& batch = shadowBatches.getBatch( shadowBatches.getActiveBatchIndex( activeIdx ) );
+		const Model::LevelOfDetail* lod = batch.ModelLOD;
+
+		for ( u32 instanceIdx = 0; instanceIdx < batch.InstanceCount; instanceIdx += MAX_INSTANCE_COUNT_PER_BATCH ) {
+			for ( i32 meshIdx = 0; meshIdx < lod->MeshCount; meshIdx++ ) {
+				const Mesh& mesh = lod->MeshArray[meshIdx];
+
+				GPUShadowDrawCmd& shadowCullCmd = worldRenderer->allocateGPUShadowCullDrawCmd();
+				shadowCullCmd.InstancesData = context.ShadowInstances + batch.InstanceOffset + instanceIdx;
+				shadowCullCmd.ShadowMeshBatchIndex = mesh.RenderWorldIndex;
+				shadowCullCmd.InstanceCount = Min( batch.InstanceCount - instanceIdx, MAX_INSTANCE_COUNT_PER_BATCH );
+			}
+		}
+	}
+}
+
+void DrawCommandBuilder::rebuildRetainedDrawCmds( CameraDrawCmdContext& context )
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    context.RetainedDrawCmdCount = 0u;
+    context.IsTranslucentSplit = SplitTranslucentInstances;
 
+    // Build draw commands from the batches (batches with too many instances are split in several draws).
+    const DrawBatchTable& geometryBatches = *context.GeometryBatches;
+    for ( u32 activeIdx = 0; activeIdx < geometryBatches.getActiveBatchCount(); activeIdx++ ) {
+        const i32 batchIdx = geometryBatches.getActiveBatchIndex( activeIdx );
+        const DrawBatchTable::Batch& batch = geometryBatches.getBatch( batchIdx );
         const Model::LevelOfDetail* lod = batch.ModelLOD;
-        for ( i32 meshIdx = 0; meshIdx < lod->MeshCount; meshIdx++ ) {
-            const Mesh& mesh = lod->MeshArray[meshIdx];
-            const Material* material = mesh.RenderMaterial;
 
-            AddCommand<DrawCommandKey::LAYER_WORLD, DrawCommandKey::WORLD_VIEWPORT_LAYER_DEFAULT>( worldRenderer, batch, cameraIdx, material, mesh );
-            AddCommand<DrawCommandKey::LAYER_DEPTH, DrawCommandKey::DEPTH_VIEWPORT_LAYER_DEFAULT>( worldRenderer, batch, cameraIdx, material, mesh );
+        for ( u32 instanceIdx = 0; instanceIdx < batch.InstanceCount; instanceIdx += MAX_INSTANCE_COUNT_PER_BATCH ) {
+            LODBatch draw;
+            draw.ModelLOD = lod;
+            draw.InstanceDataOffset = context.GeometryInstanceOffset + batch.InstanceOffset + instanceIdx;
+            draw.InstanceCount = Min( batch.InstanceCount - instanceIdx, MAX_INSTANCE_COUNT_PER_BATCH );
+            draw.ClosestDistance = batch.ClosestDistance;
+
+            for ( i32 meshIdx = 0; meshIdx < lod->MeshCount; meshIdx++ ) {
+                const Mesh& mesh = lod->MeshArray[meshIdx];
+                const Material* material = mesh.RenderMaterial;
+
+                if ( material->isTranslucent() ) {
+                    if ( context.IsTranslucentSplit && draw.InstanceCount > 1u ) {
+                        buildTranslucentInstanceDrawCmds( context, batchIdx, draw, mesh );
+                    } else {
+                        BuildCommand<DrawCommandKey::LAYER_TRANSLUCENT, DrawCommandKey::TRANSLUCENT_VIEWPORT_LAYER_DEFAULT>( allocateRetainedDrawCmd( context, batchIdx, &mesh ), draw, context.CameraIndex, material, mesh );
+                    }
+
+                    // Translucent geometry does not write to the depth buffer.
+                    continue;
+                }
+
+                BuildCommand<DrawCommandKey::LAYER_WORLD, DrawCommandKey::WORLD_VIEWPORT_LAYER_DEFAULT>( allocateRetainedDrawCmd( context, batchIdx, &mesh ), draw, context.CameraIndex, material, mesh );
+                BuildCommand<DrawCommandKey::LAYER_DEPTH, DrawCommandKey::DEPTH_VIEWPORT_LAYER_DEFAULT>( allocateRetainedDrawCmd( context, batchIdx, &mesh ), draw, context.CameraIndex, material, mesh );
+            }
+        }
+    }
+}
+
+bool DrawCommandBuilder::patchRetainedDrawCmds( CameraDrawCmdContext& context )
+{
+    DUSK_CPU_PROFILE_FUNCTION;
+
+    if ( context.IsTranslucentSplit != SplitTranslucentInstances ) {
+        return false;
+    }
+
+    const DrawBatchTable& geometryBatches = *context.GeometryBatches;
+    for ( u32 drawCmdIdx = 0; drawCmdIdx < context.RetainedDrawCmdCount; drawCmdIdx++ ) {
+        DrawCmd& drawCmd = context.RetainedDrawCmds[drawCmdIdx];
+        const RetainedDrawCmdSource& source = context.RetainedDrawCmdSources[drawCmdIdx];
+
+        // The key depends on the material; a swapped (or modified) material invalidates the command.
+        const Material* material = source.SourceMesh->RenderMaterial;
+        if ( drawCmd.infos.material != material || drawCmd.key.bitfield.materialSortKey != material->getSortKey() ) {
+            return false;
+        }
+
+        if ( drawCmd.key.bitfield.layer != DrawCommandKey::LAYER_TRANSLUCENT ) {
+            drawCmd.key.bitfield.depth = DepthToBits( geometryBatches.getBatch( source.BatchIndex ).ClosestDistance );
+        } else if ( source.InstanceIndex != ~0u ) {
+            drawCmd.depthKey = DepthToBackToFrontKey( GetInstanceDistance( context.Camera, context.GeometryInstances[source.InstanceIndex] ) );
+        } else {
+            drawCmd.depthKey = DepthToBackToFrontKey( geometryBatches.getBatch( source.BatchIndex ).ClosestDistance );
         }
     }
+
+    return true;
+}
+
+void DrawCommandBuilder::buildTranslucentInstanceDrawCmds( CameraDrawCmdContext& context, const i32 batchIndex, const LODBatch& draw, const Mesh& mesh )
+{
+    const u32 firstInstanceIdx = draw.InstanceDataOffset - context.GeometryInstanceOffset;
+
+    LODBatch instanceDraw = draw;
+    instanceDraw.InstanceCount = 1u;
+
+    for ( u32 instanceIdx = 0u; instanceIdx < draw.InstanceCount; instanceIdx++ ) {
+        const u32 geometryInstanceIdx = firstInstanceIdx + instanceIdx;
+
+        instanceDraw.InstanceDataOffset = draw.InstanceDataOffset + instanceIdx;
+        instanceDraw.ClosestDistance = GetInstanceDistance( context.Camera, context.GeometryInstances[geometryInstanceIdx] );
+
+        DrawCmd& drawCmd = allocateRetainedDrawCmd( context, batchIndex, &mesh, geometryInstanceIdx );
+        BuildCommand<DrawCommandKey::LAYER_TRANSLUCENT, DrawCommandKey::TRANSLUCENT_VIEWPORT_LAYER_DEFAULT>( drawCmd, instanceDraw, context.CameraIndex, mesh.RenderMaterial, mesh );
+    }
+}
+
+DrawCmd& DrawCommandBuilder::allocateRetainedDrawCmd( CameraDrawCmdContext& context, const i32 batchIndex, const Mesh* mesh, const u32 instanceIndex )
+{
+    if ( context.RetainedDrawCmdCount == context.RetainedDrawCmdCapacity ) {
+        const u32 newCapacity = context.RetainedDrawCmdCapacity * 2u;
+
+        DrawCmd* newDrawCmds = dk::core::allocateArray<DrawCmd>( memoryAllocator, newCapacity );
+        RetainedDrawCmdSource* newSources = dk::core::allocateArray<RetainedDrawCmdSource>( memoryAllocator, newCapacity );
+        memcpy( newDrawCmds, context.RetainedDrawCmds, sizeof( DrawCmd ) * context.RetainedDrawCmdCount );
+        memcpy( newSources, context.RetainedDrawCmdSources, sizeof( RetainedDrawCmdSource ) * context.RetainedDrawCmdCount );
+
+        dk::core::freeArray( memoryAllocator, context.RetainedDrawCmds );
+        dk::core::freeArray( memoryAllocator, context.RetainedDrawCmdSources );
+
+        context.RetainedDrawCmds = newDrawCmds;
+        context.RetainedDrawCmdSources = newSources;
+        context.RetainedDrawCmdCapacity = newCapacity;
+    }
+
+    RetainedDrawCmdSource& source = context.RetainedDrawCmdSources[context.RetainedDrawCmdCount];
+    source.BatchIndex = batchIndex;
+    source.SourceMesh = mesh;
+    source.InstanceIndex = instanceIndex;
+
+    return context.RetainedDrawCmds[context.RetainedDrawCmdCount++];
 }
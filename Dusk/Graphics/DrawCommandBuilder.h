@@ -5,16 +5,21 @@
 #pragma once
 
 #include <Maths/Matrix.h>
+#include <Maths/FrustumCulling.h>
+#include <Graphics/DrawCommand.h>
 
 class BaseAllocator;
 class LinearAllocator;
 class WorldRenderer;
+class JobSystem;
 class Model;
 class FrameGraph;
 struct CameraData;
 struct LODBatch;
 class Material;
 struct Mesh;
+struct CameraDrawCmdContext;
+struct LodSelection;
 
 class DrawCommandBuilder
 {
@@ -30,7 +35,7 @@ public:
 #endif
 
 public:
-						DrawCommandBuilder( BaseAllocator* allocator );
+						DrawCommandBuilder( BaseAllocator* allocator, JobSystem* jobSystem );
 						DrawCommandBuilder( DrawCommandBuilder& ) = delete;
 						DrawCommandBuilder& operator = ( DrawCommandBuilder& ) = delete;
 						~DrawCommandBuilder();
@@ -46,6 +51,10 @@ public:
 
 	// Build render queues for each type of render scenario and enqueued cameras.
 	// This call will also update/stream the light grid entities.
+	// Each camera is built by an independent job; the commands are then merged in camera order (the output does not
+	// depend on the order the jobs are executed in).
+	// Static geometry is retained: instance data and draw commands persist across frames and are only patched if the
+	// geometry has changed (only the modified instances are submitted for upload).
 	void				prepareAndDispatchCommands( WorldRenderer* worldRenderer );
 
 private:
@@ -61,11 +70,30 @@ private:
 	// Allocator used to allocate local copies of incoming models.
 	LinearAllocator*	staticModelsToRender;
 
-	// Allocator used to allocate instance data to render batched models/geometry.
-	LinearAllocator*	instanceDataAllocator;
+	// JobSystem used to build the cameras in parallel.
+	JobSystem*			jobSystem;
 
-	// Allocator used to allocate instance data for GPU driven draw call submit.
-	LinearAllocator*	gpuInstanceDataAllocator;
+	// World space bounding spheres of the static models to render (indexed by static model index; updated once per
+	// frame and shared by every camera).
+	BoundingSphereSoA	staticModelSpheres;
+
+	// Per-camera build state (draw commands, instance data, etc.). Indexed by camera index.
+	CameraDrawCmdContext*	cameraContexts;
+
+	// Instance data of the geometry batches (persistent; matches the FrameGraph instance vector buffer). Each camera
+	// owns a region of MAX_STATIC_MODEL_COUNT instances.
+	DrawCommandInfos::InstanceData*	instanceStorage;
+
+	// Index of the frame being built (used to recycle the batches unused for several frames).
+	u32					frameIndex;
+
+	// LODs selected by the reference camera (indexed by static model index). Double buffered: the reference camera
+	// writes the selection of the current frame while the low priority cameras read the selection of the previous one.
+	LodSelection*		sharedLods[2];
+
+	// Index of the camera whose LOD selection is reused by the low priority cameras (~0u if every camera is low
+	// priority).
+	u32					lodReferenceCameraIndex;
 
 #if DUSK_DEVBUILD
 	// The number of primitive geometry culled (either by occlusion culling or frustum culling).
@@ -77,9 +105,42 @@ private:
 	// the transistent data.
 	void				resetAllocators();
 
+	// Compute the world space bounding spheres of the static models to render.
+	void				updateStaticModelSpheres();
+
+	// Build the commands of a single camera (JobSystem entry point; userData is the CameraDrawCmdContext to build).
+	static void			BuildCameraDrawCmdsJob( void* userData, const u32 workerIndex );
+
+	// Return the index of the LOD of a static model for a given camera. The LOD is selected from its projected error
+	// (with hysteresis) once per frame and camera; low priority cameras reuse the selection of the reference camera.
+	u32					selectInstanceLod( CameraDrawCmdContext& context, const u32 modelIdx );
+
 	// Build Draw Commands for the different layers and viewports layers of a given camera.
-	void                buildGeometryDrawCmds( WorldRenderer* worldRenderer, const CameraData* camera, const u8 cameraIdx );
+	void                buildGeometryDrawCmds( CameraDrawCmdContext& context );
+
+	// Remove the models hidden by the occluders from the visible model list of a camera (the list is compacted in place).
+	// Return the number of models left.
+	u32					cullOccludedModels( CameraDrawCmdContext& context, const u32 visibleModelCount );
 
 	// Build instances informations to generate shadow draw commands on the GPU.
-	void				buildShadowGPUDrivenCullCmds( WorldRenderer* worldRenderer, const CameraData* camera );
+	void				buildShadowGPUDrivenCullCmds( CameraDrawCmdContext& context );
+
+	// Append the commands built for a given camera to the WorldRenderer queues (called once every camera is built).
+	void				mergeCameraDrawCmds( WorldRenderer* worldRenderer, CameraDrawCmdContext& context );
+
+	// Rebuild the retained geometry draw commands of a camera from its batches.
+	void				rebuildRetainedDrawCmds( CameraDrawCmdContext& context );
+
+	// Update the depth of the retained geometry draw commands of a camera. Return false if a command is no longer valid
+	// (e.g. if the material of a mesh has been swapped or if translucent instances splitting has been toggled).
+	bool				patchRetainedDrawCmds( CameraDrawCmdContext& context );
+
+	// Build one translucent draw command per instance of 'draw' (so that each instance is sorted back to front on its
+	// own instead of using the depth of its batch).
+	void				buildTranslucentInstanceDrawCmds( CameraDrawCmdContext& context, const i32 batchIndex, const LODBatch& draw, const Mesh& mesh );
+
+	// Allocate a retained draw command (the retained storage grows if needed). 'instanceIndex' is the instance drawn by
+	// the command if the command draws a single instance of its batch (~0u otherwise). The returned reference is only
+	// valid until the next allocation.
+	DrawCmd&			allocateRetainedDrawCmd( CameraDrawCmdContext& context, const i32 batchIndex, const Mesh* mesh, const u32 instanceIndex = ~0u );
 };
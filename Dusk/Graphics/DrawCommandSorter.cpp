@@ -0,0 +1,415 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "DrawCommandSorter.h"
+
+#include <Core/JobSystem.h>
+
+DrawCommandSorter::DrawCommandSorter( BaseAllocator* allocator, JobSystem* jobSystem )
+    : memoryAllocator( allocator )
+    , jobSystem( jobSystem )
+    , keys{ nullptr, nullptr }
+    , indexes{ nullptr, nullptr }
+    , sortedDrawCmds( nullptr )
+    , capacity( 0u )
+    , taskCount( 0u )
+    , unsortedDrawCmds( nullptr )
+    , sourceBufferIndex( 0u )
+    , digitShift( 0u )
+{
+    for ( u32 taskIdx = 0u; taskIdx < MAX_TASK_COUNT; taskIdx++ ) {
+        tasks[taskIdx].Sorter = this;
+    }
+
+    reserve( DEFAULT_CAPACITY );
+}
+
+DrawCommandSorter::~DrawCommandSorter()
+{
+    releaseStorage();
+}
+
+DrawCmd* DrawCommandSorter::sort( DrawCmd* drawCmds, const u32 drawCmdCount )
+{
+    if ( drawCmdCount <= 1u ) {
+        return drawCmds;
+    }
+
+    reserve( drawCmdCount );
+
+    // Split the sort into tasks.
+    const u32 maxTaskCount = ( jobSystem != nullptr ) ? Min( jobSystem->getWorkerCount(), MAX_TASK_COUNT ) : 1u;
+    taskCount = Max( Min( drawCmdCount / MIN_DRAW_CMD_COUNT_PER_TASK, maxTaskCount ), 1u );
+
+    for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+        SortTask& task = tasks[taskIdx];
+        task.Begin = static_cast< u32 >( ( static_cast< u64 >( drawCmdCount ) * taskIdx ) / taskCount );
+        task.End = static_cast< u32 >( ( static_cast< u64 >( drawCmdCount ) * ( taskIdx + 1u ) ) / taskCount );
+    }
+
+    unsortedDrawCmds = drawCmds;
+    sourceBufferIndex = 0u;
+
+    dispatchTasks( &DrawCommandSorter::InitializeKeysJob );
+
+    bool isSorted = true;
+    u64 keyAnd = ~0ull;
+    u64 keyOr = 0ull;
+    for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+        isSorted &= tasks[taskIdx].IsSorted;
+        keyAnd &= tasks[taskIdx].KeyAnd;
+        keyOr |= tasks[taskIdx].KeyOr;
+    }
+
+    // Bits which differ between at least two keys (a pass is useless if its digit is identical for every key).
+    const u64 varyingBits = ( isSorted ) ? 0ull : ( keyAnd ^ keyOr );
+
+    for ( u32 passIdx = 0u; passIdx < PASS_COUNT; passIdx++ ) {
+        digitShift = passIdx * RADIX_BITS;
+
+        if ( ( ( varyingBits >> digitShift ) & ( HISTOGRAM_SIZE - 1u ) ) == 0ull ) {
+            continue;
+        }
+
+        dispatchTasks( &DrawCommandSorter::BuildHistogramJob );
+
+        // Turn the histograms into scatter offsets (digit major, task minor to keep the sort stable).
+        u32 offset = 0u;
+        for ( u32 digit = 0u; digit < HISTOGRAM_SIZE; digit++ ) {
+            for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+                const u32 count = tasks[taskIdx].Histogram[digit];
+                tasks[taskIdx].Histogram[digit] = offset;
+                offset += count;
+            }
+        }
+
+        dispatchTasks( &DrawCommandSorter::ScatterKeysJob );
+
+        sourceBufferIndex ^= 1u;
+    }
+
+    // Keys are only 64 bits wide; translucent commands need a full precision depth to be sorted back to front.
+    const bool isTranslucentOrderChanged = sortTranslucentRanges( drawCmdCount );
+
+    if ( isSorted && !isTranslucentOrderChanged ) {
+        return drawCmds;
+    }
+
+    dispatchTasks( &DrawCommandSorter::GatherDrawCmdsJob );
+
+    return sortedDrawCmds;
+}
+
+void DrawCommandSorter::SortSerial( DrawCmd* drawCmds, DrawCmd* tempDrawCmds, const u32 drawCmdCount )
+{
+    static constexpr size_t RADIXSORT_BITS = 11;
+    static constexpr size_t RADIXSORT_HISTOGRAM_SIZE = ( 1 << RADIXSORT_BITS );
+    static constexpr size_t RADIXSORT_BIT_MASK = ( RADIXSORT_HISTOGRAM_SIZE - 1 );
+
+    if ( drawCmdCount == 0u ) {
+        return;
+    }
+
+    DrawCmd* keys = drawCmds;
+    DrawCmd* tempKeys = tempDrawCmds;
+
+    u32 histogram[RADIXSORT_HISTOGRAM_SIZE];
+    u32 shift = 0;
+    u32 pass = 0;
+    for ( ; pass < 6; ++pass ) {
+        memset( histogram, 0, sizeof( u32 ) * RADIXSORT_HISTOGRAM_SIZE );
+
+        bool sorted = true;
+        {
+            u64 key = keys[0].key.value;
+            u64 prevKey = key;
+            for ( u32 ii = 0; ii < drawCmdCount; ++ii, prevKey = key ) {
+                key = keys[ii].key.value;
+
+                const u32 index = static_cast< u32 >( ( key >> shift ) & RADIXSORT_BIT_MASK );
+                ++histogram[index];
+
+                sorted &= ( prevKey <= key );
+            }
+        }
+
+        if ( sorted ) {
+            break;
+        }
+
+        u32 offset = 0;
+        for ( u32 ii = 0; ii < RADIXSORT_HISTOGRAM_SIZE; ++ii ) {
+            const u32 count = histogram[ii];
+            histogram[ii] = offset;
+
+            offset += count;
+        }
+
+        for ( u32 ii = 0; ii < drawCmdCount; ++ii ) {
+            const u64 key = keys[ii].key.value;
+            const u32 index = static_cast< u32 >( ( key >> shift ) & RADIXSORT_BIT_MASK );
+            const u32 dest = histogram[index]++;
+
+            tempKeys[dest] = keys[ii];
+        }
+
+        DrawCmd* swapKeys = tempKeys;
+        tempKeys = keys;
+        keys = swapKeys;
+
+        shift += RADIXSORT_BITS;
+    }
+
+    if ( ( pass & 1 ) != 0 ) {
+        memcpy( drawCmds, tempDrawCmds, drawCmdCount * sizeof( DrawCmd ) );
+    }
+}
+
+void DrawCommandSorter::reserve( const u32 drawCmdCount )
+{
+    if ( drawCmdCount <= capacity ) {
+        return;
+    }
+
+    // The content does not need to be preserved (the storage is only used during a sort).
+    releaseStorage();
+
+    u32 newCapacity = Max( capacity, DEFAULT_CAPACITY );
+    while ( newCapacity < drawCmdCount ) {
+        newCapacity *= 2u;
+    }
+
+    keys[0] = dk::core::allocateArray<u64>( memoryAllocator, newCapacity );
+    keys[1] = dk::core::allocateArray<u64>( memoryAllocator, newCapacity );
+    indexes[0] = dk::core::allocateArray<u32>( memoryAllocator, newCapacity );
+    indexes[1] = dk::core::allocateArray<u32>( memoryAllocator, newCapacity );
+    sortedDrawCmds = dk::core::allocateArray<DrawCmd>( memoryAllocator, newCapacity );
+
+    capacity = newCapacity;
+}
+
+void DrawCommandSorter::releaseStorage()
+{
+    if ( sortedDrawCmds == nullptr ) {
+        return;
+    }
+
+    dk::core::freeArray( memoryAllocator, keys[0] );
+    dk::core::freeArray( memoryAllocator, keys[1] );
+    dk::core::freeArray( memoryAllocator, indexes[0] );
+    dk::core::freeArray( memoryAllocator, indexes[1] );
+    dk::core::freeArray( memoryAllocator, sortedDrawCmds );
+
+    keys[0] = nullptr;
+    keys[1] = nullptr;
+    indexes[0] = nullptr;
+    indexes[1] = nullptr;
+    sortedDrawCmds = nullptr;
+}
+
+bool DrawCommandSorter::sortTranslucentRanges( const u32 drawCmdCount )
+{
+    static constexpr u32 DEPTH_PASS_COUNT = ( 32u / RADIX_BITS );
+
+    const u64* sortedKeys = keys[sourceBufferIndex];
+    u32* sortedIndexes = indexes[sourceBufferIndex];
+    u32* tempIndexes = indexes[sourceBufferIndex ^ 1u];
+
+    bool isOrderChanged = false;
+    u32 histogram[HISTOGRAM_SIZE];
+
+    for ( u32 rangeBegin = 0u; rangeBegin < drawCmdCount; ) {
+        DrawCommandKey rangeKey;
+        rangeKey.value = sortedKeys[rangeBegin];
+
+        // Find the end of the range (commands of a layer are contiguous for a given viewport once sorted).
+        u32 rangeEnd = rangeBegin + 1u;
+        for ( ; rangeEnd < drawCmdCount; rangeEnd++ ) {
+            DrawCommandKey key;
+            key.value = sortedKeys[rangeEnd];
+
+            if ( key.bitfield.layer != rangeKey.bitfield.layer
+              || key.bitfield.viewportLayer != rangeKey.bitfield.viewportLayer
+              || key.bitfield.viewportId != rangeKey.bitfield.viewportId ) {
+                break;
+            }
+        }
+
+        if ( rangeKey.bitfield.layer != DrawCommandKey::LAYER_TRANSLUCENT || ( rangeEnd - rangeBegin ) < 2u ) {
+            rangeBegin = rangeEnd;
+            continue;
+        }
+
+        // Compute the digits which differ within the range (and skip the range if it's already sorted).
+        u32 depthKeyAnd = ~0u;
+        u32 depthKeyOr = 0u;
+        bool isSorted = true;
+        u32 previousDepthKey = 0u;
+        for ( u32 i = rangeBegin; i < rangeEnd; i++ ) {
+            const u32 depthKey = unsortedDrawCmds[sortedIndexes[i]].depthKey;
+
+            depthKeyAnd &= depthKey;
+            depthKeyOr |= depthKey;
+            isSorted &= ( previousDepthKey <= depthKey );
+
+            previousDepthKey = depthKey;
+        }
+
+        if ( isSorted ) {
+            rangeBegin = rangeEnd;
+            continue;
+        }
+
+        // Serial LSD radix sort of the range indexes (translucent ranges are usually small).
+        const u32 varyingBits = ( depthKeyAnd ^ depthKeyOr );
+        u32* sourceIndexes = sortedIndexes;
+        u32* destIndexes = tempIndexes;
+
+        for ( u32 passIdx = 0u; passIdx < DEPTH_PASS_COUNT; passIdx++ ) {
+            const u32 shift = passIdx * RADIX_BITS;
+            if ( ( ( varyingBits >> shift ) & ( HISTOGRAM_SIZE - 1u ) ) == 0u ) {
+                continue;
+            }
+
+            memset( histogram, 0, sizeof( u32 ) * HISTOGRAM_SIZE );
+            for ( u32 i = rangeBegin; i < rangeEnd; i++ ) {
+                histogram[( unsortedDrawCmds[sourceIndexes[i]].depthKey >> shift ) & ( HISTOGRAM_SIZE - 1u )]++;
+            }
+
+            u32 offset = rangeBegin;
+            for ( u32 digit = 0u; digit < HISTOGRAM_SIZE; digit++ ) {
+                const u32 count = histogram[digit];
+                histogram[digit] = offset;
+                offset += count;
+            }
+
+            for ( u32 i = rangeBegin; i < rangeEnd; i++ ) {
+                const u32 index = sourceIndexes[i];
+                destIndexes[histogram[( unsortedDrawCmds[index].depthKey >> shift ) & ( HISTOGRAM_SIZE - 1u )]++] = index;
+            }
+
+            u32* swapIndexes = sourceIndexes;
+            sourceIndexes = destIndexes;
+            destIndexes = swapIndexes;
+        }
+
+        if ( sourceIndexes != sortedIndexes ) {
+            memcpy( sortedIndexes + rangeBegin, sourceIndexes + rangeBegin, sizeof( u32 ) * ( rangeEnd - rangeBegin ) );
+        }
+
+        isOrderChanged = true;
+        rangeBegin = rangeEnd;
+    }
+
+    return isOrderChanged;
+}
+
+void DrawCommandSorter::dispatchTasks( void( *function )( void*, const u32 ) )
+{
+    if ( jobSystem == nullptr || taskCount == 1u ) {
+        for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+            function( &tasks[taskIdx], JobSystem::INVALID_WORKER_INDEX );
+        }
+        return;
+    }
+
+    JobCounter taskCounter;
+    for ( u32 taskIdx = 0u; taskIdx < taskCount; taskIdx++ ) {
+        Job* job = jobSystem->createJob( function, &tasks[taskIdx] );
+        jobSystem->submit( job, &taskCounter );
+    }
+
+    jobSystem->wait( &taskCounter );
+}
+
+void DrawCommandSorter::InitializeKeysJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    SortTask& task = *static_cast< SortTask* >( userData );
+    DrawCommandSorter* sorter = task.Sorter;
+
+    const DrawCmd* drawCmds = sorter->unsortedDrawCmds;
+    u64* keys = sorter->keys[0];
+    u32* indexes = sorter->indexes[0];
+
+    u64 keyAnd = ~0ull;
+    u64 keyOr = 0ull;
+    bool isSorted = true;
+    u64 previousKey = ( task.Begin == 0u ) ? 0ull : drawCmds[task.Begin - 1u].key.value;
+
+    for ( u32 i = task.Begin; i < task.End; i++ ) {
+        const u64 key = drawCmds[i].key.value;
+
+        keys[i] = key;
+        indexes[i] = i;
+
+        keyAnd &= key;
+        keyOr |= key;
+        isSorted &= ( previousKey <= key );
+
+        previousKey = key;
+    }
+
+    task.KeyAnd = keyAnd;
+    task.KeyOr = keyOr;
+    task.IsSorted = isSorted;
+}
+
+void DrawCommandSorter::BuildHistogramJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    SortTask& task = *static_cast< SortTask* >( userData );
+    DrawCommandSorter* sorter = task.Sorter;
+
+    const u64* keys = sorter->keys[sorter->sourceBufferIndex];
+    const u32 shift = sorter->digitShift;
+
+    memset( task.Histogram, 0, sizeof( u32 ) * HISTOGRAM_SIZE );
+
+    for ( u32 i = task.Begin; i < task.End; i++ ) {
+        task.Histogram[( keys[i] >> shift ) & ( HISTOGRAM_SIZE - 1u )]++;
+    }
+}
+
+void DrawCommandSorter::ScatterKeysJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    SortTask& task = *static_cast< SortTask* >( userData );
+    DrawCommandSorter* sorter = task.Sorter;
+
+    const u32 sourceIdx = sorter->sourceBufferIndex;
+    const u64* DUSK_RESTRICT keys = sorter->keys[sourceIdx];
+    const u32* DUSK_RESTRICT indexes = sorter->indexes[sourceIdx];
+    u64* DUSK_RESTRICT sortedKeys = sorter->keys[sourceIdx ^ 1u];
+    u32* DUSK_RESTRICT sortedIndexes = sorter->indexes[sourceIdx ^ 1u];
+    const u32 shift = sorter->digitShift;
+
+    for ( u32 i = task.Begin; i < task.End; i++ ) {
+        const u64 key = keys[i];
+        const u32 dest = task.Histogram[( key >> shift ) & ( HISTOGRAM_SIZE - 1u )]++;
+
+        sortedKeys[dest] = key;
+        sortedIndexes[dest] = indexes[i];
+    }
+}
+
+void DrawCommandSorter::GatherDrawCmdsJob( void* userData, const u32 workerIndex )
+{
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    SortTask& task = *static_cast< SortTask* >( userData );
+    DrawCommandSorter* sorter = task.Sorter;
+
+    const DrawCmd* drawCmds = sorter->unsortedDrawCmds;
+    const u32* indexes = sorter->indexes[sorter->sourceBufferIndex];
+    DrawCmd* sortedDrawCmds = sorter->sortedDrawCmds;
+
+    for ( u32 i = task.Begin; i < task.End; i++ ) {
+        sortedDrawCmds[i] = drawCmds[indexes[i]];
+    }
+}
@@ -0,0 +1,138 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class BaseAllocator;
+class JobSystem;
+
+#include <Maths/Matrix.h>
+#include <Graphics/DrawCommand.h>
+
+// Parallel LSD radix sort of draw commands (by 64-bit DrawCommandKey). Keys are sorted with their command index (the
+// commands themselves are only moved once, at the end of the sort). Each pass is split into tasks: every task builds
+// the histogram of its own range, then scatters its range using the offsets computed from every task histogram (which
+// keeps the sort stable). Passes whose digit is identical for every key (e.g. viewportId or layer bits) are skipped.
+// Commands of the translucent layer are then sorted back to front by their full precision depth key (secondary sort).
+class DrawCommandSorter
+{
+public:
+    // Number of bits sorted per pass.
+    static constexpr u32    RADIX_BITS = 8u;
+
+    // Number of buckets of a pass histogram.
+    static constexpr u32    HISTOGRAM_SIZE = ( 1u << RADIX_BITS );
+
+    // Maximum number of passes (64-bit keys).
+    static constexpr u32    PASS_COUNT = ( 64u / RADIX_BITS );
+
+    // Maximum number of tasks a sort can be split into.
+    static constexpr u32    MAX_TASK_COUNT = 16u;
+
+    // Minimum number of draw commands sorted by a task (a smaller sort is done by the calling thread).
+    static constexpr u32    MIN_DRAW_CMD_COUNT_PER_TASK = 2048u;
+
+    // Initial capacity of the sort storage (in draw commands).
+    static constexpr u32    DEFAULT_CAPACITY = 4096u;
+
+public:
+    // Return the number of draw commands which can be sorted without growing the sort storage.
+    DUSK_INLINE u32         getCapacity() const { return capacity; }
+
+public:
+                            DrawCommandSorter( BaseAllocator* allocator, JobSystem* jobSystem = nullptr );
+                            DrawCommandSorter( DrawCommandSorter& ) = delete;
+                            DrawCommandSorter& operator = ( DrawCommandSorter& ) = delete;
+                            ~DrawCommandSorter();
+
+    // Sort 'drawCmds' by key (ascending; stable); translucent commands sharing the same viewport are then sorted by
+    // depth key (ascending; stable). Return a pointer to the sorted commands: either 'drawCmds' (if the
+    // commands are already sorted) or the storage of this instance (valid until the next call to sort). The sort
+    // storage grows if 'drawCmdCount' exceeds the current capacity.
+    DrawCmd*                sort( DrawCmd* drawCmds, const u32 drawCmdCount );
+
+    // Serial radix sort (11-bit digits; moves the commands on each pass). 'tempDrawCmds' must be able to hold
+    // 'drawCmdCount' commands. Sorted commands are written to 'drawCmds'. Kept as a reference implementation.
+    static void             SortSerial( DrawCmd* drawCmds, DrawCmd* tempDrawCmds, const u32 drawCmdCount );
+
+private:
+    struct SortTask {
+        // Sorter owning this task.
+        DrawCommandSorter*  Sorter;
+
+        // Range of keys [Begin..End[ processed by this task.
+        u32                 Begin;
+        u32                 End;
+
+        // Bitwise AND/OR of the keys of the range (used to detect constant digits).
+        u64                 KeyAnd;
+        u64                 KeyOr;
+
+        // True if the keys of the range are sorted (including the key preceding the range).
+        bool                IsSorted;
+
+        // Per-digit count for the current pass (then the scatter offset of each digit for this task).
+        u32                 Histogram[HISTOGRAM_SIZE];
+    };
+
+private:
+    // The memory allocator owning this instance.
+    BaseAllocator*          memoryAllocator;
+
+    // JobSystem used to dispatch the tasks (optional).
+    JobSystem*              jobSystem;
+
+    // Keys (ping-pong buffers).
+    u64*                    keys[2];
+
+    // Command index of each key (ping-pong buffers).
+    u32*                    indexes[2];
+
+    // Sorted commands.
+    DrawCmd*                sortedDrawCmds;
+
+    // Number of draw commands the storage can hold.
+    u32                     capacity;
+
+    // Tasks of the current sort.
+    SortTask                tasks[MAX_TASK_COUNT];
+
+    // Number of tasks of the current sort.
+    u32                     taskCount;
+
+    // Commands of the current sort.
+    const DrawCmd*          unsortedDrawCmds;
+
+    // Index of the ping-pong buffer read by the current pass.
+    u32                     sourceBufferIndex;
+
+    // Shift of the digit sorted by the current pass.
+    u32                     digitShift;
+
+private:
+    // Grow the sort storage to hold at least 'drawCmdCount' commands.
+    void                    reserve( const u32 drawCmdCount );
+
+    // Release the sort storage.
+    void                    releaseStorage();
+
+    // Sort each range of translucent commands (sharing the same viewport) by depth key. Return true if the order of at
+    // least one range has changed.
+    bool                    sortTranslucentRanges( const u32 drawCmdCount );
+
+    // Execute 'function' for every task of the current sort and wait for completion.
+    void                    dispatchTasks( void( *function )( void*, const u32 ) );
+
+    // Copy keys and command indexes; compute AND/OR of the keys and check if the range is already sorted.
+    static void             InitializeKeysJob( void* userData, const u32 workerIndex );
+
+    // Build the histogram of the current digit for a task range.
+    static void             BuildHistogramJob( void* userData, const u32 workerIndex );
+
+    // Scatter the keys of a task range according to the current digit.
+    static void             ScatterKeysJob( void* userData, const u32 workerIndex );
+
+    // Copy the commands of a task range to their sorted location.
+    static void             GatherDrawCmdsJob( void* userData, const u32 workerIndex );
+};
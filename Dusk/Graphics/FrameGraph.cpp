@@ -7,9 +7,12 @@
 
 #include "WorldRenderer.h"
 #include "PipelineStateCache.h"
+#include "GpuProfiler.h"
 
 #include <Rendering/RenderDevice.h>
 #include <Maths/MatrixTransformations.h>
+#include <Core/Hashing/MurmurHash3.h>
+#include <Core/Timer.h>
 
 #include <Graphics/RenderModules/Generated/BuiltIn.generated.h>
 
@@ -21,13 +24,184 @@ static constexpr dkStringHash_t SSR_LAST_FRAME_IMAGE_RESOURCE_HASHCODE = DUSK_ST
 static constexpr dkStringHash_t MATERIALED_BUFFER_RESOURCE_HASHCODE = DUSK_STRING_HASH( "__MaterialEditorBuffer__" );
 static constexpr dkStringHash_t VECTORDATA_BUFFER_RESOURCE_HASHCODE = DUSK_STRING_HASH( "__VectorDataBuffer__" );
 
+DUSK_DEV_VAR( EnableTransientAliasing, "Share transient resources with non-overlapping lifetimes within a frame", true, bool );
+DUSK_DEV_VAR( EnableCompiledGraphCaching, "Reuse the previous frame allocation plan if the FrameGraph structure is unchanged", true, bool );
+DUSK_DEV_VAR( EnableSplitBarriers, "Begin the transitions of a resource right after its previous use (if the RenderDevice supports split barriers)", true, bool );
+DUSK_DEV_VAR( EnableCriticalPathScheduling, "Record the RenderPasses with the longest chain of dependent RenderPasses first (instead of the declaration order)", true, bool );
+DUSK_DEV_VAR( EnableAsyncCompute, "Execute async compute renderpasses on a dedicated queue (if the RenderDevice exposes one)", true, bool );
+DUSK_DEV_VAR( TransientResourceEvictionDelay, "Number of frames a pooled transient resource can stay unused before being destroyed", 120, u32 );
+
+// Size of a chunk of the FrameGraph per-frame arena.
+static constexpr size_t PASS_ALLOCATOR_CHUNK_SIZE = 256 << 10;
+
+// Initial capacity of the per-pass resource handle lists.
+static constexpr u32 PASS_RESOURCE_LIST_CAPACITY = 8u;
+
+// Initial capacity of the per-pass dependency lists.
+static constexpr u32 PASS_DEPENDENCY_LIST_CAPACITY = 4u;
+
+// Initial capacity of the per-pass barrier lists.
+static constexpr u32 PASS_BARRIER_LIST_CAPACITY = 4u;
+
 static constexpr size_t MAX_VECTOR_PER_INSTANCE = 1024;
-static constexpr size_t VECTOR_BUFFER_SIZE = MAX_VECTOR_PER_INSTANCE * sizeof( dkVec4f );
+static constexpr size_t VECTOR_BUFFER_SIZE = FrameGraph::MAX_INSTANCE_COUNT * sizeof( DrawCommandInfos::InstanceData );
 
 const FGHandle FGHandle::Invalid = FGHandle( ~0 );
 
-FrameGraphBuilder::FrameGraphBuilder()
-    : frameSamplerCount( 1 )
+// Hash the fields which must match for a pooled buffer to be reused (the size is excluded: a larger buffer can hold a
+// smaller one, see GetReuseCost).
+static u32 HashReuseCompatibility( const BufferDesc& description )
+{
+    const u32 keys[4] = {
+        description.StrideInBytes,
+        description.BindFlags,
+        static_cast< u32 >( description.Usage ),
+        static_cast< u32 >( description.DefaultView.ViewFormat )
+    };
+
+    u32 hashcode = 0u;
+    MurmurHash3_x86_32( keys, sizeof( keys ), 0u, &hashcode );
+    return hashcode;
+}
+
+// Return the memory wasted by reusing a pooled buffer for a given description (or -1 if the pooled buffer is too small
+// or has a different default view).
+static i64 GetReuseCost( const BufferDesc& pooledDescription, const BufferDesc& description )
+{
+    if ( pooledDescription.StrideInBytes != description.StrideInBytes
+      || pooledDescription.BindFlags != description.BindFlags
+      || pooledDescription.Usage != description.Usage
+      || pooledDescription.DefaultView.SortKey[0] != description.DefaultView.SortKey[0]
+      || pooledDescription.DefaultView.SortKey[1] != description.DefaultView.SortKey[1]
+      || pooledDescription.SizeInBytes < description.SizeInBytes ) {
+        return -1;
+    }
+
+    return static_cast< i64 >( pooledDescription.SizeInBytes - description.SizeInBytes );
+}
+
+// Hash the fields compared by the description equality operator (so that equal descriptions always share the same hashcode).
+// 'flags' are the FrameGraphBuilder::eImageFlags requested for the image (an image with per-mip views can't be
+// exchanged with an image without them).
+static u32 HashDescription( const ImageDesc& description, const u32 flags )
+{
+    const u32 keys[11] = {
+        static_cast< u32 >( description.format ),
+        description.width,
+        description.height,
+        description.depth,
+        description.arraySize,
+        description.mipCount,
+        description.samplerCount,
+        description.bindFlags,
+        description.miscFlags,
+        static_cast< u32 >( description.usage ),
+        flags
+    };
+
+    u32 hashcode = 0u;
+    MurmurHash3_x86_32( keys, sizeof( keys ), 0u, &hashcode );
+    return hashcode;
+}
+
+// Images can't be placed in the memory of another image; a pooled image is only reused for an equal description.
+static i64 GetReuseCost( const ImageDesc& pooledDescription, const ImageDesc& description )
+{
+    return ( pooledDescription == description ) ? 0 : -1;
+}
+
+static u32 HashDescription( const SamplerDesc& description )
+{
+    const u32 keys[7] = {
+        static_cast< u32 >( description.filter ),
+        static_cast< u32 >( description.addressU ),
+        static_cast< u32 >( description.addressV ),
+        static_cast< u32 >( description.addressW ),
+        static_cast< u32 >( description.comparisonFunction ),
+        static_cast< u32 >( description.minLOD ),
+        static_cast< u32 >( description.maxLOD )
+    };
+
+    u32 hashcode = 0u;
+    MurmurHash3_x86_32( keys, sizeof( keys ), 0u, &hashcode );
+    return hashcode;
+}
+
+static i64 GetReuseCost( const SamplerDesc& pooledDescription, const SamplerDesc& description )
+{
+    return ( pooledDescription == description ) ? 0 : -1;
+}
+
+static void AppendKeys( std::vector<u32>& key, const std::initializer_list<u32> values )
+{
+    key.insert( key.end(), values.begin(), values.end() );
+}
+
+// Append a 64 bits value to a structural key (as two 32 bits words).
+static void AppendKey64( std::vector<u32>& key, const u64 value )
+{
+    AppendKeys( key, { static_cast< u32 >( value & 0xffffffff ), static_cast< u32 >( value >> 32 ) } );
+}
+
+// Append the bit pattern of a float to a structural key (values must not be rounded).
+static u32 AsKey( const f32 value )
+{
+    u32 bits = 0u;
+    memcpy( &bits, &value, sizeof( u32 ) );
+    return bits;
+}
+
+static void AppendDescriptionKeys( std::vector<u32>& key, const ImageDesc& description )
+{
+    AppendKeys( key, {
+        static_cast< u32 >( description.dimension ),
+        static_cast< u32 >( description.format ),
+        description.width,
+        description.height,
+        description.depth,
+        description.arraySize,
+        description.mipCount,
+        description.samplerCount,
+        description.bindFlags,
+        description.miscFlags,
+        static_cast< u32 >( description.usage )
+    } );
+    AppendKey64( key, description.DefaultView.SortKey );
+}
+
+static void AppendDescriptionKeys( std::vector<u32>& key, const BufferDesc& description )
+{
+    AppendKeys( key, {
+        description.SizeInBytes,
+        description.StrideInBytes,
+        description.BindFlags,
+        static_cast< u32 >( description.Usage ),
+        description.DefaultView.FirstElement,
+        description.DefaultView.NumElements,
+        static_cast< u32 >( description.DefaultView.ViewFormat )
+    } );
+}
+
+static void AppendDescriptionKeys( std::vector<u32>& key, const SamplerDesc& description )
+{
+    AppendKeys( key, {
+        static_cast< u32 >( description.filter ),
+        static_cast< u32 >( description.addressU ),
+        static_cast< u32 >( description.addressV ),
+        static_cast< u32 >( description.addressW ),
+        static_cast< u32 >( description.comparisonFunction ),
+        static_cast< u32 >( description.minLOD ),
+        static_cast< u32 >( description.maxLOD ),
+        AsKey( description.borderColor[0] ),
+        AsKey( description.borderColor[1] ),
+        AsKey( description.borderColor[2] ),
+        AsKey( description.borderColor[3] )
+    } );
+}
+
+FrameGraphBuilder::FrameGraphBuilder( BaseAllocator* passAllocator )
+    : passAllocator( passAllocator )
+    , frameSamplerCount( 1 )
     , frameImageQuality( 1.0f )
     , frameScreenSize( dkVec2u::Zero )
     , renderPassCount( 0 )
@@ -36,9 +210,11 @@ FrameGraphBuilder::FrameGraphBuilder()
     , persitentBufferCount( 0 )
     , persitentImageCount( 0 )
     , samplerStateCount( 0 )
+    , compiledGraphHashcode( 0u )
+    , hasCompiledGraph( false )
+    , isLastCompilationCached( false )
 {
     memset( &frameViewport, 0, sizeof( Viewport ) );
-    memset( passRefs, 0, sizeof( PassInfos ) * MAX_RENDER_PASS_COUNT );
     memset( images, 0, sizeof( ImageAllocInfo ) * MAX_RESOURCES_HANDLE_PER_FRAME );
     memset( buffers, 0, sizeof( BufferAllocInfo ) * MAX_RESOURCES_HANDLE_PER_FRAME );
     memset( samplers, 0, sizeof( SamplerDesc ) * MAX_RESOURCES_HANDLE_PER_FRAME );
@@ -53,27 +229,64 @@ FrameGraphBuilder::~FrameGraphBuilder()
 
 void FrameGraphBuilder::compile( RenderDevice* renderDevice, FrameGraphResources& resources )
 {
-    resources.unacquireResources();
+    // In steady state the graph structure is identical from frame to frame; the transient resources acquired for the
+    // previous frame can then be kept as is.
+    const bool useAsyncComputeQueue = ( EnableAsyncCompute && renderDevice->hasAsyncComputeQueue() );
+    buildStructuralKey( useAsyncComputeQueue, structuralKey );
+
+    u32 graphHashcode = 0u;
+    MurmurHash3_x86_32( structuralKey.data(), static_cast< i32 >( sizeof( u32 ) * structuralKey.size() ), 0u, &graphHashcode );
+
+    // The hashcode is only used as an early out; the keys are compared to make sure the structure is actually unchanged.
+    isLastCompilationCached = ( EnableCompiledGraphCaching
+                             && hasCompiledGraph
+                             && graphHashcode == compiledGraphHashcode
+                             && structuralKey == compiledStructuralKey );
+
+    if ( isLastCompilationCached ) {
+        resources.reuseAcquiredResources( renderDevice );
+    } else {
+        resources.unacquireResources( renderDevice );
+
+        for ( u32 i = 0; i < imageCount; i++ ) {
+            ImageAllocInfo& resToAlloc = images[i];
+          /*  if ( resToAlloc.referenceCount == 0 ) {
+                continue;
+            }*/
+
+            // Resources are requested in pass order; the resource pool can therefore alias any resource whose last use
+            // happens before the first use of the resource being allocated.
+            // Passes on different queues only synchronize on their dependencies (pass order does not imply execution
+            // order); resources accessed from the async compute queue are thus given a frame long lifetime.
+            const bool isFrameLongLifetime = ( useAsyncComputeQueue && resToAlloc.isUsedByAsyncCompute );
+            const u32 firstUsePass = ( isFrameLongLifetime ) ? 0u : resToAlloc.firstUsePass;
+            const u32 lastUsePass = ( isFrameLongLifetime ) ? static_cast< u32 >( renderPassCount ) : resToAlloc.lastUsePass;
+
+            resources.allocateImage( renderDevice, i, resToAlloc.description, resToAlloc.flags, firstUsePass, lastUsePass );
+        }
 
-    for ( u32 i = 0; i < imageCount; i++ ) {
-        ImageAllocInfo& resToAlloc = images[i];
-      /*  if ( resToAlloc.referenceCount == 0 ) {
-            continue;
-        }*/
+        for ( u32 i = 0; i < bufferCount; i++ ) {
+            BufferAllocInfo& resToAlloc = buffers[i];
 
-        resources.allocateImage( renderDevice, i, resToAlloc.description, resToAlloc.flags );
-    }
+            const bool isFrameLongLifetime = ( useAsyncComputeQueue && resToAlloc.isUsedByAsyncCompute );
+            const u32 firstUsePass = ( isFrameLongLifetime ) ? 0u : resToAlloc.firstUsePass;
+            const u32 lastUsePass = ( isFrameLongLifetime ) ? static_cast< u32 >( renderPassCount ) : resToAlloc.lastUsePass;
 
-    for ( u32 i = 0; i < bufferCount; i++ ) {
-        BufferAllocInfo& resToAlloc = buffers[i];
-        resources.allocateBuffer( renderDevice, i, resToAlloc.description );
-    }
+            resources.allocateBuffer( renderDevice, i, resToAlloc.description, firstUsePass, lastUsePass );
+        }
 
-    for ( u32 i = 0; i < samplerStateCount; i++ ) {
-        SamplerDesc& resToAlloc = samplers[i];
-        resources.allocateSampler( renderDevice, i, resToAlloc );
+        for ( u32 i = 0; i < samplerStateCount; i++ ) {
+            SamplerDesc& resToAlloc = samplers[i];
+            resources.allocateSampler( renderDevice, i, resToAlloc );
+        }
+
+        compiledGraphHashcode = graphHashcode;
+        compiledStructuralKey.swap( structuralKey );
+        hasCompiledGraph = true;
     }
 
+    // Persistent resources are imported every frame (e.g. the swapchain buffer); they must be bound even if the
+    // allocation plan is reused.
     for ( u32 i = 0; i < persitentBufferCount; i++ ) {
         resources.bindPersistentBuffers( i, persitentBuffers[i] );
     }
@@ -82,6 +295,9 @@ void FrameGraphBuilder::compile( RenderDevice* renderDevice, FrameGraphResources
         resources.bindPersistentImages( i, persitentImages[i] );
     }
 
+    // Transitions are resolved every frame (the barriers reference the resources acquired for this frame).
+    resolveResourceBarriers( resources, useAsyncComputeQueue );
+
     renderPassCount = 0;
     imageCount = 0;
     bufferCount = 0;
@@ -90,6 +306,191 @@ void FrameGraphBuilder::compile( RenderDevice* renderDevice, FrameGraphResources
     persitentImageCount = 0;
 }
 
+void FrameGraphBuilder::invalidateCompiledGraph()
+{
+    hasCompiledGraph = false;
+}
+
+void FrameGraphBuilder::releasePassStorage()
+{
+    passRefs.reset();
+}
+
+void FrameGraphBuilder::buildStructuralKey( const bool useAsyncComputeQueue, std::vector<u32>& key ) const
+{
+    key.clear();
+
+    // Aliasing changes the allocation plan; toggling it (or the async compute queue usage) must trigger a rebuild.
+    AppendKeys( key, {
+        static_cast< u32 >( EnableTransientAliasing ),
+        static_cast< u32 >( useAsyncComputeQueue ),
+        static_cast< u32 >( renderPassCount ),
+        imageCount,
+        bufferCount,
+        samplerStateCount,
+        persitentBufferCount,
+        persitentImageCount
+    } );
+
+    for ( i32 i = 0; i < renderPassCount; i++ ) {
+        const PassInfos& passInfos = passRefs[i];
+
+        AppendKeys( key, {
+            passInfos.imageCount,
+            passInfos.buffersCount,
+            passInfos.dependencyCount,
+            passInfos.resourceAccessCount,
+            static_cast< u32 >( passInfos.isUncullable ),
+            static_cast< u32 >( passInfos.useAsyncCompute )
+        } );
+
+        key.insert( key.end(), passInfos.imageHandles.data(), passInfos.imageHandles.data() + passInfos.imageCount );
+        key.insert( key.end(), passInfos.bufferHandles.data(), passInfos.bufferHandles.data() + passInfos.buffersCount );
+        key.insert( key.end(), passInfos.dependencies.data(), passInfos.dependencies.data() + passInfos.dependencyCount );
+
+        for ( u32 j = 0; j < passInfos.resourceAccessCount; j++ ) {
+            const ResourceAccess& access = passInfos.resourceAccesses[j];
+
+            AppendKeys( key, {
+                access.handle,
+                static_cast< u32 >( access.requiredState ),
+                static_cast< u32 >( access.isBuffer ),
+                static_cast< u32 >( access.isReadOnly ),
+                static_cast< u32 >( access.isPersistent )
+            } );
+        }
+    }
+
+    for ( u32 i = 0; i < imageCount; i++ ) {
+        const ImageAllocInfo& image = images[i];
+
+        AppendKeys( key, {
+            image.flags,
+            image.referenceCount,
+            image.firstUsePass,
+            image.lastUsePass,
+            static_cast< u32 >( image.isUsedByAsyncCompute )
+        } );
+        AppendDescriptionKeys( key, image.description );
+    }
+
+    for ( u32 i = 0; i < bufferCount; i++ ) {
+        const BufferAllocInfo& buffer = buffers[i];
+
+        AppendKeys( key, {
+            buffer.shaderStageBinding,
+            buffer.referenceCount,
+            buffer.firstUsePass,
+            buffer.lastUsePass,
+            static_cast< u32 >( buffer.isUsedByAsyncCompute )
+        } );
+        AppendDescriptionKeys( key, buffer.description );
+    }
+
+    for ( u32 i = 0; i < samplerStateCount; i++ ) {
+        AppendDescriptionKeys( key, samplers[i] );
+    }
+
+    key.insert( key.end(), persitentBuffers, persitentBuffers + persitentBufferCount );
+    key.insert( key.end(), persitentImages, persitentImages + persitentImageCount );
+}
+
+void FrameGraphBuilder::resolveResourceBarriers( const FrameGraphResources& resources, const bool useAsyncComputeQueue )
+{
+    // State of a resource at the end of the last renderpass using it.
+    struct ResourceStateTracker {
+        eResourceState  state;
+        i32             lastAccessPass;
+    };
+
+    ResourceStateTracker imageTrackers[MAX_RESOURCES_HANDLE_PER_FRAME];
+    ResourceStateTracker bufferTrackers[MAX_RESOURCES_HANDLE_PER_FRAME];
+    ResourceStateTracker persistentImageTrackers[MAX_RESOURCES_HANDLE_PER_FRAME];
+
+    for ( i32 i = 0; i < MAX_RESOURCES_HANDLE_PER_FRAME; i++ ) {
+        imageTrackers[i] = { RESOURCE_STATE_UNKNOWN, -1 };
+        bufferTrackers[i] = { RESOURCE_STATE_UNKNOWN, -1 };
+        persistentImageTrackers[i] = { RESOURCE_STATE_UNKNOWN, -1 };
+    }
+
+    u32 splitBarrierCount = 0u;
+
+    auto isOnComputeQueue = [&]( const i32 passIndex ) {
+        return useAsyncComputeQueue && passRefs[passIndex].useAsyncCompute;
+    };
+
+    // A split barrier is only worth it if a renderpass executed on the same queue can overlap with the transition.
+    auto canSplitTransition = [&]( const i32 previousAccessPass, const i32 passIndex ) {
+        const bool isPassOnComputeQueue = isOnComputeQueue( passIndex );
+        if ( previousAccessPass < 0 || isOnComputeQueue( previousAccessPass ) != isPassOnComputeQueue ) {
+            return false;
+        }
+
+        for ( i32 i = previousAccessPass + 1; i < passIndex; i++ ) {
+            if ( isOnComputeQueue( i ) == isPassOnComputeQueue ) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    for ( i32 passIdx = 0; passIdx < renderPassCount; passIdx++ ) {
+        PassInfos& passInfos = passRefs[passIdx];
+
+        for ( u32 i = 0; i < passInfos.resourceAccessCount; i++ ) {
+            const ResourceAccess& access = passInfos.resourceAccesses[i];
+            ResourceStateTracker& tracker = ( access.isPersistent ) ? persistentImageTrackers[access.handle]
+                                          : ( access.isBuffer ) ? bufferTrackers[access.handle] : imageTrackers[access.handle];
+
+            const i32 previousAccessPass = tracker.lastAccessPass;
+            tracker.lastAccessPass = passIdx;
+
+            if ( access.requiredState == RESOURCE_STATE_UNKNOWN ) {
+                // The renderpass manages the state itself; the state is unknown from now on (unless the renderpass
+                // only reads the resource).
+                if ( !access.isReadOnly ) {
+                    tracker.state = RESOURCE_STATE_UNKNOWN;
+                }
+                continue;
+            }
+
+            // UAV writes must complete before the next access (even if the state is unchanged).
+            const bool isUAVBarrier = ( tracker.state == RESOURCE_STATE_UAV && access.requiredState == RESOURCE_STATE_UAV );
+            if ( tracker.state == access.requiredState && !isUAVBarrier ) {
+                continue;
+            }
+
+            ResourceBarrier barrier;
+            barrier.ImageResource = ( access.isPersistent ) ? resources.getPersitentImage( access.handle )
+                                  : ( access.isBuffer ) ? nullptr : resources.getImage( access.handle );
+            barrier.BufferResource = ( access.isBuffer ) ? resources.getBuffer( access.handle ) : nullptr;
+            barrier.StateBefore = tracker.state;
+            barrier.StateAfter = access.requiredState;
+            barrier.Type = BARRIER_TYPE_FULL;
+            barrier.SplitBarrierIndex = 0u;
+
+            if ( EnableSplitBarriers
+              && !isUAVBarrier
+              && tracker.state != RESOURCE_STATE_UNKNOWN
+              && splitBarrierCount < MAX_SPLIT_BARRIER_COUNT
+              && canSplitTransition( previousAccessPass, passIdx ) ) {
+                PassInfos& previousPassInfos = passRefs[previousAccessPass];
+
+                barrier.Type = BARRIER_TYPE_SPLIT_BEGIN;
+                barrier.SplitBarrierIndex = splitBarrierCount++;
+                previousPassInfos.postBarriers.pushBack( passAllocator, previousPassInfos.postBarrierCount, barrier );
+
+                barrier.Type = BARRIER_TYPE_SPLIT_END;
+            }
+
+            passInfos.preBarriers.pushBack( passAllocator, passInfos.preBarrierCount, barrier );
+
+            tracker.state = access.requiredState;
+        }
+    }
+}
+
 void FrameGraphBuilder::cullRenderPasses( FrameGraphRenderPass* renderPassList, i32& renderPassCount )
 {
     i32 tmpRenderPassCount = 0;
@@ -128,26 +529,42 @@ void FrameGraphBuilder::cullRenderPasses( FrameGraphRenderPass* renderPassList,
 void FrameGraphBuilder::scheduleRenderPasses( FrameGraphScheduler& graphScheduler, FrameGraphRenderPass* renderPassList, const i32 renderPassCount )
 {
     for ( i32 i = 0; i < renderPassCount; i++ ) {
-        const FrameGraphRenderPass& renderPass = renderPassList[i];
+        FrameGraphRenderPass& renderPass = renderPassList[i];
         const PassInfos& passInfo = passRefs[renderPass.Handle];
 
+        renderPass.PreBarriers = passInfo.preBarriers.data();
+        renderPass.PreBarrierCount = passInfo.preBarrierCount;
+        renderPass.PostBarriers = passInfo.postBarriers.data();
+        renderPass.PostBarrierCount = passInfo.postBarrierCount;
+
         if ( passInfo.useAsyncCompute ) {
-            graphScheduler.addAsyncComputeRenderPass( renderPass, passInfo.dependencies, passInfo.dependencyCount );
+            // Uncullable passes usually write resources owned by a RenderModule (which are not tracked by the graph).
+            graphScheduler.addAsyncComputeRenderPass( renderPass, passInfo.dependencies.data(), passInfo.dependencyCount, passInfo.isUncullable );
         } else {
-            graphScheduler.addRenderPass( renderPass, passInfo.dependencies, passInfo.dependencyCount );
+            graphScheduler.addRenderPass( renderPass, passInfo.dependencies.data(), passInfo.dependencyCount );
         }
     }
 }
 
 void FrameGraphBuilder::addRenderPass()
 {
-    passRefs[renderPassCount].imageCount = 0;
-    passRefs[renderPassCount].buffersCount = 0;
-    passRefs[renderPassCount].isUncullable = false;
-    passRefs[renderPassCount].useAsyncCompute = false;
-    passRefs[renderPassCount].dependencyCount = 0;
-    
-    memset( passRefs[renderPassCount].dependencies, 0xff, sizeof( FrameGraphRenderPass::Handle_t ) * 12 );
+    passRefs.reserve( passAllocator, renderPassCount + 1, renderPassCount );
+
+    PassInfos& passInfos = passRefs[renderPassCount];
+    passInfos.imageHandles = FGArenaArray<u32>( PASS_RESOURCE_LIST_CAPACITY );
+    passInfos.imageCount = 0;
+    passInfos.bufferHandles = FGArenaArray<u32>( PASS_RESOURCE_LIST_CAPACITY );
+    passInfos.buffersCount = 0;
+    passInfos.isUncullable = false;
+    passInfos.useAsyncCompute = false;
+    passInfos.dependencies = FGArenaArray<FrameGraphRenderPass::Handle_t>( PASS_DEPENDENCY_LIST_CAPACITY );
+    passInfos.dependencyCount = 0;
+    passInfos.resourceAccesses = FGArenaArray<ResourceAccess>( PASS_RESOURCE_LIST_CAPACITY );
+    passInfos.resourceAccessCount = 0;
+    passInfos.preBarriers = FGArenaArray<ResourceBarrier>( PASS_BARRIER_LIST_CAPACITY );
+    passInfos.preBarrierCount = 0;
+    passInfos.postBarriers = FGArenaArray<ResourceBarrier>( PASS_BARRIER_LIST_CAPACITY );
+    passInfos.postBarrierCount = 0;
 
     renderPassCount++;
 }
@@ -186,9 +603,14 @@ FGHandle FrameGraphBuilder::allocateImage( ImageDesc& description, const u32 ima
     images[imageCount].flags = imageFlags;
     images[imageCount].referenceCount = 0u;
     images[imageCount].requestSource = requesterHandle;
+    images[imageCount].firstUsePass = requesterHandle;
+    images[imageCount].lastUsePass = requesterHandle;
 
     PassInfos& passInfos = passRefs[requesterHandle];
-    passInfos.imageHandles[passInfos.imageCount++] = imageCount;
+    images[imageCount].isUsedByAsyncCompute = passInfos.useAsyncCompute;
+    passInfos.imageHandles.pushBack( passAllocator, passInfos.imageCount, imageCount );
+
+    recordResourceAccess( imageCount, false, false, RESOURCE_STATE_UNKNOWN );
 
     return imageCount++;
 }
@@ -199,6 +621,11 @@ FGHandle FrameGraphBuilder::copyImage( const FGHandle resourceToCopy, ImageDesc*
     images[imageCount].flags = 0u;
     images[imageCount].referenceCount = 0u;
     images[imageCount].requestSource = ( renderPassCount - 1 );
+    images[imageCount].firstUsePass = ( renderPassCount - 1 );
+    images[imageCount].lastUsePass = ( renderPassCount - 1 );
+
+    // Reading the source image extends its lifetime to this pass.
+    images[resourceToCopy].lastUsePass = ( renderPassCount - 1 );
 
     ApplyImageDescriptionFlags( images[imageCount].description, imageFlags );
 
@@ -207,7 +634,12 @@ FGHandle FrameGraphBuilder::copyImage( const FGHandle resourceToCopy, ImageDesc*
     }
 
     PassInfos& passInfos = passRefs[( renderPassCount - 1 )];
-    passInfos.imageHandles[passInfos.imageCount++] = imageCount;
+    images[imageCount].isUsedByAsyncCompute = passInfos.useAsyncCompute;
+    images[resourceToCopy].isUsedByAsyncCompute |= passInfos.useAsyncCompute;
+    passInfos.imageHandles.pushBack( passAllocator, passInfos.imageCount, imageCount );
+
+    recordResourceAccess( resourceToCopy, false, true, RESOURCE_STATE_UNKNOWN );
+    recordResourceAccess( imageCount, false, false, RESOURCE_STATE_UNKNOWN );
 
     return imageCount++;
 }
@@ -249,10 +681,15 @@ FGHandle FrameGraphBuilder::allocateBuffer( BufferDesc& description, const u32 s
     buffers[bufferCount].shaderStageBinding = shaderStageBinding;
     buffers[bufferCount].referenceCount = 0u;
     buffers[bufferCount].requestSource = requesterHandle;
+    buffers[bufferCount].firstUsePass = requesterHandle;
+    buffers[bufferCount].lastUsePass = requesterHandle;
     buffers[bufferCount].description = description;
 
     PassInfos& passInfos = passRefs[requesterHandle];
-    passInfos.bufferHandles[passInfos.buffersCount++] = bufferCount;
+    buffers[bufferCount].isUsedByAsyncCompute = passInfos.useAsyncCompute;
+    passInfos.bufferHandles.pushBack( passAllocator, passInfos.buffersCount, bufferCount );
+
+    recordResourceAccess( bufferCount, true, false, RESOURCE_STATE_UNKNOWN );
 
     return bufferCount++;
 }
@@ -265,13 +702,39 @@ FGHandle FrameGraphBuilder::allocateSampler( const SamplerDesc& description )
 
 FGHandle FrameGraphBuilder::readReadOnlyImage( const FGHandle resourceHandle )
 {
-    images[resourceHandle].referenceCount++;
+    const FrameGraphRenderPass::Handle_t passHandle = ( renderPassCount - 1 );
+
+    ImageAllocInfo& imageResource = images[resourceHandle];
+    imageResource.referenceCount++;
+    imageResource.lastUsePass = passHandle;
+    imageResource.isUsedByAsyncCompute |= passRefs[passHandle].useAsyncCompute;
+
+    // Read-only accesses don't serialize the readers, but the last writer must have completed (the writer might run on
+    // another queue).
+    if ( imageResource.requestSource < passHandle ) {
+        updatePassDependency( passRefs[passHandle], imageResource.requestSource );
+    }
+
+    recordResourceAccess( resourceHandle, false, true, RESOURCE_STATE_UNKNOWN );
+
     return resourceHandle;
 }
 
 FGHandle FrameGraphBuilder::readReadOnlyBuffer( const FGHandle resourceHandle )
 {
-    buffers[resourceHandle].referenceCount++;
+    const FrameGraphRenderPass::Handle_t passHandle = ( renderPassCount - 1 );
+
+    BufferAllocInfo& bufferResource = buffers[resourceHandle];
+    bufferResource.referenceCount++;
+    bufferResource.lastUsePass = passHandle;
+    bufferResource.isUsedByAsyncCompute |= passRefs[passHandle].useAsyncCompute;
+
+    if ( bufferResource.requestSource < passHandle ) {
+        updatePassDependency( passRefs[passHandle], bufferResource.requestSource );
+    }
+
+    recordResourceAccess( resourceHandle, true, true, RESOURCE_STATE_UNKNOWN );
+
     return resourceHandle;
 }
 
@@ -284,8 +747,7 @@ void FrameGraphBuilder::updatePassDependency( PassInfos& passInfos, const FrameG
     }
 
     // If the dependency does not exist yet, add it
-    passInfos.dependencies[passInfos.dependencyCount] = dependency;
-    passInfos.dependencyCount++;
+    passInfos.dependencies.pushBack( passAllocator, passInfos.dependencyCount, dependency );
 }
 
 FGHandle FrameGraphBuilder::readImage( const FGHandle resourceHandle )
@@ -296,6 +758,10 @@ FGHandle FrameGraphBuilder::readImage( const FGHandle resourceHandle )
 
     updatePassDependency( passRefs[( renderPassCount - 1 )], imageResource.requestSource );
     imageResource.requestSource = ( renderPassCount - 1 );
+    imageResource.lastUsePass = ( renderPassCount - 1 );
+    imageResource.isUsedByAsyncCompute |= passRefs[( renderPassCount - 1 )].useAsyncCompute;
+
+    recordResourceAccess( resourceHandle, false, false, RESOURCE_STATE_UNKNOWN );
 
     return resourceHandle;
 }
@@ -308,10 +774,76 @@ FGHandle FrameGraphBuilder::readBuffer( const FGHandle resourceHandle )
 
     updatePassDependency( passRefs[( renderPassCount - 1 )], bufferResource.requestSource );
     bufferResource.requestSource = ( renderPassCount - 1 );
+    bufferResource.lastUsePass = ( renderPassCount - 1 );
+    bufferResource.isUsedByAsyncCompute |= passRefs[( renderPassCount - 1 )].useAsyncCompute;
+
+    recordResourceAccess( resourceHandle, true, false, RESOURCE_STATE_UNKNOWN );
 
     return resourceHandle;
 }
 
+void FrameGraphBuilder::requireImageState( const FGHandle resourceHandle, const eResourceState state )
+{
+    DUSK_DEV_ASSERT( resourceHandle < imageCount, "Only transient images can be transitioned by the FrameGraph!" );
+
+    const FrameGraphRenderPass::Handle_t passHandle = ( renderPassCount - 1 );
+
+    ImageAllocInfo& imageResource = images[resourceHandle];
+    imageResource.lastUsePass = passHandle;
+    imageResource.isUsedByAsyncCompute |= passRefs[passHandle].useAsyncCompute;
+
+    // The transition must happen once the last writer has completed.
+    if ( imageResource.requestSource < passHandle ) {
+        updatePassDependency( passRefs[passHandle], imageResource.requestSource );
+    }
+
+    recordResourceAccess( resourceHandle, false, true, state );
+}
+
+void FrameGraphBuilder::requireBufferState( const FGHandle resourceHandle, const eResourceState state )
+{
+    DUSK_DEV_ASSERT( resourceHandle < bufferCount, "Only transient buffers can be transitioned by the FrameGraph!" );
+
+    const FrameGraphRenderPass::Handle_t passHandle = ( renderPassCount - 1 );
+
+    BufferAllocInfo& bufferResource = buffers[resourceHandle];
+    bufferResource.lastUsePass = passHandle;
+    bufferResource.isUsedByAsyncCompute |= passRefs[passHandle].useAsyncCompute;
+
+    if ( bufferResource.requestSource < passHandle ) {
+        updatePassDependency( passRefs[passHandle], bufferResource.requestSource );
+    }
+
+    recordResourceAccess( resourceHandle, true, true, state );
+}
+
+void FrameGraphBuilder::requirePersistentImageState( const FGHandle resourceHandle, const eResourceState state )
+{
+    DUSK_DEV_ASSERT( resourceHandle < persitentImageCount, "Unknown persistent image handle!" );
+
+    recordResourceAccess( resourceHandle, false, true, state, true );
+}
+
+void FrameGraphBuilder::recordResourceAccess( const u32 resourceHandle, const bool isBuffer, const bool isReadOnly, const eResourceState requiredState, const bool isPersistent )
+{
+    PassInfos& passInfos = passRefs[( renderPassCount - 1 )];
+
+    for ( u32 i = 0; i < passInfos.resourceAccessCount; i++ ) {
+        ResourceAccess& access = passInfos.resourceAccesses[i];
+
+        if ( access.handle == resourceHandle && access.isBuffer == isBuffer && access.isPersistent == isPersistent ) {
+            access.isReadOnly &= isReadOnly;
+
+            if ( requiredState != RESOURCE_STATE_UNKNOWN ) {
+                access.requiredState = requiredState;
+            }
+            return;
+        }
+    }
+
+    passInfos.resourceAccesses.pushBack( passAllocator, passInfos.resourceAccessCount, ResourceAccess{ resourceHandle, requiredState, isBuffer, isReadOnly, isPersistent } );
+}
+
 FGHandle FrameGraphBuilder::retrieveSwapchainBuffer()
 {
     persitentImages[persitentImageCount] = SWAPCHAIN_BUFFER_RESOURCE_HASHCODE;
@@ -380,27 +912,17 @@ FrameGraphResources::FrameGraphResources( BaseAllocator* allocator )
     : memoryAllocator( allocator )
     , pipelineImageQuality( 1.0f )
     , deltaTime( 0.0f )
-    , allocatedBuffersCount( 0 )
-	, allocatedImageCount( 0 )
-	, allocatedSamplerCount( 0 )
     , activeScreenSize( dkVec2u::Zero )
-    , instanceBufferData( nullptr )
+    , frameIndex( 0u )
+    , instanceData( nullptr )
+    , dirtyInstanceBegin( ~0u )
+    , dirtyInstanceEnd( 0u )
 {
-    memset( drawCmdBuckets, 0, sizeof( DrawCmdBucket ) * 3 * 4 );
+    memset( drawCmdBuckets, 0, sizeof( drawCmdBuckets ) );
     memset( &activeCameraData, 0, sizeof( CameraData ) );
     memset( &activeViewport, 0, sizeof( Viewport ) );
 
-    memset( allocatedBuffers, 0, sizeof( Buffer* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-    memset( buffersDesc, 0, sizeof( BufferDesc ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-    memset( isBufferFree, 0, sizeof( bool ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-
-    memset( allocatedImages, 0, sizeof( Image* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-    memset( imagesDesc, 0, sizeof( ImageDesc ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-    memset( isImageFree, 0, sizeof( bool ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-
-	memset( allocatedSamplers, 0, sizeof( Sampler* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-	memset( samplerDesc, 0, sizeof( ImageDesc ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-	memset( isSamplerFree, 0, sizeof( bool ) * MAX_ALLOCABLE_RESOURCE_TYPE );
+    memset( &transientMemoryStats, 0, sizeof( FGTransientMemoryStats ) );
 
     memset( inUseBuffers, 0, sizeof( Buffer* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
 	memset( inUseImages, 0, sizeof( Image* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
@@ -408,36 +930,46 @@ FrameGraphResources::FrameGraphResources( BaseAllocator* allocator )
 
     memset( persistentBuffers, 0, sizeof( Buffer* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
     memset( persistentImages, 0, sizeof( Image* ) * MAX_ALLOCABLE_RESOURCE_TYPE );
-
-    instanceBufferData = dk::core::allocateArray<uint8_t>( allocator, VECTOR_BUFFER_SIZE );
-    memset( instanceBufferData, 0, VECTOR_BUFFER_SIZE );
 }
 
 FrameGraphResources::~FrameGraphResources()
 {
-    dk::core::freeArray<u8>( memoryAllocator, static_cast<u8*>( instanceBufferData ) );
+
 }
 
 void FrameGraphResources::releaseResources( RenderDevice* renderDevice )
 {
-    for ( i32 bufferIdx = 0; bufferIdx < allocatedBuffersCount; bufferIdx++ ) {
-        renderDevice->destroyBuffer( allocatedBuffers[bufferIdx] );
-    }
+    bufferPool.forEach( [renderDevice]( Buffer* buffer ) { renderDevice->destroyBuffer( buffer ); } );
+    imagePool.forEach( [renderDevice]( Image* image ) { renderDevice->destroyImage( image ); } );
+    samplerPool.forEach( [renderDevice]( Sampler* sampler ) { renderDevice->destroySampler( sampler ); } );
+}
 
-    for ( i32 imageIdx = 0; imageIdx < allocatedImageCount; imageIdx++ ) {
-        renderDevice->destroyImage( allocatedImages[imageIdx] );
-	}
+void FrameGraphResources::unacquireResources( RenderDevice* renderDevice )
+{
+    bufferPool.releaseAll( frameIndex );
+    imagePool.releaseAll( frameIndex );
+    samplerPool.releaseAll( frameIndex );
 
-	for ( i32 samplerIdx = 0; samplerIdx < allocatedSamplerCount; samplerIdx++ ) {
-		renderDevice->destroySampler( allocatedSamplers[samplerIdx] );
-	}
+    // Pooled resources are reused by the next frames; resources which are no longer requested (e.g. after a
+    // resolution change) are destroyed once they have been unused for long enough.
+    frameIndex++;
+
+    bufferPool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Buffer* buffer ) { renderDevice->destroyBuffer( buffer ); } );
+    imagePool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Image* image ) { renderDevice->destroyImage( image ); } );
+    samplerPool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Sampler* sampler ) { renderDevice->destroySampler( sampler ); } );
+
+    memset( &transientMemoryStats, 0, sizeof( FGTransientMemoryStats ) );
 }
 
-void FrameGraphResources::unacquireResources()
+void FrameGraphResources::reuseAcquiredResources( RenderDevice* renderDevice )
 {
-    memset( isBufferFree, 1, sizeof( bool ) * static_cast<u32>( allocatedBuffersCount ) );
-	memset( isImageFree, 1, sizeof( bool ) * static_cast< u32 >( allocatedImageCount ) );
-	memset( isSamplerFree, 1, sizeof( bool ) * static_cast< u32 >( allocatedSamplerCount ) );
+    // Acquired resources stay in the pools in-use lists (and are therefore never evicted); the transient memory
+    // statistics of the previous frame are still valid.
+    frameIndex++;
+
+    bufferPool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Buffer* buffer ) { renderDevice->destroyBuffer( buffer ); } );
+    imagePool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Image* image ) { renderDevice->destroyImage( image ); } );
+    samplerPool.evict( frameIndex, TransientResourceEvictionDelay, [renderDevice]( Sampler* sampler ) { renderDevice->destroySampler( sampler ); } );
 }
 
 void FrameGraphResources::setPipelineViewport( const Viewport& viewport, const ScissorRegion& scissor, const CameraData* cameraData )
@@ -452,33 +984,9 @@ void FrameGraphResources::setImageQuality( const f32 imageQuality )
     pipelineImageQuality = imageQuality;
 }
 
-// Copy instance data to shared buffer
-void FrameGraphResources::updateVectorBuffer( const DrawCmd& cmd, size_t& instanceBufferOffset )
-{
-    switch ( cmd.key.bitfield.layer ) {
-    case DrawCommandKey::LAYER_DEPTH: {
-       /* const size_t instancesDataSize = sizeof( DrawCommandInfos::InstanceData ) * cmd.infos.instanceCount;
-
-        dkMat4x4f modelViewProjection = *cmd.infos.modelMatrix * activeCameraData.shadowViewMatrix[cmd.key.bitfield.viewportLayer - 1u];
-        memcpy( reinterpret_cast<u8*>( instanceBufferData ) + instanceBufferOffset, &modelViewProjection, sizeof( dkMat4x4f ) );
-
-        instanceBufferOffset += instancesDataSize;*/
-    } break;
-
-    case DrawCommandKey::LAYER_WORLD:
-    default: {
-        const size_t instancesDataSize = sizeof( DrawCommandInfos::InstanceData ) * cmd.infos.instanceCount;
-
-        memcpy( reinterpret_cast<u8*>( instanceBufferData ) + instanceBufferOffset, cmd.infos.modelMatrix, instancesDataSize );
-
-        instanceBufferOffset += instancesDataSize;
-    } break;
-    }
-}
-
 void FrameGraphResources::dispatchToBuckets( DrawCmd* drawCmds, const size_t drawCmdCount )
 {
-    memset( &drawCmdBuckets, 0, sizeof( DrawCmdBucket ) * 4 * 8 );
+    memset( drawCmdBuckets, 0, sizeof( drawCmdBuckets ) );
 
     if ( drawCmdCount == 0 ) {
         return;
@@ -491,12 +999,8 @@ void FrameGraphResources::dispatchToBuckets( DrawCmd* drawCmds, const size_t dra
 
     drawCmdBuckets[layer][viewportLayer].beginAddr = ( drawCmds + 0 );
 
-    size_t instanceBufferOffset = 0ull;
-
-    updateVectorBuffer( drawCmds[0], instanceBufferOffset );
-
+    // Instance data is not copied: draw commands reference the persistent instance data (see setInstanceData).
     DrawCmdBucket * previousBucket = &drawCmdBuckets[layer][viewportLayer];
-    previousBucket->instanceDataStartOffset = 0.0f;
     previousBucket->vectorPerInstance = static_cast< float >( sizeof( DrawCommandInfos::InstanceData ) / sizeof( dkVec4f ) );
 
     for ( size_t drawCmdIdx = 1; drawCmdIdx < drawCmdCount; drawCmdIdx++ ) {
@@ -508,15 +1012,12 @@ void FrameGraphResources::dispatchToBuckets( DrawCmd* drawCmds, const size_t dra
             auto & bucket = drawCmdBuckets[drawCmdKey.layer][drawCmdKey.viewportLayer];
             bucket.beginAddr = ( drawCmds + drawCmdIdx );
             bucket.vectorPerInstance = static_cast< float >( sizeof( DrawCommandInfos::InstanceData ) / sizeof( dkVec4f ) );
-            bucket.instanceDataStartOffset = static_cast< float >( instanceBufferOffset / sizeof( dkVec4f ) );
 
             layer = drawCmdKey.layer;
             viewportLayer = drawCmdKey.viewportLayer;
 
             previousBucket = &drawCmdBuckets[drawCmdKey.layer][drawCmdKey.viewportLayer];
         }
-
-        updateVectorBuffer( drawCmds[drawCmdIdx], instanceBufferOffset );
     }
 
     previousBucket->endAddr = ( drawCmds + drawCmdCount );
@@ -524,12 +1025,12 @@ void FrameGraphResources::dispatchToBuckets( DrawCmd* drawCmds, const size_t dra
 
 void FrameGraphResources::importPersistentImage( const dkStringHash_t resourceHashcode, Image* image )
 {
-    persistentImagesMap[resourceHashcode] = image;
+    persistentImagesTable.insert( resourceHashcode, image );
 }
 
 void FrameGraphResources::importPersistentBuffer( const dkStringHash_t resourceHashcode, Buffer * buffer )
 {
-    persistentBuffersMap[resourceHashcode] = buffer;
+    persistentBuffersTable.insert( resourceHashcode, buffer );
 }
 
 const FrameGraphResources::DrawCmdBucket& FrameGraphResources::getDrawCmdBucket( const DrawCommandKey::Layer layer, const uint8_t viewportLayer ) const
@@ -537,9 +1038,25 @@ const FrameGraphResources::DrawCmdBucket& FrameGraphResources::getDrawCmdBucket(
     return drawCmdBuckets[layer][viewportLayer];
 }
 
-void* FrameGraphResources::getVectorBufferData() const
+void FrameGraphResources::setInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyBegin, const u32 dirtyEnd )
 {
-    return instanceBufferData;
+    instanceData = instances;
+
+    if ( dirtyBegin < dirtyEnd ) {
+        dirtyInstanceBegin = Min( dirtyInstanceBegin, dirtyBegin );
+        dirtyInstanceEnd = Max( dirtyInstanceEnd, dirtyEnd );
+    }
+}
+
+const DrawCommandInfos::InstanceData* FrameGraphResources::flushInstanceData( u32& dirtyBegin, u32& dirtyEnd )
+{
+    dirtyBegin = dirtyInstanceBegin;
+    dirtyEnd = dirtyInstanceEnd;
+
+    dirtyInstanceBegin = ~0u;
+    dirtyInstanceEnd = 0u;
+
+    return instanceData;
 }
 
 const CameraData* FrameGraphResources::getMainCamera() const
@@ -602,44 +1119,45 @@ Image* FrameGraphResources::getPersitentImage( const FGHandle resourceHandle ) c
     return persistentImages[resourceHandle];
 }
 
-void FrameGraphResources::allocateBuffer( RenderDevice* renderDevice, const FGHandle resourceHandle, const BufferDesc& description )
+void FrameGraphResources::allocateBuffer( RenderDevice* renderDevice, const FGHandle resourceHandle, const BufferDesc& description, const u32 firstUsePass, const u32 lastUsePass )
 {
-    Buffer* buffer = nullptr;
+    const u64 bufferFootprint = description.SizeInBytes;
+    transientMemoryStats.PeakMemoryWithoutAliasing += bufferFootprint;
 
-    for ( int i = 0; i < allocatedBuffersCount; i++ ) {
-        if ( buffersDesc[i] == description && isBufferFree[i] ) {
-            buffer = allocatedBuffers[i];
-            isBufferFree[i] = false;
-            break;
-        }
+    // A free buffer or a buffer whose lifetime has ended before this one begins can be reused as long as it is large
+    // enough (the smallest compatible buffer is picked).
+    const u32 hashcode = HashReuseCompatibility( description );
+
+    bool isAliased = false;
+    i32 poolIndex = bufferPool.acquire( hashcode, description, static_cast< i32 >( firstUsePass ), static_cast< i32 >( lastUsePass ), frameIndex, EnableTransientAliasing, isAliased,
+                                        []( const BufferDesc& pooledDesc, const BufferDesc& desc ) { return GetReuseCost( pooledDesc, desc ); } );
+    if ( poolIndex == bufferPool.INVALID_ENTRY ) {
+        Buffer* buffer = renderDevice->createBuffer( description );
+        poolIndex = bufferPool.insert( hashcode, description, buffer, static_cast< i32 >( lastUsePass ), frameIndex );
     }
 
-    if ( buffer == nullptr ) {
-        buffer = renderDevice->createBuffer( description );
-        allocatedBuffers[allocatedBuffersCount] = buffer;
-        buffersDesc[allocatedBuffersCount] = description;
-        allocatedBuffersCount++;
+    // Only account the memory once per pooled buffer (using the size of the pooled buffer, which might be larger than
+    // the requested one).
+    if ( !isAliased ) {
+        transientMemoryStats.PeakMemoryWithAliasing += bufferPool.getDescription( poolIndex ).SizeInBytes;
     }
 
-    inUseBuffers[resourceHandle] = buffer;
+    inUseBuffers[resourceHandle] = bufferPool.getResource( poolIndex );
 }
 
-void FrameGraphResources::allocateImage( RenderDevice* renderDevice, const FGHandle resourceHandle, const ImageDesc& description, const u32 flags )
+void FrameGraphResources::allocateImage( RenderDevice* renderDevice, const FGHandle resourceHandle, const ImageDesc& description, const u32 flags, const u32 firstUsePass, const u32 lastUsePass )
 {
-    Image* image = nullptr;
+    const u64 imageFootprint = ImageDesc::GetMemoryFootprint( description );
+    transientMemoryStats.PeakMemoryWithoutAliasing += imageFootprint;
 
-    for ( i32 i = 0; i < allocatedImageCount; i++ ) {
-        if ( imagesDesc[i] == description && isImageFree[i] ) {
-            image = allocatedImages[i];
-            isImageFree[i] = false;
-            break;
-        }
-    }
+    // A free image or an image whose lifetime has ended before this one begins can be reused.
+    const u32 hashcode = HashDescription( description, flags );
 
-    if ( image == nullptr ) {
-        image = renderDevice->createImage( description );
-        allocatedImages[allocatedImageCount] = image;
-        imagesDesc[allocatedImageCount] = description;
+    bool isAliased = false;
+    i32 poolIndex = imagePool.acquire( hashcode, description, static_cast< i32 >( firstUsePass ), static_cast< i32 >( lastUsePass ), frameIndex, EnableTransientAliasing, isAliased,
+                                       []( const ImageDesc& pooledDesc, const ImageDesc& desc ) { return GetReuseCost( pooledDesc, desc ); } );
+    if ( poolIndex == imagePool.INVALID_ENTRY ) {
+        Image* image = renderDevice->createImage( description );
 
         if ( flags & FrameGraphBuilder::eImageFlags::REQUEST_PER_MIP_RESOURCE_VIEW ) {
             // Negative or null mip count means that the mip count must be automatically computed.
@@ -659,59 +1177,57 @@ void FrameGraphResources::allocateImage( RenderDevice* renderDevice, const FGHan
             }
         }
 
-        allocatedImageCount++;
+        poolIndex = imagePool.insert( hashcode, description, image, static_cast< i32 >( lastUsePass ), frameIndex );
     }
 
-    inUseImages[resourceHandle] = image;
+    // Only account the memory once per pooled image.
+    if ( !isAliased ) {
+        transientMemoryStats.PeakMemoryWithAliasing += imageFootprint;
+    }
+
+    inUseImages[resourceHandle] = imagePool.getResource( poolIndex );
 }
 
 void FrameGraphResources::allocateSampler( RenderDevice* renderDevice, const FGHandle resourceHandle, const SamplerDesc& description )
 {
-    Sampler* sampler = nullptr;
+    const u32 hashcode = HashDescription( description );
 
-    for ( i32 i = 0; i < allocatedSamplerCount; i++ ) {
-        if ( samplerDesc[i] == description && isSamplerFree[i] ) {
-            sampler = allocatedSamplers[i];
-            isSamplerFree[i] = false;
-            break;
-        }
+    bool isAliased = false;
+    i32 poolIndex = samplerPool.acquire( hashcode, description, 0, 0, frameIndex, false, isAliased,
+                                         []( const SamplerDesc& pooledDesc, const SamplerDesc& desc ) { return GetReuseCost( pooledDesc, desc ); } );
+    if ( poolIndex == samplerPool.INVALID_ENTRY ) {
+        Sampler* sampler = renderDevice->createSampler( description );
+        poolIndex = samplerPool.insert( hashcode, description, sampler, 0, frameIndex );
     }
 
-    if ( sampler == nullptr ) {
-        sampler = renderDevice->createSampler( description );
-        allocatedSamplers[allocatedSamplerCount] = sampler;
-        samplerDesc[allocatedSamplerCount] = description;
-        allocatedSamplerCount++;
-    }
-
-    inUseSamplers[resourceHandle] = sampler;
+    inUseSamplers[resourceHandle] = samplerPool.getResource( poolIndex );
 }
 
 void FrameGraphResources::bindPersistentBuffers( const FGHandle resourceHandle, const dkStringHash_t hashcode )
 {
-    auto it = persistentBuffersMap.find( hashcode );
-    persistentBuffers[resourceHandle] = ( it != persistentBuffersMap.end() ) ? it->second : nullptr;
+    persistentBuffers[resourceHandle] = persistentBuffersTable.find( hashcode );
 }
 
 void FrameGraphResources::bindPersistentImages( const FGHandle resourceHandle, const dkStringHash_t hashcode )
 {
-    auto it = persistentImagesMap.find( hashcode );
-    persistentImages[resourceHandle] = ( it != persistentImagesMap.end() ) ? it->second : nullptr;
+    persistentImages[resourceHandle] = persistentImagesTable.find( hashcode );
 }
 
 bool FrameGraphResources::isPersistentImageAvailable( const dkStringHash_t resourceHashcode ) const
 {
-    return ( persistentImagesMap.find( resourceHashcode ) != persistentImagesMap.end() );
+    return persistentImagesTable.contains( resourceHashcode );
 }
 
 bool FrameGraphResources::isPersistentBufferAvailable( const dkStringHash_t resourceHashcode ) const
 {
-    return ( persistentBuffersMap.find( resourceHashcode ) != persistentBuffersMap.end() );
+    return persistentBuffersTable.contains( resourceHashcode );
 }
 
-FrameGraph::FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevice, VirtualFileSystem* activeVfs )
+FrameGraph::FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevice, VirtualFileSystem* activeVfs, JobSystem* jobSystem )
     : memoryAllocator( allocator )
+    , passAllocator( allocator, PASS_ALLOCATOR_CHUNK_SIZE )
     , renderPassCount( 0 )
+    , bindingDestructorCount( 0u )
     , pipelineImageQuality( 1.0f )
     , graphScreenSize( dkVec2u::Zero )
     , msaaSamplerCount( 0 )
@@ -721,11 +1237,10 @@ FrameGraph::FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevi
     , ssrLastFrameRenderTarget( nullptr )
     , presentRenderTarget( nullptr )
     , graphResources( allocator )
-    , graphBuilder()
-    , graphScheduler( allocator, activeRenderDevice, activeVfs )
+    , graphBuilder( &passAllocator )
+    , graphScheduler( allocator, &passAllocator, activeRenderDevice, activeVfs, jobSystem )
     , graphicsProfiler( nullptr )
 {
-    memset( renderPasses, 0, sizeof( FrameGraphRenderPass ) * 48 );
     memset( &activeViewport, 0, sizeof( Viewport ) );
 
     // Setup PerView Buffer (persistent buffer shared between workers)
@@ -757,12 +1272,14 @@ FrameGraph::FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevi
 
 FrameGraph::~FrameGraph()
 {
-
+    graphScheduler.waitUntilReady();
+    releasePassStorage();
 }
 
 void FrameGraph::destroy( RenderDevice* renderDevice )
 {
     graphResources.releaseResources( renderDevice );
+    graphBuilder.invalidateCompiledGraph();
 
     if ( graphicsProfiler != nullptr ) {
         //graphicsProfiler->destroy( renderDevice );
@@ -794,13 +1311,18 @@ void FrameGraph::waitPendingFrameCompletion()
 {
     DUSK_CPU_PROFILE_FUNCTION;
     
-    while ( !graphScheduler.isReady() ) {
-        std::this_thread::yield();
+    graphScheduler.waitUntilReady();
+
+    // The storage of the completed frame can be reused (unless RenderPasses have been recorded for the next frame).
+    if ( renderPassCount == 0 ) {
+        releasePassStorage();
     }
 }
 
 void FrameGraph::execute( RenderDevice* renderDevice, const f32 deltaTime )
 {
+    DUSK_CPU_PROFILE_FUNCTION;
+
     // Check if we need to reallocate persistent resources
     if ( hasViewportChanged ) {
         recreatePersistentResources( renderDevice );
@@ -820,11 +1342,17 @@ void FrameGraph::execute( RenderDevice* renderDevice, const f32 deltaTime )
 	graphResources.importPersistentBuffer( VECTORDATA_BUFFER_RESOURCE_HASHCODE, graphScheduler.getVectorDataBuffer() );
     
     // Cull & compile
-    //graphBuilder.cullRenderPasses( renderPasses, renderPassCount );
-    graphBuilder.compile( renderDevice, graphResources );
+    //graphBuilder.cullRenderPasses( renderPasses.data(), renderPassCount );
+    {
+        DUSK_CPU_PROFILE_SCOPED( "Compile FrameGraph" );
+        graphBuilder.compile( renderDevice, graphResources );
+    }
     
     // Schedule renderpass execution.
-    graphBuilder.scheduleRenderPasses( graphScheduler, renderPasses, renderPassCount );
+    {
+        DUSK_CPU_PROFILE_SCOPED( "Schedule RenderPasses" );
+        graphBuilder.scheduleRenderPasses( graphScheduler, renderPasses.data(), renderPassCount );
+    }
 
     // Update PerView Buffer
     if ( activeCamera != nullptr ) {
@@ -877,7 +1405,10 @@ void FrameGraph::execute( RenderDevice* renderDevice, const f32 deltaTime )
 #endif
 
     // Dispatch render passes to rendering threads
-    graphScheduler.dispatch( &perViewData, graphResources.getVectorBufferData() );
+    u32 dirtyInstanceBegin, dirtyInstanceEnd;
+    const DrawCommandInfos::InstanceData* instanceData = graphResources.flushInstanceData( dirtyInstanceBegin, dirtyInstanceEnd );
+
+    graphScheduler.dispatch( &perViewData, instanceData, dirtyInstanceBegin, dirtyInstanceEnd );
 
     renderPassCount = 0;
 }
@@ -887,6 +1418,13 @@ void FrameGraph::submitAndDispatchDrawCmds( DrawCmd* drawCmds, const size_t draw
     graphResources.dispatchToBuckets( drawCmds, drawCmdCount );
 }
 
+void FrameGraph::submitInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd )
+{
+    DUSK_DEV_ASSERT( dirtyInstanceBegin >= dirtyInstanceEnd || dirtyInstanceEnd <= MAX_INSTANCE_COUNT, "Instance data range is out of bounds!" );
+
+    graphResources.setInstanceData( instances, dirtyInstanceBegin, dirtyInstanceEnd );
+}
+
 void FrameGraph::setViewport( const Viewport& viewport, const ScissorRegion& scissorRegion, const CameraData* camera )
 {
     hasViewportChanged = ( activeViewport != viewport );
@@ -992,8 +1530,11 @@ DUSK_INLINE void AddCopyImagePass( FrameGraph& frameGraph, FGHandle inputRenderT
         FGHandle outputImage;
     };
 
+    constexpr const char* PassName = "FrameGraph::copyAsPresentRenderTarget";
+    constexpr dkStringHash_t PassNameHashcode = DUSK_STRING_HASH( PassName );
+
     PassData& downscaleData = frameGraph.addRenderPass<PassData>(
-        "FrameGraph::copyAsPresentRenderTarget",
+        PassName, PassNameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.setUncullablePass();
 
@@ -1099,6 +1640,63 @@ Image* FrameGraph::getPresentRenderTarget() const
     return presentRenderTarget;
 }
 
+FrameGraphRenderPass::Handle_t FrameGraph::allocateRenderPass( const char* name, const dkStringHash_t nameHashcode )
+{
+    const FrameGraphRenderPass::Handle_t renderPassHandle = static_cast< FrameGraphRenderPass::Handle_t >( renderPassCount );
+
+    renderPasses.reserve( &passAllocator, renderPassHandle + 1u, renderPassHandle );
+
+    FrameGraphRenderPass& renderPass = renderPasses[renderPassHandle];
+    renderPass.Binding = nullptr;
+    renderPass.ExecuteBinding = nullptr;
+    renderPass.Resources = &graphResources;
+    renderPass.NameHashcode = nameHashcode;
+#if DUSK_DEVBUILD
+    renderPass.Name = name;
+#endif
+    renderPass.Handle = renderPassHandle;
+    renderPass.PreBarriers = nullptr;
+    renderPass.PostBarriers = nullptr;
+    renderPass.PreBarrierCount = 0u;
+    renderPass.PostBarrierCount = 0u;
+    renderPass.RecordingChunkCount = 1u;
+
+    renderPassCount++;
+
+    return renderPassHandle;
+}
+
+void* FrameGraph::allocatePassMemory( const size_t size, const size_t alignment )
+{
+    void* memory = passAllocator.allocate( size, static_cast< u8 >( alignment ) );
+    DUSK_RAISE_FATAL_ERROR( memory != nullptr, "RenderPass storage allocation failed!" );
+
+    memset( memory, 0, size );
+
+    return memory;
+}
+
+void FrameGraph::registerBindingDestructor( FrameGraphRenderPass::DestroyBinding_t destroy, void* binding )
+{
+    bindingDestructors.pushBack( &passAllocator, bindingDestructorCount, BindingDestructor{ destroy, binding } );
+}
+
+void FrameGraph::releasePassStorage()
+{
+    for ( u32 i = 0u; i < bindingDestructorCount; i++ ) {
+        bindingDestructors[i].Destroy( bindingDestructors[i].Binding );
+    }
+    bindingDestructorCount = 0u;
+
+    renderPasses.reset();
+    bindingDestructors.reset();
+
+    graphBuilder.releasePassStorage();
+    graphScheduler.releasePassStorage();
+
+    passAllocator.clear();
+}
+
 void FrameGraph::recreatePersistentResources( RenderDevice* renderDevice )
 {
     // Last Frame Render Target
@@ -1156,16 +1754,26 @@ void FrameGraph::recreatePersistentResources( RenderDevice* renderDevice )
     ssrLastFrameRenderTarget = renderDevice->createImage( ssrDesc );
 }
 
-FrameGraphScheduler::FrameGraphScheduler( BaseAllocator* allocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys )
+FrameGraphScheduler::FrameGraphScheduler( BaseAllocator* allocator, BaseAllocator* passAllocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys, JobSystem* jobSystem )
     : memoryAllocator( allocator )
+    , passAllocator( passAllocator )
+    , jobSystem( jobSystem )
+    , pipelineStateCache( nullptr )
     , renderDevice( renderDevice )
     , perViewBuffer( nullptr )
 #if DUSKED
     , materialEditorBuffer( nullptr )
 #endif
     , enqueuedRenderPassCount( 0u )
-    , enqueuedAsyncRenderPassCount( 0u )
+    , enqueuedCmdListCount( 0u )
+    , handleToEnqueuedIndexCount( 0u )
+    , dispatchedRenderPassCount( 0u )
     , currentState( SCHEDULER_STATE_READY )
+    , pendingDirtyBegin( ~0ull )
+    , pendingDirtyEnd( 0ull )
+    , vectorBufferUsedSize( 0ull )
+    , uploadIndex( 0u )
+    , isPartialBufferUpdateSupported( renderDevice->hasPartialBufferUpdate() )
 {
     BufferDesc perViewBufferDesc;
     perViewBufferDesc.Usage = RESOURCE_USAGE_DYNAMIC;
@@ -1193,58 +1801,102 @@ FrameGraphScheduler::FrameGraphScheduler( BaseAllocator* allocator, RenderDevice
     vectorDataBuffer = renderDevice->createBuffer( vectorDataBufferDesc );
 
     instanceBufferData = dk::core::allocateArray<u8>( allocator, VECTOR_BUFFER_SIZE );
+    memset( instanceBufferData, 0, VECTOR_BUFFER_SIZE );
 
-    workers = dk::core::allocateArray<FrameGraphRenderThread>( memoryAllocator, RENDER_THREAD_COUNT, memoryAllocator, renderDevice, virtualFileSys );
-    dispatcherThread = std::thread( &FrameGraphScheduler::jobDispatcherThread, this );
+    for ( i32 i = 0; i < RenderDevice::PENDING_FRAME_COUNT; i++ ) {
+        uploadDirtyBegin[i] = ~0ull;
+        uploadDirtyEnd[i] = 0ull;
+    }
+
+    // A RenderPass can be executed by any worker; the cache is shared (PSOs are only created once).
+    pipelineStateCache = dk::core::allocate<PipelineStateCache>( memoryAllocator, memoryAllocator, renderDevice, virtualFileSys );
 
-    memset( enqueuedRenderPass, 0, sizeof( RenderPassExecutionInfos ) * MAX_RENDERPASS_PER_FRAME );
-    memset( enqueuedAsyncRenderPass, 0, sizeof( RenderPassExecutionInfos ) * MAX_RENDERPASS_PER_FRAME );
+    dispatcherThread = std::thread( &FrameGraphScheduler::jobDispatcherThread, this );
 }
 
 FrameGraphScheduler::~FrameGraphScheduler()
 {
-    if ( workers != nullptr ) {
-        dk::core::freeArray( memoryAllocator, workers );
-        workers = nullptr;
-    }
+    // Wait for the pending frame and notify the dispatcher thread for shutdown.
+    waitUntilReady();
+    setState( SCHEDULER_STATE_WAITING_SHUTDOWN );
 
-    currentState.store( SCHEDULER_STATE_WAITING_SHUTDOWN );
     if ( dispatcherThread.joinable() ) {
         dispatcherThread.join();
     }
 
+    if ( pipelineStateCache != nullptr ) {
+        dk::core::free( memoryAllocator, pipelineStateCache );
+        pipelineStateCache = nullptr;
+    }
+
     dk::core::freeArray( memoryAllocator, instanceBufferData );
 }
 
 void FrameGraphScheduler::addRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies, const u32 dependencyCount )
 {
-    // Retrieve internal FrameGraphRenderPass state to build state dependencies.
-    RenderPassExecutionInfos::State_t* internalDependencies[RenderPassExecutionInfos::MAX_DEP_COUNT] = { nullptr };
+    const u32 enqueuedIndex = enqueuedRenderPassCount;
+    enqueuedRenderPass.reserve( passAllocator, enqueuedIndex + 1u, enqueuedIndex );
+    enqueuedRenderPassCount++;
+
+    if ( renderPass.Handle >= handleToEnqueuedIndexCount ) {
+        const u32 newHandleCount = renderPass.Handle + 1u;
+        handleToEnqueuedIndex.reserve( passAllocator, newHandleCount, handleToEnqueuedIndexCount );
+
+        // Handles of RenderPasses which are not enqueued (e.g. culled RenderPasses) have no index.
+        memset( &handleToEnqueuedIndex[handleToEnqueuedIndexCount], 0xff, sizeof( u32 ) * ( newHandleCount - handleToEnqueuedIndexCount ) );
+        handleToEnqueuedIndexCount = newHandleCount;
+    }
+
+    handleToEnqueuedIndex[renderPass.Handle] = enqueuedIndex;
+
+    RenderPassExecutionInfos& execInfos = enqueuedRenderPass[enqueuedIndex];
+    execInfos.RenderPass = &renderPass;
+    execInfos.Scheduler = this;
+    execInfos.CmdLists = nullptr;
+    execInfos.RecordingChunks = static_cast< RenderPassRecordingChunk* >( passAllocator->allocate( sizeof( RenderPassRecordingChunk ) * renderPass.RecordingChunkCount, alignof( RenderPassRecordingChunk ) ) );
+    execInfos.CmdListIndex = enqueuedCmdListCount;
+    execInfos.StartJob = nullptr;
+    execInfos.CompletionJob = nullptr;
+    execInfos.QueueSignalValue = 0ull;
+    execInfos.CriticalPathLength = 0.0f;
+    execInfos.JobPriority = 0u;
+    execInfos.DispatchOrder = ~0u;
+    execInfos.UseAsyncCompute = false;
+    execInfos.WritesUntrackedResources = false;
+    execInfos.DependencyCount = 0u;
+    execInfos.Dependencies = ( dependencyCount > 0u ) ? static_cast< u32* >( passAllocator->allocate( sizeof( u32 ) * dependencyCount, alignof( u32 ) ) ) : nullptr;
+
+    // Remap dependency handles to enqueued indexes (RenderPass are enqueued in submission order so the dependencies
+    // should already be known).
     for ( u32 depIdx = 0u; depIdx < dependencyCount; depIdx++ ) {
-        const FrameGraphRenderPass::Handle_t dependencyHandle = dependencies[depIdx];
+        const u32 dependencyIndex = handleToEnqueuedIndex[dependencies[depIdx]];
+        DUSK_DEV_ASSERT( dependencyIndex < enqueuedIndex, "RenderPass depends on a RenderPass which has not been enqueued yet!" );
 
-        internalDependencies[depIdx] = &enqueuedRenderPass[dependencyHandle].ExecutionState;
+        execInfos.Dependencies[execInfos.DependencyCount++] = dependencyIndex;
     }
 
-    RenderPassExecutionInfos& execInfos = enqueuedRenderPass[enqueuedRenderPassCount++];
-    execInfos = RenderPassExecutionInfos( &renderPass, internalDependencies, dependencyCount );
+    DUSK_RAISE_FATAL_ERROR( execInfos.RecordingChunks != nullptr, "RenderPass recording chunks allocation failed!" );
+
+    for ( u32 chunkIdx = 0u; chunkIdx < renderPass.RecordingChunkCount; chunkIdx++ ) {
+        RenderPassRecordingChunk& recordingChunk = execInfos.RecordingChunks[chunkIdx];
+        recordingChunk.ExecInfos = &execInfos;
+        recordingChunk.Chunk.Index = chunkIdx;
+        recordingChunk.Chunk.Count = renderPass.RecordingChunkCount;
+        recordingChunk.RecordingJob = nullptr;
+        recordingChunk.CpuTime = 0.0f;
+    }
+
+    enqueuedCmdListCount += renderPass.RecordingChunkCount;
 }
 
-void FrameGraphScheduler::addAsyncComputeRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies, const u32 dependencyCount )
+void FrameGraphScheduler::addAsyncComputeRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies, const u32 dependencyCount, const bool writesUntrackedResources )
 {
-#ifndef DUSK_ASYNC_COMPUTE_AVAILABLE
     addRenderPass( renderPass, dependencies, dependencyCount );
-#else
-    // Retrieve internal FrameGraphRenderPass state to build state dependencies.
-    RenderPassExecutionInfos::State_t* internalDependencies[RenderPassExecutionInfos::MAX_DEP_COUNT] = { nullptr };
-    for ( u32 depIdx = 0u; depIdx < dependencyCount; depIdx++ ) {
-        const FrameGraphRenderPass::Handle_t dependencyHandle = dependencies[depIdx];
 
-        internalDependencies[depIdx] = &enqueuedAsyncRenderPass[dependencyHandle].ExecutionState;
-    }
-
-    enqueuedAsyncRenderPass[enqueuedAsyncRenderPassCount++] = RenderPassExecutionInfos( &renderPass, internalDependencies, dependencyCount );
-#endif
+    // Fallback to the graphics queue if the device can't overlap compute and graphics work.
+    RenderPassExecutionInfos& execInfos = enqueuedRenderPass[enqueuedRenderPassCount - 1];
+    execInfos.UseAsyncCompute = ( EnableAsyncCompute && renderDevice->hasAsyncComputeQueue() );
+    execInfos.WritesUntrackedResources = writesUntrackedResources;
 }
 
 #if DUSKED
@@ -1257,232 +1909,453 @@ void FrameGraphScheduler::updateMaterialEdBuffer( const MaterialEdData* matEdDat
 }
 #endif
 
-void FrameGraphScheduler::dispatch( const PerViewBufferData* perViewData, const void* vectorBufferData )
+void FrameGraphScheduler::dispatch( const PerViewBufferData* perViewData, const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd )
 {
-    if ( enqueuedRenderPassCount == 0u && enqueuedAsyncRenderPassCount == 0u ) {
+    // Copy the modified instances (the dispatcher thread only reads the copy while recording a frame). The modified
+    // range is kept until the next upload (even if nothing is dispatched this frame).
+    if ( instances != nullptr && dirtyInstanceBegin < dirtyInstanceEnd ) {
+        const size_t dirtyBegin = dirtyInstanceBegin * sizeof( DrawCommandInfos::InstanceData );
+        const size_t dirtyEnd = dirtyInstanceEnd * sizeof( DrawCommandInfos::InstanceData );
+
+        memcpy( instanceBufferData + dirtyBegin, instances + dirtyInstanceBegin, dirtyEnd - dirtyBegin );
+
+        pendingDirtyBegin = Min( pendingDirtyBegin, dirtyBegin );
+        pendingDirtyEnd = Max( pendingDirtyEnd, dirtyEnd );
+    }
+
+    if ( enqueuedRenderPassCount == 0u ) {
         return;
     }
 
+    // The arena is not thread safe; allocate the submission list before waking up the dispatcher thread.
+    cmdListsToSubmit.reserve( passAllocator, enqueuedCmdListCount, 0u );
+
+    computeRenderPassPriorities();
+
     // Make a local copy of the data (if available).
     if ( perViewData != nullptr ) {
         memcpy( &perViewBufferData, perViewData, sizeof( PerViewBufferData ) );
     }
 
-    if ( vectorBufferData != nullptr ) {
-        memcpy( instanceBufferData, vectorBufferData, VECTOR_BUFFER_SIZE );
-    }
-
     State schedulerState = SCHEDULER_STATE_READY;
     bool flushResult = currentState.compare_exchange_strong( schedulerState, SCHEDULER_STATE_HAS_JOB_TO_DO );
     
     DUSK_DEV_ASSERT( flushResult, "Failed to flush FrameGraphScheduler : the scheduler is busy!" );
+
+    // Wake up the dispatcher thread.
+    { std::lock_guard<std::mutex> lock( stateMutex ); }
+    stateCondition.notify_all();
 }
 
 bool FrameGraphScheduler::isReady()
 {
-    State schedulerState = SCHEDULER_STATE_READY;
-    return currentState.compare_exchange_weak( schedulerState, SCHEDULER_STATE_READY );
+    return currentState.load() == SCHEDULER_STATE_READY;
 }
 
-void FrameGraphScheduler::jobDispatcherThread()
+void FrameGraphScheduler::waitUntilReady()
 {
-    while ( 1 ) {
-        State schedulerState = SCHEDULER_STATE_HAS_JOB_TO_DO;
-        if ( !currentState.compare_exchange_weak( schedulerState, SCHEDULER_STATE_HAS_JOB_TO_DO ) ) {
-            if ( schedulerState == SCHEDULER_STATE_WAITING_SHUTDOWN ) {
-                return;
-            }
+    std::unique_lock<std::mutex> lock( stateMutex );
+    stateCondition.wait( lock, [this]() { return currentState.load() == SCHEDULER_STATE_READY; } );
+}
 
-            std::this_thread::yield();
-            continue;
-        }
+void FrameGraphScheduler::releasePassStorage()
+{
+    DUSK_DEV_ASSERT( enqueuedRenderPassCount == 0u, "RenderPasses are still enqueued!" );
 
-        currentState.store( SCHEDULER_STATE_WAITING_JOB_COMPLETION );
+    enqueuedRenderPass.reset();
+    handleToEnqueuedIndex.reset();
+    cmdListsToSubmit.reset();
+    handleToEnqueuedIndexCount = 0u;
+}
 
-        // Schedule renderpasses
-        i32 freeWorkerIdx = 0;
-        i32 perWorkerJobCount[RENDER_THREAD_COUNT] = { 0 };
+#if DUSK_DEVBUILD
+void FrameGraphScheduler::fillScheduleEditorInfos( std::vector<FGRenderPassScheduleInfosEditor>& infos ) const
+{
+    std::lock_guard<std::mutex> lock( scheduleInfosMutex );
+    infos = scheduleInfos;
+}
+#endif
 
-        // TODO Have a dedicated worker for compute render pass? (so that we can schedule stuff asynchronously?)
+void FrameGraphScheduler::computeRenderPassPriorities()
+{
+    // Cost of a RenderPass without timing history (this way the critical path length matches the chain length).
+    constexpr f32 DefaultPassCost = 0.001f;
 
-        // Super basic load-balancing, we should get some kind of metric to make this more efficient (instruction count? expected run time?)
-//#ifndef DUSK_ASYNC_COMPUTE_AVAILABLE
-        i32 renderPassPerWorker = ( enqueuedRenderPassCount / RENDER_THREAD_COUNT ) + 1;
+    // Priorities are expressed in microseconds (zero is reserved for non-prioritized jobs).
+    constexpr f32 PriorityPerMs = 1000.0f;
 
-        // TODO For testing purposes, we do a FIFO scheduling.
+    if ( !EnableCriticalPathScheduling ) {
         for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
-            workers[freeWorkerIdx].enqueueRenderPass( &enqueuedRenderPass[i] );
-
-            ++perWorkerJobCount[freeWorkerIdx];
-            if ( perWorkerJobCount[freeWorkerIdx] >= renderPassPerWorker ) {
-                freeWorkerIdx = ( ++freeWorkerIdx % RENDER_THREAD_COUNT );
-            }
+            enqueuedRenderPass[i].CriticalPathLength = 0.0f;
+            enqueuedRenderPass[i].JobPriority = 0u;
         }
-        enqueuedRenderPassCount = 0u;
-//#else
-//#pragma error "Async Compute needs to be implemented!"
-//#endif
+        return;
+    }
 
-        // Update shared resources at the beginning of the frame (e.g. PerViewBuffer).
-        // Flush the command list as soon as possible.
-        // We need to do the buffer upload in the dispatcher thread since we want to guarantee the constness of the view
-        // data for the frame being rendered.
-        CommandList& bufferUploadCmdList = renderDevice->allocateCopyCommandList();
-        bufferUploadCmdList.begin();
-        bufferUploadCmdList.updateBuffer( *perViewBuffer, &perViewBufferData, sizeof( PerViewBufferData ) );
-#if DUSKED
-        bufferUploadCmdList.updateBuffer( *materialEditorBuffer, &materialEdData, sizeof( MaterialEdData ) );
-#endif
-        bufferUploadCmdList.updateBuffer( *vectorDataBuffer, instanceBufferData, VECTOR_BUFFER_SIZE );
-        bufferUploadCmdList.end();
-        renderDevice->submitCommandList( bufferUploadCmdList );
+    // Longest critical path of the RenderPasses depending on a given RenderPass.
+    f32* longestDependentPath = static_cast< f32* >( passAllocator->allocate( sizeof( f32 ) * enqueuedRenderPassCount, alignof( f32 ) ) );
+    DUSK_RAISE_FATAL_ERROR( longestDependentPath != nullptr, "Critical path storage allocation failed!" );
+    memset( longestDependentPath, 0, sizeof( f32 ) * enqueuedRenderPassCount );
 
-        CommandList* allocatedCmdList[RENDER_THREAD_COUNT] = { nullptr };
-        for ( i32 j = 0; j < RENDER_THREAD_COUNT; j++ ) {
-            if ( workers[j].hasWorkTodo() ) {
-                allocatedCmdList[j] = ( j == 1 ) ? &renderDevice->allocateComputeCommandList() : &renderDevice->allocateGraphicsCommandList();
-                allocatedCmdList[j]->begin();
+    // RenderPasses only depend on RenderPasses enqueued before them; walking the list backward guarantees that every
+    // dependent of a RenderPass has been visited before the RenderPass itself.
+    for ( i32 i = static_cast< i32 >( enqueuedRenderPassCount ) - 1; i >= 0; i-- ) {
+        RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+        const dkStringHash_t passHashcode = execInfos.RenderPass->NameHashcode;
 
-                workers[j].flush( allocatedCmdList[j] );
-            }
-        }
+        auto timingsIt = passTimings.find( passHashcode );
+        const f32 cpuTime = ( timingsIt != passTimings.end() ) ? timingsIt->second.CpuTime : 0.0f;
+        const f32 gpuTime = g_GpuProfiler.getLatestSectionTiming( passHashcode );
+        const f32 passCost = Max( cpuTime + gpuTime, DefaultPassCost );
 
-        spinUntilCompletion();
+        execInfos.CriticalPathLength = passCost + longestDependentPath[i];
+        execInfos.JobPriority = 1u + static_cast< u32 >( execInfos.CriticalPathLength * PriorityPerMs );
 
-        // Finish cmd list and submit to the Device.
-        u32 cmdCount = 0;
-        CommandList* cmdListToSubmit[RENDER_THREAD_COUNT] = { nullptr };
-        for ( i32 j = 0; j < RENDER_THREAD_COUNT; j++ ) {
-            if ( allocatedCmdList[j] != nullptr ) {
-                CommandList& workerCmdList = *allocatedCmdList[j];
-                workerCmdList.end();
-
-                cmdListToSubmit[cmdCount++] = allocatedCmdList[j];
-            }
+        for ( u32 depIdx = 0; depIdx < execInfos.DependencyCount; depIdx++ ) {
+            f32& dependencyLongestPath = longestDependentPath[execInfos.Dependencies[depIdx]];
+            dependencyLongestPath = Max( dependencyLongestPath, execInfos.CriticalPathLength );
         }
-
-        renderDevice->submitCommandLists( cmdListToSubmit, cmdCount );
-
-        // Swap buffers
-        renderDevice->present();
-
-        currentState.store( SCHEDULER_STATE_READY );
     }
 }
 
-void FrameGraphScheduler::spinUntilCompletion()
+void FrameGraphScheduler::updateRenderPassTimings()
 {
-    bool isReady;
+#if DUSK_DEVBUILD
+    std::lock_guard<std::mutex> lock( scheduleInfosMutex );
+    scheduleInfos.resize( enqueuedRenderPassCount );
+#endif
 
-    do {
-        isReady = true;
+    for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
+        const RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+        const FrameGraphRenderPass* renderPass = execInfos.RenderPass;
 
-        for ( i32 j = 0; j < RENDER_THREAD_COUNT; j++ ) {
-            isReady &= workers[j].isReady();
+        // Chunks are recorded concurrently; the longest chunk is the one delaying the dependents.
+        f32 cpuTime = 0.0f;
+        for ( u32 chunkIdx = 0; chunkIdx < renderPass->RecordingChunkCount; chunkIdx++ ) {
+            cpuTime = Max( cpuTime, execInfos.RecordingChunks[chunkIdx].CpuTime );
         }
-    } while ( !isReady );
+
+        passTimings[renderPass->NameHashcode].CpuTime = cpuTime;
+
+#if DUSK_DEVBUILD
+        FGRenderPassScheduleInfosEditor& passScheduleInfos = scheduleInfos[i];
+        passScheduleInfos.Name = renderPass->Name;
+        passScheduleInfos.CpuTime = cpuTime;
+        passScheduleInfos.GpuTime = g_GpuProfiler.getLatestSectionTiming( renderPass->NameHashcode );
+        passScheduleInfos.CriticalPathLength = execInfos.CriticalPathLength;
+        passScheduleInfos.DispatchOrder = execInfos.DispatchOrder;
+        passScheduleInfos.UseAsyncCompute = execInfos.UseAsyncCompute;
+#endif
+    }
 }
 
-FrameGraphRenderThread::FrameGraphRenderThread( BaseAllocator* allocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys )
-    : memoryAllocator( allocator )
-    , threadHandle( &FrameGraphRenderThread::workerThread, this )
-    , pipelineStateCache( nullptr )
-    , commandList( nullptr )
-    , currentState( FGRAPH_THREAD_STATE_READY )
-    , rpToExecuteCount( 0u )
+void FrameGraphScheduler::setState( const State state )
 {
-    pipelineStateCache = dk::core::allocate<PipelineStateCache>( memoryAllocator, memoryAllocator, renderDevice, virtualFileSys );
-    memset( renderpassToExecute, 0, sizeof( RenderPassExecutionInfos* ) * MAX_RENDERPASS_COUNT );
+    {
+        std::lock_guard<std::mutex> lock( stateMutex );
+        currentState.store( state );
+    }
+    stateCondition.notify_all();
 }
 
-FrameGraphRenderThread::~FrameGraphRenderThread()
+void FrameGraphScheduler::ExecuteRenderPassJob( void* userData, const u32 workerIndex )
 {
-    // Notify workerThread for shutdown.
-    currentState.store( FGRAPH_THREAD_STATE_WAITING_SHUTDOWN );
-    if ( threadHandle.joinable() ) {
-        threadHandle.join();
+    Timer recordingTimer;
+    recordingTimer.start();
+
+    RenderPassRecordingChunk* recordingChunk = static_cast< RenderPassRecordingChunk* >( userData );
+    RenderPassExecutionInfos* execInfos = recordingChunk->ExecInfos;
+    const FrameGraphRenderPass* renderPass = execInfos->RenderPass;
+    const FGRecordingChunk& chunk = recordingChunk->Chunk;
+
+    CommandList* cmdList = execInfos->CmdLists[chunk.Index];
+
+    // A split recording is bracketed by the start/completion jobs; otherwise the boundaries are recorded here.
+    const bool isSplit = ( chunk.Count > 1u );
+    if ( !isSplit ) {
+        StartRenderPassJob( execInfos, workerIndex );
     }
 
-    dk::core::free( memoryAllocator, pipelineStateCache );
-    commandList = nullptr;
-    rpToExecuteCount.store( 0u );
+    renderPass->Execute( cmdList, execInfos->Scheduler->pipelineStateCache, chunk );
+
+    if ( !isSplit ) {
+        CompleteRenderPassJob( execInfos, workerIndex );
+    }
+
+    recordingChunk->CpuTime = static_cast< f32 >( recordingTimer.getElapsedTimeAsMiliseconds() );
 }
 
-bool FrameGraphRenderThread::isReady()
+void FrameGraphScheduler::StartRenderPassJob( void* userData, const u32 workerIndex )
 {
-    State ExpectedState = FGRAPH_THREAD_STATE_READY;
-    return currentState.compare_exchange_weak( ExpectedState, FGRAPH_THREAD_STATE_READY );
+    DUSK_UNUSED_VARIABLE( workerIndex );
+
+    RenderPassExecutionInfos* execInfos = static_cast< RenderPassExecutionInfos* >( userData );
+    const FrameGraphRenderPass* renderPass = execInfos->RenderPass;
+
+    execInfos->DispatchOrder = execInfos->Scheduler->dispatchedRenderPassCount.fetch_add( 1u );
+
+    // The transitions resolved by the FrameGraph are flushed as a single batch at the RenderPass boundaries (since
+    // the chunks are submitted in order, the first and last CommandLists are the boundaries of the RenderPass).
+    execInfos->CmdLists[0]->resourceBarriers( renderPass->PreBarriers, renderPass->PreBarrierCount );
 }
 
-bool FrameGraphRenderThread::hasWorkTodo()
+void FrameGraphScheduler::CompleteRenderPassJob( void* userData, const u32 workerIndex )
 {
-    u32 workCount = 0u;
+    DUSK_UNUSED_VARIABLE( workerIndex );
 
-    bool hasNothingTodo = rpToExecuteCount.compare_exchange_weak( workCount, 0u );
-    return !( hasNothingTodo && workCount == 0u );
+    RenderPassExecutionInfos* execInfos = static_cast< RenderPassExecutionInfos* >( userData );
+    const FrameGraphRenderPass* renderPass = execInfos->RenderPass;
+
+    execInfos->CmdLists[renderPass->RecordingChunkCount - 1u]->resourceBarriers( renderPass->PostBarriers, renderPass->PostBarrierCount );
 }
 
-void FrameGraphRenderThread::flush( CommandList* cmdList )
+void FrameGraphScheduler::submitCommandLists( u64 waitedSignalValues[COMMAND_QUEUE_COUNT][COMMAND_QUEUE_COUNT] )
 {
-    commandList = cmdList;
+    // CommandLists are submitted in enqueue order. Consecutive RenderPasses on the same queue are submitted as a batch;
+    // the batch is flushed whenever the queue changes or a cross-queue wait is required.
+    u64 lastSignalValues[COMMAND_QUEUE_COUNT] = {};
+
+    // Value the graphics queue must wait for before its next RenderPass (async RenderPasses writing untracked resources).
+    u64 untrackedWritesSignalValue = 0ull;
 
-    rpInExecutionCount.store( rpToExecuteCount.load() );
-    rpToExecuteCount.store( 0u );
+    // Batches are ranges of RenderPass; the CommandLists of a batch are the CommandLists of its RenderPass (contiguous
+    // in the submission list).
+    eCommandQueue batchQueue = COMMAND_QUEUE_GRAPHICS;
+    bool batchWritesUntrackedResources = false;
+    u32 batchStart = 0u;
+
+    auto flushBatch = [&]( const u32 batchEnd ) {
+        if ( batchStart == batchEnd ) {
+            return;
+        }
 
-    State workerState = FGRAPH_THREAD_STATE_READY;
-    bool flushResult = currentState.compare_exchange_strong( workerState, FGRAPH_THREAD_STATE_HAS_JOB_TO_DO );
-    DUSK_DEV_ASSERT( flushResult, "Failed to flush RenderJobs : the RenderThread is busy!" );
+        const u32 cmdListStart = enqueuedRenderPass[batchStart].CmdListIndex;
+        const u32 cmdListEnd = ( batchEnd < enqueuedRenderPassCount ) ? enqueuedRenderPass[batchEnd].CmdListIndex : enqueuedCmdListCount;
+        renderDevice->submitCommandLists( &cmdListsToSubmit[cmdListStart], ( cmdListEnd - cmdListStart ) );
+
+        const u64 signalValue = renderDevice->signalQueue( batchQueue );
+        for ( u32 i = batchStart; i < batchEnd; i++ ) {
+            enqueuedRenderPass[i].QueueSignalValue = signalValue;
+        }
+
+        if ( batchWritesUntrackedResources ) {
+            untrackedWritesSignalValue = signalValue;
+        }
+
+        lastSignalValues[batchQueue] = signalValue;
+        batchWritesUntrackedResources = false;
+        batchStart = batchEnd;
+    };
+
+    for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
+        const RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+        const eCommandQueue passQueue = ( execInfos.UseAsyncCompute ) ? COMMAND_QUEUE_COMPUTE : COMMAND_QUEUE_GRAPHICS;
+
+        if ( passQueue != batchQueue ) {
+            flushBatch( i );
+            batchQueue = passQueue;
+        }
+
+        // Dependencies on another queue have already been submitted (and signaled) since they are enqueued first.
+        u64 requiredSignalValues[COMMAND_QUEUE_COUNT] = {};
+        for ( u32 depIdx = 0; depIdx < execInfos.DependencyCount; depIdx++ ) {
+            const RenderPassExecutionInfos& dependency = enqueuedRenderPass[execInfos.Dependencies[depIdx]];
+            const eCommandQueue dependencyQueue = ( dependency.UseAsyncCompute ) ? COMMAND_QUEUE_COMPUTE : COMMAND_QUEUE_GRAPHICS;
+
+            if ( dependencyQueue != passQueue ) {
+                requiredSignalValues[dependencyQueue] = Max( requiredSignalValues[dependencyQueue], dependency.QueueSignalValue );
+            }
+        }
+
+        if ( passQueue == COMMAND_QUEUE_GRAPHICS ) {
+            requiredSignalValues[COMMAND_QUEUE_COMPUTE] = Max( requiredSignalValues[COMMAND_QUEUE_COMPUTE], untrackedWritesSignalValue );
+        }
+
+        for ( i32 queueIdx = 0; queueIdx < COMMAND_QUEUE_COUNT; queueIdx++ ) {
+            if ( requiredSignalValues[queueIdx] > waitedSignalValues[passQueue][queueIdx] ) {
+                flushBatch( i );
+
+                renderDevice->waitQueue( passQueue, static_cast< eCommandQueue >( queueIdx ), requiredSignalValues[queueIdx] );
+                waitedSignalValues[passQueue][queueIdx] = requiredSignalValues[queueIdx];
+            }
+        }
+
+        batchWritesUntrackedResources |= execInfos.WritesUntrackedResources;
+    }
+
+    flushBatch( enqueuedRenderPassCount );
+
+    // Presentation happens on the graphics queue; it must wait for the async compute work of the frame.
+    if ( lastSignalValues[COMMAND_QUEUE_COMPUTE] > waitedSignalValues[COMMAND_QUEUE_GRAPHICS][COMMAND_QUEUE_COMPUTE] ) {
+        renderDevice->waitQueue( COMMAND_QUEUE_GRAPHICS, COMMAND_QUEUE_COMPUTE, lastSignalValues[COMMAND_QUEUE_COMPUTE] );
+    }
 }
 
-void FrameGraphRenderThread::enqueueRenderPass( RenderPassExecutionInfos* renderpass )
+void FrameGraphScheduler::uploadVectorBuffer( CommandList& cmdList )
 {
-    renderpassToExecute[rpToExecuteCount++] = renderpass;
+    uploadDirtyBegin[uploadIndex] = pendingDirtyBegin;
+    uploadDirtyEnd[uploadIndex] = pendingDirtyEnd;
+    uploadIndex = ( uploadIndex + 1u ) % RenderDevice::PENDING_FRAME_COUNT;
+
+    if ( pendingDirtyBegin < pendingDirtyEnd ) {
+        vectorBufferUsedSize = Max( vectorBufferUsedSize, pendingDirtyEnd );
+    }
+
+    pendingDirtyBegin = ~0ull;
+    pendingDirtyEnd = 0ull;
+
+    // The copy of the buffer updated by this frame was last updated PENDING_FRAME_COUNT uploads ago.
+    size_t dirtyBegin = ~0ull;
+    size_t dirtyEnd = 0ull;
+    for ( i32 i = 0; i < RenderDevice::PENDING_FRAME_COUNT; i++ ) {
+        if ( uploadDirtyBegin[i] < uploadDirtyEnd[i] ) {
+            dirtyBegin = Min( dirtyBegin, uploadDirtyBegin[i] );
+            dirtyEnd = Max( dirtyEnd, uploadDirtyEnd[i] );
+        }
+    }
+
+    if ( dirtyBegin >= dirtyEnd ) {
+        return;
+    }
+
+    if ( isPartialBufferUpdateSupported ) {
+        cmdList.updateBuffer( *vectorDataBuffer, instanceBufferData + dirtyBegin, dirtyEnd - dirtyBegin, dirtyBegin );
+    } else {
+        // The whole buffer content is discarded on update; upload everything written so far.
+        cmdList.updateBuffer( *vectorDataBuffer, instanceBufferData, vectorBufferUsedSize );
+    }
 }
 
-void FrameGraphRenderThread::workerThread()
+void FrameGraphScheduler::jobDispatcherThread()
 {
     while ( 1 ) {
-        State workerState = FGRAPH_THREAD_STATE_HAS_JOB_TO_DO;
-        bool hasBeenNotified = currentState.compare_exchange_weak( workerState, FGRAPH_THREAD_STATE_HAS_JOB_TO_DO );
-        if ( !hasBeenNotified ) {
-            // Received shutdown signal; we can safely return.
-            if ( workerState == FGRAPH_THREAD_STATE_WAITING_SHUTDOWN ) {
+        {
+            std::unique_lock<std::mutex> lock( stateMutex );
+            stateCondition.wait( lock, [this]() {
+                const State state = currentState.load();
+                return state == SCHEDULER_STATE_HAS_JOB_TO_DO || state == SCHEDULER_STATE_WAITING_SHUTDOWN;
+            } );
+
+            if ( currentState.load() == SCHEDULER_STATE_WAITING_SHUTDOWN ) {
                 return;
             }
 
-            std::this_thread::yield();
-            continue;
+            currentState.store( SCHEDULER_STATE_WAITING_JOB_COMPLETION );
         }
 
-        DUSK_DEV_ASSERT( commandList, "FrameGraphRenderThread has no CommandList binded!" );
+        // Update shared resources at the beginning of the frame (e.g. PerViewBuffer).
+        // Flush the command list as soon as possible.
+        // We need to do the buffer upload in the dispatcher thread since we want to guarantee the constness of the view
+        // data for the frame being rendered.
+        CommandList& bufferUploadCmdList = renderDevice->allocateCopyCommandList();
+        bufferUploadCmdList.begin();
+        bufferUploadCmdList.updateBuffer( *perViewBuffer, &perViewBufferData, sizeof( PerViewBufferData ) );
+#if DUSKED
+        bufferUploadCmdList.updateBuffer( *materialEditorBuffer, &materialEdData, sizeof( MaterialEdData ) );
+#endif
+        uploadVectorBuffer( bufferUploadCmdList );
+        bufferUploadCmdList.end();
+        renderDevice->submitCommandList( bufferUploadCmdList );
+
+        // Synchronize the queues at the beginning of the frame: the upload must be visible to every queue and the
+        // previous frame must be completed on every queue (transient resources are reused from frame to frame).
+        u64 waitedSignalValues[COMMAND_QUEUE_COUNT][COMMAND_QUEUE_COUNT];
+        u64 frameStartSignalValues[COMMAND_QUEUE_COUNT];
+        for ( i32 queueIdx = 0; queueIdx < COMMAND_QUEUE_COUNT; queueIdx++ ) {
+            frameStartSignalValues[queueIdx] = renderDevice->signalQueue( static_cast< eCommandQueue >( queueIdx ) );
+        }
 
-        currentState.store( FGRAPH_THREAD_STATE_BUSY );
+        for ( i32 queueIdx = 0; queueIdx < COMMAND_QUEUE_COUNT; queueIdx++ ) {
+            for ( i32 waitedQueueIdx = 0; waitedQueueIdx < COMMAND_QUEUE_COUNT; waitedQueueIdx++ ) {
+                waitedSignalValues[queueIdx][waitedQueueIdx] = frameStartSignalValues[waitedQueueIdx];
 
-        // Execute enqueued RenderPass
-        const u32 jobCount = rpInExecutionCount.load();
-        rpInExecutionCount.store( 0u );
+                if ( queueIdx != waitedQueueIdx ) {
+                    renderDevice->waitQueue( static_cast< eCommandQueue >( queueIdx ), static_cast< eCommandQueue >( waitedQueueIdx ), frameStartSignalValues[waitedQueueIdx] );
+                }
+            }
+        }
 
-        for ( u32 jobIdx = 0; jobIdx < jobCount; jobIdx++ ) {
-            RenderPassExecutionInfos& renderPass = *renderpassToExecute[jobIdx];
+        // Each recording chunk of a RenderPass is recorded to its own CommandList. This way a chunk can be executed by
+        // any worker and CommandLists are submitted in enqueue order (which guarantees the GPU execution order
+        // whichever worker has recorded the chunk). CommandList allocation is not thread safe and is done here.
+        for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
+            RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+            const u32 chunkCount = execInfos.RenderPass->RecordingChunkCount;
+
+            execInfos.CmdLists = &cmdListsToSubmit[execInfos.CmdListIndex];
+
+            for ( u32 chunkIdx = 0; chunkIdx < chunkCount; chunkIdx++ ) {
+                RenderPassRecordingChunk& recordingChunk = execInfos.RecordingChunks[chunkIdx];
+
+                CommandList* cmdList = ( execInfos.UseAsyncCompute ) ? &renderDevice->allocateComputeCommandList() : &renderDevice->allocateGraphicsCommandList();
+                cmdList->begin();
+
+                execInfos.CmdLists[chunkIdx] = cmdList;
+                recordingChunk.RecordingJob = jobSystem->createJob( &FrameGraphScheduler::ExecuteRenderPassJob, &recordingChunk, execInfos.JobPriority );
+            }
 
-            // Wait for dependencies
-            if ( renderPass.DependencyCount != 0u ) {
-                RenderPassExecutionInfos::State dependencyState = RenderPassExecutionInfos::RP_EXECUTION_STATE_DONE;
-                do {
-                    dependencyState = RenderPassExecutionInfos::RP_EXECUTION_STATE_DONE;
-                    for ( u32 depIdx = 0; depIdx < renderPass.DependencyCount; depIdx++ ) {
-                        if ( !renderPass.Dependencies[depIdx]->compare_exchange_weak( dependencyState, RenderPassExecutionInfos::RP_EXECUTION_STATE_DONE ) ) {
-                            break;
-                        }
-                    }
-                } while ( dependencyState != RenderPassExecutionInfos::RP_EXECUTION_STATE_DONE );
+            if ( chunkCount == 1u ) {
+                execInfos.StartJob = execInfos.RecordingChunks[0].RecordingJob;
+                execInfos.CompletionJob = execInfos.StartJob;
+                continue;
             }
 
-            renderPass.ExecutionState.store( RenderPassExecutionInfos::RP_EXECUTION_STATE_IN_PROGRESS );
-            renderPass.RenderPass->Execute( commandList, pipelineStateCache );
-            renderPass.ExecutionState.store( RenderPassExecutionInfos::RP_EXECUTION_STATE_DONE );
+            // Split recordings are bracketed by a start and a completion job recording the RenderPass boundaries (this
+            // way the dependents of the RenderPass only have to wait for a single job).
+            execInfos.StartJob = jobSystem->createJob( &FrameGraphScheduler::StartRenderPassJob, &execInfos, execInfos.JobPriority );
+            execInfos.CompletionJob = jobSystem->createJob( &FrameGraphScheduler::CompleteRenderPassJob, &execInfos, execInfos.JobPriority );
+
+            for ( u32 chunkIdx = 0; chunkIdx < chunkCount; chunkIdx++ ) {
+                Job* recordingJob = execInfos.RecordingChunks[chunkIdx].RecordingJob;
+
+                jobSystem->addDependency( recordingJob, execInfos.StartJob );
+                jobSystem->addDependency( execInfos.CompletionJob, recordingJob );
+            }
+        }
+
+        // Build the dependency graph. A RenderPass becomes runnable once all its dependencies are completed.
+        for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
+            RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+
+            for ( u32 depIdx = 0; depIdx < execInfos.DependencyCount; depIdx++ ) {
+                jobSystem->addDependency( execInfos.StartJob, enqueuedRenderPass[execInfos.Dependencies[depIdx]].CompletionJob );
+            }
+        }
+
+        for ( u32 i = 0; i < enqueuedRenderPassCount; i++ ) {
+            RenderPassExecutionInfos& execInfos = enqueuedRenderPass[i];
+            const u32 chunkCount = execInfos.RenderPass->RecordingChunkCount;
+
+            if ( chunkCount > 1u ) {
+                jobSystem->submit( execInfos.StartJob, &frameJobCounter );
+                jobSystem->submit( execInfos.CompletionJob, &frameJobCounter );
+            }
+
+            for ( u32 chunkIdx = 0; chunkIdx < chunkCount; chunkIdx++ ) {
+                jobSystem->submit( execInfos.RecordingChunks[chunkIdx].RecordingJob, &frameJobCounter );
+            }
+        }
+
+        // Park until every RenderPass has been recorded.
+        jobSystem->wait( &frameJobCounter );
+
+        updateRenderPassTimings();
+        dispatchedRenderPassCount.store( 0u );
+
+        // Finish cmd list and submit to the Device.
+        for ( u32 i = 0; i < enqueuedCmdListCount; i++ ) {
+            cmdListsToSubmit[i]->end();
         }
 
-        currentState.store( FGRAPH_THREAD_STATE_READY );
+        submitCommandLists( waitedSignalValues );
+
+        enqueuedRenderPassCount = 0u;
+        enqueuedCmdListCount = 0u;
+        handleToEnqueuedIndexCount = 0u;
+
+        // Swap buffers
+        renderDevice->present();
+
+        setState( SCHEDULER_STATE_READY );
     }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 class FrameGraphResources;
+class FrameGraphScheduler;
 class GraphicsProfiler;
 class FrameGraphBuilder;
 class PipelineStateCache;
@@ -14,26 +15,27 @@ struct Buffer;
 struct Image;
 struct DrawCmd;
 
-#include <unordered_map>
 #include <atomic>
 #include <thread>
 #include <functional>
 #include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
 
+#include <Core/JobSystem.h>
 #include <Framework/Cameras/Camera.h>
 #include <Rendering/RenderDevice.h>
 #include <Rendering/CommandList.h>
 
+#include <Core/Allocators/ChunkedLinearAllocator.h>
+
 #include "DrawCommand.h"
+#include "FrameGraphArenaArray.h"
+#include "FrameGraphResourcePool.h"
 
 #include "ShaderHeaders/MaterialRuntimeEd.h"
 
-template<typename T>
-using dkPassSetup_t = std::function< void( FrameGraphBuilder&, T& ) >;
-
-template<typename T>
-using dkPassCallback_t = std::function< void( const T&, const FrameGraphResources*, CommandList*, PipelineStateCache* ) >;
-
 static constexpr dkStringHash_t PerViewBufferHashcode = DUSK_STRING_HASH( "PerViewBuffer" );
 static constexpr dkStringHash_t PerPassBufferHashcode = DUSK_STRING_HASH( "PerPassBuffer" );
 static constexpr dkStringHash_t PerWorldBufferHashcode = DUSK_STRING_HASH( "PerWorldBuffer" );
@@ -157,81 +159,195 @@ public:
     static const FGHandle Invalid;
 };
 
+// Chunk of a RenderPass recording. A RenderPass recording can be split into several chunks; each chunk is recorded to
+// its own CommandList (possibly by different workers) and the CommandLists are submitted in chunk order.
+struct FGRecordingChunk
+{
+    // Index of the chunk (in the [0..Count[ range).
+    u32     Index;
+
+    // Number of chunks the recording is split into.
+    u32     Count;
+
+    DUSK_INLINE bool isFirst() const { return Index == 0u; }
+    DUSK_INLINE bool isLast() const { return Index == ( Count - 1u ); }
+
+    // Return the sub range [begin..end[ of a range of 'elementCount' elements recorded by this chunk (the elements are
+    // evenly distributed between the chunks).
+    DUSK_INLINE void getRange( const u32 elementCount, u32& begin, u32& end ) const
+    {
+        begin = static_cast< u32 >( ( static_cast< u64 >( elementCount ) * Index ) / Count );
+        end = static_cast< u32 >( ( static_cast< u64 >( elementCount ) * ( Index + 1u ) ) / Count );
+    }
+};
+
 struct FrameGraphRenderPass
 {
     using Handle_t = u32;
 
-    // Callback with PassData binded.
-    using BindedCallback_t = std::function< void( CommandList*, PipelineStateCache* ) >;
+    // Function executing a binding (the execute callback of a RenderPass with a copy of its PassData) for a given
+    // recording chunk.
+    using ExecuteBinding_t = void( * )( const void* binding, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk );
 
-    // Buffer for PassData storage.
-    char                Data[1024];
+    // Function destroying a binding.
+    using DestroyBinding_t = void( * )( void* binding );
 
-    // Callback for binded lambda execution.
-    BindedCallback_t    Execute;
+    // Execute callback with PassData binded (allocated from the FrameGraph per-frame arena).
+    const void*                 Binding;
 
-    // Name of the FrameGraphRenderPass (for debug/profiling).
-    std::string         Name;
+    // Function executing the binding.
+    ExecuteBinding_t            ExecuteBinding;
+
+    // Resources of the FrameGraph owning this RenderPass.
+    const FrameGraphResources*  Resources;
+
+    // Hashcode of the FrameGraphRenderPass name.
+    dkStringHash_t              NameHashcode;
+
+#if DUSK_DEVBUILD
+    // Name of the FrameGraphRenderPass (for debug/profiling). The string must have a static lifetime.
+    const char*                 Name;
+#endif
 
     // FrameGraph internal handle (used for RenderPass culling).
-    Handle_t            Handle;
+    Handle_t                    Handle;
+
+    // Barriers flushed (as a single batch) before the execution of the RenderPass (allocated from the FrameGraph
+    // per-frame arena).
+    const ResourceBarrier*      PreBarriers;
+
+    // Barriers flushed after the execution of the RenderPass (begin of split barriers; allocated from the FrameGraph
+    // per-frame arena).
+    const ResourceBarrier*      PostBarriers;
+
+    u32                         PreBarrierCount;
+    u32                         PostBarrierCount;
+
+    // Number of chunks the recording of the RenderPass is split into (one if the RenderPass is recorded at once).
+    u32                         RecordingChunkCount;
+
+    // Execute a recording chunk of the RenderPass.
+    DUSK_INLINE void            Execute( CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk ) const { ExecuteBinding( Binding, Resources, cmdList, psoCache, chunk ); }
 };
 
-struct RenderPassExecutionInfos 
+// Execute callback of a RenderPass with a copy of the PassData (taken once the RenderPass setup is done).
+template<typename TPassData, typename TExecute>
+struct FGPassBinding
 {
-    // Maximum dependency count per RenderPass.
-    static constexpr i32 MAX_DEP_COUNT = 8;
+    TExecute    Callback;
+    TPassData   PassData;
 
-    enum State {
-        // Job has been added to the Scheduler and is waiting for execution.
-        RP_EXECUTION_STATE_WAITING = 0,
+    static void Execute( const void* binding, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk )
+    {
+        const FGPassBinding* passBinding = static_cast< const FGPassBinding* >( binding );
+        passBinding->Callback( passBinding->PassData, resources, cmdList, psoCache );
+    }
 
-        // Job is being executed by a FrameGraphRenderThread.
-        RP_EXECUTION_STATE_IN_PROGRESS,
+    static void Destroy( void* binding )
+    {
+        static_cast< FGPassBinding* >( binding )->~FGPassBinding();
+    }
+};
 
-        // Job is completed.
-        RP_EXECUTION_STATE_DONE,
-    };
-    using State_t = std::atomic<RenderPassExecutionInfos::State>;
+// Execute callback of a RenderPass whose recording is split into chunks (the chunk is forwarded to the callback).
+template<typename TPassData, typename TExecute>
+struct FGParallelPassBinding
+{
+    TExecute    Callback;
+    TPassData   PassData;
 
+    static void Execute( const void* binding, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk )
+    {
+        const FGParallelPassBinding* passBinding = static_cast< const FGParallelPassBinding* >( binding );
+        passBinding->Callback( passBinding->PassData, resources, cmdList, psoCache, chunk );
+    }
+
+    static void Destroy( void* binding )
+    {
+        static_cast< FGParallelPassBinding* >( binding )->~FGParallelPassBinding();
+    }
+};
+
+struct RenderPassExecutionInfos;
+
+// Recording chunk of an enqueued RenderPass (forwarded to the job recording the chunk).
+struct RenderPassRecordingChunk
+{
+    // RenderPass to record.
+    RenderPassExecutionInfos*           ExecInfos;
+
+    FGRecordingChunk                    Chunk;
+
+    // Job recording this chunk (allocated by the dispatcher thread).
+    Job*                                RecordingJob;
+
+    // CPU time spent recording this chunk (in ms).
+    f32                                 CpuTime;
+};
+
+struct RenderPassExecutionInfos 
+{
     // Constant reference to the RenderPass to execute (should be owned by the FrameGraph).
     const FrameGraphRenderPass*         RenderPass;
-    
-    // Current execution state (see RenderPassExecutionInfos::State).
-    State_t                             ExecutionState;
 
-    // Dependencies for this RenderPass (the FrameGraphRenderThread will spin until all the dependencies are done).
-    State_t*                            Dependencies[MAX_DEP_COUNT];
+    // Scheduler owning this instance (required to retrieve per-worker resources at execution time).
+    FrameGraphScheduler*                Scheduler;
+
+    // CommandLists the RenderPass is recorded to (one per recording chunk; points to the scheduler submission list and
+    // is set by the dispatcher thread).
+    CommandList**                       CmdLists;
+
+    // Recording chunks of the RenderPass (allocated from the FrameGraph per-frame arena).
+    RenderPassRecordingChunk*           RecordingChunks;
+
+    // Index of the first CommandList of the RenderPass in the scheduler submission list.
+    u32                                 CmdListIndex;
+
+    // Job started once the dependencies of this RenderPass are completed (allocated by the dispatcher thread).
+    Job*                                StartJob;
+
+    // Job completed once every recording chunk of this RenderPass is recorded (allocated by the dispatcher thread).
+    // StartJob and CompletionJob are the same job if the recording is not split.
+    Job*                                CompletionJob;
+
+    // Indexes (in the Scheduler enqueued RenderPass array) of the RenderPass this RenderPass depends on (allocated
+    // from the FrameGraph per-frame arena).
+    u32*                                Dependencies;
 
     // Dependencies count.
     u32                                 DependencyCount;
 
-private:
-    DUSK_INLINE void CopyDependencies( State_t* const * dependencies )
-    {
-        DUSK_RAISE_FATAL_ERROR( DependencyCount < MAX_DEP_COUNT, "DependencyCount: too many dependencies for this RenderPass!" );
-        memcpy( Dependencies, dependencies, sizeof( State_t* ) * DependencyCount );
-    }
+    // Value signaled on the RenderPass queue once its CommandList has completed (set at submission time).
+    u64                                 QueueSignalValue;
 
-public:
-    RenderPassExecutionInfos( const FrameGraphRenderPass* renderPass = nullptr, State_t** dependencies = nullptr, const u32 dependencyCount = 0u )
-        : RenderPass( renderPass )
-        , ExecutionState( RP_EXECUTION_STATE_WAITING )
-        , DependencyCount( dependencyCount )
-    {
-        CopyDependencies( dependencies );
-    }
+    // Estimated length (in ms) of the longest chain of RenderPasses starting with this RenderPass (computed from the
+    // timings of the previous frames).
+    f32                                 CriticalPathLength;
 
-    RenderPassExecutionInfos& operator = ( const RenderPassExecutionInfos& r )
-    {
-        RenderPass = r.RenderPass;
-        ExecutionState = RP_EXECUTION_STATE_WAITING;
-        DependencyCount = r.DependencyCount;
+    // Priority of the jobs recording this RenderPass (see Job::Priority).
+    u32                                 JobPriority;
 
-        CopyDependencies( static_cast<State_t* const *>( r.Dependencies ) );
-    
-        return *this;
-    }
+    // Rank of the RenderPass in the order RenderPasses have started recording.
+    u32                                 DispatchOrder;
+
+    // True if the RenderPass should be recorded to a compute CommandList.
+    bool                                UseAsyncCompute;
+
+    // True if the RenderPass writes resources which are not tracked by the FrameGraph (e.g. buffers owned by a
+    // RenderModule). The graphics queue waits for such async RenderPass before executing its next RenderPass.
+    bool                                WritesUntrackedResources;
+};
+
+// Transient memory statistics for the last compiled frame.
+struct FGTransientMemoryStats
+{
+    // Memory required by the transient resources if each resource had a dedicated allocation (in bytes).
+    u64 PeakMemoryWithoutAliasing;
+
+    // Memory used by the transient resources once resources with non-overlapping lifetimes share their allocation
+    // (in bytes). This is the sum of the sizes of the distinct pooled resources acquired for the frame (a pooled buffer
+    // can be larger than the buffer it holds).
+    u64 PeakMemoryWithAliasing;
 };
 
 #if DUSK_DEVBUILD
@@ -257,83 +373,31 @@ struct FGImageInfosEditor
 
     Image*      AllocatedImage;
 };
-#endif
 
-class FrameGraphRenderThread
+struct FGRenderPassScheduleInfosEditor
 {
-public:
-    enum State {
-        // Thread is ready and waiting for work.
-        FGRAPH_THREAD_STATE_READY = 0,
-
-        // Thread has received job to do.
-        FGRAPH_THREAD_STATE_HAS_JOB_TO_DO,
-
-        // Thread is executing one or several render passes.
-        FGRAPH_THREAD_STATE_BUSY,
+    // Name of the RenderPass.
+    const char* Name;
 
-        // Thread has received a shutdown signal (e.g. dtor has been called) and should shutdown as soon as possible.
-        FGRAPH_THREAD_STATE_WAITING_SHUTDOWN,
-    };
-
-    // Maximum number of RenderPassExecutionInfos per FrameGraphRenderThread (for a single frame).
-    static constexpr i32        MAX_RENDERPASS_COUNT = 32;
-
-public:
-                                FrameGraphRenderThread( BaseAllocator* allocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys );
-                                FrameGraphRenderThread( FrameGraphRenderThread& ) = default;
-                                FrameGraphRenderThread& operator = ( FrameGraphRenderThread& ) = default;
-                                ~FrameGraphRenderThread();
-
-    // (Thread Safe) Return true if the FrameGraphRenderThread is available; false otherwise.
-    bool                        isReady();
-
-    // Returns true if there is at least one enqueued RenderPass; false otherwise.
-    bool                        hasWorkTodo();
+    // CPU time spent recording the RenderPass (in ms).
+    f32         CpuTime;
 
-    // Execute enqueued RenderPassExecutionInfos with a CommandList allocated at higher level.
-    // FrameGraphRenderThread is not responsible for CommandList submit/begin/end calls.
-    void                        flush( CommandList* cmdList );
+    // GPU time used to seed the critical path of the RenderPass (in ms; zero if the RenderPass is not profiled).
+    f32         GpuTime;
 
-    // Enqueue a renderpass for execution
-    void                        enqueueRenderPass( RenderPassExecutionInfos* renderpass );
-
-private:
-    // Allocator owning the memory of this FrameGraphRenderThread instance.
-    BaseAllocator*              memoryAllocator;
-
-    // Thread handle for this FrameGraphRenderThread instance.
-    std::thread                 threadHandle;
-    
-    // Thread local PSO cache.
-    PipelineStateCache*         pipelineStateCache;
+    // Estimated length of the longest chain of RenderPasses starting with this RenderPass (in ms).
+    f32         CriticalPathLength;
 
-    // Binded CommandList for this thread (allocated by the Job Dispatcher thread).
-    CommandList*                commandList;
+    // Rank of the RenderPass in the order RenderPasses have started recording.
+    u32         DispatchOrder;
 
-    // The current state of this FrameGraphRenderThread instance (see FrameGraphRenderThread::State).
-    std::atomic<State>          currentState;
-
-    // RenderPasses to execute this frame.
-    RenderPassExecutionInfos*   renderpassToExecute[MAX_RENDERPASS_COUNT];
-
-    // RenderPasses to execute count.
-    std::atomic<u32>            rpToExecuteCount;
-
-    // RenderPasses to execute count.
-    std::atomic<u32>            rpInExecutionCount;
-
-private:
-    // Internal function executing incoming RenderPasses.
-    void                        workerThread();
+    // True if the RenderPass has been executed on the async compute queue.
+    bool        UseAsyncCompute;
 };
+#endif
 
 class FrameGraphScheduler     
 {
-public:
-    // Maximum number of FrameGraphRenderPass scheduled per frame.
-    static constexpr i32        MAX_RENDERPASS_PER_FRAME = 96;
-
 public:
     // Return a pointer to the PerViewBuffer persistent buffer.
     DUSK_INLINE Buffer*         getPerViewPersistentBuffer() const { return perViewBuffer; }
@@ -347,7 +411,7 @@ public:
     DUSK_INLINE Buffer*         getVectorDataBuffer() const { return vectorDataBuffer; }
 
 public:
-                                FrameGraphScheduler( BaseAllocator* allocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys );
+                                FrameGraphScheduler( BaseAllocator* allocator, BaseAllocator* passAllocator, RenderDevice* renderDevice, VirtualFileSystem* virtualFileSys, JobSystem* jobSystem );
                                 FrameGraphScheduler( FrameGraphScheduler& ) = default;
                                 FrameGraphScheduler& operator = ( FrameGraphScheduler& ) = default;
                                 ~FrameGraphScheduler();
@@ -356,18 +420,31 @@ public:
     void                        addRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies = nullptr, const u32 dependencyCount = 0u );
 
     // Enqueue an asynchronous FrameGraphRenderPass for execution (with or without dependencies). The Renderpass must run
-    // on a GPU compute pipeline.
-    void                        addAsyncComputeRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies = nullptr, const u32 dependencyCount = 0u );
+    // on a GPU compute pipeline. The compute queue only waits for the graphics RenderPasses it depends on (and vice versa).
+    void                        addAsyncComputeRenderPass( const FrameGraphRenderPass& renderPass, const FrameGraphRenderPass::Handle_t* dependencies = nullptr, const u32 dependencyCount = 0u, const bool writesUntrackedResources = false );
 
     void                        updateMaterialEdBuffer( const MaterialEdData* matEdData );
 
-    // Dispatch enqueued RenderPassExecutionInfos to FrameGraphRenderThreads. PerViewBufferData is a pointer to a persistent
+    // Dispatch enqueued RenderPassExecutionInfos to the JobSystem. PerViewBufferData is a pointer to a persistent
     // resource containing the data for the current view (can be nil if the scheduled render passes don't need those infos)
-    void                        dispatch( const PerViewBufferData* perViewData = nullptr, const void* vectorBufferData = nullptr );
+    // Instances in [dirtyInstanceBegin..dirtyInstanceEnd[ are copied from 'instances' and uploaded to the vector buffer.
+    void                        dispatch( const PerViewBufferData* perViewData = nullptr, const DrawCommandInfos::InstanceData* instances = nullptr, const u32 dirtyInstanceBegin = 0u, const u32 dirtyInstanceEnd = 0u );
 
     // (Thread Safe) Return true if the scheduler is ready to receive RenderPass; false otherwise.
     bool                        isReady();
 
+    // (Thread Safe) Park the calling thread until the scheduler is ready to receive RenderPass.
+    // This is a blocking call.
+    void                        waitUntilReady();
+
+    // Forget the storage allocated from the per-frame arena (must be called before the arena is cleared).
+    void                        releasePassStorage();
+
+#if DUSK_DEVBUILD
+    // (Thread Safe) Fill a given vector with the scheduling infos of the RenderPasses of the last completed frame.
+    void                        fillScheduleEditorInfos( std::vector<FGRenderPassScheduleInfosEditor>& scheduleInfos ) const;
+#endif
+
 private:
     enum State {
         // The scheduler is ready to receive RenderPass to execute.
@@ -383,14 +460,24 @@ private:
         SCHEDULER_STATE_WAITING_SHUTDOWN,
     };
 
-    static constexpr i32        RENDER_THREAD_COUNT = 3;
+    // Timings measured for a RenderPass.
+    struct PassTimings {
+        // CPU time spent recording the RenderPass (in ms; longest recording chunk if the recording is split).
+        f32 CpuTime;
+    };
 
 private:
     // Allocator owning this instance.
     BaseAllocator*              memoryAllocator;
 
-    // Thread executing RenderPasses from the FrameGraph.
-    FrameGraphRenderThread*     workers;
+    // Per-frame arena (owned by the FrameGraph).
+    BaseAllocator*              passAllocator;
+
+    // JobSystem executing the RenderPasses.
+    JobSystem*                  jobSystem;
+
+    // PSO cache shared by the workers recording RenderPasses.
+    PipelineStateCache*         pipelineStateCache;
 
     // Pointer to the active RenderDevice.
     RenderDevice*               renderDevice;
@@ -410,20 +497,49 @@ private:
     std::thread                 dispatcherThread;
 
     // Enqueued FrameGraphRenderPass waiting for execution.
-    RenderPassExecutionInfos    enqueuedRenderPass[MAX_RENDERPASS_PER_FRAME];
+    FGArenaArray<RenderPassExecutionInfos>  enqueuedRenderPass;
 
-    // Enqueued FrameGraphRenderPass waiting for asynchronous execution.
-    RenderPassExecutionInfos    enqueuedAsyncRenderPass[MAX_RENDERPASS_PER_FRAME];
+    // Index of the RenderPassExecutionInfos for a given FrameGraphRenderPass handle.
+    FGArenaArray<u32>           handleToEnqueuedIndex;
+
+    // CommandLists of the enqueued FrameGraphRenderPass (in enqueue order; recording chunks of a RenderPass are stored
+    // contiguously in chunk order).
+    FGArenaArray<CommandList*>  cmdListsToSubmit;
 
     // Enqueued FrameGraphRenderPass count.
     u32                         enqueuedRenderPassCount;
 
-    // Enqueued asynchronous FrameGraphRenderPass count.
-    u32                         enqueuedAsyncRenderPassCount;
+    // Number of CommandLists required by the enqueued FrameGraphRenderPass.
+    u32                         enqueuedCmdListCount;
+
+    // Number of entries of handleToEnqueuedIndex.
+    u32                         handleToEnqueuedIndexCount;
+
+    // Completion counter of the RenderPass jobs of the frame being recorded.
+    JobCounter                  frameJobCounter;
+
+    // Number of RenderPasses which have started recording for the frame being recorded.
+    std::atomic<u32>            dispatchedRenderPassCount;
+
+    // Timings of the previous frames (indexed by RenderPass name hashcode). Written by the dispatcher thread once the
+    // frame is recorded; read on dispatch (the scheduler is idle at this point).
+    std::unordered_map<dkStringHash_t, PassTimings> passTimings;
+
+#if DUSK_DEVBUILD
+    // Scheduling infos of the last completed frame.
+    std::vector<FGRenderPassScheduleInfosEditor>    scheduleInfos;
+
+    // Lock protecting scheduleInfos.
+    mutable std::mutex          scheduleInfosMutex;
+#endif
 
     // Scheduler current state.
     std::atomic<State>          currentState;
 
+    // Mutex/condition used to park threads waiting for a scheduler state change.
+    std::mutex                  stateMutex;
+    std::condition_variable     stateCondition;
+
     // PerViewBufferData for the current frame (this is a copy of FrameGraph data).
     PerViewBufferData           perViewBufferData;
 
@@ -432,15 +548,58 @@ private:
     MaterialEdData              materialEdData;
 #endif
 
+    // Copy of the instance data (matches the vector buffer content once the pending uploads are done).
 	u8*                         instanceBufferData;
 
+    // Range of the vector buffer (in bytes) modified since the last upload.
+    size_t                      pendingDirtyBegin;
+    size_t                      pendingDirtyEnd;
+
+    // Range of the vector buffer (in bytes) modified during the last uploads (each pending frame has its own copy of
+    // the buffer; a copy must receive the modifications done since its previous update).
+    size_t                      uploadDirtyBegin[RenderDevice::PENDING_FRAME_COUNT];
+    size_t                      uploadDirtyEnd[RenderDevice::PENDING_FRAME_COUNT];
+
+    // Size of the range of the vector buffer written so far (in bytes).
+    size_t                      vectorBufferUsedSize;
+
+    // Index of the next upload (modulo PENDING_FRAME_COUNT).
+    u32                         uploadIndex;
+
+    // True if the RenderDevice can update a sub range of a buffer.
+    bool                        isPartialBufferUpdateSupported;
+
 private:
     // Internal function for CommandList allocation/submit and RenderDevice present.
     void                        jobDispatcherThread();
 
-    // (Thread Safe) Wait until all the FrameGraphRenderThread are ready.
-    // This is a blocking call.
-    void                        spinUntilCompletion();
+    // Upload the modified ranges of the vector buffer (nothing is uploaded if the instance data is unchanged).
+    void                        uploadVectorBuffer( CommandList& cmdList );
+
+    // Update the scheduler state and wake up the threads waiting for a state change.
+    void                        setState( const State state );
+
+    // Compute the critical path length of the enqueued RenderPasses and the priority of their jobs.
+    void                        computeRenderPassPriorities();
+
+    // Store the timings of the enqueued RenderPasses (once their recording is completed).
+    void                        updateRenderPassTimings();
+
+    // Submit the CommandLists of the enqueued RenderPasses (inserting cross-queue waits from the RenderPasses
+    // dependencies). 'waitedSignalValues' holds the value each queue already waits for (per waited queue).
+    void                        submitCommandLists( u64 waitedSignalValues[COMMAND_QUEUE_COUNT][COMMAND_QUEUE_COUNT] );
+
+    // Job function recording a RenderPass recording chunk (userData is a RenderPassRecordingChunk).
+    static void                 ExecuteRenderPassJob( void* userData, const u32 workerIndex );
+
+    // Job function starting a RenderPass recording (userData is a RenderPassExecutionInfos). Records the pre-barriers
+    // to the first CommandList of the RenderPass; runs before any recording chunk if the recording is split.
+    static void                 StartRenderPassJob( void* userData, const u32 workerIndex );
+
+    // Job function completing a RenderPass recording (userData is a RenderPassExecutionInfos). Records the
+    // post-barriers to the last CommandList of the RenderPass; runs once every recording chunk is recorded if the
+    // recording is split.
+    static void                 CompleteRenderPassJob( void* userData, const u32 workerIndex );
 };
 
 class FrameGraphBuilder
@@ -466,9 +625,6 @@ public:
         REQUEST_PER_MIP_RESOURCE_VIEW = 1 << 5,
     };
 
-    // Maximum of RenderPass count (per frame).
-    static constexpr i32 MAX_RENDER_PASS_COUNT          = 64;
-
     // Maximum number of a single resource type allocable per frame.
     static constexpr i32 MAX_RESOURCES_HANDLE_PER_FRAME = 64;
 
@@ -489,22 +645,33 @@ public:
     // Set FrameGraph default super scaling scale (e.g. 2.0 mean that image resolution will use a scale factor of 2).
     DUSK_INLINE void setImageQuality( const float imageQuality = 1.0f ) { frameImageQuality = imageQuality; }
 
-    // Enable asynchronous compute for the renderpass being recorded (if the active graphics API supports it).
+    // Enable asynchronous compute for the renderpass being recorded (if the active graphics API supports it). Must be
+    // called before the renderpass declares its resources (the renderpass must only dispatch compute work).
     DUSK_INLINE void useAsyncCompute()                                  { passRefs[( renderPassCount - 1 )].useAsyncCompute = true; }
 
     // Declare the renderpass being recorded as uncullable. This is useful if nothing consumes this renderpass output.
     // (e.g. Present renderpass; IBL convolution renderpass; etc.)
     DUSK_INLINE void setUncullablePass()                                { passRefs[( renderPassCount - 1 )].isUncullable = true; }
 
+    // Return true if the last compilation reused the resource allocation plan of the previous frame.
+    DUSK_INLINE bool isCompiledGraphReused() const                      { return isLastCompilationCached; }
+
 public:
-                                    FrameGraphBuilder();
+                                    FrameGraphBuilder( BaseAllocator* passAllocator );
                                     FrameGraphBuilder( FrameGraphBuilder& ) = default;
                                     FrameGraphBuilder& operator = ( FrameGraphBuilder& ) = default;
                                     ~FrameGraphBuilder();
 
-    // Allocate resources requested by the render passes.
+    // Allocate resources requested by the render passes. If the structure of the graph (passes, resources descriptions
+    // and resources lifetimes) is identical to the previous compilation, the previous allocation plan is reused.
     void        compile( RenderDevice* renderDevice, FrameGraphResources& resources );
 
+    // Invalidate the allocation plan of the previous compilation (the next compilation will rebuild it).
+    void        invalidateCompiledGraph();
+
+    // Forget the storage allocated from the per-frame arena (must be called before the arena is cleared).
+    void        releasePassStorage();
+
     // Cull any render pass that has no impact on the final frame (unless the renderpass has been declared as uncullable).
     void        cullRenderPasses( FrameGraphRenderPass* renderPassList, i32& renderPassCount );
 
@@ -537,6 +704,19 @@ public:
     // Use readReadOnlyImage if you won't write to this buffer.
     FGHandle readBuffer( const FGHandle resourceHandle );
 
+    // Declare the state a transient image must be in when the renderpass is executed. The FrameGraph tracks the state
+    // of the image across the renderpasses and transitions it before the execution (the transitions of a renderpass
+    // are batched). The renderpass must not change the state of the image itself.
+    void     requireImageState( const FGHandle resourceHandle, const eResourceState state );
+
+    // Declare the state a transient buffer must be in when the renderpass is executed (see requireImageState).
+    void     requireBufferState( const FGHandle resourceHandle, const eResourceState state );
+
+    // Declare the state a persistent image (e.g. the swapchain buffer) must be in when the renderpass is executed (see
+    // requireImageState). The state of the image is unknown at the start of the frame; the first transition uses the
+    // state tracked by the backend.
+    void     requirePersistentImageState( const FGHandle resourceHandle, const eResourceState state );
+
     // Retrieve the swapchain buffer for the current frame being recorded.
     FGHandle retrieveSwapchainBuffer();
 
@@ -579,6 +759,9 @@ public:
 #endif
 
 private:
+    // Per-frame arena (owned by the FrameGraph).
+    BaseAllocator*  passAllocator;
+
     // FrameGraph active viewport.
     Viewport        frameViewport;
 
@@ -611,22 +794,63 @@ private:
     // Requested sampler count.
     u32             samplerStateCount;
 
-    // RenderPass infos. The infos struct is filled during the renderpass record.
+    // Structural hashcode of the last compiled graph.
+    u32             compiledGraphHashcode;
+
+    // Structural key of the graph recorded for the current frame (see buildStructuralKey; the storage is reused from
+    // frame to frame).
+    std::vector<u32> structuralKey;
+
+    // Structural key of the last compiled graph (compared on hashcode match to rule out collisions).
+    std::vector<u32> compiledStructuralKey;
+
+    // True if compiledGraphHashcode matches the allocation plan held by the graph resources.
+    bool            hasCompiledGraph;
+
+    // True if the last compilation reused the previous allocation plan.
+    bool            isLastCompilationCached;
+
+    // Access of a renderpass to a transient resource.
+    struct ResourceAccess {
+        u32             handle;
+
+        // State required by the renderpass (RESOURCE_STATE_UNKNOWN if the renderpass manages the state itself).
+        eResourceState  requiredState;
+        bool            isBuffer;
+        bool            isReadOnly;
+
+        // True if 'handle' is a persistent resource handle.
+        bool            isPersistent;
+    };
+
+    // RenderPass infos. The infos struct is filled during the renderpass record (the lists are allocated from the
+    // per-frame arena).
     struct PassInfos {
-        u32                             imageHandles[MAX_RESOURCES_HANDLE_PER_FRAME];
+        FGArenaArray<u32>               imageHandles;
         u32                             imageCount;
-        u32                             bufferHandles[MAX_RESOURCES_HANDLE_PER_FRAME];
+        FGArenaArray<u32>               bufferHandles;
         u32                             buffersCount;
         bool                            isUncullable;
         bool                            useAsyncCompute;
         u32                             dependencyCount;
-        FrameGraphRenderPass::Handle_t  dependencies[12];
-    } passRefs[MAX_RENDER_PASS_COUNT];
+        FGArenaArray<FrameGraphRenderPass::Handle_t>  dependencies;
+        FGArenaArray<ResourceAccess>    resourceAccesses;
+        u32                             resourceAccessCount;
+        FGArenaArray<ResourceBarrier>   preBarriers;
+        u32                             preBarrierCount;
+        FGArenaArray<ResourceBarrier>   postBarriers;
+        u32                             postBarrierCount;
+    };
+
+    FGArenaArray<PassInfos>             passRefs;
 
     struct ImageAllocInfo {
         u32             flags;
         u32             referenceCount;
         FrameGraphRenderPass::Handle_t    requestSource;
+        FrameGraphRenderPass::Handle_t    firstUsePass;
+        FrameGraphRenderPass::Handle_t    lastUsePass;
+        bool            isUsedByAsyncCompute;
         ImageDesc       description;
     } images[MAX_RESOURCES_HANDLE_PER_FRAME];
 
@@ -634,6 +858,9 @@ private:
         u32             shaderStageBinding;
         u32             referenceCount;
         FrameGraphRenderPass::Handle_t    requestSource;
+        FrameGraphRenderPass::Handle_t    firstUsePass;
+        FrameGraphRenderPass::Handle_t    lastUsePass;
+        bool            isUsedByAsyncCompute;
         BufferDesc      description;
     } buffers[MAX_RESOURCES_HANDLE_PER_FRAME];
 
@@ -645,7 +872,20 @@ private:
 
 private:
     void ApplyImageDescriptionFlags( ImageDesc& description, const u32 imageFlags ) const;
+
+    // Serialize the graph structure recorded for the current frame (passes, resource descriptions and resource
+    // lifetimes) into 'key'. Every field is written bit-exactly; per-frame data (pass data, camera constants, etc.) is
+    // not part of the key.
+    void buildStructuralKey( const bool useAsyncComputeQueue, std::vector<u32>& key ) const;
     void updatePassDependency( PassInfos& passInfos, const FrameGraphRenderPass::Handle_t dependency );
+
+    // Record the access of the renderpass being recorded to a transient resource. Accesses to the same resource are
+    // merged (a required state overrides an unknown state; a read/write access overrides a read-only access).
+    void recordResourceAccess( const u32 resourceHandle, const bool isBuffer, const bool isReadOnly, const eResourceState requiredState, const bool isPersistent = false );
+
+    // Compute the transitions required by the recorded renderpasses (from the state of the resources at the end of the
+    // previous renderpass using them). Must be called once the resources have been allocated.
+    void resolveResourceBarriers( const FrameGraphResources& resources, const bool useAsyncComputeQueue );
 };
 
 class FrameGraphResources
@@ -656,7 +896,6 @@ public:
         DrawCmd*                    endAddr;
 
         float                       vectorPerInstance;
-        float                       instanceDataStartOffset;
 
         DUSK_INLINE DrawCmd*        begin()         { return beginAddr; }
         DUSK_INLINE const DrawCmd*  begin() const   { return beginAddr; }
@@ -671,7 +910,17 @@ public:
                             ~FrameGraphResources();
 
     void                    releaseResources( RenderDevice* renderDevice );
-    void                    unacquireResources();
+
+    // Release the transient resources acquired for the previous frame and evict pooled resources which have not
+    // been requested for a while.
+    void                    unacquireResources( RenderDevice* renderDevice );
+
+    // Keep the transient resources acquired for the previous frame (the allocation plan is unchanged) and evict pooled
+    // resources which have not been requested for a while.
+    void                    reuseAcquiredResources( RenderDevice* renderDevice );
+
+    // Return the transient memory statistics for the last compiled frame.
+    const FGTransientMemoryStats& getTransientMemoryStats() const { return transientMemoryStats; }
 
     void                    setPipelineViewport( const Viewport& viewport, const ScissorRegion& scissor, const CameraData* cameraData );
     void                    setImageQuality( const f32 imageQuality = 1.0f );
@@ -681,7 +930,15 @@ public:
     void                    importPersistentBuffer( const dkStringHash_t resourceHashcode, Buffer* buffer );
 
     const DrawCmdBucket&    getDrawCmdBucket( const DrawCommandKey::Layer layer, const uint8_t viewportLayer ) const;
-    void*                   getVectorBufferData() const;
+
+    // Set the instance data referenced by the draw commands (see DrawCommandInfos::instanceDataOffset). The storage is
+    // owned by the caller and must persist across frames; only the instances in [dirtyInstanceBegin..dirtyInstanceEnd[
+    // have been modified since the previous submission.
+    void                    setInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd );
+
+    // Return the instance data (nullptr if no data has been submitted yet) and the range of instances modified since
+    // the previous flush (the range is reset).
+    const DrawCommandInfos::InstanceData* flushInstanceData( u32& dirtyInstanceBegin, u32& dirtyInstanceEnd );
 
     const CameraData*       getMainCamera() const;
     const Viewport*         getMainViewport() const;
@@ -701,8 +958,13 @@ public:
     Buffer*                 getPersistentBuffer( const FGHandle resourceHandle ) const;
     Image*                  getPersitentImage( const FGHandle resourceHandle ) const;
 
-    void                    allocateBuffer( RenderDevice* renderDevice, const FGHandle resourceHandle, const BufferDesc& description );
-    void                    allocateImage( RenderDevice* renderDevice, const FGHandle resourceHandle, const ImageDesc& description, const u32 flags );
+    // Allocate a transient buffer used from the pass 'firstUsePass' to the pass 'lastUsePass' (inclusive). The buffer
+    // might alias a pooled buffer whose last use happens before 'firstUsePass'.
+    void                    allocateBuffer( RenderDevice* renderDevice, const FGHandle resourceHandle, const BufferDesc& description, const u32 firstUsePass, const u32 lastUsePass );
+
+    // Allocate a transient image used from the pass 'firstUsePass' to the pass 'lastUsePass' (inclusive). The image
+    // might alias a pooled image whose last use happens before 'firstUsePass'.
+    void                    allocateImage( RenderDevice* renderDevice, const FGHandle resourceHandle, const ImageDesc& description, const u32 flags, const u32 firstUsePass, const u32 lastUsePass );
     void                    allocateSampler( RenderDevice* renderDevice, const FGHandle resourceHandle, const SamplerDesc& description );
 
     void                    bindPersistentBuffers( const FGHandle resourceHandle, const dkStringHash_t hashcode );
@@ -714,32 +976,37 @@ public:
 private:
     static constexpr i32    MAX_ALLOCABLE_RESOURCE_TYPE = 96;
 
+    // Maximum number of resources (per resource type) kept alive by the transient pools.
+    static constexpr i32    MAX_POOLED_RESOURCE_COUNT = 256;
+
+    // Maximum number of persistent resources (per resource type; must be a power of two).
+    static constexpr i32    MAX_PERSISTENT_RESOURCE_COUNT = 128;
+
 private:
     BaseAllocator*          memoryAllocator;
-    DrawCmdBucket           drawCmdBuckets[4][8];
+    DrawCmdBucket           drawCmdBuckets[DrawCommandKey::LAYER_COUNT][DrawCommandKey::VIEWPORT_LAYER_COUNT];
     CameraData              activeCameraData;
     Viewport                activeViewport;
     ScissorRegion           activeScissor;
     f32                     pipelineImageQuality;
     f32                     deltaTime;
-    i32                     allocatedBuffersCount;
-	i32                     allocatedImageCount;
-	i32                     allocatedSamplerCount;
     dkVec2u                 activeScreenSize;
 
-    void*                   instanceBufferData;
+    // Index of the frame being compiled (used to evict pooled resources).
+    u32                     frameIndex;
 
-    Buffer*                 allocatedBuffers[MAX_ALLOCABLE_RESOURCE_TYPE];
-    BufferDesc              buffersDesc[MAX_ALLOCABLE_RESOURCE_TYPE];
-    bool                    isBufferFree[MAX_ALLOCABLE_RESOURCE_TYPE];
+    // Instance data submitted by the caller (persistent).
+    const DrawCommandInfos::InstanceData* instanceData;
 
-    Image*                  allocatedImages[MAX_ALLOCABLE_RESOURCE_TYPE];
-    ImageDesc               imagesDesc[MAX_ALLOCABLE_RESOURCE_TYPE];
-    bool                    isImageFree[MAX_ALLOCABLE_RESOURCE_TYPE];
+    // Range of instances modified since the previous flush.
+    u32                     dirtyInstanceBegin;
+    u32                     dirtyInstanceEnd;
 
-	Sampler*                allocatedSamplers[MAX_ALLOCABLE_RESOURCE_TYPE];
-	SamplerDesc             samplerDesc[MAX_ALLOCABLE_RESOURCE_TYPE];
-	bool                    isSamplerFree[MAX_ALLOCABLE_RESOURCE_TYPE];
+    FGTransientMemoryStats  transientMemoryStats;
+
+    FGTransientResourcePool<Buffer, BufferDesc, MAX_POOLED_RESOURCE_COUNT>      bufferPool;
+    FGTransientResourcePool<Image, ImageDesc, MAX_POOLED_RESOURCE_COUNT>        imagePool;
+    FGTransientResourcePool<Sampler, SamplerDesc, MAX_POOLED_RESOURCE_COUNT>    samplerPool;
 
     Buffer*                 inUseBuffers[MAX_ALLOCABLE_RESOURCE_TYPE];
     Image*                  inUseImages[MAX_ALLOCABLE_RESOURCE_TYPE];
@@ -748,15 +1015,19 @@ private:
     Buffer*                 persistentBuffers[MAX_ALLOCABLE_RESOURCE_TYPE];
     Image*                  persistentImages[MAX_ALLOCABLE_RESOURCE_TYPE];
 
-    std::unordered_map<dkStringHash_t, Buffer*> persistentBuffersMap;
-    std::unordered_map<dkStringHash_t, Image*>  persistentImagesMap;
-
-private:
-    void                    updateVectorBuffer( const DrawCmd& cmd, size_t& instanceBufferOffset );
+    FGPersistentResourceTable<Buffer, MAX_PERSISTENT_RESOURCE_COUNT>    persistentBuffersTable;
+    FGPersistentResourceTable<Image, MAX_PERSISTENT_RESOURCE_COUNT>     persistentImagesTable;
 };
 
 class FrameGraph
 {
+public:
+    // Maximum number of chunks a RenderPass recording can be split into.
+    static constexpr u32 MAX_RECORDING_CHUNK_COUNT = 16u;
+
+    // Capacity of the instance vector buffer (in instances).
+    static constexpr u32 MAX_INSTANCE_COUNT = 32768u;
+
 public:
 #if DUSKED
     // Fill a given vector with debug infos for buffers allocated by this graph.
@@ -771,11 +1042,14 @@ public:
 
     // Return the name of the renderpass stored at a given index.
     // This function DOES NOT check the sanity of the index.
-    DUSK_INLINE const char* getRenderPassName( const i32 renderPassIndex ) const { return renderPasses[renderPassIndex].Name.c_str(); }
+    DUSK_INLINE const char* getRenderPassName( const i32 renderPassIndex ) const { return renderPasses[renderPassIndex].Name; }
+
+    // Fill a given vector with the scheduling infos (critical path and dispatch order) of the last completed frame.
+    DUSK_INLINE void retrieveScheduleEditorInfos( std::vector<FGRenderPassScheduleInfosEditor>& infos ) const { graphScheduler.fillScheduleEditorInfos( infos ); }
 #endif
 
 public:
-            FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevice, VirtualFileSystem* activeVfs );
+            FrameGraph( BaseAllocator* allocator, RenderDevice* activeRenderDevice, VirtualFileSystem* activeVfs, JobSystem* jobSystem );
             FrameGraph( FrameGraph& ) = default;
             FrameGraph& operator = ( FrameGraph& ) = default;
             ~FrameGraph();
@@ -783,13 +1057,17 @@ public:
     void    destroy( RenderDevice* renderDevice );
     void    enableProfiling( RenderDevice* renderDevice );
 
-    // Spin until the pending frame is completed.
+    // Park the calling thread until the pending frame is completed.
     // This is a blocking call.
     void    waitPendingFrameCompletion();
     
     void    execute( RenderDevice* renderDevice, const f32 deltaTime );
 
     void    submitAndDispatchDrawCmds( DrawCmd* drawCmds, const size_t drawCmdCount );
+
+    // Submit the instance data referenced by the draw commands (see FrameGraphResources::setInstanceData). Only the
+    // modified instances are uploaded to the GPU.
+    void    submitInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd );
     void    setViewport( const Viewport& viewport, const ScissorRegion& scissorRegion, const CameraData* camera = nullptr );
     void    setMSAAQuality( const uint32_t samplerCount = 1 );
     void    setScreenSize( const dkVec2u& screenSize );
@@ -830,38 +1108,29 @@ public:
     void    saveLastFrameSSRRenderTarget( FGHandle inputRenderTarget );
 
     // Add a renderpass to this framegraph. T should be the datatype used to forward resource handles (or misc data) from
-    // the setup step to the execution step.
-    template<typename T>
-    T& addRenderPass( const char* name, dkPassSetup_t<T> setup, dkPassCallback_t<T> execute ) {
-        static_assert( sizeof( T ) <= sizeof( FGHandle ) * 128, "Pass data 128 resource limit hit!" );
-        static_assert( sizeof( execute ) <= 1024 * 1024, "Execute lambda should be < 1ko!" );
-
-        DUSK_RAISE_FATAL_ERROR( renderPassCount < FrameGraphBuilder::MAX_RENDER_PASS_COUNT, "RenderPass limit reached!" );
-
-        FrameGraphRenderPass::Handle_t renderPassHandle = renderPassCount;
-        
-        FrameGraphRenderPass& renderPass = renderPasses[renderPassHandle];
-        memset( &renderPass, 0, sizeof( FrameGraphRenderPass ) );
-
-        renderPassCount++;
-
-        T& passData = *( T* )renderPass.Data;
+    // the setup step to the execution step. The name must have a static lifetime; nameHashcode is the hashcode of the
+    // name (DUSK_STRING_HASH; generated renderpasses declare it as <Pass>_NameHashcode).
+    // setup should be callable as void( FrameGraphBuilder&, T& ).
+    // execute should be callable as void( const T&, const FrameGraphResources*, CommandList*, PipelineStateCache* ).
+    template<typename T, typename TSetup, typename TExecute>
+    T& addRenderPass( const char* name, const dkStringHash_t nameHashcode, TSetup setup, TExecute execute ) {
+        return addRenderPassWithBinding<T, FGPassBinding<T, TExecute>>( name, nameHashcode, 1u, setup, execute );
+    }
 
-        graphBuilder.addRenderPass();
-        setup( graphBuilder, passData );
+    // Add a renderpass whose recording is split into 'chunkCount' chunks. Each chunk is recorded to its own CommandList
+    // (chunks can be recorded concurrently by different workers); CommandLists are submitted in chunk order. Barriers
+    // resolved by the graph are recorded at the beginning of the first chunk and at the end of the last chunk.
+    // execute should be callable as void( const T&, const FrameGraphResources*, CommandList*, PipelineStateCache*, const FGRecordingChunk& ).
+    template<typename T, typename TSetup, typename TExecute>
+    T& addParallelRenderPass( const char* name, const dkStringHash_t nameHashcode, const u32 chunkCount, TSetup setup, TExecute execute ) {
+        return addRenderPassWithBinding<T, FGParallelPassBinding<T, TExecute>>( name, nameHashcode, chunkCount, setup, execute );
+    }
 
-        renderPass.Execute = std::bind(
-            execute,
-            passData,
-            &graphResources,
-            std::placeholders::_1,
-            std::placeholders::_2
-        );
-        renderPass.Name = name;
-        renderPass.Handle = renderPassHandle;
+    // Return true if the last executed frame reused the compiled graph of the previous frame.
+    bool isCompiledGraphReused() const { return graphBuilder.isCompiledGraphReused(); }
 
-        return passData;
-    }
+    // Return the transient memory statistics (with and without resource aliasing) of the last executed frame.
+    const FGTransientMemoryStats& getTransientMemoryStats() const { return graphResources.getTransientMemoryStats(); }
 
 #if DUSK_DEVBUILD
     const char* getProfilingSummary() const;
@@ -880,12 +1149,28 @@ private:
     // The memory allocator owning this instance.
     BaseAllocator*                      memoryAllocator;
 
-    // Array of RenderPasses enqueued for this graph.
-    FrameGraphRenderPass                renderPasses[FrameGraphBuilder::MAX_RENDER_PASS_COUNT];
+    // Per-frame arena holding the RenderPasses storage (PassData, execute callbacks, dependency lists, etc.). The
+    // arena is cleared once the frame using this storage is completed.
+    ChunkedLinearAllocator              passAllocator;
+
+    // Array of RenderPasses enqueued for this graph (allocated from the per-frame arena).
+    FGArenaArray<FrameGraphRenderPass>  renderPasses;
 
     // Number of RenderPass stored in the renderPasses array.
     i32                                 renderPassCount;
 
+    // Destructor of a binding which is not trivially destructible.
+    struct BindingDestructor {
+        FrameGraphRenderPass::DestroyBinding_t  Destroy;
+        void*                                   Binding;
+    };
+
+    // Bindings to destroy once the frame is completed.
+    FGArenaArray<BindingDestructor>     bindingDestructors;
+
+    // Number of entries of bindingDestructors.
+    u32                                 bindingDestructorCount;
+
     // The active SSAA factor applied for this graph.
     f32                                 pipelineImageQuality;
 
@@ -935,6 +1220,42 @@ private:
     GraphicsProfiler*                   graphicsProfiler;
 
 private:
+    template<typename T, typename Binding_t, typename TSetup, typename TExecute>
+    T& addRenderPassWithBinding( const char* name, const dkStringHash_t nameHashcode, const u32 chunkCount, TSetup& setup, TExecute& execute ) {
+        const FrameGraphRenderPass::Handle_t renderPassHandle = allocateRenderPass( name, nameHashcode );
+
+        // PassData is zero-initialized and lives until the frame completion.
+        T& passData = *static_cast< T* >( allocatePassMemory( sizeof( T ), alignof( T ) ) );
+
+        graphBuilder.addRenderPass();
+        setup( graphBuilder, passData );
+
+        Binding_t* binding = new ( allocatePassMemory( sizeof( Binding_t ), alignof( Binding_t ) ) ) Binding_t{ execute, passData };
+
+        if ( !std::is_trivially_destructible<Binding_t>::value ) {
+            registerBindingDestructor( &Binding_t::Destroy, binding );
+        }
+
+        FrameGraphRenderPass& renderPass = renderPasses[renderPassHandle];
+        renderPass.Binding = binding;
+        renderPass.ExecuteBinding = &Binding_t::Execute;
+        renderPass.RecordingChunkCount = Min( Max( chunkCount, 1u ), MAX_RECORDING_CHUNK_COUNT );
+
+        return passData;
+    }
+
+    // Allocate a RenderPass from the per-frame arena and return its handle.
+    FrameGraphRenderPass::Handle_t      allocateRenderPass( const char* name, const dkStringHash_t nameHashcode );
+
+    // Allocate zero-initialized memory from the per-frame arena.
+    void*                               allocatePassMemory( const size_t size, const size_t alignment );
+
+    // Register a binding destructor (called once the frame is completed).
+    void                                registerBindingDestructor( FrameGraphRenderPass::DestroyBinding_t destroy, void* binding );
+
+    // Destroy the bindings and clear the per-frame arena. The scheduler must not be executing RenderPasses.
+    void                                releasePassStorage();
+
     // Destroy and re-create persistent resources for this graph. Can be used when the application context has changed
     // (e.g. screen resize, graphics quality changes, etc.).
     void                                recreatePersistentResources( RenderDevice* renderDevice );
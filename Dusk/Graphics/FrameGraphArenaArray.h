@@ -0,0 +1,78 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <type_traits>
+
+// Array whose storage is allocated from a per-frame arena. Growing the array allocates a bigger storage from the arena
+// (the previous storage is reclaimed once the arena is cleared). The capacity is kept across resets so that the next
+// frame allocates its storage at once.
+template<typename T>
+class FGArenaArray
+{
+public:
+    DUSK_INLINE T&          operator [] ( const u32 index )         { return elements[index]; }
+    DUSK_INLINE const T&    operator [] ( const u32 index ) const   { return elements[index]; }
+
+    // Return a pointer to the first element of the array (null if the storage has not been allocated yet).
+    DUSK_INLINE T*          data() const                            { return elements; }
+
+    // Return the number of elements the array can hold without reallocation.
+    DUSK_INLINE u32         getCapacity() const                     { return capacity; }
+
+public:
+    FGArenaArray( const u32 initialCapacity = 0u )
+        : elements( nullptr )
+        , capacity( initialCapacity )
+    {
+
+    }
+
+    // Make sure the array can hold 'requiredCount' elements. The first 'usedCount' elements are preserved if the
+    // storage has to be reallocated.
+    void reserve( BaseAllocator* arena, const u32 requiredCount, const u32 usedCount )
+    {
+        static_assert( std::is_trivially_copyable<T>::value, "T must be trivially copyable!" );
+
+        if ( elements != nullptr && requiredCount <= capacity ) {
+            return;
+        }
+
+        u32 newCapacity = ( elements == nullptr ) ? Max( capacity, 1u ) : ( capacity * 2u );
+        while ( newCapacity < requiredCount ) {
+            newCapacity *= 2u;
+        }
+
+        T* newElements = static_cast< T* >( arena->allocate( sizeof( T ) * newCapacity, alignof( T ) ) );
+        DUSK_RAISE_FATAL_ERROR( newElements != nullptr, "Arena allocation failed!" );
+
+        if ( elements != nullptr && usedCount > 0u ) {
+            memcpy( newElements, elements, sizeof( T ) * usedCount );
+        }
+
+        elements = newElements;
+        capacity = newCapacity;
+    }
+
+    // Append an element to the array ('count' is the number of elements stored in the array; it is incremented).
+    void pushBack( BaseAllocator* arena, u32& count, const T& element )
+    {
+        reserve( arena, count + 1u, count );
+        elements[count++] = element;
+    }
+
+    // Forget the storage (must be called when the arena owning the storage is cleared).
+    void reset()
+    {
+        elements = nullptr;
+    }
+
+private:
+    // Array storage (owned by the arena).
+    T*  elements;
+
+    // Number of elements the storage can hold.
+    u32 capacity;
+};
@@ -0,0 +1,307 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+// Pool of transient GPU resources keyed by the hash of the description fields which must match for two resources to be
+// interchangeable. Entries sharing the same bucket are linked
+// together in two intrusive lists: a free list (entries which have not been acquired for the frame being compiled) and
+// an in-use list (entries acquired for the frame being compiled; those can still be aliased once their lifetime ends).
+// The pool does not create nor destroy resources; the owner is responsible for the resource lifecycle.
+template<typename TResource, typename TDescription, i32 Capacity>
+class FGTransientResourcePool
+{
+public:
+    // Number of buckets (must be a power of two).
+    static constexpr u32    BUCKET_COUNT = 64u;
+
+    // Index returned when no entry is available.
+    static constexpr i32    INVALID_ENTRY = -1;
+
+public:
+    // Return the number of entries currently stored in the pool.
+    DUSK_INLINE i32         getEntryCount() const { return entryCount; }
+
+    // Return the resource stored in a given entry.
+    DUSK_INLINE TResource*  getResource( const i32 entryIndex ) const { return entries[entryIndex].Resource; }
+
+    // Return the description of the resource stored in a given entry (which might differ from the description used to
+    // acquire the entry).
+    DUSK_INLINE const TDescription& getDescription( const i32 entryIndex ) const { return entries[entryIndex].Description; }
+
+public:
+    FGTransientResourcePool()
+        : unusedEntryList( INVALID_ENTRY )
+        , entryCount( 0 )
+    {
+        static_assert( ( BUCKET_COUNT & ( BUCKET_COUNT - 1u ) ) == 0u, "BUCKET_COUNT must be a power of two!" );
+
+        for ( u32 i = 0u; i < BUCKET_COUNT; i++ ) {
+            bucketFreeLists[i] = INVALID_ENTRY;
+            bucketInUseLists[i] = INVALID_ENTRY;
+        }
+
+        for ( i32 i = Capacity - 1; i >= 0; i-- ) {
+            entries[i].Resource = nullptr;
+            entries[i].Next = unusedEntryList;
+            unusedEntryList = i;
+        }
+    }
+
+    // Look for a pooled resource compatible with a given description. 'hashcode' is the hash of the description fields
+    // which must match exactly (entries are bucketed by this hashcode); 'getReuseCost( pooledDesc, requestedDesc )'
+    // returns the cost of reusing a pooled resource for the requested description (e.g. the wasted memory) or a negative
+    // value if the pooled resource can't hold the requested one. The compatible entry with the lowest cost is returned.
+    // If 'allowAliasing' is true, an entry already acquired for this frame can be returned if its last use happens
+    // before 'firstUsePass' ('isAliased' is then set to true); aliasing is preferred over acquiring a free entry.
+    // Return INVALID_ENTRY if no entry is available (the caller should create a resource and insert it).
+    template<typename TReuseCost>
+    i32 acquire( const u32 hashcode, const TDescription& description, const i32 firstUsePass, const i32 lastUsePass, const u32 frameIndex, const bool allowAliasing, bool& isAliased, TReuseCost getReuseCost )
+    {
+        const u32 bucketIndex = ( hashcode & ( BUCKET_COUNT - 1u ) );
+
+        isAliased = false;
+
+        if ( allowAliasing ) {
+            i32 bestEntryIndex = INVALID_ENTRY;
+            i64 bestCost = 0;
+            for ( i32 entryIndex = bucketInUseLists[bucketIndex]; entryIndex != INVALID_ENTRY; entryIndex = entries[entryIndex].Next ) {
+                const Entry& entry = entries[entryIndex];
+                if ( entry.Hashcode != hashcode || entry.LastUsePass >= firstUsePass ) {
+                    continue;
+                }
+
+                const i64 cost = getReuseCost( entry.Description, description );
+                if ( cost >= 0 && ( bestEntryIndex == INVALID_ENTRY || cost < bestCost ) ) {
+                    bestEntryIndex = entryIndex;
+                    bestCost = cost;
+                }
+            }
+
+            if ( bestEntryIndex != INVALID_ENTRY ) {
+                Entry& entry = entries[bestEntryIndex];
+                entry.LastUsePass = lastUsePass;
+                entry.LastRequestFrame = frameIndex;
+                isAliased = true;
+                return bestEntryIndex;
+            }
+        }
+
+        i32* bestPreviousLink = nullptr;
+        i64 bestCost = 0;
+
+        i32* previousLink = &bucketFreeLists[bucketIndex];
+        for ( i32 entryIndex = *previousLink; entryIndex != INVALID_ENTRY; entryIndex = *previousLink ) {
+            const Entry& entry = entries[entryIndex];
+            if ( entry.Hashcode == hashcode ) {
+                const i64 cost = getReuseCost( entry.Description, description );
+                if ( cost >= 0 && ( bestPreviousLink == nullptr || cost < bestCost ) ) {
+                    bestPreviousLink = previousLink;
+                    bestCost = cost;
+                }
+            }
+
+            previousLink = &entries[entryIndex].Next;
+        }
+
+        if ( bestPreviousLink == nullptr ) {
+            return INVALID_ENTRY;
+        }
+
+        // Move the entry from the bucket free list to the bucket in-use list.
+        const i32 entryIndex = *bestPreviousLink;
+        Entry& entry = entries[entryIndex];
+        *bestPreviousLink = entry.Next;
+        entry.Next = bucketInUseLists[bucketIndex];
+        bucketInUseLists[bucketIndex] = entryIndex;
+
+        entry.LastUsePass = lastUsePass;
+        entry.LastRequestFrame = frameIndex;
+        return entryIndex;
+    }
+
+    // Insert a newly created resource in the pool. The entry is marked as acquired for the frame being compiled.
+    i32 insert( const u32 hashcode, const TDescription& description, TResource* resource, const i32 lastUsePass, const u32 frameIndex )
+    {
+        DUSK_RAISE_FATAL_ERROR( unusedEntryList != INVALID_ENTRY, "Transient resource pool is full!" );
+
+        const u32 bucketIndex = ( hashcode & ( BUCKET_COUNT - 1u ) );
+
+        const i32 entryIndex = unusedEntryList;
+        Entry& entry = entries[entryIndex];
+        unusedEntryList = entry.Next;
+
+        entry.Resource = resource;
+        entry.Description = description;
+        entry.Hashcode = hashcode;
+        entry.LastUsePass = lastUsePass;
+        entry.LastRequestFrame = frameIndex;
+        entry.Next = bucketInUseLists[bucketIndex];
+        bucketInUseLists[bucketIndex] = entryIndex;
+
+        entryCount++;
+
+        return entryIndex;
+    }
+
+    // Move every acquired entry back to the free lists. 'frameIndex' is the index of the last frame the entries have
+    // been used by.
+    void releaseAll( const u32 frameIndex )
+    {
+        for ( u32 bucketIndex = 0u; bucketIndex < BUCKET_COUNT; bucketIndex++ ) {
+            i32 entryIndex = bucketInUseLists[bucketIndex];
+            while ( entryIndex != INVALID_ENTRY ) {
+                Entry& entry = entries[entryIndex];
+                const i32 nextEntryIndex = entry.Next;
+
+                entry.LastRequestFrame = frameIndex;
+                entry.Next = bucketFreeLists[bucketIndex];
+                bucketFreeLists[bucketIndex] = entryIndex;
+
+                entryIndex = nextEntryIndex;
+            }
+
+            bucketInUseLists[bucketIndex] = INVALID_ENTRY;
+        }
+    }
+
+    // Remove free entries which have not been requested during the last 'maxUnusedFrameCount' frames. 'evictCallback'
+    // is called for each evicted resource (and should destroy it).
+    template<typename TCallback>
+    void evict( const u32 frameIndex, const u32 maxUnusedFrameCount, TCallback evictCallback )
+    {
+        for ( u32 bucketIndex = 0u; bucketIndex < BUCKET_COUNT; bucketIndex++ ) {
+            i32* previousLink = &bucketFreeLists[bucketIndex];
+            for ( i32 entryIndex = *previousLink; entryIndex != INVALID_ENTRY; entryIndex = *previousLink ) {
+                Entry& entry = entries[entryIndex];
+                if ( ( frameIndex - entry.LastRequestFrame ) <= maxUnusedFrameCount ) {
+                    previousLink = &entry.Next;
+                    continue;
+                }
+
+                evictCallback( entry.Resource );
+
+                *previousLink = entry.Next;
+
+                entry.Resource = nullptr;
+                entry.Next = unusedEntryList;
+                unusedEntryList = entryIndex;
+
+                entryCount--;
+            }
+        }
+    }
+
+    // Call 'callback' for every resource stored in the pool (acquired or not).
+    template<typename TCallback>
+    void forEach( TCallback callback ) const
+    {
+        for ( i32 i = 0; i < Capacity; i++ ) {
+            if ( entries[i].Resource != nullptr ) {
+                callback( entries[i].Resource );
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        // Pooled resource (null if the entry is unused).
+        TResource*      Resource;
+
+        // Description of the pooled resource.
+        TDescription    Description;
+
+        // Hashcode of the description (see acquire).
+        u32             Hashcode;
+
+        // Index of the last pass using the resource for the frame being compiled.
+        i32             LastUsePass;
+
+        // Index of the last frame which requested this resource (used for eviction).
+        u32             LastRequestFrame;
+
+        // Index of the next entry in the list owning this entry.
+        i32             Next;
+    };
+
+private:
+    // Pool entries.
+    Entry               entries[Capacity];
+
+    // Per-bucket head of the list of entries available for the frame being compiled.
+    i32                 bucketFreeLists[BUCKET_COUNT];
+
+    // Per-bucket head of the list of entries acquired for the frame being compiled.
+    i32                 bucketInUseLists[BUCKET_COUNT];
+
+    // Head of the list of unused entries.
+    i32                 unusedEntryList;
+
+    // Number of entries holding a resource.
+    i32                 entryCount;
+};
+
+// Fixed capacity open addressing table mapping a resource hashcode to a persistent resource.
+template<typename TResource, i32 Capacity>
+class FGPersistentResourceTable
+{
+public:
+    FGPersistentResourceTable()
+    {
+        static_assert( ( Capacity & ( Capacity - 1 ) ) == 0, "Capacity must be a power of two!" );
+
+        memset( keys, 0, sizeof( dkStringHash_t ) * Capacity );
+        memset( values, 0, sizeof( TResource* ) * Capacity );
+        memset( isSlotUsed, 0, sizeof( bool ) * Capacity );
+    }
+
+    // Insert or update the resource associated to a given hashcode.
+    void insert( const dkStringHash_t hashcode, TResource* resource )
+    {
+        const i32 slotIndex = findSlot( hashcode );
+        DUSK_RAISE_FATAL_ERROR( slotIndex != -1, "Persistent resource table is full!" );
+
+        keys[slotIndex] = hashcode;
+        values[slotIndex] = resource;
+        isSlotUsed[slotIndex] = true;
+    }
+
+    // Return true if a resource has been inserted for a given hashcode.
+    bool contains( const dkStringHash_t hashcode ) const
+    {
+        const i32 slotIndex = findSlot( hashcode );
+        return ( slotIndex != -1 && isSlotUsed[slotIndex] );
+    }
+
+    // Return the resource associated to a given hashcode (or null if the hashcode is unknown).
+    TResource* find( const dkStringHash_t hashcode ) const
+    {
+        const i32 slotIndex = findSlot( hashcode );
+        return ( slotIndex != -1 && isSlotUsed[slotIndex] ) ? values[slotIndex] : nullptr;
+    }
+
+private:
+    // Hashcode stored in each slot.
+    dkStringHash_t  keys[Capacity];
+
+    // Resource stored in each slot.
+    TResource*      values[Capacity];
+
+    // True if the slot holds a resource.
+    bool            isSlotUsed[Capacity];
+
+private:
+    // Return the slot holding 'hashcode' or the first empty slot of its probe sequence (-1 if the table is full).
+    i32 findSlot( const dkStringHash_t hashcode ) const
+    {
+        for ( i32 probeIdx = 0; probeIdx < Capacity; probeIdx++ ) {
+            const i32 slotIndex = static_cast< i32 >( ( hashcode + probeIdx ) & ( Capacity - 1 ) );
+            if ( !isSlotUsed[slotIndex] || keys[slotIndex] == hashcode ) {
+                return slotIndex;
+            }
+        }
+
+        return -1;
+    }
+};
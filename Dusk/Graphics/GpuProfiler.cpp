@@ -7,6 +7,13 @@
 
 #include "Rendering/CommandList.h"
 
+// Return the index of the section stack of a command list (the compute command lists are stored after the graphics ones).
+static DUSK_INLINE i32 GetSectionStackIndex( const CommandList& cmdList )
+{
+    const i32 poolOffset = ( cmdList.getCommandListType() == CommandList::Type::COMPUTE ) ? RenderDevice::CMD_LIST_POOL_CAPACITY : 0;
+    return poolOffset + cmdList.getCommandListPooledIndex();
+}
+
 GpuProfiler::GpuProfiler()
 	: timestampQueryPool( nullptr )
 	, internalIndex( -1 )
@@ -80,6 +87,7 @@ void GpuProfiler::update( RenderDevice& renderDevice )
 
         section.Maximum = Max( section.Maximum, sectionTiming );
         section.Minimum = Min( section.Minimum, sectionTiming );
+        section.Latest = sectionTiming;
 
         timestampIdx += 2;
     }
@@ -100,7 +108,7 @@ void GpuProfiler::beginSection( CommandList& cmdList, const std::string& section
     section.BeginQueryHandle[internalIndex] = cmdList.allocateQuery( *timestampQueryPool );
     section.EndQueryHandle[internalIndex] = cmdList.allocateQuery( *timestampQueryPool );
 
-	std::stack<dkStringHash_t>& sectionsStack = sectionsStacks[cmdList.getCommandListPooledIndex()];
+	std::stack<dkStringHash_t>& sectionsStack = sectionsStacks[GetSectionStackIndex( cmdList )];
     section.Parent = ( !sectionsStack.empty() ) ? &profiledSections[sectionsStack.top()] : nullptr;
     
     sectionsStack.push( sectionHashcode );
@@ -110,7 +118,7 @@ void GpuProfiler::beginSection( CommandList& cmdList, const std::string& section
 
 void GpuProfiler::endSection( CommandList& cmdList )
 {
-    std::stack<dkStringHash_t>& sectionsStack = sectionsStacks[cmdList.getCommandListPooledIndex()];
+    std::stack<dkStringHash_t>& sectionsStack = sectionsStacks[GetSectionStackIndex( cmdList )];
     DUSK_ASSERT( !sectionsStack.empty(), "There is no active profiling section..." );
 
     if ( sectionsStack.empty() ) {
@@ -133,6 +141,12 @@ void GpuProfiler::endSection( CommandList& cmdList )
     sectionsStack.pop();
 }
 
+f32 GpuProfiler::getLatestSectionTiming( const dkStringHash_t sectionHashcode ) const
+{
+    auto it = profiledSections.find( sectionHashcode );
+    return ( it != profiledSections.end() ) ? it->second.Latest : 0.0f;
+}
+
 void GpuProfiler::getSectionsResult( RenderDevice& renderDevice, CommandList& cmdList )
 {
 }
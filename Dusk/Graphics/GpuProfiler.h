@@ -40,6 +40,9 @@ public:
         // Min timing for this section.
         f32     Minimum;
 
+        // Timing of the latest sample retrieved for this section.
+        f32     Latest;
+
         // Pointer to the parent for hierarchal profiling. Null if this section is orphan.
         SectionData* Parent;
 
@@ -52,6 +55,7 @@ public:
             , CallCount( 0ull )
             , Maximum( -std::numeric_limits<f32>::max() )
             , Minimum( +std::numeric_limits<f32>::max() )
+            , Latest( 0.0f )
             , Parent( nullptr )
             , Name( "" )
         {
@@ -87,6 +91,10 @@ public:
     // End the latest section pushed to the session stack.
     void            endSection( CommandList& cmdList );
 
+    // Return the latest timing (in ms) retrieved for a given section (or zero if the section has not been profiled
+    // yet).
+    f32             getLatestSectionTiming( const dkStringHash_t sectionHashcode ) const;
+
 private:
     // The maximum number of profiling section (per frame).
 	static constexpr i32 MAX_PROFILE_SECTION_COUNT = 128;
@@ -105,8 +113,9 @@ private:
 
     // Stack keeping track of the active sections being recorded.
     // We allocate one stack per command list to guarantee thread safeness
-    // and avoid heavy synchronizations.
-    std::stack<dkStringHash_t> sectionsStacks[RenderDevice::CMD_LIST_POOL_CAPACITY];
+    // and avoid heavy synchronizations (graphics and compute command lists
+    // are pooled separately; see GetSectionStackIndex).
+    std::stack<dkStringHash_t> sectionsStacks[RenderDevice::CMD_LIST_POOL_CAPACITY * 2];
 
     u32 perInternalFrameSectionCount[RESULT_RETRIVAL_FRAME_LAG];
 
@@ -55,8 +55,11 @@ LightGrid::Data LightGrid::updateClusters( FrameGraph& frameGraph )
         FGHandle ItemList;
     };
 
+    constexpr const char* PassName = "PerSceneBufferData Update";
+    constexpr dkStringHash_t PassNameHashcode = DUSK_STRING_HASH( PassName );
+
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        "PerSceneBufferData Update",
+        PassName, PassNameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             BufferDesc sceneClustersBufferDesc;
             sceneClustersBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
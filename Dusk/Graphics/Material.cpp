@@ -181,6 +181,7 @@ void Material::bindForScenario( const RenderScenario scenario, CommandList* cmdL
         DefaultPipelineState.InputLayout.Entry[0] = { 0, VIEW_FORMAT_R32G32B32_FLOAT, 0, 0, 0, false, "POSITION" };
         DefaultPipelineState.InputLayout.Entry[1] = { 0, VIEW_FORMAT_R32G32B32_FLOAT, 0, 1, 0, true, "NORMAL" };
         DefaultPipelineState.InputLayout.Entry[2] = { 0, VIEW_FORMAT_R32G32_FLOAT, 0, 2, 0, true, "TEXCOORD" };
+        DefaultPipelineState.InputLayout.Entry[3] = { 0, VIEW_FORMAT_R32_UINT, 1, 3, 0, false, "BLENDINDICES" };
         DefaultPipelineState.depthClearValue = 0.0f;
 
 		DefaultPipelineState.addStaticSampler( RenderingHelpers::S_BilinearWrap );
@@ -212,6 +213,7 @@ void Material::bindForScenario( const RenderScenario scenario, CommandList* cmdL
 		DefaultPipelineState.InputLayout.Entry[0] = { 0, VIEW_FORMAT_R32G32B32_FLOAT, 0, 0, 0, false, "POSITION" };
 		DefaultPipelineState.InputLayout.Entry[1] = { 0, VIEW_FORMAT_R32G32B32_FLOAT, 0, 1, 0, true, "NORMAL" };
 		DefaultPipelineState.InputLayout.Entry[2] = { 0, VIEW_FORMAT_R32G32_FLOAT, 0, 2, 0, true, "TEXCOORD" };
+		DefaultPipelineState.InputLayout.Entry[3] = { 0, VIEW_FORMAT_R32_UINT, 1, 3, 0, false, "BLENDINDICES" };
         DefaultPipelineState.depthClearValue = 0.0f;
 
         // Retrieve the appropriate shader binding for the given scenario.
@@ -306,6 +308,11 @@ bool Material::isOpaque() const
         && !isWireframe;
 }
 
+bool Material::isTranslucent() const
+{
+    return isAlphaBlended;
+}
+
 u32 Material::getSortKey() const
 {
     u32 sortKey = 0;
@@ -83,6 +83,10 @@ public:
     // Return true if this material is opaque; false otherwise.
     bool            isOpaque() const;
 
+    // Return true if this material is blended with the geometry behind it (i.e. must be rendered back to front, after
+    // the opaque geometry); false otherwise.
+    bool            isTranslucent() const;
+
     // Return this material instance sort key (i.e. an integer used for sorting
     // draw commands with minimal state change count).
     u32             getSortKey() const;
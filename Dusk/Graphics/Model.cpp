@@ -11,6 +11,7 @@ Model::Model( BaseAllocator* allocator, const dkChar_t* name )
     , lod{}
     , modelAABB{}
     , modelBoundingSphere{}
+    , occluderMesh( nullptr )
     , resourceFilePath( "" )
 {
     setName( name );
@@ -43,6 +44,56 @@ const Model::LevelOfDetail& Model::getLevelOfDetail( const f32 distanceToMesh )
     return lod[cheapestValidLodIdx];
 }
 
+u32 Model::selectLevelOfDetail( const f32 pixelsPerUnit, const f32 distanceToMesh, const f32 maxErrorInPixels, const f32 hysteresis, const u32 previousLodIdx ) const
+{
+    if ( lodCount <= 1u ) {
+        return 0u;
+    }
+
+    if ( previousLodIdx >= lodCount ) {
+        return getCheapestAcceptableLod( pixelsPerUnit, distanceToMesh, maxErrorInPixels, 1.0f );
+    }
+
+    // Only switch to a cheaper lod if its error is below the band and only switch to a finer lod if the error of the
+    // previous lod is above the band.
+    const u32 cheaperLodIdx = getCheapestAcceptableLod( pixelsPerUnit, distanceToMesh, maxErrorInPixels, 1.0f - hysteresis );
+    const u32 finerLodIdx = getCheapestAcceptableLod( pixelsPerUnit, distanceToMesh, maxErrorInPixels, 1.0f + hysteresis );
+
+    return Min( Max( previousLodIdx, cheaperLodIdx ), finerLodIdx );
+}
+
+bool Model::hasGeometricErrors() const
+{
+    return ( lodCount > 1u && lod[lodCount - 1].GeometricError > 0.0f );
+}
+
+u32 Model::getCheapestAcceptableLod( const f32 pixelsPerUnit, const f32 distanceToMesh, const f32 maxErrorInPixels, const f32 slack ) const
+{
+    // Lods are sorted from the finest to the cheapest; stop at the first lod exceeding the budget.
+    u32 cheapestLodIdx = 0u;
+    if ( hasGeometricErrors() ) {
+        const f32 maxError = maxErrorInPixels * slack;
+        for ( u32 lodIdx = 1; lodIdx < lodCount; lodIdx++ ) {
+            if ( lod[lodIdx].GeometricError * pixelsPerUnit > maxError ) {
+                break;
+            }
+
+            cheapestLodIdx = lodIdx;
+        }
+    } else {
+        const f32 distance = distanceToMesh * slack;
+        for ( u32 lodIdx = 1; lodIdx < lodCount; lodIdx++ ) {
+            if ( lod[lodIdx - 1].EndDistance >= distance ) {
+                break;
+            }
+
+            cheapestLodIdx = lodIdx;
+        }
+    }
+
+    return cheapestLodIdx;
+}
+
 const Model::LevelOfDetail& Model::getLevelOfDetailByIndex( const u32 lodIdx ) const
 {
     DUSK_DEV_ASSERT( lodIdx < lodCount, "lodIdx is out of bounds!" );
@@ -78,7 +129,7 @@ const std::string& Model::getResourcedPath() const
 }
 #endif
 
-Model::LevelOfDetail& Model::addLevelOfDetail( const f32 lodEndDistance )
+Model::LevelOfDetail& Model::addLevelOfDetail( const f32 lodEndDistance, const f32 geometricError )
 {
     i32 lodIdx = lodCount;
     if ( lodIdx >= MAX_LOD_COUNT ) {
@@ -89,6 +140,7 @@ Model::LevelOfDetail& Model::addLevelOfDetail( const f32 lodEndDistance )
     Model::LevelOfDetail& allocatedLevel = lod[lodIdx];
     allocatedLevel.EndDistance = lodEndDistance;
     allocatedLevel.LodIndex = lodIdx;
+    allocatedLevel.GeometricError = geometricError;
 
     lodCount++;
 
@@ -134,6 +186,16 @@ dkStringHash_t Model::getHashcode() const
     return modelHashcode;
 }
 
+void Model::setOccluderMesh( const OccluderMesh* occluder )
+{
+    occluderMesh = occluder;
+}
+
+const OccluderMesh* Model::getOccluderMesh() const
+{
+    return occluderMesh;
+}
+
 void Model::rebuildLodHashcodes()
 {
 	for ( u32 lodIdx = 0; lodIdx < lodCount; lodIdx++ ) {
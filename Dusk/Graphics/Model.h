@@ -6,6 +6,7 @@
 
 class BaseAllocator;
 struct Mesh;
+struct OccluderMesh;
 
 #include <Maths/BoundingSphere.h>
 #include <Maths/AABB.h>
@@ -21,6 +22,10 @@ public:
         // Level Of Detail index.
         u32         LodIndex;
 
+        // Maximum deviation (in model space units) of this LOD from the full detail geometry (zero for LOD0). The LOD
+        // is selected from this error projected on screen (see selectLevelOfDetail).
+        f32         GeometricError;
+
         // Array of mesh used to draw this lod.
         Mesh*       MeshArray;
 
@@ -41,6 +46,7 @@ public:
         LevelOfDetail()
             : EndDistance( std::numeric_limits<f32>::max() )
             , LodIndex( 0 )
+            , GeometricError( 0.0f )
             , MeshArray( nullptr )
             , MeshCount( -1 )
 #if DUSK_DEVBUILD
@@ -57,6 +63,9 @@ public:
     // Maximum level of detail per model. Might need to be raised in the future.
     static constexpr i32    MAX_LOD_COUNT = 4;
 
+    // Index returned when no LOD has been selected yet.
+    static constexpr u32    INVALID_LOD_INDEX = ~0u;
+
 public:
                             Model( BaseAllocator* allocator, const dkChar_t* name = DUSK_STRING( "DefaultModel" ) );
                             ~Model();
@@ -68,6 +77,17 @@ public:
     // Return the lod to display accordingly to the distance between the camera and the model.
     const LevelOfDetail&    getLevelOfDetail( const f32 distanceToMesh ) const;
 
+    // Return the index of the lod to display: the cheapest lod whose geometric error, projected on screen, does not
+    // exceed 'maxErrorInPixels' ('pixelsPerUnit' is the size in pixels of one model space unit at the instance location).
+    // Models without error metrics fall back to the distance based selection (using 'distanceToMesh').
+    // 'previousLodIdx' is the lod displayed by the previous frame (or INVALID_LOD_INDEX): the selection only switches
+    // once the error leaves the band [maxError * ( 1 - hysteresis )..maxError * ( 1 + hysteresis )] so that instances
+    // close to a threshold don't switch lod every frame.
+    u32                     selectLevelOfDetail( const f32 pixelsPerUnit, const f32 distanceToMesh, const f32 maxErrorInPixels, const f32 hysteresis, const u32 previousLodIdx ) const;
+
+    // Return true if the lods of this model have error metrics (the cheapest lod has a non-zero geometric error).
+    bool                    hasGeometricErrors() const;
+
     // Return the lod by its index. The index must be between 0 and ( getLevelOfDetailCount() - 1 ).
     const LevelOfDetail&    getLevelOfDetailByIndex( const u32 lodIdx ) const;
 
@@ -86,9 +106,9 @@ public:
     const std::string&      getResourcedPath() const;
 #endif
 
-    // Add a lod to this model (with an explicit max. visibility distance). Return a reference to the lod added, or a 
-    // reference to the cheapest lod level if the model has reached the maximum lod count.
-    LevelOfDetail&          addLevelOfDetail( const f32 lodEndDistance );
+    // Add a lod to this model (with an explicit max. visibility distance and geometric error). Return a reference to the
+    // lod added, or a reference to the cheapest lod level if the model has reached the maximum lod count.
+    LevelOfDetail&          addLevelOfDetail( const f32 lodEndDistance, const f32 geometricError = 0.0f );
 
     // Set the name of this model.
     void                    setName( const dkString_t& newName );
@@ -107,6 +127,13 @@ public:
     // Return the hashcode of this model (precomputed hashcode based on this model name).
     dkStringHash_t          getHashcode() const;
 
+    // Designate this model as an occluder (the occluder mesh is rasterized to the CPU occlusion buffer when the model
+    // is visible). The mesh is owned by the caller and must outlive this model. Pass nullptr to clear the occluder.
+    void                    setOccluderMesh( const OccluderMesh* occluder );
+
+    // Return the occluder mesh of this model (or nullptr if this model is not an occluder).
+    const OccluderMesh*     getOccluderMesh() const;
+
 private:
     // Allocator owning this object.
     BaseAllocator*          memoryAllocator;
@@ -129,9 +156,15 @@ private:
     // Bounding Sphere for this model.
     BoundingSphere          modelBoundingSphere;
 
+    // Simplified geometry used for occlusion culling (optional).
+    const OccluderMesh*     occluderMesh;
+
     // Absolute path to the file storing this model.
     std::string             resourceFilePath;
 
 private:
     void rebuildLodHashcodes();
+
+    // Return the index of the cheapest lod acceptable once the error budget (or the lod distances) is scaled by 'slack'.
+    u32  getCheapestAcceptableLod( const f32 pixelsPerUnit, const f32 distanceToMesh, const f32 maxErrorInPixels, const f32 slack ) const;
 };
@@ -23,6 +23,26 @@ static constexpr f32    LOD_DISTANCE_LUT[Model::MAX_LOD_COUNT] =
     10000.0f
 };
 
+// Return the average edge length of the triangles of a lod (triangles are assumed to be equilateral and to cover the
+// surface of the lod bounding box).
+static f32 EstimateAverageEdgeLength( const Model::LevelOfDetail& lod )
+{
+    u32 faceCount = 0u;
+    for ( i32 i = 0; i < lod.MeshCount; i++ ) {
+        faceCount += lod.MeshArray[i].FaceCount;
+    }
+
+    if ( faceCount == 0u ) {
+        return 0.0f;
+    }
+
+    const dkVec3f extents = lod.GroupAABB.maxPoint - lod.GroupAABB.minPoint;
+    const f32 surfaceArea = 2.0f * ( extents.x * extents.y + extents.y * extents.z + extents.z * extents.x );
+
+    // Area of an equilateral triangle is edge^2 * sqrt( 3 ) / 4.
+    return sqrtf( surfaceArea / static_cast< f32 >( faceCount ) * 4.0f / sqrtf( 3.0f ) );
+}
+
 template<typename T = f32, eResourceBind bindType = RESOURCE_BIND_VERTEX_BUFFER>
 static Buffer* CreateIfNonEmpty( RenderDevice* renderDevice, const std::vector<T>& dataArray, const u32 strideInBytes )
 {
@@ -65,6 +85,11 @@ void dk::graphics::BuildParsedModel( Model* builtModel, BaseAllocator* memoryAll
 
     std::vector<Mesh*> builtMeshes;
 
+    // Parsed models don't store any error metric; the geometric error of each lod is estimated from the coarsening of
+    // its triangles (half the growth of the average edge length compared to LOD0).
+    f32 lod0EdgeLength = 0.0f;
+    f32 geometricError = 0.0f;
+
     // Build model LODs.
     for ( u32 lodIdx = 0; lodIdx < lodCount; lodIdx++ ) {
         Model::LevelOfDetail& lod = builtModel->getLevelOfDetailForEditor( lodIdx );
@@ -141,6 +166,15 @@ void dk::graphics::BuildParsedModel( Model* builtModel, BaseAllocator* memoryAll
 				memcpy( builtMesh.Indices, mesh.IndexList, sizeof( u32 ) * mesh.IndexCount );
             }
         }
+
+        // Errors must not decrease from a lod to the next one.
+        const f32 edgeLength = EstimateAverageEdgeLength( lod );
+        if ( lodIdx == 0 ) {
+            lod0EdgeLength = edgeLength;
+        } else {
+            geometricError = Max( geometricError, 0.5f * ( edgeLength - lod0EdgeLength ) );
+            lod.GeometricError = geometricError;
+        }
     }
     
     // Create buffers.
@@ -0,0 +1,271 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "OcclusionBuffer.h"
+
+#if defined( DUSK_SSE42 )
+#include <xmmintrin.h>
+#endif
+
+static DUSK_INLINE u32 GetMipWidth( const u32 mipIdx )
+{
+    return Max( OcclusionBuffer::WIDTH >> mipIdx, 1u );
+}
+
+static DUSK_INLINE u32 GetMipHeight( const u32 mipIdx )
+{
+    return Max( OcclusionBuffer::HEIGHT >> mipIdx, 1u );
+}
+
+// Return true if a clip space position is behind the camera or in front of the near plane (reversed Z).
+static DUSK_INLINE bool IsNearClipped( const dkVec4f& clipPosition )
+{
+    return clipPosition.w <= 0.0f || clipPosition.z > clipPosition.w;
+}
+
+// Project a clip space position to the screen space of the buffer (x and y in pixels; depth in z).
+static DUSK_INLINE dkVec3f ToScreenSpace( const dkVec4f& clipPosition )
+{
+    const f32 invW = 1.0f / clipPosition.w;
+
+    return dkVec3f( ( clipPosition.x * invW * 0.5f + 0.5f ) * static_cast< f32 >( OcclusionBuffer::WIDTH ),
+                    ( 0.5f - clipPosition.y * invW * 0.5f ) * static_cast< f32 >( OcclusionBuffer::HEIGHT ),
+                    clipPosition.z * invW );
+}
+
+OcclusionBuffer::OcclusionBuffer( BaseAllocator* allocator )
+    : memoryAllocator( allocator )
+    , depthPyramid( nullptr )
+    , mipOffsets{ 0u }
+    , viewProjection( dkMat4x4f::Identity )
+    , occluderCount( 0u )
+{
+    u32 texelCount = 0u;
+    for ( u32 mipIdx = 0u; mipIdx < MIP_COUNT; mipIdx++ ) {
+        mipOffsets[mipIdx] = texelCount;
+        texelCount += GetMipWidth( mipIdx ) * GetMipHeight( mipIdx );
+    }
+
+    depthPyramid = dk::core::allocateArray<f32>( memoryAllocator, texelCount );
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+    dk::core::freeArray( memoryAllocator, depthPyramid );
+}
+
+void OcclusionBuffer::clear( const dkMat4x4f& viewProjectionMatrix )
+{
+    // Only the first level needs to be cleared (the other levels are rebuilt from it).
+    memset( depthPyramid, 0, sizeof( f32 ) * WIDTH * HEIGHT );
+
+    viewProjection = viewProjectionMatrix;
+    occluderCount = 0u;
+}
+
+void OcclusionBuffer::rasterizeOccluder( const OccluderMesh& occluder, const dkMat4x4f& modelMatrix )
+{
+    const dkMat4x4f modelViewProjection = viewProjection * modelMatrix;
+
+    for ( u32 i = 0u; ( i + 2u ) < occluder.IndexCount; i += 3u ) {
+        const dkVec4f clip0 = dkVec4f( occluder.Vertices[occluder.Indices[i]], 1.0f ) * modelViewProjection;
+        const dkVec4f clip1 = dkVec4f( occluder.Vertices[occluder.Indices[i + 1u]], 1.0f ) * modelViewProjection;
+        const dkVec4f clip2 = dkVec4f( occluder.Vertices[occluder.Indices[i + 2u]], 1.0f ) * modelViewProjection;
+
+        // Skipping a triangle is conservative (it can only make the occluder smaller); no clipping is required.
+        if ( IsNearClipped( clip0 ) || IsNearClipped( clip1 ) || IsNearClipped( clip2 ) ) {
+            continue;
+        }
+
+        rasterizeTriangle( ToScreenSpace( clip0 ), ToScreenSpace( clip1 ), ToScreenSpace( clip2 ) );
+    }
+
+    occluderCount++;
+}
+
+void OcclusionBuffer::rasterizeTriangle( const dkVec3f& v0, const dkVec3f& v1, const dkVec3f& v2 )
+{
+    // Rasterize the triangle whatever its winding (swap two vertices to make it counter clockwise).
+    const f32 signedArea = ( v1.x - v0.x ) * ( v2.y - v0.y ) - ( v1.y - v0.y ) * ( v2.x - v0.x );
+    if ( signedArea == 0.0f ) {
+        return;
+    }
+
+    const dkVec3f& a = v0;
+    const dkVec3f& b = ( signedArea > 0.0f ) ? v1 : v2;
+    const dkVec3f& c = ( signedArea > 0.0f ) ? v2 : v1;
+    const f32 invArea = 1.0f / ( ( signedArea > 0.0f ) ? signedArea : -signedArea );
+
+    // Screen bounds (clamped to the buffer).
+    const i32 minX = Max( static_cast< i32 >( floor( Min( a.x, Min( b.x, c.x ) ) ) ), 0 );
+    const i32 maxX = Min( static_cast< i32 >( ceil( Max( a.x, Max( b.x, c.x ) ) ) ), static_cast< i32 >( WIDTH ) - 1 );
+    const i32 minY = Max( static_cast< i32 >( floor( Min( a.y, Min( b.y, c.y ) ) ) ), 0 );
+    const i32 maxY = Min( static_cast< i32 >( ceil( Max( a.y, Max( b.y, c.y ) ) ) ), static_cast< i32 >( HEIGHT ) - 1 );
+    if ( minX > maxX || minY > maxY ) {
+        return;
+    }
+
+    // Edge functions (E = A * x + B * y + C; positive inside the triangle). Edge 'N' is opposite to vertex 'N'.
+    const f32 edgeA0 = b.y - c.y, edgeB0 = c.x - b.x, edgeC0 = -( edgeA0 * b.x + edgeB0 * b.y );
+    const f32 edgeA1 = c.y - a.y, edgeB1 = a.x - c.x, edgeC1 = -( edgeA1 * c.x + edgeB1 * c.y );
+    const f32 edgeA2 = a.y - b.y, edgeB2 = b.x - a.x, edgeC2 = -( edgeA2 * a.x + edgeB2 * a.y );
+
+    // Depth plane (z / w is linear in screen space).
+    const f32 depthA = ( edgeA0 * a.z + edgeA1 * b.z + edgeA2 * c.z ) * invArea;
+    const f32 depthB = ( edgeB0 * a.z + edgeB1 * b.z + edgeB2 * c.z ) * invArea;
+    const f32 depthC = ( edgeC0 * a.z + edgeC1 * b.z + edgeC2 * c.z ) * invArea;
+
+#if defined( DUSK_SSE42 )
+    // Process the pixels 4 at a time (groups are aligned on 4 pixels; since the triangle is contained in its bounds, the
+    // pixels of a group outside the bounds always fail the edge tests).
+    const i32 firstX = ( minX & ~3 );
+    const __m128 pixelOffsets = _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 edgeA0x4 = _mm_set1_ps( edgeA0 );
+    const __m128 edgeA1x4 = _mm_set1_ps( edgeA1 );
+    const __m128 edgeA2x4 = _mm_set1_ps( edgeA2 );
+    const __m128 depthAx4 = _mm_set1_ps( depthA );
+
+    for ( i32 y = minY; y <= maxY; y++ ) {
+        const f32 pixelY = static_cast< f32 >( y ) + 0.5f;
+        const __m128 rowEdge0 = _mm_set1_ps( edgeB0 * pixelY + edgeC0 );
+        const __m128 rowEdge1 = _mm_set1_ps( edgeB1 * pixelY + edgeC1 );
+        const __m128 rowEdge2 = _mm_set1_ps( edgeB2 * pixelY + edgeC2 );
+        const __m128 rowDepth = _mm_set1_ps( depthB * pixelY + depthC );
+
+        f32* row = depthPyramid + y * WIDTH;
+        for ( i32 x = firstX; x <= maxX; x += 4 ) {
+            const __m128 pixelX = _mm_add_ps( _mm_set1_ps( static_cast< f32 >( x ) ), pixelOffsets );
+
+            const __m128 edge0 = _mm_add_ps( _mm_mul_ps( edgeA0x4, pixelX ), rowEdge0 );
+            const __m128 edge1 = _mm_add_ps( _mm_mul_ps( edgeA1x4, pixelX ), rowEdge1 );
+            const __m128 edge2 = _mm_add_ps( _mm_mul_ps( edgeA2x4, pixelX ), rowEdge2 );
+
+            const __m128 coverage = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( edge0, zero ), _mm_cmpge_ps( edge1, zero ) ), _mm_cmpge_ps( edge2, zero ) );
+            if ( _mm_movemask_ps( coverage ) == 0 ) {
+                continue;
+            }
+
+            // Keep the closest depth (reversed Z) of the covered pixels.
+            const __m128 depth = _mm_add_ps( _mm_mul_ps( depthAx4, pixelX ), rowDepth );
+            const __m128 previousDepth = _mm_loadu_ps( row + x );
+            const __m128 closestDepth = _mm_max_ps( previousDepth, depth );
+
+            _mm_storeu_ps( row + x, _mm_or_ps( _mm_and_ps( coverage, closestDepth ), _mm_andnot_ps( coverage, previousDepth ) ) );
+        }
+    }
+#else
+    for ( i32 y = minY; y <= maxY; y++ ) {
+        const f32 pixelY = static_cast< f32 >( y ) + 0.5f;
+
+        f32* row = depthPyramid + y * WIDTH;
+        for ( i32 x = minX; x <= maxX; x++ ) {
+            const f32 pixelX = static_cast< f32 >( x ) + 0.5f;
+
+            if ( ( edgeA0 * pixelX + edgeB0 * pixelY + edgeC0 ) < 0.0f
+              || ( edgeA1 * pixelX + edgeB1 * pixelY + edgeC1 ) < 0.0f
+              || ( edgeA2 * pixelX + edgeB2 * pixelY + edgeC2 ) < 0.0f ) {
+                continue;
+            }
+
+            row[x] = Max( row[x], depthA * pixelX + depthB * pixelY + depthC );
+        }
+    }
+#endif
+}
+
+void OcclusionBuffer::buildHierarchy()
+{
+    // Each texel stores the farthest depth (reversed Z) of the texels it covers in the previous level.
+    for ( u32 mipIdx = 1u; mipIdx < MIP_COUNT; mipIdx++ ) {
+        const f32* source = depthPyramid + mipOffsets[mipIdx - 1u];
+        const u32 sourceWidth = GetMipWidth( mipIdx - 1u );
+        const u32 sourceHeight = GetMipHeight( mipIdx - 1u );
+
+        f32* destination = depthPyramid + mipOffsets[mipIdx];
+        const u32 width = GetMipWidth( mipIdx );
+        const u32 height = GetMipHeight( mipIdx );
+
+        for ( u32 y = 0u; y < height; y++ ) {
+            const f32* sourceRow0 = source + ( y * 2u ) * sourceWidth;
+            const f32* sourceRow1 = source + Min( y * 2u + 1u, sourceHeight - 1u ) * sourceWidth;
+
+            for ( u32 x = 0u; x < width; x++ ) {
+                const u32 x0 = x * 2u;
+                const u32 x1 = Min( x0 + 1u, sourceWidth - 1u );
+
+                destination[y * width + x] = Min( Min( sourceRow0[x0], sourceRow0[x1] ), Min( sourceRow1[x0], sourceRow1[x1] ) );
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isSphereOccluded( const dkVec3f& sphereCenter, const f32 sphereRadius ) const
+{
+    if ( occluderCount == 0u ) {
+        return false;
+    }
+
+    // Project the corners of the box bounding the sphere (the box bounds are conservative).
+    const dkVec4f centerClip = dkVec4f( sphereCenter, 1.0f ) * viewProjection;
+    const dkVec4f axisX = viewProjection[0] * sphereRadius;
+    const dkVec4f axisY = viewProjection[1] * sphereRadius;
+    const dkVec4f axisZ = viewProjection[2] * sphereRadius;
+
+    f32 screenMinX = std::numeric_limits<f32>::max();
+    f32 screenMinY = std::numeric_limits<f32>::max();
+    f32 screenMaxX = -std::numeric_limits<f32>::max();
+    f32 screenMaxY = -std::numeric_limits<f32>::max();
+    f32 closestDepth = 0.0f;
+
+    for ( u32 cornerIdx = 0u; cornerIdx < 8u; cornerIdx++ ) {
+        const dkVec4f cornerClip = centerClip
+            + ( ( cornerIdx & 1u ) ? axisX : -axisX )
+            + ( ( cornerIdx & 2u ) ? axisY : -axisY )
+            + ( ( cornerIdx & 4u ) ? axisZ : -axisZ );
+
+        // The camera is (or might be) inside the bounds.
+        if ( IsNearClipped( cornerClip ) ) {
+            return false;
+        }
+
+        const dkVec3f cornerScreen = ToScreenSpace( cornerClip );
+        screenMinX = Min( screenMinX, cornerScreen.x );
+        screenMinY = Min( screenMinY, cornerScreen.y );
+        screenMaxX = Max( screenMaxX, cornerScreen.x );
+        screenMaxY = Max( screenMaxY, cornerScreen.y );
+        closestDepth = Max( closestDepth, cornerScreen.z );
+    }
+
+    // Bounds outside the buffer (nothing to test against).
+    if ( screenMaxX < 0.0f || screenMaxY < 0.0f
+      || screenMinX >= static_cast< f32 >( WIDTH ) || screenMinY >= static_cast< f32 >( HEIGHT ) ) {
+        return false;
+    }
+
+    const u32 minX = static_cast< u32 >( Max( screenMinX, 0.0f ) );
+    const u32 minY = static_cast< u32 >( Max( screenMinY, 0.0f ) );
+    const u32 maxX = Min( static_cast< u32 >( screenMaxX ), WIDTH - 1u );
+    const u32 maxY = Min( static_cast< u32 >( screenMaxY ), HEIGHT - 1u );
+
+    // Pick the finest level where the bounds cover at most 2x2 texels.
+    u32 mipIdx = 0u;
+    while ( ( mipIdx + 1u ) < MIP_COUNT
+         && ( ( ( maxX >> mipIdx ) - ( minX >> mipIdx ) ) > 1u || ( ( maxY >> mipIdx ) - ( minY >> mipIdx ) ) > 1u ) ) {
+        mipIdx++;
+    }
+
+    const f32* mip = depthPyramid + mipOffsets[mipIdx];
+    const u32 mipWidth = GetMipWidth( mipIdx );
+
+    f32 farthestOccluderDepth = std::numeric_limits<f32>::max();
+    for ( u32 y = ( minY >> mipIdx ); y <= ( maxY >> mipIdx ); y++ ) {
+        for ( u32 x = ( minX >> mipIdx ); x <= ( maxX >> mipIdx ); x++ ) {
+            farthestOccluderDepth = Min( farthestOccluderDepth, mip[y * mipWidth + x] );
+        }
+    }
+
+    return closestDepth < farthestOccluderDepth;
+}
@@ -0,0 +1,78 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class BaseAllocator;
+
+#include <Maths/Matrix.h>
+
+// Simplified geometry of a model rasterized to the occlusion buffer (indexed triangle list, in model space). An occluder
+// mesh must be fully contained in the geometry it stands for (otherwise it might hide geometry which is visible).
+// Vertices and indices are owned by the caller.
+struct OccluderMesh
+{
+    const dkVec3f*  Vertices;
+    const u32*      Indices;
+    u32             IndexCount;
+};
+
+// Low resolution depth buffer rasterized on the CPU (reversed Z; 0 is infinitely far). Occluder triangles are rasterized
+// four pixels at a time; a min depth pyramid (HiZ) is then built so that an occludee test only reads a few texels
+// whatever the size of the occludee on screen. Usage: clear, rasterizeOccluder (for each occluder), buildHierarchy,
+// then isSphereOccluded (for each occludee).
+class OcclusionBuffer
+{
+public:
+    // Resolution of the depth buffer (the width must be a multiple of 4).
+    static constexpr u32    WIDTH = 256u;
+    static constexpr u32    HEIGHT = 128u;
+
+    // Number of levels of the depth pyramid (down to 1x1).
+    static constexpr u32    MIP_COUNT = 9u;
+
+public:
+    // Return the number of occluders rasterized since the last clear.
+    DUSK_INLINE u32         getOccluderCount() const { return occluderCount; }
+
+public:
+                            OcclusionBuffer( BaseAllocator* allocator );
+                            OcclusionBuffer( OcclusionBuffer& ) = delete;
+                            OcclusionBuffer& operator = ( OcclusionBuffer& ) = delete;
+                            ~OcclusionBuffer();
+
+    // Clear the buffer and set the view projection used to rasterize the occluders and to test the occludees.
+    // The projection must be a reversed Z projection.
+    void                    clear( const dkMat4x4f& viewProjectionMatrix );
+
+    // Rasterize an occluder to the depth buffer. Triangles crossing the near plane are skipped.
+    void                    rasterizeOccluder( const OccluderMesh& occluder, const dkMat4x4f& modelMatrix );
+
+    // Build the depth pyramid. Must be called once every occluder has been rasterized (and before any occludee test).
+    void                    buildHierarchy();
+
+    // Return true if the given world space sphere is hidden by the occluders; false otherwise (or if the test is
+    // inconclusive, e.g. if the sphere crosses the near plane).
+    bool                    isSphereOccluded( const dkVec3f& sphereCenter, const f32 sphereRadius ) const;
+
+private:
+    // The memory allocator owning this instance.
+    BaseAllocator*          memoryAllocator;
+
+    // Depth pyramid (every level is stored contiguously; level 0 is the rasterized depth buffer).
+    f32*                    depthPyramid;
+
+    // Offset (in texels) of each level of the pyramid.
+    u32                     mipOffsets[MIP_COUNT];
+
+    // View projection of the buffer.
+    dkMat4x4f               viewProjection;
+
+    // Number of occluders rasterized since the last clear.
+    u32                     occluderCount;
+
+private:
+    // Rasterize a triangle (screen space x and y; depth in z) to the depth buffer.
+    void                    rasterizeTriangle( const dkVec3f& v0, const dkVec3f& v1, const dkVec3f& v2 );
+};
@@ -25,7 +25,9 @@ PipelineStateCache::PipelineStateCache( BaseAllocator* allocator, RenderDevice*
     , cachedPipelineStateCount( 0 )
 {
     memset( pipelineHashes, 0, sizeof( Hash128 ) * MAX_CACHE_ELEMENT_COUNT );
-    memset( pipelineStates, 0, sizeof( PipelineState* ) * MAX_CACHE_ELEMENT_COUNT );
+    for ( size_t i = 0; i < MAX_CACHE_ELEMENT_COUNT; i++ ) {
+        pipelineStates[i].store( nullptr );
+    }
 
     pipelineStateCacheAllocator = dk::core::allocate<LinearAllocator>( memoryAllocator, 4 << 20, memoryAllocator->allocate( 4 << 20 ) );
 }
@@ -33,30 +35,43 @@ PipelineStateCache::PipelineStateCache( BaseAllocator* allocator, RenderDevice*
 PipelineStateCache::~PipelineStateCache()
 {
     for ( i32 i = 0; i < cachedPipelineStateCount; i++ ) {
-        renderDevice->destroyPipelineState( pipelineStates[i] );
+        renderDevice->destroyPipelineState( pipelineStates[i].load() );
     }
 
     dk::core::free( memoryAllocator, shaderCache );
 
     cachedPipelineStateCount = 0;
     memset( pipelineHashes, 0, sizeof( Hash128 ) * MAX_CACHE_ELEMENT_COUNT );
-    memset( pipelineStates, 0, sizeof( PipelineState* ) * MAX_CACHE_ELEMENT_COUNT );
+    for ( size_t i = 0; i < MAX_CACHE_ELEMENT_COUNT; i++ ) {
+        pipelineStates[i].store( nullptr );
+    }
 }
 
 PipelineState* PipelineStateCache::getOrCreatePipelineState( const PipelineStateDesc& descriptor, const ShaderBinding& shaderBinding, const bool forceRebuild )
 {
-    i32 cachedPsoIndex = -1;
-
     // (crappy) linear hashcode lookup (TODO profile this to make sure this isn't bottleneck)
     Hash128 psoDescHashcode = computePipelineStateKey( descriptor, shaderBinding );
-    for ( i32 i = 0; i < cachedPipelineStateCount; i++ ) {
+    if ( !forceRebuild ) {
+        const i32 publishedPsoCount = cachedPipelineStateCount.load( std::memory_order_acquire );
+        for ( i32 i = 0; i < publishedPsoCount; i++ ) {
+            if ( pipelineHashes[i] == psoDescHashcode ) {
+                return pipelineStates[i].load( std::memory_order_acquire );
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock( creationLock );
+
+    // Another thread might have created the PSO while we were waiting for the lock.
+    i32 cachedPsoIndex = -1;
+    for ( i32 i = 0; i < cachedPipelineStateCount.load( std::memory_order_relaxed ); i++ ) {
         if ( pipelineHashes[i] == psoDescHashcode ) {
             if ( forceRebuild ) {
                 cachedPsoIndex = i;
                 break;
             }
 
-            return pipelineStates[i];
+            return pipelineStates[i].load( std::memory_order_relaxed );
         }
     }
 
@@ -123,24 +138,25 @@ PipelineState* PipelineStateCache::getOrCreatePipelineState( const PipelineState
     if ( filledDescriptor.cachedPsoData != nullptr ) {
         dk::core::freeArray( pipelineStateCacheAllocator, static_cast< u8* >( filledDescriptor.cachedPsoData ) );
 
-        // Since allocators are thread local, we can safely reset its pointer at the end of the creation of the pso
+        // Creations are serialized; we can safely reset the allocator at the end of the creation of the pso
         pipelineStateCacheAllocator->clear();
     }
 
-    // TODO Critical section / synchronized section
-    const i32 psoCacheIndex = ( cachedPsoIndex == -1 ) ? cachedPipelineStateCount.load() : cachedPsoIndex;
+    // A rebuilt PSO replaces its entry in place (the hashcode is unchanged); a new PSO is published by the count update.
+    if ( cachedPsoIndex != -1 ) {
+        pipelineStates[cachedPsoIndex].store( pipelineState, std::memory_order_release );
+        return pipelineState;
+    }
 
-    pipelineHashes[psoCacheIndex] = psoDescHashcode;
-    pipelineStates[psoCacheIndex] = pipelineState;
+    const i32 psoCacheIndex = cachedPipelineStateCount.load( std::memory_order_relaxed );
+    DUSK_RAISE_FATAL_ERROR( psoCacheIndex < static_cast< i32 >( MAX_CACHE_ELEMENT_COUNT ), "Too many pipeline states (MAX_CACHE_ELEMENT_COUNT is %zu)!", MAX_CACHE_ELEMENT_COUNT );
 
-    PipelineState* cachedPipelineState = pipelineStates[psoCacheIndex];
+    pipelineHashes[psoCacheIndex] = psoDescHashcode;
+    pipelineStates[psoCacheIndex].store( pipelineState, std::memory_order_relaxed );
 
-    // Update cache entry count if the entry has just been added.
-    if ( cachedPsoIndex == -1 ) {
-        cachedPipelineStateCount++;
-    }
+    cachedPipelineStateCount.store( psoCacheIndex + 1, std::memory_order_release );
 
-    return cachedPipelineState;
+    return pipelineState;
 }
 
 Hash128 PipelineStateCache::computePipelineStateKey( const PipelineStateDesc& descriptor, const ShaderBinding& shaderBinding ) const
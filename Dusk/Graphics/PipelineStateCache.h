@@ -15,6 +15,9 @@ class LinearAllocator;
 #include <Core/Types.h>
 #include <Rendering/RenderDevice.h>
 
+#include <atomic>
+#include <mutex>
+
 class PipelineStateCache
 {
 public:
@@ -58,17 +61,25 @@ public:
                                                         PipelineStateCache& operator = ( PipelineStateCache& ) = delete;
                                                         ~PipelineStateCache();
 
+    // Return the PSO matching a descriptor (the PSO is created on the first request). Thread safe: lookups of cached
+    // PSOs are lock free; creations are serialized.
     PipelineState*                                      getOrCreatePipelineState( const PipelineStateDesc& descriptor, const ShaderBinding& shaderBinding, const bool forceRebuild = false );
 
 private:
-    // The pipeline cache is local (one cache per thread); it shouldnt be too expensive 
-    // to do a linear lookup when we need to retrieve a certain pipeline state
-    static constexpr size_t MAX_CACHE_ELEMENT_COUNT = 32;
+    // The cache is shared by every thread recording commands; it shouldnt be too expensive to do a linear lookup when
+    // we need to retrieve a certain pipeline state.
+    static constexpr size_t MAX_CACHE_ELEMENT_COUNT = 128;
 
 private:
     Hash128                 pipelineHashes[MAX_CACHE_ELEMENT_COUNT];
-    PipelineState*          pipelineStates[MAX_CACHE_ELEMENT_COUNT];
+    std::atomic<PipelineState*> pipelineStates[MAX_CACHE_ELEMENT_COUNT];
+
+    // Number of published entries. An entry is written before the count is incremented; readers can therefore read
+    // the entries below the count without locking.
     std::atomic_int32_t     cachedPipelineStateCount;
+
+    // Serializes PSO creations (and the ShaderCache/allocator used to build them).
+    std::mutex              creationLock;
     BaseAllocator*          memoryAllocator;
     RenderDevice*           renderDevice;
     VirtualFileSystem*      virtualFs;
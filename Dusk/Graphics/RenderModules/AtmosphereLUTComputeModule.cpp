@@ -664,9 +664,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
 
 	// Compute the transmittance, and store it in transmittance.
     frameGraph.addRenderPass<PassData>(
-        AtmosphereLUTCompute::ComputeTransmittance_Name,
+        AtmosphereLUTCompute::ComputeTransmittance_Name, AtmosphereLUTCompute::ComputeTransmittance_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
+            builder.setUncullablePass();
 
             BufferDesc passBufferDesc;
             passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -711,9 +712,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
 	// leave it unchanged (we don't want the direct irradiance in
 	// irradiance_texture_, but only the irradiance from the sky).
     frameGraph.addRenderPass<PassData>(
-        AtmosphereLUTCompute::ComputeDirectIrradiance_Name,
+        AtmosphereLUTCompute::ComputeDirectIrradiance_Name, AtmosphereLUTCompute::ComputeDirectIrradiance_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
+            builder.setUncullablePass();
 
             BufferDesc passBufferDesc;
             passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -770,9 +772,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
 	// either store them or accumulate them in scattering_texture_ and
 	// optional_single_mie_scattering_texture_.
     frameGraph.addRenderPass<PassData>(
-        AtmosphereLUTCompute::ComputeSingleScatteringPass_Name,
+        AtmosphereLUTCompute::ComputeSingleScatteringPass_Name, AtmosphereLUTCompute::ComputeSingleScatteringPass_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
+            builder.setUncullablePass();
 
             BufferDesc passBufferDesc;
             passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -831,9 +834,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
 		// Compute the scattering density, and store it in
 		// delta_scattering_density_texture.
         frameGraph.addRenderPass<PassData>(
-            AtmosphereLUTCompute::ComputeScatteringDensity_Name,
+            AtmosphereLUTCompute::ComputeScatteringDensity_Name, AtmosphereLUTCompute::ComputeScatteringDensity_NameHashcode,
             [&]( FrameGraphBuilder& builder, PassData& passData ) {
                 builder.useAsyncCompute();
+                builder.setUncullablePass();
 
                 BufferDesc passBufferDesc;
                 passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -894,9 +898,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
 		// Compute the indirect irradiance, store it in delta_irradiance_texture and
 		// accumulate it in irradiance_texture_.
 		frameGraph.addRenderPass<PassData>(
-			AtmosphereLUTCompute::ComputeIndirectIrradiance_Name,
+			AtmosphereLUTCompute::ComputeIndirectIrradiance_Name, AtmosphereLUTCompute::ComputeIndirectIrradiance_NameHashcode,
 			[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			    builder.useAsyncCompute();
+			    builder.setUncullablePass();
 
 			    BufferDesc passBufferDesc;
 			    passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -963,9 +968,10 @@ void AtmosphereLUTComputeModule::precomputeIteration( FrameGraph& frameGraph, co
         // scattering_texture_.
         // 
         frameGraph.addRenderPass<PassData>(
-			AtmosphereLUTCompute::ComputeMultipleScattering_Name,
+			AtmosphereLUTCompute::ComputeMultipleScattering_Name, AtmosphereLUTCompute::ComputeMultipleScattering_NameHashcode,
 			[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			    builder.useAsyncCompute();
+			    builder.setUncullablePass();
 
 			    BufferDesc passBufferDesc;
 			    passBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
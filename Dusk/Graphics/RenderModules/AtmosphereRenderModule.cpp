@@ -75,10 +75,8 @@ FGHandle AtmosphereRenderModule::renderSky( FrameGraph& frameGraph, FGHandle ren
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        AtmosphereBruneton::BrunetonSky_Name,
+        AtmosphereBruneton::BrunetonSky_Name, AtmosphereBruneton::BrunetonSky_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
-            builder.useAsyncCompute();
-
             passData.Output = builder.readImage( renderTarget );
             passData.DepthBuffer = builder.readImage( depthBuffer );
 
@@ -179,7 +177,7 @@ void AtmosphereRenderModule::renderSkyForProbeCapture( FrameGraph& frameGraph, I
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        AtmosphereBruneton::BrunetonSkyProbeCapture_Name,
+        AtmosphereBruneton::BrunetonSkyProbeCapture_Name, AtmosphereBruneton::BrunetonSkyProbeCapture_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.setUncullablePass();
             builder.useAsyncCompute();
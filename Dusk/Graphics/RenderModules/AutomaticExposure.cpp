@@ -83,7 +83,7 @@ FGHandle AutomaticExposureModule::addBinComputePass( FrameGraph& frameGraph, con
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        AutoExposure::BinCompute_Name,
+        AutoExposure::BinCompute_Name, AutoExposure::BinCompute_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
@@ -136,7 +136,7 @@ FGHandle AutomaticExposureModule::addHistogramMergePass( FrameGraph& frameGraph,
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        AutoExposure::HistogramMerge_Name,
+        AutoExposure::HistogramMerge_Name, AutoExposure::HistogramMerge_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
@@ -186,7 +186,7 @@ FGHandle AutomaticExposureModule::addExposureComputePass( FrameGraph& frameGraph
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        AutoExposure::TileHistogramCompute_Name,
+        AutoExposure::TileHistogramCompute_Name, AutoExposure::TileHistogramCompute_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
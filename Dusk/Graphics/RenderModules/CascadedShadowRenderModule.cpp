@@ -235,7 +235,7 @@ void CascadedShadowRenderModule::captureShadowMap( FrameGraph& frameGraph, FGHan
     // Filter shadow geometry.
     struct DummyPassData {};
     frameGraph.addRenderPass<DummyPassData>(
-        Culling::FilterShadowGeometry_Name,
+        Culling::FilterShadowGeometry_Name, Culling::FilterShadowGeometry_NameHashcode,
         [&]( FrameGraphBuilder& builder, DummyPassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -287,7 +287,7 @@ void CascadedShadowRenderModule::captureShadowMap( FrameGraph& frameGraph, FGHan
     };
 
     PassData& data = frameGraph.addRenderPass<PassData>(
-        ShadowRendering::DirectionalShadowRendering_Name,
+        ShadowRendering::DirectionalShadowRendering_Name, ShadowRendering::DirectionalShadowRendering_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
 			BufferDesc perPassBuffer;
 			perPassBuffer.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
@@ -514,7 +514,7 @@ void CascadedShadowRenderModule::clearIndirectArgsBuffer( FrameGraph& frameGraph
 {
     struct DummyPassData {};
     frameGraph.addRenderPass<DummyPassData>(
-        Culling::ClearArgsBuffer_Name,
+        Culling::ClearArgsBuffer_Name, Culling::ClearArgsBuffer_NameHashcode,
         [&]( FrameGraphBuilder& builder, DummyPassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -558,7 +558,7 @@ void CascadedShadowRenderModule::setupParameters( FrameGraph& frameGraph, FGHand
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        ShadowSetup::SetupCSMParameters_Name,
+        ShadowSetup::SetupCSMParameters_Name, ShadowSetup::SetupCSMParameters_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -619,7 +619,7 @@ FGHandle CascadedShadowRenderModule::reduceDepthBuffer( FrameGraph& frameGraph,
     };
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        DepthPyramid::DepthReduction_Name,
+        DepthPyramid::DepthReduction_Name, DepthPyramid::DepthReduction_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
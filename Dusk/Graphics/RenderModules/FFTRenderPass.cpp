@@ -64,7 +64,7 @@ FFTPassOutput AddFFTComputePass( FrameGraph& frameGraph, FGHandle input, f32 inp
         };
 
         DownscalePassData& downscaleData = frameGraph.addRenderPass<DownscalePassData>(
-            BuiltIn::CopyImagePass_Name,
+            BuiltIn::CopyImagePass_Name, BuiltIn::CopyImagePass_NameHashcode,
             [&]( FrameGraphBuilder& builder, DownscalePassData& passData ) {
                 builder.setUncullablePass();
 
@@ -118,7 +118,7 @@ FFTPassOutput AddFFTComputePass( FrameGraph& frameGraph, FGHandle input, f32 inp
     }
 
     PassData rowPassData = frameGraph.addRenderPass<PassData>(
-        FFT::FFTComputeRow_Name,
+        FFT::FFTComputeRow_Name, FFT::FFTComputeRow_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -201,7 +201,7 @@ FGHandle AddInverseFFTComputePass( FrameGraph& frameGraph, FFTPassOutput& inputI
     };
     
     PassDataRow& rowPassData = frameGraph.addRenderPass<PassDataRow>(
-        FFT::InverseFFTComputeRow_Name,
+        FFT::InverseFFTComputeRow_Name, FFT::InverseFFTComputeRow_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassDataRow& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -255,7 +255,7 @@ FGHandle AddInverseFFTComputePass( FrameGraph& frameGraph, FFTPassOutput& inputI
     };
     
     PassDataCol& colPassData = frameGraph.addRenderPass<PassDataCol>(
-        FFT::InverseFFTComputeCol_Name,
+        FFT::InverseFFTComputeCol_Name, FFT::InverseFFTComputeCol_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassDataCol& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -356,7 +356,7 @@ FGHandle AddInverseFFTComputePass( FrameGraph& frameGraph, FFTPassOutput& inputI
         );
 
         DownscalePassData& downscaleData = frameGraph.addRenderPass<DownscalePassData>(
-            FFT::UpscaleConvolutedFFT_Name,
+            FFT::UpscaleConvolutedFFT_Name, FFT::UpscaleConvolutedFFT_NameHashcode,
             [&]( FrameGraphBuilder& builder, DownscalePassData& passData ) {
                 builder.setUncullablePass();
 
@@ -52,7 +52,7 @@ FGHandle FrameCompositionModule::addFrameCompositionPass( FrameGraph& frameGraph
     );
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        PostEffects::Default_Name,
+        PostEffects::Default_Name, PostEffects::Default_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
@@ -66,6 +66,7 @@ FGHandle FrameCompositionModule::addFrameCompositionPass( FrameGraph& frameGraph
             outputDesc.bindFlags = RESOURCE_BIND_RENDER_TARGET_VIEW | RESOURCE_BIND_SHADER_RESOURCE | RESOURCE_BIND_UNORDERED_ACCESS_VIEW;
 
             passData.output = builder.allocateImage( outputDesc, FrameGraphBuilder::eImageFlags::USE_PIPELINE_DIMENSIONS_ONE );
+            builder.requireImageState( passData.output, eResourceState::RESOURCE_STATE_UAV );
 
             // PerPass Buffer
             BufferDesc bufferDesc;
@@ -110,7 +111,6 @@ FGHandle FrameCompositionModule::addFrameCompositionPass( FrameGraph& frameGraph
             u32 ThreadGroupX = DispatchSize( PostEffects::Default_DispatchX, vp->Width );
             u32 ThreadGroupY = DispatchSize( PostEffects::Default_DispatchY, vp->Height );
             cmdList->dispatchCompute( ThreadGroupX, ThreadGroupY, PostEffects::Default_DispatchZ );
-            cmdList->insertComputeBarrier( *outputTarget );
 
             cmdList->popEventMarker();
         }
@@ -37,7 +37,7 @@ FFTPassOutput GlareRenderModule::addGlareComputePass( FrameGraph& frameGraph, FF
     };
 
     PassData rowPassData = frameGraph.addRenderPass<PassData>(
-        FFT::FrequencyDomainMul_Name,
+        FFT::FrequencyDomainMul_Name, FFT::FrequencyDomainMul_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -125,7 +125,7 @@ void GlareRenderModule::precomputePipelineResources( FrameGraph& frameGraph )
     };
 
     PassData rowPassData = frameGraph.addRenderPass<PassData>(
-        FFT::FFTComputeRow_Name,
+        FFT::FFTComputeRow_Name, FFT::FFTComputeRow_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -24,7 +24,7 @@ void AddCubeFaceIrradianceComputePass( FrameGraph& frameGraph, Image* cubemap, I
 	};
 
 	PassData& passData = frameGraph.addRenderPass<PassData>(
-		IBL::ComputeIrradianceMap_Name,
+		IBL::ComputeIrradianceMap_Name, IBL::ComputeIrradianceMap_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			builder.useAsyncCompute();
 			builder.setUncullablePass();
@@ -82,7 +82,7 @@ void AddCubeFaceFilteringPass( FrameGraph& frameGraph, Image* cubemap, Image* fi
 	};
 
 	PassData& passData = frameGraph.addRenderPass<PassData>(
-		IBL::FilterCubeFace_Name,
+		IBL::FilterCubeFace_Name, IBL::FilterCubeFace_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			builder.useAsyncCompute();
 			builder.setUncullablePass();
@@ -144,7 +144,7 @@ void AddBrdfDfgLutComputePass( FrameGraph& frameGraph, Image* brdfDfgLut )
     struct PassData {};
 
     frameGraph.addRenderPass<PassData>(
-        BrdfLut::ComputeBRDFLut_Name,
+        BrdfLut::ComputeBRDFLut_Name, BrdfLut::ComputeBRDFLut_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
             builder.setUncullablePass();
@@ -60,7 +60,7 @@ FGHandle LineRenderingModule::renderLines( FrameGraph& frameGraph, FGHandle outp
     );
 
     PassData& data = frameGraph.addRenderPass<PassData>(
-        HUD::LineRendering_Name,
+        HUD::LineRendering_Name, HUD::LineRendering_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
         passData.PerViewBuffer = builder.retrievePerViewBuffer();
         passData.Output = builder.readImage( output );
@@ -29,6 +29,21 @@ const char* GetDepthPassName()
     };
 }
 
+template<i32 SamplerCount>
+dkStringHash_t GetDepthPassNameHashcode()
+{
+    switch ( SamplerCount ) {
+    case 2:
+        return AntiAliasing::ResolveDepthMSAAx2_NameHashcode;
+    case 4:
+        return AntiAliasing::ResolveDepthMSAAx4_NameHashcode;
+    case 8:
+        return AntiAliasing::ResolveDepthMSAAx8_NameHashcode;
+    default:
+        return DUSK_STRING_HASH( "" );
+    };
+}
+
 template<i32 SamplerCount>
 const dkChar_t* GetDepthEventName()
 {
@@ -94,7 +109,7 @@ FGHandle AddResolveDepthMSAARenderPass( FrameGraph& frameGraph,
     };
     
     PassData passData = frameGraph.addRenderPass<PassData>(
-        GetDepthPassName<SamplerCount>(),
+        GetDepthPassName<SamplerCount>(), GetDepthPassNameHashcode<SamplerCount>(),
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
@@ -160,6 +175,21 @@ const char* GetPassName()
     };
 }
 
+template<i32 SamplerCount, bool UseTemporalAA>
+dkStringHash_t GetPassNameHashcode()
+{
+    switch ( SamplerCount ) {
+    case 2:
+        return ( UseTemporalAA ) ? AntiAliasing::ResolveMSAAx2WithTAA_NameHashcode : AntiAliasing::ResolveMSAAx2_NameHashcode;
+    case 4:
+        return ( UseTemporalAA ) ? AntiAliasing::ResolveMSAAx4WithTAA_NameHashcode : AntiAliasing::ResolveMSAAx4_NameHashcode;
+    case 8:
+        return ( UseTemporalAA ) ? AntiAliasing::ResolveMSAAx8WithTAA_NameHashcode : AntiAliasing::ResolveMSAAx8_NameHashcode;
+    default:
+        return AntiAliasing::ResolveTAA_NameHashcode;
+    };
+}
+
 template<i32 SamplerCount, bool UseTemporalAA>
 const dkChar_t* GetEventName()
 {
@@ -251,7 +281,7 @@ FGHandle AddResolveMSAARenderPass( FrameGraph& frameGraph,
     };
 
     PassData passData = frameGraph.addRenderPass<PassData>(
-        GetPassName<SamplerCount, UseTemporalAA>(),
+        GetPassName<SamplerCount, UseTemporalAA>(), GetPassNameHashcode<SamplerCount, UseTemporalAA>(),
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             builder.useAsyncCompute();
 
@@ -267,6 +297,9 @@ FGHandle AddResolveMSAARenderPass( FrameGraph& frameGraph,
 
             copiedImageDesc->bindFlags |= RESOURCE_BIND_UNORDERED_ACCESS_VIEW;
 
+            builder.requireImageState( passData.Input, eResourceState::RESOURCE_STATE_ALL_BINDED_RESOURCE );
+            builder.requireImageState( passData.Output, eResourceState::RESOURCE_STATE_UAV );
+
             BufferDesc bufferDesc;
             bufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;
             bufferDesc.SizeInBytes = sizeof( AntiAliasing::ResolveMSAAx2WithTAAProperties );
@@ -293,9 +326,6 @@ FGHandle AddResolveMSAARenderPass( FrameGraph& frameGraph,
             cmdList->bindPipelineState( pso );
             cmdList->pushEventMarker( GetEventName<SamplerCount, UseTemporalAA>() );
 
-            cmdList->transitionImage( *outputTarget, eResourceState::RESOURCE_STATE_UAV );
-            cmdList->transitionImage( *inputTarget, eResourceState::RESOURCE_STATE_ALL_BINDED_RESOURCE, 0, CommandList::TRANSITION_GRAPHICS_TO_COMPUTE );
-
             cmdList->bindConstantBuffer( PerPassBufferHashcode, passBuffer );
 
             // The hashcode are shared between permutations; so we can take any permutation name.
@@ -327,11 +357,7 @@ FGHandle AddResolveMSAARenderPass( FrameGraph& frameGraph,
             u32 threadCountX = DispatchSize( dispatchX, static_cast< u32 >( vp->Width * cameraData->imageQuality ) );
             u32 threadCountY = DispatchSize( dispatchY, static_cast< u32 >( vp->Height * cameraData->imageQuality ) );
             cmdList->dispatchCompute( threadCountX, threadCountY, dispatchZ );
-            cmdList->insertComputeBarrier( *outputTarget );
             cmdList->popEventMarker();
-
-            cmdList->transitionImage( *inputTarget, eResourceState::RESOURCE_STATE_ALL_BINDED_RESOURCE, 0, CommandList::TRANSITION_COMPUTE_TO_GRAPHICS );
-            cmdList->transitionImage( *outputTarget, eResourceState::RESOURCE_STATE_UAV, 0, CommandList::TRANSITION_COMPUTE_TO_GRAPHICS );
         }
     );
 
@@ -374,8 +400,11 @@ FGHandle AddCheapMSAAResolveRenderPass( FrameGraph& frameGraph, FGHandle inputIm
         FGHandle Output;
     };
 
+    constexpr const char* PassName = "AntiAliasing::CheapMSAAResolve";
+    constexpr dkStringHash_t PassNameHashcode = DUSK_STRING_HASH( PassName );
+
     PassData passData = frameGraph.addRenderPass<PassData>(
-        "AntiAliasing::CheapMSAAResolve",
+        PassName, PassNameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.Input = builder.readReadOnlyImage( inputImage );
 
@@ -430,7 +459,7 @@ FGHandle AddSSAAResolveRenderPass( FrameGraph& frameGraph, FGHandle resolvedInpu
     };
 
     PassData& downscaleData = frameGraph.addRenderPass<PassData>(
-        AntiAliasing::ResolveSSAA_Name,
+        AntiAliasing::ResolveSSAA_Name, AntiAliasing::ResolveSSAA_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.Input = builder.readReadOnlyImage( resolvedInput );
 
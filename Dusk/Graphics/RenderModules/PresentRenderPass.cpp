@@ -37,10 +37,13 @@ void AddPresentRenderPass( FrameGraph& frameGraph, FGHandle imageToPresent )
     );
 
     frameGraph.addRenderPass<PassData>(
-        BuiltIn::PresentPass_Name,
+        BuiltIn::PresentPass_Name, BuiltIn::PresentPass_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.input = builder.readImage( imageToPresent );
             passData.swapchain = builder.retrieveSwapchainBuffer();
+
+            builder.requireImageState( passData.input, eResourceState::RESOURCE_STATE_PIXEL_BINDED_RESOURCE );
+            builder.requirePersistentImageState( passData.swapchain, eResourceState::RESOURCE_STATE_SWAPCHAIN_BUFFER );
         },
         [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache ) {
             DUSK_GPU_PROFILE_SCOPED( *cmdList, BuiltIn::PresentPass_Name );
@@ -72,9 +75,6 @@ void AddPresentRenderPass( FrameGraph& frameGraph, FGHandle imageToPresent )
             cmdList->setViewport( screenVp );
             cmdList->setScissor( screenSr );
 
-            cmdList->transitionImage( *inputTarget, eResourceState::RESOURCE_STATE_PIXEL_BINDED_RESOURCE );
-            cmdList->transitionImage( *outputTarget, eResourceState::RESOURCE_STATE_SWAPCHAIN_BUFFER );
-
             cmdList->bindImage( BuiltIn::PresentPass_InputRenderTarget_Hashcode, inputTarget );
 
             FramebufferAttachment attachment( outputTarget );
@@ -95,16 +95,13 @@ void AddSwapchainStateTransition( FrameGraph& frameGraph )
     };
 
     frameGraph.addRenderPass<PassData>(
-        BuiltIn::PresentPass_Name,
+        BuiltIn::PresentPass_Name, BuiltIn::PresentPass_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.swapchain = builder.retrieveSwapchainBuffer();
+            builder.requirePersistentImageState( passData.swapchain, eResourceState::RESOURCE_STATE_SWAPCHAIN_BUFFER );
         },
         [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache ) {
-            Image* outputTarget = resources->getPersitentImage( passData.swapchain );
-            
-            cmdList->pushEventMarker( BuiltIn::PresentPass_EventName );
-            cmdList->transitionImage( *outputTarget, eResourceState::RESOURCE_STATE_SWAPCHAIN_BUFFER );
-            cmdList->popEventMarker();
+            // The transition is flushed by the FrameGraph before the execution of the renderpass.
         }
     );
 }
@@ -40,7 +40,7 @@ SSRModule::HiZResult SSRModule::computeHiZMips( FrameGraph& frameGraph, FGHandle
 	};
 
 	PassData data = frameGraph.addRenderPass<PassData>(
-		DepthPyramid::DepthDownsample_Name,
+		DepthPyramid::DepthDownsample_Name, DepthPyramid::DepthDownsample_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			builder.useAsyncCompute();
 			builder.setUncullablePass();
@@ -178,7 +178,7 @@ SSRModule::TraceResult SSRModule::rayTraceHiZ( FrameGraph& frameGraph, FGHandle
     };
 
 	PassData data = frameGraph.addRenderPass<PassData>(
-		SSR::HiZTrace_Name,
+		SSR::HiZTrace_Name, SSR::HiZTrace_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			builder.useAsyncCompute();
 			builder.setUncullablePass();
@@ -271,7 +271,7 @@ FGHandle SSRModule::resolveRaytrace( FrameGraph& frameGraph, const SSRModule::Tr
     };
 
 	PassData data = frameGraph.addRenderPass<PassData>(
-		SSR::ResolveTrace_Name,
+		SSR::ResolveTrace_Name, SSR::ResolveTrace_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 			builder.useAsyncCompute();
 			builder.setUncullablePass();
@@ -352,7 +352,7 @@ FGHandle SSRModule::resolveRaytrace( FrameGraph& frameGraph, const SSRModule::Tr
 //    };
 //
 //	PassData data = frameGraph.addRenderPass<PassData>(
-//		SSR::TemporalRebuild_Name,
+//		SSR::TemporalRebuild_Name, SSR::TemporalRebuild_NameHashcode,
 //		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 //			builder.useAsyncCompute();
 //			builder.setUncullablePass();
@@ -428,7 +428,7 @@ FGHandle SSRModule::resolveRaytrace( FrameGraph& frameGraph, const SSRModule::Tr
 //    };
 //
 //	PassData data = frameGraph.addRenderPass<PassData>(
-//		SSR::Combine_Name,
+//		SSR::Combine_Name, SSR::Combine_NameHashcode,
 //		[&]( FrameGraphBuilder& builder, PassData& passData ) {
 //			builder.useAsyncCompute();
 //			builder.setUncullablePass();
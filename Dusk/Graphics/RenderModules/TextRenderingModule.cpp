@@ -80,7 +80,7 @@ FGHandle TextRenderingModule::renderText( FrameGraph& frameGraph, FGHandle outpu
     );
 
     PassData& data = frameGraph.addRenderPass<PassData>(
-        HUD::RenderText_Name,
+        HUD::RenderText_Name, HUD::RenderText_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.PerViewBuffer = builder.retrievePerViewBuffer();
             passData.Output = builder.readImage( output );
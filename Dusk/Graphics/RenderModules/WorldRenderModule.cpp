@@ -46,6 +46,102 @@ static constexpr dkStringHash_t BRDFInputSamplerHashcode = DUSK_STRING_HASH( "Te
 DUSK_ENV_OPTION_LIST( TextureFiltering, TEXTURE_FILTERING_OPTION_LIST )
 
 DUSK_ENV_VAR( TextureFiltering, BILINEAR, eTextureFiltering ) // "Defines texture filtering quality [Bilinear/Trilinear/Anisotropic (8)/Anisotropic (16)]"
+DUSK_DEV_VAR( WorldRecordingChunkCount, "Number of CommandLists the world geometry passes are recorded to (each chunk can be recorded by a different worker)", 4, u32 );
+DUSK_DEV_VAR( WorldUseMultiDrawIndirect, "Collapse consecutive world draws sharing the same states into a single multi draw indirect call (if supported by the RenderDevice)", true, bool );
+
+// Maximum number of indirect draws recorded by a chunk of a geometry pass.
+static constexpr u32 MAX_INDIRECT_DRAW_COUNT = 1024u;
+
+// Maximum number of instances rendered by a single multi draw (capacity of the instance id stream).
+static constexpr u32 MAX_INDIRECT_INSTANCE_COUNT = 8192u;
+
+// Arguments of an indexed indirect draw (matches the layout expected by DrawIndexedInstancedIndirect/vkCmdDrawIndexedIndirect).
+struct DrawIndexedIndirectArgs
+{
+    u32 IndexCountPerInstance;
+    u32 InstanceCount;
+    u32 StartIndexLocation;
+    i32 BaseVertexLocation;
+    u32 StartInstanceLocation;
+};
+
+// Return the draw commands of 'bucket' recorded by 'chunk'.
+static void GetChunkDrawRange( const FrameGraphResources::DrawCmdBucket& bucket, const FGRecordingChunk& chunk, const DrawCmd*& drawBegin, const DrawCmd*& drawEnd )
+{
+    u32 rangeBegin, rangeEnd;
+    chunk.getRange( static_cast< u32 >( bucket.end() - bucket.begin() ), rangeBegin, rangeEnd );
+
+    drawBegin = bucket.begin() + rangeBegin;
+    drawEnd = bucket.begin() + rangeEnd;
+}
+
+// Return true if two draw commands can be recorded by the same multi draw (i.e. they share the pipeline state, the
+// resource bindings and the geometry buffers).
+static bool CanShareMultiDraw( const DrawCommandInfos& cmdInfos, const DrawCommandInfos& otherCmdInfos )
+{
+    const BufferBinding* vertexBuffers = cmdInfos.vertexBuffers;
+    const BufferBinding* otherVertexBuffers = otherCmdInfos.vertexBuffers;
+
+    return cmdInfos.material == otherCmdInfos.material
+        && cmdInfos.useShortIndices == otherCmdInfos.useShortIndices
+        && cmdInfos.indiceBuffer->BufferObject == otherCmdInfos.indiceBuffer->BufferObject
+        && vertexBuffers[eMeshAttribute::Position].BufferObject == otherVertexBuffers[eMeshAttribute::Position].BufferObject
+        && vertexBuffers[eMeshAttribute::Position].OffsetInBytes == otherVertexBuffers[eMeshAttribute::Position].OffsetInBytes
+        && vertexBuffers[eMeshAttribute::Normal].BufferObject == otherVertexBuffers[eMeshAttribute::Normal].BufferObject
+        && vertexBuffers[eMeshAttribute::UvMap_0].BufferObject == otherVertexBuffers[eMeshAttribute::UvMap_0].BufferObject;
+}
+
+// Return the end of the run of draw commands starting at 'runBegin' which can be recorded by a single multi draw (at
+// most 'maxDrawCount' draws). The run holds a single draw command if multi draw is disabled. Instances of a run are
+// fetched relative to the instances of its first draw command; a draw command can only join the run if its instances
+// are stored after the first draw command instances (and within the instance id stream capacity).
+static const DrawCmd* FindMultiDrawRunEnd( const DrawCmd* runBegin, const DrawCmd* drawEnd, const bool useMultiDraw, const u32 maxDrawCount )
+{
+    const DrawCmd* runEnd = runBegin + 1;
+    if ( !useMultiDraw || maxDrawCount < 2u ) {
+        return runEnd;
+    }
+
+    const u32 firstInstance = runBegin->infos.instanceDataOffset;
+
+    u32 drawCount = 1u;
+    for ( ; runEnd != drawEnd && drawCount < maxDrawCount; runEnd++, drawCount++ ) {
+        const DrawCommandInfos& cmdInfos = runEnd->infos;
+
+        if ( cmdInfos.instanceDataOffset < firstInstance
+          || ( cmdInfos.instanceDataOffset + cmdInfos.instanceCount - firstInstance ) > MAX_INDIRECT_INSTANCE_COUNT
+          || !CanShareMultiDraw( runBegin->infos, cmdInfos ) ) {
+            break;
+        }
+    }
+
+    return runEnd;
+}
+
+// Write the indirect arguments of the multi draws recording the draw commands [drawBegin..drawEnd[ (runs of a single
+// draw command are recorded with a regular draw call and have no arguments). Return the number of arguments written.
+static u32 BuildIndirectArgs( const DrawCmd* drawBegin, const DrawCmd* drawEnd, const bool useMultiDraw, DrawIndexedIndirectArgs* indirectArgs )
+{
+    u32 argsCount = 0u;
+    for ( const DrawCmd* runBegin = drawBegin; runBegin != drawEnd; ) {
+        const DrawCmd* runEnd = FindMultiDrawRunEnd( runBegin, drawEnd, useMultiDraw, MAX_INDIRECT_DRAW_COUNT - argsCount );
+        if ( ( runEnd - runBegin ) > 1 ) {
+            // Instances are fetched relative to the first instance of the run (see the instance id stream).
+            for ( const DrawCmd* cmd = runBegin; cmd != runEnd; cmd++ ) {
+                DrawIndexedIndirectArgs& args = indirectArgs[argsCount++];
+                args.IndexCountPerInstance = cmd->infos.indiceBufferCount;
+                args.InstanceCount = cmd->infos.instanceCount;
+                args.StartIndexLocation = cmd->infos.indiceBufferOffset;
+                args.BaseVertexLocation = 0;
+                args.StartInstanceLocation = cmd->infos.instanceDataOffset - runBegin->infos.instanceDataOffset;
+            }
+        }
+
+        runBegin = runEnd;
+    }
+
+    return argsCount;
+}
 
 WorldRenderModule::WorldRenderModule()
     : pickingBuffer( nullptr )
@@ -54,7 +150,10 @@ WorldRenderModule::WorldRenderModule()
     , pickedEntityId( Entity::INVALID_ID )
     , isResultAvailable( false )
     , brdfDfgLut( nullptr )
+    , instanceIdBuffer( nullptr )
+    , isMultiDrawIndirectSupported( false )
 {
+    memset( indirectArgsBuffers, 0, sizeof( Buffer* ) * INDIRECT_DRAW_PASS_COUNT * FrameGraph::MAX_RECORDING_CHUNK_COUNT );
 
 }
 
@@ -74,6 +173,20 @@ void WorldRenderModule::destroy( RenderDevice& renderDevice )
 		renderDevice.destroyBuffer( pickingReadbackBuffer );
         pickingReadbackBuffer = nullptr;
 	}
+
+    if ( instanceIdBuffer != nullptr ) {
+        renderDevice.destroyBuffer( instanceIdBuffer );
+        instanceIdBuffer = nullptr;
+    }
+
+    for ( u32 passIdx = 0; passIdx < INDIRECT_DRAW_PASS_COUNT; passIdx++ ) {
+        for ( u32 chunkIdx = 0; chunkIdx < FrameGraph::MAX_RECORDING_CHUNK_COUNT; chunkIdx++ ) {
+            if ( indirectArgsBuffers[passIdx][chunkIdx] != nullptr ) {
+                renderDevice.destroyBuffer( indirectArgsBuffers[passIdx][chunkIdx] );
+                indirectArgsBuffers[passIdx][chunkIdx] = nullptr;
+            }
+        }
+    }
 }
 
 void WorldRenderModule::loadCachedResources( RenderDevice& renderDevice, GraphicsAssetCache& graphicsAssetCache )
@@ -98,6 +211,40 @@ void WorldRenderModule::loadCachedResources( RenderDevice& renderDevice, Graphic
 	renderDevice.setDebugMarker( *pickingBuffer, DUSK_STRING( "PickingBuffer" ) );
 	renderDevice.setDebugMarker( *pickingReadbackBuffer, DUSK_STRING( "ReadBackPickingBuffer" ) );
 #endif
+
+    // Create the instance id stream (shared by every draw of the geometry passes).
+    std::vector<u32> instanceIds( MAX_INDIRECT_INSTANCE_COUNT );
+    for ( u32 i = 0; i < MAX_INDIRECT_INSTANCE_COUNT; i++ ) {
+        instanceIds[i] = i;
+    }
+
+    BufferDesc instanceIdBufferDesc;
+    instanceIdBufferDesc.BindFlags = RESOURCE_BIND_VERTEX_BUFFER;
+    instanceIdBufferDesc.SizeInBytes = MAX_INDIRECT_INSTANCE_COUNT * sizeof( u32 );
+    instanceIdBufferDesc.StrideInBytes = sizeof( u32 );
+    instanceIdBufferDesc.Usage = RESOURCE_USAGE_STATIC;
+
+    instanceIdBuffer = renderDevice.createBuffer( instanceIdBufferDesc, instanceIds.data() );
+
+    // Create the indirect arguments buffers (only if the device can replay multi draws).
+    isMultiDrawIndirectSupported = renderDevice.hasMultiDrawIndirect();
+    if ( isMultiDrawIndirectSupported ) {
+        BufferDesc indirectArgsBufferDesc;
+        indirectArgsBufferDesc.BindFlags = RESOURCE_BIND_INDIRECT_ARGUMENTS;
+        indirectArgsBufferDesc.SizeInBytes = MAX_INDIRECT_DRAW_COUNT * sizeof( DrawIndexedIndirectArgs );
+        indirectArgsBufferDesc.StrideInBytes = sizeof( DrawIndexedIndirectArgs );
+        indirectArgsBufferDesc.Usage = RESOURCE_USAGE_DYNAMIC;
+
+        for ( u32 passIdx = 0; passIdx < INDIRECT_DRAW_PASS_COUNT; passIdx++ ) {
+            for ( u32 chunkIdx = 0; chunkIdx < FrameGraph::MAX_RECORDING_CHUNK_COUNT; chunkIdx++ ) {
+                indirectArgsBuffers[passIdx][chunkIdx] = renderDevice.createBuffer( indirectArgsBufferDesc );
+            }
+        }
+    }
+
+#if DUSK_DEVBUILD
+    renderDevice.setDebugMarker( *instanceIdBuffer, DUSK_STRING( "WorldInstanceIdBuffer" ) );
+#endif
 }
 
 FGHandle WorldRenderModule::addPrimitiveLightPass( FrameGraph& frameGraph, FGHandle perSceneBuffer, FGHandle lightClusters, FGHandle itemList, FGHandle depthPrepassBuffer, Material::RenderScenario scenario, Image* iblDiffuse, Image* iblSpecular, const dkMat4x4f& globalShadowMatrix )
@@ -125,8 +272,12 @@ FGHandle WorldRenderModule::addPrimitiveLightPass( FrameGraph& frameGraph, FGHan
         clearPickingBuffer( frameGraph );
     }
 
-    PassData& data = frameGraph.addRenderPass<PassData>(
-        "Forward+ Light Pass",
+    constexpr const char* PassName = "Forward+ Light Pass";
+    constexpr dkStringHash_t PassNameHashcode = DUSK_STRING_HASH( PassName );
+
+    PassData& data = frameGraph.addParallelRenderPass<PassData>(
+        PassName, PassNameHashcode,
+        WorldRecordingChunkCount,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             ImageDesc rtDesc;
             rtDesc.dimension = ImageDesc::DIMENSION_2D;
@@ -181,7 +332,7 @@ FGHandle WorldRenderModule::addPrimitiveLightPass( FrameGraph& frameGraph, FGHan
             passData.CSMSlices = builder.retrievePersistentImage( CascadedShadowRenderModule::SliceImageHashcode );
             passData.ClustersItemListBuffer = builder.readReadOnlyBuffer( itemList );
         },
-        [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache ) {
+        [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk ) {
             Image* outputTarget = resources->getImage( passData.output );
             Image* zbufferTarget = resources->getImage( passData.depthBuffer );
 
@@ -209,7 +360,10 @@ FGHandle WorldRenderModule::addPrimitiveLightPass( FrameGraph& frameGraph, FGHan
             FramebufferAttachment FramebufferAttachments[1] = { 
                 FramebufferAttachment( outputTarget )
             };
-            cmdList->clearRenderTargets( Framebuffer, 1u, ClearValue );
+
+            if ( chunk.isFirst() ) {
+                cmdList->clearRenderTargets( Framebuffer, 1u, ClearValue );
+            }
 
             // Update viewport (using image quality scaling)
             const CameraData* camera = resources->getMainCamera();
@@ -237,79 +391,123 @@ FGHandle WorldRenderModule::addPrimitiveLightPass( FrameGraph& frameGraph, FGHan
             // Retrieve draw commands for the pass.
             const FrameGraphResources::DrawCmdBucket& bucket = resources->getDrawCmdBucket( DrawCommandKey::LAYER_WORLD, DrawCommandKey::WORLD_VIEWPORT_LAYER_DEFAULT );
 
+            const DrawCmd* drawBegin;
+            const DrawCmd* drawEnd;
+
             PerPassData perPassData;
-            perPassData.StartVector = bucket.instanceDataStartOffset;
+            GetChunkDrawRange( bucket, chunk, drawBegin, drawEnd );
 			perPassData.VectorPerInstance = bucket.vectorPerInstance;
 			perPassData.SunShadowMatrix = globalShadowMatrix;
 
-            for ( const DrawCmd& cmd : bucket ) {
-                const DrawCommandInfos& cmdInfos = cmd.infos;
-                const Material* material = cmdInfos.material;
-
-                // Upload vector buffer offset
-				cmdList->updateBuffer( *perPassBuffer, &perPassData, sizeof( PerPassData ) );
-
-                // Retrieve the PipelineState for the given RenderScenario.
-                // TODO Cache the current PSO binded (if the PSO is the same; don't rebind anything).
-                // TODO We need to make material mutable (since the scenario bind updates the streaming/caching).
-                //      It simply require some refactoring at higher level (Mesh struct; gfx cache; etc.)
-                const_cast<Material*>( material )->bindForScenario( scenario, cmdList, psoCache, samplerCount );
-
-                cmdList->setViewport( vp );
-                cmdList->setScissor( sr );
+            // Upload the arguments of the multi draws recorded by this chunk.
+            const bool useMultiDraw = ( isMultiDrawIndirectSupported && WorldUseMultiDrawIndirect );
+            Buffer* indirectArgsBuffer = indirectArgsBuffers[INDIRECT_DRAW_PASS_LIGHT][chunk.Index];
 
-                // NOTE Since buffer registers are cached those calls have a low cost on the CPU side.
-				cmdList->bindBuffer( InstanceVectorBufferHashcode, vectorBuffer );
-                cmdList->bindConstantBuffer( PerViewBufferHashcode, perViewBuffer );
-                cmdList->bindConstantBuffer( PerPassBufferHashcode, perPassBuffer );
-
-                if ( !material->skipLighting() ) {
-                    cmdList->bindConstantBuffer( PerWorldBufferHashcode, perWorldBuffer );
-                    cmdList->bindSampler( BRDFInputSamplerHashcode, materialSampler );
-                }
-
-                cmdList->bindImage( BrdfDfgLUTHascode, brdfDfgLut );
-                cmdList->bindImage( IBLDiffuseHascode, iblDiffuse );
-                cmdList->bindImage( IBLSpecularHascode, iblSpecular );
-                cmdList->bindImage( CascadedShadowRenderModule::SliceImageHashcode, sliceShadow );
-
-                if ( isInMaterialEdition ) {
-                    cmdList->bindConstantBuffer( MaterialEditorBufferHashcode, materialEdBuffer );
-                }
+            DrawIndexedIndirectArgs indirectArgs[MAX_INDIRECT_DRAW_COUNT];
+            const u32 indirectArgsCount = BuildIndirectArgs( drawBegin, drawEnd, useMultiDraw, indirectArgs );
+            if ( indirectArgsCount != 0u ) {
+                cmdList->updateBuffer( *indirectArgsBuffer, indirectArgs, indirectArgsCount * sizeof( DrawIndexedIndirectArgs ) );
+            }
 
-                if ( isPickingRequested ) {
-                    cmdList->bindBuffer( PickingBufferHashcode, pickingBuffer );
+            // Record the draw commands [rangeBegin..rangeEnd[ (consecutive draws sharing the same states are collapsed into
+            // a multi draw if 'useMultiDrawForRange' is true).
+            u32 indirectArgsOffset = 0u;
+            auto recordDrawRange = [&]( const DrawCmd* rangeBegin, const DrawCmd* rangeEnd, const bool useMultiDrawForRange ) {
+                for ( const DrawCmd* runBegin = rangeBegin; runBegin != rangeEnd; ) {
+                    const DrawCmd* runEnd = FindMultiDrawRunEnd( runBegin, rangeEnd, useMultiDrawForRange, MAX_INDIRECT_DRAW_COUNT - indirectArgsOffset );
+                    const DrawCommandInfos& cmdInfos = runBegin->infos;
+                    const Material* material = cmdInfos.material;
+
+                    // Upload vector buffer offset
+                    perPassData.StartVector = static_cast< f32 >( cmdInfos.instanceDataOffset ) * bucket.vectorPerInstance;
+					cmdList->updateBuffer( *perPassBuffer, &perPassData, sizeof( PerPassData ) );
+
+                    // Retrieve the PipelineState for the given RenderScenario.
+                    // NOTE Redundant bindings (e.g. consecutive draws using the same material) are dropped by the CommandList.
+                    // TODO We need to make material mutable (since the scenario bind updates the streaming/caching).
+                    //      It simply require some refactoring at higher level (Mesh struct; gfx cache; etc.)
+                    const_cast<Material*>( material )->bindForScenario( scenario, cmdList, psoCache, samplerCount );
+
+                    cmdList->setViewport( vp );
+                    cmdList->setScissor( sr );
+
+                    // NOTE Since buffer registers are cached those calls have a low cost on the CPU side.
+					cmdList->bindBuffer( InstanceVectorBufferHashcode, vectorBuffer );
+                    cmdList->bindConstantBuffer( PerViewBufferHashcode, perViewBuffer );
+                    cmdList->bindConstantBuffer( PerPassBufferHashcode, perPassBuffer );
+
+                    if ( !material->skipLighting() ) {
+                        cmdList->bindConstantBuffer( PerWorldBufferHashcode, perWorldBuffer );
+                        cmdList->bindSampler( BRDFInputSamplerHashcode, materialSampler );
+                    }
+
+                    cmdList->bindImage( BrdfDfgLUTHascode, brdfDfgLut );
+                    cmdList->bindImage( IBLDiffuseHascode, iblDiffuse );
+                    cmdList->bindImage( IBLSpecularHascode, iblSpecular );
+                    cmdList->bindImage( CascadedShadowRenderModule::SliceImageHashcode, sliceShadow );
+
+                    if ( isInMaterialEdition ) {
+                        cmdList->bindConstantBuffer( MaterialEditorBufferHashcode, materialEdBuffer );
+                    }
+
+                    if ( isPickingRequested ) {
+                        cmdList->bindBuffer( PickingBufferHashcode, pickingBuffer );
+                    }
+
+                    cmdList->bindBuffer( CascadedShadowRenderModule::SliceBufferHashcode, sliceBuffer );
+
+                    cmdList->bindImage( ClustersBufferHashcode, lightClusters );
+                    cmdList->bindBuffer( ItemListBufferHashcode, itemList );
+
+                    // Re-setup the framebuffer (some permutations have a different framebuffer layout).
+                    cmdList->setupFramebuffer( FramebufferAttachments, FramebufferAttachment( zbufferTarget ) );
+                    cmdList->prepareAndBindResourceList();
+
+                    const Buffer* bufferList[4] = { 
+                        cmdInfos.vertexBuffers[eMeshAttribute::Position].BufferObject,
+                        cmdInfos.vertexBuffers[eMeshAttribute::Normal].BufferObject,
+                        cmdInfos.vertexBuffers[eMeshAttribute::UvMap_0].BufferObject,
+                        instanceIdBuffer
+                    };
+
+                    const u32 bufferOffsets[4] = {
+                        cmdInfos.vertexBuffers[eMeshAttribute::Position].OffsetInBytes,
+                        0u,
+                        0u,
+                        0u
+                    };
+
+                    // Bind vertex buffers
+                    cmdList->bindVertexBuffer( ( const Buffer** )bufferList, bufferOffsets, 4, 0);
+                    cmdList->bindIndiceBuffer( cmdInfos.indiceBuffer->BufferObject, !cmdInfos.useShortIndices );
+
+                    const u32 runDrawCount = static_cast< u32 >( runEnd - runBegin );
+                    if ( runDrawCount == 1u ) {
+					    cmdList->drawIndexed( cmdInfos.indiceBufferCount, cmdInfos.instanceCount, cmdInfos.indiceBufferOffset );
+                    } else {
+                        cmdList->multiDrawIndexedInstancedIndirect( runDrawCount, indirectArgsBuffer, indirectArgsOffset * sizeof( DrawIndexedIndirectArgs ), sizeof( DrawIndexedIndirectArgs ) );
+                        indirectArgsOffset += runDrawCount;
+                    }
+
+                    runBegin = runEnd;
                 }
+            };
 
-                cmdList->bindBuffer( CascadedShadowRenderModule::SliceBufferHashcode, sliceBuffer );
-
-                cmdList->bindImage( ClustersBufferHashcode, lightClusters );
-                cmdList->bindBuffer( ItemListBufferHashcode, itemList );
-
-                // Re-setup the framebuffer (some permutations have a different framebuffer layout).
-                cmdList->setupFramebuffer( FramebufferAttachments, FramebufferAttachment( zbufferTarget ) );
-                cmdList->prepareAndBindResourceList();
-
-                const Buffer* bufferList[3] = { 
-                    cmdInfos.vertexBuffers[eMeshAttribute::Position].BufferObject,
-                    cmdInfos.vertexBuffers[eMeshAttribute::Normal].BufferObject,
-                    cmdInfos.vertexBuffers[eMeshAttribute::UvMap_0].BufferObject
-                };
-
-                const u32 bufferOffsets[3] = {
-                    cmdInfos.vertexBuffers[eMeshAttribute::Position].OffsetInBytes,
-                    0u,
-                    0u
-                };
+            recordDrawRange( drawBegin, drawEnd, useMultiDraw );
 
-                // Bind vertex buffers
-                cmdList->bindVertexBuffer( ( const Buffer** )bufferList, bufferOffsets, 3, 0);
-                cmdList->bindIndiceBuffer( cmdInfos.indiceBuffer->BufferObject, !cmdInfos.useShortIndices );
-
-				cmdList->drawIndexed( cmdInfos.indiceBufferCount, cmdInfos.instanceCount, cmdInfos.indiceBufferOffset );
+            // Picking readback is done once the last chunk has been recorded.
+            if ( !chunk.isLast() ) {
+                cmdList->popEventMarker();
+                return;
+            }
 
-				// Update vector buffer offset data
-				perPassData.StartVector += ( cmdInfos.instanceCount * bucket.vectorPerInstance );
+            // Translucent geometry is blended on top of the opaque geometry: the last chunk records it once every opaque
+            // draw has been recorded (draws are recorded one by one to preserve the back to front order).
+            const FrameGraphResources::DrawCmdBucket& translucentBucket = resources->getDrawCmdBucket( DrawCommandKey::LAYER_TRANSLUCENT, DrawCommandKey::TRANSLUCENT_VIEWPORT_LAYER_DEFAULT );
+            if ( translucentBucket.begin() != translucentBucket.end() ) {
+                cmdList->pushEventMarker( DUSK_STRING( "Translucent Geometry" ) );
+                recordDrawRange( translucentBucket.begin(), translucentBucket.end(), false );
+                cmdList->popEventMarker();
             }
 
             // TODO Might worth moving the copy call to a copy command queue?
@@ -351,8 +549,12 @@ WorldRenderModule::PrePassOutput WorldRenderModule::addGeometryPrepass( FrameGra
         FGHandle VectorDataBuffer;
     };
 
-    PassData& data = frameGraph.addRenderPass<PassData>(
-        "WorldRenderModule::GeometryPrePass",
+    constexpr const char* PassName = "WorldRenderModule::GeometryPrePass";
+    constexpr dkStringHash_t PassNameHashcode = DUSK_STRING_HASH( PassName );
+
+    PassData& data = frameGraph.addParallelRenderPass<PassData>(
+        PassName, PassNameHashcode,
+        WorldRecordingChunkCount,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             ImageDesc zBufferRenderTargetDesc;
             zBufferRenderTargetDesc.dimension = ImageDesc::DIMENSION_2D;
@@ -390,7 +592,7 @@ WorldRenderModule::PrePassOutput WorldRenderModule::addGeometryPrepass( FrameGra
 
             passData.PerViewBuffer = builder.retrievePerViewBuffer();
         },
-        [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache ) {
+        [=]( const PassData& passData, const FrameGraphResources* resources, CommandList* cmdList, PipelineStateCache* psoCache, const FGRecordingChunk& chunk ) {
             Image* zbufferTarget = resources->getImage( passData.DepthBuffer );
             Image* gbuffer = resources->getImage( passData.GBuffer );
             Image* velocity = resources->getImage( passData.VelocityBuffer );
@@ -409,8 +611,10 @@ WorldRenderModule::PrePassOutput WorldRenderModule::addGeometryPrepass( FrameGra
                 velocity
             };
 
-            cmdList->clearRenderTargets( FrameBuffer, 2u, ClearValues );
-            cmdList->clearDepthStencil( zbufferTarget, 0.0f );
+            if ( chunk.isFirst() ) {
+                cmdList->clearRenderTargets( FrameBuffer, 2u, ClearValues );
+                cmdList->clearDepthStencil( zbufferTarget, 0.0f );
+            }
 
             // Update viewport (using image quality scaling)
             const CameraData* camera = resources->getMainCamera();
@@ -439,15 +643,31 @@ WorldRenderModule::PrePassOutput WorldRenderModule::addGeometryPrepass( FrameGra
             // Retrieve draw commands for the pass.
             const FrameGraphResources::DrawCmdBucket& bucket = resources->getDrawCmdBucket( DrawCommandKey::LAYER_DEPTH, DrawCommandKey::DEPTH_VIEWPORT_LAYER_DEFAULT );
 
+            const DrawCmd* drawBegin;
+            const DrawCmd* drawEnd;
+
             PerPassData perPassData;
-            perPassData.StartVector = bucket.instanceDataStartOffset;
+            GetChunkDrawRange( bucket, chunk, drawBegin, drawEnd );
             perPassData.VectorPerInstance = bucket.vectorPerInstance;
 
-            for ( const DrawCmd& cmd : bucket ) {
-                const DrawCommandInfos& cmdInfos = cmd.infos;
+            // Upload the arguments of the multi draws recorded by this chunk.
+            const bool useMultiDraw = ( isMultiDrawIndirectSupported && WorldUseMultiDrawIndirect );
+            Buffer* indirectArgsBuffer = indirectArgsBuffers[INDIRECT_DRAW_PASS_DEPTH][chunk.Index];
+
+            DrawIndexedIndirectArgs indirectArgs[MAX_INDIRECT_DRAW_COUNT];
+            const u32 indirectArgsCount = BuildIndirectArgs( drawBegin, drawEnd, useMultiDraw, indirectArgs );
+            if ( indirectArgsCount != 0u ) {
+                cmdList->updateBuffer( *indirectArgsBuffer, indirectArgs, indirectArgsCount * sizeof( DrawIndexedIndirectArgs ) );
+            }
+
+            u32 indirectArgsOffset = 0u;
+            for ( const DrawCmd* runBegin = drawBegin; runBegin != drawEnd; ) {
+                const DrawCmd* runEnd = FindMultiDrawRunEnd( runBegin, drawEnd, useMultiDraw, MAX_INDIRECT_DRAW_COUNT - indirectArgsOffset );
+                const DrawCommandInfos& cmdInfos = runBegin->infos;
                 const Material* material = cmdInfos.material;
 
                 // Upload vector buffer offset
+                perPassData.StartVector = static_cast< f32 >( cmdInfos.instanceDataOffset ) * bucket.vectorPerInstance;
 				cmdList->updateBuffer( *perPassBuffer, &perPassData, sizeof( PerPassData ) );
 
                 // Retrieve the PipelineState for the given RenderScenario.
@@ -466,26 +686,33 @@ WorldRenderModule::PrePassOutput WorldRenderModule::addGeometryPrepass( FrameGra
                 cmdList->setupFramebuffer( Framebuffer, FramebufferAttachment( zbufferTarget ) );
                 cmdList->prepareAndBindResourceList();
 
-                const Buffer* bufferList[3] = { 
+                const Buffer* bufferList[4] = { 
 					cmdInfos.vertexBuffers[eMeshAttribute::Position].BufferObject,
 					cmdInfos.vertexBuffers[eMeshAttribute::Normal].BufferObject,
-					cmdInfos.vertexBuffers[eMeshAttribute::UvMap_0].BufferObject
+					cmdInfos.vertexBuffers[eMeshAttribute::UvMap_0].BufferObject,
+                    instanceIdBuffer
                 };
 
-                const u32 bufferOffsets[3] = {
+                const u32 bufferOffsets[4] = {
                     cmdInfos.vertexBuffers[eMeshAttribute::Position].OffsetInBytes,
                     0u,
+                    0u,
                     0u
                 };
 
                 // Bind vertex buffers
-                cmdList->bindVertexBuffer( ( const Buffer** )bufferList, bufferOffsets, 3u );
+                cmdList->bindVertexBuffer( ( const Buffer** )bufferList, bufferOffsets, 4u );
                 cmdList->bindIndiceBuffer( cmdInfos.indiceBuffer->BufferObject, !cmdInfos.useShortIndices );
 
-				cmdList->drawIndexed( cmdInfos.indiceBufferCount, cmdInfos.instanceCount, cmdInfos.indiceBufferOffset );
+                const u32 runDrawCount = static_cast< u32 >( runEnd - runBegin );
+                if ( runDrawCount == 1u ) {
+				    cmdList->drawIndexed( cmdInfos.indiceBufferCount, cmdInfos.instanceCount, cmdInfos.indiceBufferOffset );
+                } else {
+                    cmdList->multiDrawIndexedInstancedIndirect( runDrawCount, indirectArgsBuffer, indirectArgsOffset * sizeof( DrawIndexedIndirectArgs ), sizeof( DrawIndexedIndirectArgs ) );
+                    indirectArgsOffset += runDrawCount;
+                }
 
-				// Update vector buffer offset data
-				perPassData.StartVector += ( cmdInfos.instanceCount * bucket.vectorPerInstance );
+                runBegin = runEnd;
             }
 
             cmdList->popEventMarker();
@@ -505,7 +732,7 @@ void WorldRenderModule::clearPickingBuffer( FrameGraph& frameGraph )
 	struct PassDataDummy {};
 
 	frameGraph.addRenderPass<PassDataDummy>(
-		BuiltIn::ClearPickingBuffer_Name,
+		BuiltIn::ClearPickingBuffer_Name, BuiltIn::ClearPickingBuffer_NameHashcode,
 		[&]( FrameGraphBuilder& builder, PassDataDummy& passData ) {
 		    builder.setUncullablePass();
 		    builder.useAsyncCompute();
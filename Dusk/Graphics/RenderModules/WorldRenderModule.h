@@ -53,6 +53,14 @@ public:
 
 	void				setDefaultBrdfDfgLut( Image* brdfDfgLut );
 
+private:
+	// Geometry passes recording multi draws.
+	enum eIndirectDrawPass {
+		INDIRECT_DRAW_PASS_LIGHT = 0,
+		INDIRECT_DRAW_PASS_DEPTH,
+		INDIRECT_DRAW_PASS_COUNT
+	};
+
 private:
 	// Buffer used to store picking infos on the GPU.
 	Buffer*				pickingBuffer;
@@ -73,6 +81,16 @@ private:
 	// most likely be refactored in the future.
 	Image*				brdfDfgLut;
 
+	// Per-instance vertex stream holding the index of each instance (instance 'N' stores 'N'). Multi draws offset this
+	// stream with the start instance of each draw so that the shaders can fetch per-instance data from the vector buffer.
+	Buffer*				instanceIdBuffer;
+
+	// Indirect draw arguments (one buffer per geometry pass and recording chunk).
+	Buffer*				indirectArgsBuffers[INDIRECT_DRAW_PASS_COUNT][FrameGraph::MAX_RECORDING_CHUNK_COUNT];
+
+	// True if the active RenderDevice supports multi draw indirect; false otherwise.
+	bool				isMultiDrawIndirectSupported;
+
 private:
 	void				clearPickingBuffer( FrameGraph& frameGraph );
 };
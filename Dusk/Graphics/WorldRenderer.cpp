@@ -14,6 +14,7 @@
 #include <Rendering/CommandList.h>
 
 #include "LightGrid.h"
+#include "DrawCommandSorter.h"
 #include "EnvironmentProbeStreaming.h"
 
 #include "RenderModules/AtmosphereRenderModule.h"
@@ -32,69 +33,11 @@
 DUSK_ENV_VAR( EnableTAA, false, bool ); // "Enable Temporal AntiAliasing [false/true]
 DUSK_ENV_VAR( ComputeDFGLUTRuntime, false, bool ); // "Compute BRDF DFG LUT at runtime (don't load from disk) [false/true]"
 
-static constexpr size_t MAX_DRAW_CMD_COUNT = 4096;
+// Initial capacity of the draw command storage (grows if a frame needs more draw commands).
+static constexpr u32 DEFAULT_DRAW_CMD_CAPACITY = 4096u;
 
-void RadixSort( DrawCmd* DUSK_RESTRICT _keys, DrawCmd* DUSK_RESTRICT _tempKeys, const size_t size )
-{
-    static constexpr size_t RADIXSORT_BITS = 11;
-    static constexpr size_t RADIXSORT_HISTOGRAM_SIZE = ( 1 << RADIXSORT_BITS );
-    static constexpr size_t RADIXSORT_BIT_MASK = ( RADIXSORT_HISTOGRAM_SIZE - 1 );
-
-    DrawCmd * keys = _keys;
-    DrawCmd * tempKeys = _tempKeys;
-
-    uint32_t histogram[RADIXSORT_HISTOGRAM_SIZE];
-    uint16_t shift = 0;
-    uint32_t pass = 0;
-    for ( ; pass < 6; ++pass ) {
-        memset( histogram, 0, sizeof( uint32_t ) * RADIXSORT_HISTOGRAM_SIZE );
-
-        bool sorted = true;
-        {
-            uint64_t key = keys[0].key.value;
-            uint64_t prevKey = key;
-            for ( uint32_t ii = 0; ii < size; ++ii, prevKey = key ) {
-                key = keys[ii].key.value;
-
-                uint16_t index = ( ( key >> shift ) & RADIXSORT_BIT_MASK );
-                ++histogram[index];
-
-                sorted &= ( prevKey <= key );
-            }
-        }
-
-        if ( sorted ) {
-            goto done;
-        }
-
-        uint32_t offset = 0;
-        for ( uint32_t ii = 0; ii < RADIXSORT_HISTOGRAM_SIZE; ++ii ) {
-            uint32_t count = histogram[ii];
-            histogram[ii] = offset;
-
-            offset += count;
-        }
-
-        for ( uint32_t ii = 0; ii < size; ++ii ) {
-            uint64_t key = keys[ii].key.value;
-            uint16_t index = ( ( key >> shift ) & RADIXSORT_BIT_MASK );
-            uint32_t dest = histogram[index]++;
-
-            tempKeys[dest] = keys[ii];
-        }
-
-        DrawCmd * swapKeys = tempKeys;
-        tempKeys = keys;
-        keys = swapKeys;
-
-        shift += RADIXSORT_BITS;
-    }
-
-done:
-    if ( ( pass & 1 ) != 0 ) {
-        memcpy( _keys, _tempKeys, size * sizeof( DrawCmd ) );
-    }
-}
+// Capacity of the GPU shadow cull command storage.
+static constexpr size_t MAX_GPU_SHADOW_DRAW_CMD_COUNT = 4096;
 
 WorldRenderer::WorldRenderer( BaseAllocator* allocator )
     : automaticExposure( dk::core::allocate<AutomaticExposureModule>( allocator ) )
@@ -104,10 +47,12 @@ WorldRenderer::WorldRenderer( BaseAllocator* allocator )
     , WorldRendering( dk::core::allocate<WorldRenderModule>( allocator ) )
     , memoryAllocator( allocator )
     , primitiveCache( dk::core::allocate<PrimitiveCache>( allocator ) )
-    , drawCmdAllocator( dk::core::allocate<LinearAllocator>( allocator, sizeof( DrawCmd ) * MAX_DRAW_CMD_COUNT, allocator->allocate( sizeof( DrawCmd ) * MAX_DRAW_CMD_COUNT ) ) )
-	, gpuShadowCullAllocator( dk::core::allocate<LinearAllocator>( allocator, sizeof( GPUShadowDrawCmd )* MAX_DRAW_CMD_COUNT, allocator->allocate( sizeof( GPUShadowDrawCmd )* MAX_DRAW_CMD_COUNT ) ) )
+    , drawCmds( dk::core::allocateArray<DrawCmd>( allocator, DEFAULT_DRAW_CMD_CAPACITY ) )
+    , drawCmdCount( 0u )
+    , drawCmdCapacity( DEFAULT_DRAW_CMD_CAPACITY )
+    , drawCmdSorter( nullptr )
+	, gpuShadowCullAllocator( dk::core::allocate<LinearAllocator>( allocator, sizeof( GPUShadowDrawCmd )* MAX_GPU_SHADOW_DRAW_CMD_COUNT, allocator->allocate( sizeof( GPUShadowDrawCmd )* MAX_GPU_SHADOW_DRAW_CMD_COUNT ) ) )
     , frameGraph( nullptr )
-    , frameDrawCmds( dk::core::allocateArray<DrawCmd>( allocator, sizeof( DrawCmd )* MAX_DRAW_CMD_COUNT ) )
     , needResourcePrecompute( true )
     , wireframeMaterial( nullptr )
     , brdfDfgLut( nullptr )
@@ -128,10 +73,12 @@ WorldRenderer::~WorldRenderer()
 	dk::core::free( memoryAllocator, atmosphereRendering );
     dk::core::free( memoryAllocator, WorldRendering );
     dk::core::free( memoryAllocator, primitiveCache );
-	dk::core::free( memoryAllocator, drawCmdAllocator );
+	dk::core::freeArray( memoryAllocator, drawCmds );
+	if ( drawCmdSorter != nullptr ) {
+		dk::core::free( memoryAllocator, drawCmdSorter );
+	}
 	dk::core::free( memoryAllocator, gpuShadowCullAllocator );
     dk::core::free( memoryAllocator, frameGraph );
-    dk::core::free( memoryAllocator, frameDrawCmds );
     dk::core::free( memoryAllocator, lightGrid );
     dk::core::free( memoryAllocator, environmentProbeStreaming );
 	dk::core::free( memoryAllocator, cascadedShadowMapRendering );
@@ -168,9 +115,10 @@ void WorldRenderer::destroy( RenderDevice* renderDevice )
     WorldRendering->destroy( *renderDevice );
 }
 
-void WorldRenderer::loadCachedResources( RenderDevice* renderDevice, ShaderCache* shaderCache, GraphicsAssetCache* graphicsAssetCache, VirtualFileSystem* virtualFileSystem )
+void WorldRenderer::loadCachedResources( RenderDevice* renderDevice, ShaderCache* shaderCache, GraphicsAssetCache* graphicsAssetCache, VirtualFileSystem* virtualFileSystem, JobSystem* jobSystem )
 {
-    frameGraph = dk::core::allocate<FrameGraph>( memoryAllocator, memoryAllocator, renderDevice, virtualFileSystem );
+    frameGraph = dk::core::allocate<FrameGraph>( memoryAllocator, memoryAllocator, renderDevice, virtualFileSystem, jobSystem );
+    drawCmdSorter = dk::core::allocate<DrawCommandSorter>( memoryAllocator, memoryAllocator, jobSystem );
 
     primitiveCache->createCachedGeometry( renderDevice );
     
@@ -240,26 +188,69 @@ void WorldRenderer::drawWorld( RenderDevice* renderDevice, const f32 deltaTime )
 {
     DUSK_CPU_PROFILE_FUNCTION;
 
-    // Sort this frame draw commands.
-    DrawCmd* drawCmds = static_cast< DrawCmd* >( drawCmdAllocator->getBaseAddress() );
-    const size_t drawCmdCount = drawCmdAllocator->getAllocationCount();
+    // Sort this frame draw commands (the sorted commands are either stored in place or in the sorter storage; both
+    // stay untouched until the next frame).
+    DrawCmd* sortedDrawCmds = nullptr;
 
-    RadixSort( drawCmds, frameDrawCmds, drawCmdCount );
+    {
+        DUSK_CPU_PROFILE_SCOPED( "Sort Draw Commands" );
+        sortedDrawCmds = drawCmdSorter->sort( drawCmds, drawCmdCount );
+    }
 
     // Submit commands to each render queue.
-    frameGraph->submitAndDispatchDrawCmds( drawCmds, drawCmdCount );
+    {
+        DUSK_CPU_PROFILE_SCOPED( "Dispatch Draw Commands" );
+        frameGraph->submitAndDispatchDrawCmds( sortedDrawCmds, drawCmdCount );
+    }
 
     // Execute current frame graph.
     frameGraph->execute( renderDevice, deltaTime );
 
     // Reset DrawCmd Pool.
-    drawCmdAllocator->clear();
+    drawCmdCount = 0u;
     gpuShadowCullAllocator->clear();
 }
 
 DrawCmd& WorldRenderer::allocateDrawCmd()
 {
-    return *dk::core::allocate<DrawCmd>( drawCmdAllocator );
+    if ( drawCmdCount == drawCmdCapacity ) {
+        growDrawCmdStorage( drawCmdCount + 1u );
+    }
+
+    return *new ( &drawCmds[drawCmdCount++] ) DrawCmd();
+}
+
+DrawCmd* WorldRenderer::allocateDrawCmds( const u32 count )
+{
+    if ( ( drawCmdCount + count ) > drawCmdCapacity ) {
+        growDrawCmdStorage( drawCmdCount + count );
+    }
+
+    DrawCmd* allocatedDrawCmds = &drawCmds[drawCmdCount];
+    drawCmdCount += count;
+
+    return allocatedDrawCmds;
+}
+
+void WorldRenderer::submitInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd )
+{
+    frameGraph->submitInstanceData( instances, dirtyInstanceBegin, dirtyInstanceEnd );
+}
+
+void WorldRenderer::growDrawCmdStorage( const u32 minimumCapacity )
+{
+    u32 newCapacity = drawCmdCapacity * 2u;
+    while ( newCapacity < minimumCapacity ) {
+        newCapacity *= 2u;
+    }
+
+    DrawCmd* newDrawCmds = dk::core::allocateArray<DrawCmd>( memoryAllocator, newCapacity );
+    memcpy( newDrawCmds, drawCmds, sizeof( DrawCmd ) * drawCmdCount );
+
+    dk::core::freeArray( memoryAllocator, drawCmds );
+
+    drawCmds = newDrawCmds;
+    drawCmdCapacity = newCapacity;
 }
 //
 //DrawCmd& WorldRenderer::allocateSpherePrimitiveDrawCmd()
@@ -22,6 +22,7 @@ class CommandList;
 class FrameGraph;
 class Material;
 class VirtualFileSystem;
+class JobSystem;
 class TextRenderingModule;
 class AutomaticExposureModule;
 class GlareRenderModule;
@@ -34,6 +35,7 @@ class EnvironmentProbeStreaming;
 class CascadedShadowRenderModule;
 class SSRModule;
 class RenderWorld;
+class DrawCommandSorter;
 
 struct CameraData;
 struct Buffer;
@@ -75,14 +77,23 @@ public:
                      ~WorldRenderer();
 
     void             destroy( RenderDevice* renderDevice );
-    void             loadCachedResources( RenderDevice* renderDevice, ShaderCache* shaderCache, GraphicsAssetCache* graphicsAssetCache, VirtualFileSystem* virtualFileSystem );
+    void             loadCachedResources( RenderDevice* renderDevice, ShaderCache* shaderCache, GraphicsAssetCache* graphicsAssetCache, VirtualFileSystem* virtualFileSystem, JobSystem* jobSystem );
 
     void             drawDebugSphere( CommandList& cmdList );
 
     void             drawWorld( RenderDevice* renderDevice, const f32 deltaTime );
 
+    // Allocate a draw command for the current frame (the draw command storage grows if needed). The returned reference
+    // is only valid until the next allocation.
     DrawCmd&            allocateDrawCmd();
 
+    // Allocate 'drawCmdCount' contiguous draw commands for the current frame (the commands are not initialized). The
+    // returned pointer is only valid until the next allocation.
+    DrawCmd*            allocateDrawCmds( const u32 drawCmdCount );
+
+    // Submit the instance data referenced by the draw commands of the current frame (see FrameGraph::submitInstanceData).
+    void                submitInstanceData( const DrawCommandInfos::InstanceData* instances, const u32 dirtyInstanceBegin, const u32 dirtyInstanceEnd );
+
     //DrawCmd&            allocateSpherePrimitiveDrawCmd();
 
     GPUShadowDrawCmd&   allocateGPUShadowCullDrawCmd();
@@ -99,6 +110,11 @@ public:
     // Return the virtual resource handle to the resolved depth buffer (or the regular depth buffer if multisampling is disabled).
     FGHandle      getResolvedDepth();
 
+private:
+    // Grow the capacity of the draw command storage (the capacity is doubled until it can hold 'minimumCapacity'
+    // commands).
+    void             growDrawCmdStorage( const u32 minimumCapacity );
+
 private:
     // The memory allocator owning this instance.
     BaseAllocator*   memoryAllocator;
@@ -106,8 +122,17 @@ private:
     // Cache to precompute and store basic primitives (for debug or special stuff).
     PrimitiveCache*  primitiveCache;
 
-    // Draw Command allocator.
-    LinearAllocator* drawCmdAllocator;
+    // Current frame draw commands.
+    DrawCmd*         drawCmds;
+
+    // Number of draw commands allocated for the current frame.
+    u32              drawCmdCount;
+
+    // Number of draw commands the storage can hold.
+    u32              drawCmdCapacity;
+
+    // Sort the draw commands (by key) before their dispatch to the FrameGraph buckets.
+    DrawCommandSorter* drawCmdSorter;
 
 	// GPU Shadow Cull Command allocator.
 	LinearAllocator* gpuShadowCullAllocator;
@@ -115,9 +140,6 @@ private:
     // The FrameGraph used to render the world.
     FrameGraph*      frameGraph;
 
-    // Current frame draw commands.
-    DrawCmd*         frameDrawCmds;
-
     // If true, RenderModules need to precompute its transistent resources for frame rendering.
     bool             needResourcePrecompute;
 
@@ -0,0 +1,158 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "FrustumCulling.h"
+
+#include "Frustum.h"
+#include "BoundingSphere.h"
+#include "AABB.h"
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( DUSK_SSE42 )
+#include <xmmintrin.h>
+#endif
+
+// Planes tested by the infinite Z culling (the far plane is skipped).
+static constexpr i32 CULLING_PLANE_COUNT = 5;
+static constexpr i32 CULLING_PLANES[CULLING_PLANE_COUNT] = { 0, 1, 2, 3, 5 };
+
+static DUSK_INLINE f32 DistanceToPlane( const dkVec4f& plane, const dkVec3f& point )
+{
+    return dkVec4f::dot( dkVec4f( point, 1.0f ), plane );
+}
+
+f32 dk::maths::CullSphereInfReversedZ( const Frustum& frustum, const dkVec3f& sphereCenter, const f32 sphereRadius )
+{
+    f32 dist01 = Min( DistanceToPlane( frustum.planes[0], sphereCenter ), DistanceToPlane( frustum.planes[1], sphereCenter ) );
+    f32 dist23 = Min( DistanceToPlane( frustum.planes[2], sphereCenter ), DistanceToPlane( frustum.planes[3], sphereCenter ) );
+    f32 dist45 = DistanceToPlane( frustum.planes[5], sphereCenter );
+
+    return Min( Min( dist01, dist23 ), dist45 ) + sphereRadius;
+}
+
+f32 dk::maths::CullSphereInfReversedZ( const Frustum& frustum, const BoundingSphere& sphere )
+{
+    return CullSphereInfReversedZ( frustum, sphere.center, sphere.radius );
+}
+
+f32 dk::maths::CullAABBInfReversedZ( const Frustum& frustum, const AABB& aabb )
+{
+    const dkVec3f boxCenter = ( aabb.minPoint + aabb.maxPoint ) * 0.5f;
+    const dkVec3f boxHalfExtents = ( aabb.maxPoint - aabb.minPoint ) * 0.5f;
+
+    // Distance of the box corner the furthest along each plane normal (the box is outside if this corner is outside).
+    f32 minDistance = std::numeric_limits<f32>::max();
+    for ( i32 planeIdx = 0; planeIdx < CULLING_PLANE_COUNT; planeIdx++ ) {
+        const dkVec4f& plane = frustum.planes[CULLING_PLANES[planeIdx]];
+        const f32 projectedExtent = fabsf( plane.x ) * boxHalfExtents.x + fabsf( plane.y ) * boxHalfExtents.y + fabsf( plane.z ) * boxHalfExtents.z;
+
+        minDistance = Min( minDistance, DistanceToPlane( plane, boxCenter ) + projectedExtent );
+    }
+
+    return minDistance;
+}
+
+// Test the spheres in the [firstSphere..sphereCount[ range and append the visible ones to 'visibleIndexes'.
+static u32 CullSpheresScalar( const Frustum& frustum, const BoundingSphereSoA& spheres, const u32 firstSphere, const u32 sphereCount, u32* visibleIndexes, u32 visibleCount )
+{
+    for ( u32 i = firstSphere; i < sphereCount; i++ ) {
+        const dkVec3f sphereCenter( spheres.CenterX[i], spheres.CenterY[i], spheres.CenterZ[i] );
+
+        // Branchless append (the index is always written; the count only moves forward if the sphere is visible).
+        visibleIndexes[visibleCount] = i;
+        visibleCount += ( dk::maths::CullSphereInfReversedZ( frustum, sphereCenter, spheres.Radius[i] ) > 0.0f ) ? 1u : 0u;
+    }
+
+    return visibleCount;
+}
+
+u32 dk::maths::CullSpheresInfReversedZScalar( const Frustum& frustum, const BoundingSphereSoA& spheres, const u32 sphereCount, u32* visibleIndexes )
+{
+    return CullSpheresScalar( frustum, spheres, 0u, sphereCount, visibleIndexes, 0u );
+}
+
+u32 dk::maths::CullSpheresInfReversedZ( const Frustum& frustum, const BoundingSphereSoA& spheres, const u32 sphereCount, u32* visibleIndexes )
+{
+    u32 visibleCount = 0u;
+    u32 sphereIdx = 0u;
+
+#if defined( __AVX__ )
+    // Splat the planes once for the whole batch.
+    __m256 planeX[CULLING_PLANE_COUNT], planeY[CULLING_PLANE_COUNT], planeZ[CULLING_PLANE_COUNT], planeW[CULLING_PLANE_COUNT];
+    for ( i32 planeIdx = 0; planeIdx < CULLING_PLANE_COUNT; planeIdx++ ) {
+        const dkVec4f& plane = frustum.planes[CULLING_PLANES[planeIdx]];
+        planeX[planeIdx] = _mm256_set1_ps( plane.x );
+        planeY[planeIdx] = _mm256_set1_ps( plane.y );
+        planeZ[planeIdx] = _mm256_set1_ps( plane.z );
+        planeW[planeIdx] = _mm256_set1_ps( plane.w );
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+
+    for ( ; ( sphereIdx + 8u ) <= sphereCount; sphereIdx += 8u ) {
+        const __m256 centerX = _mm256_loadu_ps( spheres.CenterX + sphereIdx );
+        const __m256 centerY = _mm256_loadu_ps( spheres.CenterY + sphereIdx );
+        const __m256 centerZ = _mm256_loadu_ps( spheres.CenterZ + sphereIdx );
+
+        // Same evaluation order as the scalar path (x*x + y*y + z*z + w) so that both paths agree.
+        __m256 minDistance = _mm256_set1_ps( std::numeric_limits<f32>::max() );
+        for ( i32 planeIdx = 0; planeIdx < CULLING_PLANE_COUNT; planeIdx++ ) {
+            __m256 distance = _mm256_mul_ps( centerX, planeX[planeIdx] );
+            distance = _mm256_add_ps( distance, _mm256_mul_ps( centerY, planeY[planeIdx] ) );
+            distance = _mm256_add_ps( distance, _mm256_mul_ps( centerZ, planeZ[planeIdx] ) );
+            distance = _mm256_add_ps( distance, planeW[planeIdx] );
+
+            minDistance = _mm256_min_ps( minDistance, distance );
+        }
+
+        const __m256 visibility = _mm256_add_ps( minDistance, _mm256_loadu_ps( spheres.Radius + sphereIdx ) );
+        const u32 visibilityMask = static_cast< u32 >( _mm256_movemask_ps( _mm256_cmp_ps( visibility, zero, _CMP_GT_OQ ) ) );
+
+        for ( u32 lane = 0u; lane < 8u; lane++ ) {
+            visibleIndexes[visibleCount] = sphereIdx + lane;
+            visibleCount += ( visibilityMask >> lane ) & 1u;
+        }
+    }
+#elif defined( DUSK_SSE42 )
+    __m128 planeX[CULLING_PLANE_COUNT], planeY[CULLING_PLANE_COUNT], planeZ[CULLING_PLANE_COUNT], planeW[CULLING_PLANE_COUNT];
+    for ( i32 planeIdx = 0; planeIdx < CULLING_PLANE_COUNT; planeIdx++ ) {
+        const dkVec4f& plane = frustum.planes[CULLING_PLANES[planeIdx]];
+        planeX[planeIdx] = _mm_set1_ps( plane.x );
+        planeY[planeIdx] = _mm_set1_ps( plane.y );
+        planeZ[planeIdx] = _mm_set1_ps( plane.z );
+        planeW[planeIdx] = _mm_set1_ps( plane.w );
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for ( ; ( sphereIdx + 4u ) <= sphereCount; sphereIdx += 4u ) {
+        const __m128 centerX = _mm_loadu_ps( spheres.CenterX + sphereIdx );
+        const __m128 centerY = _mm_loadu_ps( spheres.CenterY + sphereIdx );
+        const __m128 centerZ = _mm_loadu_ps( spheres.CenterZ + sphereIdx );
+
+        __m128 minDistance = _mm_set1_ps( std::numeric_limits<f32>::max() );
+        for ( i32 planeIdx = 0; planeIdx < CULLING_PLANE_COUNT; planeIdx++ ) {
+            __m128 distance = _mm_mul_ps( centerX, planeX[planeIdx] );
+            distance = _mm_add_ps( distance, _mm_mul_ps( centerY, planeY[planeIdx] ) );
+            distance = _mm_add_ps( distance, _mm_mul_ps( centerZ, planeZ[planeIdx] ) );
+            distance = _mm_add_ps( distance, planeW[planeIdx] );
+
+            minDistance = _mm_min_ps( minDistance, distance );
+        }
+
+        const __m128 visibility = _mm_add_ps( minDistance, _mm_loadu_ps( spheres.Radius + sphereIdx ) );
+        const u32 visibilityMask = static_cast< u32 >( _mm_movemask_ps( _mm_cmpgt_ps( visibility, zero ) ) );
+
+        for ( u32 lane = 0u; lane < 4u; lane++ ) {
+            visibleIndexes[visibleCount] = sphereIdx + lane;
+            visibleCount += ( visibilityMask >> lane ) & 1u;
+        }
+    }
+#endif
+
+    // Remaining spheres (or every sphere if the target has no SIMD support).
+    return CullSpheresScalar( frustum, spheres, sphereIdx, sphereCount, visibleIndexes, visibleCount );
+}
@@ -0,0 +1,46 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+struct Frustum;
+struct BoundingSphere;
+struct AABB;
+
+template <typename Precision, i32 ScalarCount>
+struct Vector;
+using dkVec3f = Vector<f32, 3>;
+
+// Bounding spheres stored as structure of arrays (one array per component). Arrays are owned by the caller.
+struct BoundingSphereSoA
+{
+    f32*    CenterX;
+    f32*    CenterY;
+    f32*    CenterZ;
+    f32*    Radius;
+};
+
+namespace dk
+{
+    namespace maths
+    {
+        // Frustum culling on a sphere. Returns > 0 if visible, <= 0 otherwise
+        // NOTE Infinite Z version (it implicitly skips the far plane check)
+        f32 CullSphereInfReversedZ( const Frustum& frustum, const dkVec3f& sphereCenter, const f32 sphereRadius );
+        f32 CullSphereInfReversedZ( const Frustum& frustum, const BoundingSphere& sphere );
+
+        // Frustum culling on an axis aligned box. Returns > 0 if visible (or partially visible), <= 0 otherwise
+        // NOTE Infinite Z version (it implicitly skips the far plane check)
+        f32 CullAABBInfReversedZ( const Frustum& frustum, const AABB& aabb );
+
+        // Frustum culling on a batch of spheres (infinite Z version). Write the indexes of the visible spheres to
+        // 'visibleIndexes' (in ascending order; must be large enough to hold 'sphereCount' indexes) and return the
+        // number of visible spheres. Spheres are tested 8 at a time (AVX) or 4 at a time (SSE) if the target supports
+        // it; the remaining spheres use the scalar path.
+        u32 CullSpheresInfReversedZ( const Frustum& frustum, const BoundingSphereSoA& spheres, const u32 sphereCount, u32* visibleIndexes );
+
+        // Scalar implementation of CullSpheresInfReversedZ (reference implementation).
+        u32 CullSpheresInfReversedZScalar( const Frustum& frustum, const BoundingSphereSoA& spheres, const u32 sphereCount, u32* visibleIndexes );
+    }
+}
@@ -12,3 +12,216 @@ void CommandList::setFrameIndex( const i32 deviceFrameIndex )
     resourceFrameIndex = ( deviceFrameIndex % RenderDevice::PENDING_FRAME_COUNT );
     frameIndex = deviceFrameIndex;
 }
+
+void CommandList::resetBindingCache()
+{
+    boundPipelineState = nullptr;
+    boundIndiceBuffer = nullptr;
+    boundRenderTargetCount = 0u;
+    boundResourceCount = 0u;
+
+    memset( boundVertexBuffers, 0, sizeof( const Buffer* ) * MAX_VERTEX_BUFFER_BIND_COUNT );
+    memset( boundVertexBufferOffsets, 0, sizeof( u32 ) * MAX_VERTEX_BUFFER_BIND_COUNT );
+
+    isPipelineStateBound = false;
+    isIndiceBuffer32bits = false;
+    isViewportBound = false;
+    isScissorBound = false;
+    isFramebufferBound = false;
+    isResourceListDirty = true;
+
+    bindingStats.IssuedBindCount = 0u;
+    bindingStats.FilteredBindCount = 0u;
+}
+
+void CommandList::invalidateResourceBindings()
+{
+    boundResourceCount = 0u;
+    isResourceListDirty = true;
+}
+
+void CommandList::invalidateInputBuffer( const void* resource )
+{
+    // A backend might unbind a buffer from the input assembler when the buffer is bound as a shader resource.
+    for ( u32 i = 0; i < MAX_VERTEX_BUFFER_BIND_COUNT; i++ ) {
+        if ( boundVertexBuffers[i] == resource ) {
+            boundVertexBuffers[i] = nullptr;
+        }
+    }
+
+    if ( boundIndiceBuffer == resource ) {
+        boundIndiceBuffer = nullptr;
+    }
+}
+
+bool CommandList::shouldBindPipelineState( const PipelineState* pipelineState )
+{
+    if ( isPipelineStateBound && boundPipelineState == pipelineState ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    trackPipelineStateBind( pipelineState );
+    return true;
+}
+
+void CommandList::trackPipelineStateBind( const PipelineState* pipelineState )
+{
+    boundPipelineState = pipelineState;
+    isPipelineStateBound = true;
+
+    // Resources and framebuffer attachments are resolved against the pipeline state bound.
+    isFramebufferBound = false;
+    invalidateResourceBindings();
+
+    bindingStats.IssuedBindCount++;
+}
+
+bool CommandList::shouldBindVertexBuffers( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex )
+{
+    DUSK_DEV_ASSERT( ( startBindIndex + bufferCount ) <= MAX_VERTEX_BUFFER_BIND_COUNT, "Too many vertex buffers bound!" );
+
+    bool isRedundant = true;
+    for ( u32 i = 0; i < bufferCount; i++ ) {
+        const u32 bindIndex = ( startBindIndex + i );
+        const u32 offset = ( offsets != nullptr ) ? offsets[i] : 0u;
+
+        if ( boundVertexBuffers[bindIndex] != buffers[i] || boundVertexBufferOffsets[bindIndex] != offset ) {
+            boundVertexBuffers[bindIndex] = buffers[i];
+            boundVertexBufferOffsets[bindIndex] = offset;
+            isRedundant = false;
+        }
+    }
+
+    if ( isRedundant ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldBindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices )
+{
+    if ( boundIndiceBuffer == buffer && isIndiceBuffer32bits == use32bitsIndices ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    boundIndiceBuffer = buffer;
+    isIndiceBuffer32bits = use32bitsIndices;
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldSetViewport( const Viewport& viewport )
+{
+    if ( isViewportBound && boundViewport == viewport ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    boundViewport = viewport;
+    isViewportBound = true;
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldSetScissor( const ScissorRegion& scissorRegion )
+{
+    if ( isScissorBound && boundScissor == scissorRegion ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    boundScissor = scissorRegion;
+    isScissorBound = true;
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldSetupFramebuffer( const FramebufferAttachment* renderTargetViews, const u32 renderTargetCount, const FramebufferAttachment& depthStencilView, const bool hasSideEffects )
+{
+    DUSK_DEV_ASSERT( renderTargetCount <= MAX_FRAMEBUFFER_ATTACHMENT_COUNT, "Too many render targets bound!" );
+
+    // Only a pure rebind (same attachments, nothing to clear or to begin) can be dropped.
+    bool isRedundant = !hasSideEffects
+                    && isFramebufferBound
+                    && boundRenderTargetCount == renderTargetCount
+                    && boundDepthStencil.ImageAttachment == depthStencilView.ImageAttachment
+                    && boundDepthStencil.ViewDescription.SortKey == depthStencilView.ViewDescription.SortKey;
+
+    for ( u32 i = 0; i < renderTargetCount && isRedundant; i++ ) {
+        isRedundant = ( boundRenderTargets[i].ImageAttachment == renderTargetViews[i].ImageAttachment
+                     && boundRenderTargets[i].ViewDescription.SortKey == renderTargetViews[i].ViewDescription.SortKey );
+    }
+
+    if ( isRedundant ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    for ( u32 i = 0; i < renderTargetCount; i++ ) {
+        boundRenderTargets[i] = renderTargetViews[i];
+    }
+
+    boundDepthStencil = depthStencilView;
+    boundRenderTargetCount = renderTargetCount;
+    isFramebufferBound = true;
+
+    // Binding an image as an attachment unbinds it from the shader resources (the resources must be bound again).
+    invalidateResourceBindings();
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldBindResource( const dkStringHash_t hashcode, const void* resource, const u64 viewKey )
+{
+    for ( u32 i = 0; i < boundResourceCount; i++ ) {
+        CachedResourceBinding& binding = boundResources[i];
+        if ( binding.Hashcode != hashcode ) {
+            continue;
+        }
+
+        if ( binding.Resource == resource && binding.ViewKey == viewKey ) {
+            bindingStats.FilteredBindCount++;
+            return false;
+        }
+
+        binding.Resource = resource;
+        binding.ViewKey = viewKey;
+
+        invalidateInputBuffer( resource );
+        isResourceListDirty = true;
+        bindingStats.IssuedBindCount++;
+        return true;
+    }
+
+    DUSK_DEV_ASSERT( boundResourceCount < MAX_CACHED_RESOURCE_BINDING_COUNT, "Too many resources bound to a single pipeline state (MAX_CACHED_RESOURCE_BINDING_COUNT is %u)", MAX_CACHED_RESOURCE_BINDING_COUNT );
+    if ( boundResourceCount < MAX_CACHED_RESOURCE_BINDING_COUNT ) {
+        boundResources[boundResourceCount++] = { hashcode, resource, viewKey };
+    }
+
+    invalidateInputBuffer( resource );
+    isResourceListDirty = true;
+    bindingStats.IssuedBindCount++;
+    return true;
+}
+
+bool CommandList::shouldPrepareAndBindResourceList()
+{
+    if ( !isResourceListDirty ) {
+        bindingStats.FilteredBindCount++;
+        return false;
+    }
+
+    isResourceListDirty = false;
+
+    bindingStats.IssuedBindCount++;
+    return true;
+}
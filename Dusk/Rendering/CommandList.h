@@ -89,6 +89,40 @@ enum eResourceState
     RESOURCE_STATE_INDEX_BUFFER,
 };
 
+enum eBarrierType
+{
+    // Transition the resource immediately.
+    BARRIER_TYPE_FULL = 0,
+
+    // Start a split transition. The resource must not be accessed until the matching BARRIER_TYPE_SPLIT_END barrier
+    // is recorded (on the same queue).
+    BARRIER_TYPE_SPLIT_BEGIN,
+
+    // Complete a split transition started earlier.
+    BARRIER_TYPE_SPLIT_END,
+};
+
+// Resource transition recorded as part of a barrier batch (see CommandList::resourceBarriers). Either ImageResource
+// or BufferResource must be set. A barrier from RESOURCE_STATE_UAV to RESOURCE_STATE_UAV is a UAV barrier (the writes
+// must complete before the next access).
+struct ResourceBarrier
+{
+    Image*          ImageResource;
+    Buffer*         BufferResource;
+
+    // State of the resource before the barrier. If the state is RESOURCE_STATE_UNKNOWN, the state tracked by the
+    // backend is used instead.
+    eResourceState  StateBefore;
+    eResourceState  StateAfter;
+
+    eBarrierType    Type;
+
+    // Index of the split transition (shared by its BARRIER_TYPE_SPLIT_BEGIN and BARRIER_TYPE_SPLIT_END barriers and
+    // unique for a frame). Assigned by the FrameGraph in the [0..MAX_SPLIT_BARRIER_COUNT[ range; ignored for full
+    // barriers.
+    u32             SplitBarrierIndex;
+};
+
 struct FramebufferAttachment 
 {
     // The image attachment to bind to the framebuffer.
@@ -113,6 +147,25 @@ static constexpr u32 QUERY_COUNT_WHOLE_POOL = 0xffffffff;
 static constexpr u32 BUFFER_MAP_WHOLE_MEMORY = 0;
 static constexpr u32 IMAGE_UPDATE_WHOLE_MIPCHAIN = 0;
 static constexpr u32 MAX_VERTEX_BUFFER_BIND_COUNT = 8;
+static constexpr u32 MAX_FRAMEBUFFER_ATTACHMENT_COUNT = 8;
+
+// Maximum number of split transitions in flight in a single frame (transitions past this limit are not split).
+static constexpr u32 MAX_SPLIT_BARRIER_COUNT = 128;
+
+// Number of resource bindings (constant buffers, images, buffers and samplers) remembered by a CommandList. The cache
+// is cleared when a different pipeline state is bound; it can therefore hold every resource of a pipeline state.
+static constexpr u32 MAX_CACHED_RESOURCE_BINDING_COUNT = static_cast<u32>( PipelineStateDesc::MAX_RESOURCE_COUNT );
+
+// Binding calls recorded by a CommandList since its last begin (see CommandList::getBindingStats). Resource bindings are
+// not tracked on Direct3D12 (the backend does not implement them yet).
+struct CommandListBindingStats
+{
+    // Number of binding calls forwarded to the backend.
+    u32     IssuedBindCount;
+
+    // Number of redundant binding calls dropped by the CommandList.
+    u32     FilteredBindCount;
+};
 
 class CommandList
 {
@@ -137,6 +190,9 @@ public:
 	DUSK_INLINE i32                 getCommandListPooledIndex() const { return commandListPoolIndex; }
 	DUSK_INLINE i32                 getFrameIndex() const { return frameIndex; }
 
+    // Return the binding calls recorded since the last call to begin.
+    DUSK_INLINE const CommandListBindingStats& getBindingStats() const { return bindingStats; }
+
 public:
                                     CommandList( const Type cmdListType );
                                     CommandList( CommandList& ) = delete;
@@ -174,6 +230,9 @@ public:
     void                            dispatchCompute( const u32 threadCountX, const u32 threadCountY, const u32 threadCountZ );
 
     void                            updateBuffer( Buffer& buffer, const void* data, const size_t dataSize );
+
+    // Update 'dataSize' bytes of a buffer starting at 'offsetInBytes' (see RenderDevice::hasPartialBufferUpdate).
+    void                            updateBuffer( Buffer& buffer, const void* data, const size_t dataSize, const size_t offsetInBytes );
     void*                           mapBuffer( Buffer& buffer, const u32 startOffsetInBytes = 0, const u32 sizeInBytes = BUFFER_MAP_WHOLE_MEMORY );
     void                            unmapBuffer( Buffer& buffer );
 
@@ -195,9 +254,21 @@ public:
     void                            transitionImage( Image& image, const eResourceState state, const u32 mipIndex = 0, const TransitionType transitionType = TRANSITION_SAME_QUEUE );
     void                            transitionBuffer( Buffer& buffer, const eResourceState state );
 
+    // Record a batch of barriers at once. Backends flush the whole batch with a single barrier call (split barriers
+    // are emitted as full barriers if the backend does not support them).
+    void                            resourceBarriers( const ResourceBarrier* barriers, const u32 barrierCount );
+
     void                            insertComputeBarrier( Image& image );
     void                            resolveImage( Image& src, Image& dst );
 
+private:
+    // Resource bound to a shader resource hashcode.
+    struct CachedResourceBinding {
+        dkStringHash_t              Hashcode;
+        const void*                 Resource;
+        u64                         ViewKey;
+    };
+
 private:
     NativeCommandList*              nativeCommandList;
     BaseAllocator*                  memoryAllocator;
@@ -208,4 +279,55 @@ private:
     // Internal pool index to figure out which external resource is bound
     // to the command list
     i32                             commandListPoolIndex;
+
+    // State bound since the last call to begin. The backends check a binding against this cache before recording it;
+    // redundant bindings are dropped.
+    const PipelineState*            boundPipelineState;
+    const Buffer*                   boundVertexBuffers[MAX_VERTEX_BUFFER_BIND_COUNT];
+    u32                             boundVertexBufferOffsets[MAX_VERTEX_BUFFER_BIND_COUNT];
+    const Buffer*                   boundIndiceBuffer;
+    Viewport                        boundViewport;
+    ScissorRegion                   boundScissor;
+    FramebufferAttachment           boundRenderTargets[MAX_FRAMEBUFFER_ATTACHMENT_COUNT];
+    FramebufferAttachment           boundDepthStencil;
+    u32                             boundRenderTargetCount;
+    CachedResourceBinding           boundResources[MAX_CACHED_RESOURCE_BINDING_COUNT];
+    u32                             boundResourceCount;
+
+    bool                            isPipelineStateBound;
+    bool                            isIndiceBuffer32bits;
+    bool                            isViewportBound;
+    bool                            isScissorBound;
+    bool                            isFramebufferBound;
+
+    // True if a binding has been issued since the last prepareAndBindResourceList call.
+    bool                            isResourceListDirty;
+
+    // Binding calls recorded since the last call to begin.
+    CommandListBindingStats         bindingStats;
+
+private:
+    // Clear the binding cache and the binding stats (called by the backends on begin).
+    void                            resetBindingCache();
+
+    // Forget the resources bound so far (e.g. if the backend resolves bindings against a state which has changed).
+    void                            invalidateResourceBindings();
+
+    // Forget the vertex/index buffer bindings of 'resource' (called when 'resource' is bound as a shader resource).
+    void                            invalidateInputBuffer( const void* resource );
+
+    // Return true if the binding must be recorded by the backend (false if it is redundant). A binding which has to be
+    // recorded updates the binding cache. A framebuffer setup with side effects (e.g. attachments to clear) is never
+    // considered redundant.
+    bool                            shouldBindPipelineState( const PipelineState* pipelineState );
+    bool                            shouldBindVertexBuffers( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex );
+    bool                            shouldBindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices );
+    bool                            shouldSetViewport( const Viewport& viewport );
+    bool                            shouldSetScissor( const ScissorRegion& scissorRegion );
+    bool                            shouldSetupFramebuffer( const FramebufferAttachment* renderTargetViews, const u32 renderTargetCount, const FramebufferAttachment& depthStencilView, const bool hasSideEffects );
+    bool                            shouldBindResource( const dkStringHash_t hashcode, const void* resource, const u64 viewKey = 0ull );
+    bool                            shouldPrepareAndBindResourceList();
+
+    // Update the binding cache for a pipeline state bind the backend cannot skip.
+    void                            trackPipelineStateBind( const PipelineState* pipelineState );
 };
@@ -113,6 +113,10 @@ DUSK_INLINE void BuildBindVertexBufferPacket( CommandPacket::BindVertexBuffer* c
 
 void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex )
 {
+    if ( !shouldBindVertexBuffers( buffers, offsets, bufferCount, startBindIndex ) ) {
+        return;
+    }
+
     CommandPacket::BindVertexBuffer* commandPacket = dk::core::allocate<CommandPacket::BindVertexBuffer>( nativeCommandList->CommandPacketAllocator );
     memset( commandPacket, 0, sizeof( CommandPacket::BindVertexBuffer ) );
 
@@ -127,6 +131,10 @@ void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets,
 
 void CommandList::bindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices )
 {
+    if ( !shouldBindIndiceBuffer( buffer, use32bitsIndices ) ) {
+        return;
+    }
+
     CommandPacket::BindIndiceBuffer* commandPacket = dk::core::allocate<CommandPacket::BindIndiceBuffer>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_BIND_INDICE_BUFFER;
     commandPacket->ViewFormat = ( use32bitsIndices ) ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
@@ -153,6 +161,26 @@ void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t d
     nativeCommandList->Commands.push( reinterpret_cast<u32*>( commandPacket ) );
 }
 
+void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t dataSize, const size_t offsetInBytes )
+{
+    DUSK_DEV_ASSERT( buffer.BufferObject, "Buffer IS NULL!" );
+
+    // Mapped buffers (RESOURCE_USAGE_DYNAMIC) can only be updated with a WRITE_DISCARD map (the previous content of the
+    // buffer is lost); UpdateSubresource is restricted to default usage (and can't update a constant buffer range).
+    DUSK_DEV_ASSERT( buffer.UsageFlags == RESOURCE_USAGE_DEFAULT && !( buffer.BindFlags & RESOURCE_BIND_CONSTANT_BUFFER ),
+                     "Partial buffer updates are only supported for non-constant buffers with a default usage!" );
+
+    CommandPacket::UpdateBufferRegion* commandPacket = dk::core::allocate<CommandPacket::UpdateBufferRegion>( nativeCommandList->CommandPacketAllocator );
+    commandPacket->Identifier = CPI_UPDATE_BUFFER_REGION;
+    commandPacket->BufferObject = buffer.BufferObject;
+    commandPacket->OffsetInBytes = offsetInBytes;
+    commandPacket->DataSize = dataSize;
+    commandPacket->Data = dk::core::allocateArray<u8>( nativeCommandList->CommandPacketAllocator, dataSize );
+    memcpy( commandPacket->Data, data, dataSize );
+
+    nativeCommandList->Commands.push( reinterpret_cast<u32*>( commandPacket ) );
+}
+
 void* CommandList::mapBuffer( Buffer& buffer, const u32 startOffsetInBytes, const u32 sizeInBytes )
 {
     D3D11_MAPPED_SUBRESOURCE mappedSubresource;
@@ -51,6 +51,10 @@ void CommandList::end()
 
 void CommandList::setViewport( const Viewport& viewport )
 {
+    if ( !shouldSetViewport( viewport ) ) {
+        return;
+    }
+
     CommandPacket::SetViewport* commandPacket = dk::core::allocate<CommandPacket::SetViewport>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_SET_VIEWPORT;
     commandPacket->ViewportObject = viewport;
@@ -60,6 +64,10 @@ void CommandList::setViewport( const Viewport& viewport )
 
 void CommandList::setScissor( const ScissorRegion& scissorRegion )
 {
+    if ( !shouldSetScissor( scissorRegion ) ) {
+        return;
+    }
+
     CommandPacket::SetScissor* commandPacket = dk::core::allocate<CommandPacket::SetScissor>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_SET_SCISSOR;
     commandPacket->ScissorObject = scissorRegion;
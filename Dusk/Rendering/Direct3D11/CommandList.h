@@ -75,6 +75,15 @@ namespace CommandPacket
         void*           Data;
     };
 
+    struct UpdateBufferRegion
+    {
+        u32             Identifier;
+        ID3D11Buffer*   BufferObject;
+        size_t          OffsetInBytes;
+        size_t          DataSize;
+        void*           Data;
+    };
+
 	struct CopyResource
 	{
 		u32             Identifier;
@@ -224,6 +233,9 @@ enum CommandPacketIdentifier
     // Update a single buffer.
     CPI_UPDATE_BUFFER,
 
+    // Update a range of a single buffer (the rest of the buffer is preserved).
+    CPI_UPDATE_BUFFER_REGION,
+
     // Bind color attachments/depth attachment. Number of attachment is defined by the active pipeline state.
     CPI_SETUP_FRAMEBUFFER,
 
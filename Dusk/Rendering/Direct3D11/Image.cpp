@@ -576,6 +576,11 @@ void CommandList::transitionImage( Image& image, const eResourceState state, con
     // Resource state is managed at driver level in D3D11
 }
 
+void CommandList::resourceBarriers( const ResourceBarrier* barriers, const u32 barrierCount )
+{
+    // Resource state is managed at driver level in D3D11
+}
+
 void CommandList::insertComputeBarrier( Image& image )
 {
 
@@ -597,12 +602,24 @@ void CommandList::resolveImage( Image& src, Image& dst )
 
 void CommandList::setupFramebuffer( FramebufferAttachment* renderTargetViews, FramebufferAttachment depthStencilView )
 {
+    const PipelineState* pipelineState = nativeCommandList->BindedPipelineState;
+
+    // The packet replay clears the attachments flagged by the pipeline state.
+    bool hasClearRequest = pipelineState->clearDsv;
+    for ( u32 i = 0; i < pipelineState->rtvCount; i++ ) {
+        hasClearRequest |= pipelineState->clearRtv[i];
+    }
+
+    if ( !shouldSetupFramebuffer( renderTargetViews, pipelineState->rtvCount, depthStencilView, hasClearRequest ) ) {
+        return;
+    }
+
     CommandPacket::SetupFramebuffer* commandPacket = dk::core::allocate<CommandPacket::SetupFramebuffer>( nativeCommandList->CommandPacketAllocator );
     memset( commandPacket, 0, sizeof( CommandPacket::SetupFramebuffer ) );
 
     commandPacket->Identifier = CPI_SETUP_FRAMEBUFFER;
 
-    memcpy( commandPacket->RenderTargetView, renderTargetViews, sizeof( FramebufferAttachment ) * nativeCommandList->BindedPipelineState->rtvCount );
+    memcpy( commandPacket->RenderTargetView, renderTargetViews, sizeof( FramebufferAttachment ) * pipelineState->rtvCount );
     commandPacket->DepthStencilView = depthStencilView;
 
     nativeCommandList->Commands.push( reinterpret_cast<u32*>( commandPacket ) );
@@ -519,6 +519,10 @@ PipelineState* RenderDevice::createPipelineState( const PipelineStateDesc& descr
 
 void CommandList::prepareAndBindResourceList()
 {
+    if ( !shouldPrepareAndBindResourceList() ) {
+        return;
+    }
+
     CommandPacket::ArgumentLessPacket* commandPacket = dk::core::allocate<CommandPacket::ArgumentLessPacket>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_PREPARE_AND_BIND_RESOURCES;
 
@@ -561,10 +565,16 @@ void RenderDevice::destroyPipelineStateCache( PipelineState* pipelineState )
 void CommandList::begin()
 {
     nativeCommandList->CommandPacketAllocator->clear();
+
+    resetBindingCache();
 }
 
 void CommandList::bindPipelineState( PipelineState* pipelineState )
 {
+    if ( !shouldBindPipelineState( pipelineState ) ) {
+        return;
+    }
+
     CommandPacket::BindPipelineState* commandPacket = dk::core::allocate<CommandPacket::BindPipelineState>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_BIND_PIPELINE_STATE;
     commandPacket->PipelineStateObject = pipelineState;
@@ -578,6 +588,10 @@ void CommandList::bindPipelineState( PipelineState* pipelineState )
 
 void CommandList::bindConstantBuffer( const dkStringHash_t hashcode, Buffer* buffer )
 {
+    if ( !shouldBindResource( hashcode, buffer ) ) {
+        return;
+    }
+
     CommandPacket::BindConstantBuffer* commandPacket = dk::core::allocate<CommandPacket::BindConstantBuffer>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_BIND_CBUFFER;
     commandPacket->BufferObject = buffer;
@@ -588,6 +602,10 @@ void CommandList::bindConstantBuffer( const dkStringHash_t hashcode, Buffer* buf
 
 void CommandList::bindImage( const dkStringHash_t hashcode, Image* image, const ImageViewDesc viewDescription )
 {
+    if ( !shouldBindResource( hashcode, image, viewDescription.SortKey ) ) {
+        return;
+    }
+
     CommandPacket::BindResource* commandPacket = dk::core::allocate<CommandPacket::BindResource>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_BIND_IMAGE;
     commandPacket->ImageObject = image;
@@ -601,6 +619,10 @@ void CommandList::bindBuffer( const dkStringHash_t hashcode, Buffer* buffer, con
 {
     DUSK_DEV_ASSERT( buffer, "Buffer is null!" );
 
+    if ( !shouldBindResource( hashcode, buffer, static_cast<u64>( viewFormat ) ) ) {
+        return;
+    }
+
     CommandPacket::BindResource* commandPacket = dk::core::allocate<CommandPacket::BindResource>( nativeCommandList->CommandPacketAllocator );
     commandPacket->Identifier = CPI_BIND_BUFFER;
     commandPacket->BufferObject = buffer;
@@ -612,6 +634,10 @@ void CommandList::bindBuffer( const dkStringHash_t hashcode, Buffer* buffer, con
 
 void CommandList::bindSampler( const dkStringHash_t hashcode, Sampler* sampler )
 {
+	if ( !shouldBindResource( hashcode, sampler ) ) {
+		return;
+	}
+
 	CommandPacket::BindResource* commandPacket = dk::core::allocate<CommandPacket::BindResource>( nativeCommandList->CommandPacketAllocator );
 	commandPacket->Identifier = CPI_BIND_SAMPLER;
 	commandPacket->SamplerObject = sampler;
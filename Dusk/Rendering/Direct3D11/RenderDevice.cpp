@@ -68,6 +68,7 @@ RenderContext::RenderContext()
 
     memset( CBufferRegisterUpdateStart, 0xff, sizeof( u32 ) * eShaderStage::SHADER_STAGE_COUNT );
     memset( CBufferRegisterUpdateCount, 0x00, sizeof( i32 ) * eShaderStage::SHADER_STAGE_COUNT );
+    memset( QueueSignalValue, 0x00, sizeof( u64 ) * eCommandQueue::COMMAND_QUEUE_COUNT );
     memset( CBufferRegisters, 0x00, sizeof( ID3D11Buffer* ) * eShaderStage::SHADER_STAGE_COUNT * D3D11_COMMONSHADER_CONSTANT_BUFFER_REGISTER_COUNT );
 
 	memset( SamplerRegisters, 0x00, sizeof( ID3D11SamplerState* )* eShaderStage::SHADER_STAGE_COUNT* D3D11_COMMONSHADER_SAMPLER_REGISTER_COUNT );
@@ -422,11 +423,7 @@ CommandList& RenderDevice::allocateGraphicsCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( graphicsCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        graphicsCmdListAllocator[bufferIdx]->clear();
-    }
-    CommandList* cmdList = static_cast< CommandList* >( graphicsCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( graphicsCmdListAllocator[bufferIdx], graphicsCmdListPoolFrameIndex[bufferIdx] );
     cmdList->setFrameIndex( static_cast< i32 >( frameIndex ) );
 
     return *cmdList;
@@ -436,11 +433,7 @@ CommandList& RenderDevice::allocateComputeCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( computeCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        computeCmdListAllocator[bufferIdx]->clear();
-    }
-    CommandList* cmdList = static_cast< CommandList* >( computeCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( computeCmdListAllocator[bufferIdx], computeCmdListPoolFrameIndex[bufferIdx] );
     cmdList->setFrameIndex( static_cast< i32 >( frameIndex ) );
 
     return *cmdList;
@@ -463,6 +456,20 @@ void UpdateBuffer_Replay( ID3D11DeviceContext* immediateContext, ID3D11Resource*
     }
 }
 
+void UpdateBufferRegion_Replay( ID3D11DeviceContext* immediateContext, ID3D11Resource* resource, const void* data, const size_t offsetInBytes, const size_t dataSize )
+{
+    // Buffers are 1D resources (only the X axis of the box is relevant).
+    D3D11_BOX updateBox;
+    updateBox.left = static_cast<UINT>( offsetInBytes );
+    updateBox.right = static_cast<UINT>( offsetInBytes + dataSize );
+    updateBox.top = 0;
+    updateBox.bottom = 1;
+    updateBox.front = 0;
+    updateBox.back = 1;
+
+    immediateContext->UpdateSubresource( resource, 0, &updateBox, data, 0, 0 );
+}
+
 void RenderDevice::submitCommandList( CommandList& cmdList )
 {
     // Replay recorded commands
@@ -500,6 +507,12 @@ void RenderDevice::submitCommandList( CommandList& cmdList )
             UpdateBuffer_Replay( renderContext->ImmediateContext, cmdPacket.BufferObject, cmdPacket.Data, cmdPacket.DataSize );
             break;
         }
+        case CPI_UPDATE_BUFFER_REGION:
+        {
+            CommandPacket::UpdateBufferRegion cmdPacket = *( CommandPacket::UpdateBufferRegion* )bufferPointer;
+            UpdateBufferRegion_Replay( renderContext->ImmediateContext, cmdPacket.BufferObject, cmdPacket.Data, cmdPacket.OffsetInBytes, cmdPacket.DataSize );
+            break;
+        }
         case CPI_SETUP_FRAMEBUFFER:
         {
             CommandPacket::SetupFramebuffer cmdPacket = *( CommandPacket::SetupFramebuffer* )bufferPointer;
@@ -712,6 +725,37 @@ void RenderDevice::submitCommandLists( CommandList** cmdLists, const u32 cmdList
     }
 }
 
+bool RenderDevice::hasAsyncComputeQueue() const
+{
+    return false;
+}
+
+bool RenderDevice::hasMultiDrawIndirect() const
+{
+    // Replayed as a loop of DrawIndexedInstancedIndirect if no vendor extension is available.
+    return true;
+}
+
+bool RenderDevice::hasPartialBufferUpdate() const
+{
+    // Ranges of default usage buffers are updated with UpdateSubresource; dynamic buffers (e.g. the FrameGraph vector
+    // buffer) can only be updated with a WRITE_DISCARD map.
+    return false;
+}
+
+u64 RenderDevice::signalQueue( const eCommandQueue queue )
+{
+    return ++renderContext->QueueSignalValue[queue];
+}
+
+void RenderDevice::waitQueue( const eCommandQueue queue, const eCommandQueue waitedQueue, const u64 signalValue )
+{
+    // CommandLists are replayed in submission order; there is nothing to wait for.
+    DUSK_UNUSED_VARIABLE( queue );
+    DUSK_UNUSED_VARIABLE( waitedQueue );
+    DUSK_UNUSED_VARIABLE( signalValue );
+}
+
 void RenderDevice::present()
 {
     HRESULT swapBufferResult = renderContext->SwapChain->Present( renderContext->SynchronisationInterval, 0 );
@@ -106,6 +106,10 @@ struct RenderContext
     // Active PipelineState.
     PipelineState*              BindedPipelineState;
 
+    // Last value signaled per queue (every CommandList is replayed on the immediate context; queues are implicitly
+    // synchronized).
+    u64                         QueueSignalValue[eCommandQueue::COMMAND_QUEUE_COUNT];
+
 #if DUSK_DEVBUILD
     // Latest debug event pushed on the stack.
     const dkChar_t*             ActiveDebugMarker;
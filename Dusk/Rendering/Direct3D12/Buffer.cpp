@@ -234,6 +234,10 @@ void RenderDevice::setDebugMarker( Buffer& buffer, const dkChar_t* objectName )
 
 void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex )
 {
+    if ( !shouldBindVertexBuffers( buffers, offsets, bufferCount, startBindIndex ) ) {
+        return;
+    }
+
     D3D12_VERTEX_BUFFER_VIEW vboView[MAX_VERTEX_BUFFER_BIND_COUNT];
     for ( u32 i = 0; i < bufferCount; i++ ) {
         vboView[i].BufferLocation = buffers[i]->resource[resourceFrameIndex]->GetGPUVirtualAddress();
@@ -246,6 +250,10 @@ void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets,
 
 void CommandList::bindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices )
 {
+    if ( !shouldBindIndiceBuffer( buffer, use32bitsIndices ) ) {
+        return;
+    }
+
     D3D12_INDEX_BUFFER_VIEW iboView;
     iboView.BufferLocation = buffer->resource[resourceFrameIndex]->GetGPUVirtualAddress();
     iboView.Format = ( use32bitsIndices ) ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
@@ -263,13 +271,22 @@ void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t d
     }
 }
 
+void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t dataSize, const size_t offsetInBytes )
+{
+    u8* bufferPointer = static_cast<u8*>( mapBuffer( buffer, static_cast<u32>( buffer.heapOffset + offsetInBytes ), static_cast<u32>( dataSize ) ) );
+    if ( bufferPointer != nullptr ) {
+        memcpy( bufferPointer + offsetInBytes, data, dataSize );
+        unmapBuffer( buffer );
+    }
+}
+
 void* CommandList::mapBuffer( Buffer& buffer, const u32 startOffsetInBytes, const u32 sizeInBytes )
 {
     void* mappedMemory = nullptr;
 
     D3D12_RANGE bufferRange;
     bufferRange.Begin = startOffsetInBytes;
-    bufferRange.End = sizeInBytes;
+    bufferRange.End = static_cast<SIZE_T>( startOffsetInBytes ) + sizeInBytes;
 
     buffer.memoryMappedRanges[buffer.memoryMappedRangeCount++] = bufferRange;
 
@@ -281,7 +298,7 @@ void* CommandList::mapBuffer( Buffer& buffer, const u32 startOffsetInBytes, cons
 
 void CommandList::unmapBuffer( Buffer& buffer )
 {
-    buffer.resource[resourceFrameIndex]->Unmap( 0, &buffer.memoryMappedRanges[buffer.memoryMappedRangeCount--] );
+    buffer.resource[resourceFrameIndex]->Unmap( 0, &buffer.memoryMappedRanges[--buffer.memoryMappedRangeCount] );
 }
 
 void CommandList::transitionBuffer( Buffer& buffer, const eResourceState state )
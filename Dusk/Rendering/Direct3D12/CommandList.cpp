@@ -5,9 +5,13 @@
 #include <Shared.h>
 
 #if DUSK_D3D12
-#include "CommandList.h"
+#include <Rendering/RenderDevice.h>
 #include <Rendering/CommandList.h>
 
+#include "Buffer.h"
+#include "RenderDevice.h"
+#include "CommandList.h"
+
 #include <d3d12.h>
 #include <pix.h>
 
@@ -53,6 +57,10 @@ void CommandList::end()
 
 void CommandList::setViewport( const Viewport& viewport )
 {
+    if ( !shouldSetViewport( viewport ) ) {
+        return;
+    }
+
     D3D12_VIEWPORT nativeViewport;
     nativeViewport.TopLeftX = static_cast<FLOAT>( viewport.X );
     nativeViewport.TopLeftY = static_cast<FLOAT>( viewport.Y );
@@ -66,6 +74,10 @@ void CommandList::setViewport( const Viewport& viewport )
 
 void CommandList::setScissor( const ScissorRegion& scissorRegion )
 {
+    if ( !shouldSetScissor( scissorRegion ) ) {
+        return;
+    }
+
     D3D12_RECT nativeScissor;
     nativeScissor.bottom = scissorRegion.Bottom;
     nativeScissor.top = scissorRegion.Top;
@@ -92,7 +104,19 @@ void CommandList::dispatchCompute( const u32 threadCountX, const u32 threadCount
 
 void CommandList::multiDrawIndexedInstancedIndirect( const u32 instanceCount, Buffer* argsBuffer, const u32 bufferAlignmentInBytes /* = 0u */, const u32 argumentsSizeInBytes /* = 0u */ )
 {
- 
+    ID3D12CommandSignature* commandSignature = nativeCommandList->renderContext->drawIndexedIndirectSignature;
+    ID3D12Resource* argsResource = argsBuffer->resource[resourceFrameIndex];
+
+    constexpr u32 SIGNATURE_STRIDE = static_cast<u32>( sizeof( D3D12_DRAW_INDEXED_ARGUMENTS ) );
+    if ( argumentsSizeInBytes == 0u || argumentsSizeInBytes == SIGNATURE_STRIDE ) {
+        nativeCommandList->graphicsCmdList->ExecuteIndirect( commandSignature, instanceCount, argsResource, bufferAlignmentInBytes, nullptr, 0 );
+        return;
+    }
+
+    // The stride of a command signature is immutable; issue one command per draw if the arguments are not tightly packed.
+    for ( u32 drawIndex = 0u; drawIndex < instanceCount; drawIndex++ ) {
+        nativeCommandList->graphicsCmdList->ExecuteIndirect( commandSignature, 1u, argsResource, bufferAlignmentInBytes + drawIndex * argumentsSizeInBytes, nullptr, 0 );
+    }
 }
 
 void CommandList::pushEventMarker( const dkChar_t* eventName )
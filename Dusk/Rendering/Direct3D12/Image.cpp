@@ -16,6 +16,7 @@
 #include "PipelineState.h"
 
 #include "Image.h"
+#include "Buffer.h"
 #include "ResourceAllocationHelpers.h"
 
 #include <d3d12.h>
@@ -320,6 +321,62 @@ void CommandList::transitionImage( Image& image, const eResourceState state, con
     image.currentResourceState[resourceFrameIndex] = nextState;
 }
 
+void CommandList::resourceBarriers( const ResourceBarrier* barriers, const u32 barrierCount )
+{
+    // Flush the batch with a single ResourceBarrier call (in chunks if the batch is too large for the stack storage).
+    static constexpr u32 MAX_BARRIER_PER_CALL = 32u;
+
+    D3D12_RESOURCE_BARRIER nativeBarriers[MAX_BARRIER_PER_CALL];
+    u32 nativeBarrierCount = 0u;
+
+    for ( u32 i = 0u; i < barrierCount; i++ ) {
+        const ResourceBarrier& barrier = barriers[i];
+
+        ID3D12Resource* resource = ( barrier.ImageResource != nullptr ) ? barrier.ImageResource->resource[resourceFrameIndex] : barrier.BufferResource->resource[resourceFrameIndex];
+        D3D12_RESOURCE_STATES* trackedState = ( barrier.ImageResource != nullptr ) ? &barrier.ImageResource->currentResourceState[resourceFrameIndex] : &barrier.BufferResource->currentResourceState;
+
+        D3D12_RESOURCE_BARRIER& nativeBarrier = nativeBarriers[nativeBarrierCount];
+
+        if ( barrier.StateBefore == RESOURCE_STATE_UAV && barrier.StateAfter == RESOURCE_STATE_UAV ) {
+            nativeBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            nativeBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            nativeBarrier.UAV.pResource = resource;
+        } else {
+            // Split barriers are only emitted if the state before the barrier is known; a full barrier falls back to
+            // the tracked state otherwise (the resource might have been transitioned by an explicit transition).
+            const D3D12_RESOURCE_STATES stateBefore = ( barrier.StateBefore != RESOURCE_STATE_UNKNOWN ) ? RESOURCE_STATE_LUT[barrier.StateBefore] : *trackedState;
+            const D3D12_RESOURCE_STATES stateAfter = RESOURCE_STATE_LUT[barrier.StateAfter];
+
+            if ( stateBefore == stateAfter ) {
+                continue;
+            }
+
+            nativeBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            nativeBarrier.Flags = ( barrier.Type == BARRIER_TYPE_SPLIT_BEGIN ) ? D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY
+                                : ( barrier.Type == BARRIER_TYPE_SPLIT_END ) ? D3D12_RESOURCE_BARRIER_FLAG_END_ONLY
+                                : D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            nativeBarrier.Transition.pResource = resource;
+            nativeBarrier.Transition.StateBefore = stateBefore;
+            nativeBarrier.Transition.StateAfter = stateAfter;
+            nativeBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+
+            // The resource keeps its previous state until the split transition is completed.
+            if ( barrier.Type != BARRIER_TYPE_SPLIT_BEGIN ) {
+                *trackedState = stateAfter;
+            }
+        }
+
+        if ( ++nativeBarrierCount == MAX_BARRIER_PER_CALL ) {
+            nativeCommandList->graphicsCmdList->ResourceBarrier( nativeBarrierCount, nativeBarriers );
+            nativeBarrierCount = 0u;
+        }
+    }
+
+    if ( nativeBarrierCount > 0u ) {
+        nativeCommandList->graphicsCmdList->ResourceBarrier( nativeBarrierCount, nativeBarriers );
+    }
+}
+
 void CommandList::insertComputeBarrier( Image& image )
 {
     D3D12_RESOURCE_BARRIER uavBarrier;
@@ -443,6 +500,7 @@ static D3D12_CPU_DESCRIPTOR_HANDLE CreateDepthStencilView( RenderContext* render
 void CommandList::setupFramebuffer( FramebufferAttachment* renderTargetViews, FramebufferAttachment depthStencilView )
 {
     const PipelineState& pipelineState = *nativeCommandList->BindedPipelineState;
+
     bool hasDsv = pipelineState.hasDepthStencilView;
     bool shouldClearDsv = false;
     UINT renderTargetCount = 0;
@@ -514,7 +572,10 @@ void CommandList::setupFramebuffer( FramebufferAttachment* renderTargetViews, Fr
         cmdList->ClearDepthStencilView( dsv, D3D12_CLEAR_FLAG_DEPTH, pipelineState.depthClearValue, pipelineState.stencilClearValue, 1, &clearDepthRectangle );
     }
 
-    cmdList->OMSetRenderTargets( renderTargetCount, rtvs, FALSE, ( hasDsv ) ? &dsv : nullptr );
+    // Transitions and clears are always recorded; only the attachment bind itself can be redundant.
+    if ( shouldSetupFramebuffer( renderTargetViews, pipelineState.rtvCount, depthStencilView, false ) ) {
+        cmdList->OMSetRenderTargets( renderTargetCount, rtvs, FALSE, ( hasDsv ) ? &dsv : nullptr );
+    }
 }
 
 void RenderDevice::createImageView( Image& image, const ImageViewDesc& viewDescription, const u32 creationFlags )
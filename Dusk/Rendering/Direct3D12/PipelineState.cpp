@@ -885,10 +885,16 @@ void CommandList::begin()
     } else {
         cmdList->Reset( *nativeCommandList->allocator, nullptr );
     }
+
+    resetBindingCache();
 }
 
 void CommandList::bindPipelineState( PipelineState* pipelineState )
 {
+    if ( !shouldBindPipelineState( pipelineState ) ) {
+        return;
+    }
+
     nativeCommandList->BindedPipelineState = pipelineState;
 }
 
@@ -42,6 +42,7 @@ RenderContext::RenderContext()
     , copyCmdQueue( nullptr )
     , synchronisationInterval( 0 )
     , frameCompletionEvent( nullptr )
+    , drawIndexedIndirectSignature( nullptr )
     , samplerDescriptorHeap( nullptr )
     , rtvDescriptorHeap( nullptr )
     , rtvDescriptorHeapOffset( 0 )
@@ -75,6 +76,8 @@ RenderContext::RenderContext()
     memset( copyCmdListUsageIndex, 0, sizeof( size_t ) * RenderDevice::PENDING_FRAME_COUNT );
     memset( frameCompletionFence, 0, sizeof( ID3D12Fence* ) * RenderDevice::PENDING_FRAME_COUNT );
     memset( frameFenceValues, 0, sizeof( u64 ) * RenderDevice::PENDING_FRAME_COUNT );
+    memset( queueFence, 0, sizeof( ID3D12Fence* ) * eCommandQueue::COMMAND_QUEUE_COUNT );
+    memset( queueFenceValues, 0, sizeof( u64 ) * eCommandQueue::COMMAND_QUEUE_COUNT );
     memset( srvDescriptorHeapOffset, 0, sizeof( size_t ) * RenderDevice::PENDING_FRAME_COUNT );
     memset( volatileBuffers, 0, sizeof( ID3D12Resource* ) * RenderDevice::PENDING_FRAME_COUNT );
 }
@@ -115,6 +118,14 @@ RenderContext::~RenderContext()
         frameCompletionFence[i]->Release();
     }
 
+    for ( i32 i = 0; i < eCommandQueue::COMMAND_QUEUE_COUNT; i++ ) {
+        queueFence[i]->Release();
+    }
+
+    if ( drawIndexedIndirectSignature != nullptr ) {
+        drawIndexedIndirectSignature->Release();
+    }
+
     for ( i32 i = 0; i < RenderDevice::PENDING_FRAME_COUNT; i++ ) {
         volatileBuffers[i]->Release();
     }
@@ -529,6 +540,27 @@ void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefr
         renderContext->device->CreateFence( 0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS( &renderContext->frameCompletionFence[i] ) );
     }
 
+    for ( i32 i = 0; i < eCommandQueue::COMMAND_QUEUE_COUNT; i++ ) {
+        renderContext->queueFenceValues[i] = 0;
+        renderContext->device->CreateFence( 0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS( &renderContext->queueFence[i] ) );
+    }
+
+    // Indirect draws (the signature only holds draw arguments; no root signature is required).
+    D3D12_INDIRECT_ARGUMENT_DESC drawIndexedArgumentDesc = {};
+    drawIndexedArgumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+    D3D12_COMMAND_SIGNATURE_DESC drawIndexedSignatureDesc = {};
+    drawIndexedSignatureDesc.ByteStride = sizeof( D3D12_DRAW_INDEXED_ARGUMENTS );
+    drawIndexedSignatureDesc.NumArgumentDescs = 1;
+    drawIndexedSignatureDesc.pArgumentDescs = &drawIndexedArgumentDesc;
+    drawIndexedSignatureDesc.NodeMask = 0;
+
+    HRESULT signatureCreationResult = renderContext->device->CreateCommandSignature( &drawIndexedSignatureDesc, nullptr, IID_PPV_ARGS( &renderContext->drawIndexedIndirectSignature ) );
+    if ( FAILED( signatureCreationResult ) ) {
+        DUSK_LOG_WARN( "Failed to create indexed draw command signature (error code: 0x%x); multi draw indirect will be disabled\n", signatureCreationResult );
+        renderContext->drawIndexedIndirectSignature = nullptr;
+    }
+
     // Create command list allocators (per command queue)
     constexpr size_t CMD_LIST_ALLOCATION_SIZE = sizeof( CommandList ) * CMD_LIST_POOL_CAPACITY; 
     
@@ -637,11 +669,7 @@ CommandList& RenderDevice::allocateGraphicsCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( graphicsCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        graphicsCmdListAllocator[bufferIdx]->clear();
-    }
-    CommandList* cmdList = static_cast<CommandList*>( graphicsCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( graphicsCmdListAllocator[bufferIdx], graphicsCmdListPoolFrameIndex[bufferIdx] );
     NativeCommandList* nativeCmdList = cmdList->getNativeCommandList();
 
     // The command list itself shouldn't be reset until we bind a pipeline state (which should happen if the user requested a
@@ -658,11 +686,7 @@ CommandList& RenderDevice::allocateComputeCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( computeCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        computeCmdListAllocator[bufferIdx]->clear();
-    }
-    CommandList* cmdList = static_cast< CommandList* >( computeCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( computeCmdListAllocator[bufferIdx], computeCmdListPoolFrameIndex[bufferIdx] );
     NativeCommandList* nativeCmdList = cmdList->getNativeCommandList();
 
     // The command list itself shouldn't be reset until we bind a pipeline state (which should happen if the user requested a
@@ -691,7 +715,55 @@ void RenderDevice::submitCommandList( CommandList& cmdList )
 
 void RenderDevice::submitCommandLists( CommandList** cmdLists, const u32 cmdListCount )
 {
+    static constexpr u32 MAX_BATCH_SIZE = 32u;
+    ID3D12CommandList* batch[MAX_BATCH_SIZE];
+
+    // Consecutive CommandLists targeting the same queue are submitted at once (submission order is preserved).
+    u32 cmdListIdx = 0u;
+    while ( cmdListIdx < cmdListCount ) {
+        const CommandList::Type batchType = cmdLists[cmdListIdx]->getCommandListType();
+
+        u32 batchSize = 0u;
+        while ( cmdListIdx < cmdListCount && batchSize < MAX_BATCH_SIZE && cmdLists[cmdListIdx]->getCommandListType() == batchType ) {
+            batch[batchSize++] = cmdLists[cmdListIdx++]->getNativeCommandList()->graphicsCmdList;
+        }
+
+        ID3D12CommandQueue* submitQueue = ( batchType == CommandList::Type::GRAPHICS ) ? renderContext->directCmdQueue : renderContext->computeCmdQueue;
+        submitQueue->ExecuteCommandLists( batchSize, batch );
+    }
+}
 
+bool RenderDevice::hasAsyncComputeQueue() const
+{
+    return true;
+}
+
+bool RenderDevice::hasMultiDrawIndirect() const
+{
+    return ( renderContext->drawIndexedIndirectSignature != nullptr );
+}
+
+bool RenderDevice::hasPartialBufferUpdate() const
+{
+    return true;
+}
+
+static ID3D12CommandQueue* GetCommandQueue( RenderContext* renderContext, const eCommandQueue queue )
+{
+    return ( queue == eCommandQueue::COMMAND_QUEUE_GRAPHICS ) ? renderContext->directCmdQueue : renderContext->computeCmdQueue;
+}
+
+u64 RenderDevice::signalQueue( const eCommandQueue queue )
+{
+    const u64 signalValue = ++renderContext->queueFenceValues[queue];
+    GetCommandQueue( renderContext, queue )->Signal( renderContext->queueFence[queue], signalValue );
+
+    return signalValue;
+}
+
+void RenderDevice::waitQueue( const eCommandQueue queue, const eCommandQueue waitedQueue, const u64 signalValue )
+{
+    GetCommandQueue( renderContext, queue )->Wait( renderContext->queueFence[waitedQueue], signalValue );
 }
  
 void RenderDevice::resizeBackbuffer( const u32 width, const u32 height )
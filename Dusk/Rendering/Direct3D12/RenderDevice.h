@@ -14,6 +14,7 @@ struct ID3D12Fence;
 struct ID3D12DescriptorHeap;
 struct ID3D12Heap;
 struct ID3D12Resource;
+struct ID3D12CommandSignature;
 
 #include <Core/Allocators/PoolAllocator.h>
 
@@ -78,6 +79,13 @@ struct RenderContext
     HANDLE                      frameCompletionEvent;
     u64                         frameFenceValues[RenderDevice::PENDING_FRAME_COUNT];
 
+    // Cross-queue synchronization fences (one per eCommandQueue) and their last signaled value.
+    ID3D12Fence*                queueFence[eCommandQueue::COMMAND_QUEUE_COUNT];
+    u64                         queueFenceValues[eCommandQueue::COMMAND_QUEUE_COUNT];
+
+    // Command signature used to issue indexed draws with ExecuteIndirect (arguments stored as D3D12_DRAW_INDEXED_ARGUMENTS).
+    ID3D12CommandSignature*     drawIndexedIndirectSignature;
+
     ID3D12DescriptorHeap*       samplerDescriptorHeap;
 
     ID3D12DescriptorHeap*       rtvDescriptorHeap; // RTV
@@ -4,6 +4,9 @@
 */
 #include <Shared.h>
 #include "RenderDevice.h"
+#include "CommandList.h"
+
+#include "Core/Allocators/LinearAllocator.h"
 
 DUSK_ENV_VAR( DisableVendorExtensions, false, bool ); // If true, disable the usage of graphics vendor extension (AMD/Nvidia/Intel/etc.).
 DUSK_ENV_VAR( AutomaticOutputSelection, false, bool ); // If true, automatically chose the output for swapchain creation (overrides user's monitor request).
@@ -19,6 +22,22 @@ RenderDevice::RenderDevice( BaseAllocator* allocator )
 {
     memset( graphicsCmdListAllocator, 0, sizeof( LinearAllocator* ) * PENDING_FRAME_COUNT );
     memset( computeCmdListAllocator, 0, sizeof( LinearAllocator* ) * PENDING_FRAME_COUNT );
+    memset( graphicsCmdListPoolFrameIndex, 0xff, sizeof( size_t ) * PENDING_FRAME_COUNT );
+    memset( computeCmdListPoolFrameIndex, 0xff, sizeof( size_t ) * PENDING_FRAME_COUNT );
+}
+
+CommandList* RenderDevice::allocatePooledCommandList( LinearAllocator* cmdListPool, size_t& poolFrameIndex )
+{
+    // The pool of a frame is only reused PENDING_FRAME_COUNT frames later (once the GPU is done with it); wrapping
+    // around within a frame would hand out a CommandList which is still recorded or pending for submission.
+    if ( poolFrameIndex != frameIndex ) {
+        cmdListPool->clear();
+        poolFrameIndex = frameIndex;
+    }
+
+    DUSK_RAISE_FATAL_ERROR( cmdListPool->getAllocationCount() < CMD_LIST_POOL_CAPACITY, "CommandList pool exhausted (more than %i CommandLists allocated in a single frame)!", CMD_LIST_POOL_CAPACITY );
+
+    return static_cast< CommandList* >( cmdListPool->allocate( sizeof( CommandList ), alignof( CommandList ) ) );
 }
 
 size_t RenderDevice::getFrameIndex() const
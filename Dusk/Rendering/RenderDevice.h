@@ -400,6 +400,24 @@ struct ImageDesc
     {
         return 1u + static_cast< u32 >( floor( log2( Max( description.width, description.height ) ) ) );
     }
+
+    // Return an estimation of the memory footprint (in bytes) of an image matching a given description. Backend specific
+    // alignment/padding requirements are not taken in account.
+    static DUSK_INLINE u64 GetMemoryFootprint( const ImageDesc& description )
+    {
+        const u32 mipCount = ( description.mipCount == 0u ) ? GetMipCount( description ) : description.mipCount;
+
+        u64 mipChainFootprint = 0ull;
+        for ( u32 mipIdx = 0u; mipIdx < mipCount; mipIdx++ ) {
+            const u64 mipWidth = Max( 1u, description.width >> mipIdx );
+            const u64 mipHeight = Max( 1u, description.height >> mipIdx );
+            const u64 mipDepth = Max( 1u, description.depth >> mipIdx );
+
+            mipChainFootprint += mipWidth * mipHeight * mipDepth;
+        }
+
+        return mipChainFootprint * VIEW_FORMAT_STRIDE[description.format] * Max( 1u, description.arraySize ) * Max( 1u, description.samplerCount );
+    }
 };
 
 struct BufferViewDesc
@@ -924,6 +942,79 @@ namespace RenderingHelpers
     static constexpr PipelineStateDesc PS_Compute = PipelineStateDesc( PipelineStateDesc::COMPUTE );
 }
 
+// GPU queue CommandLists are submitted to.
+enum eCommandQueue
+{
+    COMMAND_QUEUE_GRAPHICS = 0,
+    COMMAND_QUEUE_COMPUTE,
+
+    COMMAND_QUEUE_COUNT
+};
+
+#if DUSK_STUB
+// Simulated GPU queue timelines for the last presented frame. Each CommandList submitted takes one time unit to
+// execute; the stats therefore measure how well the submissions overlap rather than the actual GPU workload.
+struct QueueTimelineStats
+{
+    // Time spent executing CommandLists (per queue).
+    u64     BusyTime[COMMAND_QUEUE_COUNT];
+
+    // Time elapsed between the beginning of the frame and the completion of its last CommandList.
+    u64     FrameTime;
+
+    // Number of CommandLists submitted (per queue).
+    u32     SubmittedCommandListCount[COMMAND_QUEUE_COUNT];
+
+    // Number of cross-queue waits inserted.
+    u32     CrossQueueWaitCount;
+};
+
+// Barriers recorded during the last presented frame.
+struct BarrierStats
+{
+    // Number of barrier submissions (a batch recorded with CommandList::resourceBarriers counts as one submission).
+    u32     BarrierBatchCount;
+
+    // Number of barriers recorded (all batches included).
+    u32     BarrierCount;
+
+    // Number of split barriers recorded (begin and end are counted separately).
+    u32     SplitBarrierCount;
+};
+
+// Draw related API calls recorded during the last presented frame.
+struct ApiCallStats
+{
+    // Number of direct draw calls (draw and drawIndexed).
+    u32     DrawCallCount;
+
+    // Number of multi draw indirect calls.
+    u32     MultiDrawCallCount;
+
+    // Number of draws issued by the multi draw indirect calls.
+    u32     IndirectDrawCount;
+
+    // Number of pipeline state binds.
+    u32     PipelineStateBindCount;
+
+    // Number of resource list binds (CommandList::prepareAndBindResourceList calls).
+    u32     ResourceListBindCount;
+
+    // Number of buffer updates.
+    u32     BufferUpdateCount;
+
+    // Number of bytes uploaded by the buffer updates.
+    u64     BufferUpdateSize;
+
+    // Number of binding calls (pipeline states, resources, vertex/index buffers, viewports, scissors and framebuffers)
+    // forwarded to the backend by the submitted CommandLists.
+    u32     IssuedBindCount;
+
+    // Number of redundant binding calls dropped by the submitted CommandLists.
+    u32     FilteredBindCount;
+};
+#endif
+
 enum eImageViewCreationFlags
 {
     IMAGE_VIEW_CREATE_RTV_OR_DSV    = 1 << 1,
@@ -942,8 +1033,10 @@ public:
     static constexpr i32        PENDING_FRAME_COUNT = 3;
 #endif
 
-    // Capacity for each command list type.
-    static constexpr i32        CMD_LIST_POOL_CAPACITY = 32; 
+    // Capacity for each command list type. Should be large enough to give one command list per FrameGraph
+    // renderpass recording chunk (plus the upload command list) for a single frame. The pools are recycled once per
+    // frame; exhausting a pool during a frame is a fatal error.
+    static constexpr i32        CMD_LIST_POOL_CAPACITY = 256;
 
 public:
     // Returns a pointer to the active RenderContext used by the RenderDevice
@@ -975,6 +1068,38 @@ public:
     void                        submitCommandList( CommandList& cmdList );
     void                        submitCommandLists( CommandList** cmdLists, const u32 cmdListCount );
 
+    // Return true if compute CommandLists are executed on a queue running concurrently with the graphics queue.
+    bool                        hasAsyncComputeQueue() const;
+
+    // Return true if the backend implements CommandList::multiDrawIndexedInstancedIndirect.
+    bool                        hasMultiDrawIndirect() const;
+
+    // Return true if CommandList::updateBuffer can update a sub range of a buffer (the rest of the buffer content is
+    // preserved); false if the whole buffer content is discarded on update.
+    bool                        hasPartialBufferUpdate() const;
+
+    // Signal a queue once every CommandList submitted to this queue so far has completed. Return the value signaled
+    // (values are monotonically increasing per queue).
+    u64                         signalQueue( const eCommandQueue queue );
+
+    // Make a queue wait (on the GPU timeline) until 'waitedQueue' has reached a given signal value. CommandLists
+    // submitted to 'queue' afterward won't start before the wait is over.
+    void                        waitQueue( const eCommandQueue queue, const eCommandQueue waitedQueue, const u64 signalValue );
+
+#if DUSK_STUB
+    // Create the device without display surface (the Stub backend never presents to a window).
+    void                        create( const bool useDebugContext = false );
+
+    // Return the simulated queue timelines of the last presented frame.
+    const QueueTimelineStats&   getQueueTimelineStats() const;
+
+    // Return the barriers recorded during the last presented frame.
+    const BarrierStats&         getBarrierStats() const;
+
+    // Return the draw related API calls recorded during the last presented frame.
+    const ApiCallStats&         getApiCallStats() const;
+#endif
+
     size_t                      getFrameIndex() const;
     Image*                      getSwapchainBuffer();
     u32                         getActiveRefreshRate() const;
@@ -1022,6 +1147,15 @@ private:
     
     LinearAllocator*            graphicsCmdListAllocator[PENDING_FRAME_COUNT];
     LinearAllocator*            computeCmdListAllocator[PENDING_FRAME_COUNT];
+
+    // Index of the frame which has last allocated from each CommandList pool. A pool is recycled on the first
+    // allocation of a new frame (CommandLists are recorded and submitted within the frame they are allocated in).
+    size_t                      graphicsCmdListPoolFrameIndex[PENDING_FRAME_COUNT];
+    size_t                      computeCmdListPoolFrameIndex[PENDING_FRAME_COUNT];
+
+private:
+    // Allocate a CommandList from a pool of preallocated CommandLists (see graphicsCmdListPoolFrameIndex).
+    CommandList*                allocatePooledCommandList( LinearAllocator* cmdListPool, size_t& poolFrameIndex );
 };
 
 // TODO Might worth moving this stuff somewhere else since it doesn't belong here...
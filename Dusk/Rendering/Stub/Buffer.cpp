@@ -8,6 +8,8 @@
 #include "Rendering/CommandList.h"
 #include "Rendering/RenderDevice.h"
 
+#include "RenderDevice.h"
+
 Buffer* RenderDevice::createBuffer( const BufferDesc& description, const void* initialData )
 {
     return nullptr;
@@ -25,17 +27,28 @@ void RenderDevice::setDebugMarker( Buffer& buffer, const dkChar_t* objectName )
 
 void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex )
 {
-
+    shouldBindVertexBuffers( buffers, offsets, bufferCount, startBindIndex );
 }
 
 void CommandList::bindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices )
 {
-
+    shouldBindIndiceBuffer( buffer, use32bitsIndices );
 }
 
 void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t dataSize )
 {
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->bufferUpdateCount++;
+        nativeCommandList->renderContext->bufferUpdateSize += dataSize;
+    }
+}
 
+void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t dataSize, const size_t offsetInBytes )
+{
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->bufferUpdateCount++;
+        nativeCommandList->renderContext->bufferUpdateSize += dataSize;
+    }
 }
 
 void* CommandList::mapBuffer( Buffer& buffer, const u32 startOffsetInBytes, const u32 sizeInBytes )
@@ -50,7 +63,11 @@ void CommandList::unmapBuffer( Buffer& buffer )
 
 void CommandList::transitionBuffer( Buffer& buffer, const eResourceState state )
 {
-
+    // Explicit transitions are submitted one barrier at a time.
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->barrierBatchCount++;
+        nativeCommandList->renderContext->barrierCount++;
+    }
 }
 
 void CommandList::copyBuffer( Buffer* sourceBuffer, Buffer* destBuffer )
@@ -6,6 +6,9 @@
 
 #if DUSK_STUB
 #include "Rendering/CommandList.h"
+#include "Rendering/RenderDevice.h"
+
+#include "RenderDevice.h"
 
 CommandList::CommandList( const CommandList::Type cmdListType )
     : memoryAllocator( nullptr )
@@ -14,7 +17,7 @@ CommandList::CommandList( const CommandList::Type cmdListType )
     , resourceFrameIndex( 0 )
     , commandListPoolIndex( 0 )
 {
-
+    resetBindingCache();
 }
 
 CommandList::~CommandList()
@@ -24,7 +27,8 @@ CommandList::~CommandList()
 
 void CommandList::initialize( BaseAllocator* allocator, const i32 pooledIndex )
 {
-
+    memoryAllocator = allocator;
+    commandListPoolIndex = pooledIndex;
 }
 
 void CommandList::end()
@@ -34,22 +38,26 @@ void CommandList::end()
 
 void CommandList::setViewport( const Viewport& viewport )
 {
-
+    shouldSetViewport( viewport );
 }
 
 void CommandList::setScissor( const ScissorRegion& scissorRegion )
 {
-
+    shouldSetScissor( scissorRegion );
 }
 
 void CommandList::draw( const u32 vertexCount, const u32 instanceCount, const u32 vertexOffset, const u32 instanceOffset )
 {
-
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->drawCallCount++;
+    }
 }
 
 void CommandList::drawIndexed( const u32 indiceCount, const u32 instanceCount, const u32 indiceOffset, const u32 vertexOffset, const u32 instanceOffset )
 {
-
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->drawCallCount++;
+    }
 }
 
 void CommandList::dispatchCompute( const u32 threadCountX, const u32 threadCountY, const u32 threadCountZ )
@@ -69,6 +77,9 @@ void CommandList::popEventMarker()
 
 void CommandList::multiDrawIndexedInstancedIndirect( const u32 instanceCount, Buffer* argsBuffer, const u32 bufferAlignmentInBytes /* = 0u */, const u32 argumentsSizeInBytes /* = 0u */ )
 {
-
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->multiDrawCallCount++;
+        nativeCommandList->renderContext->indirectDrawCount += instanceCount;
+    }
 }
 #endif
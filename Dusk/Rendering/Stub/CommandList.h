@@ -0,0 +1,15 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#if DUSK_STUB
+struct RenderContext;
+
+struct NativeCommandList
+{
+    // RenderContext owning the CommandList (used to account the commands recorded).
+    RenderContext*  renderContext;
+};
+#endif
@@ -5,6 +5,22 @@
 #include <Shared.h>
 
 #if DUSK_STUB
+#include "Rendering/CommandList.h"
+
+#include "RenderDevice.h"
+
+static void AccountBarrierBatch( NativeCommandList* nativeCommandList, const u32 barrierCount, const u32 splitBarrierCount )
+{
+    if ( nativeCommandList == nullptr ) {
+        return;
+    }
+
+    RenderContext* renderContext = nativeCommandList->renderContext;
+    renderContext->barrierBatchCount++;
+    renderContext->barrierCount += barrierCount;
+    renderContext->splitBarrierCount += splitBarrierCount;
+}
+
 Image* RenderDevice::createImage( const ImageDesc& description, const void* initialData, const size_t initialDataSize )
 {
     return nullptr;
@@ -27,17 +43,37 @@ void RenderDevice::createImageView( Image& image, const ImageViewDesc& viewDescr
 
 void CommandList::transitionImage( Image& image, const eResourceState state, const u32 mipIndex, const TransitionType transitionType )
 {
+    // Explicit transitions are submitted one barrier at a time.
+    AccountBarrierBatch( nativeCommandList, 1u, 0u );
+}
 
+void CommandList::resourceBarriers( const ResourceBarrier* barriers, const u32 barrierCount )
+{
+    if ( barrierCount == 0u ) {
+        return;
+    }
+
+    u32 splitBarrierCount = 0u;
+    for ( u32 i = 0u; i < barrierCount; i++ ) {
+        if ( barriers[i].Type != BARRIER_TYPE_FULL ) {
+            splitBarrierCount++;
+        }
+    }
+
+    AccountBarrierBatch( nativeCommandList, barrierCount, splitBarrierCount );
 }
 
 void CommandList::insertComputeBarrier( Image& image )
 {
-
+    AccountBarrierBatch( nativeCommandList, 1u, 0u );
 }
 
 void CommandList::setupFramebuffer( FramebufferAttachment* renderTargetViews, FramebufferAttachment depthStencilView )
 {
-
+    // The headless device has no pipeline state to retrieve the attachment count from; the first attachment is assumed
+    // to be the only one.
+    const u32 renderTargetCount = ( renderTargetViews != nullptr ) ? 1u : 0u;
+    shouldSetupFramebuffer( renderTargetViews, renderTargetCount, depthStencilView, false );
 }
 
 void CommandList::clearRenderTargets( Image** renderTargetViews, const u32 renderTargetCount, const f32 clearValues[4] )
@@ -5,6 +5,11 @@
 #include <Shared.h>
 
 #if DUSK_STUB
+#include "Rendering/CommandList.h"
+#include "Rendering/RenderDevice.h"
+
+#include "RenderDevice.h"
+
 Shader* RenderDevice::createShader( const eShaderStage stage, const void* bytecode, const size_t bytecodeSize )
 {
     return nullptr;
@@ -22,7 +27,13 @@ PipelineState* RenderDevice::createPipelineState( const PipelineStateDesc& descr
 
 void CommandList::prepareAndBindResourceList()
 {
+    if ( !shouldPrepareAndBindResourceList() ) {
+        return;
+    }
 
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->resourceListBindCount++;
+    }
 }
 
 void RenderDevice::destroyPipelineState( PipelineState* pipelineState )
@@ -42,31 +53,37 @@ void RenderDevice::destroyPipelineStateCache( PipelineState* pipelineState )
 
 void CommandList::bindPipelineState( PipelineState* pipelineState )
 {
+    if ( !shouldBindPipelineState( pipelineState ) ) {
+        return;
+    }
 
+    if ( nativeCommandList != nullptr ) {
+        nativeCommandList->renderContext->pipelineStateBindCount++;
+    }
 }
 
 void CommandList::begin()
 {
-
+    resetBindingCache();
 }
 
 void CommandList::bindConstantBuffer( const dkStringHash_t hashcode, Buffer* buffer )
 {
-
+    shouldBindResource( hashcode, buffer );
 }
 
 void CommandList::bindImage( const dkStringHash_t hashcode, Image* image, const ImageViewDesc viewDescription )
 {
-
+    shouldBindResource( hashcode, image, viewDescription.SortKey );
 }
 
 void CommandList::bindBuffer( const dkStringHash_t hashcode, Buffer* buffer, const eViewFormat viewFormat )
 {
-
+    shouldBindResource( hashcode, buffer, static_cast<u64>( viewFormat ) );
 }
 
 void CommandList::bindSampler( const dkStringHash_t hashcode, Sampler* sampler )
 {
-
+    shouldBindResource( hashcode, sampler );
 }
 #endif
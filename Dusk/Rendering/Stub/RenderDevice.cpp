@@ -8,16 +8,64 @@
 #include "Rendering/RenderDevice.h"
 #include "Rendering/CommandList.h"
 
+#include "RenderDevice.h"
+
+static void SimulateSubmission( RenderContext* renderContext, const CommandList& cmdList )
+{
+    const eCommandQueue queue = ( cmdList.getCommandListType() == CommandList::Type::GRAPHICS ) ? COMMAND_QUEUE_GRAPHICS : COMMAND_QUEUE_COMPUTE;
+
+    renderContext->queueTime[queue]++;
+    renderContext->currentFrameStats.BusyTime[queue]++;
+    renderContext->currentFrameStats.SubmittedCommandListCount[queue]++;
+
+    const CommandListBindingStats& bindingStats = cmdList.getBindingStats();
+    renderContext->issuedBindCount += bindingStats.IssuedBindCount;
+    renderContext->filteredBindCount += bindingStats.FilteredBindCount;
+}
+
+static CommandList& AllocateCommandList( RenderContext* renderContext, CommandList** cmdLists, u32& cmdListIndex )
+{
+    // The pool is recycled on present; wrapping around within a frame would hand out a CommandList which is still
+    // recorded or pending for submission.
+    DUSK_RAISE_FATAL_ERROR( cmdListIndex < RenderDevice::CMD_LIST_POOL_CAPACITY, "CommandList pool exhausted (more than %i CommandLists allocated in a single frame)!", RenderDevice::CMD_LIST_POOL_CAPACITY );
+
+    CommandList* cmdList = cmdLists[cmdListIndex++];
+
+    cmdList->setNativeCommandList( &renderContext->nativeCommandList );
+    return *cmdList;
+}
+
 RenderDevice::~RenderDevice()
 {
+    for ( i32 i = 0; i < CMD_LIST_POOL_CAPACITY; i++ ) {
+        dk::core::free( memoryAllocator, renderContext->graphicsCmdLists[i] );
+        dk::core::free( memoryAllocator, renderContext->computeCmdLists[i] );
+    }
 
+    dk::core::free( memoryAllocator, renderContext );
 }
 
 void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefreshRate, const bool useDebugContext)
 {
     DUSK_UNUSED_VARIABLE( displaySurface );
     DUSK_UNUSED_VARIABLE( desiredRefreshRate );
+
+    create( useDebugContext );
+}
+
+void RenderDevice::create( const bool useDebugContext )
+{
     DUSK_UNUSED_VARIABLE( useDebugContext );
+
+    renderContext = dk::core::allocate<RenderContext>( memoryAllocator );
+
+    for ( i32 i = 0; i < CMD_LIST_POOL_CAPACITY; i++ ) {
+        renderContext->graphicsCmdLists[i] = dk::core::allocate<CommandList>( memoryAllocator, CommandList::Type::GRAPHICS );
+        renderContext->computeCmdLists[i] = dk::core::allocate<CommandList>( memoryAllocator, CommandList::Type::COMPUTE );
+
+        renderContext->graphicsCmdLists[i]->initialize( memoryAllocator, i );
+        renderContext->computeCmdLists[i]->initialize( memoryAllocator, i );
+    }
 }
 
 void RenderDevice::enableVerticalSynchronisation( const bool enabled )
@@ -27,35 +75,115 @@ void RenderDevice::enableVerticalSynchronisation( const bool enabled )
 
 CommandList& RenderDevice::allocateGraphicsCommandList()
 {
-    static CommandList STUB_CMDLIST_GFX( CommandList::Type::GRAPHICS );
-    return STUB_CMDLIST_GFX;
+    return AllocateCommandList( renderContext, renderContext->graphicsCmdLists, renderContext->graphicsCmdListIndex );
 }
 
 CommandList& RenderDevice::allocateComputeCommandList()
 {
-    static CommandList STUB_CMDLIST_COMPUTE( CommandList::Type::COMPUTE );
-    return STUB_CMDLIST_COMPUTE;
+    return AllocateCommandList( renderContext, renderContext->computeCmdLists, renderContext->computeCmdListIndex );
 }
 
 CommandList& RenderDevice::allocateCopyCommandList()
 {
-    static CommandList STUB_CMDLIST_COPY( CommandList::Type::COMPUTE );
-    return STUB_CMDLIST_COPY;
+    return allocateComputeCommandList();
 }
 
 void RenderDevice::submitCommandList( CommandList& cmdList )
 {
-    DUSK_UNUSED_VARIABLE( cmdList );
+    SimulateSubmission( renderContext, cmdList );
 }
 
 void RenderDevice::submitCommandLists( CommandList** cmdLists, const u32 cmdListCount )
 {
+    for ( u32 i = 0u; i < cmdListCount; i++ ) {
+        SimulateSubmission( renderContext, *cmdLists[i] );
+    }
+}
 
+bool RenderDevice::hasAsyncComputeQueue() const
+{
+    return true;
 }
 
-void RenderDevice::present()
+bool RenderDevice::hasMultiDrawIndirect() const
+{
+    return true;
+}
+
+bool RenderDevice::hasPartialBufferUpdate() const
+{
+    return true;
+}
+
+u64 RenderDevice::signalQueue( const eCommandQueue queue )
+{
+    const u64 signalValue = ++renderContext->signalValue[queue];
+    renderContext->signalTime[queue][signalValue % SIGNAL_HISTORY_SIZE] = renderContext->queueTime[queue];
+
+    return signalValue;
+}
+
+void RenderDevice::waitQueue( const eCommandQueue queue, const eCommandQueue waitedQueue, const u64 signalValue )
+{
+    DUSK_DEV_ASSERT( signalValue <= renderContext->signalValue[waitedQueue], "Waiting on a value which has not been signaled yet (deadlock)!" );
+    DUSK_DEV_ASSERT( signalValue + SIGNAL_HISTORY_SIZE > renderContext->signalValue[waitedQueue], "Signal history is too short!" );
+
+    const u64 signalTime = renderContext->signalTime[waitedQueue][signalValue % SIGNAL_HISTORY_SIZE];
+    renderContext->queueTime[queue] = Max( renderContext->queueTime[queue], signalTime );
+    renderContext->currentFrameStats.CrossQueueWaitCount++;
+}
+
+const QueueTimelineStats& RenderDevice::getQueueTimelineStats() const
+{
+    return renderContext->lastFrameStats;
+}
+
+const BarrierStats& RenderDevice::getBarrierStats() const
 {
+    return renderContext->lastFrameBarrierStats;
+}
 
+const ApiCallStats& RenderDevice::getApiCallStats() const
+{
+    return renderContext->lastFrameApiCallStats;
+}
+
+void RenderDevice::present()
+{
+    // Presentation waits for every queue to be idle; the next frame starts once the longest timeline is completed.
+    u64 frameEndTime = renderContext->frameStartTime;
+    for ( i32 i = 0; i < COMMAND_QUEUE_COUNT; i++ ) {
+        frameEndTime = Max( frameEndTime, renderContext->queueTime[i] );
+    }
+
+    for ( i32 i = 0; i < COMMAND_QUEUE_COUNT; i++ ) {
+        renderContext->queueTime[i] = frameEndTime;
+    }
+
+    renderContext->currentFrameStats.FrameTime = ( frameEndTime - renderContext->frameStartTime );
+    renderContext->lastFrameStats = renderContext->currentFrameStats;
+
+    memset( &renderContext->currentFrameStats, 0, sizeof( QueueTimelineStats ) );
+
+    renderContext->graphicsCmdListIndex = 0u;
+    renderContext->computeCmdListIndex = 0u;
+
+    BarrierStats& barrierStats = renderContext->lastFrameBarrierStats;
+    barrierStats.BarrierBatchCount = renderContext->barrierBatchCount.exchange( 0u );
+    barrierStats.BarrierCount = renderContext->barrierCount.exchange( 0u );
+    barrierStats.SplitBarrierCount = renderContext->splitBarrierCount.exchange( 0u );
+
+    ApiCallStats& apiCallStats = renderContext->lastFrameApiCallStats;
+    apiCallStats.DrawCallCount = renderContext->drawCallCount.exchange( 0u );
+    apiCallStats.MultiDrawCallCount = renderContext->multiDrawCallCount.exchange( 0u );
+    apiCallStats.IndirectDrawCount = renderContext->indirectDrawCount.exchange( 0u );
+    apiCallStats.PipelineStateBindCount = renderContext->pipelineStateBindCount.exchange( 0u );
+    apiCallStats.ResourceListBindCount = renderContext->resourceListBindCount.exchange( 0u );
+    apiCallStats.BufferUpdateCount = renderContext->bufferUpdateCount.exchange( 0u );
+    apiCallStats.BufferUpdateSize = renderContext->bufferUpdateSize.exchange( 0ull );
+    apiCallStats.IssuedBindCount = renderContext->issuedBindCount.exchange( 0u );
+    apiCallStats.FilteredBindCount = renderContext->filteredBindCount.exchange( 0u );
+    renderContext->frameStartTime = frameEndTime;
 }
 
 void RenderDevice::waitForPendingFrameCompletion()
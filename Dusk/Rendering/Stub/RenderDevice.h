@@ -0,0 +1,101 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#if DUSK_STUB
+#include <atomic>
+
+#include <Rendering/RenderDevice.h>
+
+#include "CommandList.h"
+
+// Number of signals remembered per queue (a wait must target one of the last SIGNAL_HISTORY_SIZE signals).
+static constexpr u64 SIGNAL_HISTORY_SIZE = 1024ull;
+
+// The headless device does not execute anything; it models a timeline per queue instead (one time unit per
+// CommandList) so that the overlap achieved by a given submission can be measured.
+struct RenderContext
+{
+    // Time at which the last CommandList submitted to a queue completes.
+    u64                 queueTime[COMMAND_QUEUE_COUNT];
+
+    // Last value signaled on a queue.
+    u64                 signalValue[COMMAND_QUEUE_COUNT];
+
+    // Completion time of the last signals (indexed by signal value modulo the history size).
+    u64                 signalTime[COMMAND_QUEUE_COUNT][SIGNAL_HISTORY_SIZE];
+
+    // Time at which the frame being recorded began.
+    u64                 frameStartTime;
+
+    // Stats of the frame being recorded.
+    QueueTimelineStats  currentFrameStats;
+
+    // Stats of the last presented frame.
+    QueueTimelineStats  lastFrameStats;
+
+    // Barriers recorded for the frame being recorded (CommandLists are recorded concurrently).
+    std::atomic<u32>    barrierBatchCount;
+    std::atomic<u32>    barrierCount;
+    std::atomic<u32>    splitBarrierCount;
+
+    // Barriers recorded during the last presented frame.
+    BarrierStats        lastFrameBarrierStats;
+
+    // Draw related API calls recorded for the frame being recorded.
+    std::atomic<u32>    drawCallCount;
+    std::atomic<u32>    multiDrawCallCount;
+    std::atomic<u32>    indirectDrawCount;
+    std::atomic<u32>    pipelineStateBindCount;
+    std::atomic<u32>    resourceListBindCount;
+    std::atomic<u32>    bufferUpdateCount;
+    std::atomic<u64>    bufferUpdateSize;
+    std::atomic<u32>    issuedBindCount;
+    std::atomic<u32>    filteredBindCount;
+
+    // Draw related API calls recorded during the last presented frame.
+    ApiCallStats        lastFrameApiCallStats;
+
+    // Native CommandList shared by the CommandLists allocated by the device.
+    NativeCommandList   nativeCommandList;
+
+    // CommandLists allocated by the device (each recording chunk records to its own CommandList; the pool is recycled
+    // on present).
+    CommandList*        graphicsCmdLists[RenderDevice::CMD_LIST_POOL_CAPACITY];
+    CommandList*        computeCmdLists[RenderDevice::CMD_LIST_POOL_CAPACITY];
+    u32                 graphicsCmdListIndex;
+    u32                 computeCmdListIndex;
+
+    RenderContext()
+        : frameStartTime( 0ull )
+        , barrierBatchCount( 0u )
+        , barrierCount( 0u )
+        , splitBarrierCount( 0u )
+        , drawCallCount( 0u )
+        , multiDrawCallCount( 0u )
+        , indirectDrawCount( 0u )
+        , pipelineStateBindCount( 0u )
+        , resourceListBindCount( 0u )
+        , bufferUpdateCount( 0u )
+        , bufferUpdateSize( 0ull )
+        , issuedBindCount( 0u )
+        , filteredBindCount( 0u )
+        , graphicsCmdListIndex( 0u )
+        , computeCmdListIndex( 0u )
+    {
+        memset( queueTime, 0, sizeof( u64 ) * COMMAND_QUEUE_COUNT );
+        memset( signalValue, 0, sizeof( u64 ) * COMMAND_QUEUE_COUNT );
+        memset( signalTime, 0, sizeof( u64 ) * COMMAND_QUEUE_COUNT * SIGNAL_HISTORY_SIZE );
+        memset( &currentFrameStats, 0, sizeof( QueueTimelineStats ) );
+        memset( &lastFrameStats, 0, sizeof( QueueTimelineStats ) );
+        memset( &lastFrameBarrierStats, 0, sizeof( BarrierStats ) );
+        memset( &lastFrameApiCallStats, 0, sizeof( ApiCallStats ) );
+        memset( graphicsCmdLists, 0, sizeof( CommandList* ) * RenderDevice::CMD_LIST_POOL_CAPACITY );
+        memset( computeCmdLists, 0, sizeof( CommandList* ) * RenderDevice::CMD_LIST_POOL_CAPACITY );
+
+        nativeCommandList.renderContext = this;
+    }
+};
+#endif
@@ -133,6 +133,10 @@ void RenderDevice::setDebugMarker( Buffer& buffer, const dkChar_t* objectName )
 
 void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets, const u32 bufferCount, const u32 startBindIndex )
 {
+    if ( !shouldBindVertexBuffers( buffers, offsets, bufferCount, startBindIndex ) ) {
+        return;
+    }
+
     VkDeviceSize nativeOffsets[8];
     VkBuffer nativeBuffers[8];
 
@@ -146,6 +150,10 @@ void CommandList::bindVertexBuffer( const Buffer** buffers, const u32* offsets,
 
 void CommandList::bindIndiceBuffer( const Buffer* buffer, const bool use32bitsIndices )
 {
+    if ( !shouldBindIndiceBuffer( buffer, use32bitsIndices ) ) {
+        return;
+    }
+
     VkIndexType indexType = ( use32bitsIndices ) ? VkIndexType::VK_INDEX_TYPE_UINT32 : VkIndexType::VK_INDEX_TYPE_UINT16;
 
     vkCmdBindIndexBuffer( nativeCommandList->cmdList, buffer->resource[resourceFrameIndex], 0, indexType );
@@ -158,6 +166,20 @@ void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t d
     vkCmdUpdateBuffer( nativeCommandList->cmdList, buffer.resource[resourceFrameIndex], 0ull, dataSize, data );
 }
 
+void CommandList::updateBuffer( Buffer& buffer, const void* data, const size_t dataSize, const size_t offsetInBytes )
+{
+    DUSK_RAISE_FATAL_ERROR( !nativeCommandList->isInRenderPass, "Trying to call vkCmdUpdateBuffer inside a RenderPass!" );
+
+    // vkCmdUpdateBuffer is limited to 64KB per call.
+    static constexpr size_t MAX_UPDATE_SIZE = 65536;
+
+    const u8* updateData = static_cast<const u8*>( data );
+    for ( size_t updateOffset = 0; updateOffset < dataSize; updateOffset += MAX_UPDATE_SIZE ) {
+        const size_t updateSize = Min( dataSize - updateOffset, MAX_UPDATE_SIZE );
+        vkCmdUpdateBuffer( nativeCommandList->cmdList, buffer.resource[resourceFrameIndex], static_cast<VkDeviceSize>( offsetInBytes + updateOffset ), updateSize, updateData + updateOffset );
+    }
+}
+
 void* CommandList::mapBuffer( Buffer& buffer, const u32 startOffsetInBytes, const u32 sizeInBytes )
 {
     void* mappedMemoryAddress = nullptr;
@@ -5,7 +5,9 @@
 #include <Shared.h>
 
 #if DUSK_VULKAN
+#include <Rendering/RenderDevice.h>
 #include <Rendering/CommandList.h>
+#include "Buffer.h"
 #include "CommandList.h"
 
 #include <Core/StringHelpers.h>
@@ -16,6 +18,9 @@ NativeCommandList::NativeCommandList()
     : cmdList( VK_NULL_HANDLE )
     , vkCmdDebugMarkerBegin( nullptr )
     , vkCmdDebugMarkerEnd( nullptr )
+    , splitBarrierEvents( nullptr )
+    , isMultiDrawIndirectSupported( false )
+    , imageStateUpdateCount( 0u )
 {
 
 }
@@ -60,6 +65,10 @@ void CommandList::setViewport( const Viewport& viewport )
 {
     DUSK_DEV_ASSERT( commandListType == CommandList::Type::GRAPHICS, "Called setViewport on a compute command list! The call will be ignored." );
 
+    if ( !shouldSetViewport( viewport ) ) {
+        return;
+    }
+
     nativeCommandList->activeViewport = viewport;
 
     VkViewport vkViewport;
@@ -77,6 +86,10 @@ void CommandList::setScissor( const ScissorRegion& scissorRegion )
 {
     DUSK_DEV_ASSERT( commandListType == CommandList::Type::GRAPHICS, "Called setScissor on a compute command list! The call will be ignored." );
 
+    if ( !shouldSetScissor( scissorRegion ) ) {
+        return;
+    }
+
     VkRect2D vkScissor;
     vkScissor.offset.x = scissorRegion.Left;
     vkScissor.offset.y = scissorRegion.Top;
@@ -103,7 +116,16 @@ void CommandList::dispatchCompute( const u32 threadCountX, const u32 threadCount
 
 void CommandList::multiDrawIndexedInstancedIndirect( const u32 instanceCount, Buffer* argsBuffer, const u32 bufferAlignmentInBytes, const u32 argumentsSizeInBytes )
 {
+    VkBuffer argsResource = argsBuffer->resource[resourceFrameIndex];
+    if ( nativeCommandList->isMultiDrawIndirectSupported ) {
+        vkCmdDrawIndexedIndirect( nativeCommandList->cmdList, argsResource, bufferAlignmentInBytes, instanceCount, argumentsSizeInBytes );
+        return;
+    }
 
+    // Without the multiDrawIndirect feature, drawCount must be 0 or 1.
+    for ( u32 drawIndex = 0u; drawIndex < instanceCount; drawIndex++ ) {
+        vkCmdDrawIndexedIndirect( nativeCommandList->cmdList, argsResource, bufferAlignmentInBytes + drawIndex * argumentsSizeInBytes, 1u, argumentsSizeInBytes );
+    }
 }
 
 void CommandList::pushEventMarker( const dkChar_t* eventName )
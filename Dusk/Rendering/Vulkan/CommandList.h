@@ -12,8 +12,22 @@
 
 #include <Rendering/CommandList.h>
 
+struct Image;
+
+// State of an image after the barriers recorded on a CommandList.
+struct ImageStateUpdate
+{
+    Image*                  ImageResource;
+    eResourceState          State;
+    VkImageLayout           Layout;
+    VkPipelineStageFlags    Stage;
+};
+
 struct NativeCommandList
 {
+    // Maximum number of images a CommandList can transition.
+    static constexpr u32                        MAX_IMAGE_STATE_UPDATE_COUNT = 128u;
+
                                                                 NativeCommandList();
                                                                 ~NativeCommandList();
 
@@ -23,6 +37,7 @@ struct NativeCommandList
 
     VkDevice                                              device; // Required to do descriptorSet allocation from descriptorSetPool (sadly)
     VkDescriptorPool                                descriptorPool; // renderDevice->descriptorPool[currentFrameResIdx]
+    VkEvent*                                        splitBarrierEvents; // renderDevice->splitBarrierEvents[currentFrameResIdx]
 
     Viewport                                               activeViewport;
     PipelineState*                                      BindedPipelineState;
@@ -46,6 +61,14 @@ struct NativeCommandList
     // TODO For debug purposes, should be removed later
     bool                                    isInRenderPass;
 
+    // True if indirect draws can be issued with drawCount > 1 (see VkPhysicalDeviceFeatures::multiDrawIndirect).
+    bool                                    isMultiDrawIndirectSupported;
+
+    // Image states changed by the barriers recorded on this CommandList. CommandLists are recorded concurrently; the
+    // states are only committed to the images on submission (in submission order).
+    ImageStateUpdate                        imageStateUpdates[MAX_IMAGE_STATE_UPDATE_COUNT];
+    u32                                     imageStateUpdateCount;
+
     VkDescriptorBufferInfo  bufferInfos[256];
     VkDescriptorImageInfo imageInfos[256];
     VkDescriptorSet             activeDescriptorSets[8];
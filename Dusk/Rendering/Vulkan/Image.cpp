@@ -10,6 +10,7 @@
 
 #include "CommandList.h"
 #include "Image.h"
+#include "Buffer.h"
 #include "ImageHelpers.h"
 #include "ResourceAllocationHelpers.h"
 
@@ -454,9 +455,81 @@ static DUSK_INLINE VkPipelineStageFlags GetStageFlags( const VkAccessFlags acces
     return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 }
 
+// Return the state of an image as seen by the commands recorded so far on a CommandList.
+static ImageStateUpdate GetImageState( const NativeCommandList& nativeCommandList, Image& image, const i32 resourceFrameIndex )
+{
+    for ( u32 i = nativeCommandList.imageStateUpdateCount; i-- > 0u; ) {
+        if ( nativeCommandList.imageStateUpdates[i].ImageResource == &image ) {
+            return nativeCommandList.imageStateUpdates[i];
+        }
+    }
+
+    return ImageStateUpdate{ &image, image.currentState[resourceFrameIndex], image.currentLayout[resourceFrameIndex], image.currentStage[resourceFrameIndex] };
+}
+
+// Update the state of an image for the commands recorded next on a CommandList (see NativeCommandList::imageStateUpdates).
+static void SetImageState( NativeCommandList& nativeCommandList, Image& image, const eResourceState state, const VkImageLayout layout, const VkPipelineStageFlags stage )
+{
+    const ImageStateUpdate stateUpdate = { &image, state, layout, stage };
+
+    for ( u32 i = 0u; i < nativeCommandList.imageStateUpdateCount; i++ ) {
+        if ( nativeCommandList.imageStateUpdates[i].ImageResource == &image ) {
+            nativeCommandList.imageStateUpdates[i] = stateUpdate;
+            return;
+        }
+    }
+
+    DUSK_RAISE_FATAL_ERROR( nativeCommandList.imageStateUpdateCount < NativeCommandList::MAX_IMAGE_STATE_UPDATE_COUNT, "Too many images transitioned by a single CommandList (max is %u)!", NativeCommandList::MAX_IMAGE_STATE_UPDATE_COUNT );
+    nativeCommandList.imageStateUpdates[nativeCommandList.imageStateUpdateCount++] = stateUpdate;
+}
+
+// Barriers can't be recorded inside a render pass; the render pass is restarted by the next framebuffer setup.
+static void EndActiveRenderPass( NativeCommandList& nativeCommandList )
+{
+    if ( nativeCommandList.isInRenderPass ) {
+        vkCmdEndRenderPass( nativeCommandList.cmdList );
+        nativeCommandList.isInRenderPass = false;
+    }
+}
+
+VkImageLayout GetBindingLayout( const NativeCommandList& nativeCommandList, const Image& image, const VkDescriptorType descriptorType, const i32 resourceFrameIndex )
+{
+    if ( descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE ) {
+        return VK_IMAGE_LAYOUT_GENERAL;
+    }
+
+    for ( u32 i = nativeCommandList.imageStateUpdateCount; i-- > 0u; ) {
+        if ( nativeCommandList.imageStateUpdates[i].ImageResource == &image ) {
+            return nativeCommandList.imageStateUpdates[i].Layout;
+        }
+    }
+
+    // The image has been transitioned to a read state by the barriers of the RenderPass (possibly recorded on another
+    // CommandList if the recording is split).
+    return ( image.aspectFlag & VK_IMAGE_ASPECT_DEPTH_BIT ) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+void CommitImageStates( NativeCommandList& nativeCommandList, const i32 resourceFrameIndex )
+{
+    for ( u32 i = 0u; i < nativeCommandList.imageStateUpdateCount; i++ ) {
+        const ImageStateUpdate& stateUpdate = nativeCommandList.imageStateUpdates[i];
+
+        Image& image = *stateUpdate.ImageResource;
+        image.currentState[resourceFrameIndex] = stateUpdate.State;
+        image.currentLayout[resourceFrameIndex] = stateUpdate.Layout;
+        image.currentStage[resourceFrameIndex] = stateUpdate.Stage;
+    }
+
+    nativeCommandList.imageStateUpdateCount = 0u;
+}
+
 void CommandList::transitionImage( Image& image, const eResourceState state, const u32 mipIndex, const TransitionType transitionType )
 {
-    const eResourceState previousState = image.currentState[resourceFrameIndex];
+    // Image descriptors store the layout of the image; bindings recorded so far must be written again.
+    invalidateResourceBindings();
+
+    const ImageStateUpdate imageState = GetImageState( *nativeCommandList, image, resourceFrameIndex );
+    const eResourceState previousState = imageState.State;
 
     VkImageLayout oldLayout = GetLayout( previousState );
     VkImageLayout newLayout = GetLayout( state );
@@ -470,7 +543,7 @@ void CommandList::transitionImage( Image& image, const eResourceState state, con
 
     VkPipelineStageFlags stageFlags = ( commandListType == CommandList::Type::GRAPHICS ) ? VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 
-    VkPipelineStageFlags srcStage =  image.currentStage[resourceFrameIndex];
+    VkPipelineStageFlags srcStage = imageState.Stage;
     VkPipelineStageFlags dstStage = GetStageFlags( dstAccess, stageFlags );
 
     u32 srcQueueIdx = VK_QUEUE_FAMILY_IGNORED;
@@ -514,11 +587,150 @@ void CommandList::transitionImage( Image& image, const eResourceState state, con
     imgBarrier.subresourceRange.baseArrayLayer = 0;
     imgBarrier.subresourceRange.layerCount = 1;
 
+    EndActiveRenderPass( *nativeCommandList );
     vkCmdPipelineBarrier( nativeCommandList->cmdList, srcStage, dstStage, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 1, &imgBarrier );
 
-    image.currentLayout[resourceFrameIndex] = newLayout;
-    image.currentState[resourceFrameIndex] = state;
-    image.currentStage[resourceFrameIndex] = dstStage;
+    SetImageState( *nativeCommandList, image, state, newLayout, dstStage );
+}
+
+void CommandList::resourceBarriers( const ResourceBarrier* barriers, const u32 barrierCount )
+{
+    invalidateResourceBindings();
+    EndActiveRenderPass( *nativeCommandList );
+
+    // Full barriers are flushed with a single vkCmdPipelineBarrier call; split barriers are implemented with events
+    // (the begin signals the resource event once the previous accesses are done; the ends of the batch are flushed with
+    // a single vkCmdWaitEvents call). Batches too large for the stack storage are flushed in chunks.
+    static constexpr u32 MAX_BARRIER_PER_CALL = 32u;
+
+    struct BarrierBatch {
+        VkImageMemoryBarrier    ImageBarriers[MAX_BARRIER_PER_CALL];
+        VkBufferMemoryBarrier   BufferBarriers[MAX_BARRIER_PER_CALL];
+        VkEvent                 Events[MAX_BARRIER_PER_CALL * 2u];
+        u32                     ImageBarrierCount;
+        u32                     BufferBarrierCount;
+        u32                     EventCount;
+        VkPipelineStageFlags    SrcStage;
+        VkPipelineStageFlags    DstStage;
+    };
+
+    BarrierBatch fullBatch = {};
+    BarrierBatch splitBatch = {};
+
+    const VkPipelineStageFlags psoStageFlags = ( commandListType == CommandList::Type::GRAPHICS ) ? VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+    auto flushBatch = [&]( BarrierBatch& batch ) {
+        if ( batch.ImageBarrierCount == 0u && batch.BufferBarrierCount == 0u ) {
+            return;
+        }
+
+        if ( batch.EventCount == 0u ) {
+            vkCmdPipelineBarrier( nativeCommandList->cmdList, batch.SrcStage, batch.DstStage, 0, 0, VK_NULL_HANDLE, batch.BufferBarrierCount, batch.BufferBarriers, batch.ImageBarrierCount, batch.ImageBarriers );
+        } else {
+            vkCmdWaitEvents( nativeCommandList->cmdList, batch.EventCount, batch.Events, batch.SrcStage, batch.DstStage, 0, VK_NULL_HANDLE, batch.BufferBarrierCount, batch.BufferBarriers, batch.ImageBarrierCount, batch.ImageBarriers );
+        }
+
+        batch.ImageBarrierCount = 0u;
+        batch.BufferBarrierCount = 0u;
+        batch.EventCount = 0u;
+        batch.SrcStage = 0;
+        batch.DstStage = 0;
+    };
+
+    for ( u32 i = 0u; i < barrierCount; i++ ) {
+        const ResourceBarrier& barrier = barriers[i];
+
+        // The image state is only needed if the FrameGraph doesn't know the state before the barrier (first transition
+        // of the frame).
+        const ImageStateUpdate imageState = ( barrier.ImageResource != nullptr ) ? GetImageState( *nativeCommandList, *barrier.ImageResource, resourceFrameIndex ) : ImageStateUpdate{};
+
+        // Stage of the accesses preceding the barrier. Split transitions always have a known state before the barrier;
+        // the begin and the end derive the same stage from it.
+        VkPipelineStageFlags previousStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        if ( barrier.StateBefore != RESOURCE_STATE_UNKNOWN ) {
+            previousStage = GetStageFlags( GetAccessMask( barrier.StateBefore ), psoStageFlags );
+        } else if ( barrier.ImageResource != nullptr ) {
+            previousStage = ( imageState.Stage != 0 ) ? imageState.Stage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+
+        // Split barrier events are owned by the device and indexed by the FrameGraph (the index is unique for a frame).
+        const bool isSplitBarrier = ( barrier.Type != BARRIER_TYPE_FULL );
+        VkEvent splitBarrierEvent = ( isSplitBarrier ) ? nativeCommandList->splitBarrierEvents[barrier.SplitBarrierIndex] : VK_NULL_HANDLE;
+
+        if ( barrier.Type == BARRIER_TYPE_SPLIT_BEGIN ) {
+            // The previous wait on this event (if any) has been recorded during an earlier frame; the event can be
+            // reset safely.
+            vkCmdResetEvent( nativeCommandList->cmdList, splitBarrierEvent, previousStage );
+            vkCmdSetEvent( nativeCommandList->cmdList, splitBarrierEvent, previousStage );
+            continue;
+        }
+
+        const bool isSplitEnd = ( barrier.Type == BARRIER_TYPE_SPLIT_END );
+        BarrierBatch& batch = ( isSplitEnd ) ? splitBatch : fullBatch;
+
+        const VkPipelineStageFlags srcStage = previousStage;
+
+        const VkAccessFlags dstAccess = GetAccessMask( barrier.StateAfter );
+        const VkPipelineStageFlags barrierDstStage = GetStageFlags( dstAccess, psoStageFlags );
+
+        if ( barrier.ImageResource != nullptr ) {
+            Image& image = *barrier.ImageResource;
+
+            const eResourceState previousState = ( barrier.StateBefore != RESOURCE_STATE_UNKNOWN ) ? barrier.StateBefore : imageState.State;
+            const VkImageLayout oldLayout = GetLayout( previousState );
+            const VkImageLayout newLayout = GetLayout( barrier.StateAfter );
+
+            if ( oldLayout == newLayout && barrier.StateAfter != RESOURCE_STATE_UAV ) {
+                continue;
+            }
+
+            VkImageMemoryBarrier& imgBarrier = batch.ImageBarriers[batch.ImageBarrierCount++];
+            imgBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            imgBarrier.pNext = VK_NULL_HANDLE;
+            imgBarrier.srcAccessMask = GetAccessMask( previousState );
+            imgBarrier.dstAccessMask = dstAccess;
+            imgBarrier.oldLayout = oldLayout;
+            imgBarrier.newLayout = newLayout;
+            imgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imgBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imgBarrier.image = image.resource[resourceFrameIndex];
+            imgBarrier.subresourceRange.aspectMask = image.aspectFlag;
+            imgBarrier.subresourceRange.baseMipLevel = 0;
+            imgBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            imgBarrier.subresourceRange.baseArrayLayer = 0;
+            imgBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+            SetImageState( *nativeCommandList, image, barrier.StateAfter, newLayout, barrierDstStage );
+        } else {
+            // Buffer states are not tracked by the backend; assume any previous write if the state is unknown.
+            const VkAccessFlags srcAccess = ( barrier.StateBefore != RESOURCE_STATE_UNKNOWN ) ? GetAccessMask( barrier.StateBefore ) : VK_ACCESS_MEMORY_WRITE_BIT;
+
+            VkBufferMemoryBarrier& bufBarrier = batch.BufferBarriers[batch.BufferBarrierCount++];
+            bufBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufBarrier.pNext = VK_NULL_HANDLE;
+            bufBarrier.srcAccessMask = srcAccess;
+            bufBarrier.dstAccessMask = dstAccess;
+            bufBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufBarrier.buffer = barrier.BufferResource->resource[resourceFrameIndex];
+            bufBarrier.offset = 0;
+            bufBarrier.size = VK_WHOLE_SIZE;
+        }
+
+        if ( isSplitEnd ) {
+            batch.Events[batch.EventCount++] = splitBarrierEvent;
+        }
+
+        batch.SrcStage |= srcStage;
+        batch.DstStage |= barrierDstStage;
+
+        if ( batch.ImageBarrierCount == MAX_BARRIER_PER_CALL || batch.BufferBarrierCount == MAX_BARRIER_PER_CALL ) {
+            flushBatch( batch );
+        }
+    }
+
+    flushBatch( splitBatch );
+    flushBatch( fullBatch );
 }
 
 void CommandList::insertComputeBarrier( Image& image )
@@ -595,6 +807,18 @@ void CommandList::setupFramebuffer( FramebufferAttachment* renderTargetViews, Fr
     const FramebufferLayoutDesc& fboLayout = pipelineState->fboLayout;
 
     u32 attachmentCount = fboLayout.getAttachmentCount();
+
+    // Beginning the render pass clears the attachments flagged by the layout; the setup can only be skipped if the
+    // render pass is still active and nothing has to be cleared.
+    bool hasSideEffects = !nativeCommandList->isInRenderPass
+                       || fboLayout.depthStencilAttachment.targetState == FramebufferLayoutDesc::InitialState::CLEAR;
+    for ( u32 i = 0; i < attachmentCount; i++ ) {
+        hasSideEffects |= ( fboLayout.Attachments[i].targetState == FramebufferLayoutDesc::InitialState::CLEAR );
+    }
+
+    if ( !shouldSetupFramebuffer( renderTargetViews, attachmentCount, depthStencilView, hasSideEffects ) ) {
+        return;
+    }
     for ( u32 i = 0; i < attachmentCount; i++ ) {
         const FramebufferLayoutDesc::AttachmentDesc& attachment = fboLayout.Attachments[i];
 
@@ -37,4 +37,12 @@ struct Image
         resourceUsage = eResourceUsage::RESOURCE_USAGE_STATIC;
     }
 };
+
+struct NativeCommandList;
+
+// Return the layout of 'image' when bound to a descriptor of type 'descriptorType' by the CommandList.
+VkImageLayout GetBindingLayout( const NativeCommandList& nativeCommandList, const Image& image, const VkDescriptorType descriptorType, const i32 resourceFrameIndex );
+
+// Commit the image states changed by a CommandList (must be called on submission, in submission order).
+void CommitImageStates( NativeCommandList& nativeCommandList, const i32 resourceFrameIndex );
 #endif
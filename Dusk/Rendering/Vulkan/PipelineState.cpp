@@ -938,6 +938,10 @@ PipelineState* RenderDevice::createPipelineState( const PipelineStateDesc& descr
 
 void CommandList::prepareAndBindResourceList()
 {
+    if ( !shouldPrepareAndBindResourceList() ) {
+        return;
+    }
+
     NativeCommandList* nativeCommandList = getNativeCommandList();
     PipelineState* pipelineState = nativeCommandList->BindedPipelineState;
 
@@ -1028,6 +1032,7 @@ void CommandList::begin()
     vkBeginCommandBuffer( nativeCommandList->cmdList, &cmdBufferInfos );
 
     nativeCommandList->isInRenderPass = false;
+    nativeCommandList->imageStateUpdateCount = 0u;
     nativeCommandList->waitForSwapchainRetrival = false;
     nativeCommandList->waitForPreviousCmdList = false;
 
@@ -1036,6 +1041,8 @@ void CommandList::begin()
     nativeCommandList->imageInfosCount = 0;
     nativeCommandList->writeDescriptorSetsCount = 0;
     nativeCommandList->bufferInfosCount = 0;
+
+    resetBindingCache();
 }
 
 void CommandList::bindPipelineState( PipelineState* pipelineState )
@@ -1043,6 +1050,9 @@ void CommandList::bindPipelineState( PipelineState* pipelineState )
     // NOTE Do not bind the PSO nor the DescriptorSet yet, since we need to do the binding/update of the sets
     nativeCommandList->BindedPipelineState = pipelineState;
 
+    // Descriptor sets are allocated on PSO bind and cannot be updated once bound (the bind is never filtered).
+    trackPipelineStateBind( pipelineState );
+
     if ( pipelineState == nullptr ) {
         return;
     }
@@ -1060,6 +1070,10 @@ void CommandList::bindPipelineState( PipelineState* pipelineState )
 
 void CommandList::bindConstantBuffer( const dkStringHash_t hashcode, Buffer* buffer )
 {
+    if ( !shouldBindResource( hashcode, buffer ) ) {
+        return;
+    }
+
     std::unordered_map<dkStringHash_t, PipelineState::ResourceBinding>& bindingSet = nativeCommandList->BindedPipelineState->bindingSet;
 
     auto it = bindingSet.find( hashcode );
@@ -1085,6 +1099,10 @@ void CommandList::bindConstantBuffer( const dkStringHash_t hashcode, Buffer* buf
 
 void CommandList::bindImage( const dkStringHash_t hashcode, Image* image, const ImageViewDesc viewDescription )
 {
+    if ( !shouldBindResource( hashcode, image, viewDescription.SortKey ) ) {
+        return;
+    }
+
     std::unordered_map<dkStringHash_t, PipelineState::ResourceBinding>& bindingSet = nativeCommandList->BindedPipelineState->bindingSet;
 
     auto it = bindingSet.find( hashcode );
@@ -1110,7 +1128,7 @@ void CommandList::bindImage( const dkStringHash_t hashcode, Image* image, const
 
     VkDescriptorImageInfo& imageInfos = nativeCommandList->imageInfos[nativeCommandList->imageInfosCount++];
     imageInfos.imageView = image->renderTargetView[viewFormat][resourceFrameIndex];
-    imageInfos.imageLayout = image->currentLayout[resourceFrameIndex];
+    imageInfos.imageLayout = GetBindingLayout( *nativeCommandList, *image, binding.type, resourceFrameIndex );
     imageInfos.sampler = nativeCommandList->BindedPipelineState->immutableSamplers[0];
 
     VkWriteDescriptorSet& writeDescriptor = nativeCommandList->writeDescriptorSets[nativeCommandList->writeDescriptorSetsCount++];
@@ -1126,6 +1144,10 @@ void CommandList::bindImage( const dkStringHash_t hashcode, Image* image, const
 
 void CommandList::bindBuffer( const dkStringHash_t hashcode, Buffer* buffer,  const eViewFormat viewFormat )
 {
+    if ( !shouldBindResource( hashcode, buffer, static_cast<u64>( viewFormat ) ) ) {
+        return;
+    }
+
     std::unordered_map<dkStringHash_t, PipelineState::ResourceBinding>& bindingSet = nativeCommandList->BindedPipelineState->bindingSet;
 
     auto it = bindingSet.find( hashcode );
@@ -1151,6 +1173,6 @@ void CommandList::bindBuffer( const dkStringHash_t hashcode, Buffer* buffer,  co
 
 void CommandList::bindSampler( const dkStringHash_t hashcode, Sampler* sampler )
 {
-
+    shouldBindResource( hashcode, sampler );
 }
 #endif
@@ -173,6 +173,12 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL VkDebugCallback( VkDebugUtilsMessageSeveri
 
 RenderDevice::~RenderDevice()
 {
+    for ( i32 i = 0; i < PENDING_FRAME_COUNT; i++ ) {
+        for ( u32 j = 0; j < MAX_SPLIT_BARRIER_COUNT; j++ ) {
+            vkDestroyEvent( renderContext->device, renderContext->splitBarrierEvents[i][j], nullptr );
+        }
+    }
+
     dk::core::free( memoryAllocator, pipelineStateCacheAllocator );
     dk::core::free( memoryAllocator, renderContext );
 }
@@ -420,11 +426,18 @@ void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefr
         VK_EXT_DEBUG_MARKER_EXTENSION_NAME,
     };
 
+    VkPhysicalDeviceFeatures supportedFeatures = {};
+    vkGetPhysicalDeviceFeatures( physicalDevice, &supportedFeatures );
+
     VkPhysicalDeviceFeatures deviceFeatures = {};
     deviceFeatures.imageCubeArray = VK_TRUE;
     deviceFeatures.shaderStorageImageExtendedFormats = VK_TRUE;
     deviceFeatures.fillModeNonSolid = VK_TRUE;
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+
+    renderContext->isMultiDrawIndirectSupported = ( supportedFeatures.multiDrawIndirect == VK_TRUE );
+    DUSK_LOG_INFO( "Multi draw indirect: %s\n", ( renderContext->isMultiDrawIndirectSupported ) ? "supported" : "not supported" );
 
     VkDeviceCreateInfo deviceCreationInfos;
     deviceCreationInfos.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -648,6 +661,7 @@ void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefr
 
             nativeCmdList->device = renderContext->device;
             nativeCmdList->cmdQueueIdx = renderContext->graphicsQueueIndex;
+            nativeCmdList->isMultiDrawIndirectSupported = renderContext->isMultiDrawIndirectSupported;
 
 #if DUSK_ENABLE_GPU_DEBUG_MARKER
             nativeCmdList->vkCmdDebugMarkerBegin = vkCmdDebugMarkerBeginEXT;
@@ -689,6 +703,7 @@ void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefr
 
             nativeCmdList->device = renderContext->device;
             nativeCmdList->cmdQueueIdx = renderContext->computeQueueIndex;
+            nativeCmdList->isMultiDrawIndirectSupported = renderContext->isMultiDrawIndirectSupported;
 
 #if DUSK_ENABLE_GPU_DEBUG_MARKER
             nativeCmdList->vkCmdDebugMarkerBegin = vkCmdDebugMarkerBeginEXT;
@@ -737,6 +752,18 @@ void RenderDevice::create( DisplaySurface& displaySurface, const u32 desiredRefr
         renderContext->frameSemaphoresCount[i] = 1;
     }
 
+    VkEventCreateInfo eventCreateInfo;
+    eventCreateInfo.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    eventCreateInfo.pNext = nullptr;
+    eventCreateInfo.flags = 0u;
+
+    for ( i32 i = 0; i < PENDING_FRAME_COUNT; i++ ) {
+        for ( u32 j = 0; j < MAX_SPLIT_BARRIER_COUNT; j++ ) {
+            VkResult eventCreationResult = vkCreateEvent( renderContext->device, &eventCreateInfo, nullptr, &renderContext->splitBarrierEvents[i][j] );
+            DUSK_ASSERT( ( eventCreationResult == VK_SUCCESS ), "Failed to create split barrier event! (error code: %i)", eventCreationResult )
+        }
+    }
+
     u32 nextImageIdx = 0;
     VkResult opResult = vkAcquireNextImageKHR( renderContext->device, renderContext->swapChain, std::numeric_limits<uint64_t>::max(), renderContext->frameSemaphores[0][0], VK_NULL_HANDLE, &nextImageIdx );
     DUSK_RAISE_FATAL_ERROR( opResult == VkResult::VK_SUCCESS, "Failed to acquire next image! (error code: 0x%x)", opResult );
@@ -751,15 +778,11 @@ CommandList& RenderDevice::allocateGraphicsCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( graphicsCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        graphicsCmdListAllocator[bufferIdx]->clear();
-    }
-
-    CommandList* cmdList = static_cast< CommandList* >( graphicsCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ), alignof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( graphicsCmdListAllocator[bufferIdx], graphicsCmdListPoolFrameIndex[bufferIdx] );
     NativeCommandList* nativeCmdList = cmdList->getNativeCommandList();
 
     nativeCmdList->descriptorPool = renderContext->descriptorPool[bufferIdx];
+    nativeCmdList->splitBarrierEvents = renderContext->splitBarrierEvents[bufferIdx];
 
     cmdList->setFrameIndex( static_cast< i32 >( frameIndex ) );
 
@@ -770,15 +793,11 @@ CommandList& RenderDevice::allocateComputeCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( computeCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        computeCmdListAllocator[bufferIdx]->clear();
-    }
-
-    CommandList* cmdList = static_cast< CommandList* >( computeCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ), alignof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( computeCmdListAllocator[bufferIdx], computeCmdListPoolFrameIndex[bufferIdx] );
     NativeCommandList* nativeCmdList = cmdList->getNativeCommandList();
 
     nativeCmdList->descriptorPool = renderContext->descriptorPool[bufferIdx];
+    nativeCmdList->splitBarrierEvents = renderContext->splitBarrierEvents[bufferIdx];
 
     cmdList->setFrameIndex( static_cast< i32 >( frameIndex ) );
 
@@ -789,15 +808,11 @@ CommandList& RenderDevice::allocateCopyCommandList()
 {
     const size_t bufferIdx = frameIndex % PENDING_FRAME_COUNT;
 
-    // Reset the allocator (go back to the start of the allocator memory space)
-    if ( graphicsCmdListAllocator[bufferIdx]->getAllocationCount() == CMD_LIST_POOL_CAPACITY ) {
-        graphicsCmdListAllocator[bufferIdx]->clear();
-    }
-
-    CommandList* cmdList = static_cast< CommandList* >( graphicsCmdListAllocator[bufferIdx]->allocate( sizeof( CommandList ), alignof( CommandList ) ) );
+    CommandList* cmdList = allocatePooledCommandList( graphicsCmdListAllocator[bufferIdx], graphicsCmdListPoolFrameIndex[bufferIdx] );
     NativeCommandList* nativeCmdList = cmdList->getNativeCommandList();
 
     nativeCmdList->descriptorPool = renderContext->descriptorPool[bufferIdx];
+    nativeCmdList->splitBarrierEvents = renderContext->splitBarrierEvents[bufferIdx];
 
     cmdList->setFrameIndex( static_cast< i32 >( frameIndex ) );
 
@@ -806,7 +821,38 @@ CommandList& RenderDevice::allocateCopyCommandList()
 
 void RenderDevice::submitCommandLists( CommandList** cmdList, const u32 cmdListCount )
 {
+    for ( u32 i = 0; i < cmdListCount; i++ ) {
+        CommitImageStates( *cmdList[i]->getNativeCommandList(), static_cast< i32 >( frameIndex % PENDING_FRAME_COUNT ) );
+    }
+}
+
+bool RenderDevice::hasAsyncComputeQueue() const
+{
+    // TODO Cross-queue waits require timeline semaphores (and queue family ownership transfers); until then the
+    // FrameGraph records compute passes to graphics CommandLists.
+    return false;
+}
+
+bool RenderDevice::hasMultiDrawIndirect() const
+{
+    return renderContext->isMultiDrawIndirectSupported;
+}
+
+bool RenderDevice::hasPartialBufferUpdate() const
+{
+    return true;
+}
 
+u64 RenderDevice::signalQueue( const eCommandQueue queue )
+{
+    return ++renderContext->queueSignalValues[queue];
+}
+
+void RenderDevice::waitQueue( const eCommandQueue queue, const eCommandQueue waitedQueue, const u64 signalValue )
+{
+    DUSK_UNUSED_VARIABLE( queue );
+    DUSK_UNUSED_VARIABLE( waitedQueue );
+    DUSK_UNUSED_VARIABLE( signalValue );
 }
 
 void RenderDevice::submitCommandList( CommandList& cmdList )
@@ -815,6 +861,7 @@ void RenderDevice::submitCommandList( CommandList& cmdList )
     NativeCommandList* nativeCmdList = cmdList.getNativeCommandList();
 
     vkEndCommandBuffer( nativeCmdList->cmdList );
+    CommitImageStates( *nativeCmdList, static_cast< i32 >( bufferIdx ) );
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -38,6 +38,9 @@ struct RenderContext
     u32                                 computeQueueIndex;
     u32                                 presentQueueIndex;
 
+    // Last value signaled per queue (compute CommandLists are not overlapped with graphics yet).
+    u64                                 queueSignalValues[eCommandQueue::COMMAND_QUEUE_COUNT];
+
     VkExtent2D                          swapChainExtent;
     VkFormat                            swapChainFormat;
 
@@ -51,9 +54,15 @@ struct RenderContext
     VkCommandPool                       graphicsCommandPool[RenderDevice::PENDING_FRAME_COUNT];
     VkCommandPool                       computeCommandPool[RenderDevice::PENDING_FRAME_COUNT];
 
+    // Events used by the split barriers (indexed by ResourceBarrier::SplitBarrierIndex).
+    VkEvent                             splitBarrierEvents[RenderDevice::PENDING_FRAME_COUNT][MAX_SPLIT_BARRIER_COUNT];
+
     VkSemaphore frameSemaphores[RenderDevice::PENDING_FRAME_COUNT][33];
     u32 frameSemaphoresCount[RenderDevice::PENDING_FRAME_COUNT];
 
     bool                            waitForSwapchain;
+
+    // True if the physical device supports (and the logical device enables) drawCount > 1 for indirect draws.
+    bool                            isMultiDrawIndirectSupported;
 };
 #endif
@@ -0,0 +1,274 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "AreaStreamingBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/JobSystem.h"
+#include "Core/Timer.h"
+
+#include "Framework/AreaStreaming.h"
+#include "Framework/EntityDatabase.h"
+
+#include "Graphics/Model.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+DUSK_ENV_VAR( BenchmarkStreamingFrameCount, 600, u32 ); // "Number of frames (anchors moving through the world) simulated by the area streaming microbenchmark"
+DUSK_ENV_VAR( BenchmarkStreamingEntityPerArea, 256, u32 ); // "Maximum number of entities of a synthetic area of the area streaming microbenchmark"
+DUSK_ENV_VAR( BenchmarkStreamingAnchorSpeed, 4.0f, f32 ); // "Distance (in world units) travelled per frame by the anchors of the area streaming microbenchmark"
+DUSK_ENV_VAR( BenchmarkStreamingBudget, 1.0f, f32 ); // "Activation budget (in milliseconds) of the area streaming microbenchmark"
+DUSK_ENV_VAR( BenchmarkStreamingFrameTime, 2.0f, f32 ); // "Duration (in milliseconds) of a frame simulated by the area streaming microbenchmark (the read jobs run meanwhile)"
+
+// Synthetic world streamed by the area streaming microbenchmark.
+struct SyntheticStreamingWorld
+{
+    // Database allocating the entities spawned by the streaming.
+    EntityDatabase*     Entities;
+
+    // Number of areas read (written by the read jobs).
+    std::atomic<u32>    AreaReadCount;
+
+    // Number of spawns with invalid arguments and releases of dead entities.
+    u32                 InvalidOperationCount;
+};
+
+// Return the number of entities of a synthetic area (0 if the area does not exist).
+static u32 GetSyntheticAreaEntityCount( const Area& area )
+{
+    u32 hash = ( static_cast< u32 >( area.GridX ) * 73856093u ) ^ ( static_cast< u32 >( area.GridZ ) * 19349663u );
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995u;
+    hash ^= hash >> 15;
+
+    // One area out of eight does not exist (e.g. sea).
+    if ( ( hash & 7u ) == 0u ) {
+        return 0u;
+    }
+
+    return 1u + ( hash >> 3 ) % Max( BenchmarkStreamingEntityPerArea, 1u );
+}
+
+static bool ReadSyntheticArea( void* userData, const Area& area, AreaDataBuffer& areaData )
+{
+    static const char* ASSET_PATHS[4] = {
+        "GameData/geometry/tree.mesh",
+        "GameData/geometry/rock.mesh",
+        "GameData/geometry/house.mesh",
+        "GameData/geometry/fence.mesh",
+    };
+
+    SyntheticStreamingWorld* world = static_cast< SyntheticStreamingWorld* >( userData );
+    world->AreaReadCount++;
+
+    const u32 entityCount = GetSyntheticAreaEntityCount( area );
+    if ( entityCount == 0u ) {
+        return false;
+    }
+
+    std::vector<AreaEntity> entities( entityCount );
+    std::vector<std::string> names( entityCount );
+    std::vector<const char*> namePointers( entityCount );
+
+    const dkVec3f areaOrigin = area.getAreaWorldOrigin();
+    u32 seed = static_cast< u32 >( area.GridX * 7919 + area.GridZ );
+    for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+        AreaEntity& entity = entities[entityIdx];
+        entity.Position = areaOrigin + dkVec3f( NextRandomFloat( seed ) * Area::DIMENSION, 0.0f, NextRandomFloat( seed ) * Area::DIMENSION );
+        entity.Rotation = dkQuatf::Identity;
+        entity.Scale = dkVec3f( 1.0f, 1.0f, 1.0f );
+        entity.ModelAssetIndex = ( entityIdx % 5u == 4u ) ? AreaEntity::INVALID_ASSET_INDEX : ( entityIdx % 5u );
+
+        names[entityIdx] = "Area " + std::to_string( area.GridX ) + "_" + std::to_string( area.GridZ ) + " #" + std::to_string( entityIdx );
+        namePointers[entityIdx] = names[entityIdx].c_str();
+    }
+
+    const size_t areaDataSize = AreaStreaming::SerializeArea( ASSET_PATHS, 4u, entities.data(), namePointers.data(), entityCount );
+    u8* data = areaData.allocate( areaDataSize );
+    if ( data == nullptr ) {
+        return false;
+    }
+
+    AreaStreaming::SerializeArea( ASSET_PATHS, 4u, entities.data(), namePointers.data(), entityCount, data );
+
+    return true;
+}
+
+static Entity SpawnSyntheticEntity( void* userData, const AreaEntity& areaEntity, const char* name, Model* model )
+{
+    SyntheticStreamingWorld* world = static_cast< SyntheticStreamingWorld* >( userData );
+
+    // No model resolver is provided: every entity must be spawned without model.
+    if ( model != nullptr || strncmp( name, "Area ", 5 ) != 0 ) {
+        world->InvalidOperationCount++;
+    }
+
+    return world->Entities->allocateEntity();
+}
+
+static void ReleaseSyntheticEntity( void* userData, Entity& entity )
+{
+    SyntheticStreamingWorld* world = static_cast< SyntheticStreamingWorld* >( userData );
+    if ( !world->Entities->isEntityAlive( entity ) ) {
+        world->InvalidOperationCount++;
+        return;
+    }
+
+    world->Entities->releaseEntity( entity );
+}
+
+void RunStreamingMicrobenchmark( BenchmarkStreamingStats& streamingStats )
+{
+    const u32 frameCount = Max( BenchmarkStreamingFrameCount, 1u );
+    const u32 entityPerArea = Max( BenchmarkStreamingEntityPerArea, 1u );
+
+    // Maximum number of updates executed once the anchors have stopped (waiting for the areas to be streamed in).
+    constexpr u32 MAX_SETTLE_UPDATE_COUNT = 100000u;
+
+    // Radius (in world units) of the circle followed by the second anchor (e.g. a vehicle).
+    constexpr f32 VEHICLE_PATH_RADIUS = 384.0f;
+
+    DUSK_LOG_INFO( "Running area streaming microbenchmark (%u frame(s); up to %u entities per area)...\n", frameCount, entityPerArea );
+
+    SyntheticStreamingWorld world;
+    world.Entities = dk::core::allocate<EntityDatabase>( g_GlobalAllocator, g_GlobalAllocator );
+    world.Entities->create( AreaStreaming::MAX_RESIDENT_AREA_COUNT * entityPerArea + EntityDatabase::MIN_FREE_INDEX_COUNT );
+    world.AreaReadCount = 0u;
+    world.InvalidOperationCount = 0u;
+
+    // Worst case: every resident area is as large as possible (entities, names and spawned entities; twice as much
+    // memory to absorb the fragmentation).
+    constexpr size_t MAX_AREA_ENTITY_SIZE = sizeof( AreaEntity ) + sizeof( Entity ) + 32;
+
+    AreaStreamingSettings settings;
+    settings.ActivationBudget = static_cast< f64 >( BenchmarkStreamingBudget );
+    settings.MemorySize = 2 * AreaStreaming::MAX_RESIDENT_AREA_COUNT * ( entityPerArea * MAX_AREA_ENTITY_SIZE + 4096 );
+    settings.ReadArea = &ReadSyntheticArea;
+    settings.UserData = &world;
+
+    AreaStreaming* areaStreaming = dk::core::allocate<AreaStreaming>( g_GlobalAllocator, g_GlobalAllocator, g_JobSystem );
+    areaStreaming->create( settings );
+
+    // The first anchor (e.g. a camera) goes straight; the second one (e.g. a vehicle) drives in circles.
+    dkVec3f anchors[2];
+    auto updateAnchors = [&]( const u32 frameIdx ) {
+        const f32 distance = static_cast< f32 >( frameIdx ) * BenchmarkStreamingAnchorSpeed;
+        const f32 angle = distance / VEHICLE_PATH_RADIUS;
+
+        anchors[0] = dkVec3f( distance, 0.0f, 0.0f );
+        anchors[1] = dkVec3f( cosf( angle ) * VEHICLE_PATH_RADIUS, 0.0f, sinf( angle ) * VEHICLE_PATH_RADIUS );
+    };
+
+    streamingStats.PeakResidentAreaCount = 0u;
+    streamingStats.PeakEntityCount = 0u;
+    streamingStats.MaxUpdateTime = 0.0;
+    streamingStats.SettleUpdateCount = 0u;
+    streamingStats.MismatchCount = 0u;
+
+    f64 updateTimeSum = 0.0;
+
+    Timer updateTimer;
+    Timer frameTimer;
+    for ( u32 frameIdx = 0u; frameIdx < frameCount; frameIdx++ ) {
+        frameTimer.reset();
+
+        updateAnchors( frameIdx );
+        areaStreaming->setAnchor( 0u, anchors[0] );
+        areaStreaming->setAnchor( 1u, anchors[1] );
+
+        updateTimer.reset();
+        areaStreaming->update( &SpawnSyntheticEntity, &ReleaseSyntheticEntity, &world );
+        const f64 updateTime = updateTimer.getElapsedTimeAsMiliseconds();
+
+        updateTimeSum += updateTime;
+        streamingStats.MaxUpdateTime = Max( streamingStats.MaxUpdateTime, updateTime );
+        streamingStats.PeakResidentAreaCount = Max( streamingStats.PeakResidentAreaCount, areaStreaming->getResidentAreaCount() );
+        streamingStats.PeakEntityCount = Max( streamingStats.PeakEntityCount, world.Entities->getAliveEntityCount() );
+
+        // Simulate the rest of the frame.
+        while ( frameTimer.getElapsedTimeAsMiliseconds() < static_cast< f64 >( BenchmarkStreamingFrameTime ) ) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Stop the anchors (they stay where they are) and wait for the areas around them.
+    do {
+        areaStreaming->update( &SpawnSyntheticEntity, &ReleaseSyntheticEntity, &world );
+
+        streamingStats.SettleUpdateCount++;
+        std::this_thread::yield();
+    } while ( ( areaStreaming->getPendingLoadCount() != 0u || areaStreaming->getTransitionAreaCount() != 0u )
+           && streamingStats.SettleUpdateCount < MAX_SETTLE_UPDATE_COUNT );
+
+    // Correctness: every area within the load radius must be active; areas beyond the unload radius must be released.
+    const f32 unloadRadius = settings.LoadRadius + settings.UnloadHysteresis;
+    const i32 minGridX = static_cast< i32 >( floorf( ( Min( anchors[0].x, anchors[1].x ) - unloadRadius ) / Area::DIMENSION ) );
+    const i32 maxGridX = static_cast< i32 >( floorf( ( Max( anchors[0].x, anchors[1].x ) + unloadRadius ) / Area::DIMENSION ) );
+    const i32 minGridZ = static_cast< i32 >( floorf( ( Min( anchors[0].z, anchors[1].z ) - unloadRadius ) / Area::DIMENSION ) );
+    const i32 maxGridZ = static_cast< i32 >( floorf( ( Max( anchors[0].z, anchors[1].z ) + unloadRadius ) / Area::DIMENSION ) );
+
+    u32 minExpectedEntityCount = 0u;
+    u32 maxExpectedEntityCount = 0u;
+    for ( i32 gridZ = minGridZ; gridZ <= maxGridZ; gridZ++ ) {
+        for ( i32 gridX = minGridX; gridX <= maxGridX; gridX++ ) {
+            const Area area = { gridX, gridZ };
+            const dkVec3f areaOrigin = area.getAreaWorldOrigin();
+
+            f32 anchorDistance = std::numeric_limits<f32>::max();
+            for ( const dkVec3f& anchor : anchors ) {
+                const f32 distanceX = Max( Max( areaOrigin.x - anchor.x, anchor.x - ( areaOrigin.x + Area::DIMENSION ) ), 0.0f );
+                const f32 distanceZ = Max( Max( areaOrigin.z - anchor.z, anchor.z - ( areaOrigin.z + Area::DIMENSION ) ), 0.0f );
+                anchorDistance = Min( anchorDistance, sqrtf( distanceX * distanceX + distanceZ * distanceZ ) );
+            }
+
+            const u32 entityCount = GetSyntheticAreaEntityCount( area );
+            minExpectedEntityCount += ( anchorDistance <= settings.LoadRadius ) ? entityCount : 0u;
+            maxExpectedEntityCount += ( anchorDistance <= unloadRadius ) ? entityCount : 0u;
+        }
+    }
+
+    const u32 aliveEntityCount = world.Entities->getAliveEntityCount();
+    if ( aliveEntityCount < minExpectedEntityCount ) {
+        streamingStats.MismatchCount += minExpectedEntityCount - aliveEntityCount;
+    } else if ( aliveEntityCount > maxExpectedEntityCount ) {
+        streamingStats.MismatchCount += aliveEntityCount - maxExpectedEntityCount;
+    }
+
+    // Every entity must be released once everything is unloaded.
+    areaStreaming->unloadAll( &ReleaseSyntheticEntity, &world );
+    streamingStats.MismatchCount += world.Entities->getAliveEntityCount() + world.InvalidOperationCount;
+
+    streamingStats.AreaReadCount = world.AreaReadCount.load();
+    streamingStats.UpdateTime = updateTimeSum / static_cast< f64 >( frameCount );
+
+    if ( streamingStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Area streaming mismatch (%u missing, unexpected or invalid entit(ies))!\n", streamingStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Area streaming: %u area(s) read; peak %u resident area(s) and %u entities; update %f ms (max %f ms); settled in %u update(s)\n",
+                   streamingStats.AreaReadCount, streamingStats.PeakResidentAreaCount, streamingStats.PeakEntityCount, streamingStats.UpdateTime, streamingStats.MaxUpdateTime, streamingStats.SettleUpdateCount );
+
+    dk::core::free( g_GlobalAllocator, areaStreaming );
+    dk::core::free( g_GlobalAllocator, world.Entities );
+}
+
+void WriteStreamingReport( std::stringstream& report, const BenchmarkStreamingStats& streamingStats )
+{
+    report << "  \"areaStreaming\": {\n";
+    report << "    \"activationBudgetMs\": " << BenchmarkStreamingBudget << ",\n";
+    report << "    \"areaReadCount\": " << streamingStats.AreaReadCount << ",\n";
+    report << "    \"peakResidentAreaCount\": " << streamingStats.PeakResidentAreaCount << ",\n";
+    report << "    \"peakEntityCount\": " << streamingStats.PeakEntityCount << ",\n";
+    report << "    \"updateMs\": " << streamingStats.UpdateTime << ",\n";
+    report << "    \"maxUpdateMs\": " << streamingStats.MaxUpdateTime << ",\n";
+    report << "    \"settleUpdateCount\": " << streamingStats.SettleUpdateCount << ",\n";
+    report << "    \"mismatchCount\": " << streamingStats.MismatchCount << "\n";
+    report << "  },\n";
+}
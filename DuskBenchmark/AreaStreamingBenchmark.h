@@ -0,0 +1,35 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkStreamingStats
+{
+    // Number of areas read by the read jobs.
+    u32                     AreaReadCount;
+
+    // Maximum number of areas resident at once.
+    u32                     PeakResidentAreaCount;
+
+    // Maximum number of entities alive at once.
+    u32                     PeakEntityCount;
+
+    // Average and maximum time of a streaming update (in milliseconds).
+    f64                     UpdateTime;
+    f64                     MaxUpdateTime;
+
+    // Number of updates required to stream the areas around the final anchors in.
+    u32                     SettleUpdateCount;
+
+    // Number of missing (or unexpected) entities once settled plus the number of invalid spawns/releases.
+    u32                     MismatchCount;
+};
+
+// Run the area streaming microbenchmark (the spawned entities are checked against the areas surrounding the anchors).
+void RunStreamingMicrobenchmark( BenchmarkStreamingStats& streamingStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'areaStreaming').
+void WriteStreamingReport( std::stringstream& report, const BenchmarkStreamingStats& streamingStats );
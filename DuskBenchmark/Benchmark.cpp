@@ -0,0 +1,684 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "Benchmark.h"
+#include "BenchmarkShared.h"
+
+#include "FrustumCullingBenchmark.h"
+#include "DrawSortBenchmark.h"
+#include "OcclusionBenchmark.h"
+#include "LodBenchmark.h"
+#include "TransformBenchmark.h"
+#include "ComponentStorageBenchmark.h"
+#include "EntityBenchmark.h"
+#include "SpatialGridBenchmark.h"
+#include "AreaStreamingBenchmark.h"
+#include "TransientAliasingBenchmark.h"
+
+#include "Core/CommandLineArgs.h"
+#include "Core/JobSystem.h"
+#include "Core/Timer.h"
+#include "Core/StringHelpers.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+
+
+#include "FileSystem/VirtualFileSystem.h"
+#include "FileSystem/FileSystemNative.h"
+
+#include "Framework/World.h"
+#include "Framework/Transform.h"
+#include "Framework/StaticGeometry.h"
+#include "Framework/PointLight.h"
+#include "Framework/Cameras/FreeCamera.h"
+
+#include "Graphics/ShaderCache.h"
+#include "Graphics/GraphicsAssetCache.h"
+#include "Graphics/WorldRenderer.h"
+#include "Graphics/RenderWorld.h"
+#include "Graphics/DrawCommandBuilder.h"
+#include "Graphics/Model.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/RenderModules/PresentRenderPass.h"
+
+#include "Rendering/RenderDevice.h"
+
+#include "Maths/Helpers.h"
+#include "Maths/AABB.h"
+
+#include <atomic>
+#include <new>
+#include <sstream>
+
+// Number of heap allocations (global operator new calls) since the process start.
+static std::atomic<u64> g_HeapAllocationCount( 0ull );
+
+// Size of the heap allocations (in bytes) since the process start.
+static std::atomic<u64> g_HeapAllocationSize( 0ull );
+
+void* operator new( std::size_t size )
+{
+    g_HeapAllocationCount.fetch_add( 1ull, std::memory_order_relaxed );
+    g_HeapAllocationSize.fetch_add( size, std::memory_order_relaxed );
+
+    void* allocation = std::malloc( size > 0 ? size : 1 );
+    if ( allocation == nullptr ) {
+        throw std::bad_alloc();
+    }
+
+    return allocation;
+}
+
+void* operator new[]( std::size_t size )
+{
+    return ::operator new( size );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete[]( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete[]( void* pointer, std::size_t ) noexcept
+{
+    std::free( pointer );
+}
+
+static char  g_BaseBuffer[128];
+static void* g_AllocatedTable;
+
+LinearAllocator* g_GlobalAllocator;
+RenderDevice* g_RenderDevice;
+JobSystem* g_JobSystem;
+static VirtualFileSystem* g_VirtualFileSystem;
+static FileSystemNative* g_DataFileSystem;
+static FileSystemNative* g_EdAssetsFileSystem;
+static FileSystemNative* g_RendererFileSystem;
+static FileSystemNative* g_OutputFileSystem;
+static ShaderCache* g_ShaderCache;
+static GraphicsAssetCache* g_GraphicsAssetCache;
+static WorldRenderer* g_WorldRenderer;
+static RenderWorld* g_RenderWorld;
+static DrawCommandBuilder* g_DrawCommandBuilder;
+static World* g_World;
+
+DUSK_ENV_VAR( ScreenSize, dkVec2u( 1280, 720 ), dkVec2u ); // "Defines the benchmark viewport size [0..N]"
+DUSK_ENV_VAR( JobWorkerCount, 0, u32 ); // "Number of JobSystem workers (0 to use one worker per hardware thread minus one)"
+DUSK_ENV_VAR( BenchmarkFrameCount, 300, u32 ); // "Number of frames to record"
+DUSK_ENV_VAR( BenchmarkWarmupFrameCount, 16, u32 ); // "Number of frames executed before the recording starts"
+DUSK_ENV_VAR( BenchmarkStaticInstanceCount, 2048, u32 ); // "Number of static geometry instances in the synthetic world"
+DUSK_ENV_VAR( BenchmarkInstancePerModel, 128, u32 ); // "Number of instances sharing the same model"
+DUSK_ENV_VAR( BenchmarkPointLightCount, 64, u32 ); // "Number of point lights in the synthetic world"
+DUSK_ENV_VAR( BenchmarkCameraCount, 1, u32 ); // "Number of cameras submitted to the DrawCommandBuilder (the first one is used to build the FrameGraph)"
+DUSK_ENV_VAR( BenchmarkWorldExtent, 512.0f, f32 ); // "Half extent (in world units) of the area populated by the synthetic world"
+
+// Size of the memory table used by the benchmark.
+static constexpr size_t GLOBAL_MEMORY_TABLE_SIZE = ( 1024 << 20 );
+
+// Name of the report written in the working directory.
+static constexpr const dkChar_t* BENCHMARK_REPORT_FILENAME = DUSK_STRING( "DuskBenchmark.json" );
+
+// Maximum number of camera used by the benchmark (should match DrawCommandBuilder::MAX_SIMULTANEOUS_VIEWPORT_COUNT).
+static constexpr u32 MAX_BENCHMARK_CAMERA_COUNT = 8u;
+
+struct BenchmarkFrameStats
+{
+    // Frame time (in milliseconds).
+    f64                     FrameTime;
+
+    // Heap allocations done during the frame.
+    u64                     HeapAllocationCount;
+
+    // Heap memory allocated during the frame (in bytes).
+    u64                     HeapAllocationSize;
+
+    // Allocations done by the global engine allocator during the frame.
+    u64                     EngineAllocationCount;
+
+    // Transient FrameGraph memory for this frame.
+    FGTransientMemoryStats  TransientMemory;
+
+    // True if the FrameGraph reused the compiled graph of the previous frame.
+    bool                    IsCompiledGraphReused;
+
+    // Simulated GPU queue timelines (graphics/async compute overlap).
+    QueueTimelineStats      QueueTimeline;
+
+    // Barriers recorded for this frame.
+    BarrierStats            Barriers;
+
+    // Rendering API calls recorded for this frame.
+    ApiCallStats            ApiCalls;
+};
+
+// Results of a benchmark run (see WriteReport).
+struct BenchmarkReport
+{
+    // Stats of the recorded frames (the warmup frames are excluded).
+    const BenchmarkFrameStats*  FrameStats;
+
+    // Number of recorded frames.
+    u32                         FrameCount;
+
+    // Number of models instantiated by the synthetic world.
+    u32                         ModelCount;
+
+    // Microbenchmarks stats.
+    BenchmarkCullingStats       Culling;
+    BenchmarkSortStats          Sort;
+    BenchmarkOcclusionStats     Occlusion;
+    BenchmarkLodStats           Lod;
+    BenchmarkTransformStats     Transform;
+    BenchmarkComponentStats     Component;
+    BenchmarkEntityStats        Entity;
+    BenchmarkSpatialStats       Spatial;
+    BenchmarkStreamingStats     Streaming;
+    BenchmarkAliasingStats      Aliasing;
+};
+
+// Return the number of mismatches (summed for every microbenchmark).
+static u32 GetMismatchCount( const BenchmarkReport& benchmarkReport )
+{
+    return benchmarkReport.Culling.MismatchCount
+         + benchmarkReport.Sort.MismatchCount
+         + benchmarkReport.Sort.TranslucentMismatchCount
+         + benchmarkReport.Occlusion.MismatchCount
+         + benchmarkReport.Lod.MismatchCount
+         + benchmarkReport.Transform.MismatchCount
+         + benchmarkReport.Component.MismatchCount
+         + benchmarkReport.Entity.MismatchCount
+         + benchmarkReport.Spatial.MismatchCount
+         + benchmarkReport.Streaming.MismatchCount
+         + benchmarkReport.Aliasing.MismatchCount;
+}
+
+static void InitializeSubsystems()
+{
+    DUSK_LOG_INFO( "Initializing I/O subsystems...\n" );
+
+    g_VirtualFileSystem = dk::core::allocate<VirtualFileSystem>( g_GlobalAllocator );
+
+    g_DataFileSystem = dk::core::allocate<FileSystemNative>( g_GlobalAllocator, DUSK_STRING( "./data/" ) );
+    g_VirtualFileSystem->mount( g_DataFileSystem, DUSK_STRING( "GameData" ), 1 );
+
+#if DUSK_DEVBUILD
+    g_EdAssetsFileSystem = dk::core::allocate<FileSystemNative>( g_GlobalAllocator, DUSK_STRING( "./../../Assets/" ) );
+    g_RendererFileSystem = dk::core::allocate<FileSystemNative>( g_GlobalAllocator, DUSK_STRING( "./../../Dusk/Graphics/" ) );
+
+    g_VirtualFileSystem->mount( g_EdAssetsFileSystem, DUSK_STRING( "EditorAssets" ), 0 );
+    g_VirtualFileSystem->mount( g_RendererFileSystem, DUSK_STRING( "EditorAssets" ), 1 );
+    g_VirtualFileSystem->mount( g_EdAssetsFileSystem, DUSK_STRING( "GameData" ), 1 );
+#endif
+
+    g_OutputFileSystem = dk::core::allocate<FileSystemNative>( g_GlobalAllocator, DUSK_STRING( "./" ) );
+    g_VirtualFileSystem->mount( g_OutputFileSystem, DUSK_STRING( "BenchmarkOutput" ), 0 );
+
+    DUSK_LOG_INFO( "Creating JobSystem...\n" );
+
+    g_JobSystem = dk::core::allocate<JobSystem>( g_GlobalAllocator, g_GlobalAllocator );
+    g_JobSystem->create( JobWorkerCount );
+
+    DUSK_LOG_INFO( "Creating RenderDevice (%s)...\n", RenderDevice::getBackendName() );
+
+    // The benchmark runs headless (no display surface; see DuskBenchmark/CMakeLists.txt).
+    g_RenderDevice = dk::core::allocate<RenderDevice>( g_GlobalAllocator, g_GlobalAllocator );
+    g_RenderDevice->create( false );
+
+    g_ShaderCache = dk::core::allocate<ShaderCache>( g_GlobalAllocator, g_GlobalAllocator, g_RenderDevice, g_VirtualFileSystem );
+    g_GraphicsAssetCache = dk::core::allocate<GraphicsAssetCache>( g_GlobalAllocator, g_GlobalAllocator, g_RenderDevice, g_ShaderCache, g_VirtualFileSystem );
+
+    g_WorldRenderer = dk::core::allocate<WorldRenderer>( g_GlobalAllocator, g_GlobalAllocator );
+    g_WorldRenderer->loadCachedResources( g_RenderDevice, g_ShaderCache, g_GraphicsAssetCache, g_VirtualFileSystem, g_JobSystem );
+
+    g_RenderWorld = dk::core::allocate<RenderWorld>( g_GlobalAllocator, g_GlobalAllocator );
+    g_RenderWorld->create( *g_RenderDevice );
+
+    g_DrawCommandBuilder = dk::core::allocate<DrawCommandBuilder>( g_GlobalAllocator, g_GlobalAllocator, g_JobSystem );
+
+    g_World = dk::core::allocate<World>( g_GlobalAllocator, g_GlobalAllocator, g_JobSystem );
+    g_World->create();
+}
+
+static void BuildSyntheticWorld( Model** models, const u32 modelCount )
+{
+    DUSK_LOG_INFO( "Building synthetic world (%u static instance(s); %u model(s); %u point light(s))...\n",
+                   BenchmarkStaticInstanceCount, modelCount, BenchmarkPointLightCount );
+
+    Material* defaultMaterial = g_GraphicsAssetCache->getDefaultMaterial();
+
+    // Each model has a single LOD made of a single mesh (without any GPU resource; the Stub backend does not need any).
+    for ( u32 modelIdx = 0u; modelIdx < modelCount; modelIdx++ ) {
+        dkString_t modelName = DUSK_STRING( "BenchmarkModel" ) + DUSK_TO_STRING( modelIdx );
+
+        Model* model = dk::core::allocate<Model>( g_GlobalAllocator, g_GlobalAllocator, modelName.c_str() );
+
+        Model::LevelOfDetail& lod = model->addLevelOfDetail( std::numeric_limits<f32>::max() );
+        lod.MeshArray = dk::core::allocateArray<Mesh>( g_GlobalAllocator, 1 );
+        lod.MeshCount = 1;
+        lod.MeshArray[0].RenderMaterial = defaultMaterial;
+        lod.MeshArray[0].IndiceCount = 36;
+        lod.MeshArray[0].VertexCount = 24;
+        lod.MeshArray[0].FaceCount = 12;
+        lod.MeshArray[0].RenderWorldIndex = 0;
+        dk::maths::CreateAABB( lod.GroupAABB, dkVec3f::Zero, dkVec3f( 1.0f, 1.0f, 1.0f ) );
+
+        model->computeBounds();
+
+        models[modelIdx] = model;
+    }
+
+    TransformDatabase* transformDatabase = g_World->getTransformDatabase();
+    StaticGeometryDatabase* staticGeometryDatabase = g_World->getStaticGeometryDatabase();
+    PointLightDatabase* pointLightDatabase = g_World->getPointLightDatabase();
+
+    u32 seed = 0x1337u;
+    const f32 worldExtent = BenchmarkWorldExtent;
+
+    for ( u32 instanceIdx = 0u; instanceIdx < BenchmarkStaticInstanceCount; instanceIdx++ ) {
+        Entity entity = g_World->createStaticMesh( "BenchmarkStaticMesh" );
+
+        const dkVec3f position = dkVec3f(
+            ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent,
+            NextRandomFloat( seed ) * 16.0f,
+            ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent
+        );
+
+        staticGeometryDatabase->setModel( staticGeometryDatabase->lookup( entity ), models[instanceIdx % modelCount] );
+        transformDatabase->setPosition( transformDatabase->lookup( entity ), position );
+    }
+
+    for ( u32 lightIdx = 0u; lightIdx < BenchmarkPointLightCount; lightIdx++ ) {
+        Entity entity = g_World->createPointLight( "BenchmarkPointLight" );
+
+        const dkVec3f position = dkVec3f(
+            ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent,
+            NextRandomFloat( seed ) * 16.0f,
+            ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent
+        );
+
+        transformDatabase->setPosition( transformDatabase->lookup( entity ), position );
+
+        PointLightGPU& lightData = pointLightDatabase->getLightData( pointLightDatabase->lookup( entity ) );
+        lightData.ColorLinearSpace = dkVec3f( 1.0f, 1.0f, 1.0f );
+        lightData.PowerInLux = 100.0f;
+        lightData.WorldRadius = 4.0f + NextRandomFloat( seed ) * 16.0f;
+    }
+
+    // Compute entities world matrices.
+    g_World->update( 0.0f );
+}
+
+static void WriteReport( const BenchmarkReport& benchmarkReport )
+{
+    const BenchmarkFrameStats* frameStats = benchmarkReport.FrameStats;
+    const u32 frameCount = benchmarkReport.FrameCount;
+
+    std::stringstream report;
+    report << "{\n";
+    report << "  \"backend\": \"" << DUSK_NARROW_STRING( RenderDevice::getBackendName() ) << "\",\n";
+    report << "  \"config\": {\n";
+    report << "    \"frameCount\": " << frameCount << ",\n";
+    report << "    \"staticInstanceCount\": " << BenchmarkStaticInstanceCount << ",\n";
+    report << "    \"modelCount\": " << benchmarkReport.ModelCount << ",\n";
+    report << "    \"pointLightCount\": " << BenchmarkPointLightCount << ",\n";
+    report << "    \"cameraCount\": " << BenchmarkCameraCount << ",\n";
+    report << "    \"workerCount\": " << g_JobSystem->getWorkerCount() << ",\n";
+    report << "    \"screenWidth\": " << ScreenSize.x << ",\n";
+    report << "    \"screenHeight\": " << ScreenSize.y << "\n";
+    report << "  },\n";
+
+    // Frame-level stats.
+    f64 frameTimeSum = 0.0;
+    f64 frameTimeMin = std::numeric_limits<f64>::max();
+    f64 frameTimeMax = 0.0;
+    u64 heapAllocationSum = 0ull;
+    u64 heapAllocationSizeSum = 0ull;
+    u64 engineAllocationSum = 0ull;
+    u64 transientMemoryPeak = 0ull;
+    u64 transientMemoryPeakAliased = 0ull;
+    u32 reusedCompiledGraphCount = 0u;
+    u64 queueBusyTimeSum[COMMAND_QUEUE_COUNT] = {};
+    u64 queueFrameTimeSum = 0ull;
+    u64 crossQueueWaitSum = 0ull;
+    u64 barrierBatchSum = 0ull;
+    u64 barrierSum = 0ull;
+    u64 splitBarrierSum = 0ull;
+    u64 drawCallSum = 0ull;
+    u64 multiDrawCallSum = 0ull;
+    u64 indirectDrawSum = 0ull;
+    u64 pipelineStateBindSum = 0ull;
+    u64 resourceListBindSum = 0ull;
+    u64 bufferUpdateSum = 0ull;
+    u64 bufferUpdateSizeSum = 0ull;
+    u64 issuedBindSum = 0ull;
+    u64 filteredBindSum = 0ull;
+
+    for ( u32 frameIdx = 0u; frameIdx < frameCount; frameIdx++ ) {
+        const BenchmarkFrameStats& stats = frameStats[frameIdx];
+        frameTimeSum += stats.FrameTime;
+        frameTimeMin = Min( frameTimeMin, stats.FrameTime );
+        frameTimeMax = Max( frameTimeMax, stats.FrameTime );
+        heapAllocationSum += stats.HeapAllocationCount;
+        heapAllocationSizeSum += stats.HeapAllocationSize;
+        engineAllocationSum += stats.EngineAllocationCount;
+        transientMemoryPeak = Max( transientMemoryPeak, stats.TransientMemory.PeakMemoryWithoutAliasing );
+        transientMemoryPeakAliased = Max( transientMemoryPeakAliased, stats.TransientMemory.PeakMemoryWithAliasing );
+        reusedCompiledGraphCount += ( stats.IsCompiledGraphReused ) ? 1u : 0u;
+
+        for ( i32 queueIdx = 0; queueIdx < COMMAND_QUEUE_COUNT; queueIdx++ ) {
+            queueBusyTimeSum[queueIdx] += stats.QueueTimeline.BusyTime[queueIdx];
+        }
+        queueFrameTimeSum += stats.QueueTimeline.FrameTime;
+        crossQueueWaitSum += stats.QueueTimeline.CrossQueueWaitCount;
+        barrierBatchSum += stats.Barriers.BarrierBatchCount;
+        barrierSum += stats.Barriers.BarrierCount;
+        splitBarrierSum += stats.Barriers.SplitBarrierCount;
+        drawCallSum += stats.ApiCalls.DrawCallCount;
+        multiDrawCallSum += stats.ApiCalls.MultiDrawCallCount;
+        indirectDrawSum += stats.ApiCalls.IndirectDrawCount;
+        pipelineStateBindSum += stats.ApiCalls.PipelineStateBindCount;
+        resourceListBindSum += stats.ApiCalls.ResourceListBindCount;
+        bufferUpdateSum += stats.ApiCalls.BufferUpdateCount;
+        bufferUpdateSizeSum += stats.ApiCalls.BufferUpdateSize;
+        issuedBindSum += stats.ApiCalls.IssuedBindCount;
+        filteredBindSum += stats.ApiCalls.FilteredBindCount;
+    }
+
+    const f64 frameCountF64 = static_cast< f64 >( Max( frameCount, 1u ) );
+
+    report << "  \"frame\": {\n";
+    report << "    \"avgMs\": " << ( frameTimeSum / frameCountF64 ) << ",\n";
+    report << "    \"minMs\": " << frameTimeMin << ",\n";
+    report << "    \"maxMs\": " << frameTimeMax << ",\n";
+    report << "    \"heapAllocationsPerFrame\": " << ( static_cast< f64 >( heapAllocationSum ) / frameCountF64 ) << ",\n";
+    report << "    \"heapBytesPerFrame\": " << ( static_cast< f64 >( heapAllocationSizeSum ) / frameCountF64 ) << ",\n";
+    report << "    \"engineAllocationsPerFrame\": " << ( static_cast< f64 >( engineAllocationSum ) / frameCountF64 ) << ",\n";
+    report << "    \"reusedCompiledGraphCount\": " << reusedCompiledGraphCount << "\n";
+    report << "  },\n";
+
+    report << "  \"transientMemory\": {\n";
+    report << "    \"peakBytesWithoutAliasing\": " << transientMemoryPeak << ",\n";
+    report << "    \"peakBytesWithAliasing\": " << transientMemoryPeakAliased << "\n";
+    report << "  },\n";
+
+    // A queue is always busy while the other waits for it; the time saved by overlapping the queues is therefore the
+    // difference between the serialized time and the frame time.
+    const u64 queueSerializedTimeSum = queueBusyTimeSum[COMMAND_QUEUE_GRAPHICS] + queueBusyTimeSum[COMMAND_QUEUE_COMPUTE];
+
+    report << "  \"gpuQueues\": {\n";
+    report << "    \"graphicsBusyPerFrame\": " << ( static_cast< f64 >( queueBusyTimeSum[COMMAND_QUEUE_GRAPHICS] ) / frameCountF64 ) << ",\n";
+    report << "    \"computeBusyPerFrame\": " << ( static_cast< f64 >( queueBusyTimeSum[COMMAND_QUEUE_COMPUTE] ) / frameCountF64 ) << ",\n";
+    report << "    \"frameTimePerFrame\": " << ( static_cast< f64 >( queueFrameTimeSum ) / frameCountF64 ) << ",\n";
+    report << "    \"overlapPerFrame\": " << ( static_cast< f64 >( queueSerializedTimeSum - queueFrameTimeSum ) / frameCountF64 ) << ",\n";
+    report << "    \"crossQueueWaitsPerFrame\": " << ( static_cast< f64 >( crossQueueWaitSum ) / frameCountF64 ) << "\n";
+    report << "  },\n";
+
+    report << "  \"barriers\": {\n";
+    report << "    \"batchesPerFrame\": " << ( static_cast< f64 >( barrierBatchSum ) / frameCountF64 ) << ",\n";
+    report << "    \"barriersPerFrame\": " << ( static_cast< f64 >( barrierSum ) / frameCountF64 ) << ",\n";
+    report << "    \"splitBarriersPerFrame\": " << ( static_cast< f64 >( splitBarrierSum ) / frameCountF64 ) << "\n";
+    report << "  },\n";
+
+    report << "  \"apiCalls\": {\n";
+    report << "    \"drawCallsPerFrame\": " << ( static_cast< f64 >( drawCallSum ) / frameCountF64 ) << ",\n";
+    report << "    \"multiDrawCallsPerFrame\": " << ( static_cast< f64 >( multiDrawCallSum ) / frameCountF64 ) << ",\n";
+    report << "    \"indirectDrawsPerFrame\": " << ( static_cast< f64 >( indirectDrawSum ) / frameCountF64 ) << ",\n";
+    report << "    \"pipelineStateBindsPerFrame\": " << ( static_cast< f64 >( pipelineStateBindSum ) / frameCountF64 ) << ",\n";
+    report << "    \"resourceListBindsPerFrame\": " << ( static_cast< f64 >( resourceListBindSum ) / frameCountF64 ) << ",\n";
+    report << "    \"bufferUpdatesPerFrame\": " << ( static_cast< f64 >( bufferUpdateSum ) / frameCountF64 ) << ",\n";
+    report << "    \"bufferUpdateBytesPerFrame\": " << ( static_cast< f64 >( bufferUpdateSizeSum ) / frameCountF64 ) << ",\n";
+    report << "    \"issuedBindsPerFrame\": " << ( static_cast< f64 >( issuedBindSum ) / frameCountF64 ) << ",\n";
+    report << "    \"filteredBindsPerFrame\": " << ( static_cast< f64 >( filteredBindSum ) / frameCountF64 ) << "\n";
+    report << "  },\n";
+
+    WriteCullingReport( report, benchmarkReport.Culling );
+    WriteSortReport( report, benchmarkReport.Sort );
+    WriteOcclusionReport( report, benchmarkReport.Occlusion );
+    WriteLodReport( report, benchmarkReport.Lod );
+    WriteTransformReport( report, benchmarkReport.Transform );
+    WriteComponentReport( report, benchmarkReport.Component );
+    WriteEntityReport( report, benchmarkReport.Entity );
+    WriteSpatialReport( report, benchmarkReport.Spatial );
+    WriteStreamingReport( report, benchmarkReport.Streaming );
+    WriteAliasingReport( report, benchmarkReport.Aliasing );
+
+    // Per-stage stats (from the CPU profiler sections).
+    report << "  \"stages\": [\n";
+    bool isFirstSection = true;
+    for ( const auto& section : g_CpuProfiler ) {
+        const CpuProfiler::SectionData& data = section.second;
+        if ( data.SampleCount == 0ull ) {
+            continue;
+        }
+
+        if ( !isFirstSection ) {
+            report << ",\n";
+        }
+        isFirstSection = false;
+
+        report << "    { \"name\": \"" << data.Name << "\""
+               << ", \"parent\": \"" << ( ( data.Parent != nullptr ) ? data.Parent->Name : "" ) << "\""
+               << ", \"callCount\": " << data.SampleCount
+               << ", \"avgMs\": " << CpuProfiler::SectionData::CalculateAverage( data )
+               << ", \"minMs\": " << data.Minimum
+               << ", \"maxMs\": " << data.Maximum
+               << ", \"totalMs\": " << data.Sum << " }";
+    }
+    report << "\n  ]\n";
+    report << "}\n";
+
+    const std::string reportContent = report.str();
+
+    dkString_t reportPath = dkString_t( DUSK_STRING( "BenchmarkOutput/" ) ) + BENCHMARK_REPORT_FILENAME;
+    FileSystemObject* reportFile = g_VirtualFileSystem->openFile( reportPath, eFileOpenMode::FILE_OPEN_MODE_WRITE );
+    if ( reportFile == nullptr || !reportFile->isGood() ) {
+        DUSK_LOG_ERROR( "Failed to open '%s' for writing! Dumping the report to the log instead...\n", reportPath.c_str() );
+        DUSK_LOG_RAW( "%hs", reportContent.c_str() );
+        return;
+    }
+
+    reportFile->writeString( reportContent );
+    reportFile->close();
+
+    DUSK_LOG_INFO( "Benchmark report written to '%s'\n", reportPath.c_str() );
+}
+
+// Run the benchmark and write its report. Return the number of mismatches (summed for every microbenchmark).
+static u32 RunBenchmark()
+{
+    const u32 instancePerModel = Max( BenchmarkInstancePerModel, 1u );
+    const u32 modelCount = Max( ( BenchmarkStaticInstanceCount + instancePerModel - 1u ) / instancePerModel, 1u );
+
+    Model** models = dk::core::allocateArray<Model*>( g_GlobalAllocator, modelCount, nullptr );
+    BuildSyntheticWorld( models, modelCount );
+
+    // Setup cameras (spread around the world center; looking at the center).
+    const u32 cameraCount = Min( Max( BenchmarkCameraCount, 1u ), MAX_BENCHMARK_CAMERA_COUNT );
+    FreeCamera* cameras = dk::core::allocateArray<FreeCamera>( g_GlobalAllocator, cameraCount );
+    for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+        FreeCamera& camera = cameras[cameraIdx];
+        camera.setProjectionMatrix( 90.0f, static_cast< f32 >( ScreenSize.x ), static_cast< f32 >( ScreenSize.y ) );
+        camera.setOrientation( ( static_cast< f32 >( cameraIdx ) / static_cast< f32 >( cameraCount ) ) * dk::maths::TWO_PI<f32>(), 0.0f, 0.0f );
+        camera.update( 0.0f );
+    }
+
+    // Cameras the renderables are collected for (the camera data is owned by the cameras).
+    const CameraData* cameraDataArray[MAX_BENCHMARK_CAMERA_COUNT];
+    for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+        cameraDataArray[cameraIdx] = &cameras[cameraIdx].getData();
+    }
+
+    Viewport viewport;
+    viewport.X = 0;
+    viewport.Y = 0;
+    viewport.Width = static_cast< i32 >( ScreenSize.x );
+    viewport.Height = static_cast< i32 >( ScreenSize.y );
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+
+    ScissorRegion scissor;
+    scissor.Top = 0;
+    scissor.Left = 0;
+    scissor.Right = static_cast< i32 >( ScreenSize.x );
+    scissor.Bottom = static_cast< i32 >( ScreenSize.y );
+
+    const dkVec2f viewportSize = dkVec2f( static_cast< f32 >( ScreenSize.x ), static_cast< f32 >( ScreenSize.y ) );
+
+    // Fixed delta time (keeps the frames deterministic).
+    constexpr f32 FRAME_DELTA_TIME = 1.0f / 60.0f;
+
+    const u32 totalFrameCount = BenchmarkWarmupFrameCount + BenchmarkFrameCount;
+    BenchmarkFrameStats* frameStats = dk::core::allocateArray<BenchmarkFrameStats>( g_GlobalAllocator, Max( BenchmarkFrameCount, 1u ) );
+
+    DUSK_LOG_INFO( "Running benchmark (%u warmup frame(s); %u frame(s))...\n", BenchmarkWarmupFrameCount, BenchmarkFrameCount );
+
+    Timer frameTimer;
+    for ( u32 frameIdx = 0u; frameIdx < totalFrameCount; frameIdx++ ) {
+        // Reset the profiler once the warmup is done (we don't want to record pipeline state creation, etc.).
+        if ( frameIdx == BenchmarkWarmupFrameCount ) {
+            g_CpuProfiler.clear();
+        }
+
+        const u64 heapAllocationCount = g_HeapAllocationCount.load();
+        const u64 heapAllocationSize = g_HeapAllocationSize.load();
+        const size_t engineAllocationCount = g_GlobalAllocator->getAllocationCount();
+
+        frameTimer.reset();
+
+        {
+            DUSK_CPU_PROFILE_SCOPED( "Frame" );
+
+            FrameGraph& frameGraph = g_WorldRenderer->prepareFrameGraph( viewport, scissor, &cameras[0].getData() );
+            frameGraph.setScreenSize( ScreenSize );
+
+            g_World->update( FRAME_DELTA_TIME );
+            g_World->collectRenderables( g_DrawCommandBuilder, g_WorldRenderer->getLightGrid(), cameraDataArray, cameraCount );
+
+            g_RenderWorld->update( g_RenderDevice );
+
+            for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+                g_DrawCommandBuilder->addWorldCameraToRender( &cameras[cameraIdx].getData() );
+            }
+            g_DrawCommandBuilder->prepareAndDispatchCommands( g_WorldRenderer );
+
+            {
+                DUSK_CPU_PROFILE_SCOPED( "Record RenderPasses" );
+
+                FGHandle presentRt = g_WorldRenderer->buildDefaultGraph( frameGraph, Material::RenderScenario::Default, viewportSize, g_RenderWorld );
+                AddPresentRenderPass( frameGraph, presentRt );
+            }
+
+            g_WorldRenderer->drawWorld( g_RenderDevice, FRAME_DELTA_TIME );
+
+            // Wait for the render passes execution (so that the worker time is accounted for this frame).
+            frameGraph.waitPendingFrameCompletion();
+
+            if ( frameIdx >= BenchmarkWarmupFrameCount ) {
+                BenchmarkFrameStats& stats = frameStats[frameIdx - BenchmarkWarmupFrameCount];
+                stats.TransientMemory = frameGraph.getTransientMemoryStats();
+                stats.IsCompiledGraphReused = frameGraph.isCompiledGraphReused();
+                stats.QueueTimeline = g_RenderDevice->getQueueTimelineStats();
+                stats.Barriers = g_RenderDevice->getBarrierStats();
+                stats.ApiCalls = g_RenderDevice->getApiCallStats();
+            }
+        }
+
+        if ( frameIdx >= BenchmarkWarmupFrameCount ) {
+            BenchmarkFrameStats& stats = frameStats[frameIdx - BenchmarkWarmupFrameCount];
+            stats.FrameTime = frameTimer.getElapsedTimeAsMiliseconds();
+            stats.HeapAllocationCount = g_HeapAllocationCount.load() - heapAllocationCount;
+            stats.HeapAllocationSize = g_HeapAllocationSize.load() - heapAllocationSize;
+            stats.EngineAllocationCount = static_cast< u64 >( g_GlobalAllocator->getAllocationCount() - engineAllocationCount );
+        }
+    }
+
+    BenchmarkReport benchmarkReport;
+    benchmarkReport.FrameStats = frameStats;
+    benchmarkReport.FrameCount = BenchmarkFrameCount;
+    benchmarkReport.ModelCount = modelCount;
+
+    RunCullingMicrobenchmark( cameras, cameraCount, BenchmarkWorldExtent, benchmarkReport.Culling );
+    RunSortMicrobenchmark( benchmarkReport.Sort );
+    RunOcclusionMicrobenchmark( benchmarkReport.Occlusion );
+    RunLodMicrobenchmark( static_cast< f32 >( ScreenSize.y ), benchmarkReport.Lod );
+    RunTransformMicrobenchmark( benchmarkReport.Transform );
+    RunComponentMicrobenchmark( benchmarkReport.Component );
+    RunEntityMicrobenchmark( benchmarkReport.Entity );
+    RunSpatialMicrobenchmark( cameras, cameraCount, benchmarkReport.Spatial );
+    RunStreamingMicrobenchmark( benchmarkReport.Streaming );
+    RunAliasingMicrobenchmark( benchmarkReport.Aliasing );
+
+    WriteReport( benchmarkReport );
+
+    dk::core::freeArray( g_GlobalAllocator, frameStats );
+    dk::core::freeArray( g_GlobalAllocator, cameras );
+
+    return GetMismatchCount( benchmarkReport );
+}
+
+static void Shutdown()
+{
+    DUSK_LOG_INFO( "Shutting down...\n" );
+
+    g_WorldRenderer->destroy( g_RenderDevice );
+    g_RenderWorld->destroy( *g_RenderDevice );
+
+    dk::core::free( g_GlobalAllocator, g_World );
+    dk::core::free( g_GlobalAllocator, g_DrawCommandBuilder );
+    dk::core::free( g_GlobalAllocator, g_RenderWorld );
+    dk::core::free( g_GlobalAllocator, g_WorldRenderer );
+    dk::core::free( g_GlobalAllocator, g_GraphicsAssetCache );
+    dk::core::free( g_GlobalAllocator, g_ShaderCache );
+    dk::core::free( g_GlobalAllocator, g_RenderDevice );
+
+#if DUSK_DEVBUILD
+    dk::core::free( g_GlobalAllocator, g_EdAssetsFileSystem );
+    dk::core::free( g_GlobalAllocator, g_RendererFileSystem );
+#endif
+
+    dk::core::free( g_GlobalAllocator, g_OutputFileSystem );
+    dk::core::free( g_GlobalAllocator, g_DataFileSystem );
+    dk::core::free( g_GlobalAllocator, g_VirtualFileSystem );
+    dk::core::free( g_GlobalAllocator, g_JobSystem );
+
+    g_GlobalAllocator->clear();
+    g_GlobalAllocator->~LinearAllocator();
+    dk::core::free( g_AllocatedTable );
+
+    Logger::CloseOutputStreams();
+}
+
+i32 dk::benchmark::Start( const char* cmdLineArgs )
+{
+    DUSK_LOG_RAW( "================================\nDusk Benchmark %s\n%hs\nCompiled with: %s\n================================\n\n", DUSK_BUILD, DUSK_BUILD_DATE, DUSK_COMPILER );
+
+    g_AllocatedTable = dk::core::malloc( GLOBAL_MEMORY_TABLE_SIZE );
+    g_GlobalAllocator = new ( g_BaseBuffer ) LinearAllocator( GLOBAL_MEMORY_TABLE_SIZE, g_AllocatedTable );
+
+    dk::core::ReadCommandLineArgs( cmdLineArgs );
+
+    InitializeSubsystems();
+    const u32 mismatchCount = RunBenchmark();
+
+    if ( mismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Benchmark failed: %u mismatch(es) (see the report)!\n", mismatchCount );
+    }
+
+    Shutdown();
+
+    // Non-zero if any microbenchmark output does not match its reference.
+    return ( mismatchCount != 0u ) ? 1 : 0;
+}
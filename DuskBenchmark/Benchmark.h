@@ -0,0 +1,14 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+namespace dk
+{
+    namespace benchmark
+    {
+        // Run the benchmark and return the process exit code (0 on success).
+        i32 Start( const char* cmdLineArgs );
+    }
+}
@@ -0,0 +1,21 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class LinearAllocator;
+class RenderDevice;
+class JobSystem;
+
+// Subsystems shared by the microbenchmarks (owned by Benchmark.cpp).
+extern LinearAllocator* g_GlobalAllocator;
+extern RenderDevice* g_RenderDevice;
+extern JobSystem* g_JobSystem;
+
+// Pseudo random (but deterministic) float in the [0..1] range.
+static DUSK_INLINE f32 NextRandomFloat( u32& seed )
+{
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast< f32 >( seed >> 8 ) / static_cast< f32 >( 1u << 24 );
+}
@@ -0,0 +1,239 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "ComponentStorageBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Framework/PointLight.h"
+
+#include <queue>
+
+#include <unordered_map>
+
+DUSK_ENV_VAR( BenchmarkComponentInstanceCount, 10000, u32 ); // "Number of components allocated by the component storage microbenchmark"
+DUSK_ENV_VAR( BenchmarkComponentIterationCount, 100, u32 ); // "Number of insertion/lookup/iteration/deletion cycles executed by the component storage microbenchmark"
+
+// Reference entity to instance mapping (hashmap lookup and free list; no packing after deletions). Matches the
+// ComponentDatabase implementation prior to the sparse set.
+struct HashMapComponentStorage
+{
+    std::unordered_map<size_t, Instance>    EntityToInstanceMap;
+    std::queue<Instance>                    FreeInstances;
+    Entity*                                 Owner;
+    PointLightGPU*                          PointLight;
+    size_t                                  AllocationCount;
+};
+
+void RunComponentMicrobenchmark( BenchmarkComponentStats& componentStats )
+{
+    const u32 instanceCount = Max( BenchmarkComponentInstanceCount, 1u );
+    const u32 iterationCount = Max( BenchmarkComponentIterationCount, 1u );
+
+    // Entity indexes are spread over the index range (entities owning a component are rarely contiguous).
+    constexpr u32 ENTITY_INDEX_STRIDE = 3u;
+
+    DUSK_LOG_INFO( "Running component storage microbenchmark (%u instance(s); %u iteration(s))...\n", instanceCount, iterationCount );
+
+    PointLightDatabase* pointLightDatabase = dk::core::allocate<PointLightDatabase>( g_GlobalAllocator, g_GlobalAllocator );
+    pointLightDatabase->create( instanceCount );
+
+    HashMapComponentStorage reference;
+    reference.Owner = dk::core::allocateArray<Entity>( g_GlobalAllocator, instanceCount );
+    reference.PointLight = dk::core::allocateArray<PointLightGPU>( g_GlobalAllocator, instanceCount );
+    reference.AllocationCount = 0;
+
+    // Entities in allocation order and in a (deterministic) random order for lookups and deletions.
+    Entity* entities = dk::core::allocateArray<Entity>( g_GlobalAllocator, instanceCount );
+    Entity* shuffledEntities = dk::core::allocateArray<Entity>( g_GlobalAllocator, instanceCount );
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        entities[instanceIdx] = Entity( ( instanceIdx * ENTITY_INDEX_STRIDE ) & Entity::INDEX_MASK, 0u );
+        shuffledEntities[instanceIdx] = entities[instanceIdx];
+    }
+
+    u32 seed = 0xC0FFEEu;
+    for ( u32 instanceIdx = instanceCount - 1u; instanceIdx > 0u; instanceIdx-- ) {
+        const u32 swapIdx = Min( static_cast< u32 >( NextRandomFloat( seed ) * static_cast< f32 >( instanceIdx + 1u ) ), instanceIdx );
+        std::swap( shuffledEntities[instanceIdx], shuffledEntities[swapIdx] );
+    }
+
+    componentStats.InstanceCount = instanceCount;
+    componentStats.MismatchCount = 0u;
+
+    f64 insertionTimeSum[2] = { 0.0, 0.0 };
+    f64 lookupTimeSum[2] = { 0.0, 0.0 };
+    f64 iterationTimeSum[2] = { 0.0, 0.0 };
+    f64 deletionTimeSum[2] = { 0.0, 0.0 };
+
+    Timer benchmarkTimer;
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        // Insertion.
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            Instance instance;
+            if ( !reference.FreeInstances.empty() ) {
+                instance = reference.FreeInstances.front();
+                reference.FreeInstances.pop();
+            } else {
+                instance = Instance( reference.AllocationCount++ );
+            }
+
+            reference.EntityToInstanceMap[entities[instanceIdx].extractIndex()] = instance;
+            reference.Owner[instance.getIndex()] = entities[instanceIdx];
+            reference.PointLight[instance.getIndex()].WorldRadius = static_cast< f32 >( instanceIdx );
+        }
+        insertionTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            pointLightDatabase->allocateComponent( entities[instanceIdx] );
+            pointLightDatabase->getLightData( pointLightDatabase->lookup( entities[instanceIdx] ) ).WorldRadius = static_cast< f32 >( instanceIdx );
+        }
+        insertionTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        // Lookup (the sums are compared to make sure both implementations return the same data).
+        f64 lookupSum[2] = { 0.0, 0.0 };
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            const Instance instance = reference.EntityToInstanceMap.at( shuffledEntities[instanceIdx].extractIndex() );
+            lookupSum[0] += reference.PointLight[instance.getIndex()].WorldRadius;
+        }
+        lookupTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            lookupSum[1] += pointLightDatabase->getLightData( pointLightDatabase->lookup( shuffledEntities[instanceIdx] ) ).WorldRadius;
+        }
+        lookupTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        // Remove half of the components (random order) so that the iteration has to deal with deleted components.
+        const u32 halfInstanceCount = instanceCount / 2u;
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < halfInstanceCount; instanceIdx++ ) {
+            const size_t entityIndex = shuffledEntities[instanceIdx].extractIndex();
+            const Instance instance = reference.EntityToInstanceMap.at( entityIndex );
+            reference.FreeInstances.push( instance );
+            reference.Owner[instance.getIndex()] = Entity();
+            reference.EntityToInstanceMap.erase( entityIndex );
+        }
+        deletionTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < halfInstanceCount; instanceIdx++ ) {
+            pointLightDatabase->removeComponent( shuffledEntities[instanceIdx] );
+        }
+        deletionTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        // Iteration (the reference has to skip the deleted components).
+        f64 iterationSum[2] = { 0.0, 0.0 };
+
+        benchmarkTimer.reset();
+        for ( size_t instanceIdx = 0; instanceIdx < reference.AllocationCount; instanceIdx++ ) {
+            if ( reference.Owner[instanceIdx].isValid() ) {
+                iterationSum[0] += reference.PointLight[instanceIdx].WorldRadius;
+            }
+        }
+        iterationTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        const size_t pointLightCount = pointLightDatabase->getInstanceCount();
+        for ( size_t instanceIdx = 0; instanceIdx < pointLightCount; instanceIdx++ ) {
+            iterationSum[1] += pointLightDatabase->getLightData( Instance( instanceIdx ) ).WorldRadius;
+        }
+        iterationTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        // Correctness: every live component must match the reference; removed components must be unmapped.
+        if ( iterationIdx == 0u ) {
+            for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+                const Entity& entity = shuffledEntities[instanceIdx];
+                const bool isRemoved = ( instanceIdx < halfInstanceCount );
+
+                if ( pointLightDatabase->hasComponent( entity ) == isRemoved ) {
+                    componentStats.MismatchCount++;
+                    continue;
+                }
+
+                if ( !isRemoved ) {
+                    const Instance instance = pointLightDatabase->lookup( entity );
+                    const Instance referenceInstance = reference.EntityToInstanceMap.at( entity.extractIndex() );
+
+                    if ( pointLightDatabase->getOwner( instance ).getIdentifier() != entity.getIdentifier()
+                      || pointLightDatabase->getLightData( instance ).WorldRadius != reference.PointLight[referenceInstance.getIndex()].WorldRadius ) {
+                        componentStats.MismatchCount++;
+                    }
+                }
+            }
+
+            if ( pointLightCount != ( instanceCount - halfInstanceCount ) || lookupSum[0] != lookupSum[1] || iterationSum[0] != iterationSum[1] ) {
+                componentStats.MismatchCount++;
+            }
+        }
+
+        // Remove the remaining components (the databases are empty for the next iteration).
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = halfInstanceCount; instanceIdx < instanceCount; instanceIdx++ ) {
+            const size_t entityIndex = shuffledEntities[instanceIdx].extractIndex();
+            const Instance instance = reference.EntityToInstanceMap.at( entityIndex );
+            reference.FreeInstances.push( instance );
+            reference.Owner[instance.getIndex()] = Entity();
+            reference.EntityToInstanceMap.erase( entityIndex );
+        }
+        deletionTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        for ( u32 instanceIdx = halfInstanceCount; instanceIdx < instanceCount; instanceIdx++ ) {
+            pointLightDatabase->removeComponent( shuffledEntities[instanceIdx] );
+        }
+        deletionTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+    }
+
+    if ( pointLightDatabase->getInstanceCount() != 0 ) {
+        componentStats.MismatchCount++;
+    }
+
+    const f64 iterationCountF64 = static_cast< f64 >( iterationCount );
+    for ( u32 implIdx = 0u; implIdx < 2u; implIdx++ ) {
+        componentStats.InsertionTime[implIdx] = insertionTimeSum[implIdx] / iterationCountF64;
+        componentStats.LookupTime[implIdx] = lookupTimeSum[implIdx] / iterationCountF64;
+        componentStats.IterationTime[implIdx] = iterationTimeSum[implIdx] / iterationCountF64;
+        componentStats.DeletionTime[implIdx] = deletionTimeSum[implIdx] / iterationCountF64;
+    }
+
+    if ( componentStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Component storage mismatch (%u component(s) differ from the reference)!\n", componentStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Component storage (hashmap/sparse set): insertion %f/%f ms; lookup %f/%f ms; iteration %f/%f ms; deletion %f/%f ms\n", 
+                   componentStats.InsertionTime[0], componentStats.InsertionTime[1], componentStats.LookupTime[0], componentStats.LookupTime[1],
+                   componentStats.IterationTime[0], componentStats.IterationTime[1], componentStats.DeletionTime[0], componentStats.DeletionTime[1] );
+
+    dk::core::freeArray( g_GlobalAllocator, shuffledEntities );
+    dk::core::freeArray( g_GlobalAllocator, entities );
+    dk::core::freeArray( g_GlobalAllocator, reference.PointLight );
+    dk::core::freeArray( g_GlobalAllocator, reference.Owner );
+    dk::core::free( g_GlobalAllocator, pointLightDatabase );
+}
+
+void WriteComponentReport( std::stringstream& report, const BenchmarkComponentStats& componentStats )
+{
+    report << "  \"componentStorage\": {\n";
+    report << "    \"instanceCount\": " << componentStats.InstanceCount << ",\n";
+    report << "    \"hashMapInsertionMs\": " << componentStats.InsertionTime[0] << ",\n";
+    report << "    \"sparseSetInsertionMs\": " << componentStats.InsertionTime[1] << ",\n";
+    report << "    \"hashMapLookupMs\": " << componentStats.LookupTime[0] << ",\n";
+    report << "    \"sparseSetLookupMs\": " << componentStats.LookupTime[1] << ",\n";
+    report << "    \"hashMapIterationMs\": " << componentStats.IterationTime[0] << ",\n";
+    report << "    \"sparseSetIterationMs\": " << componentStats.IterationTime[1] << ",\n";
+    report << "    \"hashMapDeletionMs\": " << componentStats.DeletionTime[0] << ",\n";
+    report << "    \"sparseSetDeletionMs\": " << componentStats.DeletionTime[1] << ",\n";
+    report << "    \"mismatchCount\": " << componentStats.MismatchCount << "\n";
+    report << "  },\n";
+}
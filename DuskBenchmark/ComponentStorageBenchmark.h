@@ -0,0 +1,36 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkComponentStats
+{
+    // Number of components allocated per iteration.
+    u32                     InstanceCount;
+
+    // Average time to allocate every component using the hashmap reference and the sparse set (in milliseconds).
+    f64                     InsertionTime[2];
+
+    // Average time to lookup every component (random order) using the hashmap reference and the sparse set (in
+    // milliseconds).
+    f64                     LookupTime[2];
+
+    // Average time to iterate every component using the hashmap reference and the sparse set (in milliseconds).
+    f64                     IterationTime[2];
+
+    // Average time to remove every component (random order) using the hashmap reference and the sparse set (in
+    // milliseconds).
+    f64                     DeletionTime[2];
+
+    // Number of components whose data (or lookup result) does not match the reference.
+    u32                     MismatchCount;
+};
+
+// Run the component storage microbenchmark (the sparse set storage is checked against a hashmap storage).
+void RunComponentMicrobenchmark( BenchmarkComponentStats& componentStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'componentStorage').
+void WriteComponentReport( std::stringstream& report, const BenchmarkComponentStats& componentStats );
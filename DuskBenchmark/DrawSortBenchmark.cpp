@@ -0,0 +1,132 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "DrawSortBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/JobSystem.h"
+#include "Core/Timer.h"
+
+#include "Graphics/DrawCommandBuilder.h"
+#include "Graphics/DrawCommandSorter.h"
+
+DUSK_ENV_VAR( BenchmarkSortDrawCmdCount, 16384, u32 ); // "Number of draw commands sorted by the draw command sort microbenchmark"
+DUSK_ENV_VAR( BenchmarkSortIterationCount, 100, u32 ); // "Number of sorts executed by the draw command sort microbenchmark"
+
+void RunSortMicrobenchmark( BenchmarkSortStats& sortStats )
+{
+    const u32 drawCmdCount = Max( BenchmarkSortDrawCmdCount, 1u );
+    const u32 iterationCount = Max( BenchmarkSortIterationCount, 1u );
+
+    DUSK_LOG_INFO( "Running draw command sort microbenchmark (%u draw command(s); %u iteration(s))...\n", drawCmdCount, iterationCount );
+
+    DrawCmd* drawCmds = dk::core::allocateArray<DrawCmd>( g_GlobalAllocator, drawCmdCount );
+    DrawCmd* serialDrawCmds = dk::core::allocateArray<DrawCmd>( g_GlobalAllocator, drawCmdCount );
+    DrawCmd* tempDrawCmds = dk::core::allocateArray<DrawCmd>( g_GlobalAllocator, drawCmdCount );
+
+    DrawCommandSorter* drawCmdSorter = dk::core::allocate<DrawCommandSorter>( g_GlobalAllocator, g_GlobalAllocator, g_JobSystem );
+
+    // Keys mimic a frame of the world renderer (a few materials; depth and world layers; a single viewport). The
+    // instance count stores the allocation index to check the sort stability.
+    u32 seed = 0xdecafu;
+    for ( u32 cmdIdx = 0u; cmdIdx < drawCmdCount; cmdIdx++ ) {
+        auto& key = drawCmds[cmdIdx].key.bitfield;
+        key.materialSortKey = static_cast< u32 >( NextRandomFloat( seed ) * 32.0f );
+        key.depth = static_cast< u16 >( NextRandomFloat( seed ) * 65535.0f );
+        key.sortOrder = DrawCommandKey::SORT_FRONT_TO_BACK;
+        key.layer = ( NextRandomFloat( seed ) > 0.5f ) ? DrawCommandKey::LAYER_DEPTH : DrawCommandKey::LAYER_WORLD;
+
+        drawCmds[cmdIdx].infos.instanceCount = cmdIdx;
+    }
+
+    // Correctness: both implementations must return the same (stable) order.
+    memcpy( serialDrawCmds, drawCmds, sizeof( DrawCmd ) * drawCmdCount );
+    DrawCommandSorter::SortSerial( serialDrawCmds, tempDrawCmds, drawCmdCount );
+    const DrawCmd* sortedDrawCmds = drawCmdSorter->sort( drawCmds, drawCmdCount );
+
+    sortStats.DrawCmdCount = drawCmdCount;
+    sortStats.MismatchCount = 0u;
+    for ( u32 cmdIdx = 0u; cmdIdx < drawCmdCount; cmdIdx++ ) {
+        if ( serialDrawCmds[cmdIdx].infos.instanceCount != sortedDrawCmds[cmdIdx].infos.instanceCount ) {
+            sortStats.MismatchCount++;
+        }
+    }
+
+    if ( sortStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Draw command sort mismatch (%u draw command(s) differ)!\n", sortStats.MismatchCount );
+    }
+
+    // Timings (both implementations sort the same unsorted commands).
+    Timer sortTimer;
+    sortTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        memcpy( serialDrawCmds, drawCmds, sizeof( DrawCmd ) * drawCmdCount );
+        DrawCommandSorter::SortSerial( serialDrawCmds, tempDrawCmds, drawCmdCount );
+    }
+    sortStats.SerialSortTime = sortTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount );
+
+    sortTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        memcpy( serialDrawCmds, drawCmds, sizeof( DrawCmd ) * drawCmdCount );
+        drawCmdSorter->sort( serialDrawCmds, drawCmdCount );
+    }
+    sortStats.ParallelSortTime = sortTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount );
+
+    // Translucent commands (same count; a few materials; random full precision depth). Compared to the opaque path
+    // above, the sort also includes the back to front secondary sort.
+    for ( u32 cmdIdx = 0u; cmdIdx < drawCmdCount; cmdIdx++ ) {
+        DrawCmd& drawCmd = drawCmds[cmdIdx];
+        auto& key = drawCmd.key.bitfield;
+        key.materialSortKey = static_cast< u32 >( NextRandomFloat( seed ) * 32.0f );
+        key.depth = 0u;
+        key.sortOrder = DrawCommandKey::SORT_BACK_TO_FRONT;
+        key.layer = DrawCommandKey::LAYER_TRANSLUCENT;
+
+        drawCmd.depthKey = static_cast< u32 >( NextRandomFloat( seed ) * 4294967040.0f );
+        drawCmd.infos.instanceCount = cmdIdx;
+    }
+
+    sortedDrawCmds = drawCmdSorter->sort( drawCmds, drawCmdCount );
+
+    sortStats.TranslucentMismatchCount = 0u;
+    for ( u32 cmdIdx = 1u; cmdIdx < drawCmdCount; cmdIdx++ ) {
+        if ( sortedDrawCmds[cmdIdx - 1u].depthKey > sortedDrawCmds[cmdIdx].depthKey ) {
+            sortStats.TranslucentMismatchCount++;
+        }
+    }
+
+    if ( sortStats.TranslucentMismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Translucent draw command sort mismatch (%u draw command(s) are not sorted back to front)!\n", sortStats.TranslucentMismatchCount );
+    }
+
+    sortTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        memcpy( serialDrawCmds, drawCmds, sizeof( DrawCmd ) * drawCmdCount );
+        drawCmdSorter->sort( serialDrawCmds, drawCmdCount );
+    }
+    sortStats.TranslucentSortTime = sortTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount );
+
+    DUSK_LOG_INFO( "Draw command sort: serial %f ms/sort; parallel %f ms/sort; translucent %f ms/sort\n", sortStats.SerialSortTime, sortStats.ParallelSortTime, sortStats.TranslucentSortTime );
+
+    dk::core::free( g_GlobalAllocator, drawCmdSorter );
+    dk::core::freeArray( g_GlobalAllocator, tempDrawCmds );
+    dk::core::freeArray( g_GlobalAllocator, serialDrawCmds );
+    dk::core::freeArray( g_GlobalAllocator, drawCmds );
+}
+
+void WriteSortReport( std::stringstream& report, const BenchmarkSortStats& sortStats )
+{
+    report << "  \"drawSort\": {\n";
+    report << "    \"drawCmdCount\": " << sortStats.DrawCmdCount << ",\n";
+    report << "    \"serialMsPerSort\": " << sortStats.SerialSortTime << ",\n";
+    report << "    \"parallelMsPerSort\": " << sortStats.ParallelSortTime << ",\n";
+    report << "    \"mismatchCount\": " << sortStats.MismatchCount << ",\n";
+    report << "    \"translucentMsPerSort\": " << sortStats.TranslucentSortTime << ",\n";
+    report << "    \"translucentMismatchCount\": " << sortStats.TranslucentMismatchCount << "\n";
+    report << "  },\n";
+}
@@ -0,0 +1,35 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkSortStats
+{
+    // Number of draw commands per sort.
+    u32                     DrawCmdCount;
+
+    // Average time of a sort using the serial implementation (in milliseconds).
+    f64                     SerialSortTime;
+
+    // Average time of a sort using the parallel implementation (in milliseconds).
+    f64                     ParallelSortTime;
+
+    // Number of draw commands whose position differs between both implementations.
+    u32                     MismatchCount;
+
+    // Average time of a sort of translucent commands (parallel implementation + back to front secondary sort; in
+    // milliseconds).
+    f64                     TranslucentSortTime;
+
+    // Number of translucent draw commands which are not sorted back to front.
+    u32                     TranslucentMismatchCount;
+};
+
+// Run the draw command sort microbenchmark (the parallel sort output is checked against the serial sort; translucent draw commands must be sorted back to front).
+void RunSortMicrobenchmark( BenchmarkSortStats& sortStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'drawSort').
+void WriteSortReport( std::stringstream& report, const BenchmarkSortStats& sortStats );
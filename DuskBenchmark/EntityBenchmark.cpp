@@ -0,0 +1,124 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "EntityBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Framework/EntityDatabase.h"
+
+DUSK_ENV_VAR( BenchmarkEntityCount, 8192, u32 ); // "Number of entities allocated per iteration by the entity allocation microbenchmark"
+DUSK_ENV_VAR( BenchmarkEntityIterationCount, 256, u32 ); // "Number of allocation/release cycles executed by the entity allocation microbenchmark"
+
+void RunEntityMicrobenchmark( BenchmarkEntityStats& entityStats )
+{
+    const u32 entityCount = Max( BenchmarkEntityCount, 1u );
+    const u32 iterationCount = Max( BenchmarkEntityIterationCount, 1u );
+
+    DUSK_LOG_INFO( "Running entity allocation microbenchmark (%u entities; %u iteration(s))...\n", entityCount, iterationCount );
+
+    // Entities are constantly respawned (e.g. traffic): each iteration releases the entities of the previous one.
+    const u32 entityCapacity = entityCount * 2u + EntityDatabase::MIN_FREE_INDEX_COUNT;
+
+    EntityDatabase* entityDatabases[2];
+    Entity* aliveEntities[2];
+    for ( u32 dbIdx = 0u; dbIdx < 2u; dbIdx++ ) {
+        entityDatabases[dbIdx] = dk::core::allocate<EntityDatabase>( g_GlobalAllocator, g_GlobalAllocator );
+        entityDatabases[dbIdx]->create( entityCapacity );
+
+        aliveEntities[dbIdx] = dk::core::allocateArray<Entity>( g_GlobalAllocator, entityCount );
+    }
+
+    // Entities allocated by the first iteration (must never be alive again).
+    Entity* staleEntities = dk::core::allocateArray<Entity>( g_GlobalAllocator, entityCount );
+
+    entityStats.EntityCount = entityCount;
+    entityStats.MismatchCount = 0u;
+
+    f64 allocationTimeSum[2] = { 0.0, 0.0 };
+    f64 releaseTimeSum[2] = { 0.0, 0.0 };
+
+    Timer benchmarkTimer;
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        // Allocation (one by one, then in bulk).
+        benchmarkTimer.reset();
+        for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+            aliveEntities[0][entityIdx] = entityDatabases[0]->allocateEntity();
+        }
+        allocationTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        entityDatabases[1]->allocateEntities( aliveEntities[1], entityCount );
+        allocationTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        // Correctness: both paths must allocate the same handles; stale handles must be detected.
+        for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+            const Entity& entity = aliveEntities[1][entityIdx];
+            if ( entity.getIdentifier() != aliveEntities[0][entityIdx].getIdentifier() || !entityDatabases[1]->isEntityAlive( entity ) ) {
+                entityStats.MismatchCount++;
+            }
+
+            if ( iterationIdx != 0u && entityDatabases[1]->isEntityAlive( staleEntities[entityIdx] ) ) {
+                entityStats.MismatchCount++;
+            }
+        }
+
+        if ( iterationIdx == 0u ) {
+            memcpy( staleEntities, aliveEntities[1], sizeof( Entity ) * entityCount );
+        }
+
+        // Release (one by one, then in bulk).
+        benchmarkTimer.reset();
+        for ( u32 entityIdx = 0u; entityIdx < entityCount; entityIdx++ ) {
+            entityDatabases[0]->releaseEntity( aliveEntities[0][entityIdx] );
+        }
+        releaseTimeSum[0] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        benchmarkTimer.reset();
+        entityDatabases[1]->releaseEntities( aliveEntities[1], entityCount );
+        releaseTimeSum[1] += benchmarkTimer.getElapsedTimeAsMiliseconds();
+    }
+
+    if ( entityDatabases[1]->getAliveEntityCount() != 0u ) {
+        entityStats.MismatchCount++;
+    }
+
+    const f64 iterationCountF64 = static_cast< f64 >( iterationCount );
+    for ( u32 implIdx = 0u; implIdx < 2u; implIdx++ ) {
+        entityStats.AllocationTime[implIdx] = allocationTimeSum[implIdx] / iterationCountF64;
+        entityStats.ReleaseTime[implIdx] = releaseTimeSum[implIdx] / iterationCountF64;
+    }
+    entityStats.RetiredIndexCount = entityDatabases[1]->getRetiredIndexCount();
+
+    if ( entityStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Entity allocation mismatch (%u stale or invalid handle(s))!\n", entityStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Entity allocation (single/bulk): allocation %f/%f ms; release %f/%f ms; %u retired index(es)\n",
+                   entityStats.AllocationTime[0], entityStats.AllocationTime[1], entityStats.ReleaseTime[0], entityStats.ReleaseTime[1], entityStats.RetiredIndexCount );
+
+    dk::core::freeArray( g_GlobalAllocator, staleEntities );
+    for ( u32 dbIdx = 0u; dbIdx < 2u; dbIdx++ ) {
+        dk::core::freeArray( g_GlobalAllocator, aliveEntities[dbIdx] );
+        dk::core::free( g_GlobalAllocator, entityDatabases[dbIdx] );
+    }
+}
+
+void WriteEntityReport( std::stringstream& report, const BenchmarkEntityStats& entityStats )
+{
+    report << "  \"entityAllocation\": {\n";
+    report << "    \"entityCount\": " << entityStats.EntityCount << ",\n";
+    report << "    \"singleAllocationMs\": " << entityStats.AllocationTime[0] << ",\n";
+    report << "    \"bulkAllocationMs\": " << entityStats.AllocationTime[1] << ",\n";
+    report << "    \"singleReleaseMs\": " << entityStats.ReleaseTime[0] << ",\n";
+    report << "    \"bulkReleaseMs\": " << entityStats.ReleaseTime[1] << ",\n";
+    report << "    \"retiredIndexCount\": " << entityStats.RetiredIndexCount << ",\n";
+    report << "    \"mismatchCount\": " << entityStats.MismatchCount << "\n";
+    report << "  },\n";
+}
@@ -0,0 +1,31 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkEntityStats
+{
+    // Number of entities allocated (then released) per iteration.
+    u32                     EntityCount;
+
+    // Average time to allocate the entities one by one and in bulk (in milliseconds).
+    f64                     AllocationTime[2];
+
+    // Average time to release the entities one by one and in bulk (in milliseconds).
+    f64                     ReleaseTime[2];
+
+    // Number of indices retired by the bulk database (generation exhausted).
+    u32                     RetiredIndexCount;
+
+    // Number of released (stale) entities reported alive, or alive entities reported dead.
+    u32                     MismatchCount;
+};
+
+// Run the entity allocation microbenchmark (stale handles must never be alive again).
+void RunEntityMicrobenchmark( BenchmarkEntityStats& entityStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'entityAllocation').
+void WriteEntityReport( std::stringstream& report, const BenchmarkEntityStats& entityStats );
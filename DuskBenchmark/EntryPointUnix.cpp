@@ -0,0 +1,25 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#if DUSK_UNIX
+#include <Shared.h>
+#include "Benchmark.h"
+
+// Application EntryPoint (Unix)
+i32 main( i32 argc, char** argv )
+{
+    DUSK_LOG_INITIALIZE;
+
+    // Concat the cmdline (to emulate Windows cmdline format)
+    std::string concatCmdLine;
+    for ( int i = 1; i < argc; i++ ) {
+        concatCmdLine += argv[i];
+
+        if ( i != argc - 1 )
+            concatCmdLine += " ";
+    }
+
+    return dk::benchmark::Start( concatCmdLine.c_str() );
+}
+#endif
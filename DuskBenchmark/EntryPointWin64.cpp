@@ -0,0 +1,24 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#if DUSK_WIN
+#include <Shared.h>
+#include "Benchmark.h"
+
+// Application EntryPoint (Windows). The benchmark is a console application (so that CI runners can capture its output).
+int main( int argc, char** argv )
+{
+    DUSK_LOG_INITIALIZE;
+
+    std::string concatCmdLine;
+    for ( int i = 1; i < argc; i++ ) {
+        concatCmdLine += argv[i];
+
+        if ( i != argc - 1 )
+            concatCmdLine += " ";
+    }
+
+    return dk::benchmark::Start( concatCmdLine.c_str() );
+}
+#endif
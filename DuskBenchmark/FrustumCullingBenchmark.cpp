@@ -0,0 +1,105 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "FrustumCullingBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Framework/Cameras/FreeCamera.h"
+
+#include "Maths/FrustumCulling.h"
+#include "Maths/Helpers.h"
+
+DUSK_ENV_VAR( BenchmarkCullingSphereCount, 4096, u32 ); // "Number of bounding spheres tested by the frustum culling microbenchmark"
+DUSK_ENV_VAR( BenchmarkCullingIterationCount, 1000, u32 ); // "Number of culling passes (per camera) executed by the frustum culling microbenchmark"
+
+void RunCullingMicrobenchmark( const FreeCamera* cameras, const u32 cameraCount, const f32 worldExtent, BenchmarkCullingStats& cullingStats )
+{
+    const u32 sphereCount = Max( BenchmarkCullingSphereCount, 1u );
+    const u32 iterationCount = Max( BenchmarkCullingIterationCount, 1u );
+
+    DUSK_LOG_INFO( "Running frustum culling microbenchmark (%u sphere(s); %u camera(s); %u iteration(s))...\n", sphereCount, cameraCount, iterationCount );
+
+    BoundingSphereSoA spheres;
+    spheres.CenterX = dk::core::allocateArray<f32>( g_GlobalAllocator, sphereCount );
+    spheres.CenterY = dk::core::allocateArray<f32>( g_GlobalAllocator, sphereCount );
+    spheres.CenterZ = dk::core::allocateArray<f32>( g_GlobalAllocator, sphereCount );
+    spheres.Radius = dk::core::allocateArray<f32>( g_GlobalAllocator, sphereCount );
+
+    u32* scalarVisibleIndexes = dk::core::allocateArray<u32>( g_GlobalAllocator, sphereCount );
+    u32* simdVisibleIndexes = dk::core::allocateArray<u32>( g_GlobalAllocator, sphereCount );
+
+    u32 seed = 0xc0ffeeu;
+    for ( u32 sphereIdx = 0u; sphereIdx < sphereCount; sphereIdx++ ) {
+        spheres.CenterX[sphereIdx] = ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent;
+        spheres.CenterY[sphereIdx] = NextRandomFloat( seed ) * 16.0f;
+        spheres.CenterZ[sphereIdx] = ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * worldExtent;
+        spheres.Radius[sphereIdx] = 0.5f + NextRandomFloat( seed ) * 4.0f;
+    }
+
+    cullingStats.SphereCount = sphereCount;
+    cullingStats.VisibleCount = 0u;
+    cullingStats.MismatchCount = 0u;
+
+    // Correctness: both paths must return the same visible list.
+    for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+        const Frustum& frustum = cameras[cameraIdx].getData().frustum;
+
+        const u32 scalarVisibleCount = dk::maths::CullSpheresInfReversedZScalar( frustum, spheres, sphereCount, scalarVisibleIndexes );
+        const u32 simdVisibleCount = dk::maths::CullSpheresInfReversedZ( frustum, spheres, sphereCount, simdVisibleIndexes );
+
+        if ( scalarVisibleCount != simdVisibleCount
+          || memcmp( scalarVisibleIndexes, simdVisibleIndexes, sizeof( u32 ) * scalarVisibleCount ) != 0 ) {
+            DUSK_LOG_ERROR( "Frustum culling mismatch for camera %u (scalar: %u visible; SIMD: %u visible)!\n", cameraIdx, scalarVisibleCount, simdVisibleCount );
+            cullingStats.MismatchCount++;
+        }
+
+        cullingStats.VisibleCount += simdVisibleCount;
+    }
+
+    // Timings (the visible count is accumulated so that the calls can't be optimized away).
+    u32 visibleCountSum = 0u;
+
+    Timer cullingTimer;
+    cullingTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+            visibleCountSum += dk::maths::CullSpheresInfReversedZScalar( cameras[cameraIdx].getData().frustum, spheres, sphereCount, scalarVisibleIndexes );
+        }
+    }
+    cullingStats.ScalarPassTime = cullingTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount * cameraCount );
+
+    cullingTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+            visibleCountSum += dk::maths::CullSpheresInfReversedZ( cameras[cameraIdx].getData().frustum, spheres, sphereCount, simdVisibleIndexes );
+        }
+    }
+    cullingStats.SimdPassTime = cullingTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount * cameraCount );
+
+    DUSK_LOG_INFO( "Frustum culling: scalar %f ms/pass; SIMD %f ms/pass (%u visible)\n", cullingStats.ScalarPassTime, cullingStats.SimdPassTime, visibleCountSum );
+
+    dk::core::freeArray( g_GlobalAllocator, simdVisibleIndexes );
+    dk::core::freeArray( g_GlobalAllocator, scalarVisibleIndexes );
+    dk::core::freeArray( g_GlobalAllocator, spheres.Radius );
+    dk::core::freeArray( g_GlobalAllocator, spheres.CenterZ );
+    dk::core::freeArray( g_GlobalAllocator, spheres.CenterY );
+    dk::core::freeArray( g_GlobalAllocator, spheres.CenterX );
+}
+
+void WriteCullingReport( std::stringstream& report, const BenchmarkCullingStats& cullingStats )
+{
+    report << "  \"culling\": {\n";
+    report << "    \"sphereCount\": " << cullingStats.SphereCount << ",\n";
+    report << "    \"visibleCount\": " << cullingStats.VisibleCount << ",\n";
+    report << "    \"scalarMsPerPass\": " << cullingStats.ScalarPassTime << ",\n";
+    report << "    \"simdMsPerPass\": " << cullingStats.SimdPassTime << ",\n";
+    report << "    \"mismatchCount\": " << cullingStats.MismatchCount << "\n";
+    report << "  },\n";
+}
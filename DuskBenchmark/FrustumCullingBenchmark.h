@@ -0,0 +1,34 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class FreeCamera;
+
+#include <sstream>
+
+struct BenchmarkCullingStats
+{
+    // Number of spheres tested per culling pass.
+    u32                     SphereCount;
+
+    // Number of visible spheres (summed for every camera).
+    u32                     VisibleCount;
+
+    // Average time of a culling pass using the scalar path (in milliseconds).
+    f64                     ScalarPassTime;
+
+    // Average time of a culling pass using the SIMD path (in milliseconds).
+    f64                     SimdPassTime;
+
+    // Number of culling passes whose SIMD output does not match the scalar output.
+    u32                     MismatchCount;
+};
+
+// Run the frustum culling microbenchmark (the SIMD path output is checked against the scalar path). The spheres are
+// spread over the [-worldExtent..worldExtent] range (on the XZ plane).
+void RunCullingMicrobenchmark( const FreeCamera* cameras, const u32 cameraCount, const f32 worldExtent, BenchmarkCullingStats& cullingStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'culling').
+void WriteCullingReport( std::stringstream& report, const BenchmarkCullingStats& cullingStats );
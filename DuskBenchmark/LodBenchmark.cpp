@@ -0,0 +1,129 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "LodBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Graphics/Model.h"
+
+#include "Maths/Helpers.h"
+
+DUSK_ENV_VAR( BenchmarkLodInstanceCount, 1024, u32 ); // "Number of instances (placed around the LOD thresholds) of the LOD selection microbenchmark"
+DUSK_ENV_VAR( BenchmarkLodFrameCount, 256, u32 ); // "Number of frames (with camera jitter) simulated by the LOD selection microbenchmark"
+
+void RunLodMicrobenchmark( const f32 viewportHeight, BenchmarkLodStats& lodStats )
+{
+    const u32 instanceCount = Max( BenchmarkLodInstanceCount, 1u );
+    const u32 frameCount = Max( BenchmarkLodFrameCount, 2u );
+
+    constexpr f32 MAX_ERROR_IN_PIXELS = 1.0f;
+    constexpr f32 HYSTERESIS = 0.2f;
+
+    // Maximum camera offset per frame (relative to the distance between the camera and the instance). Must stay within
+    // the hysteresis band for the selection to be stable.
+    constexpr f32 CAMERA_JITTER = 0.05f;
+
+    // Hand-built model: each LOD doubles the error of the previous one.
+    Model* model = dk::core::allocate<Model>( g_GlobalAllocator, g_GlobalAllocator, DUSK_STRING( "BenchmarkLodModel" ) );
+    model->addLevelOfDetail( std::numeric_limits<f32>::max(), 0.0f );
+    model->addLevelOfDetail( std::numeric_limits<f32>::max(), 0.01f );
+    model->addLevelOfDetail( std::numeric_limits<f32>::max(), 0.02f );
+    model->addLevelOfDetail( std::numeric_limits<f32>::max(), 0.04f );
+
+    DUSK_LOG_INFO( "Running LOD selection microbenchmark (%u instance(s); %u frame(s))...\n", instanceCount, frameCount );
+
+    // Size (in pixels) of one world unit at one world unit from the camera (90 degrees vertical fov).
+    const f32 projectionScale = viewportHeight / ( 2.0f * tanf( dk::maths::radians( 90.0f ) * 0.5f ) );
+
+    // Place each instance close to the distance at which a LOD switch happens.
+    const i32 lodCount = model->getLevelOfDetailCount();
+    f32* instanceDistances = dk::core::allocateArray<f32>( g_GlobalAllocator, instanceCount );
+    u32* previousLods = dk::core::allocateArray<u32>( g_GlobalAllocator, instanceCount );
+    u32* previousLodsWithHysteresis = dk::core::allocateArray<u32>( g_GlobalAllocator, instanceCount );
+
+    u32 seed = 0x1337u;
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        const u32 lodIdx = 1u + ( instanceIdx % static_cast< u32 >( lodCount - 1 ) );
+        const f32 switchDistance = model->getLevelOfDetailByIndex( lodIdx ).GeometricError * projectionScale / MAX_ERROR_IN_PIXELS;
+
+        instanceDistances[instanceIdx] = switchDistance * ( 1.0f + ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * 0.01f );
+        previousLods[instanceIdx] = Model::INVALID_LOD_INDEX;
+        previousLodsWithHysteresis[instanceIdx] = Model::INVALID_LOD_INDEX;
+    }
+
+    lodStats.InstanceCount = instanceCount;
+    lodStats.SwitchCountWithoutHysteresis = 0u;
+    lodStats.SwitchCountWithHysteresis = 0u;
+    lodStats.MismatchCount = 0u;
+
+    Timer lodTimer;
+    f64 selectionTimeSum = 0.0;
+    for ( u32 frameIdx = 0u; frameIdx < frameCount; frameIdx++ ) {
+        // The camera jitters along the view axis (the worst case for the selection stability).
+        const f32 cameraOffset = ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * CAMERA_JITTER;
+
+        lodTimer.reset();
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            const f32 pixelsPerUnit = projectionScale / ( instanceDistances[instanceIdx] * ( 1.0f + cameraOffset ) );
+
+            const u32 lodIdx = model->selectLevelOfDetail( pixelsPerUnit, 0.0f, MAX_ERROR_IN_PIXELS, HYSTERESIS, previousLodsWithHysteresis[instanceIdx] );
+            if ( frameIdx > 0u && lodIdx != previousLodsWithHysteresis[instanceIdx] ) {
+                lodStats.SwitchCountWithHysteresis++;
+            }
+            previousLodsWithHysteresis[instanceIdx] = lodIdx;
+        }
+        selectionTimeSum += lodTimer.getElapsedTimeAsMiliseconds();
+
+        for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+            const f32 pixelsPerUnit = projectionScale / ( instanceDistances[instanceIdx] * ( 1.0f + cameraOffset ) );
+
+            const u32 lodIdx = model->selectLevelOfDetail( pixelsPerUnit, 0.0f, MAX_ERROR_IN_PIXELS, 0.0f, previousLods[instanceIdx] );
+            if ( frameIdx > 0u && lodIdx != previousLods[instanceIdx] ) {
+                lodStats.SwitchCountWithoutHysteresis++;
+            }
+            previousLods[instanceIdx] = lodIdx;
+
+            // The selected LOD must stay within the band (and the next cheaper LOD must be outside of the band).
+            const u32 selectedLodIdx = previousLodsWithHysteresis[instanceIdx];
+            const f32 selectedError = model->getLevelOfDetailByIndex( selectedLodIdx ).GeometricError * pixelsPerUnit;
+            const bool isTooCoarse = ( selectedError > MAX_ERROR_IN_PIXELS * ( 1.0f + HYSTERESIS ) );
+            const bool isTooFine = ( ( selectedLodIdx + 1u ) < static_cast< u32 >( lodCount )
+                                     && model->getLevelOfDetailByIndex( selectedLodIdx + 1u ).GeometricError * pixelsPerUnit <= MAX_ERROR_IN_PIXELS * ( 1.0f - HYSTERESIS ) );
+            if ( isTooCoarse || isTooFine ) {
+                lodStats.MismatchCount++;
+            }
+        }
+    }
+    lodStats.SelectionTime = selectionTimeSum / static_cast< f64 >( frameCount );
+
+    // The camera jitter is smaller than the hysteresis band: an instance must never switch LOD.
+    if ( lodStats.SwitchCountWithHysteresis != 0u ) {
+        DUSK_LOG_ERROR( "LOD selection is not stable under camera jitter (%u switch(es))!\n", lodStats.SwitchCountWithHysteresis );
+        lodStats.MismatchCount += lodStats.SwitchCountWithHysteresis;
+    }
+
+    DUSK_LOG_INFO( "LOD selection: %f ms/pass; %u switch(es) without hysteresis; %u switch(es) with hysteresis\n", lodStats.SelectionTime, lodStats.SwitchCountWithoutHysteresis, lodStats.SwitchCountWithHysteresis );
+
+    dk::core::freeArray( g_GlobalAllocator, previousLodsWithHysteresis );
+    dk::core::freeArray( g_GlobalAllocator, previousLods );
+    dk::core::freeArray( g_GlobalAllocator, instanceDistances );
+    dk::core::free( g_GlobalAllocator, model );
+}
+
+void WriteLodReport( std::stringstream& report, const BenchmarkLodStats& lodStats )
+{
+    report << "  \"lodSelection\": {\n";
+    report << "    \"instanceCount\": " << lodStats.InstanceCount << ",\n";
+    report << "    \"msPerPass\": " << lodStats.SelectionTime << ",\n";
+    report << "    \"switchCountWithoutHysteresis\": " << lodStats.SwitchCountWithoutHysteresis << ",\n";
+    report << "    \"switchCountWithHysteresis\": " << lodStats.SwitchCountWithHysteresis << ",\n";
+    report << "    \"mismatchCount\": " << lodStats.MismatchCount << "\n";
+    report << "  },\n";
+}
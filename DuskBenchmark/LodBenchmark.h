@@ -0,0 +1,32 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkLodStats
+{
+    // Number of instances whose LOD is selected every frame.
+    u32                     InstanceCount;
+
+    // Number of LOD switches without hysteresis (summed for every frame and instance).
+    u32                     SwitchCountWithoutHysteresis;
+
+    // Number of LOD switches with hysteresis (summed for every frame and instance).
+    u32                     SwitchCountWithHysteresis;
+
+    // Average time to select the LOD of every instance (in milliseconds).
+    f64                     SelectionTime;
+
+    // Number of selections outside of the hysteresis band or switching LOD under camera jitter.
+    u32                     MismatchCount;
+};
+
+// Run the LOD selection microbenchmark (the LOD selected with hysteresis must stay within the error band). The LOD
+// error is projected on a viewport of 'viewportHeight' pixels.
+void RunLodMicrobenchmark( const f32 viewportHeight, BenchmarkLodStats& lodStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'lodSelection').
+void WriteLodReport( std::stringstream& report, const BenchmarkLodStats& lodStats );
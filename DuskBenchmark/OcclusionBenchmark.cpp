@@ -0,0 +1,156 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "OcclusionBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Graphics/OcclusionBuffer.h"
+
+#include "Maths/Helpers.h"
+#include "Maths/MatrixTransformations.h"
+
+DUSK_ENV_VAR( BenchmarkOcclusionIterationCount, 1000, u32 ); // "Number of passes (rasterization + tests) executed by the occlusion culling microbenchmark"
+
+void RunOcclusionMicrobenchmark( BenchmarkOcclusionStats& occlusionStats )
+{
+    const u32 iterationCount = Max( BenchmarkOcclusionIterationCount, 1u );
+
+    // Hand-built scene: a wall (20 x 10 x 2 units) in front of the camera. The expected visibility of each occludee is
+    // known (occludees are placed far enough from the silhouette of the wall for the test to be resolution independent).
+    static constexpr u32 BOX_VERTEX_COUNT = 8u;
+    static constexpr u32 BOX_INDEX_COUNT = 36u;
+
+    const dkVec3f boxVertices[BOX_VERTEX_COUNT] = {
+        dkVec3f( -1.0f, -1.0f, -1.0f ), dkVec3f( 1.0f, -1.0f, -1.0f ), dkVec3f( 1.0f, 1.0f, -1.0f ), dkVec3f( -1.0f, 1.0f, -1.0f ),
+        dkVec3f( -1.0f, -1.0f, 1.0f ), dkVec3f( 1.0f, -1.0f, 1.0f ), dkVec3f( 1.0f, 1.0f, 1.0f ), dkVec3f( -1.0f, 1.0f, 1.0f ),
+    };
+
+    const u32 boxIndices[BOX_INDEX_COUNT] = {
+        0, 2, 1, 0, 3, 2, // -Z
+        4, 5, 6, 4, 6, 7, // +Z
+        0, 4, 7, 0, 7, 3, // -X
+        1, 2, 6, 1, 6, 5, // +X
+        0, 1, 5, 0, 5, 4, // -Y
+        3, 7, 6, 3, 6, 2, // +Y
+    };
+
+    OccluderMesh boxOccluder;
+    boxOccluder.Vertices = boxVertices;
+    boxOccluder.Indices = boxIndices;
+    boxOccluder.IndexCount = BOX_INDEX_COUNT;
+
+    const dkMat4x4f wallMatrix = dk::maths::MakeScaleMat( dkVec3f( 10.0f, 5.0f, 1.0f ), dk::maths::MakeTranslationMat( dkVec3f( 0.0f, 5.0f, 20.0f ) ) );
+
+    const dkVec3f eyePosition( 0.0f, 2.0f, 0.0f );
+    const dkMat4x4f viewMatrix = dk::maths::MakeLookAtMat( eyePosition, eyePosition + dkVec3f( 0.0f, 0.0f, 1.0f ), dkVec3f( 0.0f, 1.0f, 0.0f ) );
+    const dkMat4x4f projectionMatrix = dk::maths::MakeInfReversedZProj( dk::maths::radians( 90.0f ), 16.0f / 9.0f, 0.1f );
+    const dkMat4x4f viewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    struct Occludee
+    {
+        dkVec3f Center;
+        f32     Radius;
+        bool    IsOccluded;
+    };
+
+    static constexpr u32 MAX_OCCLUDEE_COUNT = 64u;
+    Occludee occludees[MAX_OCCLUDEE_COUNT];
+    u32 occludeeCount = 0u;
+
+    for ( i32 gridX = -3; gridX <= 3; gridX++ ) {
+        for ( i32 gridY = 1; gridY <= 4; gridY++ ) {
+            const f32 x = static_cast< f32 >( gridX ) * 2.0f;
+            const f32 y = static_cast< f32 >( gridY ) * 2.0f;
+
+            // Behind the wall.
+            occludees[occludeeCount++] = { dkVec3f( x, y, 40.0f ), 0.5f, true };
+
+            // In front of the wall.
+            occludees[occludeeCount++] = { dkVec3f( x, y, 10.0f ), 0.5f, false };
+        }
+    }
+
+    // Beside and above the wall.
+    occludees[occludeeCount++] = { dkVec3f( -40.0f, 4.0f, 40.0f ), 1.0f, false };
+    occludees[occludeeCount++] = { dkVec3f( 40.0f, 4.0f, 40.0f ), 1.0f, false };
+    occludees[occludeeCount++] = { dkVec3f( 0.0f, 36.0f, 40.0f ), 1.0f, false };
+
+    // Partially hidden by the wall.
+    occludees[occludeeCount++] = { dkVec3f( 21.0f, 4.0f, 40.0f ), 3.0f, false };
+
+    // Large enough to be visible around the wall.
+    occludees[occludeeCount++] = { dkVec3f( 0.0f, 4.0f, 60.0f ), 40.0f, false };
+
+    // Behind the camera and around the camera.
+    occludees[occludeeCount++] = { dkVec3f( 0.0f, 2.0f, -10.0f ), 1.0f, false };
+    occludees[occludeeCount++] = { eyePosition, 1.0f, false };
+
+    DUSK_LOG_INFO( "Running occlusion culling microbenchmark (%u occludee(s); %u iteration(s))...\n", occludeeCount, iterationCount );
+
+    OcclusionBuffer* occlusionBuffer = dk::core::allocate<OcclusionBuffer>( g_GlobalAllocator, g_GlobalAllocator );
+
+    // Correctness: each occludee must match its expected visibility.
+    occlusionBuffer->clear( viewProjectionMatrix );
+    occlusionBuffer->rasterizeOccluder( boxOccluder, wallMatrix );
+    occlusionBuffer->buildHierarchy();
+
+    occlusionStats.SphereCount = occludeeCount;
+    occlusionStats.OccludedCount = 0u;
+    occlusionStats.ExpectedOccludedCount = 0u;
+    occlusionStats.MismatchCount = 0u;
+    for ( u32 occludeeIdx = 0u; occludeeIdx < occludeeCount; occludeeIdx++ ) {
+        const Occludee& occludee = occludees[occludeeIdx];
+        const bool isOccluded = occlusionBuffer->isSphereOccluded( occludee.Center, occludee.Radius );
+
+        if ( isOccluded != occludee.IsOccluded ) {
+            DUSK_LOG_ERROR( "Occlusion culling mismatch for occludee %u (expected: %s)!\n", occludeeIdx, ( occludee.IsOccluded ) ? "occluded" : "visible" );
+            occlusionStats.MismatchCount++;
+        }
+
+        occlusionStats.OccludedCount += ( isOccluded ) ? 1u : 0u;
+        occlusionStats.ExpectedOccludedCount += ( occludee.IsOccluded ) ? 1u : 0u;
+    }
+
+    // Timings (the occluded count is accumulated so that the calls can't be optimized away).
+    u32 occludedCountSum = 0u;
+
+    Timer occlusionTimer;
+    occlusionTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        occlusionBuffer->clear( viewProjectionMatrix );
+        occlusionBuffer->rasterizeOccluder( boxOccluder, wallMatrix );
+        occlusionBuffer->buildHierarchy();
+    }
+    occlusionStats.RasterizationTime = occlusionTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount );
+
+    occlusionTimer.reset();
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        for ( u32 occludeeIdx = 0u; occludeeIdx < occludeeCount; occludeeIdx++ ) {
+            occludedCountSum += ( occlusionBuffer->isSphereOccluded( occludees[occludeeIdx].Center, occludees[occludeeIdx].Radius ) ) ? 1u : 0u;
+        }
+    }
+    occlusionStats.TestTime = occlusionTimer.getElapsedTimeAsMiliseconds() / static_cast< f64 >( iterationCount );
+
+    DUSK_LOG_INFO( "Occlusion culling: rasterization %f ms/pass; tests %f ms/pass (%u occluded)\n", occlusionStats.RasterizationTime, occlusionStats.TestTime, occludedCountSum );
+
+    dk::core::free( g_GlobalAllocator, occlusionBuffer );
+}
+
+void WriteOcclusionReport( std::stringstream& report, const BenchmarkOcclusionStats& occlusionStats )
+{
+    report << "  \"occlusion\": {\n";
+    report << "    \"sphereCount\": " << occlusionStats.SphereCount << ",\n";
+    report << "    \"occludedCount\": " << occlusionStats.OccludedCount << ",\n";
+    report << "    \"expectedOccludedCount\": " << occlusionStats.ExpectedOccludedCount << ",\n";
+    report << "    \"rasterizationMsPerPass\": " << occlusionStats.RasterizationTime << ",\n";
+    report << "    \"testMsPerPass\": " << occlusionStats.TestTime << ",\n";
+    report << "    \"mismatchCount\": " << occlusionStats.MismatchCount << "\n";
+    report << "  },\n";
+}
@@ -0,0 +1,34 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkOcclusionStats
+{
+    // Number of occludees tested per pass.
+    u32                     SphereCount;
+
+    // Number of occludees hidden by the occluders.
+    u32                     OccludedCount;
+
+    // Number of occludees expected to be hidden by the occluders.
+    u32                     ExpectedOccludedCount;
+
+    // Average time to rasterize the occluders and build the depth pyramid (in milliseconds).
+    f64                     RasterizationTime;
+
+    // Average time to test every occludee (in milliseconds).
+    f64                     TestTime;
+
+    // Number of occludees whose visibility does not match the expected visibility.
+    u32                     MismatchCount;
+};
+
+// Run the occlusion culling microbenchmark (the visibility of each occludee is checked against its expected visibility).
+void RunOcclusionMicrobenchmark( BenchmarkOcclusionStats& occlusionStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'occlusion').
+void WriteOcclusionReport( std::stringstream& report, const BenchmarkOcclusionStats& occlusionStats );
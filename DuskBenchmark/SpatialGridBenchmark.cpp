@@ -0,0 +1,169 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "SpatialGridBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/Timer.h"
+
+#include "Framework/Cameras/FreeCamera.h"
+#include "Framework/SpatialGrid.h"
+
+#include "Maths/AABB.h"
+#include "Maths/FrustumCulling.h"
+#include "Maths/Helpers.h"
+
+DUSK_ENV_VAR( BenchmarkSpatialInstanceCount, 50000, u32 ); // "Number of instances (spread over the whole grid) of the spatial grid microbenchmark"
+DUSK_ENV_VAR( BenchmarkSpatialIterationCount, 100, u32 ); // "Number of queries/updates (per camera) executed by the spatial grid microbenchmark"
+DUSK_ENV_VAR( BenchmarkSpatialMovingRatio, 0.1f, f32 ); // "Ratio of instances moved per update by the spatial grid microbenchmark [0..1]"
+
+void RunSpatialMicrobenchmark( FreeCamera* cameras, const u32 cameraCount, BenchmarkSpatialStats& spatialStats )
+{
+    const u32 instanceCount = Max( BenchmarkSpatialInstanceCount, 1u );
+    const u32 iterationCount = Max( BenchmarkSpatialIterationCount, 1u );
+    const u32 movingCount = Min( static_cast< u32 >( static_cast< f32 >( instanceCount ) * Max( BenchmarkSpatialMovingRatio, 0.0f ) ), instanceCount );
+
+    // Instances are spread over the whole grid (the world is much larger than the view distance).
+    constexpr f32 GRID_HALF_EXTENT = SpatialGrid::CELL_COUNT_PER_AXIS * SpatialGrid::CELL_SIZE * 0.5f;
+
+    // Distance (in world units) an instance can move per update.
+    constexpr f32 MAX_MOVE_DISTANCE = 8.0f;
+
+    DUSK_LOG_INFO( "Running spatial grid microbenchmark (%u instance(s); %u moving; %u camera(s); %u iteration(s))...\n", instanceCount, movingCount, cameraCount, iterationCount );
+
+    SpatialGrid* spatialGrid = dk::core::allocate<SpatialGrid>( g_GlobalAllocator, g_GlobalAllocator );
+    spatialGrid->create( instanceCount );
+
+    Entity* entities = dk::core::allocateArray<Entity>( g_GlobalAllocator, instanceCount );
+    u32* bruteForceVisibleIndexes = dk::core::allocateArray<u32>( g_GlobalAllocator, instanceCount );
+    u32* candidateIndexes = dk::core::allocateArray<u32>( g_GlobalAllocator, instanceCount );
+    bool* isCandidate = dk::core::allocateArray<bool>( g_GlobalAllocator, instanceCount, false );
+
+    u32 seed = 0xC0FFEEu;
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        const dkVec3f center( ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * GRID_HALF_EXTENT, NextRandomFloat( seed ) * 16.0f, ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * GRID_HALF_EXTENT );
+        const f32 halfExtent = 0.5f + NextRandomFloat( seed ) * 4.0f;
+
+        AABB bounds;
+        dk::maths::CreateAABB( bounds, center, dkVec3f( halfExtent, halfExtent, halfExtent ) );
+
+        entities[instanceIdx] = Entity( instanceIdx, 0u );
+        spatialGrid->allocateComponent( entities[instanceIdx], bounds );
+    }
+
+    spatialStats.InstanceCount = instanceCount;
+    spatialStats.VisibleCount = 0u;
+    spatialStats.CandidateCount = 0u;
+    spatialStats.MismatchCount = 0u;
+
+    f64 bruteForceTimeSum = 0.0;
+    f64 queryTimeSum = 0.0;
+    f64 updateTimeSum = 0.0;
+
+    Timer benchmarkTimer;
+    for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+        // Move some instances (a few of them are removed then reinserted to exercise the swap-remove path).
+        benchmarkTimer.reset();
+        for ( u32 movingIdx = 0u; movingIdx < movingCount; movingIdx++ ) {
+            Entity& entity = entities[Min( static_cast< u32 >( NextRandomFloat( seed ) * static_cast< f32 >( instanceCount ) ), instanceCount - 1u )];
+            const Instance instance = spatialGrid->lookup( entity );
+
+            const dkVec3f offset( ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * MAX_MOVE_DISTANCE, 0.0f, ( NextRandomFloat( seed ) * 2.0f - 1.0f ) * MAX_MOVE_DISTANCE );
+
+            AABB bounds = spatialGrid->getBounds( instance );
+            bounds.minPoint += offset;
+            bounds.maxPoint += offset;
+
+            if ( ( movingIdx & 63u ) == 0u ) {
+                spatialGrid->removeComponent( entity );
+                spatialGrid->allocateComponent( entity, bounds );
+            } else {
+                spatialGrid->setBounds( instance, bounds );
+            }
+        }
+        spatialGrid->updateCellBounds();
+        updateTimeSum += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+        for ( u32 cameraIdx = 0u; cameraIdx < cameraCount; cameraIdx++ ) {
+            const Frustum& frustum = cameras[cameraIdx].getData().frustum;
+
+            benchmarkTimer.reset();
+            u32 visibleCount = 0u;
+            for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+                if ( dk::maths::CullAABBInfReversedZ( frustum, spatialGrid->getBounds( Instance( instanceIdx ) ) ) > 0.0f ) {
+                    bruteForceVisibleIndexes[visibleCount++] = instanceIdx;
+                }
+            }
+            bruteForceTimeSum += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+            SpatialGrid::Query query;
+            query.ViewFrustum = &frustum;
+            query.Origin = dkVec3f::Zero;
+            query.Range = -1.0f;
+
+            benchmarkTimer.reset();
+            const u32 candidateCount = spatialGrid->query( &query, 1u, candidateIndexes );
+            queryTimeSum += benchmarkTimer.getElapsedTimeAsMiliseconds();
+
+            // Correctness: every visible instance must be returned by the grid query (once).
+            for ( u32 candidateIdx = 0u; candidateIdx < candidateCount; candidateIdx++ ) {
+                if ( isCandidate[candidateIndexes[candidateIdx]] ) {
+                    spatialStats.MismatchCount++;
+                }
+                isCandidate[candidateIndexes[candidateIdx]] = true;
+            }
+
+            for ( u32 visibleIdx = 0u; visibleIdx < visibleCount; visibleIdx++ ) {
+                if ( !isCandidate[bruteForceVisibleIndexes[visibleIdx]] ) {
+                    spatialStats.MismatchCount++;
+                }
+            }
+
+            for ( u32 candidateIdx = 0u; candidateIdx < candidateCount; candidateIdx++ ) {
+                isCandidate[candidateIndexes[candidateIdx]] = false;
+            }
+
+            if ( iterationIdx == 0u ) {
+                spatialStats.VisibleCount += visibleCount;
+                spatialStats.CandidateCount += candidateCount;
+            }
+        }
+    }
+
+    const f64 iterationCountF64 = static_cast< f64 >( iterationCount );
+    const f64 passCountF64 = static_cast< f64 >( iterationCount * Max( cameraCount, 1u ) );
+    spatialStats.BruteForceTime = bruteForceTimeSum / passCountF64;
+    spatialStats.QueryTime = queryTimeSum / passCountF64;
+    spatialStats.UpdateTime = updateTimeSum / iterationCountF64;
+
+    if ( spatialStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Spatial grid mismatch (%u visible instance(s) missing or duplicated)!\n", spatialStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Spatial grid: brute force %f ms/pass; query %f ms/pass (%u candidate(s) for %u visible); update %f ms\n",
+                   spatialStats.BruteForceTime, spatialStats.QueryTime, spatialStats.CandidateCount, spatialStats.VisibleCount, spatialStats.UpdateTime );
+
+    dk::core::freeArray( g_GlobalAllocator, isCandidate );
+    dk::core::freeArray( g_GlobalAllocator, candidateIndexes );
+    dk::core::freeArray( g_GlobalAllocator, bruteForceVisibleIndexes );
+    dk::core::freeArray( g_GlobalAllocator, entities );
+    dk::core::free( g_GlobalAllocator, spatialGrid );
+}
+
+void WriteSpatialReport( std::stringstream& report, const BenchmarkSpatialStats& spatialStats )
+{
+    report << "  \"spatialGrid\": {\n";
+    report << "    \"instanceCount\": " << spatialStats.InstanceCount << ",\n";
+    report << "    \"visibleCount\": " << spatialStats.VisibleCount << ",\n";
+    report << "    \"candidateCount\": " << spatialStats.CandidateCount << ",\n";
+    report << "    \"bruteForceMs\": " << spatialStats.BruteForceTime << ",\n";
+    report << "    \"queryMs\": " << spatialStats.QueryTime << ",\n";
+    report << "    \"updateMs\": " << spatialStats.UpdateTime << ",\n";
+    report << "    \"mismatchCount\": " << spatialStats.MismatchCount << "\n";
+    report << "  },\n";
+}
@@ -0,0 +1,35 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+class FreeCamera;
+
+#include <sstream>
+
+struct BenchmarkSpatialStats
+{
+    // Number of instances stored in the grid.
+    u32                     InstanceCount;
+
+    // Number of instances visible (brute force) and returned by the grid queries (summed for every camera).
+    u32                     VisibleCount;
+    u32                     CandidateCount;
+
+    // Average time to cull every instance (brute force) and to query the grid (in milliseconds; per camera).
+    f64                     BruteForceTime;
+    f64                     QueryTime;
+
+    // Average time to move the moving instances and refresh the cell bounds (in milliseconds).
+    f64                     UpdateTime;
+
+    // Number of visible instances missing from the grid query results.
+    u32                     MismatchCount;
+};
+
+// Run the spatial grid microbenchmark (the grid queries are checked against a brute force culling).
+void RunSpatialMicrobenchmark( FreeCamera* cameras, const u32 cameraCount, BenchmarkSpatialStats& spatialStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'spatialGrid').
+void WriteSpatialReport( std::stringstream& report, const BenchmarkSpatialStats& spatialStats );
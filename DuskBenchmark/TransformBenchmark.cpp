@@ -0,0 +1,129 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "TransformBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+#include "Core/JobSystem.h"
+#include "Core/Timer.h"
+
+#include "Framework/Transform.h"
+
+DUSK_ENV_VAR( BenchmarkTransformInstanceCount, 10000, u32 ); // "Number of instances of the transform update microbenchmark"
+DUSK_ENV_VAR( BenchmarkTransformIterationCount, 300, u32 ); // "Number of updates (per dirty ratio) executed by the transform update microbenchmark"
+
+void RunTransformMicrobenchmark( BenchmarkTransformStats& transformStats )
+{
+    const u32 instanceCount = Max( BenchmarkTransformInstanceCount, 1u );
+    const u32 iterationCount = Max( BenchmarkTransformIterationCount, 1u );
+
+    // Instances are chained by groups of HIERARCHY_DEPTH (each instance is the parent of the next one).
+    constexpr u32 HIERARCHY_DEPTH = 4u;
+    constexpr f32 DIRTY_RATIOS[3] = { 0.01f, 0.1f, 1.0f };
+
+    DUSK_LOG_INFO( "Running transform update microbenchmark (%u instance(s); %u iteration(s))...\n", instanceCount, iterationCount );
+
+    TransformDatabase* transformDatabase = dk::core::allocate<TransformDatabase>( g_GlobalAllocator, g_GlobalAllocator, g_JobSystem );
+    transformDatabase->create( instanceCount );
+
+    Entity* entities = dk::core::allocateArray<Entity>( g_GlobalAllocator, instanceCount );
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        entities[instanceIdx] = Entity( instanceIdx, 0u );
+        transformDatabase->allocateComponent( entities[instanceIdx] );
+    }
+
+    // Parent instances in reverse order (so that the instances have to be reordered by depth).
+    for ( u32 instanceIdx = instanceCount; instanceIdx-- > 0u; ) {
+        if ( ( instanceIdx % HIERARCHY_DEPTH ) != 0u ) {
+            transformDatabase->setParent( transformDatabase->lookup( entities[instanceIdx] ), transformDatabase->lookup( entities[instanceIdx - 1u] ) );
+        }
+    }
+
+    u32 seed = 0x1337u;
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        const Instance instance = transformDatabase->lookup( entities[instanceIdx] );
+        transformDatabase->setPosition( instance, dkVec3f( NextRandomFloat( seed ), NextRandomFloat( seed ), NextRandomFloat( seed ) ) );
+        transformDatabase->setRotation( instance, dkQuatf( dkVec3f( 0.0f, NextRandomFloat( seed ), 0.0f ) ) );
+    }
+    transformDatabase->update( 0.0f );
+
+    transformStats.InstanceCount = instanceCount;
+    transformStats.DepthCount = transformDatabase->getHierarchyDepthCount();
+
+    // Instances are reordered by the first update; lookup the instances once the hierarchy is stable.
+    Instance* instances = dk::core::allocateArray<Instance>( g_GlobalAllocator, instanceCount );
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        instances[instanceIdx] = transformDatabase->lookup( entities[instanceIdx] );
+    }
+
+    Timer updateTimer;
+    for ( u32 ratioIdx = 0u; ratioIdx < 3u; ratioIdx++ ) {
+        const u32 dirtyCount = Max( static_cast< u32 >( instanceCount * DIRTY_RATIOS[ratioIdx] ), 1u );
+
+        f64 updateTimeSum = 0.0;
+        for ( u32 iterationIdx = 0u; iterationIdx < iterationCount; iterationIdx++ ) {
+            // Spread the dirty instances over the whole database (roots and children).
+            for ( u32 dirtyIdx = 0u; dirtyIdx < dirtyCount; dirtyIdx++ ) {
+                const u32 instanceIdx = static_cast< u32 >( ( static_cast< u64 >( dirtyIdx ) * instanceCount ) / dirtyCount + iterationIdx ) % instanceCount;
+                transformDatabase->setPosition( instances[instanceIdx], dkVec3f( NextRandomFloat( seed ), NextRandomFloat( seed ), NextRandomFloat( seed ) ) );
+            }
+
+            updateTimer.reset();
+            transformDatabase->update( 0.0f );
+            updateTimeSum += updateTimer.getElapsedTimeAsMiliseconds();
+        }
+
+        transformStats.UpdateTime[ratioIdx] = updateTimeSum / static_cast< f64 >( iterationCount );
+    }
+
+    // Correctness: compare each world matrix to the reference computation (instances are created parent first).
+    dkMat4x4f* referenceWorldMatrices = dk::core::allocateArray<dkMat4x4f>( g_GlobalAllocator, instanceCount );
+
+    transformStats.MismatchCount = 0u;
+    for ( u32 instanceIdx = 0u; instanceIdx < instanceCount; instanceIdx++ ) {
+        const dkMat4x4f& localMatrix = transformDatabase->getLocalMatrix( instances[instanceIdx] );
+
+        const bool isRoot = ( ( instanceIdx % HIERARCHY_DEPTH ) == 0u );
+        referenceWorldMatrices[instanceIdx] = ( isRoot ) ? localMatrix : localMatrix * referenceWorldMatrices[instanceIdx - 1u];
+
+        const dkMat4x4f& worldMatrix = transformDatabase->getWorldMatrix( instances[instanceIdx] );
+        bool isMatching = true;
+        for ( i32 row = 0; row < 4; row++ ) {
+            for ( i32 column = 0; column < 4; column++ ) {
+                isMatching &= ( fabsf( worldMatrix[row][column] - referenceWorldMatrices[instanceIdx][row][column] ) <= 1e-4f );
+            }
+        }
+
+        if ( !isMatching ) {
+            transformStats.MismatchCount++;
+        }
+    }
+
+    if ( transformStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Transform update mismatch (%u world matrices differ from the reference)!\n", transformStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Transform update: %f ms (1%% dirty); %f ms (10%% dirty); %f ms (100%% dirty)\n", transformStats.UpdateTime[0], transformStats.UpdateTime[1], transformStats.UpdateTime[2] );
+
+    dk::core::freeArray( g_GlobalAllocator, referenceWorldMatrices );
+    dk::core::freeArray( g_GlobalAllocator, instances );
+    dk::core::freeArray( g_GlobalAllocator, entities );
+    dk::core::free( g_GlobalAllocator, transformDatabase );
+}
+
+void WriteTransformReport( std::stringstream& report, const BenchmarkTransformStats& transformStats )
+{
+    report << "  \"transforms\": {\n";
+    report << "    \"instanceCount\": " << transformStats.InstanceCount << ",\n";
+    report << "    \"depthCount\": " << transformStats.DepthCount << ",\n";
+    report << "    \"msPerUpdate1PctDirty\": " << transformStats.UpdateTime[0] << ",\n";
+    report << "    \"msPerUpdate10PctDirty\": " << transformStats.UpdateTime[1] << ",\n";
+    report << "    \"msPerUpdate100PctDirty\": " << transformStats.UpdateTime[2] << ",\n";
+    report << "    \"mismatchCount\": " << transformStats.MismatchCount << "\n";
+    report << "  },\n";
+}
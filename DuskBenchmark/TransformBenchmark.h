@@ -0,0 +1,28 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkTransformStats
+{
+    // Number of instances of the database.
+    u32                     InstanceCount;
+
+    // Number of depth levels of the hierarchy.
+    u32                     DepthCount;
+
+    // Average time of an update with 1%, 10% and 100% of the instances dirty (in milliseconds).
+    f64                     UpdateTime[3];
+
+    // Number of world matrices which don't match the reference (recursive) computation.
+    u32                     MismatchCount;
+};
+
+// Run the transform update microbenchmark (the world matrices are checked against a reference hierarchy computation).
+void RunTransformMicrobenchmark( BenchmarkTransformStats& transformStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'transforms').
+void WriteTransformReport( std::stringstream& report, const BenchmarkTransformStats& transformStats );
@@ -0,0 +1,104 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#include <Shared.h>
+#include "TransientAliasingBenchmark.h"
+
+#include "BenchmarkShared.h"
+
+#include "Core/Allocators/AllocationHelpers.h"
+#include "Core/Allocators/LinearAllocator.h"
+
+#include "Graphics/FrameGraph.h"
+
+#include "Rendering/RenderDevice.h"
+
+// Transient resource aliasing: lifetimes are expressed in pass indexes (the first and last pass are inclusive).
+void RunAliasingMicrobenchmark( BenchmarkAliasingStats& aliasingStats )
+{
+    DUSK_LOG_INFO( "Running transient resource aliasing check...\n" );
+
+    FrameGraphResources* resources = dk::core::allocate<FrameGraphResources>( g_GlobalAllocator, g_GlobalAllocator );
+
+    aliasingStats.MismatchCount = 0u;
+
+    // Buffers with non-overlapping lifetimes share the allocation of the largest one (4MB [0..1]; 2MB [2..3]; 4MB [4..5]).
+    BufferDesc bufferDesc;
+    bufferDesc.StrideInBytes = sizeof( u32 );
+    bufferDesc.BindFlags = RESOURCE_BIND_UNORDERED_ACCESS_VIEW | RESOURCE_BIND_SHADER_RESOURCE;
+    bufferDesc.Usage = RESOURCE_USAGE_DEFAULT;
+
+    bufferDesc.SizeInBytes = 4u << 20u;
+    resources->allocateBuffer( g_RenderDevice, 0, bufferDesc, 0u, 1u );
+
+    bufferDesc.SizeInBytes = 2u << 20u;
+    resources->allocateBuffer( g_RenderDevice, 1, bufferDesc, 2u, 3u );
+
+    bufferDesc.SizeInBytes = 4u << 20u;
+    resources->allocateBuffer( g_RenderDevice, 2, bufferDesc, 4u, 5u );
+
+    const FGTransientMemoryStats bufferMemoryStats = resources->getTransientMemoryStats();
+    aliasingStats.BufferMemoryWithoutAliasing = bufferMemoryStats.PeakMemoryWithoutAliasing;
+    aliasingStats.BufferMemoryWithAliasing = bufferMemoryStats.PeakMemoryWithAliasing;
+
+    if ( aliasingStats.BufferMemoryWithoutAliasing != ( 10ull << 20ull ) ) {
+        aliasingStats.MismatchCount++;
+    }
+
+    if ( aliasingStats.BufferMemoryWithAliasing != ( 4ull << 20ull ) ) {
+        aliasingStats.MismatchCount++;
+    }
+
+    // Identical images with non-overlapping lifetimes share the same allocation; an image requesting per-mip views
+    // can't alias an image without them.
+    ImageDesc imageDesc;
+    imageDesc.dimension = ImageDesc::DIMENSION_2D;
+    imageDesc.format = VIEW_FORMAT_R32G32B32A32_FLOAT;
+    imageDesc.width = 256u;
+    imageDesc.height = 256u;
+    imageDesc.mipCount = 1u;
+    imageDesc.bindFlags = RESOURCE_BIND_RENDER_TARGET_VIEW | RESOURCE_BIND_SHADER_RESOURCE;
+    imageDesc.usage = RESOURCE_USAGE_DEFAULT;
+
+    const u64 imageFootprint = ImageDesc::GetMemoryFootprint( imageDesc );
+
+    resources->allocateImage( g_RenderDevice, 0, imageDesc, 0u, 0u, 1u );
+    resources->allocateImage( g_RenderDevice, 1, imageDesc, 0u, 2u, 3u );
+    resources->allocateImage( g_RenderDevice, 2, imageDesc, FrameGraphBuilder::REQUEST_PER_MIP_RESOURCE_VIEW, 4u, 5u );
+
+    const FGTransientMemoryStats memoryStats = resources->getTransientMemoryStats();
+    aliasingStats.ImageMemoryWithoutAliasing = memoryStats.PeakMemoryWithoutAliasing - bufferMemoryStats.PeakMemoryWithoutAliasing;
+    aliasingStats.ImageMemoryWithAliasing = memoryStats.PeakMemoryWithAliasing - bufferMemoryStats.PeakMemoryWithAliasing;
+
+    if ( aliasingStats.ImageMemoryWithoutAliasing != imageFootprint * 3ull ) {
+        aliasingStats.MismatchCount++;
+    }
+
+    if ( aliasingStats.ImageMemoryWithAliasing != imageFootprint * 2ull ) {
+        aliasingStats.MismatchCount++;
+    }
+
+    if ( aliasingStats.MismatchCount != 0u ) {
+        DUSK_LOG_ERROR( "Transient resource aliasing mismatch (%u unexpected memory footprint(s))!\n", aliasingStats.MismatchCount );
+    }
+
+    DUSK_LOG_INFO( "Transient aliasing: buffers %llu/%llu bytes; images %llu/%llu bytes (with/without aliasing)\n",
+                   aliasingStats.BufferMemoryWithAliasing, aliasingStats.BufferMemoryWithoutAliasing,
+                   aliasingStats.ImageMemoryWithAliasing, aliasingStats.ImageMemoryWithoutAliasing );
+
+    resources->unacquireResources( g_RenderDevice );
+    resources->releaseResources( g_RenderDevice );
+    dk::core::free( g_GlobalAllocator, resources );
+}
+
+void WriteAliasingReport( std::stringstream& report, const BenchmarkAliasingStats& aliasingStats )
+{
+    report << "  \"transientAliasing\": {\n";
+    report << "    \"bufferBytesWithoutAliasing\": " << aliasingStats.BufferMemoryWithoutAliasing << ",\n";
+    report << "    \"bufferBytesWithAliasing\": " << aliasingStats.BufferMemoryWithAliasing << ",\n";
+    report << "    \"imageBytesWithoutAliasing\": " << aliasingStats.ImageMemoryWithoutAliasing << ",\n";
+    report << "    \"imageBytesWithAliasing\": " << aliasingStats.ImageMemoryWithAliasing << ",\n";
+    report << "    \"mismatchCount\": " << aliasingStats.MismatchCount << "\n";
+    report << "  },\n";
+}
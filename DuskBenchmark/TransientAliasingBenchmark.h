@@ -0,0 +1,28 @@
+/*
+    Dusk Source Code
+    Copyright (C) 2020 Prevost Baptiste
+*/
+#pragma once
+
+#include <sstream>
+
+struct BenchmarkAliasingStats
+{
+    // Memory required by the buffers of the check (with and without aliasing; in bytes).
+    u64                     BufferMemoryWithoutAliasing;
+    u64                     BufferMemoryWithAliasing;
+
+    // Memory required by the images of the check (with and without aliasing; in bytes).
+    u64                     ImageMemoryWithoutAliasing;
+    u64                     ImageMemoryWithAliasing;
+
+    // Number of memory footprints which do not match the expected aliasing.
+    u32                     MismatchCount;
+};
+
+// Run the transient resource aliasing check (the memory footprints of the FrameGraph transient pools are checked against
+// the expected aliasing).
+void RunAliasingMicrobenchmark( BenchmarkAliasingStats& aliasingStats );
+
+// Append the stats of the microbenchmark to the benchmark report (JSON object named 'transientAliasing').
+void WriteAliasingReport( std::stringstream& report, const BenchmarkAliasingStats& aliasingStats );
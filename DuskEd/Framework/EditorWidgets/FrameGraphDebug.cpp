@@ -16,6 +16,8 @@
 #include "Core/Environment.h"
 #include "Core/StringHelpers.h"
 
+#include <algorithm>
+
 // Test a bit in a given bitfield. If the bit is set, append flagAsString to the builtString.
 template<u32 BitToTest>
 static DUSK_INLINE void TestAndAppendFlagToString( std::string& builtString, const u32 bitfield, const char* bitValueAsString )
@@ -146,6 +148,14 @@ void FrameGraphDebugWidget::displayEditorWindow( const FrameGraph* frameGraph )
 	std::vector<FGImageInfosEditor> imageInfos;
 	frameGraph->retrieveImageEditorInfos( imageInfos );
 
+	std::vector<FGRenderPassScheduleInfosEditor> scheduleInfos;
+	frameGraph->retrieveScheduleEditorInfos( scheduleInfos );
+
+	// Display the RenderPasses in the order they have started recording.
+	std::sort( scheduleInfos.begin(), scheduleInfos.end(), []( const FGRenderPassScheduleInfosEditor& left, const FGRenderPassScheduleInfosEditor& right ) {
+		return left.DispatchOrder < right.DispatchOrder;
+	} );
+
 	if ( ImGui::Begin( "FrameGraph Infos", &isOpen ) ) {
 		ImGui::Text( "MSAA Sampler Count: %u", frameGraphInstance->getMSAASamplerCount() );
 		ImGui::Text( "Image Quality: %f", frameGraphInstance->getImageQuality() );
@@ -161,6 +171,28 @@ void FrameGraphDebugWidget::displayEditorWindow( const FrameGraph* frameGraph )
 			}
 		}
 
+		ImGui::Separator();
+		if ( ImGui::TreeNode( "Dispatch Order" ) ) {
+			ImGui::Columns( 5, "DispatchOrderColumns" );
+			ImGui::Text( "RenderPass" ); ImGui::NextColumn();
+			ImGui::Text( "Critical Path (ms)" ); ImGui::NextColumn();
+			ImGui::Text( "CPU (ms)" ); ImGui::NextColumn();
+			ImGui::Text( "GPU (ms)" ); ImGui::NextColumn();
+			ImGui::Text( "Queue" ); ImGui::NextColumn();
+			ImGui::Separator();
+
+			for ( const FGRenderPassScheduleInfosEditor& passScheduleInfos : scheduleInfos ) {
+				ImGui::Text( "%u. %s", passScheduleInfos.DispatchOrder, passScheduleInfos.Name ); ImGui::NextColumn();
+				ImGui::Text( "%.3f", passScheduleInfos.CriticalPathLength ); ImGui::NextColumn();
+				ImGui::Text( "%.3f", passScheduleInfos.CpuTime ); ImGui::NextColumn();
+				ImGui::Text( "%.3f", passScheduleInfos.GpuTime ); ImGui::NextColumn();
+				ImGui::Text( "%s", ( passScheduleInfos.UseAsyncCompute ) ? "Compute" : "Graphics" ); ImGui::NextColumn();
+			}
+
+			ImGui::Columns( 1 );
+			ImGui::TreePop();
+		}
+
 		ImGui::Separator();
 		if ( ImGui::TreeNode( "Buffers" ) ) {
 			u32 bufferIdx = 0u;
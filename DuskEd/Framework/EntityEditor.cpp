@@ -312,6 +312,7 @@ void EntityEditor::displayStaticGeometrySection()
                     
                     if ( builtModel != nullptr ) {
                         staticGeoDb->setModel( staticGeoDb->lookup( *activeEntity ), builtModel );
+                        activeWorld->updateRenderableBounds( *activeEntity );
                     }
                 }
             }
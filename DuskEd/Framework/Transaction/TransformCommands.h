@@ -11,6 +11,7 @@ class TranslateCommand : public TransactionCommand
 public:
     TranslateCommand( TransformDatabase::EdInstanceData* transformToEdit, const dkVec3f& newValue, const dkVec3f& oldValue )
         : translationToEdit( transformToEdit->Position )
+        , dirtyFlags( transformToEdit->DirtyFlags )
         , translation( newValue )
         , previousTranslation( oldValue )
     {
@@ -20,15 +21,18 @@ public:
     virtual void execute() override
     {
 		*translationToEdit = translation;
+        *dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
     }
 
     virtual void undo() override
     {
         *translationToEdit = previousTranslation;
+        *dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
     }
 
 private:
     dkVec3f*	translationToEdit;
+    u8*         dirtyFlags;
 
     dkVec3f		translation;
     dkVec3f		previousTranslation;
@@ -39,6 +43,7 @@ class RotateCommand : public TransactionCommand
 public:
 	RotateCommand( TransformDatabase::EdInstanceData* transformToEdit, const dkQuatf& newValue, const dkQuatf& oldValue )
 		: rotationToEdit( transformToEdit->Rotation )
+		, dirtyFlags( transformToEdit->DirtyFlags )
 		, rotation( newValue )
 		, previousRotation( oldValue )
 	{
@@ -48,15 +53,18 @@ public:
 	virtual void execute() override
 	{
 		*rotationToEdit = rotation;
+		*dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
 	}
 
 	virtual void undo() override
 	{
 		*rotationToEdit = previousRotation;
+		*dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
 	}
 
 private:
 	dkQuatf*	rotationToEdit;
+	u8*			dirtyFlags;
 	dkQuatf		rotation;
 	dkQuatf     previousRotation;
 };
@@ -66,6 +74,7 @@ class ScaleCommand : public TransactionCommand
 public:
 	ScaleCommand( TransformDatabase::EdInstanceData* transformToEdit, const dkVec3f& newValue, const dkVec3f& oldValue )
 		: scaleToEdit( transformToEdit->Scale )
+		, dirtyFlags( transformToEdit->DirtyFlags )
 		, scale( newValue )
 		, previousScale( oldValue )
 	{
@@ -75,15 +84,18 @@ public:
 	virtual void execute() override
 	{
 		*scaleToEdit = scale;
+		*dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
 	}
 
 	virtual void undo() override
 	{
 		*scaleToEdit = previousScale;
+		*dirtyFlags |= TransformDatabase::DIRTY_LOCAL;
 	}
 
 private:
 	dkVec3f*	scaleToEdit;
+	u8*			dirtyFlags;
 	dkVec3f     scale;
 	dkVec3f     previousScale;
 };
\ No newline at end of file
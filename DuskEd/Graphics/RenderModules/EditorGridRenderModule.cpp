@@ -43,7 +43,7 @@ FGHandle EditorGridModule::addEditorGridPass( FrameGraph& frameGraph, FGHandle o
 	);
 
     PassData passData = frameGraph.addRenderPass<PassData>(
-        EditorGrid::RenderGrid_Name,
+        EditorGrid::RenderGrid_Name, EditorGrid::RenderGrid_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             passData.Output = builder.readImage( outputRenderTarget );
             passData.InputDepth = builder.readImage( depthBuffer );
@@ -124,7 +124,7 @@ FGHandle ImGuiRenderModule::render( FrameGraph& frameGraph, FGHandle renderTarge
     );
 
     PassData& passData = frameGraph.addRenderPass<PassData>(
-        dkImGui::ImGui_Name,
+        dkImGui::ImGui_Name, dkImGui::ImGui_NameHashcode,
         [&]( FrameGraphBuilder& builder, PassData& passData ) {
             BufferDesc perPassBufferDesc;
             perPassBufferDesc.BindFlags = RESOURCE_BIND_CONSTANT_BUFFER;